@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace EQ {
+	// What each section of a character save wrote last time, so a section that would write the same
+	// statements again can be left out of the next transaction.
+	//
+	// Some savers mark their own data clean as they write it. Those register how to undo that with
+	// OnFailure while the save is built, and if its transaction doesn't commit the undo runs, so the
+	// data is written again by the next save instead of being lost.
+	class CharacterSaveState
+	{
+	public:
+		// true when the statements differ from what the section wrote last time
+		bool Changed(size_t section, const std::vector<std::string> &statements)
+		{
+			uint64 hash = 14695981039346656037ULL;
+			for (const auto &s : statements) {
+				hash ^= std::hash<std::string>{}(s) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+			}
+
+			// 0 means never saved, so even a section that writes nothing goes out once
+			if (hash == 0) {
+				hash = 1;
+			}
+
+			if (section >= m_hashes.size()) {
+				m_hashes.resize(section + 1, 0);
+			}
+
+			if (hash == m_hashes[section]) {
+				return false;
+			}
+
+			m_hashes[section] = hash;
+			return true;
+		}
+
+		void OnFailure(std::function<void()> restore)
+		{
+			m_restores.push_back(std::move(restore));
+		}
+
+		// closes out the save being built, its id goes to Committed or Failed once the transaction is done
+		uint32 Finish()
+		{
+			const uint32 save = NextSaveId();
+			if (!m_restores.empty()) {
+				m_pending[save] = std::move(m_restores);
+				m_restores.clear();
+			}
+
+			return save;
+		}
+
+		void Committed(uint32 save)
+		{
+			m_pending.erase(save);
+		}
+
+		// the transaction rolled back, so nothing skipped as unchanged since can be trusted either
+		void Failed(uint32 save)
+		{
+			Reset();
+
+			auto iter = m_pending.find(save);
+			if (iter == m_pending.end()) {
+				return;
+			}
+
+			auto restores = std::move(iter->second);
+			m_pending.erase(iter);
+
+			for (auto &r : restores) {
+				r();
+			}
+		}
+
+		// something other than a save wrote the section's rows, the next save can't skip it
+		void Forget(size_t section)
+		{
+			if (section < m_hashes.size()) {
+				m_hashes[section] = 0;
+			}
+		}
+
+		// forgets what earlier saves wrote so the next one writes every section
+		void Reset()
+		{
+			std::fill(m_hashes.begin(), m_hashes.end(), 0);
+		}
+
+		size_t PendingSaves() const { return m_pending.size(); }
+
+	private:
+		// unique across clients, a result for a client that has since left can't be taken for a save of
+		// whoever now has the character
+		static uint32 NextSaveId()
+		{
+			static uint32 next = 0;
+			return ++next;
+		}
+
+		std::vector<uint64>                                  m_hashes;
+		std::vector<std::function<void()>>                   m_restores;
+		std::map<uint32, std::vector<std::function<void()>>> m_pending;
+	};
+}
@@ -8,11 +8,18 @@
 
 #include "dbcore.h"
 #include "mysql_stmt.h"
+#include "event/event_loop.h"
 
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <mysqld_error.h>
 #include <string.h>
+#include <thread>
+#include <vector>
 #include "strings.h"
 
 #ifdef _WINDOWS
@@ -33,6 +40,60 @@
 #define DEBUG_MYSQL_QUERIES 0
 #endif
 
+struct DBcore::AsyncPool {
+	struct Job {
+		std::string                           query;
+		std::vector<std::string>              statements; // set for transactions, query is then only used for logging
+		AsyncQueryCallback                    callback;
+		std::chrono::steady_clock::time_point queued_at;
+	};
+
+	struct Done {
+		std::string        query;
+		MySQLRequestResult result;
+		AsyncQueryCallback callback;
+		uint64             latency_us;
+	};
+
+	// each connection drains its own queue so queries sharing an order key never overtake each other
+	struct Connection {
+		std::unique_ptr<DBcore> db;
+		std::thread             thread;
+		std::deque<Job>         queue;
+		std::condition_variable cv;
+	};
+
+	std::vector<std::unique_ptr<Connection>> connections;
+	std::mutex                               lock;
+	std::condition_variable                  idle_cv;
+	bool                                     running         = true;
+	uint64                                   outstanding     = 0;
+	uint32                                   next_connection = 0;
+	AsyncPoolStats                           stats           = {};
+
+	std::mutex       done_lock;
+	std::deque<Done> done;
+	uv_async_t       *notify = nullptr;
+
+	void Join()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			running = false;
+		}
+
+		for (auto &c: connections) {
+			c->cv.notify_all();
+		}
+
+		for (auto &c: connections) {
+			if (c->thread.joinable()) {
+				c->thread.join();
+			}
+		}
+	}
+};
+
 DBcore::DBcore()
 {
 	mysql      = mysql_init(nullptr);
@@ -54,6 +115,14 @@ DBcore::~DBcore()
 	 * are re-using the default database connection pointer when we dont have an
 	 * external configuration setup ex: (content_database)
 	 */
+	// the event loop may already be gone this late, so only the worker threads are stopped here
+	if (m_async_pool) {
+		m_async_pool->Join();
+		m_async_pool.reset();
+	}
+
+	m_prepared.clear();
+
 	if (mysqlOwner) {
 		mysql_close(mysql);
 	}
@@ -88,8 +157,35 @@ bool DBcore::DoesTableExist(const std::string& table_name)
 	return results.RowCount() > 0;
 }
 
+static bool IsWriteStatement(const char *query, uint32 querylen)
+{
+	uint32 i = 0;
+	while (i < querylen && isspace(static_cast<unsigned char>(query[i]))) {
+		i++;
+	}
+
+	const char   *q  = query + i;
+	const uint32 len = querylen - i;
+
+	return (
+		(len >= 6 && strncasecmp(q, "insert", 6) == 0) ||
+		(len >= 7 && strncasecmp(q, "replace", 7) == 0) ||
+		(len >= 6 && strncasecmp(q, "update", 6) == 0) ||
+		(len >= 6 && strncasecmp(q, "delete", 6) == 0)
+	);
+}
+
 MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, bool retryOnFailureOnce)
 {
+	if (
+		m_write_capture &&
+		std::this_thread::get_id() == m_write_capture_thread &&
+		IsWriteStatement(query, querylen)
+	) {
+		m_write_capture->emplace_back(query, querylen);
+		return MySQLRequestResult(nullptr, 1);
+	}
+
 	BenchTimer timer;
 	timer.reset();
 
@@ -112,11 +208,17 @@ MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, boo
 		if (errorNumber == CR_SERVER_LOST || errorNumber == CR_SERVER_GONE_ERROR) {
 
 			if (retryOnFailureOnce) {
-				LogInfo("Database Error: Lost connection, attempting to recover");
+				if (m_log_queries) {
+					LogInfo("Database Error: Lost connection, attempting to recover");
+				}
+
 				MySQLRequestResult requestResult = QueryDatabase(query, querylen, false);
 
 				if (requestResult.Success()) {
-					LogInfo("Reconnection to database successful");
+					if (m_log_queries) {
+						LogInfo("Reconnection to database successful");
+					}
+
 					return requestResult;
 				}
 
@@ -137,7 +239,7 @@ MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, boo
 		/**
 		 * Error logging
 		 */
-		if (mysql_errno(mysql) > 0 && query[0] != '\0') {
+		if (m_log_queries && mysql_errno(mysql) > 0 && query[0] != '\0') {
 			LogMySQLError("MySQL Error ({}) [{}] Query [{}]", mysql_errno(mysql), mysql_error(mysql), query);
 		}
 
@@ -160,7 +262,7 @@ MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, boo
 		(uint32) mysql_insert_id(mysql)
 	);
 
-	if (LogSys.log_settings[Logs::MySQLQuery].is_category_enabled == 1) {
+	if (m_log_queries && LogSys.log_settings[Logs::MySQLQuery].is_category_enabled == 1) {
 		if ((strncasecmp(query, "select", 6) == 0)) {
 			LogMySQLQuery(
 				"{0} -- ({1} row{2} returned) ({3}s)",
@@ -184,6 +286,100 @@ MySQLRequestResult DBcore::QueryDatabase(const char *query, uint32 querylen, boo
 	return requestResult;
 }
 
+MySQLRequestResult DBcore::QueryDatabaseTransaction(const std::vector<std::string> &queries)
+{
+	if (queries.empty()) {
+		return MySQLRequestResult(nullptr);
+	}
+
+	std::string batch = "START TRANSACTION";
+	for (const auto &q: queries) {
+		batch += ";\n";
+		batch += q;
+	}
+	batch += ";\nCOMMIT";
+
+	BenchTimer timer;
+	timer.reset();
+
+	LockMutex lock(m_mutex);
+
+	// Reconnect if we are not connected before hand.
+	if (pStatus != Connected) {
+		Open();
+	}
+
+	SetMultiStatementsOn();
+
+	// -1 = every statement ran, > 0 = a statement failed and the server stopped there
+	uint32 rows_affected = 0;
+	int    status        = mysql_real_query(mysql, batch.c_str(), batch.length());
+	if (status == 0) {
+		do {
+			MYSQL_RES *res = mysql_store_result(mysql);
+			if (res) {
+				mysql_free_result(res);
+			}
+			else if (mysql_field_count(mysql) == 0) {
+				rows_affected += (uint32) mysql_affected_rows(mysql);
+			}
+		} while ((status = mysql_next_result(mysql)) == 0);
+	}
+
+	if (status != -1) {
+		const uint32 error_number = mysql_errno(mysql);
+
+		auto error_buffer = new char[MYSQL_ERRMSG_SIZE];
+		snprintf(error_buffer, MYSQL_ERRMSG_SIZE, "#%i: %s", error_number, mysql_error(mysql));
+
+		SetMultiStatementsOff();
+
+		if (error_number == CR_SERVER_LOST || error_number == CR_SERVER_GONE_ERROR) {
+			pStatus = Error;
+		}
+		else {
+			mysql_real_query(mysql, "ROLLBACK", 8);
+		}
+
+		if (m_log_queries) {
+			LogMySQLError(
+				"MySQL Error ({}) [{}] in transaction of [{}] statement(s), rolled back",
+				error_number,
+				error_buffer,
+				queries.size()
+			);
+		}
+
+		return MySQLRequestResult(nullptr, 0, 0, 0, 0, error_number, error_buffer);
+	}
+
+	SetMultiStatementsOff();
+
+	if (m_log_queries && LogSys.log_settings[Logs::MySQLQuery].is_category_enabled == 1) {
+		LogMySQLQuery(
+			"Transaction of [{}] statement(s) [{}] bytes -- ({} row{} affected) ({}s)",
+			queries.size(),
+			batch.length(),
+			rows_affected,
+			rows_affected == 1 ? "" : "s",
+			std::to_string(timer.elapsed())
+		);
+	}
+
+	return MySQLRequestResult(nullptr, rows_affected);
+}
+
+void DBcore::BeginWriteCapture(std::vector<std::string> *statements)
+{
+	m_write_capture        = statements;
+	m_write_capture_thread = std::this_thread::get_id();
+}
+
+void DBcore::EndWriteCapture()
+{
+	m_write_capture = nullptr;
+}
+
 void DBcore::TransactionBegin()
 {
 	QueryDatabase("START TRANSACTION");
@@ -243,6 +439,7 @@ bool DBcore::Open(uint32 *errnum, char *errbuf)
 		return true;
 	}
 	if (GetStatus() == Error) {
+		m_prepared.clear();
 		mysql_close(mysql);
 		mysql_init(mysql);        // Initialize structure again
 	}
@@ -303,6 +500,7 @@ std::string DBcore::Escape(const std::string& s)
 void DBcore::SetMutex(Mutex *mutex)
 {
 	if (m_mutex && m_mutex != mutex) {
+		m_prepared.clear();
 		safe_delete(m_mutex);
 	}
 
@@ -440,7 +638,328 @@ MySQLRequestResult DBcore::QueryDatabaseMulti(const std::string &query)
 	return r;
 }
 
+bool DBcore::QueryDatabaseStream(const std::string &query, const StreamRowCallback &callback)
+{
+	BenchTimer timer;
+	timer.reset();
+
+	LockMutex lock(m_mutex);
+
+	// Reconnect if we are not connected before hand.
+	if (pStatus != Connected) {
+		Open();
+	}
+
+	if (mysql_real_query(mysql, query.c_str(), query.length()) != 0) {
+		if (mysql_errno(mysql) == CR_SERVER_GONE_ERROR) {
+			pStatus = Error;
+		}
+
+		if (m_log_queries) {
+			LogMySQLError("MySQL Error ({}) [{}] Query [{}]", mysql_errno(mysql), mysql_error(mysql), query);
+		}
+
+		return false;
+	}
+
+	MYSQL_RES *res = mysql_use_result(mysql);
+	if (!res) {
+		if (m_log_queries && mysql_errno(mysql) > 0) {
+			LogMySQLError("MySQL Error ({}) [{}] Query [{}]", mysql_errno(mysql), mysql_error(mysql), query);
+		}
+
+		return false;
+	}
+
+	const uint32 columns = mysql_num_fields(res);
+
+	uint32    rows = 0;
+	MYSQL_ROW row;
+	while ((row = mysql_fetch_row(res)) != nullptr) {
+		rows++;
+		if (!callback(row, mysql_fetch_lengths(res), columns)) {
+			break;
+		}
+	}
+
+	// a lost connection mid stream ends the fetch loop the same way the last row does
+	const bool success = mysql_errno(mysql) == 0;
+	if (!success && m_log_queries) {
+		LogMySQLError("MySQL Error ({}) [{}] Query [{}]", mysql_errno(mysql), mysql_error(mysql), query);
+	}
+
+	// frees the result and discards anything the callback stopped short of
+	mysql_free_result(res);
+
+	if (m_log_queries && LogSys.log_settings[Logs::MySQLQuery].is_category_enabled == 1) {
+		LogMySQLQuery(
+			"{0} -- ({1} row{2} streamed) ({3}s)",
+			query,
+			rows,
+			rows == 1 ? "" : "s",
+			std::to_string(timer.elapsed())
+		);
+	}
+
+	return success;
+}
+
 mysql::PreparedStmt DBcore::Prepare(std::string query)
 {
 	return mysql::PreparedStmt(*mysql, std::move(query), m_mutex);
 }
+
+mysql::PreparedStmt &DBcore::PrepareCached(const std::string &query)
+{
+	LockMutex lock(m_mutex);
+
+	auto it = m_prepared.find(query);
+	if (it == m_prepared.end()) {
+		it = m_prepared.emplace(query, std::make_unique<mysql::PreparedStmt>(*mysql, query, m_mutex)).first;
+	}
+
+	return *it->second;
+}
+
+void DBcore::ForgetPrepared(const std::string &query)
+{
+	LockMutex lock(m_mutex);
+	m_prepared.erase(query);
+}
+
+bool DBcore::StartAsyncPool(uint32 connections)
+{
+	if (m_async_pool || connections == 0 || !pHost) {
+		return false;
+	}
+
+	auto pool = std::make_unique<AsyncPool>();
+	for (uint32 i = 0; i < connections; ++i) {
+		auto c = std::make_unique<AsyncPool::Connection>();
+		c->db = std::make_unique<DBcore>();
+		c->db->m_log_queries = false;
+
+		uint32 errnum = 0;
+		char   errbuf[MYSQL_ERRMSG_SIZE];
+		if (!c->db->Open(pHost, pUser, pPassword, pDatabase, pPort, &errnum, errbuf, pCompress, pSSL)) {
+			LogError("Failed to open async database connection [{}] of [{}] [{}]", i + 1, connections, errbuf);
+			return false;
+		}
+
+		pool->connections.emplace_back(std::move(c));
+	}
+
+	pool->stats.connections = connections;
+
+	pool->notify = new uv_async_t;
+	memset(pool->notify, 0, sizeof(uv_async_t));
+	pool->notify->data = this;
+	uv_async_init(
+		EQ::EventLoop::Get().Handle(), pool->notify, [](uv_async_t *handle) {
+			static_cast<DBcore *>(handle->data)->DeliverAsyncResults();
+		}
+	);
+
+	m_async_pool = std::move(pool);
+	for (uint32 i = 0; i < connections; ++i) {
+		m_async_pool->connections[i]->thread = std::thread(&DBcore::AsyncPoolWorker, this, i);
+	}
+
+	LogInfo("Started [{}] async database connection(s)", connections);
+
+	return true;
+}
+
+void DBcore::StopAsyncPool()
+{
+	if (!m_async_pool) {
+		return;
+	}
+
+	// workers drain their queues before exiting, then the last callbacks run here
+	m_async_pool->Join();
+	DeliverAsyncResults();
+
+	uv_close(
+		reinterpret_cast<uv_handle_t *>(m_async_pool->notify), [](uv_handle_t *handle) {
+			delete reinterpret_cast<uv_async_t *>(handle);
+		}
+	);
+
+	m_async_pool.reset();
+}
+
+DBcore::AsyncPoolStats DBcore::GetAsyncPoolStats()
+{
+	if (!m_async_pool) {
+		return AsyncPoolStats{};
+	}
+
+	std::lock_guard<std::mutex> guard(m_async_pool->lock);
+	return m_async_pool->stats;
+}
+
+void DBcore::QueryDatabaseAsync(std::string query, AsyncQueryCallback callback, uint64 order_key)
+{
+	if (!m_async_pool) {
+		auto r = QueryDatabase(query);
+		if (callback) {
+			callback(r);
+		}
+
+		return;
+	}
+
+	QueueAsyncJob(std::move(query), {}, std::move(callback), order_key);
+}
+
+void DBcore::QueryDatabaseTransactionAsync(std::vector<std::string> queries, AsyncQueryCallback callback, uint64 order_key)
+{
+	if (!m_async_pool) {
+		auto r = QueryDatabaseTransaction(queries);
+		if (callback) {
+			callback(r);
+		}
+
+		return;
+	}
+
+	auto query = fmt::format("TRANSACTION of [{}] statement(s)", queries.size());
+	QueueAsyncJob(std::move(query), std::move(queries), std::move(callback), order_key);
+}
+
+void DBcore::QueueAsyncJob(std::string query, std::vector<std::string> statements, AsyncQueryCallback callback, uint64 order_key)
+{
+	auto &pool = *m_async_pool;
+
+	AsyncPool::Connection *c = nullptr;
+	{
+		std::lock_guard<std::mutex> guard(pool.lock);
+
+		const auto size = static_cast<uint32>(pool.connections.size());
+		const auto index = order_key ? static_cast<uint32>(order_key % size) : pool.next_connection++ % size;
+
+		c = pool.connections[index].get();
+		c->queue.push_back(
+			AsyncPool::Job{
+				std::move(query),
+				std::move(statements),
+				std::move(callback),
+				std::chrono::steady_clock::now()
+			}
+		);
+
+		pool.outstanding++;
+		pool.stats.queued++;
+		pool.stats.peak_depth = std::max(pool.stats.peak_depth, pool.outstanding);
+	}
+
+	c->cv.notify_one();
+}
+
+void DBcore::FlushAsyncQueries()
+{
+	if (!m_async_pool) {
+		return;
+	}
+
+	auto &pool = *m_async_pool;
+
+	// callers go on to act on what those queries did, a failed save has to be known about by then. a
+	// callback can queue more, so keep going until nothing is left
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(pool.lock);
+			pool.idle_cv.wait(lock, [&pool]() { return pool.outstanding == 0; });
+		}
+
+		DeliverAsyncResults();
+
+		std::lock_guard<std::mutex> guard(pool.lock);
+		if (pool.outstanding == 0) {
+			return;
+		}
+	}
+}
+
+void DBcore::AsyncPoolWorker(uint32 index)
+{
+	auto &pool = *m_async_pool;
+	auto &c    = *pool.connections[index];
+
+	for (;;) {
+		AsyncPool::Job job;
+		{
+			std::unique_lock<std::mutex> lock(pool.lock);
+			c.cv.wait(lock, [&]() { return !pool.running || !c.queue.empty(); });
+			if (c.queue.empty()) {
+				return;
+			}
+
+			job = std::move(c.queue.front());
+			c.queue.pop_front();
+		}
+
+		auto result = job.statements.empty() ? c.db->QueryDatabase(job.query) : c.db->QueryDatabaseTransaction(job.statements);
+
+		const auto latency_us = static_cast<uint64>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - job.queued_at
+			).count()
+		);
+
+		const bool success = result.Success();
+		{
+			std::lock_guard<std::mutex> guard(pool.done_lock);
+			pool.done.push_back(AsyncPool::Done{std::move(job.query), std::move(result), std::move(job.callback), latency_us});
+		}
+
+		uv_async_send(pool.notify);
+
+		{
+			std::lock_guard<std::mutex> guard(pool.lock);
+			pool.outstanding--;
+			pool.stats.completed++;
+			pool.stats.total_latency_us += latency_us;
+			pool.stats.max_latency_us = std::max(pool.stats.max_latency_us, latency_us);
+			if (!success) {
+				pool.stats.failed++;
+			}
+		}
+
+		pool.idle_cv.notify_all();
+	}
+}
+
+// runs on the thread that started the pool, logging and callbacks happen here rather than on the workers
+void DBcore::DeliverAsyncResults()
+{
+	if (!m_async_pool) {
+		return;
+	}
+
+	std::deque<AsyncPool::Done> done;
+	{
+		std::lock_guard<std::mutex> guard(m_async_pool->done_lock);
+		done.swap(m_async_pool->done);
+	}
+
+	for (auto &d: done) {
+		if (!d.result.Success()) {
+			LogMySQLError("MySQL Error ({}) [{}] Async Query [{}]", d.result.ErrorNumber(), d.result.ErrorMessage(), d.query);
+		}
+		else {
+			LogMySQLQuery(
+				"{} -- ({} row{} affected) ({}us async)",
+				d.query,
+				d.result.RowsAffected(),
+				d.result.RowsAffected() == 1 ? "" : "s",
+				d.latency_us
+			);
+		}
+
+		if (d.callback) {
+			d.callback(d.result);
+		}
+	}
+}
@@ -12,7 +12,12 @@
 
 #include <mysql.h>
 #include <string.h>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #define CR_SERVER_GONE_ERROR    2006
 #define CR_SERVER_LOST          2013
@@ -25,12 +30,54 @@ public:
 		Closed, Connected, Error
 	};
 
+	typedef std::function<void(MySQLRequestResult &)> AsyncQueryCallback;
+	typedef std::function<bool(MYSQL_ROW row, unsigned long *lengths, uint32 columns)> StreamRowCallback;
+
+	struct AsyncPoolStats {
+		uint32 connections;
+		uint64 queued;
+		uint64 completed;
+		uint64 failed;
+		uint64 peak_depth;
+		uint64 total_latency_us;
+		uint64 max_latency_us;
+	};
+
 	DBcore();
 	~DBcore();
 	eStatus GetStatus() { return pStatus; }
 	MySQLRequestResult QueryDatabase(const char *query, uint32 querylen, bool retryOnFailureOnce = true);
 	MySQLRequestResult QueryDatabase(const std::string& query, bool retryOnFailureOnce = true);
 	MySQLRequestResult QueryDatabaseMulti(const std::string &query);
+
+	// reads rows off the server one at a time (mysql_use_result) instead of buffering the whole result set
+	// row pointers are only valid inside the callback, returning false stops early, the connection stays
+	// busy until the last row so the callback must not query it
+	bool QueryDatabaseStream(const std::string &query, const StreamRowCallback &callback);
+
+	// opens extra connections with this connection's credentials for QueryDatabaseAsync
+	// callbacks are posted to the event loop of the thread that starts the pool
+	bool StartAsyncPool(uint32 connections);
+	void StopAsyncPool();
+	bool IsAsyncPoolRunning() const { return m_async_pool != nullptr; }
+	AsyncPoolStats GetAsyncPoolStats();
+
+	// runs the query on a pool connection, without a pool it runs inline and calls back immediately
+	// queries sharing a non zero order_key run one at a time in the order they were queued
+	void QueryDatabaseAsync(std::string query, AsyncQueryCallback callback = nullptr, uint64 order_key = 0);
+	// blocks until every queued async query has hit the database and its callback has run, must be
+	// called from the thread that started the pool
+	void FlushAsyncQueries();
+
+	// sends every statement inside one transaction in a single round trip, rolls back on the first failure
+	MySQLRequestResult QueryDatabaseTransaction(const std::vector<std::string> &queries);
+	void QueryDatabaseTransactionAsync(std::vector<std::string> queries, AsyncQueryCallback callback = nullptr, uint64 order_key = 0);
+
+	// while capturing, writes made from the calling thread are appended to statements instead of sent
+	// reads still go to the server, the caller decides how the captured writes are executed
+	void BeginWriteCapture(std::vector<std::string> *statements);
+	void EndWriteCapture();
+	bool IsCapturingWrites() const { return m_write_capture && std::this_thread::get_id() == m_write_capture_thread; }
 	void TransactionBegin();
 	void TransactionCommit();
 	void TransactionRollback();
@@ -55,6 +102,11 @@ public:
 	// throws std::runtime_error on failure
 	mysql::PreparedStmt Prepare(std::string query);
 
+	// prepared once per distinct query text and reused for the life of the connection,
+	// same threading caveats as Prepare, throws std::runtime_error on failure
+	mysql::PreparedStmt &PrepareCached(const std::string &query);
+	void ForgetPrepared(const std::string &query);
+
 protected:
 	bool Open(
 		const char *iHost,
@@ -69,15 +121,31 @@ protected:
 	);
 
 private:
+	struct AsyncPool;
+
 	bool Open(uint32 *errnum = nullptr, char *errbuf = nullptr);
+	void AsyncPoolWorker(uint32 index);
+	void DeliverAsyncResults();
+	void QueueAsyncJob(std::string query, std::vector<std::string> statements, AsyncQueryCallback callback, uint64 order_key);
 
 	MYSQL*  mysql;
 	bool    mysqlOwner;
 	Mutex   *m_mutex;
 	eStatus pStatus;
 
+	// pool connections leave logging to the owning thread, gmsay hooks aren't thread safe
+	bool m_log_queries = true;
+
+	std::unique_ptr<AsyncPool> m_async_pool;
+
+	std::vector<std::string> *m_write_capture = nullptr;
+	std::thread::id          m_write_capture_thread;
+
 	std::mutex m_query_lock{};
 
+	// statements are tied to the connection, a reconnect drops them all
+	std::unordered_map<std::string, std::unique_ptr<mysql::PreparedStmt>> m_prepared;
+
 	std::string origin_host;
 
 	char   *pHost;
@@ -0,0 +1,118 @@
+#include "global_define.h"
+#include "eq_broadcast_packet.h"
+#include "eq_packet.h"
+#include "eq_stream_intf.h"
+#include "opcodemgr.h"
+#include "struct_strategy.h"
+
+namespace {
+
+	//stands in for a client's stream while a patch encodes, keeping everything the encoder queues.
+	class EncodeCapture : public EQStreamInterface {
+	public:
+		EncodeCapture(EQ::versions::ClientVersion version) : m_version(version) { }
+
+		virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req) {
+			if (p) {
+				packets.emplace_back(std::unique_ptr<EQApplicationPacket>(p->Copy()), ack_req);
+			}
+		}
+
+		virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req) {
+			if (p && *p) {
+				packets.emplace_back(std::unique_ptr<EQApplicationPacket>(*p), ack_req);
+				*p = nullptr;
+			}
+		}
+
+		virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames) { }
+		virtual EQApplicationPacket *PopPacket() { return nullptr; }
+		virtual void Close() { }
+		virtual void ReleaseFromUse() { }
+		virtual void RemoveData() { }
+		virtual std::string GetRemoteAddr() const { return std::string(); }
+		virtual uint32 GetRemoteIP() const { return 0; }
+		virtual uint16 GetRemotePort() const { return 0; }
+		virtual bool CheckState(EQStreamState state) { return state == ESTABLISHED; }
+		virtual std::string Describe() const { return "Broadcast Encode Capture"; }
+		virtual EQStreamState GetState() { return ESTABLISHED; }
+		virtual void SetOpcodeManager(OpcodeManager **opm) { }
+		virtual OpcodeManager *GetOpcodeManager() const { return nullptr; }
+		virtual const EQ::versions::ClientVersion ClientVersion() const { return m_version; }
+		virtual Stats GetStats() const { return Stats(); }
+		virtual void ResetStats() { }
+		virtual EQStreamManagerInterface *GetManager() const { return nullptr; }
+
+		std::vector<std::pair<std::unique_ptr<EQApplicationPacket>, bool>> packets;
+
+	private:
+		EQ::versions::ClientVersion m_version;
+	};
+
+	//the same framing EQ::Net::EQStream::QueuePacket gives a packet before handing it to the connection.
+	void AddFrame(EQBroadcastPacket::Frames &frames, const EQApplicationPacket *p, OpcodeManager *opcodes, int opcode_size, bool ack_req)
+	{
+		EQBroadcastPacket::Frame frame;
+		frame.emu_opcode = p->GetOpcode();
+		frame.bypass     = p->GetOpcodeBypass() != 0;
+		frame.opcode     = frame.bypass ? p->GetOpcodeBypass() : (opcodes ? opcodes->EmuToEQ(p->GetOpcode()) : 0);
+		frame.ack_req    = ack_req;
+
+		switch (opcode_size) {
+		case 1:
+			frame.data.PutUInt8(0, frame.opcode);
+			frame.data.PutData(1, p->pBuffer, p->size);
+			break;
+		case 2:
+			frame.data.PutUInt16(0, frame.opcode);
+			frame.data.PutData(2, p->pBuffer, p->size);
+			break;
+		}
+
+		frames.push_back(std::move(frame));
+	}
+
+}
+
+EQBroadcastPacket::EQBroadcastPacket(const EQApplicationPacket *app)
+:	m_packet(app)
+{
+}
+
+std::shared_ptr<const EQBroadcastPacket::Frames> EQBroadcastPacket::Encode(
+	const StructStrategy *structs,
+	OpcodeManager *opcodes,
+	int opcode_size,
+	bool ack_req
+)
+{
+	for (auto &e : m_encoded) {
+		if (e.structs == structs && e.opcodes == opcodes && e.opcode_size == opcode_size && e.ack_req == ack_req) {
+			return e.frames;
+		}
+	}
+
+	auto frames = std::make_shared<Frames>();
+
+	//a null packet encodes to nothing, the same as QueuePacket dropping it.
+	if (m_packet && structs) {
+		auto capture = std::make_shared<EncodeCapture>(structs->ClientVersion());
+
+		//the encoder takes ownership of what it is given.
+		EQApplicationPacket *copy = m_packet->Copy();
+		structs->Encode(&copy, capture, ack_req);
+		delete copy;
+
+		frames->reserve(capture->packets.size());
+		for (auto &c : capture->packets) {
+			AddFrame(*frames, c.first.get(), opcodes, opcode_size, c.second);
+		}
+	}
+	else if (m_packet) {
+		AddFrame(*frames, m_packet, opcodes, opcode_size, ack_req);
+	}
+
+	m_encoded.push_back({ structs, opcodes, opcode_size, ack_req, frames });
+
+	return m_encoded.back().frames;
+}
@@ -0,0 +1,59 @@
+#ifndef EQBROADCASTPACKET_H_
+#define EQBROADCASTPACKET_H_
+
+#include "types.h"
+#include "emu_opcodes.h"
+#include "net/packet.h"
+#include <memory>
+#include <vector>
+
+class EQApplicationPacket;
+class OpcodeManager;
+class StructStrategy;
+
+// A packet going out to many clients at once, such as a position or hp update sent to everyone in range
+//
+// A patch's encoder runs on it once, the first time a recipient using that patch is queued. What the encoder
+// produced is prefixed with the wire opcode and kept, so each later recipient of the same client version
+// hands the same buffers to its connection, which only adds its own sequencing on top
+class EQBroadcastPacket {
+public:
+	struct Frame {
+		EmuOpcode              emu_opcode;
+		uint16                 opcode;  // as sent, already written to the front of data
+		bool                   bypass;  // opcode came from a bypass instead of the opcode manager
+		bool                   ack_req;
+		EQ::Net::DynamicPacket data;
+	};
+
+	typedef std::vector<Frame> Frames;
+
+	//we do not own the packet, it has to outlive the broadcast.
+	explicit EQBroadcastPacket(const EQApplicationPacket *app);
+
+	EQBroadcastPacket(const EQBroadcastPacket &) = delete;
+	EQBroadcastPacket &operator=(const EQBroadcastPacket &) = delete;
+
+	const EQApplicationPacket *GetPacket() const { return m_packet; }
+
+	// encodes through structs the first time a patch asks and hands back the same frames after that,
+	// structs is null for a stream that sends emu structs as they are
+	std::shared_ptr<const Frames> Encode(const StructStrategy *structs, OpcodeManager *opcodes, int opcode_size, bool ack_req);
+
+	// how many times an encoder actually ran, one per distinct patch queued
+	size_t GetEncodeCount() const { return m_encoded.size(); }
+
+private:
+	struct Encoded {
+		const StructStrategy          *structs;
+		OpcodeManager                 *opcodes;
+		int                           opcode_size;
+		bool                          ack_req;
+		std::shared_ptr<const Frames> frames;
+	};
+
+	const EQApplicationPacket *m_packet;
+	std::vector<Encoded>      m_encoded;
+};
+
+#endif /*EQBROADCASTPACKET_H_*/
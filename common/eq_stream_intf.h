@@ -6,6 +6,7 @@
 #include <string>
 #include "emu_versions.h"
 #include "eq_packet.h"
+#include "eq_broadcast_packet.h"
 #include "net/daybreak_connection.h"
 
 typedef enum {
@@ -23,10 +24,12 @@ struct EQStreamManagerInterfaceOptions
 {
 	EQStreamManagerInterfaceOptions() {
 		opcode_size = 2;
+		network_thread = false;
 	}
 
 	EQStreamManagerInterfaceOptions(int port, bool encoded, bool compressed) {
 		opcode_size = 2;
+		network_thread = false;
 
 		//World seems to support both compression and xor zone supports one or the others.
 		//Enforce one or the other in the convienence construct
@@ -44,6 +47,7 @@ struct EQStreamManagerInterfaceOptions
 
 	int opcode_size;
 	bool track_opcode_stats;
+	bool network_thread; //run the socket and daybreak on their own thread, streams only see whole packets
 	EQ::Net::DaybreakConnectionManagerOptions daybreak_options;
 };
 
@@ -87,6 +91,10 @@ public:
 
 	virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req=true) = 0;
 	virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req=true) = 0;
+	//queues a packet shared by many recipients, encoding it at most once per client version.
+	virtual void QueueBroadcastPacket(EQBroadcastPacket &p, bool ack_req=true) { QueuePacket(p.GetPacket(), ack_req); }
+	//queues frames a broadcast already encoded for this stream's client version.
+	virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames) = 0;
 	virtual EQApplicationPacket *PopPacket() = 0;
 	virtual void Close() = 0;
 	virtual void ReleaseFromUse() = 0;
@@ -52,6 +52,18 @@ void EQStreamProxy::FastQueuePacket(EQApplicationPacket **p, bool ack_req) {
 	m_structs->Encode(p, m_stream, ack_req);
 }
 
+void EQStreamProxy::QueueBroadcastPacket(EQBroadcastPacket &p, bool ack_req) {
+	const EQStreamManagerInterface *manager = m_stream->GetManager();
+
+	//every proxy of the same patch shares whatever the first one encoded.
+	auto frames = p.Encode(m_structs, *m_opcodes, manager ? manager->GetOptions().opcode_size : 2, ack_req);
+	m_stream->QueueEncodedFrames(frames);
+}
+
+void EQStreamProxy::QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames) {
+	m_stream->QueueEncodedFrames(frames);
+}
+
 EQApplicationPacket *EQStreamProxy::PopPacket() {
 	EQApplicationPacket *pack = m_stream->PopPacket();
 	if(pack == nullptr)
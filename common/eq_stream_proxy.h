@@ -19,6 +19,8 @@ public:
 	//EQStreamInterface:
 	virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req=true);
 	virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req=true);
+	virtual void QueueBroadcastPacket(EQBroadcastPacket &p, bool ack_req=true);
+	virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames);
 	virtual EQApplicationPacket *PopPacket();
 	virtual void Close();
 	virtual std::string GetRemoteAddr() const;
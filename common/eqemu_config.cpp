@@ -177,6 +177,13 @@ void EQEmuConfig::parse_config()
 	SharedMemDir = _root["server"]["directories"].get("shared_memory", "shared/").asString();
 	LogDir       = _root["server"]["directories"].get("logs", "logs/").asString();
 
+	/**
+	 * Shared memory, keep the directory on a hugetlbfs mount to back segments with huge pages outright
+	 */
+	SharedMemPopulate  = _root["server"]["shared_memory"].get("populate", "false").asString() == "true";
+	SharedMemHugePages = _root["server"]["shared_memory"].get("huge_pages", "false").asString() == "true";
+	SharedMemWillNeed  = _root["server"]["shared_memory"].get("will_need", "false").asString() == "true";
+
 	/**
 	 * Logs
 	 */
@@ -390,6 +397,9 @@ void EQEmuConfig::Dump() const
 	std::cout << "PatchDir = " << PatchDir << std::endl;
 	std::cout << "SharedMemDir = " << SharedMemDir << std::endl;
 	std::cout << "LogDir = " << LogDir << std::endl;
+	std::cout << "SharedMemPopulate = " << SharedMemPopulate << std::endl;
+	std::cout << "SharedMemHugePages = " << SharedMemHugePages << std::endl;
+	std::cout << "SharedMemWillNeed = " << SharedMemWillNeed << std::endl;
 	std::cout << "ZonePortLow = " << ZonePortLow << std::endl;
 	std::cout << "ZonePortHigh = " << ZonePortHigh << std::endl;
 	std::cout << "DefaultStatus = " << (int) DefaultStatus << std::endl;
@@ -101,6 +101,11 @@ class EQEmuConfig
 		std::string SharedMemDir;
 		std::string LogDir;
 
+		// From <shared_memory/>, paging hints for the mapped items and spells segments
+		bool SharedMemPopulate;
+		bool SharedMemHugePages;
+		bool SharedMemWillNeed;
+
 		// From <launcher/>
 		std::string LogPrefix;
 		std::string LogSuffix;
@@ -27,14 +27,13 @@
 #include "termcolor/rang.hpp"
 #include "path_manager.h"
 #include "file.h"
+#include "event/event_loop.h"
 
 #include <iostream>
 #include <string>
 #include <time.h>
 #include <sys/stat.h>
 
-std::ofstream process_log;
-
 #include <filesystem>
 
 #ifdef _WINDOWS
@@ -64,7 +63,10 @@ EQEmuLogSys::EQEmuLogSys()
 /**
  * EQEmuLogSys Deconstructor
  */
-EQEmuLogSys::~EQEmuLogSys() = default;
+EQEmuLogSys::~EQEmuLogSys()
+{
+	StopAsyncSink();
+}
 
 EQEmuLogSys *EQEmuLogSys::LoadLogSettingsDefaults()
 {
@@ -164,12 +166,13 @@ EQEmuLogSys *EQEmuLogSys::LoadLogSettingsDefaults()
  */
 void EQEmuLogSys::ProcessLogWrite(
 	uint16 log_category,
-	const std::string &message
+	const std::string &message,
+	time_t logged_at
 )
 {
 	if (log_category == Logs::Crash) {
 		char time_stamp[80];
-		EQEmuLogSys::SetCurrentTimeStamp(time_stamp);
+		EQEmuLogSys::FormatTimeStamp(logged_at, time_stamp);
 		std::ofstream crash_log;
 		EQEmuLogSys::MakeDirectory("logs/crashes");
 		crash_log.open(
@@ -180,10 +183,11 @@ void EQEmuLogSys::ProcessLogWrite(
 		crash_log.close();
 	}
 
-	if (process_log) {
+	std::lock_guard<std::mutex> lock(m_file_lock);
+	if (m_process_log) {
 		char time_stamp[80];
-		EQEmuLogSys::SetCurrentTimeStamp(time_stamp);
-		process_log << time_stamp << " " << message << std::endl;
+		EQEmuLogSys::FormatTimeStamp(logged_at, time_stamp);
+		m_process_log << time_stamp << " " << message << "\n";
 	}
 }
 
@@ -223,7 +227,8 @@ void EQEmuLogSys::ProcessConsoleMessage(
 	const std::string &message,
 	const char *file,
 	const char *func,
-	int line
+	int line,
+	const std::string &origination
 )
 {
 	bool is_error   = (
@@ -391,24 +396,31 @@ void EQEmuLogSys::ProcessConsoleMessage(
 			<< " ";
 	}
 
-	if (!origination_info.zone_short_name.empty()) {
+	if (!origination.empty()) {
 		(!is_error ? std::cout : std::cerr)
 			<<
 			rang::fgB::black
 			<<
 			"-- "
 			<<
-			fmt::format(
-				"[{}] ({}) inst_id [{}]",
-				origination_info.zone_short_name,
-				origination_info.zone_long_name,
-				origination_info.instance_id
-			);
+			origination;
 	}
 
-	(!is_error ? std::cout : std::cerr) << rang::style::reset << std::endl;
+	(!is_error ? std::cout : std::cerr) << rang::style::reset << "\n";
+}
+
+std::string EQEmuLogSys::GetOriginationSuffix() const
+{
+	if (origination_info.zone_short_name.empty()) {
+		return {};
+	}
 
-	m_on_log_console_hook(log_category, message);
+	return fmt::format(
+		"[{}] ({}) inst_id [{}]",
+		origination_info.zone_short_name,
+		origination_info.zone_long_name,
+		origination_info.instance_id
+	);
 }
 
 /**
@@ -469,29 +481,148 @@ void EQEmuLogSys::Out(
 		va_end(args);
 	}
 
-	if (l.log_to_console_enabled) {
-		EQEmuLogSys::ProcessConsoleMessage(
-			log_category,
-			output_message,
-			file,
-			func,
-			line
+	// crashes are written inline, the process may not live long enough for the writer to get to them
+	const bool use_sink = IsAsyncSinkRunning() && log_category != Logs::Crash;
+	if (log_category == Logs::Crash) {
+		FlushAsyncSink();
+	}
+
+	if (l.log_to_console_enabled || l.log_to_file_enabled) {
+		std::string file_message;
+		if (l.log_to_file_enabled) {
+			file_message = fmt::format(
+				"[{}] [{}] {}",
+				GetPlatformName(),
+				Logs::LogCategoryName[log_category],
+				prefix + output_message
+			);
+		}
+
+		if (use_sink) {
+			QueuedLog e;
+			e.log_category = log_category;
+			e.to_console   = l.log_to_console_enabled;
+			e.to_file      = l.log_to_file_enabled;
+			e.file         = file;
+			e.func         = func;
+			e.line         = line;
+			e.logged_at    = time(nullptr);
+			e.message      = l.log_to_console_enabled ? output_message : std::string();
+			e.file_message = std::move(file_message);
+			e.origination  = l.log_to_console_enabled ? GetOriginationSuffix() : std::string();
+
+			if (m_sink->TryPush(std::move(e))) {
+				m_sink_queued.fetch_add(1, std::memory_order_relaxed);
+			}
+			else {
+				m_sink_dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		else {
+			if (l.log_to_console_enabled) {
+				EQEmuLogSys::ProcessConsoleMessage(log_category, output_message, file, func, line, GetOriginationSuffix());
+				std::cout.flush();
+			}
+			if (l.log_to_file_enabled) {
+				EQEmuLogSys::ProcessLogWrite(log_category, file_message, time(nullptr));
+
+				std::lock_guard<std::mutex> lock(m_file_lock);
+				m_process_log.flush();
+			}
+		}
+	}
+
+	const bool to_discord = l.log_to_discord_enabled && m_on_log_discord_hook;
+	if (!l.log_to_console_enabled && !l.log_to_gmsay_enabled && !to_discord) {
+		return;
+	}
+
+	// the hooks reach into game state, from any other thread they're handed to the loop of the one that set them
+	if (m_hook_relay && std::this_thread::get_id() != m_hook_thread) {
+		RelayHook(
+			[this, l, to_discord, log_category, func, webhook_id = log_settings[log_category].discord_webhook_id, output_message]() {
+				if (l.log_to_console_enabled) {
+					m_on_log_console_hook(log_category, output_message);
+				}
+				if (l.log_to_gmsay_enabled) {
+					m_on_log_gmsay_hook(log_category, func, output_message);
+				}
+				if (to_discord) {
+					m_on_log_discord_hook(log_category, webhook_id, output_message);
+				}
+			}
 		);
+
+		return;
+	}
+
+	if (l.log_to_console_enabled) {
+		m_on_log_console_hook(log_category, output_message);
 	}
 	if (l.log_to_gmsay_enabled) {
 		m_on_log_gmsay_hook(log_category, func, output_message);
 	}
-	if (l.log_to_file_enabled) {
-		EQEmuLogSys::ProcessLogWrite(
-			log_category,
-			fmt::format("[{}] [{}] {}", GetPlatformName(), Logs::LogCategoryName[log_category], prefix + output_message)
-		);
-	}
-	if (l.log_to_discord_enabled && m_on_log_discord_hook) {
+	if (to_discord) {
 		m_on_log_discord_hook(log_category, log_settings[log_category].discord_webhook_id, output_message);
 	}
 }
 
+void EQEmuLogSys::StartHookRelay()
+{
+	if (m_hook_relay) {
+		return;
+	}
+
+	m_hook_thread = std::this_thread::get_id();
+
+	// unreferenced so a process that never logs off its own thread still exits its loop
+	m_hook_relay = new uv_async_t;
+	memset(m_hook_relay, 0, sizeof(uv_async_t));
+	m_hook_relay->data = this;
+	uv_async_init(
+		EQ::EventLoop::Get().Handle(), m_hook_relay, [](uv_async_t *handle) {
+			static_cast<EQEmuLogSys *>(handle->data)->RunRelayedHooks();
+		}
+	);
+	uv_unref(reinterpret_cast<uv_handle_t *>(m_hook_relay));
+}
+
+void EQEmuLogSys::RelayHook(std::function<void()> hook)
+{
+	{
+		std::lock_guard<std::mutex> guard(m_hook_relay_lock);
+
+		// a loop that has stopped running can't be allowed to grow this forever
+		if (m_relayed_hooks.size() >= 10000) {
+			m_relayed_hooks_dropped++;
+			return;
+		}
+
+		m_relayed_hooks.push_back(std::move(hook));
+	}
+
+	uv_async_send(m_hook_relay);
+}
+
+void EQEmuLogSys::RunRelayedHooks()
+{
+	std::vector<std::function<void()>> hooks;
+	uint64                             dropped = 0;
+	{
+		std::lock_guard<std::mutex> guard(m_hook_relay_lock);
+		hooks.swap(m_relayed_hooks);
+		std::swap(dropped, m_relayed_hooks_dropped);
+	}
+
+	for (auto &h: hooks) {
+		h();
+	}
+
+	if (dropped) {
+		LogWarning("Dropped [{}] log hook call(s) made from other threads", dropped);
+	}
+}
+
 /**
  * @param time_stamp
  */
@@ -504,6 +635,23 @@ void EQEmuLogSys::SetCurrentTimeStamp(char *time_stamp)
 	strftime(time_stamp, 80, "[%m-%d-%Y %H:%M:%S]", time_info);
 }
 
+/**
+ * Thread safe variant of SetCurrentTimeStamp used by the async writer
+ *
+ * @param at
+ * @param time_stamp
+ */
+void EQEmuLogSys::FormatTimeStamp(time_t at, char *time_stamp)
+{
+	struct tm time_info{};
+#ifdef _WINDOWS
+	localtime_s(&time_info, &at);
+#else
+	localtime_r(&at, &time_info);
+#endif
+	strftime(time_stamp, 80, "[%m-%d-%Y %H:%M:%S]", &time_info);
+}
+
 /**
  * @param directory_name
  */
@@ -525,17 +673,158 @@ void EQEmuLogSys::MakeDirectory(const std::string &directory_name)
 
 void EQEmuLogSys::CloseFileLogs()
 {
-	if (process_log.is_open()) {
-		process_log.close();
+	StopAsyncSink();
+
+	std::lock_guard<std::mutex> lock(m_file_lock);
+	if (m_process_log.is_open()) {
+		m_process_log.close();
 	}
 }
 
+/**
+ * @param capacity
+ */
+void EQEmuLogSys::StartAsyncSink(size_t capacity)
+{
+	if (capacity == 0 || IsAsyncSinkRunning()) {
+		return;
+	}
+
+	// the ring outlives stop / start cycles, a late producer on another thread never sees it freed
+	if (!m_sink) {
+		m_sink = std::make_unique<EQ::Util::MPSCRing<QueuedLog>>(capacity);
+	}
+
+	m_sink_running.store(true, std::memory_order_release);
+	m_sink_thread = std::thread(&EQEmuLogSys::ProcessAsyncSink, this);
+}
+
+void EQEmuLogSys::StopAsyncSink()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sink_lock);
+		if (!m_sink_running.exchange(false)) {
+			return;
+		}
+	}
+
+	m_sink_cv.notify_all();
+
+	if (m_sink_thread.joinable()) {
+		m_sink_thread.join();
+	}
+
+	// anything pushed while the writer was shutting down
+	DrainAsyncSink();
+}
+
+void EQEmuLogSys::FlushAsyncSink()
+{
+	if (!IsAsyncSinkRunning()) {
+		return;
+	}
+
+	const uint64 target = m_sink_queued.load(std::memory_order_relaxed);
+
+	std::unique_lock<std::mutex> lock(m_sink_lock);
+	m_sink_cv.notify_all();
+	m_sink_cv.wait_for(
+		lock,
+		std::chrono::seconds(1),
+		[&] {
+			return !IsAsyncSinkRunning() || m_sink_written.load(std::memory_order_relaxed) >= target;
+		}
+	);
+}
+
+void EQEmuLogSys::ProcessAsyncSink()
+{
+	for (;;) {
+		const bool wrote = DrainAsyncSink();
+
+		std::unique_lock<std::mutex> lock(m_sink_lock);
+
+		// wake anyone waiting in FlushAsyncSink
+		if (wrote) {
+			m_sink_cv.notify_all();
+		}
+
+		if (!IsAsyncSinkRunning()) {
+			return;
+		}
+
+		// producers never signal, the writer picks up whatever accumulated since the last batch
+		if (!wrote) {
+			m_sink_cv.wait_for(lock, std::chrono::milliseconds(5));
+		}
+	}
+}
+
+bool EQEmuLogSys::DrainAsyncSink()
+{
+	if (!m_sink) {
+		return false;
+	}
+
+	QueuedLog e;
+	uint64    written = 0;
+	bool      to_file = false;
+
+	while (m_sink->TryPop(e)) {
+		if (e.to_console) {
+			ProcessConsoleMessage(e.log_category, e.message, e.file, e.func, e.line, e.origination);
+		}
+
+		if (e.to_file) {
+			ProcessLogWrite(e.log_category, e.file_message, e.logged_at);
+			to_file = true;
+		}
+
+		written++;
+	}
+
+	const uint64 dropped = m_sink_dropped.load(std::memory_order_relaxed);
+	if (dropped != m_sink_reported_dropped) {
+		const auto message = fmt::format(
+			"Log writer fell behind, dropped [{}] messages ([{}] total)",
+			dropped - m_sink_reported_dropped,
+			dropped
+		);
+
+		m_sink_reported_dropped = dropped;
+
+		ProcessConsoleMessage(Logs::Warning, message, __FILE__, __func__, __LINE__, std::string());
+		ProcessLogWrite(
+			Logs::Warning,
+			fmt::format("[{}] [{}] {}", GetPlatformName(), Logs::LogCategoryName[Logs::Warning], message),
+			time(nullptr)
+		);
+		to_file = true;
+	}
+
+	if (written == 0 && !to_file) {
+		return false;
+	}
+
+	// one flush per batch instead of one per line
+	std::cout.flush();
+	if (to_file) {
+		std::lock_guard<std::mutex> lock(m_file_lock);
+		m_process_log.flush();
+	}
+
+	m_sink_written.fetch_add(written, std::memory_order_relaxed);
+
+	return written > 0;
+}
+
 /**
  * @param log_name
  */
 void EQEmuLogSys::StartFileLogs(const std::string &log_name)
 {
 	EQEmuLogSys::CloseFileLogs();
+	EQEmuLogSys::StartAsyncSink(static_cast<size_t>(std::max(RuleI(Logging, AsyncSinkCapacity), 0)));
 
 	if (!File::Exists(path.GetLogPath())) {
 		LogInfo("Logs directory not found, creating [{}]", path.GetLogPath());
@@ -567,7 +856,8 @@ void EQEmuLogSys::StartFileLogs(const std::string &log_name)
 		EQEmuLogSys::MakeDirectory(fmt::format("{}/zone", GetLogPath()));
 
 		// Open file pointer
-		process_log.open(
+		std::lock_guard<std::mutex> lock(m_file_lock);
+		m_process_log.open(
 			fmt::format("{}/zone/{}_{}.log", GetLogPath(), m_platform_file_name, getpid()),
 			std::ios_base::app | std::ios_base::out
 		);
@@ -582,7 +872,8 @@ void EQEmuLogSys::StartFileLogs(const std::string &log_name)
 		LogInfo("Starting File Log [{}/{}_{}.log]", GetLogPath(), m_platform_file_name.c_str(), getpid());
 
 		// Open file pointer
-		process_log.open(
+		std::lock_guard<std::mutex> lock(m_file_lock);
+		m_process_log.open(
 			fmt::format("{}/{}_{}.log", GetLogPath(), m_platform_file_name.c_str(), getpid()),
 			std::ios_base::app | std::ios_base::out
 		);
@@ -810,11 +1101,6 @@ EQEmuLogSys::LogEnabled EQEmuLogSys::GetLogsEnabled(const Logs::DebugLevel &debu
 	return e;
 }
 
-bool EQEmuLogSys::IsLogEnabled(const Logs::DebugLevel &debug_level, const uint16 &log_category)
-{
-	return GetLogsEnabled(debug_level, log_category).log_enabled;
-}
-
 const std::string &EQEmuLogSys::GetLogPath() const
 {
 	return m_log_path;
@@ -24,8 +24,14 @@
 #include <iostream>
 #include <fstream>
 #include <cstdio>
+#include <ctime>
 #include <functional>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #ifdef utf16_to_utf8
@@ -35,6 +41,19 @@
 
 #include <fmt/format.h>
 #include "types.h"
+#include "util/mpsc_ring.h"
+
+struct uv_async_s;
+
+/**
+ * Compile time log gates, set through the EQEMU_LOG_MAX_LEVEL and EQEMU_LOG_COMPILED_OUT_CATEGORIES cmake options
+ *
+ * EQEMU_LOG_MAX_LEVEL - highest debug level compiled in, 1 strips every Detail alias
+ * EQEMU_LOG_COMPILED_OUT_CATEGORIES - comma separated category names stripped entirely, ex: AIScanClose,Netcode
+ */
+#ifndef EQEMU_LOG_MAX_LEVEL
+#define EQEMU_LOG_MAX_LEVEL 2
+#endif
 
 namespace Logs {
 	enum DebugLevel {
@@ -260,6 +279,35 @@ namespace Logs {
 		"NpcHandin",
 		"ZoneState"
 	};
+
+	constexpr uint16 CompiledOutCategories[] = {
+		None,
+#ifdef EQEMU_LOG_COMPILED_OUT_CATEGORIES
+		EQEMU_LOG_COMPILED_OUT_CATEGORIES
+#endif
+	};
+
+	/**
+	 * Log aliases check this before anything else, a stripped category or level
+	 * never reaches IsLogEnabled or fmt::format
+	 */
+	constexpr bool IsCompiledIn(DebugLevel debug_level, uint16 log_category)
+	{
+		if (static_cast<int>(debug_level) > EQEMU_LOG_MAX_LEVEL) {
+			return false;
+		}
+
+		for (auto c : CompiledOutCategories) {
+			if (c != None && c == log_category) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<DebugLevel debug_level, uint16 log_category>
+	constexpr bool CompiledIn = IsCompiledIn(debug_level, log_category);
 }
 
 #include "eqemu_logsys_log_aliases.h"
@@ -316,6 +364,17 @@ public:
 	 */
 	void StartFileLogs(const std::string &log_name = "");
 
+	/**
+	 * Console and file output is handed to a background writer once started,
+	 * the calling thread only formats the message and pushes it into a ring buffer.
+	 * When the ring is full the message is dropped and counted rather than stalling the caller
+	 */
+	void StartAsyncSink(size_t capacity);
+	void StopAsyncSink();
+	void FlushAsyncSink();
+	bool IsAsyncSinkRunning() const { return m_sink_running.load(std::memory_order_acquire); }
+	uint64 GetDroppedLogCount() const { return m_sink_dropped.load(std::memory_order_relaxed); }
+
 	/**
      * LogSettings Struct
      *
@@ -362,7 +421,17 @@ public:
 	};
 
 	LogEnabled GetLogsEnabled(const Logs::DebugLevel &debug_level, const uint16 &log_category);
-	bool IsLogEnabled(const Logs::DebugLevel &debug_level, const uint16 &log_category);
+
+	inline bool IsLogEnabled(const Logs::DebugLevel &debug_level, const uint16 &log_category)
+	{
+		// nearly every call lands on a category with no output at all
+		const auto &s = log_settings[log_category];
+		if (!s.log_to_console && !s.log_to_file && !s.log_to_gmsay && !s.log_to_discord) {
+			return false;
+		}
+
+		return GetLogsEnabled(debug_level, log_category).log_enabled;
+	}
 
 	struct DiscordWebhooks {
 		int         id;
@@ -375,15 +444,19 @@ public:
 	// gmsay
 	uint16 GetGMSayColorFromCategory(uint16 log_category);
 
+	// the gmsay, discord and console hooks always run on the thread that set them, from its event loop
+	// when the log came from another thread
 	EQEmuLogSys *SetGMSayHandler(const std::function<void(uint16 log_type, const char *func, const std::string &)>& f)
 	{
 		m_on_log_gmsay_hook = f;
+		StartHookRelay();
 		return this;
 	}
 
 	EQEmuLogSys *SetDiscordHandler(std::function<void(uint16 log_category, int webhook_id, const std::string &)> f)
 	{
 		m_on_log_discord_hook = f;
+		StartHookRelay();
 		return this;
 	}
 
@@ -393,7 +466,7 @@ public:
 			uint16 log_type,
 			const std::string &
 		)> f
-	) { m_on_log_console_hook = f; }
+	) { m_on_log_console_hook = f; StartHookRelay(); }
 	void SilenceConsoleLogging();
 	void EnableConsoleLogging();
 
@@ -418,15 +491,55 @@ private:
 	int                                                                             m_log_platform      = 0;
 	std::string                                                                     m_platform_file_name;
 	std::string                                                                     m_log_path;
+	std::ofstream                                                                   m_process_log;
+
+	struct QueuedLog {
+		uint16      log_category = 0;
+		bool        to_console   = false;
+		bool        to_file      = false;
+		const char  *file        = "";
+		const char  *func        = "";
+		int         line         = 0;
+		time_t      logged_at    = 0;
+		std::string message;
+		std::string file_message;
+		std::string origination;
+	};
 
+	std::unique_ptr<EQ::Util::MPSCRing<QueuedLog>> m_sink;
+	std::thread                                    m_sink_thread;
+	std::mutex                                     m_sink_lock;
+	std::condition_variable                        m_sink_cv;
+	std::atomic<bool>                              m_sink_running{false};
+	std::atomic<uint64>                            m_sink_queued{0};
+	std::atomic<uint64>                            m_sink_written{0};
+	std::atomic<uint64>                            m_sink_dropped{0};
+	uint64                                         m_sink_reported_dropped = 0;
+	std::mutex                                     m_file_lock;
+
+	std::thread::id                                m_hook_thread;
+	uv_async_s                                     *m_hook_relay = nullptr;
+	std::mutex                                     m_hook_relay_lock;
+	std::vector<std::function<void()>>             m_relayed_hooks;
+	uint64                                         m_relayed_hooks_dropped = 0;
+
+	void StartHookRelay();
+	void RelayHook(std::function<void()> hook);
+	void RunRelayedHooks();
+
+	void ProcessAsyncSink();
+	bool DrainAsyncSink();
+	std::string GetOriginationSuffix() const;
 	void ProcessConsoleMessage(
 		uint16 log_category,
 		const std::string &message,
 		const char *file,
 		const char *func,
-		int line
+		int line,
+		const std::string &origination
 	);
-	void ProcessLogWrite(uint16 log_category, const std::string &message);
+	void ProcessLogWrite(uint16 log_category, const std::string &message, time_t logged_at);
+	static void FormatTimeStamp(time_t at, char *time_stamp);
 	void InjectTablesIfNotExist();
 };
 
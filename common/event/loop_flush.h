@@ -0,0 +1,71 @@
+#pragma once
+#include <functional>
+#include "event_loop.h"
+
+namespace EQ {
+	// Runs a callback once per loop iteration while started, from a prepare handle before the loop
+	// polls and from a check handle right after, so sends made from timers go out before the poll and
+	// sends made from reads go out as soon as the reads are done.
+	class LoopFlush
+	{
+	public:
+		LoopFlush(uv_loop_t *loop, std::function<void()> cb)
+		{
+			m_cb = cb;
+
+			m_prepare = new uv_prepare_t;
+			memset(m_prepare, 0, sizeof(uv_prepare_t));
+			uv_prepare_init(loop, m_prepare);
+			m_prepare->data = this;
+
+			m_check = new uv_check_t;
+			memset(m_check, 0, sizeof(uv_check_t));
+			uv_check_init(loop, m_check);
+			m_check->data = this;
+		}
+
+		// the handles are freed once their loop is done closing them, which can be after we're gone
+		~LoopFlush()
+		{
+			uv_close((uv_handle_t*)m_prepare, [](uv_handle_t *handle) {
+				delete (uv_prepare_t*)handle;
+			});
+
+			uv_close((uv_handle_t*)m_check, [](uv_handle_t *handle) {
+				delete (uv_check_t*)handle;
+			});
+		}
+
+		void Start()
+		{
+			uv_prepare_start(m_prepare, [](uv_prepare_t *handle) {
+				((LoopFlush*)handle->data)->m_cb();
+			});
+
+			uv_check_start(m_check, [](uv_check_t *handle) {
+				((LoopFlush*)handle->data)->m_cb();
+			});
+		}
+
+		void Stop()
+		{
+			uv_prepare_stop(m_prepare);
+			uv_check_stop(m_check);
+		}
+
+		// started handles don't keep the loop alive on their own
+		void Unref()
+		{
+			uv_unref((uv_handle_t*)m_prepare);
+			uv_unref((uv_handle_t*)m_check);
+		}
+
+	private:
+		LoopFlush(const LoopFlush&);
+		LoopFlush& operator=(const LoopFlush&);
+
+		uv_prepare_t *m_prepare;
+		uv_check_t *m_check;
+		std::function<void()> m_cb;
+	};
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include "../timer.h"
+
+namespace EQ {
+	// Hierarchical timing wheel, four levels of 64 slots at 1ms per tick (64ms, 4s, 4m22s, 4h39m)
+	//
+	// Entries sit in intrusive lists keyed by expiry so adding and cancelling are O(1) and an
+	// advance only touches the slots that come due, instead of every owner polling every timer
+	// each frame. Entries further out than the top level are parked in its last slot and re-filed
+	// when it cascades. The zone advances the wheel once per frame from its loop timer.
+	class TimingWheel
+	{
+	public:
+		class Entry
+		{
+		public:
+			Entry() = default;
+			Entry(const Entry &) = delete;
+			Entry &operator=(const Entry &) = delete;
+			virtual ~Entry() { Unlink(); }
+
+			bool Scheduled() const { return m_next != nullptr; }
+
+		protected:
+			virtual void OnExpire() = 0;
+
+		private:
+			friend class TimingWheel;
+
+			void Unlink()
+			{
+				if (m_next) {
+					m_prev->m_next = m_next;
+					m_next->m_prev = m_prev;
+					m_prev = nullptr;
+					m_next = nullptr;
+				}
+			}
+
+			Entry  *m_prev   = nullptr;
+			Entry  *m_next   = nullptr;
+			uint64 m_expires = 0;
+		};
+
+		static constexpr int    Levels   = 4;
+		static constexpr int    SlotBits = 6;
+		static constexpr uint64 Slots    = 1ull << SlotBits;
+		static constexpr uint64 SlotMask = Slots - 1;
+		static constexpr uint64 MaxDelay = (1ull << (Levels * SlotBits)) - 1;
+
+		TimingWheel()
+		{
+			for (auto &level : m_slots) {
+				for (auto &head : level) {
+					head.m_prev = &head;
+					head.m_next = &head;
+				}
+			}
+		}
+
+		TimingWheel(const TimingWheel &) = delete;
+		TimingWheel &operator=(const TimingWheel &) = delete;
+
+		static TimingWheel &Instance()
+		{
+			static TimingWheel instance;
+			return instance;
+		}
+
+		// schedules (or reschedules) an entry to expire delay_ms after the wheel's current time
+		void Schedule(Entry *e, uint64 delay_ms)
+		{
+			e->Unlink();
+			e->m_expires = m_now + std::clamp<uint64>(delay_ms, 1, MaxDelay);
+			File(e);
+		}
+
+		void Cancel(Entry *e) { e->Unlink(); }
+
+		// moves the wheel to now_ms, firing everything that came due on the way
+		void Advance(uint32 now_ms)
+		{
+			if (!m_started) {
+				m_started = true;
+				m_last    = now_ms;
+				m_offset  = now_ms - static_cast<uint32>(m_now);
+				return;
+			}
+
+			const uint64 target = m_now + static_cast<uint32>(now_ms - m_last);
+			m_last   = now_ms;
+			m_offset = now_ms - static_cast<uint32>(target);
+
+			while (m_now < target) {
+				Tick();
+			}
+		}
+
+		// clock time of the tick being processed, Timer::GetCurrentTime() as of the last advance otherwise
+		uint32 GetCurrentTime() const
+		{
+			return m_started ? static_cast<uint32>(m_now) + m_offset : ::Timer::GetCurrentTime();
+		}
+
+		size_t Count() const
+		{
+			size_t count = 0;
+			for (auto &level : m_slots) {
+				for (auto &head : level) {
+					for (auto e = head.m_next; e != &head; e = e->m_next) {
+						count++;
+					}
+				}
+			}
+
+			return count;
+		}
+
+	private:
+		class Head : public Entry
+		{
+		protected:
+			void OnExpire() override {}
+		};
+
+		void File(Entry *e)
+		{
+			const uint64 delta = e->m_expires - m_now;
+
+			int level = 0;
+			while (level < Levels - 1 && delta >= (1ull << ((level + 1) * SlotBits))) {
+				level++;
+			}
+
+			Head &head = m_slots[level][(e->m_expires >> (level * SlotBits)) & SlotMask];
+			e->m_prev           = head.m_prev;
+			e->m_next           = &head;
+			head.m_prev->m_next = e;
+			head.m_prev         = e;
+		}
+
+		// pulls a slot's entries into a local list so callbacks can freely schedule or cancel
+		void Splice(Head &from, Head &to)
+		{
+			if (from.m_next == &from) {
+				to.m_prev = &to;
+				to.m_next = &to;
+				return;
+			}
+
+			to.m_next         = from.m_next;
+			to.m_prev         = from.m_prev;
+			to.m_next->m_prev = &to;
+			to.m_prev->m_next = &to;
+			from.m_prev       = &from;
+			from.m_next       = &from;
+		}
+
+		void Tick()
+		{
+			++m_now;
+
+			// when a level wraps, re-file the next slot of the level above it
+			if ((m_now & SlotMask) == 0) {
+				for (int level = 1; level < Levels; ++level) {
+					const uint64 index = (m_now >> (level * SlotBits)) & SlotMask;
+
+					Head pending;
+					Splice(m_slots[level][index], pending);
+					while (pending.m_next != &pending) {
+						Entry *e = pending.m_next;
+						e->Unlink();
+						if (e->m_expires < m_now) {
+							e->m_expires = m_now;
+						}
+						File(e);
+					}
+
+					if (index != 0) {
+						break;
+					}
+				}
+			}
+
+			Head due;
+			Splice(m_slots[0][m_now & SlotMask], due);
+			while (due.m_next != &due) {
+				Entry *e = due.m_next;
+				e->Unlink();
+				e->OnExpire();
+			}
+		}
+
+		Head   m_slots[Levels][Slots];
+		uint64 m_now     = 0;
+		uint32 m_last    = 0;
+		uint32 m_offset  = 0;
+		bool   m_started = false;
+	};
+
+	// Drop in for the polled ::Timer whose expiry is delivered by the timing wheel
+	//
+	// Bookkeeping (start, duration, accurate timing, reset value) is the wrapped ::Timer so every
+	// caller sees identical semantics, but Check() is a flag test and costs nothing until the wheel
+	// marks it due. With a callback set the timer runs it on expiry and re-arms itself instead.
+	class WheelTimer : public TimingWheel::Entry
+	{
+	public:
+		WheelTimer(uint32 timer_time = 0, bool use_accurate_timing = false, TimingWheel &wheel = TimingWheel::Instance())
+			: m_wheel(wheel), m_timer(timer_time, use_accurate_timing)
+		{
+			Reschedule();
+		}
+
+		~WheelTimer() override = default;
+
+		bool Check(bool reset = true)
+		{
+			if (!m_due) {
+				return false;
+			}
+
+			if (!m_timer.Check(reset)) {
+				Reschedule();
+				return false;
+			}
+
+			if (reset) {
+				Reschedule();
+			}
+
+			return true;
+		}
+
+		void Enable() { m_timer.Enable(); Reschedule(); }
+		void Disable() { m_timer.Disable(); Reschedule(); }
+		void Start(uint32 set_timer_time = 0, bool change_reset_timer = true) { m_timer.Start(set_timer_time, change_reset_timer); Reschedule(); }
+		void SetTimer(uint32 set_timer_time = 0) { m_timer.SetTimer(set_timer_time); Reschedule(); }
+		void Trigger() { m_timer.Trigger(); Reschedule(); }
+		void SetAtTrigger(uint32 set_at_trigger, bool enable_if_disabled = false, bool change_timer_time = false)
+		{
+			m_timer.SetAtTrigger(set_at_trigger, enable_if_disabled, change_timer_time);
+			Reschedule();
+		}
+
+		uint32 GetRemainingTime() const { return m_timer.GetRemainingTime(); }
+		inline const uint32 &GetTimerTime() { return m_timer.GetTimerTime(); }
+		inline const uint32 &GetSetAtTrigger() { return m_timer.GetSetAtTrigger(); }
+		inline bool Enabled() { return m_timer.Enabled(); }
+		inline uint32 GetStartTime() { return m_timer.GetStartTime(); }
+		inline uint32 GetDuration() { return m_timer.GetDuration(); }
+
+		// run cb on every expiry instead of waiting for Check(), the timer re-arms before cb runs
+		void SetCallback(std::function<void()> cb) { m_cb = std::move(cb); }
+
+	protected:
+		void OnExpire() override
+		{
+			m_due = true;
+			if (m_cb && Check()) {
+				m_cb();
+			}
+		}
+
+	private:
+		// the polled timer fires once current_time - start_time > timer_time
+		void Reschedule()
+		{
+			m_due = false;
+			if (!m_timer.Enabled()) {
+				m_wheel.Cancel(this);
+				return;
+			}
+
+			const uint32 now    = m_wheel.GetCurrentTime();
+			const uint32 start  = m_timer.GetStartTime();
+			const uint64 length = m_timer.GetDuration();
+
+			// a start stamped from current_time can be ahead of the wheel while it is mid advance
+			if (static_cast<int32>(start - now) > 0) {
+				m_wheel.Schedule(this, length + (start - now) + 1);
+				return;
+			}
+
+			const uint64 elapsed = now - start;
+			m_wheel.Schedule(this, elapsed > length ? 1 : length - elapsed + 1);
+		}
+
+		TimingWheel           &m_wheel;
+		::Timer               m_timer;
+		std::function<void()> m_cb;
+		bool                  m_due = false;
+	};
+}
@@ -32,6 +32,12 @@
 #ifdef FREEBSD
 #include <sys/stat.h>
 #endif
+#ifdef __linux__
+#include <sys/vfs.h>
+#ifndef HUGETLBFS_MAGIC
+#define HUGETLBFS_MAGIC 0x958458f6
+#endif
+#endif
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -43,9 +49,47 @@ namespace EQ {
 		HANDLE mapped_object_;
 #else
 		int fd_;
+		size_t length_ = 0;
+		bool huge_tlb_ = false;
 #endif
 	};
 
+#ifndef _WINDOWS
+	// hugetlbfs files can only be sized and mapped in whole huge pages
+	static size_t MappingLength(int fd, size_t size, bool &huge_tlb) {
+		huge_tlb = false;
+#ifdef __linux__
+		struct statfs st;
+		if(fstatfs(fd, &st) == 0 && static_cast<uint32>(st.f_type) == HUGETLBFS_MAGIC && st.f_bsize > 0) {
+			huge_tlb = true;
+			size_t page = static_cast<size_t>(st.f_bsize);
+			return (size + page - 1) / page * page;
+		}
+#endif
+		return size;
+	}
+
+	static void Advise(void *addr, size_t length, const MemoryMappedFile::Options &options) {
+#ifndef MAP_POPULATE
+		if(options.populate) {
+			const long page = sysconf(_SC_PAGESIZE);
+			volatile unsigned char sink = 0;
+			for(size_t i = 0; i < length; i += page) {
+				sink ^= static_cast<volatile unsigned char*>(addr)[i];
+			}
+		}
+#endif
+#ifdef MADV_HUGEPAGE
+		if(options.huge_pages) {
+			madvise(addr, length, MADV_HUGEPAGE);
+		}
+#endif
+		if(options.will_need) {
+			madvise(addr, length, MADV_WILLNEED);
+		}
+	}
+#endif
+
 	MemoryMappedFile::MemoryMappedFile(std::string filename, uint32 size)
 		: filename_(filename), size_(size) {
 		imp_ = new Implementation;
@@ -92,12 +136,13 @@ namespace EQ {
 			EQ_EXCEPT("Shared Memory", "Could not open a file for this shared memory segment.");
 		}
 
-		if(ftruncate(imp_->fd_, total_size) == -1) {
+		imp_->length_ = MappingLength(imp_->fd_, total_size, imp_->huge_tlb_);
+		if(ftruncate(imp_->fd_, imp_->length_) == -1) {
 			EQ_EXCEPT("Shared Memory", "Could not set file size for this shared memory segment.");
 		}
 
 		memory_ = reinterpret_cast<shared_memory_struct*>(
-			mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_FILE | MAP_SHARED, imp_->fd_, 0));
+			mmap(nullptr, imp_->length_, PROT_READ | PROT_WRITE, MAP_FILE | MAP_SHARED, imp_->fd_, 0));
 
 		if(memory_ == MAP_FAILED) {
 			EQ_EXCEPT("Shared Memory", "Could not create a file mapping for this shared memory file.");
@@ -106,6 +151,10 @@ namespace EQ {
 	}
 
 	MemoryMappedFile::MemoryMappedFile(std::string filename)
+		: MemoryMappedFile(filename, Options()) {
+	}
+
+	MemoryMappedFile::MemoryMappedFile(std::string filename, const Options &options)
 		: filename_(filename) {
 		imp_ = new Implementation;
 
@@ -161,16 +210,26 @@ namespace EQ {
 			EQ_EXCEPT("Shared Memory", "Could not open a file for this shared memory segment.");
 		}
 
-		if(ftruncate(imp_->fd_, total_size) == -1) {
+		imp_->length_ = MappingLength(imp_->fd_, total_size, imp_->huge_tlb_);
+		if(ftruncate(imp_->fd_, imp_->length_) == -1) {
 			EQ_EXCEPT("Shared Memory", "Could not set file size for this shared memory segment.");
 		}
 
+		int flags = MAP_FILE | MAP_SHARED;
+#ifdef MAP_POPULATE
+		if(options.populate) {
+			flags |= MAP_POPULATE;
+		}
+#endif
+
 		memory_ = reinterpret_cast<shared_memory_struct*>(
-			mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_FILE | MAP_SHARED, imp_->fd_, 0));
+			mmap(nullptr, imp_->length_, PROT_READ | PROT_WRITE, flags, imp_->fd_, 0));
 
 		if(memory_ == MAP_FAILED) {
 			EQ_EXCEPT("Shared Memory", "Could not create a file mapping for this shared memory file.");
 		}
+
+		Advise(memory_, imp_->length_, options);
 #endif
 	}
 
@@ -181,14 +240,21 @@ namespace EQ {
 		}
 #else
 		if(memory_) {
-			size_t total_size = size_ + sizeof(shared_memory_struct);
-			munmap(reinterpret_cast<void*>(memory_), total_size);
+			munmap(reinterpret_cast<void*>(memory_), imp_->length_);
 			close(imp_->fd_);
 		}
 #endif
 		delete imp_;
 	}
 
+	bool MemoryMappedFile::IsHugeTLB() const {
+#ifdef _WINDOWS
+		return false;
+#else
+		return imp_->huge_tlb_;
+#endif
+	}
+
 	void MemoryMappedFile::ZeroFile() {
 		memset(reinterpret_cast<void*>(memory_), 0, sizeof(shared_memory_struct));
 		memset(memory_->data, 0, size_);
@@ -39,6 +39,17 @@ namespace EQ {
 			unsigned char data[1];
 		};
 	public:
+		//! Mapping Options
+		/*!
+			Hints applied when an existing file is mapped, all off by default. Segments kept on a hugetlbfs
+			mount are always backed by huge pages, huge_pages only matters for files on tmpfs.
+		*/
+		struct Options {
+			bool populate   = false; //!< Fault every page in up front (MAP_POPULATE)
+			bool huge_pages = false; //!< Ask for transparent huge pages (MADV_HUGEPAGE)
+			bool will_need  = false; //!< Start reading the file in ahead of the first lookups (MADV_WILLNEED)
+		};
+
 		//! Constructor
 		/*!
 			Creates a mmf for the given filename and of size.
@@ -54,6 +65,14 @@ namespace EQ {
 		*/
 		MemoryMappedFile(std::string filename);
 
+		//! Constructor
+		/*!
+			Creates a mmf for the given filename and gets the size based on the existing size.
+		\param filename Actual filename of the mmf.
+		\param options Paging hints for the mapping.
+		*/
+		MemoryMappedFile(std::string filename, const Options &options);
+
 		//! Destructor
 		~MemoryMappedFile();
 
@@ -68,6 +87,9 @@ namespace EQ {
 
 		//! Zeros all the memory in the file, and set it to be unloaded
 		void ZeroFile();
+
+		//! Whether the mapping is backed by a hugetlbfs file
+		bool IsHugeTLB() const;
 	private:
 		//! Copy Constructor
 		MemoryMappedFile(const MemoryMappedFile&);
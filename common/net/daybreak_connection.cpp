@@ -8,11 +8,50 @@
 #include <fmt/format.h>
 #include <sstream>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <errno.h>
+#endif
+
+// libuv hands recvmmsg reads out in 64KB chunks of the buffer it is given and reads at most 20 at once
+constexpr size_t DaybreakRecvChunkSize  = 64 * 1024;
+constexpr size_t DaybreakRecvChunkCount = 20;
+
+// one slab per datagram queued this loop iteration, the whole batch is sent when it runs out of slabs
+struct EQ::Net::DaybreakConnectionManager::SendBatch
+{
+	static constexpr size_t max_datagrams  = 64;
+	static constexpr size_t slab_size      = 1536;
+	static constexpr size_t max_gso_length = 65000;
+
+	SendBatch() : slabs(new char[max_datagrams * slab_size]) { }
+
+	char *Slab(size_t i) { return slabs.get() + i * slab_size; }
+
+	std::unique_ptr<char[]> slabs;
+	sockaddr_in             addrs[max_datagrams];
+	size_t                  lengths[max_datagrams];
+	size_t                  count = 0;
+	bool                    gso   = false;
+#ifdef __linux__
+	int     fd = -1;
+	mmsghdr msgs[max_datagrams];
+	iovec   iovs[max_datagrams];
+	union {
+		char    data[CMSG_SPACE(sizeof(uint16_t))];
+		cmsghdr align;
+	} control[max_datagrams];
+#endif
+};
+
 EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager()
 {
 	m_attached = nullptr;
-	memset(&m_timer, 0, sizeof(uv_timer_t));
-	memset(&m_socket, 0, sizeof(uv_udp_t));
+	m_recv_buffer_size = 0;
+	m_timer = nullptr;
+	m_socket = nullptr;
 
 	Attach(EQ::EventLoop::Get().Handle());
 }
@@ -20,9 +59,10 @@ EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager()
 EQ::Net::DaybreakConnectionManager::DaybreakConnectionManager(const DaybreakConnectionManagerOptions &opts)
 {
 	m_attached = nullptr;
+	m_recv_buffer_size = 0;
 	m_options = opts;
-	memset(&m_timer, 0, sizeof(uv_timer_t));
-	memset(&m_socket, 0, sizeof(uv_udp_t));
+	m_timer = nullptr;
+	m_socket = nullptr;
 
 	Attach(EQ::EventLoop::Get().Handle());
 }
@@ -35,34 +75,55 @@ EQ::Net::DaybreakConnectionManager::~DaybreakConnectionManager()
 void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 {
 	if (!m_attached) {
-		uv_timer_init(loop, &m_timer);
-		m_timer.data = this;
+		m_timer = new uv_timer_t;
+		memset(m_timer, 0, sizeof(uv_timer_t));
+		uv_timer_init(loop, m_timer);
+		m_timer->data = this;
 
 		auto update_rate = (uint64_t)(1000.0 / m_options.tic_rate_hertz);
 
-		uv_timer_start(&m_timer, [](uv_timer_t *handle) {
+		uv_timer_start(m_timer, [](uv_timer_t *handle) {
 			DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
 			c->UpdateDataBudget();
 			c->Process();
 			c->ProcessResend();
 		}, update_rate, update_rate);
 
-		uv_udp_init(loop, &m_socket);
-		m_socket.data = this;
+		m_socket = new uv_udp_t;
+		memset(m_socket, 0, sizeof(uv_udp_t));
+#if defined(__linux__) && UV_VERSION_HEX >= 0x012800
+		if (m_options.batched_io) {
+			uv_udp_init_ex(loop, m_socket, AF_INET | UV_UDP_RECVMMSG);
+		}
+		else {
+			uv_udp_init(loop, m_socket);
+		}
+#else
+		uv_udp_init(loop, m_socket);
+#endif
+		m_socket->data = this;
 		struct sockaddr_in recv_addr;
 		uv_ip4_addr("0.0.0.0", m_options.port, &recv_addr);
-		int rc = uv_udp_bind(&m_socket, (const struct sockaddr *)&recv_addr, UV_UDP_REUSEADDR);
+		int rc = uv_udp_bind(m_socket, (const struct sockaddr *)&recv_addr, UV_UDP_REUSEADDR);
 
-		rc = uv_udp_recv_start(&m_socket,
+		//every read lands in the same buffer, a datagram is processed before the next read is made
+		m_recv_buffer_size = DaybreakRecvChunkSize;
+#if defined(__linux__) && UV_VERSION_HEX >= 0x012800
+		if (uv_udp_using_recvmmsg(m_socket)) {
+			m_recv_buffer_size = DaybreakRecvChunkSize * DaybreakRecvChunkCount;
+		}
+#endif
+		m_recv_buffer.reset(new char[m_recv_buffer_size]);
+
+		rc = uv_udp_recv_start(m_socket,
 			[](uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
-			buf->base = new char[suggested_size];
-			memset(buf->base, 0, suggested_size);
-			buf->len = suggested_size;
+			DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
+			buf->base = c->m_recv_buffer.get();
+			buf->len = c->m_recv_buffer_size;
 		},
 			[](uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned flags) {
 			DaybreakConnectionManager *c = (DaybreakConnectionManager*)handle->data;
 			if (nread < 0 || addr == nullptr) {
-				delete[] buf->base;
 				return;
 			}
 
@@ -70,9 +131,26 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 			uv_ip4_name((const sockaddr_in*)addr, endpoint, 16);
 			auto port = ntohs(((const sockaddr_in*)addr)->sin_port);
 			c->ProcessPacket(endpoint, port, buf->base, nread);
-			delete[] buf->base;
 		});
 
+#ifdef __linux__
+		uv_os_fd_t fd;
+		if (m_options.batched_io && uv_fileno((uv_handle_t*)m_socket, &fd) == 0) {
+			m_send_batch.reset(new SendBatch());
+			m_send_batch->fd = fd;
+
+#ifdef UDP_SEGMENT
+			int segment = 0;
+			socklen_t segment_length = sizeof(segment);
+			m_send_batch->gso = getsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &segment, &segment_length) == 0;
+#endif
+
+			m_flush.reset(new EQ::LoopFlush(loop, [this]() { FlushSendBatch(); }));
+			m_flush->Start();
+			m_flush->Unref();
+		}
+#endif
+
 		m_attached = loop;
 	}
 }
@@ -80,8 +158,24 @@ void EQ::Net::DaybreakConnectionManager::Attach(uv_loop_t *loop)
 void EQ::Net::DaybreakConnectionManager::Detach()
 {
 	if (m_attached) {
-		uv_udp_recv_stop(&m_socket);
-		uv_timer_stop(&m_timer);
+		FlushSendBatch();
+		m_send_batch.reset();
+
+		//the handles are freed once the loop is done closing them, which can be after we're gone
+		uv_udp_recv_stop(m_socket);
+		uv_close((uv_handle_t*)m_socket, [](uv_handle_t* handle) {
+			delete (uv_udp_t*)handle;
+		});
+		m_socket = nullptr;
+
+		uv_timer_stop(m_timer);
+		uv_close((uv_handle_t*)m_timer, [](uv_handle_t* handle) {
+			delete (uv_timer_t*)handle;
+		});
+		m_timer = nullptr;
+
+		m_flush.reset();
+
 		m_attached = nullptr;
 	}
 }
@@ -100,6 +194,22 @@ void EQ::Net::DaybreakConnectionManager::Connect(const std::string &addr, int po
 	m_connections.emplace(std::make_pair(std::make_pair(addr, port), connection));
 }
 
+//the port the socket is bound to, which the system picks when the options ask for 0
+int EQ::Net::DaybreakConnectionManager::LocalPort() const
+{
+	if (!m_socket) {
+		return 0;
+	}
+
+	sockaddr_storage addr;
+	int addr_len = sizeof(addr);
+	if (uv_udp_getsockname(m_socket, (sockaddr*)&addr, &addr_len) != 0 || addr.ss_family != AF_INET) {
+		return 0;
+	}
+
+	return ntohs(((sockaddr_in*)&addr)->sin_port);
+}
+
 void EQ::Net::DaybreakConnectionManager::Process()
 {
 	auto now = Clock::now();
@@ -270,20 +380,195 @@ void EQ::Net::DaybreakConnectionManager::SendDisconnect(const std::string &addr,
 	DynamicPacket out;
 	out.PutSerialize(0, header);
 
-	uv_udp_send_t *send_req = new uv_udp_send_t;
 	sockaddr_in send_addr;
 	uv_ip4_addr(addr.c_str(), port, &send_addr);
+	SendDatagram(send_addr, (const char*)out.Data(), out.Length());
+}
+
+char *EQ::Net::DaybreakConnectionManager::ReserveDatagram(size_t length)
+{
+	if (!m_send_batch || length > SendBatch::slab_size) {
+		return nullptr;
+	}
+
+	//libuv is still holding datagrams the kernel wouldn't take, stay behind them so nothing is reordered
+	if (m_socket->send_queue_count > 0) {
+		FlushSendBatch();
+		return nullptr;
+	}
+
+	return m_send_batch->Slab(m_send_batch->count);
+}
+
+void EQ::Net::DaybreakConnectionManager::CommitDatagram(const sockaddr_in &addr, size_t length)
+{
+	auto &b = *m_send_batch;
+	b.addrs[b.count] = addr;
+	b.lengths[b.count] = length;
+	b.count++;
+
+	if (b.count == SendBatch::max_datagrams) {
+		FlushSendBatch();
+	}
+}
+
+void EQ::Net::DaybreakConnectionManager::SendDatagram(const sockaddr_in &addr, const char *data, size_t length)
+{
+	char *slab = ReserveDatagram(length);
+	if (slab) {
+		memcpy(slab, data, length);
+		CommitDatagram(addr, length);
+		return;
+	}
+
+	SendUnbatched(addr, data, length);
+}
+
+void EQ::Net::DaybreakConnectionManager::SendUnbatched(const sockaddr_in &addr, const char *data, size_t length)
+{
+	if (!m_socket) {
+		return;
+	}
+
+	uv_udp_send_t *send_req = new uv_udp_send_t;
+	memset(send_req, 0, sizeof(*send_req));
 	uv_buf_t send_buffers[1];
 
-	char *data = new char[out.Length()];
-	memcpy(data, out.Data(), out.Length());
-	send_buffers[0] = uv_buf_init(data, out.Length());
+	char *copy = new char[length];
+	memcpy(copy, data, length);
+	send_buffers[0] = uv_buf_init(copy, (unsigned int)length);
 	send_req->data = send_buffers[0].base;
-	int ret = uv_udp_send(send_req, &m_socket, send_buffers, 1, (sockaddr*)&send_addr,
+	int ret = uv_udp_send(send_req, m_socket, send_buffers, 1, (const sockaddr*)&addr,
 		[](uv_udp_send_t* req, int status) {
 		delete[](char*)req->data;
 		delete req;
 	});
+
+	if (ret < 0) {
+		delete[] copy;
+		delete send_req;
+	}
+}
+
+void EQ::Net::DaybreakConnectionManager::FlushSendBatch()
+{
+	if (!m_send_batch || m_send_batch->count == 0) {
+		return;
+	}
+
+	auto &b = *m_send_batch;
+
+#ifdef __linux__
+	auto send_unbatched = [this, &b](const mmsghdr &m) {
+		for (size_t i = 0; i < m.msg_hdr.msg_iovlen; ++i) {
+			auto &iov = m.msg_hdr.msg_iov[i];
+			SendUnbatched(*(const sockaddr_in*)m.msg_hdr.msg_name, (const char*)iov.iov_base, iov.iov_len);
+		}
+	};
+
+	//one message per datagram, or with gso one message for a run of datagrams to the same client where
+	//every one is the same size as the first except maybe the last, which the kernel splits back apart
+	size_t messages = 0;
+	for (size_t i = 0; i < b.count;) {
+		size_t segments = 1;
+		if (b.gso) {
+			size_t total = b.lengths[i];
+			while (i + segments < b.count) {
+				auto &next_addr = b.addrs[i + segments];
+				auto next_length = b.lengths[i + segments];
+				if (next_addr.sin_addr.s_addr != b.addrs[i].sin_addr.s_addr || next_addr.sin_port != b.addrs[i].sin_port ||
+					next_length > b.lengths[i] || total + next_length > SendBatch::max_gso_length) {
+					break;
+				}
+
+				total += next_length;
+				segments++;
+
+				if (next_length < b.lengths[i]) {
+					break;
+				}
+			}
+		}
+
+		for (size_t s = i; s < i + segments; ++s) {
+			b.iovs[s].iov_base = b.Slab(s);
+			b.iovs[s].iov_len = b.lengths[s];
+		}
+
+		auto &m = b.msgs[messages];
+		memset(&m, 0, sizeof(m));
+		m.msg_hdr.msg_name = &b.addrs[i];
+		m.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		m.msg_hdr.msg_iov = &b.iovs[i];
+		m.msg_hdr.msg_iovlen = segments;
+
+#ifdef UDP_SEGMENT
+		if (segments > 1) {
+			m.msg_hdr.msg_control = b.control[messages].data;
+			m.msg_hdr.msg_controllen = sizeof(b.control[messages].data);
+
+			cmsghdr *cm = CMSG_FIRSTHDR(&m.msg_hdr);
+			cm->cmsg_level = IPPROTO_UDP;
+			cm->cmsg_type = UDP_SEGMENT;
+			cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+			*(uint16_t*)CMSG_DATA(cm) = (uint16_t)b.lengths[i];
+		}
+#endif
+
+		messages++;
+		i += segments;
+	}
+
+	//libuv already has datagrams queued, everything goes in behind them
+	if (m_socket->send_queue_count > 0) {
+		for (size_t i = 0; i < messages; ++i) {
+			send_unbatched(b.msgs[i]);
+		}
+
+		b.count = 0;
+		return;
+	}
+
+	size_t sent = 0;
+	while (sent < messages) {
+		int rc = sendmmsg(b.fd, &b.msgs[sent], (unsigned int)(messages - sent), 0);
+		if (rc > 0) {
+			sent += rc;
+			continue;
+		}
+
+		if (rc < 0 && errno == EINTR) {
+			continue;
+		}
+
+		//the kernel is backed up, libuv queues the rest and sends it once the socket is writable again
+		if (rc == 0 || errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+			for (; sent < messages; ++sent) {
+				send_unbatched(b.msgs[sent]);
+			}
+			break;
+		}
+
+		//a device that can't offload the segmentation fails the whole message, try it again a datagram at a time
+		if (b.msgs[sent].msg_hdr.msg_iovlen > 1) {
+			if (errno == EIO) {
+				LogNetcode("UDP GSO isn't supported for this route, sending datagrams individually");
+				b.gso = false;
+			}
+
+			send_unbatched(b.msgs[sent]);
+		}
+
+		//anything else is lost the same as a failed uv_udp_send
+		sent++;
+	}
+#else
+	for (size_t i = 0; i < b.count; ++i) {
+		SendUnbatched(b.addrs[i], b.Slab(i), b.lengths[i]);
+	}
+#endif
+
+	b.count = 0;
 }
 
 //new connection made as server
@@ -295,6 +580,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_status = StatusConnected;
 	m_endpoint = endpoint;
 	m_port = port;
+	uv_ip4_addr(m_endpoint.c_str(), m_port, &m_endpoint_addr);
 	m_connect_code = NetworkToHost(connect.connect_code);
 	m_encode_key = m_owner->m_rand.Int(std::numeric_limits<uint32_t>::min(), std::numeric_limits<uint32_t>::max());
 	m_max_packet_size = (uint32_t)std::min(owner->m_options.max_packet_size, (size_t)NetworkToHost(connect.max_packet_size));
@@ -304,6 +590,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_hold_time = Clock::now();
 	m_buffered_packets_length = 0;
 	m_rolling_ping = 500;
+	m_ping_deviation = 0;
 	m_combined.reset(new char[512]);
 	m_combined[0] = 0;
 	m_combined[1] = OP_Combined;
@@ -322,6 +609,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_status = StatusConnecting;
 	m_endpoint = endpoint;
 	m_port = port;
+	uv_ip4_addr(m_endpoint.c_str(), m_port, &m_endpoint_addr);
 	m_connect_code = m_owner->m_rand.Int(std::numeric_limits<uint32_t>::min(), std::numeric_limits<uint32_t>::max());
 	m_encode_key = 0;
 	m_max_packet_size = (uint32_t)owner->m_options.max_packet_size;
@@ -329,6 +617,7 @@ EQ::Net::DaybreakConnection::DaybreakConnection(DaybreakConnectionManager *owner
 	m_hold_time = Clock::now();
 	m_buffered_packets_length = 0;
 	m_rolling_ping = 500;
+	m_ping_deviation = 0;
 	m_combined.reset(new char[512]);
 	m_combined[0] = 0;
 	m_combined[1] = OP_Combined;
@@ -354,17 +643,17 @@ void EQ::Net::DaybreakConnection::Close()
 	}
 }
 
-void EQ::Net::DaybreakConnection::QueuePacket(Packet &p)
+void EQ::Net::DaybreakConnection::QueuePacket(const Packet &p)
 {
 	QueuePacket(p, 0, true);
 }
 
-void EQ::Net::DaybreakConnection::QueuePacket(Packet &p, int stream)
+void EQ::Net::DaybreakConnection::QueuePacket(const Packet &p, int stream)
 {
 	QueuePacket(p, stream, true);
 }
 
-void EQ::Net::DaybreakConnection::QueuePacket(Packet &p, int stream, bool reliable)
+void EQ::Net::DaybreakConnection::QueuePacket(const Packet &p, int stream, bool reliable)
 {
 	if (*(char*)p.Data() == 0) {
 		DynamicPacket packet;
@@ -382,6 +671,11 @@ EQ::Net::DaybreakConnectionStats EQ::Net::DaybreakConnection::GetStats()
 	EQ::Net::DaybreakConnectionStats ret = m_stats;
 	ret.datarate_remaining = m_outgoing_budget;
 	ret.avg_ping = m_rolling_ping;
+	ret.ping_deviation = m_ping_deviation;
+	ret.sent_window = 0;
+	for (auto &s : m_streams) {
+		ret.sent_window += s.sent_count;
+	}
 
 	return ret;
 }
@@ -646,11 +940,11 @@ void EQ::Net::DaybreakConnection::ProcessDecodedPacket(const Packet &p)
 					auto reply = p.GetSerialize<DaybreakConnectReply>(0);
 
 					if (m_connect_code == reply.connect_code) {
-						m_encode_key = reply.encode_key;
+						m_encode_key = NetworkToHost(reply.encode_key);
 						m_crc_bytes = reply.crc_bytes;
 						m_encode_passes[0] = (DaybreakEncodeType)reply.encode_pass1;
 						m_encode_passes[1] = (DaybreakEncodeType)reply.encode_pass2;
-						m_max_packet_size = reply.max_packet_size;
+						m_max_packet_size = NetworkToHost(reply.max_packet_size);
 						ChangeStatus(StatusConnected);
 
 						LogNetcode(
@@ -909,7 +1203,7 @@ void EQ::Net::DaybreakConnection::ChangeStatus(DbProtocolStatus new_status)
 	m_status = new_status;
 }
 
-bool EQ::Net::DaybreakConnection::PacketCanBeEncoded(Packet &p) const
+bool EQ::Net::DaybreakConnection::PacketCanBeEncoded(const Packet &p) const
 {
 	if (p.Length() < 2) {
 		return false;
@@ -968,89 +1262,131 @@ void EQ::Net::DaybreakConnection::Encode(Packet &p, size_t offset, size_t length
 	}
 }
 
-uint32_t Inflate(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len) {
+struct EQ::Net::DaybreakCompressionContext::Streams
+{
+	Streams() {
+		memset(&inflate_stream, 0, sizeof(inflate_stream));
+		memset(&deflate_stream, 0, sizeof(deflate_stream));
+	}
+
+	z_stream inflate_stream;
+	z_stream deflate_stream;
+	bool inflate_ready = false;
+	bool deflate_ready = false;
+};
+
+EQ::Net::DaybreakCompressionContext::DaybreakCompressionContext()
+	: m_streams(std::make_unique<Streams>())
+{
+}
+
+EQ::Net::DaybreakCompressionContext::~DaybreakCompressionContext()
+{
+	if (m_streams->inflate_ready) {
+		inflateEnd(&m_streams->inflate_stream);
+	}
+
+	if (m_streams->deflate_ready) {
+		deflateEnd(&m_streams->deflate_stream);
+	}
+}
+
+EQ::Net::DaybreakCompressionContext &EQ::Net::DaybreakCompressionContext::ForThread()
+{
+	thread_local DaybreakCompressionContext context;
+	return context;
+}
+
+uint32_t EQ::Net::DaybreakCompressionContext::Inflate(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len) {
 	if (!in) {
 		return 0;
 	}
 
-	z_stream zstream;
-	memset(&zstream, 0, sizeof(zstream));
-	int zerror = 0;
-	int i;
+	z_stream &zstream = m_streams->inflate_stream;
+
+	// the stream is set up once and reset per packet, a reset is also how we recover from a bad packet
+	if (!m_streams->inflate_ready) {
+		if (inflateInit2(&zstream, 15) != Z_OK) {
+			return 0;
+		}
+
+		m_streams->inflate_ready = true;
+	}
+	else if (inflateReset(&zstream) != Z_OK) {
+		return 0;
+	}
 
 	zstream.next_in = const_cast<unsigned char *>(in);
 	zstream.avail_in = in_len;
 	zstream.next_out = out;
 	zstream.avail_out = out_len;
-	zstream.opaque = Z_NULL;
 
-	i = inflateInit2(&zstream, 15);
+	int zerror = inflate(&zstream, Z_FINISH);
 
-	if (i != Z_OK) {
-		return 0;
+	if (zerror == Z_STREAM_END) {
+		return (uint32_t)zstream.total_out;
 	}
 
-	zerror = inflate(&zstream, Z_FINISH);
+	return 0;
+}
 
-	if (zerror == Z_STREAM_END) {
-		inflateEnd(&zstream);
-		return zstream.total_out;
+uint32_t EQ::Net::DaybreakCompressionContext::Deflate(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len) {
+	if (!in) {
+		return 0;
 	}
-	else {
-		if (zerror == Z_MEM_ERROR && !zstream.msg)
-		{
+
+	z_stream &zstream = m_streams->deflate_stream;
+
+	// deflateReset keeps the level and window so the output is identical to a fresh deflateInit
+	if (!m_streams->deflate_ready) {
+		if (deflateInit(&zstream, Z_BEST_SPEED) != Z_OK) {
 			return 0;
 		}
 
-		zerror = inflateEnd(&zstream);
-		return 0;
+		m_streams->deflate_ready = true;
 	}
-}
-
-uint32_t Deflate(const uint8_t* in, uint32_t in_len, uint8_t* out, uint32_t out_len) {
-	if (!in) {
+	else if (deflateReset(&zstream) != Z_OK) {
 		return 0;
 	}
 
-	z_stream zstream;
-	memset(&zstream, 0, sizeof(zstream));
-	int zerror;
-
 	zstream.next_in = const_cast<unsigned char *>(in);
 	zstream.avail_in = in_len;
-	zstream.opaque = Z_NULL;
-
-	deflateInit(&zstream, Z_BEST_SPEED);
 	zstream.next_out = out;
 	zstream.avail_out = out_len;
 
-	zerror = deflate(&zstream, Z_FINISH);
+	int zerror = deflate(&zstream, Z_FINISH);
 
-	if (zerror == Z_STREAM_END)
-	{
-		deflateEnd(&zstream);
-		return zstream.total_out;
-	}
-	else {
-		zerror = deflateEnd(&zstream);
-		return 0;
+	if (zerror == Z_STREAM_END) {
+		return (uint32_t)zstream.total_out;
 	}
+
+	return 0;
 }
 
+constexpr size_t DaybreakCompressionBufferSize = 4096;
+
 void EQ::Net::DaybreakConnection::Decompress(Packet &p, size_t offset, size_t length)
 {
 	if (length < 2) {
 		return;
 	}
 
-	static uint8_t new_buffer[4096];
+	if (!m_compression_buffer) {
+		m_compression_buffer.reset(new uint8_t[DaybreakCompressionBufferSize]);
+	}
+
+	uint8_t *new_buffer = m_compression_buffer.get();
 	uint8_t *buffer = (uint8_t*)p.Data() + offset;
 	uint32_t new_length = 0;
 
 	if (buffer[0] == 0x5a) {
-		new_length = Inflate(buffer + 1, (uint32_t)length - 1, new_buffer, 4096);
+		new_length = DaybreakCompressionContext::ForThread().Inflate(buffer + 1, (uint32_t)length - 1, new_buffer, DaybreakCompressionBufferSize);
 	}
 	else if (buffer[0] == 0xa5) {
+		if (length - 1 > DaybreakCompressionBufferSize) {
+			return;
+		}
+
 		memcpy(new_buffer, buffer + 1, length - 1);
 		new_length = (uint32_t)length - 1;
 	}
@@ -1064,13 +1400,21 @@ void EQ::Net::DaybreakConnection::Decompress(Packet &p, size_t offset, size_t le
 
 void EQ::Net::DaybreakConnection::Compress(Packet &p, size_t offset, size_t length)
 {
-	uint8_t new_buffer[2048] = { 0 };
+	if (length + 1 > DaybreakCompressionBufferSize) {
+		return;
+	}
+
+	if (!m_compression_buffer) {
+		m_compression_buffer.reset(new uint8_t[DaybreakCompressionBufferSize]);
+	}
+
+	uint8_t *new_buffer = m_compression_buffer.get();
 	uint8_t *buffer = (uint8_t*)p.Data() + offset;
 	uint32_t new_length = 0;
 	bool send_uncompressed = true;
 
 	if (length > 30) {
-		new_length = Deflate(buffer, (uint32_t)length, new_buffer + 1, 2048) + 1;
+		new_length = DaybreakCompressionContext::ForThread().Deflate(buffer, (uint32_t)length, new_buffer + 1, DaybreakCompressionBufferSize - 1) + 1;
 		new_buffer[0] = 0x5a;
 		send_uncompressed = (new_length > length);
 	}
@@ -1084,88 +1428,50 @@ void EQ::Net::DaybreakConnection::Compress(Packet &p, size_t offset, size_t leng
 	p.PutData(offset, new_buffer, new_length);
 }
 
-void EQ::Net::DaybreakConnection::ProcessResend()
-{
-	for (int i = 0; i < 4; ++i) {
-		ProcessResend(i);
-	}
-}
-
 // observed client receive window is 300 packets, 140KB
 constexpr size_t MAX_CLIENT_RECV_PACKETS_PER_WINDOW = 300;
 constexpr size_t MAX_CLIENT_RECV_BYTES_PER_WINDOW   = 140 * 1024;
 
-void EQ::Net::DaybreakConnection::ProcessResend(int stream)
+void EQ::Net::DaybreakConnection::ProcessResend()
 {
 	if (m_status == DbProtocolStatus::StatusDisconnected) {
 		return;
 	}
 
-	if (m_streams[stream].sent_packets.empty()) {
-		return;
-	}
-
-	m_resend_packets_sent = 0;
-	m_resend_bytes_sent = 0;
-
-	auto now = Clock::now(); // Current time
-	auto s = &m_streams[stream];
-
-	// Get a reference resend delay (assume first packet represents the typical case)
-	if (!s->sent_packets.empty()) {
-		// Check if the first packet has timed out
-		auto &first_packet = s->sent_packets.begin()->second;
-		auto time_since_first_sent = std::chrono::duration_cast<std::chrono::milliseconds>(now - first_packet.first_sent).count();
+	size_t resend_packets_sent = 0;
+	size_t resend_bytes_sent = 0;
+	auto now = Clock::now();
 
-		// make sure that the first_packet in the list first_sent time is within the resend_delay and now
-		// if it is not, then we need to resend all packets in the list
-		if (time_since_first_sent <= first_packet.resend_delay && !m_acked_since_last_resend) {
-			LogNetcodeDetail(
-				"Not resending packets for stream [{}] time since first sent [{}] resend delay [{}] m_acked_since_last_resend [{}]",
-				stream,
-				time_since_first_sent,
-				first_packet.resend_delay,
-				m_acked_since_last_resend
-			);
-			return;
+	//only packets that are due come off the queue, the rest of the window isn't looked at
+	while (!m_resend_queue.empty() && m_resend_queue.top().at <= now) {
+		auto resend = m_resend_queue.top();
+		auto sp = FindSentPacket(resend.stream, resend.sequence);
+		if (sp == nullptr || sp->resend_at != resend.at) {
+			m_resend_queue.pop();
+			continue;
 		}
 
-		if (time_since_first_sent >= m_owner->m_options.resend_timeout) {
+		if ((size_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - sp->first_sent).count() >= m_owner->m_options.resend_timeout) {
 			Close();
 			return;
 		}
-	}
-
-	if (LogSys.IsLogEnabled(Logs::Detail, Logs::Netcode)) {
-		size_t    total_size = 0;
-		for (auto &e: s->sent_packets) {
-			total_size += e.second.packet.Length();
-		}
-
-		LogNetcodeDetail(
-			"Resending packets for stream [{}] packet count [{}] total packet size [{}] m_acked_since_last_resend [{}]",
-			stream,
-			s->sent_packets.size(),
-			total_size,
-			m_acked_since_last_resend
-		);
-	}
 
-	for (auto &e: s->sent_packets) {
-		if (m_resend_packets_sent >= MAX_CLIENT_RECV_PACKETS_PER_WINDOW ||
-			m_resend_bytes_sent >= MAX_CLIENT_RECV_BYTES_PER_WINDOW) {
+		//what is left stays due and goes first next tick
+		if (resend_packets_sent >= MAX_CLIENT_RECV_PACKETS_PER_WINDOW ||
+			resend_bytes_sent >= MAX_CLIENT_RECV_BYTES_PER_WINDOW) {
 			LogNetcodeDetail(
-				"Stopping resend because we hit thresholds m_resend_packets_sent [{}] max [{}] m_resend_bytes_sent [{}] max [{}]",
-				m_resend_packets_sent,
+				"Stopping resend because we hit thresholds resend_packets_sent [{}] max [{}] resend_bytes_sent [{}] max [{}]",
+				resend_packets_sent,
 				MAX_CLIENT_RECV_PACKETS_PER_WINDOW,
-				m_resend_bytes_sent,
+				resend_bytes_sent,
 				MAX_CLIENT_RECV_BYTES_PER_WINDOW
 			);
 			break;
 		}
 
-		auto &sp = e.second;
-		auto &p  = sp.packet;
+		m_resend_queue.pop();
+
+		auto &p = sp->packet;
 		if (p.Length() >= DaybreakHeader::size()) {
 			if (p.GetInt8(0) == 0 && p.GetInt8(1) >= OP_Fragment && p.GetInt8(1) <= OP_Fragment4) {
 				m_stats.resent_fragments++;
@@ -1179,45 +1485,181 @@ void EQ::Net::DaybreakConnection::ProcessResend(int stream)
 		}
 		m_stats.resent_packets++;
 
-		// Resend the packet
 		InternalBufferedSend(p);
 
-		m_resend_packets_sent++;
-		m_resend_bytes_sent += p.Length();
-		sp.last_sent = now;
-		sp.times_resent++;
-		sp.resend_delay = EQ::Clamp(
-			sp.resend_delay * 2,
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max
-		);
+		resend_packets_sent++;
+		resend_bytes_sent += p.Length();
+		sp->last_sent = now;
+		sp->times_resent++;
+
+		//a packet that timed out backs off, doubling the time from when it was first sent as it always has.
+		//one an ack showed was lost is only waited on for as long as the current ping says
+		if (sp->lost) {
+			sp->resend_delay = EQ::Clamp(
+				static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
+				m_owner->m_options.resend_delay_min,
+				m_owner->m_options.resend_delay_max);
+			sp->resend_at = now + std::chrono::milliseconds(sp->resend_delay);
+		}
+		else {
+			sp->resend_delay = EQ::Clamp(
+				sp->resend_delay * 2,
+				m_owner->m_options.resend_delay_min,
+				m_owner->m_options.resend_delay_max
+			);
+			sp->resend_at = std::max(
+				sp->first_sent + std::chrono::milliseconds(sp->resend_delay),
+				now + std::chrono::milliseconds(m_owner->m_options.resend_delay_min)
+			);
+		}
+
+		sp->lost = false;
+		m_resend_queue.push({ sp->resend_at, sp->sequence, resend.stream });
 	}
 
-	m_acked_since_last_resend = false;
+	if (resend_packets_sent > 0) {
+		//what was just resent can be lost again, later out of order acks get to look at it once more
+		for (auto &s : m_streams) {
+			s.fast_resend_next = s.sent_first;
+		}
+
+		LogNetcodeDetail(
+			"Resent packets count [{}] total packet size [{}] still queued [{}]",
+			resend_packets_sent,
+			resend_bytes_sent,
+			m_resend_queue.size()
+		);
+	}
 }
 
-void EQ::Net::DaybreakConnection::Ack(int stream, uint16_t seq)
+EQ::Net::DaybreakConnection::DaybreakSentPacket& EQ::Net::DaybreakConnection::AddSentPacket(int stream)
 {
+	auto s = &m_streams[stream];
+	size_t span = (uint16_t)(s->sequence_out - s->sent_first);
+
+	if (span >= s->sent_packets.size()) {
+		std::vector<DaybreakSentPacket> grown(s->sent_packets.empty() ? 64 : s->sent_packets.size() * 2);
+		for (auto &sp : s->sent_packets) {
+			if (sp.in_use) {
+				grown[sp.sequence & (grown.size() - 1)] = std::move(sp);
+			}
+		}
+
+		s->sent_packets.swap(grown);
+	}
 
 	auto now = Clock::now();
+	auto &sent = s->sent_packets[s->sequence_out & (s->sent_packets.size() - 1)];
+	sent.packet.Clear();
+	sent.last_sent = now;
+	sent.first_sent = now;
+	sent.times_resent = 0;
+	sent.resend_delay = EQ::Clamp(
+		static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
+		m_owner->m_options.resend_delay_min,
+		m_owner->m_options.resend_delay_max);
+	sent.resend_at = now + std::chrono::milliseconds(sent.resend_delay);
+	sent.sequence = s->sequence_out;
+	sent.in_use = true;
+	sent.lost = false;
+
+	s->sent_count++;
+	m_resend_queue.push({ sent.resend_at, sent.sequence, (uint8_t)stream });
+
+	size_t window = 0;
+	for (auto &st : m_streams) {
+		window += st.sent_count;
+	}
+
+	m_stats.max_sent_window = std::max(m_stats.max_sent_window, (uint64_t)window);
+
+	return sent;
+}
+
+EQ::Net::DaybreakConnection::DaybreakSentPacket* EQ::Net::DaybreakConnection::FindSentPacket(int stream, uint16_t seq)
+{
 	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.begin();
-	while (iter != s->sent_packets.end()) {
-		auto order = CompareSequence(seq, iter->first);
+	if ((uint16_t)(seq - s->sent_first) >= (uint16_t)(s->sequence_out - s->sent_first)) {
+		return nullptr;
+	}
+
+	auto &sent = s->sent_packets[seq & (s->sent_packets.size() - 1)];
+	if (!sent.in_use || sent.sequence != seq) {
+		return nullptr;
+	}
 
-		if (order != SequenceFuture) {
-			uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
+	return &sent;
+}
 
-			m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-			m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-			m_stats.last_ping = round_time;
-			m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
+void EQ::Net::DaybreakConnection::RemoveSentPacket(int stream, DaybreakSentPacket &sent)
+{
+	auto s = &m_streams[stream];
+	sent.in_use = false;
+	s->sent_count--;
 
-			iter = s->sent_packets.erase(iter);
-			m_acked_since_last_resend = true;
+	while (s->sent_first != s->sequence_out && !s->sent_packets[s->sent_first & (s->sent_packets.size() - 1)].in_use) {
+		s->sent_first++;
+	}
+}
+
+void EQ::Net::DaybreakConnection::UpdatePing(const DaybreakSentPacket &sent, Timestamp now)
+{
+	//an ack for a resent packet could be for any of its copies, it says nothing reliable about the ping
+	if (sent.times_resent > 0) {
+		return;
+	}
+
+	uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - sent.last_sent).count();
+
+	m_stats.max_ping = std::max(m_stats.max_ping, round_time);
+	m_stats.min_ping = std::min(m_stats.min_ping, round_time);
+	m_stats.last_ping = round_time;
+
+	size_t deviation = round_time > m_rolling_ping ? round_time - m_rolling_ping : m_rolling_ping - round_time;
+	m_ping_deviation = (m_ping_deviation * 3 + deviation) / 4;
+	m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
+}
+
+void EQ::Net::DaybreakConnection::Ack(int stream, uint16_t seq)
+{
+	auto now = Clock::now();
+	auto s = &m_streams[stream];
+	Timestamp acked_sent;
+	bool acked = false;
+
+	//everything from the front of the window up to seq, gaps left by out of order acks included
+	while (s->sent_first != s->sequence_out && CompareSequence(seq, s->sent_first) != SequenceFuture) {
+		auto &sent = s->sent_packets[s->sent_first & (s->sent_packets.size() - 1)];
+		if (sent.in_use) {
+			acked_sent = acked ? std::max(acked_sent, AckedSendTime(sent, now)) : AckedSendTime(sent, now);
+			acked = true;
+			UpdatePing(sent, now);
+			RemoveSentPacket(stream, sent);
 		}
 		else {
-			++iter;
+			s->sent_first++;
+		}
+	}
+
+	if (!acked) {
+		return;
+	}
+
+	ResendLost(stream, s->sequence_out, acked_sent, now);
+
+	//packets sent before the ping was known were scheduled from the initial guess, the one now at the
+	//front is what the client is waiting on, so it is brought in to a deadline from the current ping.
+	//if a whole tail was lost this resend getting acked is what lets the rest go out right behind it
+	if (s->sent_first != s->sequence_out) {
+		auto &first = s->sent_packets[s->sent_first & (s->sent_packets.size() - 1)];
+		auto resend_delay = EQ::Clamp(
+			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
+			m_owner->m_options.resend_delay_min,
+			m_owner->m_options.resend_delay_max);
+		auto resend_at = first.last_sent + std::chrono::milliseconds(resend_delay);
+		if (first.times_resent == 0 && resend_at < first.resend_at) {
+			first.resend_at = std::max(resend_at, now);
+			m_resend_queue.push({ first.resend_at, first.sequence, (uint8_t)stream });
 		}
 	}
 }
@@ -1225,18 +1667,69 @@ void EQ::Net::DaybreakConnection::Ack(int stream, uint16_t seq)
 void EQ::Net::DaybreakConnection::OutOfOrderAck(int stream, uint16_t seq)
 {
 	auto now = Clock::now();
+	auto sent = FindSentPacket(stream, seq);
+	if (sent == nullptr) {
+		return;
+	}
+
+	auto acked_sent = AckedSendTime(*sent, now);
+	UpdatePing(*sent, now);
+	RemoveSentPacket(stream, *sent);
+	ResendLost(stream, seq, acked_sent, now);
+}
+
+EQ::Net::Timestamp EQ::Net::DaybreakConnection::AckedSendTime(const DaybreakSentPacket &sent, Timestamp now) const
+{
+	//an ack doesn't say which copy of a resent packet arrived. one that comes back quicker than a round
+	//trip after the resend has to be for an earlier copy, crediting it to the resend would make everything
+	//sent in between look lost
+	if (sent.times_resent == 0 || now - sent.last_sent >= std::chrono::milliseconds(m_rolling_ping / 2)) {
+		return sent.last_sent;
+	}
+
+	return sent.first_sent;
+}
+
+void EQ::Net::DaybreakConnection::ResendLost(int stream, uint16_t before, Timestamp acked_sent, Timestamp now)
+{
 	auto s = &m_streams[stream];
-	auto iter = s->sent_packets.find(seq);
-	if (iter != s->sent_packets.end()) {
-		uint64_t round_time = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - iter->second.last_sent).count();
+	uint16_t span = s->sequence_out - s->sent_first;
+	uint16_t end = before - s->sent_first;
+	uint16_t i = s->fast_resend_next - s->sent_first;
+	if (end > span) {
+		return;
+	}
+
+	if (i > span) {
+		i = 0;
+	}
+
+	//the client has a packet that went out after these did, so they were most likely lost and are
+	//resent now instead of at their deadline. packets sent in order go out in sequence, so the walk
+	//stops at the first one that was sent after the acked packet and picks up from there next time
+	for (; i < end; ++i) {
+		auto &sent = s->sent_packets[(uint16_t)(s->sent_first + i) & (s->sent_packets.size() - 1)];
+		if (!sent.in_use) {
+			continue;
+		}
 
-		m_stats.max_ping = std::max(m_stats.max_ping, round_time);
-		m_stats.min_ping = std::min(m_stats.min_ping, round_time);
-		m_stats.last_ping = round_time;
-		m_rolling_ping = (m_rolling_ping * 2 + round_time) / 3;
+		if (sent.last_sent >= acked_sent) {
+			if (sent.times_resent == 0) {
+				break;
+			}
+
+			continue;
+		}
 
-		s->sent_packets.erase(iter);
+		if (sent.resend_at > now) {
+			sent.lost = true;
+			sent.resend_at = now;
+			m_resend_queue.push({ sent.resend_at, sent.sequence, (uint8_t)stream });
+			m_stats.fast_resends++;
+		}
 	}
+
+	s->fast_resend_next = s->sent_first + i;
 }
 
 void EQ::Net::DaybreakConnection::UpdateDataBudget(double budget_add)
@@ -1282,7 +1775,7 @@ void EQ::Net::DaybreakConnection::SendDisconnect()
 	InternalSend(out);
 }
 
-void EQ::Net::DaybreakConnection::InternalBufferedSend(Packet &p)
+void EQ::Net::DaybreakConnection::InternalBufferedSend(const Packet &p)
 {
 	if (p.Length() > 0xFFU) {
 		FlushBuffer();
@@ -1333,7 +1826,7 @@ void EQ::Net::DaybreakConnection::SendKeepAlive()
 	InternalSend(p);
 }
 
-void EQ::Net::DaybreakConnection::InternalSend(Packet &p)
+void EQ::Net::DaybreakConnection::InternalSend(const Packet &p)
 {
 	if (m_owner->m_options.outgoing_data_rate > 0.0) {
 		auto new_budget = m_outgoing_budget - (p.Length() / 1024.0);
@@ -1348,16 +1841,19 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p)
 
 	m_last_send = Clock::now();
 
-	auto send_func = [](uv_udp_send_t* req, int status) {
-		delete[](char*)req->data;
-		delete req;
-	};
-
 	if (PacketCanBeEncoded(p)) {
 
 		m_stats.bytes_before_encode += p.Length();
 
-		DynamicPacket out;
+		//encode straight into a slab of the send batch when there is one, each compression pass
+		//can add a flag byte and the crc goes on the end
+		size_t max_length = p.Length() + 2 + m_crc_bytes;
+		char *slab = m_owner->ReserveDatagram(max_length);
+
+		StaticPacket batched(slab, slab ? max_length : 0);
+		DynamicPacket unbatched;
+		Packet &out = slab ? (Packet&)batched : (Packet&)unbatched;
+		out.Resize(0);
 		out.PutPacket(0, p);
 
 		for (int i = 0; i < 2; ++i) {
@@ -1381,54 +1877,34 @@ void EQ::Net::DaybreakConnection::InternalSend(Packet &p)
 
 		AppendCRC(out);
 
-		uv_udp_send_t *send_req = new uv_udp_send_t;
-		memset(send_req, 0, sizeof(*send_req));
-		sockaddr_in send_addr;
-		uv_ip4_addr(m_endpoint.c_str(), m_port, &send_addr);
-		uv_buf_t send_buffers[1];
-
-		char *data = new char[out.Length()];
-		memcpy(data, out.Data(), out.Length());
-		send_buffers[0] = uv_buf_init(data, out.Length());
-		send_req->data = send_buffers[0].base;
-
 		m_stats.sent_bytes += out.Length();
 		m_stats.sent_packets++;
 		if (m_owner->m_options.simulated_out_packet_loss && m_owner->m_options.simulated_out_packet_loss >= m_owner->m_rand.Int(0, 100)) {
-			delete[](char*)send_req->data;
-			delete send_req;
 			return;
 		}
 
-		uv_udp_send(send_req, &m_owner->m_socket, send_buffers, 1, (sockaddr*)&send_addr, send_func);
+		if (slab) {
+			m_owner->CommitDatagram(m_endpoint_addr, out.Length());
+		}
+		else {
+			m_owner->SendUnbatched(m_endpoint_addr, (const char*)out.Data(), out.Length());
+		}
 		return;
 	}
 
 	m_stats.bytes_before_encode += p.Length();
 
-	uv_udp_send_t *send_req = new uv_udp_send_t;
-	sockaddr_in send_addr;
-	uv_ip4_addr(m_endpoint.c_str(), m_port, &send_addr);
-	uv_buf_t send_buffers[1];
-
-	char *data = new char[p.Length()];
-	memcpy(data, p.Data(), p.Length());
-	send_buffers[0] = uv_buf_init(data, p.Length());
-	send_req->data = send_buffers[0].base;
-
 	m_stats.sent_bytes += p.Length();
 	m_stats.sent_packets++;
 
 	if (m_owner->m_options.simulated_out_packet_loss && m_owner->m_options.simulated_out_packet_loss >= m_owner->m_rand.Int(0, 100)) {
-		delete[](char*)send_req->data;
-		delete send_req;
 		return;
 	}
 
-	uv_udp_send(send_req, &m_owner->m_socket, send_buffers, 1, (sockaddr*)&send_addr, send_func);
+	m_owner->SendDatagram(m_endpoint_addr, (const char*)p.Data(), p.Length());
 }
 
-void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id, bool reliable)
+void EQ::Net::DaybreakConnection::InternalQueuePacket(const Packet &p, int stream_id, bool reliable)
 {
 	if (!reliable) {
 		auto max_raw_size = 0xFFU - m_crc_bytes;
@@ -1453,28 +1929,19 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 
 		size_t used = 0;
 		size_t sublen = m_max_packet_size - m_crc_bytes - DaybreakReliableFragmentHeader::size() - 1; // -1 for compress flag
-		DynamicPacket first_packet;
+		auto &first_sent = AddSentPacket(stream_id);
+		auto &first_packet = first_sent.packet;
 		first_packet.PutSerialize(0, first_header);
 		first_packet.PutData(DaybreakReliableFragmentHeader::size(), (char*)p.Data() + used, sublen);
 		used += sublen;
-
-		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, first_packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
 		stream->sequence_out++;
 
 		InternalBufferedSend(first_packet);
 
 		while (used < length) {
 			auto left = length - used;
-			DynamicPacket packet;
+			auto &sent = AddSentPacket(stream_id);
+			auto &packet = sent.packet;
 			DaybreakReliableHeader header;
 			header.zero = 0;
 			header.opcode = OP_Fragment + stream_id;
@@ -1490,40 +1957,20 @@ void EQ::Net::DaybreakConnection::InternalQueuePacket(Packet &p, int stream_id,
 				used += left;
 			}
 
-			DaybreakSentPacket sent;
-			sent.packet.PutPacket(0, packet);
-			sent.last_sent = Clock::now();
-			sent.first_sent = Clock::now();
-			sent.times_resent = 0;
-			sent.resend_delay = EQ::Clamp(
-				static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-				m_owner->m_options.resend_delay_min,
-				m_owner->m_options.resend_delay_max);
-			stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
 			stream->sequence_out++;
 
 			InternalBufferedSend(packet);
 		}
 	}
 	else {
-		DynamicPacket packet;
+		auto &sent = AddSentPacket(stream_id);
+		auto &packet = sent.packet;
 		DaybreakReliableHeader header;
 		header.zero = 0;
 		header.opcode = OP_Packet + stream_id;
 		header.sequence = HostToNetwork(stream->sequence_out);
 		packet.PutSerialize(0, header);
 		packet.PutPacket(DaybreakReliableHeader::size(), p);
-
-		DaybreakSentPacket sent;
-		sent.packet.PutPacket(0, packet);
-		sent.last_sent = Clock::now();
-		sent.first_sent = Clock::now();
-		sent.times_resent = 0;
-		sent.resend_delay = EQ::Clamp(
-			static_cast<size_t>((m_rolling_ping * m_owner->m_options.resend_delay_factor) + m_owner->m_options.resend_delay_ms),
-			m_owner->m_options.resend_delay_min,
-			m_owner->m_options.resend_delay_max);
-		stream->sent_packets.emplace(std::make_pair(stream->sequence_out, sent));
 		stream->sequence_out++;
 
 		InternalBufferedSend(packet);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../random.h"
+#include "../event/loop_flush.h"
 #include "packet.h"
 #include "daybreak_structs.h"
 #include <uv.h>
@@ -90,6 +91,10 @@ namespace EQ
 				resent_packets = 0;
 				resent_fragments = 0;
 				resent_full = 0;
+				fast_resends = 0;
+				ping_deviation = 0;
+				sent_window = 0;
+				max_sent_window = 0;
 				datarate_remaining = 0.0;
 				bytes_after_decode = 0;
 				bytes_before_encode = 0;
@@ -106,6 +111,10 @@ namespace EQ
 				resent_packets = 0;
 				resent_fragments = 0;
 				resent_full = 0;
+				fast_resends = 0;
+				ping_deviation = 0;
+				sent_window = 0;
+				max_sent_window = 0;
 				datarate_remaining = 0.0;
 				bytes_after_decode = 0;
 				bytes_before_encode = 0;
@@ -128,11 +137,34 @@ namespace EQ
 			uint64_t resent_packets;
 			uint64_t resent_fragments;
 			uint64_t resent_full;
+			uint64_t fast_resends; //resent early because the client acked a packet that was sent after it
+			uint64_t ping_deviation; //rolling mean deviation of the round trip, from the same acks as avg_ping
+			uint64_t sent_window; //reliable packets sent and not yet acked
+			uint64_t max_sent_window;
 			double datarate_remaining;
 			uint64_t bytes_after_decode;
 			uint64_t bytes_before_encode;
 		};
 
+		// zlib contexts that live for the whole thread, streams are reset between packets
+		// instead of paying deflateInit/deflateEnd for every packet sent or received
+		class DaybreakCompressionContext
+		{
+		public:
+			DaybreakCompressionContext();
+			~DaybreakCompressionContext();
+			DaybreakCompressionContext(const DaybreakCompressionContext&) = delete;
+			DaybreakCompressionContext& operator=(const DaybreakCompressionContext&) = delete;
+
+			uint32_t Inflate(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len);
+			uint32_t Deflate(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len);
+
+			static DaybreakCompressionContext& ForThread();
+		private:
+			struct Streams;
+			std::unique_ptr<Streams> m_streams;
+		};
+
 		class DaybreakConnectionManager;
 		class DaybreakConnection;
 		class DaybreakConnection
@@ -146,9 +178,9 @@ namespace EQ
 			int RemotePort() const { return m_port; }
 
 			void Close();
-			void QueuePacket(Packet &p);
-			void QueuePacket(Packet &p, int stream);
-			void QueuePacket(Packet &p, int stream, bool reliable);
+			void QueuePacket(const Packet &p);
+			void QueuePacket(const Packet &p, int stream);
+			void QueuePacket(const Packet &p, int stream, bool reliable);
 
 			DaybreakConnectionStats GetStats();
 			void ResetStats();
@@ -162,6 +194,7 @@ namespace EQ
 			DaybreakConnectionManager *m_owner;
 			std::string m_endpoint;
 			int m_port;
+			sockaddr_in m_endpoint_addr;
 			uint32_t m_connect_code;
 			uint32_t m_encode_key;
 			uint32_t m_max_packet_size;
@@ -175,24 +208,43 @@ namespace EQ
 			std::list<DynamicPacket> m_buffered_packets;
 			size_t m_buffered_packets_length;
 			std::unique_ptr<char[]> m_combined;
+			std::unique_ptr<uint8_t[]> m_compression_buffer;
 			DaybreakConnectionStats m_stats;
 			Timestamp m_last_session_stats;
 			size_t m_rolling_ping;
 			Timestamp m_close_time;
 			double m_outgoing_budget;
 
-			// resend tracking
-			size_t m_resend_packets_sent = 0;
-			size_t m_resend_bytes_sent = 0;
-			bool m_acked_since_last_resend = false;
-
 			struct DaybreakSentPacket
 			{
+				DaybreakSentPacket() {
+					times_resent = 0;
+					resend_delay = 0;
+					sequence = 0;
+					in_use = false;
+					lost = false;
+				}
+
 				DynamicPacket packet;
 				Timestamp last_sent;
 				Timestamp first_sent;
+				Timestamp resend_at; //only the resend queue entry with this time is live
 				size_t times_resent;
 				size_t resend_delay;
+				uint16_t sequence;
+				bool in_use;
+				bool lost; //an ack for something sent after it came in, resent without backing off
+			};
+
+			// due times for resends, entries for packets that were acked or rescheduled since are
+			// left in place and skipped when they come up
+			struct DaybreakResend
+			{
+				Timestamp at;
+				uint16_t sequence;
+				uint8_t stream;
+
+				bool operator>(const DaybreakResend &o) const { return at > o.at; }
 			};
 
 			struct DaybreakStream
@@ -202,6 +254,9 @@ namespace EQ
 					sequence_out = 0;
 					fragment_current_bytes = 0;
 					fragment_total_bytes = 0;
+					sent_first = 0;
+					sent_count = 0;
+					fast_resend_next = 0;
 				}
 
 				uint16_t sequence_in;
@@ -212,10 +267,17 @@ namespace EQ
 				uint32_t fragment_current_bytes;
 				uint32_t fragment_total_bytes;
 
-				std::map<uint16_t, DaybreakSentPacket> sent_packets;
+				// the send window, a ring indexed by sequence & (size - 1) holding [sent_first, sequence_out),
+				// it doubles when the window fills and slots keep their packet buffers for reuse
+				std::vector<DaybreakSentPacket> sent_packets;
+				uint16_t sent_first;
+				size_t sent_count;
+				uint16_t fast_resend_next; //acks have already looked at what is before this for lost packets
 			};
 
 			DaybreakStream m_streams[4];
+			std::priority_queue<DaybreakResend, std::vector<DaybreakResend>, std::greater<DaybreakResend>> m_resend_queue;
+			size_t m_ping_deviation;
 			std::weak_ptr<DaybreakConnection> m_self;
 
 			void Process();
@@ -227,15 +289,20 @@ namespace EQ
 			void ChangeStatus(DbProtocolStatus new_status);
 			bool ValidateCRC(Packet &p);
 			void AppendCRC(Packet &p);
-			bool PacketCanBeEncoded(Packet &p) const;
+			bool PacketCanBeEncoded(const Packet &p) const;
 			void Decode(Packet &p, size_t offset, size_t length);
 			void Encode(Packet &p, size_t offset, size_t length);
 			void Decompress(Packet &p, size_t offset, size_t length);
 			void Compress(Packet &p, size_t offset, size_t length);
 			void ProcessResend();
-			void ProcessResend(int stream);
+			DaybreakSentPacket& AddSentPacket(int stream);
+			DaybreakSentPacket* FindSentPacket(int stream, uint16_t seq);
+			void RemoveSentPacket(int stream, DaybreakSentPacket &sent);
+			void UpdatePing(const DaybreakSentPacket &sent, Timestamp now);
 			void Ack(int stream, uint16_t seq);
 			void OutOfOrderAck(int stream, uint16_t seq);
+			void ResendLost(int stream, uint16_t before, Timestamp acked_sent, Timestamp now);
+			Timestamp AckedSendTime(const DaybreakSentPacket &sent, Timestamp now) const;
 			void UpdateDataBudget(double budget_add);
 
 			void SendConnect();
@@ -243,9 +310,9 @@ namespace EQ
 			void SendAck(int stream, uint16_t seq);
 			void SendOutOfOrderAck(int stream, uint16_t seq);
 			void SendDisconnect();
-			void InternalBufferedSend(Packet &p);
-			void InternalSend(Packet &p);
-			void InternalQueuePacket(Packet &p, int stream_id, bool reliable);
+			void InternalBufferedSend(const Packet &p);
+			void InternalSend(const Packet &p);
+			void InternalQueuePacket(const Packet &p, int stream_id, bool reliable);
 			void FlushBuffer();
 			SequenceOrder CompareSequence(uint16_t expected, uint16_t actual) const;
 
@@ -277,6 +344,7 @@ namespace EQ
 				resend_timeout = 30000;
 				connection_close_time = 2000;
 				outgoing_data_rate = 0.0;
+				batched_io = true;
 			}
 
 			size_t max_packet_size;
@@ -300,6 +368,7 @@ namespace EQ
 			DaybreakEncodeType encode_passes[2];
 			int port;
 			double outgoing_data_rate;
+			bool batched_io; //linux: recvmmsg reads, sendmmsg (and udp gso) writes once per loop iteration
 		};
 
 		class DaybreakConnectionManager
@@ -310,6 +379,7 @@ namespace EQ
 			~DaybreakConnectionManager();
 
 			void Connect(const std::string &addr, int port);
+			int LocalPort() const;
 			void Process();
 			void UpdateDataBudget();
 			void ProcessResend();
@@ -323,10 +393,16 @@ namespace EQ
 			void Attach(uv_loop_t *loop);
 			void Detach();
 
+			struct SendBatch;
+
 			EQ::Random m_rand;
-			uv_timer_t m_timer;
-			uv_udp_t m_socket;
+			uv_timer_t *m_timer;
+			uv_udp_t *m_socket;
+			std::unique_ptr<EQ::LoopFlush> m_flush;
 			uv_loop_t *m_attached;
+			std::unique_ptr<char[]> m_recv_buffer;
+			size_t m_recv_buffer_size;
+			std::unique_ptr<SendBatch> m_send_batch;
 			DaybreakConnectionManagerOptions m_options;
 			std::function<void(std::shared_ptr<DaybreakConnection>)> m_on_new_connection;
 			std::function<void(std::shared_ptr<DaybreakConnection>, DbProtocolStatus, DbProtocolStatus)> m_on_connection_state_change;
@@ -338,6 +414,14 @@ namespace EQ
 			std::shared_ptr<DaybreakConnection> FindConnectionByEndpoint(std::string addr, int port);
 			void SendDisconnect(const std::string &addr, int port);
 
+			// datagrams are written straight into a slab of the send batch and go out together when the
+			// loop is about to poll or has just polled, ReserveDatagram is null when they can't be batched
+			char *ReserveDatagram(size_t length);
+			void CommitDatagram(const sockaddr_in &addr, size_t length);
+			void SendDatagram(const sockaddr_in &addr, const char *data, size_t length);
+			void SendUnbatched(const sockaddr_in &addr, const char *data, size_t length);
+			void FlushSendBatch();
+
 			friend class DaybreakConnection;
 		};
 	}
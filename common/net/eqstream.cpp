@@ -1,28 +1,81 @@
 #include "eqstream.h"
+#include "../event/event_loop.h"
 #include "../eqemu_logsys.h"
 
-EQ::Net::EQStreamManager::EQStreamManager(const EQStreamManagerInterfaceOptions &options) : EQStreamManagerInterface(options), m_daybreak(options.daybreak_options)
+// a game frame's worth of packets for every client fits, anything past that waits in the backlog
+constexpr size_t NetworkThreadRingSize = 4096;
+constexpr uint64_t NetworkThreadStatsMS = 1000;
+
+EQ::Net::EQStreamManager::NetworkThread::NetworkThread()
+	: events(NetworkThreadRingSize), commands(NetworkThreadRingSize)
+{
+	events_pushed = false;
+	commands_pushed = false;
+	stopping = false;
+	game_wake = nullptr;
+	network_wake = nullptr;
+	stats_timer = nullptr;
+}
+
+EQ::Net::EQStreamManager::EQStreamManager(const EQStreamManagerInterfaceOptions &options) : EQStreamManagerInterface(options)
 {
-	m_daybreak.OnNewConnection(std::bind(&EQStreamManager::DaybreakNewConnection, this, std::placeholders::_1));
-	m_daybreak.OnConnectionStateChange(std::bind(&EQStreamManager::DaybreakConnectionStateChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-	m_daybreak.OnPacketRecv(std::bind(&EQStreamManager::DaybreakPacketRecv, this, std::placeholders::_1, std::placeholders::_2));
+	m_local_port = 0;
+
+	if (options.network_thread) {
+		StartNetworkThread();
+	}
+	else {
+		CreateDaybreak();
+	}
 }
 
 EQ::Net::EQStreamManager::~EQStreamManager()
 {
+	if (m_network) {
+		StopNetworkThread();
+	}
 }
 
 void EQ::Net::EQStreamManager::SetOptions(const EQStreamManagerInterfaceOptions &options)
 {
 	m_options = options;
-	auto &opts = m_daybreak.GetOptions();
+
+	if (m_network) {
+		NetworkCommand c;
+		c.type = NetworkCommand::SetOptions;
+		c.options.reset(new DaybreakConnectionManagerOptions(options.daybreak_options));
+		PushCommand(std::move(c));
+		return;
+	}
+
+	auto &opts = m_daybreak->GetOptions();
 	opts = options.daybreak_options;
 }
 
+void EQ::Net::EQStreamManager::CreateDaybreak()
+{
+	m_daybreak.reset(new DaybreakConnectionManager(m_options.daybreak_options));
+	m_local_port = m_daybreak->LocalPort();
+	m_daybreak->OnNewConnection(std::bind(&EQStreamManager::DaybreakNewConnection, this, std::placeholders::_1));
+	m_daybreak->OnConnectionStateChange(std::bind(&EQStreamManager::DaybreakConnectionStateChange, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	m_daybreak->OnPacketRecv(std::bind(&EQStreamManager::DaybreakPacketRecv, this, std::placeholders::_1, std::placeholders::_2));
+}
+
 void EQ::Net::EQStreamManager::DaybreakNewConnection(std::shared_ptr<DaybreakConnection> connection)
 {
 	std::shared_ptr<EQStream> stream(new EQStream(this, connection));
 	m_streams.emplace(std::make_pair(connection, stream));
+
+	if (m_network) {
+		stream->m_threaded_owner = this;
+
+		NetworkEvent e;
+		e.type = NetworkEvent::NewConnection;
+		e.stream = stream;
+		PushEvent(std::move(e));
+		return;
+	}
+
 	if (m_on_new_connection) {
 		m_on_new_connection(stream);
 	}
@@ -32,7 +85,15 @@ void EQ::Net::EQStreamManager::DaybreakConnectionStateChange(std::shared_ptr<Day
 {
 	auto iter = m_streams.find(connection);
 	if (iter != m_streams.end()) {
-		if (m_on_connection_state_change) {
+		if (m_network) {
+			NetworkEvent e;
+			e.type = NetworkEvent::StateChange;
+			e.stream = iter->second;
+			e.from = from;
+			e.to = to;
+			PushEvent(std::move(e));
+		}
+		else if (m_on_connection_state_change) {
 			m_on_connection_state_change(iter->second, from, to);
 		}
 
@@ -49,15 +110,239 @@ void EQ::Net::EQStreamManager::DaybreakPacketRecv(std::shared_ptr<DaybreakConnec
 		auto &stream = iter->second;
 		std::unique_ptr<EQ::Net::Packet> t(new EQ::Net::DynamicPacket());
 		t->PutPacket(0, p);
+
+		if (m_network) {
+			NetworkEvent e;
+			e.type = NetworkEvent::PacketRecv;
+			e.stream = stream;
+			e.packet = std::move(t);
+			PushEvent(std::move(e));
+			return;
+		}
+
 		stream->m_packet_queue.push_back(std::move(t));
 	}
 }
 
+void EQ::Net::EQStreamManager::StartNetworkThread()
+{
+	m_network.reset(new NetworkThread());
+	auto &n = *m_network;
+	auto loop = EQ::EventLoop::Get().Handle();
+
+	n.game_wake = new uv_async_t;
+	memset(n.game_wake, 0, sizeof(uv_async_t));
+	uv_async_init(loop, n.game_wake, [](uv_async_t *handle) {
+		((EQStreamManager*)handle->data)->ProcessEvents();
+	});
+	n.game_wake->data = this;
+
+	//what the game queued goes over to the network thread once per loop iteration
+	n.game_flush.reset(new EQ::LoopFlush(loop, [this]() { FlushCommands(); }));
+	n.game_flush->Start();
+	n.game_flush->Unref();
+
+	uv_unref((uv_handle_t*)n.game_wake);
+
+	std::promise<void> started;
+	auto ready = started.get_future();
+	n.thread = std::thread(&EQStreamManager::NetworkThreadMain, this, &started);
+	ready.wait();
+
+	LogInfo("EQ Network running on its own thread on port [{}]", m_options.daybreak_options.port);
+}
+
+void EQ::Net::EQStreamManager::StopNetworkThread()
+{
+	auto &n = *m_network;
+	n.stopping = true;
+	uv_async_send(n.network_wake);
+	n.thread.join();
+
+	uv_close((uv_handle_t*)n.game_wake, [](uv_handle_t *handle) {
+		delete (uv_async_t*)handle;
+	});
+
+	n.game_flush.reset();
+
+	m_network.reset();
+}
+
+void EQ::Net::EQStreamManager::NetworkThreadMain(std::promise<void> *started)
+{
+	//this thread's own loop, the daybreak manager attaches to whichever loop it is made on
+	auto &n = *m_network;
+	auto loop = EQ::EventLoop::Get().Handle();
+
+	CreateDaybreak();
+
+	n.network_wake = new uv_async_t;
+	memset(n.network_wake, 0, sizeof(uv_async_t));
+	uv_async_init(loop, n.network_wake, [](uv_async_t *handle) {
+		((EQStreamManager*)handle->data)->ProcessCommands();
+	});
+	n.network_wake->data = this;
+
+	n.network_flush.reset(new EQ::LoopFlush(loop, [this]() { FlushEvents(); }));
+	n.network_flush->Start();
+
+	n.stats_timer = new uv_timer_t;
+	memset(n.stats_timer, 0, sizeof(uv_timer_t));
+	uv_timer_init(loop, n.stats_timer);
+	n.stats_timer->data = this;
+	uv_timer_start(n.stats_timer, [](uv_timer_t *handle) {
+		((EQStreamManager*)handle->data)->PublishStats();
+	}, NetworkThreadStatsMS, NetworkThreadStatsMS);
+
+	started->set_value();
+
+	//returns once ProcessCommands sees we're stopping and every handle has closed
+	EQ::EventLoop::Get().Run();
+}
+
+void EQ::Net::EQStreamManager::PushEvent(NetworkEvent &&e)
+{
+	auto &n = *m_network;
+	if (!n.event_backlog.empty() || !n.events.TryPush(std::move(e))) {
+		n.event_backlog.push_back(std::move(e));
+	}
+
+	n.events_pushed = true;
+}
+
+void EQ::Net::EQStreamManager::FlushEvents()
+{
+	auto &n = *m_network;
+	while (!n.event_backlog.empty() && n.events.TryPush(std::move(n.event_backlog.front()))) {
+		n.event_backlog.pop_front();
+	}
+
+	if (n.events_pushed) {
+		n.events_pushed = false;
+		uv_async_send(n.game_wake);
+	}
+}
+
+void EQ::Net::EQStreamManager::ProcessCommands()
+{
+	auto &n = *m_network;
+
+	NetworkCommand c;
+	while (n.commands.TryPop(c)) {
+		switch (c.type) {
+		case NetworkCommand::Send:
+			if (c.frames) {
+				auto &f = (*c.frames)[c.frame];
+				c.connection->QueuePacket(f.data, 0, f.ack_req);
+			}
+			else {
+				c.connection->QueuePacket(c.packet, 0, c.reliable);
+			}
+			break;
+		case NetworkCommand::Close:
+			c.connection->Close();
+			break;
+		case NetworkCommand::ResetStats:
+			c.connection->ResetStats();
+			break;
+		case NetworkCommand::SetOptions:
+			m_daybreak->GetOptions() = *c.options;
+			break;
+		}
+	}
+
+	c.connection.reset();
+
+	if (!n.stopping) {
+		return;
+	}
+
+	m_streams.clear();
+	m_daybreak.reset();
+
+	uv_close((uv_handle_t*)n.network_wake, [](uv_handle_t *handle) {
+		delete (uv_async_t*)handle;
+	});
+
+	n.network_flush.reset();
+
+	uv_timer_stop(n.stats_timer);
+	uv_close((uv_handle_t*)n.stats_timer, [](uv_handle_t *handle) {
+		delete (uv_timer_t*)handle;
+	});
+}
+
+void EQ::Net::EQStreamManager::PublishStats()
+{
+	for (auto &s : m_streams) {
+		NetworkEvent e;
+		e.type = NetworkEvent::Stats;
+		e.stream = s.second;
+		e.stats.reset(new DaybreakConnectionStats(s.first->GetStats()));
+		PushEvent(std::move(e));
+	}
+}
+
+void EQ::Net::EQStreamManager::PushCommand(NetworkCommand &&c)
+{
+	auto &n = *m_network;
+	if (!n.command_backlog.empty() || !n.commands.TryPush(std::move(c))) {
+		n.command_backlog.push_back(std::move(c));
+	}
+
+	n.commands_pushed = true;
+}
+
+void EQ::Net::EQStreamManager::FlushCommands()
+{
+	auto &n = *m_network;
+	while (!n.command_backlog.empty() && n.commands.TryPush(std::move(n.command_backlog.front()))) {
+		n.command_backlog.pop_front();
+	}
+
+	if (n.commands_pushed) {
+		n.commands_pushed = false;
+		uv_async_send(n.network_wake);
+	}
+}
+
+void EQ::Net::EQStreamManager::ProcessEvents()
+{
+	auto &n = *m_network;
+
+	NetworkEvent e;
+	while (n.events.TryPop(e)) {
+		switch (e.type) {
+		case NetworkEvent::NewConnection:
+			if (m_on_new_connection) {
+				m_on_new_connection(e.stream);
+			}
+			break;
+		case NetworkEvent::StateChange:
+			e.stream->m_status = e.to;
+			if (m_on_connection_state_change) {
+				m_on_connection_state_change(e.stream, e.from, e.to);
+			}
+			break;
+		case NetworkEvent::PacketRecv:
+			e.stream->m_packet_queue.push_back(std::move(e.packet));
+			break;
+		case NetworkEvent::Stats:
+			e.stream->m_stats = *e.stats;
+			break;
+		}
+	}
+
+	e.stream.reset();
+}
+
 EQ::Net::EQStream::EQStream(EQStreamManagerInterface *owner, std::shared_ptr<DaybreakConnection> connection)
 {
 	m_owner = owner;
+	m_threaded_owner = nullptr;
 	m_connection = connection;
 	m_opcode_manager = nullptr;
+	m_status = connection->GetStatus();
 }
 
 EQ::Net::EQStream::~EQStream()
@@ -96,7 +381,15 @@ void EQ::Net::EQStream::QueuePacket(const EQApplicationPacket *p, bool ack_req)
 			break;
 		}
 
-		if (ack_req) {
+		if (m_threaded_owner) {
+			EQStreamManager::NetworkCommand c;
+			c.type = EQStreamManager::NetworkCommand::Send;
+			c.connection = m_connection;
+			c.packet = std::move(out);
+			c.reliable = ack_req;
+			m_threaded_owner->PushCommand(std::move(c));
+		}
+		else if (ack_req) {
 			m_connection->QueuePacket(out);
 		}
 		else {
@@ -111,6 +404,46 @@ void EQ::Net::EQStream::FastQueuePacket(EQApplicationPacket **p, bool ack_req) {
 	*p = nullptr;
 }
 
+void EQ::Net::EQStream::QueueBroadcastPacket(EQBroadcastPacket &p, bool ack_req) {
+	if (m_opcode_manager && *m_opcode_manager) {
+		auto frames = p.Encode(nullptr, *m_opcode_manager, m_owner->GetOptions().opcode_size, ack_req);
+		QueueEncodedFrames(frames);
+	}
+}
+
+void EQ::Net::EQStream::QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames) {
+	if (!m_opcode_manager || !*m_opcode_manager) {
+		return;
+	}
+
+	//the frames are shared with every other recipient, the connection copies what it needs to resend.
+	for (size_t i = 0; i < frames->size(); ++i) {
+		auto &f = (*frames)[i];
+		LogPacketServerClient(
+			"[{}] [{:#06x}] Size [{}] (broadcast)",
+			OpcodeManager::EmuToName(f.emu_opcode),
+			f.opcode,
+			f.data.Length()
+		);
+
+		if (!f.bypass) {
+			m_packet_sent_count[static_cast<int>(f.emu_opcode)]++;
+		}
+
+		if (m_threaded_owner) {
+			EQStreamManager::NetworkCommand c;
+			c.type = EQStreamManager::NetworkCommand::Send;
+			c.connection = m_connection;
+			c.frames = frames;
+			c.frame = i;
+			m_threaded_owner->PushCommand(std::move(c));
+			continue;
+		}
+
+		m_connection->QueuePacket(f.data, 0, f.ack_req);
+	}
+}
+
 EQApplicationPacket *EQ::Net::EQStream::PopPacket() {
 	if (m_packet_queue.empty()) {
 		return nullptr;
@@ -142,6 +475,14 @@ EQApplicationPacket *EQ::Net::EQStream::PopPacket() {
 }
 
 void EQ::Net::EQStream::Close() {
+	if (m_threaded_owner) {
+		EQStreamManager::NetworkCommand c;
+		c.type = EQStreamManager::NetworkCommand::Close;
+		c.connection = m_connection;
+		m_threaded_owner->PushCommand(std::move(c));
+		return;
+	}
+
 	m_connection->Close();
 }
 
@@ -219,7 +560,7 @@ EQStreamInterface::MatchState EQ::Net::EQStream::CheckSignature(const Signature
 }
 
 EQStreamState EQ::Net::EQStream::GetState() {
-	auto status = m_connection->GetStatus();
+	auto status = m_threaded_owner ? m_status : m_connection->GetStatus();
 	switch (status) {
 	case StatusConnecting:
 		return UNESTABLISHED;
@@ -235,7 +576,7 @@ EQStreamState EQ::Net::EQStream::GetState() {
 EQ::Net::EQStream::Stats EQ::Net::EQStream::GetStats() const
 {
 	Stats ret;
-	ret.DaybreakStats = m_connection->GetStats();
+	ret.DaybreakStats = m_threaded_owner ? m_stats : m_connection->GetStats();
 
 	for (int i = 0; i < _maxEmuOpcode; ++i) {
 		ret.RecvCount[i] = 0;
@@ -255,6 +596,16 @@ EQ::Net::EQStream::Stats EQ::Net::EQStream::GetStats() const
 
 void EQ::Net::EQStream::ResetStats()
 {
+	if (m_threaded_owner) {
+		m_stats.Reset();
+
+		EQStreamManager::NetworkCommand c;
+		c.type = EQStreamManager::NetworkCommand::ResetStats;
+		c.connection = m_connection;
+		m_threaded_owner->PushCommand(std::move(c));
+		return;
+	}
+
 	m_connection->ResetStats();
 }
 
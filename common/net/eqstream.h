@@ -4,8 +4,13 @@
 #include "../eq_stream_intf.h"
 #include "../opcodemgr.h"
 #include "daybreak_connection.h"
+#include "../util/spsc_ring.h"
+#include "../event/loop_flush.h"
+#include <atomic>
 #include <vector>
 #include <deque>
+#include <future>
+#include <thread>
 #include <unordered_map>
 
 namespace EQ
@@ -22,15 +27,83 @@ namespace EQ
 			virtual void SetOptions(const EQStreamManagerInterfaceOptions& options);
 			void OnNewConnection(std::function<void(std::shared_ptr<EQStream>)> func) { m_on_new_connection = func; }
 			void OnConnectionStateChange(std::function<void(std::shared_ptr<EQStream>, DbProtocolStatus, DbProtocolStatus)> func) { m_on_connection_state_change = func; }
+			int LocalPort() const { return m_local_port; }
 		private:
-			DaybreakConnectionManager m_daybreak;
+			// handed from the network thread to the game thread
+			struct NetworkEvent
+			{
+				enum Type { NewConnection, StateChange, PacketRecv, Stats };
+
+				Type type = NewConnection;
+				std::shared_ptr<EQStream> stream;
+				DbProtocolStatus from = StatusConnected;
+				DbProtocolStatus to = StatusConnected;
+				std::unique_ptr<Packet> packet;
+				std::unique_ptr<DaybreakConnectionStats> stats;
+			};
+
+			// handed from the game thread to the network thread
+			struct NetworkCommand
+			{
+				enum Type { Send, Close, ResetStats, SetOptions };
+
+				Type type = Send;
+				std::shared_ptr<DaybreakConnection> connection;
+				DynamicPacket packet;
+				bool reliable = true;
+				// a broadcast frame is sent from the frames every recipient shares instead of a copy in packet
+				std::shared_ptr<const EQBroadcastPacket::Frames> frames;
+				size_t frame = 0;
+				std::unique_ptr<DaybreakConnectionManagerOptions> options;
+			};
+
+			// the two sides of a manager that runs daybreak on its own thread, each ring has one
+			// producer and one consumer and each side keeps what didn't fit until there is room
+			struct NetworkThread
+			{
+				NetworkThread();
+
+				EQ::Util::SPSCRing<NetworkEvent> events;
+				EQ::Util::SPSCRing<NetworkCommand> commands;
+				std::deque<NetworkEvent> event_backlog;
+				std::deque<NetworkCommand> command_backlog;
+				bool events_pushed;
+				bool commands_pushed;
+				std::atomic<bool> stopping;
+				std::thread thread;
+
+				// game loop
+				uv_async_t *game_wake;
+				std::unique_ptr<EQ::LoopFlush> game_flush;
+
+				// network loop
+				uv_async_t *network_wake;
+				std::unique_ptr<EQ::LoopFlush> network_flush;
+				uv_timer_t *stats_timer;
+			};
+
+			std::unique_ptr<DaybreakConnectionManager> m_daybreak;
+			std::unique_ptr<NetworkThread> m_network;
 			std::function<void(std::shared_ptr<EQStream>)> m_on_new_connection;
 			std::function<void(std::shared_ptr<EQStream>, DbProtocolStatus, DbProtocolStatus)> m_on_connection_state_change;
 			std::map<std::shared_ptr<DaybreakConnection>, std::shared_ptr<EQStream>> m_streams;
+			int m_local_port;
 
+			void CreateDaybreak();
 			void DaybreakNewConnection(std::shared_ptr<DaybreakConnection> connection);
 			void DaybreakConnectionStateChange(std::shared_ptr<DaybreakConnection> connection, DbProtocolStatus from, DbProtocolStatus to);
 			void DaybreakPacketRecv(std::shared_ptr<DaybreakConnection> connection, const Packet &p);
+
+			void StartNetworkThread();
+			void StopNetworkThread();
+			void NetworkThreadMain(std::promise<void> *started);
+			void PushEvent(NetworkEvent &&e);
+			void FlushEvents();
+			void ProcessCommands();
+			void PublishStats();
+			void PushCommand(NetworkCommand &&c);
+			void FlushCommands();
+			void ProcessEvents();
 			friend class EQStream;
 		};
 
@@ -42,6 +115,8 @@ namespace EQ
 
 			virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req = true);
 			virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req = true);
+			virtual void QueueBroadcastPacket(EQBroadcastPacket &p, bool ack_req = true);
+			virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames);
 			virtual EQApplicationPacket *PopPacket();
 			virtual void Close();
 			virtual void ReleaseFromUse() { };
@@ -67,7 +142,10 @@ namespace EQ
 			virtual EQStreamManagerInterface* GetManager() const;
 		private:
 			EQStreamManagerInterface *m_owner;
+			EQStreamManager *m_threaded_owner; //set when daybreak runs on the manager's network thread
 			std::shared_ptr<DaybreakConnection> m_connection;
+			DbProtocolStatus m_status; //as of the last state change the network thread passed on
+			DaybreakConnectionStats m_stats; //as of the last snapshot the network thread passed on
 			OpcodeManager **m_opcode_manager;
 			std::deque<std::unique_ptr<EQ::Net::Packet>> m_packet_queue;
 			std::unordered_map<int, int> m_packet_recv_count;
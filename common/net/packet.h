@@ -36,6 +36,8 @@ namespace EQ {
 
 			template<typename T>
 			void PutSerialize(size_t offset, const T &value) {
+				//a packet can be written more than once, what an earlier call serialized can't be left in front
+				m_stream.str(std::string());
 				m_stream.clear();
 				cereal::BinaryOutputArchive output(m_stream);
 				output(value);
@@ -115,6 +117,7 @@ namespace EQ {
 			DynamicPacket(DynamicPacket &&o) noexcept { m_data = std::move(o.m_data); }
 			DynamicPacket(const DynamicPacket &o) { m_data = o.m_data; }
 			DynamicPacket& operator=(const DynamicPacket &o) { m_data = o.m_data; return *this; }
+			DynamicPacket& operator=(DynamicPacket &&o) noexcept { m_data = std::move(o.m_data); return *this; }
 
 			virtual const void *Data() const { return &m_data[0]; }
 			virtual void *Data() { return &m_data[0]; }
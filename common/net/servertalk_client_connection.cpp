@@ -26,16 +26,32 @@ void EQ::Net::ServertalkClient::Send(uint16_t opcode, EQ::Net::Packet &p)
 		p.PutUInt8(0, 0);
 	}
 
-	EQ::Net::DynamicPacket out;
-	out.PutUInt32(0, p.Length());
-	out.PutUInt16(4, opcode);
-	out.PutPacket(6, p);
+	if (!m_connection) {
+		return;
+	}
+
+	char header_buffer[6];
+	EQ::Net::StaticPacket header(header_buffer, sizeof(header_buffer));
+	header.PutUInt32(0, (uint32_t)p.Length());
+	header.PutUInt16(4, opcode);
 
-	InternalSend(ServertalkMessage, out);
+	uv_buf_t buffers[2] = {
+		uv_buf_init(header_buffer, sizeof(header_buffer)),
+		uv_buf_init((char*)p.Data(), p.Length())
+	};
+
+	InternalSend(ServertalkMessage, buffers, 2);
 }
 
 void EQ::Net::ServertalkClient::SendPacket(ServerPacket *p)
 {
+	//only a packet that has to be padded is copied first
+	if (p->pBuffer && p->size > 0) {
+		EQ::Net::StaticPacket pout(p->pBuffer, p->size);
+		Send(p->opcode, pout);
+		return;
+	}
+
 	EQ::Net::DynamicPacket pout;
 	if (p->pBuffer) {
 		pout.PutData(0, p->pBuffer, p->size);
@@ -95,23 +111,27 @@ void EQ::Net::ServertalkClient::ProcessData(EQ::Net::TCPConnection *c, const uns
 
 void EQ::Net::ServertalkClient::SendHello()
 {
-	EQ::Net::DynamicPacket p;
-	InternalSend(ServertalkClientHello, p);
+	InternalSend(ServertalkClientHello, nullptr, 0);
 }
 
-void EQ::Net::ServertalkClient::InternalSend(ServertalkPacketType type, EQ::Net::Packet &p)
+void EQ::Net::ServertalkClient::InternalSend(ServertalkPacketType type, const uv_buf_t *buffers, size_t count)
 {
 	if (!m_connection)
 		return;
 
-	EQ::Net::DynamicPacket out;
-	out.PutUInt32(0, (uint32_t)p.Length());
-	out.PutUInt8(4, (uint8_t)type);
-	if (p.Length() > 0) {
-		out.PutPacket(5, p);
+	size_t length = 0;
+	for (size_t i = 0; i < count; ++i) {
+		length += buffers[i].len;
 	}
 
-	m_connection->Write((const char*)out.Data(), out.Length());
+	char header_buffer[5];
+	EQ::Net::StaticPacket header(header_buffer, sizeof(header_buffer));
+	header.PutUInt32(0, (uint32_t)length);
+	header.PutUInt8(4, (uint8_t)type);
+
+	auto framing = uv_buf_init(header_buffer, sizeof(header_buffer));
+	m_connection->Write(&framing, 1);
+	m_connection->Write(buffers, count);
 }
 
 void EQ::Net::ServertalkClient::ProcessReadBuffer()
@@ -225,5 +245,7 @@ void EQ::Net::ServertalkClient::SendHandshake()
 	handshake.PutString(0, m_identifier);
 	handshake.PutString(m_identifier.length() + 1, m_credentials);
 	handshake.PutUInt8(m_identifier.length() + 1 + m_credentials.length(), 0);
-	InternalSend(ServertalkClientDowngradeSecurityHandshake, handshake);
+
+	auto buffer = uv_buf_init((char*)handshake.Data(), handshake.Length());
+	InternalSend(ServertalkClientDowngradeSecurityHandshake, &buffer, 1);
 }
@@ -30,7 +30,7 @@ namespace EQ
 			void Connect();
 			void ProcessData(EQ::Net::TCPConnection *c, const unsigned char *data, size_t length);
 			void SendHello();
-			void InternalSend(ServertalkPacketType type, EQ::Net::Packet &p);
+			void InternalSend(ServertalkPacketType type, const uv_buf_t *buffers, size_t count);
 			void ProcessReadBuffer();
 			void ProcessHello(EQ::Net::Packet &p);
 			void ProcessMessage(EQ::Net::Packet &p);
@@ -29,6 +29,7 @@ namespace EQ
 			void Listen(const ServertalkServerOptions& opts);
 			void OnConnectionIdentified(const std::string &type, std::function<void(std::shared_ptr<ServertalkServerConnection>)> cb);
 			void OnConnectionRemoved(const std::string &type, std::function<void(std::shared_ptr<ServertalkServerConnection>)> cb);
+			int LocalPort() const { return m_server ? m_server->LocalPort() : 0; }
 
 		private:
 			void ConnectionDisconnected(ServertalkServerConnection *conn);
@@ -3,6 +3,9 @@
 #include "../eqemu_logsys.h"
 #include "../util/uuid.h"
 
+//a message of this length would read as a legacy connection's identification
+constexpr size_t LegacyIdentifyCollisionLength = 43061256;
+
 EQ::Net::ServertalkServerConnection::ServertalkServerConnection(std::shared_ptr<EQ::Net::TCPConnection> c, EQ::Net::ServertalkServer *parent)
 {
 	m_connection = c;
@@ -66,31 +69,52 @@ void EQ::Net::ServertalkServerConnection::Send(uint16_t opcode, EQ::Net::Packet
 			return;
 		}
 
-		EQ::Net::DynamicPacket out;
-		out.PutUInt16(0, opcode);
-		out.PutUInt16(2, p.Length() + 4);
-		out.PutPacket(4, p);
+		char header_buffer[4];
+		EQ::Net::StaticPacket header(header_buffer, sizeof(header_buffer));
+		header.PutUInt16(0, opcode);
+		header.PutUInt16(2, p.Length() + 4);
+
+		uv_buf_t buffers[2] = {
+			uv_buf_init(header_buffer, sizeof(header_buffer)),
+			uv_buf_init((char*)p.Data(), p.Length())
+		};
 
-		m_connection->Write((const char*)out.Data(), out.Length());
+		m_connection->Write(buffers, 2);
 	} else {
 		// pad zero size packets
 		// pad packets that would cause a collision with legacy identification code
 		// It's unlikely we'd send a 4MB msg for any reason but just incase.
-		if (p.Length() == 0 || p.Length() == 43061256) {
+		if (p.Length() == 0 || p.Length() == LegacyIdentifyCollisionLength) {
 			p.PutUInt8(0, 0);
 		}
 
-		EQ::Net::DynamicPacket out;
-		out.PutUInt32(0, p.Length());
-		out.PutUInt16(4, opcode);
-		out.PutPacket(6, p);
+		if (!m_connection) {
+			return;
+		}
+
+		char header_buffer[6];
+		EQ::Net::StaticPacket header(header_buffer, sizeof(header_buffer));
+		header.PutUInt32(0, (uint32_t)p.Length());
+		header.PutUInt16(4, opcode);
 
-		InternalSend(ServertalkMessage, out);
+		uv_buf_t buffers[2] = {
+			uv_buf_init(header_buffer, sizeof(header_buffer)),
+			uv_buf_init((char*)p.Data(), p.Length())
+		};
+
+		InternalSend(ServertalkMessage, buffers, 2);
 	}
 }
 
 void EQ::Net::ServertalkServerConnection::SendPacket(ServerPacket *p)
 {
+	//only a packet that has to be padded is copied first
+	if (p->pBuffer && p->size > 0 && p->size != LegacyIdentifyCollisionLength) {
+		EQ::Net::StaticPacket pout(p->pBuffer, p->size);
+		Send(p->opcode, pout);
+		return;
+	}
+
 	EQ::Net::DynamicPacket pout;
 	if (p->pBuffer) {
 		pout.PutData(0, p->pBuffer, p->size);
@@ -268,25 +292,31 @@ void EQ::Net::ServertalkServerConnection::OnDisconnect(TCPConnection *c)
 
 void EQ::Net::ServertalkServerConnection::SendHello()
 {
-	EQ::Net::DynamicPacket hello;
-	hello.PutInt8(0, 0);
+	char hello = 0;
+	auto buffer = uv_buf_init(&hello, sizeof(hello));
 
-	InternalSend(ServertalkServerHello, hello);
+	InternalSend(ServertalkServerHello, &buffer, 1);
 }
 
-void EQ::Net::ServertalkServerConnection::InternalSend(ServertalkPacketType type, EQ::Net::Packet &p)
+void EQ::Net::ServertalkServerConnection::InternalSend(ServertalkPacketType type, const uv_buf_t *buffers, size_t count)
 {
 	if (!m_connection || m_legacy_mode)
 		return;
 
-	EQ::Net::DynamicPacket out;
-	out.PutUInt32(0, (uint32_t)p.Length());
-	out.PutUInt8(4, (uint8_t)type);
-	if (p.Length() > 0) {
-		out.PutPacket(5, p);
+	//the framing is built in place, what follows it is written straight from the caller's buffers
+	size_t length = 0;
+	for (size_t i = 0; i < count; ++i) {
+		length += buffers[i].len;
 	}
 
-	m_connection->Write((const char*)out.Data(), out.Length());
+	char header_buffer[5];
+	EQ::Net::StaticPacket header(header_buffer, sizeof(header_buffer));
+	header.PutUInt32(0, (uint32_t)length);
+	header.PutUInt8(4, (uint8_t)type);
+
+	auto framing = uv_buf_init(header_buffer, sizeof(header_buffer));
+	m_connection->Write(&framing, 1);
+	m_connection->Write(buffers, count);
 }
 
 void EQ::Net::ServertalkServerConnection::ProcessHandshake(EQ::Net::Packet &p)
@@ -30,7 +30,7 @@ namespace EQ
 			void ProcessOldReadBuffer();
 			void OnDisconnect(TCPConnection* c);
 			void SendHello();
-			void InternalSend(ServertalkPacketType type, EQ::Net::Packet &p);
+			void InternalSend(ServertalkPacketType type, const uv_buf_t *buffers, size_t count);
 			void ProcessHandshake(EQ::Net::Packet &p);
 			void ProcessMessage(EQ::Net::Packet &p);
 			void ProcessMessageOld(uint16_t opcode, EQ::Net::Packet &p);
@@ -1,5 +1,9 @@
 #include "tcp_connection.h"
 #include "../event/event_loop.h"
+#include <algorithm>
+
+//writes made in one loop iteration are copied into chunks of this size and go out as one uv_write
+constexpr size_t WriteChunkSize = 64 * 1024;
 
 void on_close_handle(uv_handle_t* handle) {
 	delete (uv_tcp_t *)handle;
@@ -109,6 +113,10 @@ void EQ::Net::TCPConnection::OnDisconnect(std::function<void(TCPConnection*)> cb
 void EQ::Net::TCPConnection::Disconnect()
 {
 	if (m_socket) {
+		//whatever was written before the disconnect still goes out ahead of the close
+		Flush();
+		m_flush.reset();
+
 		m_socket->data = this;
 		uv_close((uv_handle_t*)m_socket, [](uv_handle_t* handle) {
 			TCPConnection *connection = (TCPConnection*)handle->data;
@@ -131,32 +139,83 @@ void EQ::Net::TCPConnection::Read(const char *data, size_t count)
 }
 
 void EQ::Net::TCPConnection::Write(const char *data, size_t count)
+{
+	uv_buf_t buffer = uv_buf_init((char*)data, count);
+	Write(&buffer, 1);
+}
+
+void EQ::Net::TCPConnection::Write(const uv_buf_t *buffers, size_t count)
 {
 	if (!m_socket) {
 		return;
 	}
 
+	if (m_write_chunks.empty()) {
+		if (!m_flush) {
+			m_flush.reset(new EQ::LoopFlush(m_socket->loop, [this]() { Flush(); }));
+		}
+
+		m_flush->Start();
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		Append(buffers[i].base, buffers[i].len);
+	}
+}
+
+void EQ::Net::TCPConnection::Append(const char *data, size_t count)
+{
+	while (count > 0) {
+		if (m_write_chunks.empty() || m_write_chunks.back().length == m_write_chunks.back().capacity) {
+			WriteChunk chunk;
+			chunk.capacity = std::max(WriteChunkSize, count);
+			chunk.data.reset(new char[chunk.capacity]);
+			chunk.length = 0;
+			m_write_chunks.push_back(std::move(chunk));
+		}
+
+		auto &chunk = m_write_chunks.back();
+		auto length = std::min(count, chunk.capacity - chunk.length);
+		memcpy(chunk.data.get() + chunk.length, data, length);
+		chunk.length += length;
+		data += length;
+		count -= length;
+	}
+}
+
+void EQ::Net::TCPConnection::Flush()
+{
+	if (m_flush) {
+		m_flush->Stop();
+	}
+
+	if (!m_socket || m_write_chunks.empty()) {
+		m_write_chunks.clear();
+		return;
+	}
+
 	struct WriteBaton
 	{
 		TCPConnection *connection;
-		char *buffer;
+		std::vector<WriteChunk> chunks;
 	};
 
 	WriteBaton *baton = new WriteBaton;
 	baton->connection = this;
-	baton->buffer = new char[count];
+	baton->chunks.swap(m_write_chunks);
+
+	std::vector<uv_buf_t> send_buffers;
+	send_buffers.reserve(baton->chunks.size());
+	for (auto &chunk : baton->chunks) {
+		send_buffers.push_back(uv_buf_init(chunk.data.get(), chunk.length));
+	}
 
 	uv_write_t *write_req = new uv_write_t;
 	memset(write_req, 0, sizeof(uv_write_t));
 	write_req->data = baton;
-	uv_buf_t send_buffers[1];
-
-	memcpy(baton->buffer, data, count);
-	send_buffers[0] = uv_buf_init(baton->buffer, count);
 
-	uv_write(write_req, (uv_stream_t*)m_socket, send_buffers, 1, [](uv_write_t* req, int status) {
+	uv_write(write_req, (uv_stream_t*)m_socket, &send_buffers[0], send_buffers.size(), [](uv_write_t* req, int status) {
 		WriteBaton *baton = (WriteBaton*)req->data;
-		delete[] baton->buffer;
 		delete req;
 
 		if (status < 0) {
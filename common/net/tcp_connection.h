@@ -3,7 +3,9 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 #include <uv.h>
+#include "../event/loop_flush.h"
 
 namespace EQ
 {
@@ -23,6 +25,8 @@ namespace EQ
 			void Disconnect();
 			void Read(const char *data, size_t count);
 			void Write(const char *data, size_t count);
+			void Write(const uv_buf_t *buffers, size_t count);
+			void Flush();
 
 			bool IsConnected() const;
 			std::string LocalIP() const;
@@ -33,7 +37,18 @@ namespace EQ
 		private:
 			TCPConnection();
 
+			struct WriteChunk
+			{
+				std::unique_ptr<char[]> data;
+				size_t length;
+				size_t capacity;
+			};
+
+			void Append(const char *data, size_t count);
+
 			uv_tcp_t *m_socket;
+			std::vector<WriteChunk> m_write_chunks;
+			std::unique_ptr<EQ::LoopFlush> m_flush;
 			std::function<void(TCPConnection*, const unsigned char *, size_t)> m_on_read_cb;
 			std::function<void(TCPConnection*)> m_on_disconnect_cb;
 		};
@@ -83,3 +83,25 @@ void EQ::Net::TCPServer::AddClient(uv_tcp_t *c)
 		m_on_new_connection(client);
 	}
 }
+
+int EQ::Net::TCPServer::LocalPort() const
+{
+	if (!m_socket) {
+		return 0;
+	}
+
+	sockaddr_storage addr;
+	int addr_len = sizeof(addr);
+	uv_tcp_getsockname(m_socket, (sockaddr*)&addr, &addr_len);
+
+	if (addr.ss_family == AF_INET) {
+		sockaddr_in *s = (sockaddr_in*)&addr;
+		return ntohs(s->sin_port);
+	}
+	else if (addr.ss_family == AF_INET6) {
+		sockaddr_in6 *s = (sockaddr_in6*)&addr;
+		return ntohs(s->sin6_port);
+	}
+
+	return 0;
+}
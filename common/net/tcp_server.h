@@ -16,6 +16,7 @@ namespace EQ
 			void Listen(const std::string &addr, int port, bool ipv6, std::function<void(std::shared_ptr<TCPConnection>)> cb);
 			void Close();
 			void AddClient(uv_tcp_t *c);
+			int LocalPort() const;
 
 		private:
 			std::function<void(std::shared_ptr<TCPConnection>)> m_on_new_connection;
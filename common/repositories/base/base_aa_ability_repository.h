@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAaAbilityRepository {
@@ -34,6 +36,9 @@ public:
 		uint8_t     enabled;
 		int8_t      reset_on_death;
 		int8_t      auto_grant_enabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AaAbility &e,
+		const AaAbility &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.category != original.category;
+		e.changed_columns[3] = e.classes != original.classes;
+		e.changed_columns[4] = e.races != original.races;
+		e.changed_columns[5] = e.drakkin_heritage != original.drakkin_heritage;
+		e.changed_columns[6] = e.deities != original.deities;
+		e.changed_columns[7] = e.status != original.status;
+		e.changed_columns[8] = e.type != original.type;
+		e.changed_columns[9] = e.charges != original.charges;
+		e.changed_columns[10] = e.grant_only != original.grant_only;
+		e.changed_columns[11] = e.first_rank_id != original.first_rank_id;
+		e.changed_columns[12] = e.enabled != original.enabled;
+		e.changed_columns[13] = e.reset_on_death != original.reset_on_death;
+		e.changed_columns[14] = e.auto_grant_enabled != original.auto_grant_enabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AaAbility &e
@@ -219,21 +247,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.category));
-		v.push_back(columns[3] + " = " + std::to_string(e.classes));
-		v.push_back(columns[4] + " = " + std::to_string(e.races));
-		v.push_back(columns[5] + " = " + std::to_string(e.drakkin_heritage));
-		v.push_back(columns[6] + " = " + std::to_string(e.deities));
-		v.push_back(columns[7] + " = " + std::to_string(e.status));
-		v.push_back(columns[8] + " = " + std::to_string(e.type));
-		v.push_back(columns[9] + " = " + std::to_string(e.charges));
-		v.push_back(columns[10] + " = " + std::to_string(e.grant_only));
-		v.push_back(columns[11] + " = " + std::to_string(e.first_rank_id));
-		v.push_back(columns[12] + " = " + std::to_string(e.enabled));
-		v.push_back(columns[13] + " = " + std::to_string(e.reset_on_death));
-		v.push_back(columns[14] + " = " + std::to_string(e.auto_grant_enabled));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.category)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.classes)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.races)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.drakkin_heritage)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.deities)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.status)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.grant_only)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.first_rank_id)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.enabled)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.reset_on_death)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.auto_grant_enabled)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -408,6 +440,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AaAbility FromStmtRow(const mysql::StmtRow &row)
+	{
+		AaAbility e{};
+
+		e.id                 = row.Get<uint32_t>(0).value_or(0);
+		e.name               = row.GetStr(1).value_or("");
+		e.category           = row.Get<int32_t>(2).value_or(-1);
+		e.classes            = row.Get<int32_t>(3).value_or(131070);
+		e.races              = row.Get<int32_t>(4).value_or(65535);
+		e.drakkin_heritage   = row.Get<int32_t>(5).value_or(127);
+		e.deities            = row.Get<int32_t>(6).value_or(131071);
+		e.status             = row.Get<int32_t>(7).value_or(0);
+		e.type               = row.Get<int32_t>(8).value_or(0);
+		e.charges            = row.Get<int32_t>(9).value_or(0);
+		e.grant_only         = row.Get<int8_t>(10).value_or(0);
+		e.first_rank_id      = row.Get<int32_t>(11).value_or(-1);
+		e.enabled            = row.Get<uint8_t>(12).value_or(1);
+		e.reset_on_death     = row.Get<int8_t>(13).value_or(0);
+		e.auto_grant_enabled = row.Get<int8_t>(14).value_or(0);
+
+		return e;
+	}
+
+	static AaAbility FindOnePrepared(
+		Database& db,
+		int aa_ability_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { aa_ability_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AaAbility> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AaAbility> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -509,7 +605,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -531,13 +635,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
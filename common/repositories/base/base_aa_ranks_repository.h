@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAaRanksRepository {
@@ -32,6 +34,9 @@ public:
 		int32_t  expansion;
 		int32_t  prev_id;
 		int32_t  next_id;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AaRanks &e,
+		const AaRanks &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.upper_hotkey_sid != original.upper_hotkey_sid;
+		e.changed_columns[2] = e.lower_hotkey_sid != original.lower_hotkey_sid;
+		e.changed_columns[3] = e.title_sid != original.title_sid;
+		e.changed_columns[4] = e.desc_sid != original.desc_sid;
+		e.changed_columns[5] = e.cost != original.cost;
+		e.changed_columns[6] = e.level_req != original.level_req;
+		e.changed_columns[7] = e.spell != original.spell;
+		e.changed_columns[8] = e.spell_type != original.spell_type;
+		e.changed_columns[9] = e.recast_time != original.recast_time;
+		e.changed_columns[10] = e.expansion != original.expansion;
+		e.changed_columns[11] = e.prev_id != original.prev_id;
+		e.changed_columns[12] = e.next_id != original.next_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AaRanks &e
@@ -209,19 +235,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.upper_hotkey_sid));
-		v.push_back(columns[2] + " = " + std::to_string(e.lower_hotkey_sid));
-		v.push_back(columns[3] + " = " + std::to_string(e.title_sid));
-		v.push_back(columns[4] + " = " + std::to_string(e.desc_sid));
-		v.push_back(columns[5] + " = " + std::to_string(e.cost));
-		v.push_back(columns[6] + " = " + std::to_string(e.level_req));
-		v.push_back(columns[7] + " = " + std::to_string(e.spell));
-		v.push_back(columns[8] + " = " + std::to_string(e.spell_type));
-		v.push_back(columns[9] + " = " + std::to_string(e.recast_time));
-		v.push_back(columns[10] + " = " + std::to_string(e.expansion));
-		v.push_back(columns[11] + " = " + std::to_string(e.prev_id));
-		v.push_back(columns[12] + " = " + std::to_string(e.next_id));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.upper_hotkey_sid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.lower_hotkey_sid)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.title_sid)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.desc_sid)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.cost)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.level_req)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.spell)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.spell_type)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.recast_time)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.expansion)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.prev_id)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.next_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -388,6 +418,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AaRanks FromStmtRow(const mysql::StmtRow &row)
+	{
+		AaRanks e{};
+
+		e.id               = row.Get<uint32_t>(0).value_or(0);
+		e.upper_hotkey_sid = row.Get<int32_t>(1).value_or(-1);
+		e.lower_hotkey_sid = row.Get<int32_t>(2).value_or(-1);
+		e.title_sid        = row.Get<int32_t>(3).value_or(-1);
+		e.desc_sid         = row.Get<int32_t>(4).value_or(-1);
+		e.cost             = row.Get<int32_t>(5).value_or(1);
+		e.level_req        = row.Get<int32_t>(6).value_or(51);
+		e.spell            = row.Get<int32_t>(7).value_or(-1);
+		e.spell_type       = row.Get<int32_t>(8).value_or(0);
+		e.recast_time      = row.Get<int32_t>(9).value_or(0);
+		e.expansion        = row.Get<int32_t>(10).value_or(0);
+		e.prev_id          = row.Get<int32_t>(11).value_or(-1);
+		e.next_id          = row.Get<int32_t>(12).value_or(-1);
+
+		return e;
+	}
+
+	static AaRanks FindOnePrepared(
+		Database& db,
+		int aa_ranks_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { aa_ranks_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AaRanks> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AaRanks> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -487,7 +579,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -507,13 +607,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAccountIpRepository {
@@ -23,6 +25,9 @@ public:
 		std::string ip;
 		int32_t     count;
 		time_t      lastused;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<4> changed_columns = std::bitset<4>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -155,6 +160,18 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AccountIp &e,
+		const AccountIp &original
+	)
+	{
+		e.changed_columns[0] = e.accid != original.accid;
+		e.changed_columns[1] = e.ip != original.ip;
+		e.changed_columns[2] = e.count != original.count;
+		e.changed_columns[3] = e.lastused != original.lastused;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AccountIp &e
@@ -164,10 +181,14 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.accid));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.ip) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.count));
-		v.push_back(columns[3] + " = FROM_UNIXTIME(" + (e.lastused > 0 ? std::to_string(e.lastused) : "null") + ")");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.accid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.ip) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.count)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = FROM_UNIXTIME(" + (e.lastused > 0 ? std::to_string(e.lastused) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -298,6 +319,59 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AccountIp FromStmtRow(const mysql::StmtRow &row)
+	{
+		AccountIp e{};
+
+		e.accid    = row.Get<int32_t>(0).value_or(0);
+		e.ip       = row.GetStr(1).value_or("");
+		e.count    = row.Get<int32_t>(2).value_or(1);
+		e.lastused = row.Get<int64_t>(3).value_or(-1);
+
+		return e;
+	}
+
+	static AccountIp FindOnePrepared(
+		Database& db,
+		int account_ip_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { account_ip_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AccountIp> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AccountIp> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -388,7 +462,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<4> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.accid));
@@ -399,13 +481,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
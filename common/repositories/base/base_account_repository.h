@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAccountRepository {
@@ -44,6 +46,9 @@ public:
 		std::string crc_eqgame;
 		std::string crc_skillcaps;
 		std::string crc_basedata;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<25> changed_columns = std::bitset<25>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -260,6 +265,39 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Account &e,
+		const Account &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.charname != original.charname;
+		e.changed_columns[3] = e.auto_login_charname != original.auto_login_charname;
+		e.changed_columns[4] = e.sharedplat != original.sharedplat;
+		e.changed_columns[5] = e.password != original.password;
+		e.changed_columns[6] = e.status != original.status;
+		e.changed_columns[7] = e.ls_id != original.ls_id;
+		e.changed_columns[8] = e.lsaccount_id != original.lsaccount_id;
+		e.changed_columns[9] = e.gmspeed != original.gmspeed;
+		e.changed_columns[10] = e.invulnerable != original.invulnerable;
+		e.changed_columns[11] = e.flymode != original.flymode;
+		e.changed_columns[12] = e.ignore_tells != original.ignore_tells;
+		e.changed_columns[13] = e.revoked != original.revoked;
+		e.changed_columns[14] = e.karma != original.karma;
+		e.changed_columns[15] = e.minilogin_ip != original.minilogin_ip;
+		e.changed_columns[16] = e.hideme != original.hideme;
+		e.changed_columns[17] = e.rulesflag != original.rulesflag;
+		e.changed_columns[18] = e.suspendeduntil != original.suspendeduntil;
+		e.changed_columns[19] = e.time_creation != original.time_creation;
+		e.changed_columns[20] = e.ban_reason != original.ban_reason;
+		e.changed_columns[21] = e.suspend_reason != original.suspend_reason;
+		e.changed_columns[22] = e.crc_eqgame != original.crc_eqgame;
+		e.changed_columns[23] = e.crc_skillcaps != original.crc_skillcaps;
+		e.changed_columns[24] = e.crc_basedata != original.crc_basedata;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Account &e
@@ -269,30 +307,34 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.auto_login_charname) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.sharedplat));
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.password) + "'");
-		v.push_back(columns[6] + " = " + std::to_string(e.status));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.ls_id) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.lsaccount_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.gmspeed));
-		v.push_back(columns[10] + " = " + std::to_string(e.invulnerable));
-		v.push_back(columns[11] + " = " + std::to_string(e.flymode));
-		v.push_back(columns[12] + " = " + std::to_string(e.ignore_tells));
-		v.push_back(columns[13] + " = " + std::to_string(e.revoked));
-		v.push_back(columns[14] + " = " + std::to_string(e.karma));
-		v.push_back(columns[15] + " = '" + Strings::Escape(e.minilogin_ip) + "'");
-		v.push_back(columns[16] + " = " + std::to_string(e.hideme));
-		v.push_back(columns[17] + " = " + std::to_string(e.rulesflag));
-		v.push_back(columns[18] + " = FROM_UNIXTIME(" + (e.suspendeduntil > 0 ? std::to_string(e.suspendeduntil) : "null") + ")");
-		v.push_back(columns[19] + " = " + std::to_string(e.time_creation));
-		v.push_back(columns[20] + " = '" + Strings::Escape(e.ban_reason) + "'");
-		v.push_back(columns[21] + " = '" + Strings::Escape(e.suspend_reason) + "'");
-		v.push_back(columns[22] + " = '" + Strings::Escape(e.crc_eqgame) + "'");
-		v.push_back(columns[23] + " = '" + Strings::Escape(e.crc_skillcaps) + "'");
-		v.push_back(columns[24] + " = '" + Strings::Escape(e.crc_basedata) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.auto_login_charname) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.sharedplat)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.password) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.status)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.ls_id) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.lsaccount_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.gmspeed)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.invulnerable)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.flymode)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.ignore_tells)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.revoked)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.karma)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = '" + Strings::Escape(e.minilogin_ip) + "'"); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.hideme)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.rulesflag)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = FROM_UNIXTIME(" + (e.suspendeduntil > 0 ? std::to_string(e.suspendeduntil) : "null") + ")"); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.time_creation)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = '" + Strings::Escape(e.ban_reason) + "'"); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = '" + Strings::Escape(e.suspend_reason) + "'"); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = '" + Strings::Escape(e.crc_eqgame) + "'"); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = '" + Strings::Escape(e.crc_skillcaps) + "'"); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = '" + Strings::Escape(e.crc_basedata) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -507,6 +549,80 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Account FromStmtRow(const mysql::StmtRow &row)
+	{
+		Account e{};
+
+		e.id                  = row.Get<int32_t>(0).value_or(0);
+		e.name                = row.GetStr(1).value_or("");
+		e.charname            = row.GetStr(2).value_or("");
+		e.auto_login_charname = row.GetStr(3).value_or("");
+		e.sharedplat          = row.Get<uint32_t>(4).value_or(0);
+		e.password            = row.GetStr(5).value_or("");
+		e.status              = row.Get<int32_t>(6).value_or(0);
+		e.ls_id               = row.GetStr(7).value_or("eqemu");
+		e.lsaccount_id        = row.Get<uint32_t>(8).value_or(0);
+		e.gmspeed             = row.Get<uint8_t>(9).value_or(0);
+		e.invulnerable        = row.Get<int8_t>(10).value_or(0);
+		e.flymode             = row.Get<int8_t>(11).value_or(0);
+		e.ignore_tells        = row.Get<int8_t>(12).value_or(0);
+		e.revoked             = row.Get<uint8_t>(13).value_or(0);
+		e.karma               = row.Get<uint32_t>(14).value_or(0);
+		e.minilogin_ip        = row.GetStr(15).value_or("");
+		e.hideme              = row.Get<int8_t>(16).value_or(0);
+		e.rulesflag           = row.Get<uint8_t>(17).value_or(0);
+		e.suspendeduntil      = row.Get<int64_t>(18).value_or(-1);
+		e.time_creation       = row.Get<uint32_t>(19).value_or(0);
+		e.ban_reason          = row.GetStr(20).value_or("");
+		e.suspend_reason      = row.GetStr(21).value_or("");
+		e.crc_eqgame          = row.GetStr(22).value_or("");
+		e.crc_skillcaps       = row.GetStr(23).value_or("");
+		e.crc_basedata        = row.GetStr(24).value_or("");
+
+		return e;
+	}
+
+	static Account FindOnePrepared(
+		Database& db,
+		int account_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { account_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Account> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Account> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -618,7 +734,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<25> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -650,13 +774,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAccountRewardsRepository {
@@ -22,6 +24,9 @@ public:
 		uint32_t account_id;
 		uint32_t reward_id;
 		uint32_t amount;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<3> changed_columns = std::bitset<3>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -150,6 +155,17 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AccountRewards &e,
+		const AccountRewards &original
+	)
+	{
+		e.changed_columns[0] = e.account_id != original.account_id;
+		e.changed_columns[1] = e.reward_id != original.reward_id;
+		e.changed_columns[2] = e.amount != original.amount;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AccountRewards &e
@@ -159,9 +175,13 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.reward_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.amount));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.reward_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.amount)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -288,6 +308,58 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AccountRewards FromStmtRow(const mysql::StmtRow &row)
+	{
+		AccountRewards e{};
+
+		e.account_id = row.Get<uint32_t>(0).value_or(0);
+		e.reward_id  = row.Get<uint32_t>(1).value_or(0);
+		e.amount     = row.Get<uint32_t>(2).value_or(0);
+
+		return e;
+	}
+
+	static AccountRewards FindOnePrepared(
+		Database& db,
+		int account_rewards_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { account_rewards_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AccountRewards> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AccountRewards> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -377,7 +449,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<3> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.account_id));
@@ -387,13 +467,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAdventureDetailsRepository {
@@ -28,6 +30,9 @@ public:
 		uint32_t time_created;
 		uint32_t time_zoned;
 		uint32_t time_completed;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AdventureDetails &e,
+		const AdventureDetails &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.adventure_id != original.adventure_id;
+		e.changed_columns[2] = e.instance_id != original.instance_id;
+		e.changed_columns[3] = e.count != original.count;
+		e.changed_columns[4] = e.assassinate_count != original.assassinate_count;
+		e.changed_columns[5] = e.status != original.status;
+		e.changed_columns[6] = e.time_created != original.time_created;
+		e.changed_columns[7] = e.time_zoned != original.time_zoned;
+		e.changed_columns[8] = e.time_completed != original.time_completed;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AdventureDetails &e
@@ -189,14 +211,18 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.adventure_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.count));
-		v.push_back(columns[4] + " = " + std::to_string(e.assassinate_count));
-		v.push_back(columns[5] + " = " + std::to_string(e.status));
-		v.push_back(columns[6] + " = " + std::to_string(e.time_created));
-		v.push_back(columns[7] + " = " + std::to_string(e.time_zoned));
-		v.push_back(columns[8] + " = " + std::to_string(e.time_completed));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.adventure_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.count)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.assassinate_count)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.status)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.time_created)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.time_zoned)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.time_completed)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -347,6 +373,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AdventureDetails FromStmtRow(const mysql::StmtRow &row)
+	{
+		AdventureDetails e{};
+
+		e.id                = row.Get<uint32_t>(0).value_or(0);
+		e.adventure_id      = row.Get<uint16_t>(1).value_or(0);
+		e.instance_id       = row.Get<int32_t>(2).value_or(-1);
+		e.count             = row.Get<uint16_t>(3).value_or(0);
+		e.assassinate_count = row.Get<uint16_t>(4).value_or(0);
+		e.status            = row.Get<uint8_t>(5).value_or(0);
+		e.time_created      = row.Get<uint32_t>(6).value_or(0);
+		e.time_zoned        = row.Get<uint32_t>(7).value_or(0);
+		e.time_completed    = row.Get<uint32_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static AdventureDetails FindOnePrepared(
+		Database& db,
+		int adventure_details_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { adventure_details_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AdventureDetails> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AdventureDetails> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -442,7 +526,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -458,13 +550,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
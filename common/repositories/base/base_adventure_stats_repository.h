@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAdventureStatsRepository {
@@ -30,6 +32,9 @@ public:
 		uint32_t mmc_losses;
 		uint32_t ruj_losses;
 		uint32_t tak_losses;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<11> changed_columns = std::bitset<11>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -190,6 +195,25 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AdventureStats &e,
+		const AdventureStats &original
+	)
+	{
+		e.changed_columns[0] = e.player_id != original.player_id;
+		e.changed_columns[1] = e.guk_wins != original.guk_wins;
+		e.changed_columns[2] = e.mir_wins != original.mir_wins;
+		e.changed_columns[3] = e.mmc_wins != original.mmc_wins;
+		e.changed_columns[4] = e.ruj_wins != original.ruj_wins;
+		e.changed_columns[5] = e.tak_wins != original.tak_wins;
+		e.changed_columns[6] = e.guk_losses != original.guk_losses;
+		e.changed_columns[7] = e.mir_losses != original.mir_losses;
+		e.changed_columns[8] = e.mmc_losses != original.mmc_losses;
+		e.changed_columns[9] = e.ruj_losses != original.ruj_losses;
+		e.changed_columns[10] = e.tak_losses != original.tak_losses;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AdventureStats &e
@@ -199,17 +223,21 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.player_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.guk_wins));
-		v.push_back(columns[2] + " = " + std::to_string(e.mir_wins));
-		v.push_back(columns[3] + " = " + std::to_string(e.mmc_wins));
-		v.push_back(columns[4] + " = " + std::to_string(e.ruj_wins));
-		v.push_back(columns[5] + " = " + std::to_string(e.tak_wins));
-		v.push_back(columns[6] + " = " + std::to_string(e.guk_losses));
-		v.push_back(columns[7] + " = " + std::to_string(e.mir_losses));
-		v.push_back(columns[8] + " = " + std::to_string(e.mmc_losses));
-		v.push_back(columns[9] + " = " + std::to_string(e.ruj_losses));
-		v.push_back(columns[10] + " = " + std::to_string(e.tak_losses));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.player_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.guk_wins)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.mir_wins)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.mmc_wins)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.ruj_wins)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.tak_wins)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.guk_losses)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.mir_losses)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mmc_losses)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.ruj_losses)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.tak_losses)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -368,6 +396,66 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AdventureStats FromStmtRow(const mysql::StmtRow &row)
+	{
+		AdventureStats e{};
+
+		e.player_id  = row.Get<uint32_t>(0).value_or(0);
+		e.guk_wins   = row.Get<uint32_t>(1).value_or(0);
+		e.mir_wins   = row.Get<uint32_t>(2).value_or(0);
+		e.mmc_wins   = row.Get<uint32_t>(3).value_or(0);
+		e.ruj_wins   = row.Get<uint32_t>(4).value_or(0);
+		e.tak_wins   = row.Get<uint32_t>(5).value_or(0);
+		e.guk_losses = row.Get<uint32_t>(6).value_or(0);
+		e.mir_losses = row.Get<uint32_t>(7).value_or(0);
+		e.mmc_losses = row.Get<uint32_t>(8).value_or(0);
+		e.ruj_losses = row.Get<uint32_t>(9).value_or(0);
+		e.tak_losses = row.Get<uint32_t>(10).value_or(0);
+
+		return e;
+	}
+
+	static AdventureStats FindOnePrepared(
+		Database& db,
+		int adventure_stats_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { adventure_stats_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AdventureStats> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AdventureStats> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -465,7 +553,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<11> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.player_id));
@@ -483,13 +579,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAdventureTemplateRepository {
@@ -52,6 +54,9 @@ public:
 		float       graveyard_y;
 		float       graveyard_z;
 		std::string graveyard_radius;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<33> changed_columns = std::bitset<33>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -299,6 +304,47 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		AdventureTemplate &e,
+		const AdventureTemplate &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.zone_version != original.zone_version;
+		e.changed_columns[3] = e.is_hard != original.is_hard;
+		e.changed_columns[4] = e.is_raid != original.is_raid;
+		e.changed_columns[5] = e.min_level != original.min_level;
+		e.changed_columns[6] = e.max_level != original.max_level;
+		e.changed_columns[7] = e.type != original.type;
+		e.changed_columns[8] = e.type_data != original.type_data;
+		e.changed_columns[9] = e.type_count != original.type_count;
+		e.changed_columns[10] = e.assa_x != original.assa_x;
+		e.changed_columns[11] = e.assa_y != original.assa_y;
+		e.changed_columns[12] = e.assa_z != original.assa_z;
+		e.changed_columns[13] = e.assa_h != original.assa_h;
+		e.changed_columns[14] = e.text != original.text;
+		e.changed_columns[15] = e.duration != original.duration;
+		e.changed_columns[16] = e.zone_in_time != original.zone_in_time;
+		e.changed_columns[17] = e.win_points != original.win_points;
+		e.changed_columns[18] = e.lose_points != original.lose_points;
+		e.changed_columns[19] = e.theme != original.theme;
+		e.changed_columns[20] = e.zone_in_zone_id != original.zone_in_zone_id;
+		e.changed_columns[21] = e.zone_in_x != original.zone_in_x;
+		e.changed_columns[22] = e.zone_in_y != original.zone_in_y;
+		e.changed_columns[23] = e.zone_in_object_id != original.zone_in_object_id;
+		e.changed_columns[24] = e.dest_x != original.dest_x;
+		e.changed_columns[25] = e.dest_y != original.dest_y;
+		e.changed_columns[26] = e.dest_z != original.dest_z;
+		e.changed_columns[27] = e.dest_h != original.dest_h;
+		e.changed_columns[28] = e.graveyard_zone_id != original.graveyard_zone_id;
+		e.changed_columns[29] = e.graveyard_x != original.graveyard_x;
+		e.changed_columns[30] = e.graveyard_y != original.graveyard_y;
+		e.changed_columns[31] = e.graveyard_z != original.graveyard_z;
+		e.changed_columns[32] = e.graveyard_radius != original.graveyard_radius;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const AdventureTemplate &e
@@ -308,39 +354,43 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.zone_version));
-		v.push_back(columns[3] + " = " + std::to_string(e.is_hard));
-		v.push_back(columns[4] + " = " + std::to_string(e.is_raid));
-		v.push_back(columns[5] + " = " + std::to_string(e.min_level));
-		v.push_back(columns[6] + " = " + std::to_string(e.max_level));
-		v.push_back(columns[7] + " = " + std::to_string(e.type));
-		v.push_back(columns[8] + " = " + std::to_string(e.type_data));
-		v.push_back(columns[9] + " = " + std::to_string(e.type_count));
-		v.push_back(columns[10] + " = " + std::to_string(e.assa_x));
-		v.push_back(columns[11] + " = " + std::to_string(e.assa_y));
-		v.push_back(columns[12] + " = " + std::to_string(e.assa_z));
-		v.push_back(columns[13] + " = " + std::to_string(e.assa_h));
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.text) + "'");
-		v.push_back(columns[15] + " = " + std::to_string(e.duration));
-		v.push_back(columns[16] + " = " + std::to_string(e.zone_in_time));
-		v.push_back(columns[17] + " = " + std::to_string(e.win_points));
-		v.push_back(columns[18] + " = " + std::to_string(e.lose_points));
-		v.push_back(columns[19] + " = " + std::to_string(e.theme));
-		v.push_back(columns[20] + " = " + std::to_string(e.zone_in_zone_id));
-		v.push_back(columns[21] + " = " + std::to_string(e.zone_in_x));
-		v.push_back(columns[22] + " = " + std::to_string(e.zone_in_y));
-		v.push_back(columns[23] + " = " + std::to_string(e.zone_in_object_id));
-		v.push_back(columns[24] + " = " + std::to_string(e.dest_x));
-		v.push_back(columns[25] + " = " + std::to_string(e.dest_y));
-		v.push_back(columns[26] + " = " + std::to_string(e.dest_z));
-		v.push_back(columns[27] + " = " + std::to_string(e.dest_h));
-		v.push_back(columns[28] + " = " + std::to_string(e.graveyard_zone_id));
-		v.push_back(columns[29] + " = " + std::to_string(e.graveyard_x));
-		v.push_back(columns[30] + " = " + std::to_string(e.graveyard_y));
-		v.push_back(columns[31] + " = " + std::to_string(e.graveyard_z));
-		v.push_back(columns[32] + " = " + std::to_string(e.graveyard_radius));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.zone_version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.is_hard)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.is_raid)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.min_level)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.max_level)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.type_data)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.type_count)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.assa_x)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.assa_y)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.assa_z)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.assa_h)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.text) + "'"); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.duration)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.zone_in_time)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.win_points)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.lose_points)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.theme)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.zone_in_zone_id)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.zone_in_x)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.zone_in_y)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.zone_in_object_id)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.dest_x)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.dest_y)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.dest_z)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.dest_h)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.graveyard_zone_id)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.graveyard_x)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.graveyard_y)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.graveyard_z)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.graveyard_radius)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -585,6 +635,87 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static AdventureTemplate FromStmtRow(const mysql::StmtRow &row)
+	{
+		AdventureTemplate e{};
+
+		e.id                = row.Get<uint32_t>(0).value_or(0);
+		e.zone              = row.GetStr(1).value_or("");
+		e.zone_version      = row.Get<uint8_t>(2).value_or(0);
+		e.is_hard           = row.Get<uint8_t>(3).value_or(0);
+		e.is_raid           = row.Get<uint8_t>(4).value_or(0);
+		e.min_level         = row.Get<uint8_t>(5).value_or(1);
+		e.max_level         = row.Get<uint8_t>(6).value_or(65);
+		e.type              = row.Get<uint8_t>(7).value_or(0);
+		e.type_data         = row.Get<uint32_t>(8).value_or(0);
+		e.type_count        = row.Get<uint16_t>(9).value_or(0);
+		e.assa_x            = row.Get<float>(10).value_or(0);
+		e.assa_y            = row.Get<float>(11).value_or(0);
+		e.assa_z            = row.Get<float>(12).value_or(0);
+		e.assa_h            = row.Get<float>(13).value_or(0);
+		e.text              = row.GetStr(14).value_or("");
+		e.duration          = row.Get<uint32_t>(15).value_or(7200);
+		e.zone_in_time      = row.Get<uint32_t>(16).value_or(1800);
+		e.win_points        = row.Get<uint16_t>(17).value_or(0);
+		e.lose_points       = row.Get<uint16_t>(18).value_or(0);
+		e.theme             = row.Get<uint8_t>(19).value_or(1);
+		e.zone_in_zone_id   = row.Get<uint16_t>(20).value_or(0);
+		e.zone_in_x         = row.Get<float>(21).value_or(0);
+		e.zone_in_y         = row.Get<float>(22).value_or(0);
+		e.zone_in_object_id = row.Get<int16_t>(23).value_or(0);
+		e.dest_x            = row.Get<float>(24).value_or(0);
+		e.dest_y            = row.Get<float>(25).value_or(0);
+		e.dest_z            = row.Get<float>(26).value_or(0);
+		e.dest_h            = row.Get<float>(27).value_or(0);
+		e.graveyard_zone_id = row.Get<uint32_t>(28).value_or(0);
+		e.graveyard_x       = row.Get<float>(29).value_or(0);
+		e.graveyard_y       = row.Get<float>(30).value_or(0);
+		e.graveyard_z       = row.Get<float>(31).value_or(0);
+
+		return e;
+	}
+
+	static AdventureTemplate FindOnePrepared(
+		Database& db,
+		int adventure_template_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { adventure_template_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<AdventureTemplate> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<AdventureTemplate> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -704,7 +835,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<33> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -744,13 +883,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseAurasRepository {
@@ -30,6 +32,9 @@ public:
 		int32_t     duration;
 		int32_t     icon;
 		int32_t     cast_time;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<11> changed_columns = std::bitset<11>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -190,6 +195,25 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Auras &e,
+		const Auras &original
+	)
+	{
+		e.changed_columns[0] = e.type != original.type;
+		e.changed_columns[1] = e.npc_type != original.npc_type;
+		e.changed_columns[2] = e.name != original.name;
+		e.changed_columns[3] = e.spell_id != original.spell_id;
+		e.changed_columns[4] = e.distance != original.distance;
+		e.changed_columns[5] = e.aura_type != original.aura_type;
+		e.changed_columns[6] = e.spawn_type != original.spawn_type;
+		e.changed_columns[7] = e.movement != original.movement;
+		e.changed_columns[8] = e.duration != original.duration;
+		e.changed_columns[9] = e.icon != original.icon;
+		e.changed_columns[10] = e.cast_time != original.cast_time;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Auras &e
@@ -199,17 +223,21 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.type));
-		v.push_back(columns[1] + " = " + std::to_string(e.npc_type));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.distance));
-		v.push_back(columns[5] + " = " + std::to_string(e.aura_type));
-		v.push_back(columns[6] + " = " + std::to_string(e.spawn_type));
-		v.push_back(columns[7] + " = " + std::to_string(e.movement));
-		v.push_back(columns[8] + " = " + std::to_string(e.duration));
-		v.push_back(columns[9] + " = " + std::to_string(e.icon));
-		v.push_back(columns[10] + " = " + std::to_string(e.cast_time));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npc_type)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.distance)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.aura_type)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.spawn_type)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.movement)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.duration)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.icon)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.cast_time)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -368,6 +396,66 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Auras FromStmtRow(const mysql::StmtRow &row)
+	{
+		Auras e{};
+
+		e.type       = row.Get<int32_t>(0).value_or(0);
+		e.npc_type   = row.Get<int32_t>(1).value_or(0);
+		e.name       = row.GetStr(2).value_or("");
+		e.spell_id   = row.Get<int32_t>(3).value_or(0);
+		e.distance   = row.Get<int32_t>(4).value_or(60);
+		e.aura_type  = row.Get<int32_t>(5).value_or(1);
+		e.spawn_type = row.Get<int32_t>(6).value_or(0);
+		e.movement   = row.Get<int32_t>(7).value_or(0);
+		e.duration   = row.Get<int32_t>(8).value_or(5400);
+		e.icon       = row.Get<int32_t>(9).value_or(-1);
+		e.cast_time  = row.Get<int32_t>(10).value_or(0);
+
+		return e;
+	}
+
+	static Auras FindOnePrepared(
+		Database& db,
+		int auras_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { auras_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Auras> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Auras> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -465,7 +553,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<11> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.type));
@@ -483,13 +579,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBaseDataRepository {
@@ -29,6 +31,9 @@ public:
 		double  hp_fac;
 		double  mana_fac;
 		double  end_fac;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -185,6 +190,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BaseData &e,
+		const BaseData &original
+	)
+	{
+		e.changed_columns[0] = e.level != original.level;
+		e.changed_columns[1] = e.class_ != original.class_;
+		e.changed_columns[2] = e.hp != original.hp;
+		e.changed_columns[3] = e.mana != original.mana;
+		e.changed_columns[4] = e.end != original.end;
+		e.changed_columns[5] = e.hp_regen != original.hp_regen;
+		e.changed_columns[6] = e.end_regen != original.end_regen;
+		e.changed_columns[7] = e.hp_fac != original.hp_fac;
+		e.changed_columns[8] = e.mana_fac != original.mana_fac;
+		e.changed_columns[9] = e.end_fac != original.end_fac;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BaseData &e
@@ -194,16 +217,20 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.level));
-		v.push_back(columns[1] + " = " + std::to_string(e.class_));
-		v.push_back(columns[2] + " = " + std::to_string(e.hp));
-		v.push_back(columns[3] + " = " + std::to_string(e.mana));
-		v.push_back(columns[4] + " = " + std::to_string(e.end));
-		v.push_back(columns[5] + " = " + std::to_string(e.hp_regen));
-		v.push_back(columns[6] + " = " + std::to_string(e.end_regen));
-		v.push_back(columns[7] + " = " + std::to_string(e.hp_fac));
-		v.push_back(columns[8] + " = " + std::to_string(e.mana_fac));
-		v.push_back(columns[9] + " = " + std::to_string(e.end_fac));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.end)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.hp_regen)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.end_regen)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.hp_fac)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mana_fac)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.end_fac)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -358,6 +385,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BaseData FromStmtRow(const mysql::StmtRow &row)
+	{
+		BaseData e{};
+
+		e.level     = row.Get<uint8_t>(0).value_or(0);
+		e.class_    = row.Get<uint8_t>(1).value_or(0);
+		e.hp        = row.Get<double>(2).value_or(0);
+		e.mana      = row.Get<double>(3).value_or(0);
+		e.end       = row.Get<double>(4).value_or(0);
+		e.hp_regen  = row.Get<double>(5).value_or(0);
+		e.end_regen = row.Get<double>(6).value_or(0);
+		e.hp_fac    = row.Get<double>(7).value_or(0);
+		e.mana_fac  = row.Get<double>(8).value_or(0);
+		e.end_fac   = row.Get<double>(9).value_or(0);
+
+		return e;
+	}
+
+	static BaseData FindOnePrepared(
+		Database& db,
+		int base_data_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { base_data_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BaseData> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BaseData> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -454,7 +540,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.level));
@@ -471,13 +565,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
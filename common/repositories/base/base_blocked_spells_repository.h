@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBlockedSpellsRepository {
@@ -35,6 +37,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<16> changed_columns = std::bitset<16>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -215,6 +220,30 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BlockedSpells &e,
+		const BlockedSpells &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.spellid != original.spellid;
+		e.changed_columns[2] = e.type != original.type;
+		e.changed_columns[3] = e.zoneid != original.zoneid;
+		e.changed_columns[4] = e.x != original.x;
+		e.changed_columns[5] = e.y != original.y;
+		e.changed_columns[6] = e.z != original.z;
+		e.changed_columns[7] = e.x_diff != original.x_diff;
+		e.changed_columns[8] = e.y_diff != original.y_diff;
+		e.changed_columns[9] = e.z_diff != original.z_diff;
+		e.changed_columns[10] = e.message != original.message;
+		e.changed_columns[11] = e.description != original.description;
+		e.changed_columns[12] = e.min_expansion != original.min_expansion;
+		e.changed_columns[13] = e.max_expansion != original.max_expansion;
+		e.changed_columns[14] = e.content_flags != original.content_flags;
+		e.changed_columns[15] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BlockedSpells &e
@@ -224,21 +253,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.spellid));
-		v.push_back(columns[2] + " = " + std::to_string(e.type));
-		v.push_back(columns[3] + " = " + std::to_string(e.zoneid));
-		v.push_back(columns[4] + " = " + std::to_string(e.x));
-		v.push_back(columns[5] + " = " + std::to_string(e.y));
-		v.push_back(columns[6] + " = " + std::to_string(e.z));
-		v.push_back(columns[7] + " = " + std::to_string(e.x_diff));
-		v.push_back(columns[8] + " = " + std::to_string(e.y_diff));
-		v.push_back(columns[9] + " = " + std::to_string(e.z_diff));
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.message) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.description) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[13] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.spellid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.zoneid)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.x_diff)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.y_diff)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.z_diff)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.message) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.description) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -417,6 +450,71 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BlockedSpells FromStmtRow(const mysql::StmtRow &row)
+	{
+		BlockedSpells e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.spellid                = row.Get<uint32_t>(1).value_or(0);
+		e.type                   = row.Get<int8_t>(2).value_or(0);
+		e.zoneid                 = row.Get<int32_t>(3).value_or(0);
+		e.x                      = row.Get<float>(4).value_or(0);
+		e.y                      = row.Get<float>(5).value_or(0);
+		e.z                      = row.Get<float>(6).value_or(0);
+		e.x_diff                 = row.Get<float>(7).value_or(0);
+		e.y_diff                 = row.Get<float>(8).value_or(0);
+		e.z_diff                 = row.Get<float>(9).value_or(0);
+		e.message                = row.GetStr(10).value_or("");
+		e.description            = row.GetStr(11).value_or("");
+		e.min_expansion          = row.Get<int8_t>(12).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(13).value_or(-1);
+		e.content_flags          = row.GetStr(14).value_or("");
+		e.content_flags_disabled = row.GetStr(15).value_or("");
+
+		return e;
+	}
+
+	static BlockedSpells FindOnePrepared(
+		Database& db,
+		int blocked_spells_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { blocked_spells_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BlockedSpells> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BlockedSpells> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -519,7 +617,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<16> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -542,13 +648,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
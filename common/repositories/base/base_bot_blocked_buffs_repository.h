@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotBlockedBuffsRepository {
@@ -23,6 +25,9 @@ public:
 		uint32_t spell_id;
 		uint8_t  blocked;
 		uint8_t  blocked_pet;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<4> changed_columns = std::bitset<4>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -155,6 +160,18 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotBlockedBuffs &e,
+		const BotBlockedBuffs &original
+	)
+	{
+		e.changed_columns[0] = e.bot_id != original.bot_id;
+		e.changed_columns[1] = e.spell_id != original.spell_id;
+		e.changed_columns[2] = e.blocked != original.blocked;
+		e.changed_columns[3] = e.blocked_pet != original.blocked_pet;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotBlockedBuffs &e
@@ -164,10 +181,14 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.blocked));
-		v.push_back(columns[3] + " = " + std::to_string(e.blocked_pet));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.blocked)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.blocked_pet)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -298,6 +319,59 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotBlockedBuffs FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotBlockedBuffs e{};
+
+		e.bot_id      = row.Get<uint32_t>(0).value_or(0);
+		e.spell_id    = row.Get<uint32_t>(1).value_or(0);
+		e.blocked     = row.Get<uint8_t>(2).value_or(0);
+		e.blocked_pet = row.Get<uint8_t>(3).value_or(0);
+
+		return e;
+	}
+
+	static BotBlockedBuffs FindOnePrepared(
+		Database& db,
+		int bot_blocked_buffs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_blocked_buffs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotBlockedBuffs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotBlockedBuffs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -388,7 +462,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<4> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.bot_id));
@@ -399,13 +481,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotDataRepository {
@@ -64,6 +66,9 @@ public:
 		int16_t     poison;
 		int16_t     disease;
 		int16_t     corruption;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<45> changed_columns = std::bitset<45>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -372,6 +377,59 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotData &e,
+		const BotData &original
+	)
+	{
+		e.changed_columns[0] = e.bot_id != original.bot_id;
+		e.changed_columns[1] = e.owner_id != original.owner_id;
+		e.changed_columns[2] = e.spells_id != original.spells_id;
+		e.changed_columns[3] = e.name != original.name;
+		e.changed_columns[4] = e.last_name != original.last_name;
+		e.changed_columns[5] = e.title != original.title;
+		e.changed_columns[6] = e.suffix != original.suffix;
+		e.changed_columns[7] = e.zone_id != original.zone_id;
+		e.changed_columns[8] = e.gender != original.gender;
+		e.changed_columns[9] = e.race != original.race;
+		e.changed_columns[10] = e.class_ != original.class_;
+		e.changed_columns[11] = e.level != original.level;
+		e.changed_columns[12] = e.deity != original.deity;
+		e.changed_columns[13] = e.creation_day != original.creation_day;
+		e.changed_columns[14] = e.last_spawn != original.last_spawn;
+		e.changed_columns[15] = e.time_spawned != original.time_spawned;
+		e.changed_columns[16] = e.size != original.size;
+		e.changed_columns[17] = e.face != original.face;
+		e.changed_columns[18] = e.hair_color != original.hair_color;
+		e.changed_columns[19] = e.hair_style != original.hair_style;
+		e.changed_columns[20] = e.beard != original.beard;
+		e.changed_columns[21] = e.beard_color != original.beard_color;
+		e.changed_columns[22] = e.eye_color_1 != original.eye_color_1;
+		e.changed_columns[23] = e.eye_color_2 != original.eye_color_2;
+		e.changed_columns[24] = e.drakkin_heritage != original.drakkin_heritage;
+		e.changed_columns[25] = e.drakkin_tattoo != original.drakkin_tattoo;
+		e.changed_columns[26] = e.drakkin_details != original.drakkin_details;
+		e.changed_columns[27] = e.ac != original.ac;
+		e.changed_columns[28] = e.atk != original.atk;
+		e.changed_columns[29] = e.hp != original.hp;
+		e.changed_columns[30] = e.mana != original.mana;
+		e.changed_columns[31] = e.str != original.str;
+		e.changed_columns[32] = e.sta != original.sta;
+		e.changed_columns[33] = e.cha != original.cha;
+		e.changed_columns[34] = e.dex != original.dex;
+		e.changed_columns[35] = e.int_ != original.int_;
+		e.changed_columns[36] = e.agi != original.agi;
+		e.changed_columns[37] = e.wis != original.wis;
+		e.changed_columns[38] = e.extra_haste != original.extra_haste;
+		e.changed_columns[39] = e.fire != original.fire;
+		e.changed_columns[40] = e.cold != original.cold;
+		e.changed_columns[41] = e.magic != original.magic;
+		e.changed_columns[42] = e.poison != original.poison;
+		e.changed_columns[43] = e.disease != original.disease;
+		e.changed_columns[44] = e.corruption != original.corruption;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotData &e
@@ -381,50 +439,54 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.owner_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.spells_id));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.last_name) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.title) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.suffix) + "'");
-		v.push_back(columns[7] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.gender));
-		v.push_back(columns[9] + " = " + std::to_string(e.race));
-		v.push_back(columns[10] + " = " + std::to_string(e.class_));
-		v.push_back(columns[11] + " = " + std::to_string(e.level));
-		v.push_back(columns[12] + " = " + std::to_string(e.deity));
-		v.push_back(columns[13] + " = " + std::to_string(e.creation_day));
-		v.push_back(columns[14] + " = " + std::to_string(e.last_spawn));
-		v.push_back(columns[15] + " = " + std::to_string(e.time_spawned));
-		v.push_back(columns[16] + " = " + std::to_string(e.size));
-		v.push_back(columns[17] + " = " + std::to_string(e.face));
-		v.push_back(columns[18] + " = " + std::to_string(e.hair_color));
-		v.push_back(columns[19] + " = " + std::to_string(e.hair_style));
-		v.push_back(columns[20] + " = " + std::to_string(e.beard));
-		v.push_back(columns[21] + " = " + std::to_string(e.beard_color));
-		v.push_back(columns[22] + " = " + std::to_string(e.eye_color_1));
-		v.push_back(columns[23] + " = " + std::to_string(e.eye_color_2));
-		v.push_back(columns[24] + " = " + std::to_string(e.drakkin_heritage));
-		v.push_back(columns[25] + " = " + std::to_string(e.drakkin_tattoo));
-		v.push_back(columns[26] + " = " + std::to_string(e.drakkin_details));
-		v.push_back(columns[27] + " = " + std::to_string(e.ac));
-		v.push_back(columns[28] + " = " + std::to_string(e.atk));
-		v.push_back(columns[29] + " = " + std::to_string(e.hp));
-		v.push_back(columns[30] + " = " + std::to_string(e.mana));
-		v.push_back(columns[31] + " = " + std::to_string(e.str));
-		v.push_back(columns[32] + " = " + std::to_string(e.sta));
-		v.push_back(columns[33] + " = " + std::to_string(e.cha));
-		v.push_back(columns[34] + " = " + std::to_string(e.dex));
-		v.push_back(columns[35] + " = " + std::to_string(e.int_));
-		v.push_back(columns[36] + " = " + std::to_string(e.agi));
-		v.push_back(columns[37] + " = " + std::to_string(e.wis));
-		v.push_back(columns[38] + " = " + std::to_string(e.extra_haste));
-		v.push_back(columns[39] + " = " + std::to_string(e.fire));
-		v.push_back(columns[40] + " = " + std::to_string(e.cold));
-		v.push_back(columns[41] + " = " + std::to_string(e.magic));
-		v.push_back(columns[42] + " = " + std::to_string(e.poison));
-		v.push_back(columns[43] + " = " + std::to_string(e.disease));
-		v.push_back(columns[44] + " = " + std::to_string(e.corruption));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.owner_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spells_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.last_name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.title) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.suffix) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.gender)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.deity)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.creation_day)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.last_spawn)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.time_spawned)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.face)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.hair_color)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.hair_style)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.beard)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.beard_color)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.eye_color_1)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.eye_color_2)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.drakkin_heritage)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.drakkin_tattoo)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.drakkin_details)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.ac)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.atk)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.str)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.sta)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.cha)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.dex)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.int_)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.agi)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.wis)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.extra_haste)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.fire)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.cold)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.magic)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.poison)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.disease)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.corruption)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -719,6 +781,100 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotData FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotData e{};
+
+		e.bot_id                 = row.Get<uint32_t>(0).value_or(0);
+		e.owner_id               = row.Get<uint32_t>(1).value_or(0);
+		e.spells_id              = row.Get<uint32_t>(2).value_or(0);
+		e.name                   = row.GetStr(3).value_or("");
+		e.last_name              = row.GetStr(4).value_or("");
+		e.title                  = row.GetStr(5).value_or("");
+		e.suffix                 = row.GetStr(6).value_or("");
+		e.zone_id                = row.Get<int16_t>(7).value_or(0);
+		e.gender                 = row.Get<int8_t>(8).value_or(0);
+		e.race                   = row.Get<int16_t>(9).value_or(0);
+		e.class_                 = row.Get<int8_t>(10).value_or(0);
+		e.level                  = row.Get<uint8_t>(11).value_or(0);
+		e.deity                  = row.Get<uint32_t>(12).value_or(0);
+		e.creation_day           = row.Get<uint32_t>(13).value_or(0);
+		e.last_spawn             = row.Get<uint32_t>(14).value_or(0);
+		e.time_spawned           = row.Get<uint32_t>(15).value_or(0);
+		e.size                   = row.Get<float>(16).value_or(0);
+		e.face                   = row.Get<int32_t>(17).value_or(1);
+		e.hair_color             = row.Get<int32_t>(18).value_or(1);
+		e.hair_style             = row.Get<int32_t>(19).value_or(1);
+		e.beard                  = row.Get<int32_t>(20).value_or(0);
+		e.beard_color            = row.Get<int32_t>(21).value_or(1);
+		e.eye_color_1            = row.Get<int32_t>(22).value_or(1);
+		e.eye_color_2            = row.Get<int32_t>(23).value_or(1);
+		e.drakkin_heritage       = row.Get<int32_t>(24).value_or(0);
+		e.drakkin_tattoo         = row.Get<int32_t>(25).value_or(0);
+		e.drakkin_details        = row.Get<int32_t>(26).value_or(0);
+		e.ac                     = row.Get<int16_t>(27).value_or(0);
+		e.atk                    = row.Get<int32_t>(28).value_or(0);
+		e.hp                     = row.Get<int32_t>(29).value_or(0);
+		e.mana                   = row.Get<int32_t>(30).value_or(0);
+		e.str                    = row.Get<int32_t>(31).value_or(75);
+		e.sta                    = row.Get<int32_t>(32).value_or(75);
+		e.cha                    = row.Get<int32_t>(33).value_or(75);
+		e.dex                    = row.Get<int32_t>(34).value_or(75);
+		e.int_                   = row.Get<int32_t>(35).value_or(75);
+		e.agi                    = row.Get<int32_t>(36).value_or(75);
+		e.wis                    = row.Get<int32_t>(37).value_or(75);
+		e.extra_haste            = row.Get<int32_t>(38).value_or(0);
+		e.fire                   = row.Get<int16_t>(39).value_or(0);
+		e.cold                   = row.Get<int16_t>(40).value_or(0);
+		e.magic                  = row.Get<int16_t>(41).value_or(0);
+		e.poison                 = row.Get<int16_t>(42).value_or(0);
+		e.disease                = row.Get<int16_t>(43).value_or(0);
+		e.corruption             = row.Get<int16_t>(44).value_or(0);
+
+		return e;
+	}
+
+	static BotData FindOnePrepared(
+		Database& db,
+		int bot_data_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_data_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotData> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotData> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -850,7 +1006,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<45> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.bot_id));
@@ -902,13 +1066,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotGroupMembersRepository {
@@ -22,6 +24,9 @@ public:
 		uint32_t group_members_index;
 		uint32_t groups_index;
 		uint32_t bot_id;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<3> changed_columns = std::bitset<3>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -149,6 +154,17 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotGroupMembers &e,
+		const BotGroupMembers &original
+	)
+	{
+		e.changed_columns[0] = e.group_members_index != original.group_members_index;
+		e.changed_columns[1] = e.groups_index != original.groups_index;
+		e.changed_columns[2] = e.bot_id != original.bot_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotGroupMembers &e
@@ -158,8 +174,12 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.groups_index));
-		v.push_back(columns[2] + " = " + std::to_string(e.bot_id));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.groups_index)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.bot_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -286,6 +306,58 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotGroupMembers FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotGroupMembers e{};
+
+		e.group_members_index = row.Get<uint32_t>(0).value_or(0);
+		e.groups_index        = row.Get<uint32_t>(1).value_or(0);
+		e.bot_id              = row.Get<uint32_t>(2).value_or(0);
+
+		return e;
+	}
+
+	static BotGroupMembers FindOnePrepared(
+		Database& db,
+		int bot_group_members_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_group_members_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotGroupMembers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotGroupMembers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
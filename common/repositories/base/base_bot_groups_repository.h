@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotGroupsRepository {
@@ -23,6 +25,9 @@ public:
 		uint32_t    group_leader_id;
 		std::string group_name;
 		uint8_t     auto_spawn;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<4> changed_columns = std::bitset<4>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -154,6 +159,18 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotGroups &e,
+		const BotGroups &original
+	)
+	{
+		e.changed_columns[0] = e.groups_index != original.groups_index;
+		e.changed_columns[1] = e.group_leader_id != original.group_leader_id;
+		e.changed_columns[2] = e.group_name != original.group_name;
+		e.changed_columns[3] = e.auto_spawn != original.auto_spawn;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotGroups &e
@@ -163,9 +180,13 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.group_leader_id));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.group_name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.auto_spawn));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.group_leader_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.group_name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.auto_spawn)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -296,6 +317,59 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotGroups FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotGroups e{};
+
+		e.groups_index    = row.Get<uint32_t>(0).value_or(0);
+		e.group_leader_id = row.Get<uint32_t>(1).value_or(0);
+		e.group_name      = row.GetStr(2).value_or("");
+		e.auto_spawn      = row.Get<uint8_t>(3).value_or(0);
+
+		return e;
+	}
+
+	static BotGroups FindOnePrepared(
+		Database& db,
+		int bot_groups_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_groups_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotGroups> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotGroups> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
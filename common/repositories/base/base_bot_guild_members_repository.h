@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotGuildMembersRepository {
@@ -28,6 +30,9 @@ public:
 		uint8_t     banker;
 		std::string public_note;
 		uint8_t     alt;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -179,6 +184,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotGuildMembers &e,
+		const BotGuildMembers &original
+	)
+	{
+		e.changed_columns[0] = e.bot_id != original.bot_id;
+		e.changed_columns[1] = e.guild_id != original.guild_id;
+		e.changed_columns[2] = e.rank != original.rank;
+		e.changed_columns[3] = e.tribute_enable != original.tribute_enable;
+		e.changed_columns[4] = e.total_tribute != original.total_tribute;
+		e.changed_columns[5] = e.last_tribute != original.last_tribute;
+		e.changed_columns[6] = e.banker != original.banker;
+		e.changed_columns[7] = e.public_note != original.public_note;
+		e.changed_columns[8] = e.alt != original.alt;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotGuildMembers &e
@@ -188,15 +210,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.guild_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.rank));
-		v.push_back(columns[3] + " = " + std::to_string(e.tribute_enable));
-		v.push_back(columns[4] + " = " + std::to_string(e.total_tribute));
-		v.push_back(columns[5] + " = " + std::to_string(e.last_tribute));
-		v.push_back(columns[6] + " = " + std::to_string(e.banker));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.public_note) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.alt));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.guild_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.rank)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.tribute_enable)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.total_tribute)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.last_tribute)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.banker)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.public_note) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.alt)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -347,6 +373,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotGuildMembers FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotGuildMembers e{};
+
+		e.bot_id         = row.Get<int32_t>(0).value_or(0);
+		e.guild_id       = row.Get<uint32_t>(1).value_or(0);
+		e.rank           = row.Get<uint8_t>(2).value_or(0);
+		e.tribute_enable = row.Get<uint8_t>(3).value_or(0);
+		e.total_tribute  = row.Get<uint32_t>(4).value_or(0);
+		e.last_tribute   = row.Get<uint32_t>(5).value_or(0);
+		e.banker         = row.Get<uint8_t>(6).value_or(0);
+		e.public_note    = row.GetStr(7).value_or("");
+		e.alt            = row.Get<uint8_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static BotGuildMembers FindOnePrepared(
+		Database& db,
+		int bot_guild_members_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_guild_members_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotGuildMembers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotGuildMembers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotHealRotationsRepository {
@@ -35,6 +37,9 @@ public:
 		float    critical_hp_leather;
 		float    critical_hp_chain;
 		float    critical_hp_plate;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<16> changed_columns = std::bitset<16>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -205,6 +210,30 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotHealRotations &e,
+		const BotHealRotations &original
+	)
+	{
+		e.changed_columns[0] = e.heal_rotation_index != original.heal_rotation_index;
+		e.changed_columns[1] = e.bot_id != original.bot_id;
+		e.changed_columns[2] = e.interval_ != original.interval_;
+		e.changed_columns[3] = e.fast_heals != original.fast_heals;
+		e.changed_columns[4] = e.adaptive_targeting != original.adaptive_targeting;
+		e.changed_columns[5] = e.casting_override != original.casting_override;
+		e.changed_columns[6] = e.safe_hp_base != original.safe_hp_base;
+		e.changed_columns[7] = e.safe_hp_cloth != original.safe_hp_cloth;
+		e.changed_columns[8] = e.safe_hp_leather != original.safe_hp_leather;
+		e.changed_columns[9] = e.safe_hp_chain != original.safe_hp_chain;
+		e.changed_columns[10] = e.safe_hp_plate != original.safe_hp_plate;
+		e.changed_columns[11] = e.critical_hp_base != original.critical_hp_base;
+		e.changed_columns[12] = e.critical_hp_cloth != original.critical_hp_cloth;
+		e.changed_columns[13] = e.critical_hp_leather != original.critical_hp_leather;
+		e.changed_columns[14] = e.critical_hp_chain != original.critical_hp_chain;
+		e.changed_columns[15] = e.critical_hp_plate != original.critical_hp_plate;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotHealRotations &e
@@ -214,21 +243,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.interval_));
-		v.push_back(columns[3] + " = " + std::to_string(e.fast_heals));
-		v.push_back(columns[4] + " = " + std::to_string(e.adaptive_targeting));
-		v.push_back(columns[5] + " = " + std::to_string(e.casting_override));
-		v.push_back(columns[6] + " = " + std::to_string(e.safe_hp_base));
-		v.push_back(columns[7] + " = " + std::to_string(e.safe_hp_cloth));
-		v.push_back(columns[8] + " = " + std::to_string(e.safe_hp_leather));
-		v.push_back(columns[9] + " = " + std::to_string(e.safe_hp_chain));
-		v.push_back(columns[10] + " = " + std::to_string(e.safe_hp_plate));
-		v.push_back(columns[11] + " = " + std::to_string(e.critical_hp_base));
-		v.push_back(columns[12] + " = " + std::to_string(e.critical_hp_cloth));
-		v.push_back(columns[13] + " = " + std::to_string(e.critical_hp_leather));
-		v.push_back(columns[14] + " = " + std::to_string(e.critical_hp_chain));
-		v.push_back(columns[15] + " = " + std::to_string(e.critical_hp_plate));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.interval_)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.fast_heals)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.adaptive_targeting)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.casting_override)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.safe_hp_base)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.safe_hp_cloth)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.safe_hp_leather)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.safe_hp_chain)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.safe_hp_plate)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.critical_hp_base)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.critical_hp_cloth)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.critical_hp_leather)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.critical_hp_chain)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.critical_hp_plate)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -387,6 +420,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotHealRotations FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotHealRotations e{};
+
+		e.heal_rotation_index = row.Get<uint32_t>(0).value_or(0);
+		e.bot_id              = row.Get<uint32_t>(1).value_or(0);
+		e.interval_           = row.Get<uint32_t>(2).value_or(0);
+		e.fast_heals          = row.Get<uint32_t>(3).value_or(0);
+		e.adaptive_targeting  = row.Get<uint32_t>(4).value_or(0);
+		e.casting_override    = row.Get<uint32_t>(5).value_or(0);
+
+		return e;
+	}
+
+	static BotHealRotations FindOnePrepared(
+		Database& db,
+		int bot_heal_rotations_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_heal_rotations_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotHealRotations> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotHealRotations> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -489,7 +577,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<16> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.heal_rotation_index));
@@ -512,13 +608,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotInventoriesRepository {
@@ -36,6 +38,9 @@ public:
 		uint32_t    augment_4;
 		uint32_t    augment_5;
 		uint32_t    augment_6;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotInventories &e,
+		const BotInventories &original
+	)
+	{
+		e.changed_columns[0] = e.inventories_index != original.inventories_index;
+		e.changed_columns[1] = e.bot_id != original.bot_id;
+		e.changed_columns[2] = e.slot_id != original.slot_id;
+		e.changed_columns[3] = e.item_id != original.item_id;
+		e.changed_columns[4] = e.inst_charges != original.inst_charges;
+		e.changed_columns[5] = e.inst_color != original.inst_color;
+		e.changed_columns[6] = e.inst_no_drop != original.inst_no_drop;
+		e.changed_columns[7] = e.inst_custom_data != original.inst_custom_data;
+		e.changed_columns[8] = e.ornament_icon != original.ornament_icon;
+		e.changed_columns[9] = e.ornament_id_file != original.ornament_id_file;
+		e.changed_columns[10] = e.ornament_hero_model != original.ornament_hero_model;
+		e.changed_columns[11] = e.augment_1 != original.augment_1;
+		e.changed_columns[12] = e.augment_2 != original.augment_2;
+		e.changed_columns[13] = e.augment_3 != original.augment_3;
+		e.changed_columns[14] = e.augment_4 != original.augment_4;
+		e.changed_columns[15] = e.augment_5 != original.augment_5;
+		e.changed_columns[16] = e.augment_6 != original.augment_6;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotInventories &e
@@ -229,22 +259,26 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.inst_charges));
-		v.push_back(columns[5] + " = " + std::to_string(e.inst_color));
-		v.push_back(columns[6] + " = " + std::to_string(e.inst_no_drop));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.inst_custom_data) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.ornament_icon));
-		v.push_back(columns[9] + " = " + std::to_string(e.ornament_id_file));
-		v.push_back(columns[10] + " = " + std::to_string(e.ornament_hero_model));
-		v.push_back(columns[11] + " = " + std::to_string(e.augment_1));
-		v.push_back(columns[12] + " = " + std::to_string(e.augment_2));
-		v.push_back(columns[13] + " = " + std::to_string(e.augment_3));
-		v.push_back(columns[14] + " = " + std::to_string(e.augment_4));
-		v.push_back(columns[15] + " = " + std::to_string(e.augment_5));
-		v.push_back(columns[16] + " = " + std::to_string(e.augment_6));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.inst_charges)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.inst_color)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.inst_no_drop)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.inst_custom_data) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.ornament_icon)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.ornament_id_file)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.ornament_hero_model)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.augment_1)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.augment_2)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.augment_3)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.augment_4)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.augment_5)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.augment_6)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -427,6 +461,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotInventories FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotInventories e{};
+
+		e.inventories_index   = row.Get<uint32_t>(0).value_or(0);
+		e.bot_id              = row.Get<uint32_t>(1).value_or(0);
+		e.slot_id             = row.Get<uint32_t>(2).value_or(0);
+		e.item_id             = row.Get<uint32_t>(3).value_or(0);
+		e.inst_charges        = row.Get<uint16_t>(4).value_or(0);
+		e.inst_color          = row.Get<uint32_t>(5).value_or(0);
+		e.inst_no_drop        = row.Get<uint8_t>(6).value_or(0);
+		e.inst_custom_data    = row.GetStr(7).value_or("");
+		e.ornament_icon       = row.Get<uint32_t>(8).value_or(0);
+		e.ornament_id_file    = row.Get<uint32_t>(9).value_or(0);
+		e.ornament_hero_model = row.Get<int32_t>(10).value_or(0);
+		e.augment_1           = row.Get<uint32_t>(11).value_or(0);
+		e.augment_2           = row.Get<uint32_t>(12).value_or(0);
+		e.augment_3           = row.Get<uint32_t>(13).value_or(0);
+		e.augment_4           = row.Get<uint32_t>(14).value_or(0);
+		e.augment_5           = row.Get<uint32_t>(15).value_or(0);
+		e.augment_6           = row.Get<uint32_t>(16).value_or(0);
+
+		return e;
+	}
+
+	static BotInventories FindOnePrepared(
+		Database& db,
+		int bot_inventories_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_inventories_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotInventories> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotInventories> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -530,7 +630,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.inventories_index));
@@ -554,13 +662,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
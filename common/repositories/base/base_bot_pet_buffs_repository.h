@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotPetBuffsRepository {
@@ -24,6 +26,9 @@ public:
 		uint32_t spell_id;
 		uint32_t caster_level;
 		uint32_t duration;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<5> changed_columns = std::bitset<5>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -160,6 +165,19 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotPetBuffs &e,
+		const BotPetBuffs &original
+	)
+	{
+		e.changed_columns[0] = e.pet_buffs_index != original.pet_buffs_index;
+		e.changed_columns[1] = e.pets_index != original.pets_index;
+		e.changed_columns[2] = e.spell_id != original.spell_id;
+		e.changed_columns[3] = e.caster_level != original.caster_level;
+		e.changed_columns[4] = e.duration != original.duration;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotPetBuffs &e
@@ -169,10 +187,14 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.pets_index));
-		v.push_back(columns[2] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.caster_level));
-		v.push_back(columns[4] + " = " + std::to_string(e.duration));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.pets_index)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.caster_level)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.duration)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -307,6 +329,60 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotPetBuffs FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotPetBuffs e{};
+
+		e.pet_buffs_index = row.Get<uint32_t>(0).value_or(0);
+		e.pets_index      = row.Get<uint32_t>(1).value_or(0);
+		e.spell_id        = row.Get<uint32_t>(2).value_or(0);
+		e.caster_level    = row.Get<uint32_t>(3).value_or(0);
+		e.duration        = row.Get<uint32_t>(4).value_or(0);
+
+		return e;
+	}
+
+	static BotPetBuffs FindOnePrepared(
+		Database& db,
+		int bot_pet_buffs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_pet_buffs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotPetBuffs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotPetBuffs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -398,7 +474,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<5> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.pet_buffs_index));
@@ -410,13 +494,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
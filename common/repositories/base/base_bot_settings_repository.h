@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotSettingsRepository {
@@ -27,6 +29,9 @@ public:
 		int32_t     value;
 		std::string category_name;
 		std::string setting_name;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotSettings &e,
+		const BotSettings &original
+	)
+	{
+		e.changed_columns[0] = e.character_id != original.character_id;
+		e.changed_columns[1] = e.bot_id != original.bot_id;
+		e.changed_columns[2] = e.stance != original.stance;
+		e.changed_columns[3] = e.setting_id != original.setting_id;
+		e.changed_columns[4] = e.setting_type != original.setting_type;
+		e.changed_columns[5] = e.value != original.value;
+		e.changed_columns[6] = e.category_name != original.category_name;
+		e.changed_columns[7] = e.setting_name != original.setting_name;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotSettings &e
@@ -184,14 +205,18 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.stance));
-		v.push_back(columns[3] + " = " + std::to_string(e.setting_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.setting_type));
-		v.push_back(columns[5] + " = " + std::to_string(e.value));
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.category_name) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.setting_name) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.stance)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.setting_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.setting_type)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.value)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.category_name) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.setting_name) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -338,6 +363,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotSettings FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotSettings e{};
+
+		e.character_id	= row.Get<uint32_t>(0).value_or(0);
+		e.bot_id        = row.Get<uint32_t>(1).value_or(0);
+		e.stance        = row.Get<uint8_t>(2).value_or(0);
+		e.setting_id    = row.Get<uint16_t>(3).value_or(0);
+		e.setting_type  = row.Get<uint8_t>(4).value_or(0);
+		e.value         = row.Get<int32_t>(5).value_or(0);
+		e.category_name = row.GetStr(6).value_or("");
+		e.setting_name  = row.GetStr(7).value_or("");
+
+		return e;
+	}
+
+	static BotSettings FindOnePrepared(
+		Database& db,
+		int bot_settings_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_settings_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotSettings> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotSettings> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -432,7 +514,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.character_id));
@@ -447,13 +537,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotSpellCastingChancesRepository {
@@ -39,6 +41,9 @@ public:
 		uint8_t pHND_value;
 		uint8_t pSND_value;
 		uint8_t pHSND_value;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<20> changed_columns = std::bitset<20>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -235,6 +240,34 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotSpellCastingChances &e,
+		const BotSpellCastingChances &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.spell_type_index != original.spell_type_index;
+		e.changed_columns[2] = e.class_id != original.class_id;
+		e.changed_columns[3] = e.stance_index != original.stance_index;
+		e.changed_columns[4] = e.nHSND_value != original.nHSND_value;
+		e.changed_columns[5] = e.pH_value != original.pH_value;
+		e.changed_columns[6] = e.pS_value != original.pS_value;
+		e.changed_columns[7] = e.pHS_value != original.pHS_value;
+		e.changed_columns[8] = e.pN_value != original.pN_value;
+		e.changed_columns[9] = e.pHN_value != original.pHN_value;
+		e.changed_columns[10] = e.pSN_value != original.pSN_value;
+		e.changed_columns[11] = e.pHSN_value != original.pHSN_value;
+		e.changed_columns[12] = e.pD_value != original.pD_value;
+		e.changed_columns[13] = e.pHD_value != original.pHD_value;
+		e.changed_columns[14] = e.pSD_value != original.pSD_value;
+		e.changed_columns[15] = e.pHSD_value != original.pHSD_value;
+		e.changed_columns[16] = e.pND_value != original.pND_value;
+		e.changed_columns[17] = e.pHND_value != original.pHND_value;
+		e.changed_columns[18] = e.pSND_value != original.pSND_value;
+		e.changed_columns[19] = e.pHSND_value != original.pHSND_value;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotSpellCastingChances &e
@@ -244,25 +277,29 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.spell_type_index));
-		v.push_back(columns[2] + " = " + std::to_string(e.class_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.stance_index));
-		v.push_back(columns[4] + " = " + std::to_string(e.nHSND_value));
-		v.push_back(columns[5] + " = " + std::to_string(e.pH_value));
-		v.push_back(columns[6] + " = " + std::to_string(e.pS_value));
-		v.push_back(columns[7] + " = " + std::to_string(e.pHS_value));
-		v.push_back(columns[8] + " = " + std::to_string(e.pN_value));
-		v.push_back(columns[9] + " = " + std::to_string(e.pHN_value));
-		v.push_back(columns[10] + " = " + std::to_string(e.pSN_value));
-		v.push_back(columns[11] + " = " + std::to_string(e.pHSN_value));
-		v.push_back(columns[12] + " = " + std::to_string(e.pD_value));
-		v.push_back(columns[13] + " = " + std::to_string(e.pHD_value));
-		v.push_back(columns[14] + " = " + std::to_string(e.pSD_value));
-		v.push_back(columns[15] + " = " + std::to_string(e.pHSD_value));
-		v.push_back(columns[16] + " = " + std::to_string(e.pND_value));
-		v.push_back(columns[17] + " = " + std::to_string(e.pHND_value));
-		v.push_back(columns[18] + " = " + std::to_string(e.pSND_value));
-		v.push_back(columns[19] + " = " + std::to_string(e.pHSND_value));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.spell_type_index)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.class_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.stance_index)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.nHSND_value)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.pH_value)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.pS_value)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.pHS_value)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.pN_value)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.pHN_value)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.pSN_value)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.pHSN_value)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.pD_value)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.pHD_value)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.pSD_value)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.pHSD_value)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.pND_value)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.pHND_value)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.pSND_value)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.pHSND_value)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -457,6 +494,75 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotSpellCastingChances FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotSpellCastingChances e{};
+
+		e.id               = row.Get<int32_t>(0).value_or(0);
+		e.spell_type_index = row.Get<uint8_t>(1).value_or(0);
+		e.class_id         = row.Get<uint8_t>(2).value_or(0);
+		e.stance_index     = row.Get<uint8_t>(3).value_or(0);
+		e.nHSND_value      = row.Get<uint8_t>(4).value_or(0);
+		e.pH_value         = row.Get<uint8_t>(5).value_or(0);
+		e.pS_value         = row.Get<uint8_t>(6).value_or(0);
+		e.pHS_value        = row.Get<uint8_t>(7).value_or(0);
+		e.pN_value         = row.Get<uint8_t>(8).value_or(0);
+		e.pHN_value        = row.Get<uint8_t>(9).value_or(0);
+		e.pSN_value        = row.Get<uint8_t>(10).value_or(0);
+		e.pHSN_value       = row.Get<uint8_t>(11).value_or(0);
+		e.pD_value         = row.Get<uint8_t>(12).value_or(0);
+		e.pHD_value        = row.Get<uint8_t>(13).value_or(0);
+		e.pSD_value        = row.Get<uint8_t>(14).value_or(0);
+		e.pHSD_value       = row.Get<uint8_t>(15).value_or(0);
+		e.pND_value        = row.Get<uint8_t>(16).value_or(0);
+		e.pHND_value       = row.Get<uint8_t>(17).value_or(0);
+		e.pSND_value       = row.Get<uint8_t>(18).value_or(0);
+		e.pHSND_value      = row.Get<uint8_t>(19).value_or(0);
+
+		return e;
+	}
+
+	static BotSpellCastingChances FindOnePrepared(
+		Database& db,
+		int bot_spell_casting_chances_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_spell_casting_chances_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotSpellCastingChances> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotSpellCastingChances> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -563,7 +669,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<20> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -590,13 +704,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotSpellsEntriesRepository {
@@ -34,6 +36,9 @@ public:
 		std::string bucket_name;
 		std::string bucket_value;
 		uint8_t     bucket_comparison;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotSpellsEntries &e,
+		const BotSpellsEntries &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.npc_spells_id != original.npc_spells_id;
+		e.changed_columns[2] = e.spell_id != original.spell_id;
+		e.changed_columns[3] = e.type != original.type;
+		e.changed_columns[4] = e.minlevel != original.minlevel;
+		e.changed_columns[5] = e.maxlevel != original.maxlevel;
+		e.changed_columns[6] = e.manacost != original.manacost;
+		e.changed_columns[7] = e.recast_delay != original.recast_delay;
+		e.changed_columns[8] = e.priority != original.priority;
+		e.changed_columns[9] = e.resist_adjust != original.resist_adjust;
+		e.changed_columns[10] = e.min_hp != original.min_hp;
+		e.changed_columns[11] = e.max_hp != original.max_hp;
+		e.changed_columns[12] = e.bucket_name != original.bucket_name;
+		e.changed_columns[13] = e.bucket_value != original.bucket_value;
+		e.changed_columns[14] = e.bucket_comparison != original.bucket_comparison;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotSpellsEntries &e
@@ -219,20 +247,24 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.npc_spells_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.type));
-		v.push_back(columns[4] + " = " + std::to_string(e.minlevel));
-		v.push_back(columns[5] + " = " + std::to_string(e.maxlevel));
-		v.push_back(columns[6] + " = " + std::to_string(e.manacost));
-		v.push_back(columns[7] + " = " + std::to_string(e.recast_delay));
-		v.push_back(columns[8] + " = " + std::to_string(e.priority));
-		v.push_back(columns[9] + " = " + std::to_string(e.resist_adjust));
-		v.push_back(columns[10] + " = " + std::to_string(e.min_hp));
-		v.push_back(columns[11] + " = " + std::to_string(e.max_hp));
-		v.push_back(columns[12] + " = '" + Strings::Escape(e.bucket_name) + "'");
-		v.push_back(columns[13] + " = '" + Strings::Escape(e.bucket_value) + "'");
-		v.push_back(columns[14] + " = " + std::to_string(e.bucket_comparison));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npc_spells_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.minlevel)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.maxlevel)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.manacost)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.recast_delay)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.priority)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.resist_adjust)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.min_hp)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.max_hp)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = '" + Strings::Escape(e.bucket_name) + "'"); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = '" + Strings::Escape(e.bucket_value) + "'"); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.bucket_comparison)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -407,6 +439,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotSpellsEntries FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotSpellsEntries e{};
+
+		e.id                = row.Get<uint32_t>(0).value_or(0);
+		e.npc_spells_id     = row.Get<int32_t>(1).value_or(0);
+		e.spell_id          = row.Get<uint16_t>(2).value_or(0);
+		e.type              = row.Get<uint32_t>(3).value_or(0);
+		e.minlevel          = row.Get<uint8_t>(4).value_or(0);
+		e.maxlevel          = row.Get<uint8_t>(5).value_or(255);
+		e.manacost          = row.Get<int16_t>(6).value_or(-1);
+		e.recast_delay      = row.Get<int32_t>(7).value_or(-1);
+		e.priority          = row.Get<int16_t>(8).value_or(0);
+		e.resist_adjust     = row.Get<int32_t>(9).value_or(0);
+		e.min_hp            = row.Get<int16_t>(10).value_or(0);
+		e.max_hp            = row.Get<int16_t>(11).value_or(0);
+		e.bucket_name       = row.GetStr(12).value_or("");
+		e.bucket_value      = row.GetStr(13).value_or("");
+		e.bucket_comparison = row.Get<uint8_t>(14).value_or(0);
+
+		return e;
+	}
+
+	static BotSpellsEntries FindOnePrepared(
+		Database& db,
+		int bot_spells_entries_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_spells_entries_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotSpellsEntries> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotSpellsEntries> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -508,7 +604,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -530,13 +634,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
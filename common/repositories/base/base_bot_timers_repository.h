@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBotTimersRepository {
@@ -28,6 +30,9 @@ public:
 		uint32_t spell_id;
 		uint8_t  is_item;
 		uint32_t item_id;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BotTimers &e,
+		const BotTimers &original
+	)
+	{
+		e.changed_columns[0] = e.bot_id != original.bot_id;
+		e.changed_columns[1] = e.timer_id != original.timer_id;
+		e.changed_columns[2] = e.timer_value != original.timer_value;
+		e.changed_columns[3] = e.recast_time != original.recast_time;
+		e.changed_columns[4] = e.is_spell != original.is_spell;
+		e.changed_columns[5] = e.is_disc != original.is_disc;
+		e.changed_columns[6] = e.spell_id != original.spell_id;
+		e.changed_columns[7] = e.is_item != original.is_item;
+		e.changed_columns[8] = e.item_id != original.item_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BotTimers &e
@@ -189,15 +211,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.timer_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.timer_value));
-		v.push_back(columns[3] + " = " + std::to_string(e.recast_time));
-		v.push_back(columns[4] + " = " + std::to_string(e.is_spell));
-		v.push_back(columns[5] + " = " + std::to_string(e.is_disc));
-		v.push_back(columns[6] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.is_item));
-		v.push_back(columns[8] + " = " + std::to_string(e.item_id));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.timer_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.timer_value)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.recast_time)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.is_spell)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.is_disc)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.is_item)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.item_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -348,6 +374,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BotTimers FromStmtRow(const mysql::StmtRow &row)
+	{
+		BotTimers e{};
+
+		e.bot_id      = row.Get<uint32_t>(0).value_or(0);
+		e.timer_id    = row.Get<uint32_t>(1).value_or(0);
+		e.timer_value = row.Get<uint32_t>(2).value_or(0);
+		e.recast_time = row.Get<uint32_t>(3).value_or(0);
+		e.is_spell    = row.Get<uint8_t>(4).value_or(0);
+		e.is_disc     = row.Get<uint8_t>(5).value_or(0);
+		e.spell_id    = row.Get<uint32_t>(6).value_or(0);
+		e.is_item     = row.Get<uint8_t>(7).value_or(0);
+		e.item_id     = row.Get<uint32_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static BotTimers FindOnePrepared(
+		Database& db,
+		int bot_timers_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bot_timers_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BotTimers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BotTimers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -443,7 +527,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.bot_id));
@@ -459,13 +551,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBugReportsRepository {
@@ -51,6 +53,9 @@ public:
 		time_t      last_review;
 		std::string last_reviewer;
 		std::string reviewer_notes;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<32> changed_columns = std::bitset<32>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -295,6 +300,46 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BugReports &e,
+		const BugReports &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.client_version_id != original.client_version_id;
+		e.changed_columns[3] = e.client_version_name != original.client_version_name;
+		e.changed_columns[4] = e.account_id != original.account_id;
+		e.changed_columns[5] = e.character_id != original.character_id;
+		e.changed_columns[6] = e.character_name != original.character_name;
+		e.changed_columns[7] = e.reporter_spoof != original.reporter_spoof;
+		e.changed_columns[8] = e.category_id != original.category_id;
+		e.changed_columns[9] = e.category_name != original.category_name;
+		e.changed_columns[10] = e.reporter_name != original.reporter_name;
+		e.changed_columns[11] = e.ui_path != original.ui_path;
+		e.changed_columns[12] = e.pos_x != original.pos_x;
+		e.changed_columns[13] = e.pos_y != original.pos_y;
+		e.changed_columns[14] = e.pos_z != original.pos_z;
+		e.changed_columns[15] = e.heading != original.heading;
+		e.changed_columns[16] = e.time_played != original.time_played;
+		e.changed_columns[17] = e.target_id != original.target_id;
+		e.changed_columns[18] = e.target_name != original.target_name;
+		e.changed_columns[19] = e.optional_info_mask != original.optional_info_mask;
+		e.changed_columns[20] = e._can_duplicate != original._can_duplicate;
+		e.changed_columns[21] = e._crash_bug != original._crash_bug;
+		e.changed_columns[22] = e._target_info != original._target_info;
+		e.changed_columns[23] = e._character_flags != original._character_flags;
+		e.changed_columns[24] = e._unknown_value != original._unknown_value;
+		e.changed_columns[25] = e.bug_report != original.bug_report;
+		e.changed_columns[26] = e.system_info != original.system_info;
+		e.changed_columns[27] = e.report_datetime != original.report_datetime;
+		e.changed_columns[28] = e.bug_status != original.bug_status;
+		e.changed_columns[29] = e.last_review != original.last_review;
+		e.changed_columns[30] = e.last_reviewer != original.last_reviewer;
+		e.changed_columns[31] = e.reviewer_notes != original.reviewer_notes;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BugReports &e
@@ -304,37 +349,41 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.client_version_id));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.client_version_name) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.character_name) + "'");
-		v.push_back(columns[7] + " = " + std::to_string(e.reporter_spoof));
-		v.push_back(columns[8] + " = " + std::to_string(e.category_id));
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.category_name) + "'");
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.reporter_name) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.ui_path) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.pos_x));
-		v.push_back(columns[13] + " = " + std::to_string(e.pos_y));
-		v.push_back(columns[14] + " = " + std::to_string(e.pos_z));
-		v.push_back(columns[15] + " = " + std::to_string(e.heading));
-		v.push_back(columns[16] + " = " + std::to_string(e.time_played));
-		v.push_back(columns[17] + " = " + std::to_string(e.target_id));
-		v.push_back(columns[18] + " = '" + Strings::Escape(e.target_name) + "'");
-		v.push_back(columns[19] + " = " + std::to_string(e.optional_info_mask));
-		v.push_back(columns[20] + " = " + std::to_string(e._can_duplicate));
-		v.push_back(columns[21] + " = " + std::to_string(e._crash_bug));
-		v.push_back(columns[22] + " = " + std::to_string(e._target_info));
-		v.push_back(columns[23] + " = " + std::to_string(e._character_flags));
-		v.push_back(columns[24] + " = " + std::to_string(e._unknown_value));
-		v.push_back(columns[25] + " = '" + Strings::Escape(e.bug_report) + "'");
-		v.push_back(columns[26] + " = '" + Strings::Escape(e.system_info) + "'");
-		v.push_back(columns[27] + " = FROM_UNIXTIME(" + (e.report_datetime > 0 ? std::to_string(e.report_datetime) : "null") + ")");
-		v.push_back(columns[28] + " = " + std::to_string(e.bug_status));
-		v.push_back(columns[29] + " = FROM_UNIXTIME(" + (e.last_review > 0 ? std::to_string(e.last_review) : "null") + ")");
-		v.push_back(columns[30] + " = '" + Strings::Escape(e.last_reviewer) + "'");
-		v.push_back(columns[31] + " = '" + Strings::Escape(e.reviewer_notes) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.client_version_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.client_version_name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.character_name) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.reporter_spoof)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.category_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.category_name) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.reporter_name) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.ui_path) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.pos_x)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.pos_y)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.pos_z)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.time_played)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.target_id)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = '" + Strings::Escape(e.target_name) + "'"); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.optional_info_mask)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e._can_duplicate)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e._crash_bug)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e._target_info)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e._character_flags)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e._unknown_value)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = '" + Strings::Escape(e.bug_report) + "'"); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = '" + Strings::Escape(e.system_info) + "'"); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = FROM_UNIXTIME(" + (e.report_datetime > 0 ? std::to_string(e.report_datetime) : "null") + ")"); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.bug_status)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = FROM_UNIXTIME(" + (e.last_review > 0 ? std::to_string(e.last_review) : "null") + ")"); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = '" + Strings::Escape(e.last_reviewer) + "'"); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = '" + Strings::Escape(e.reviewer_notes) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -577,6 +626,87 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BugReports FromStmtRow(const mysql::StmtRow &row)
+	{
+		BugReports e{};
+
+		e.id                  = row.Get<uint32_t>(0).value_or(0);
+		e.zone                = row.GetStr(1).value_or("Unknown");
+		e.client_version_id   = row.Get<uint32_t>(2).value_or(0);
+		e.client_version_name = row.GetStr(3).value_or("Unknown");
+		e.account_id          = row.Get<uint32_t>(4).value_or(0);
+		e.character_id        = row.Get<uint32_t>(5).value_or(0);
+		e.character_name      = row.GetStr(6).value_or("Unknown");
+		e.reporter_spoof      = row.Get<int8_t>(7).value_or(1);
+		e.category_id         = row.Get<uint32_t>(8).value_or(0);
+		e.category_name       = row.GetStr(9).value_or("Other");
+		e.reporter_name       = row.GetStr(10).value_or("Unknown");
+		e.ui_path             = row.GetStr(11).value_or("Unknown");
+		e.pos_x               = row.Get<float>(12).value_or(0);
+		e.pos_y               = row.Get<float>(13).value_or(0);
+		e.pos_z               = row.Get<float>(14).value_or(0);
+		e.heading             = row.Get<uint32_t>(15).value_or(0);
+		e.time_played         = row.Get<uint32_t>(16).value_or(0);
+		e.target_id           = row.Get<uint32_t>(17).value_or(0);
+		e.target_name         = row.GetStr(18).value_or("Unknown");
+		e.optional_info_mask  = row.Get<uint32_t>(19).value_or(0);
+		e._can_duplicate      = row.Get<int8_t>(20).value_or(0);
+		e._crash_bug          = row.Get<int8_t>(21).value_or(0);
+		e._target_info        = row.Get<int8_t>(22).value_or(0);
+		e._character_flags    = row.Get<int8_t>(23).value_or(0);
+		e._unknown_value      = row.Get<int8_t>(24).value_or(0);
+		e.bug_report          = row.GetStr(25).value_or("");
+		e.system_info         = row.GetStr(26).value_or("");
+		e.report_datetime     = row.Get<int64_t>(27).value_or(-1);
+		e.bug_status          = row.Get<uint8_t>(28).value_or(0);
+		e.last_review         = row.Get<int64_t>(29).value_or(-1);
+		e.last_reviewer       = row.GetStr(30).value_or("None");
+		e.reviewer_notes      = row.GetStr(31).value_or("");
+
+		return e;
+	}
+
+	static BugReports FindOnePrepared(
+		Database& db,
+		int bug_reports_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bug_reports_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BugReports> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BugReports> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -695,7 +825,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<32> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -734,13 +872,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
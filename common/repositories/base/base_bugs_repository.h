@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBugsRepository {
@@ -32,6 +34,9 @@ public:
 		std::string bug;
 		std::string date;
 		uint8_t     status;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Bugs &e,
+		const Bugs &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.name != original.name;
+		e.changed_columns[3] = e.ui != original.ui;
+		e.changed_columns[4] = e.x != original.x;
+		e.changed_columns[5] = e.y != original.y;
+		e.changed_columns[6] = e.z != original.z;
+		e.changed_columns[7] = e.type != original.type;
+		e.changed_columns[8] = e.flag != original.flag;
+		e.changed_columns[9] = e.target != original.target;
+		e.changed_columns[10] = e.bug != original.bug;
+		e.changed_columns[11] = e.date != original.date;
+		e.changed_columns[12] = e.status != original.status;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Bugs &e
@@ -209,18 +235,22 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.ui) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.x));
-		v.push_back(columns[5] + " = " + std::to_string(e.y));
-		v.push_back(columns[6] + " = " + std::to_string(e.z));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.type) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.flag));
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.target) + "'");
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.bug) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.date) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.status));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.ui) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.type) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.flag)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.target) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.bug) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.date) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.status)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -387,6 +417,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Bugs FromStmtRow(const mysql::StmtRow &row)
+	{
+		Bugs e{};
+
+		e.id     = row.Get<uint32_t>(0).value_or(0);
+		e.zone   = row.GetStr(1).value_or("");
+		e.name   = row.GetStr(2).value_or("");
+		e.ui     = row.GetStr(3).value_or("");
+		e.x      = row.Get<float>(4).value_or(0);
+		e.y      = row.Get<float>(5).value_or(0);
+		e.z      = row.Get<float>(6).value_or(0);
+		e.type   = row.GetStr(7).value_or("");
+		e.flag   = row.Get<uint8_t>(8).value_or(0);
+		e.target = row.GetStr(9).value_or("");
+		e.bug    = row.GetStr(10).value_or("");
+		e.date   = row.GetStr(11).value_or(0);
+		e.status = row.Get<uint8_t>(12).value_or(0);
+
+		return e;
+	}
+
+	static Bugs FindOnePrepared(
+		Database& db,
+		int bugs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { bugs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Bugs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Bugs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -486,7 +578,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -506,13 +606,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
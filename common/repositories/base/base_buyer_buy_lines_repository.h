@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseBuyerBuyLinesRepository {
@@ -28,6 +30,9 @@ public:
 		int32_t     item_price;
 		uint32_t    item_icon;
 		std::string item_name;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		BuyerBuyLines &e,
+		const BuyerBuyLines &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.buyer_id != original.buyer_id;
+		e.changed_columns[2] = e.char_id != original.char_id;
+		e.changed_columns[3] = e.buy_slot_id != original.buy_slot_id;
+		e.changed_columns[4] = e.item_id != original.item_id;
+		e.changed_columns[5] = e.item_qty != original.item_qty;
+		e.changed_columns[6] = e.item_price != original.item_price;
+		e.changed_columns[7] = e.item_icon != original.item_icon;
+		e.changed_columns[8] = e.item_name != original.item_name;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const BuyerBuyLines &e
@@ -189,14 +211,18 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.buyer_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.buy_slot_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.item_qty));
-		v.push_back(columns[6] + " = " + std::to_string(e.item_price));
-		v.push_back(columns[7] + " = " + std::to_string(e.item_icon));
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.item_name) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.buyer_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.buy_slot_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.item_qty)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.item_price)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.item_icon)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.item_name) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -347,6 +373,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static BuyerBuyLines FromStmtRow(const mysql::StmtRow &row)
+	{
+		BuyerBuyLines e{};
+
+		e.id          = row.Get<uint64_t>(0).value_or(0);
+		e.buyer_id    = row.Get<uint64_t>(1).value_or(0);
+		e.char_id     = row.Get<uint32_t>(2).value_or(0);
+		e.buy_slot_id = row.Get<int32_t>(3).value_or(0);
+		e.item_id     = row.Get<int32_t>(4).value_or(0);
+		e.item_qty    = row.Get<int32_t>(5).value_or(0);
+		e.item_price  = row.Get<int32_t>(6).value_or(0);
+		e.item_icon   = row.Get<uint32_t>(7).value_or(0);
+		e.item_name   = row.GetStr(8).value_or("");
+
+		return e;
+	}
+
+	static BuyerBuyLines FindOnePrepared(
+		Database& db,
+		int buyer_buy_lines_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { buyer_buy_lines_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<BuyerBuyLines> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<BuyerBuyLines> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -442,7 +526,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -458,13 +550,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharCreateCombinationsRepository {
@@ -25,6 +27,9 @@ public:
 		uint32_t deity;
 		uint32_t start_zone;
 		uint32_t expansions_req;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<6> changed_columns = std::bitset<6>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -165,6 +170,20 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharCreateCombinations &e,
+		const CharCreateCombinations &original
+	)
+	{
+		e.changed_columns[0] = e.allocation_id != original.allocation_id;
+		e.changed_columns[1] = e.race != original.race;
+		e.changed_columns[2] = e.class_ != original.class_;
+		e.changed_columns[3] = e.deity != original.deity;
+		e.changed_columns[4] = e.start_zone != original.start_zone;
+		e.changed_columns[5] = e.expansions_req != original.expansions_req;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharCreateCombinations &e
@@ -174,12 +193,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.allocation_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.race));
-		v.push_back(columns[2] + " = " + std::to_string(e.class_));
-		v.push_back(columns[3] + " = " + std::to_string(e.deity));
-		v.push_back(columns[4] + " = " + std::to_string(e.start_zone));
-		v.push_back(columns[5] + " = " + std::to_string(e.expansions_req));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.allocation_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.deity)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.start_zone)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.expansions_req)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -318,6 +341,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharCreateCombinations FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharCreateCombinations e{};
+
+		e.allocation_id  = row.Get<uint32_t>(0).value_or(0);
+		e.race           = row.Get<uint32_t>(1).value_or(0);
+		e.class_         = row.Get<uint32_t>(2).value_or(0);
+		e.deity          = row.Get<uint32_t>(3).value_or(0);
+		e.start_zone     = row.Get<uint32_t>(4).value_or(0);
+		e.expansions_req = row.Get<uint32_t>(5).value_or(0);
+
+		return e;
+	}
+
+	static CharCreateCombinations FindOnePrepared(
+		Database& db,
+		int char_create_combinations_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { char_create_combinations_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharCreateCombinations> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharCreateCombinations> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -410,7 +488,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<6> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.allocation_id));
@@ -423,13 +509,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharCreatePointAllocationsRepository {
@@ -34,6 +36,9 @@ public:
 		uint32_t alloc_int;
 		uint32_t alloc_wis;
 		uint32_t alloc_cha;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharCreatePointAllocations &e,
+		const CharCreatePointAllocations &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.base_str != original.base_str;
+		e.changed_columns[2] = e.base_sta != original.base_sta;
+		e.changed_columns[3] = e.base_dex != original.base_dex;
+		e.changed_columns[4] = e.base_agi != original.base_agi;
+		e.changed_columns[5] = e.base_int != original.base_int;
+		e.changed_columns[6] = e.base_wis != original.base_wis;
+		e.changed_columns[7] = e.base_cha != original.base_cha;
+		e.changed_columns[8] = e.alloc_str != original.alloc_str;
+		e.changed_columns[9] = e.alloc_sta != original.alloc_sta;
+		e.changed_columns[10] = e.alloc_dex != original.alloc_dex;
+		e.changed_columns[11] = e.alloc_agi != original.alloc_agi;
+		e.changed_columns[12] = e.alloc_int != original.alloc_int;
+		e.changed_columns[13] = e.alloc_wis != original.alloc_wis;
+		e.changed_columns[14] = e.alloc_cha != original.alloc_cha;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharCreatePointAllocations &e
@@ -219,21 +247,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.base_str));
-		v.push_back(columns[2] + " = " + std::to_string(e.base_sta));
-		v.push_back(columns[3] + " = " + std::to_string(e.base_dex));
-		v.push_back(columns[4] + " = " + std::to_string(e.base_agi));
-		v.push_back(columns[5] + " = " + std::to_string(e.base_int));
-		v.push_back(columns[6] + " = " + std::to_string(e.base_wis));
-		v.push_back(columns[7] + " = " + std::to_string(e.base_cha));
-		v.push_back(columns[8] + " = " + std::to_string(e.alloc_str));
-		v.push_back(columns[9] + " = " + std::to_string(e.alloc_sta));
-		v.push_back(columns[10] + " = " + std::to_string(e.alloc_dex));
-		v.push_back(columns[11] + " = " + std::to_string(e.alloc_agi));
-		v.push_back(columns[12] + " = " + std::to_string(e.alloc_int));
-		v.push_back(columns[13] + " = " + std::to_string(e.alloc_wis));
-		v.push_back(columns[14] + " = " + std::to_string(e.alloc_cha));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.base_str)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.base_sta)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.base_dex)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.base_agi)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.base_int)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.base_wis)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.base_cha)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.alloc_str)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.alloc_sta)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.alloc_dex)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.alloc_agi)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.alloc_int)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.alloc_wis)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.alloc_cha)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -408,6 +440,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharCreatePointAllocations FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharCreatePointAllocations e{};
+
+		e.id        = row.Get<uint32_t>(0).value_or(0);
+		e.base_str  = row.Get<uint32_t>(1).value_or(0);
+		e.base_sta  = row.Get<uint32_t>(2).value_or(0);
+		e.base_dex  = row.Get<uint32_t>(3).value_or(0);
+		e.base_agi  = row.Get<uint32_t>(4).value_or(0);
+		e.base_int  = row.Get<uint32_t>(5).value_or(0);
+		e.base_wis  = row.Get<uint32_t>(6).value_or(0);
+		e.base_cha  = row.Get<uint32_t>(7).value_or(0);
+		e.alloc_str = row.Get<uint32_t>(8).value_or(0);
+		e.alloc_sta = row.Get<uint32_t>(9).value_or(0);
+		e.alloc_dex = row.Get<uint32_t>(10).value_or(0);
+		e.alloc_agi = row.Get<uint32_t>(11).value_or(0);
+		e.alloc_int = row.Get<uint32_t>(12).value_or(0);
+		e.alloc_wis = row.Get<uint32_t>(13).value_or(0);
+		e.alloc_cha = row.Get<uint32_t>(14).value_or(0);
+
+		return e;
+	}
+
+	static CharCreatePointAllocations FindOnePrepared(
+		Database& db,
+		int char_create_point_allocations_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { char_create_point_allocations_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharCreatePointAllocations> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharCreatePointAllocations> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -509,7 +605,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -531,13 +635,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterBindRepository {
@@ -27,6 +29,9 @@ public:
 		float    y;
 		float    z;
 		float    heading;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterBind &e,
+		const CharacterBind &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.slot != original.slot;
+		e.changed_columns[2] = e.zone_id != original.zone_id;
+		e.changed_columns[3] = e.instance_id != original.instance_id;
+		e.changed_columns[4] = e.x != original.x;
+		e.changed_columns[5] = e.y != original.y;
+		e.changed_columns[6] = e.z != original.z;
+		e.changed_columns[7] = e.heading != original.heading;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterBind &e
@@ -184,13 +205,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.slot));
-		v.push_back(columns[2] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.x));
-		v.push_back(columns[5] + " = " + std::to_string(e.y));
-		v.push_back(columns[6] + " = " + std::to_string(e.z));
-		v.push_back(columns[7] + " = " + std::to_string(e.heading));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.slot)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.heading)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -337,6 +362,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterBind FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterBind e{};
+
+		e.id          = row.Get<uint32_t>(0).value_or(0);
+		e.slot        = row.Get<int32_t>(1).value_or(0);
+		e.zone_id     = row.Get<uint16_t>(2).value_or(0);
+		e.instance_id = row.Get<uint32_t>(3).value_or(0);
+		e.x           = row.Get<float>(4).value_or(0);
+		e.y           = row.Get<float>(5).value_or(0);
+		e.z           = row.Get<float>(6).value_or(0);
+		e.heading     = row.Get<float>(7).value_or(0);
+
+		return e;
+	}
+
+	static CharacterBind FindOnePrepared(
+		Database& db,
+		int character_bind_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_bind_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterBind> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterBind> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -431,7 +513,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -446,13 +536,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
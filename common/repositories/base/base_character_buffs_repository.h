@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterBuffsRepository {
@@ -36,6 +38,9 @@ public:
 		int32_t     caston_z;
 		int32_t     ExtraDIChance;
 		int32_t     instrument_mod;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterBuffs &e,
+		const CharacterBuffs &original
+	)
+	{
+		e.changed_columns[0] = e.character_id != original.character_id;
+		e.changed_columns[1] = e.slot_id != original.slot_id;
+		e.changed_columns[2] = e.spell_id != original.spell_id;
+		e.changed_columns[3] = e.caster_level != original.caster_level;
+		e.changed_columns[4] = e.caster_name != original.caster_name;
+		e.changed_columns[5] = e.ticsremaining != original.ticsremaining;
+		e.changed_columns[6] = e.counters != original.counters;
+		e.changed_columns[7] = e.numhits != original.numhits;
+		e.changed_columns[8] = e.melee_rune != original.melee_rune;
+		e.changed_columns[9] = e.magic_rune != original.magic_rune;
+		e.changed_columns[10] = e.persistent != original.persistent;
+		e.changed_columns[11] = e.dot_rune != original.dot_rune;
+		e.changed_columns[12] = e.caston_x != original.caston_x;
+		e.changed_columns[13] = e.caston_y != original.caston_y;
+		e.changed_columns[14] = e.caston_z != original.caston_z;
+		e.changed_columns[15] = e.ExtraDIChance != original.ExtraDIChance;
+		e.changed_columns[16] = e.instrument_mod != original.instrument_mod;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterBuffs &e
@@ -229,23 +259,27 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.caster_level));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.caster_name) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.ticsremaining));
-		v.push_back(columns[6] + " = " + std::to_string(e.counters));
-		v.push_back(columns[7] + " = " + std::to_string(e.numhits));
-		v.push_back(columns[8] + " = " + std::to_string(e.melee_rune));
-		v.push_back(columns[9] + " = " + std::to_string(e.magic_rune));
-		v.push_back(columns[10] + " = " + std::to_string(e.persistent));
-		v.push_back(columns[11] + " = " + std::to_string(e.dot_rune));
-		v.push_back(columns[12] + " = " + std::to_string(e.caston_x));
-		v.push_back(columns[13] + " = " + std::to_string(e.caston_y));
-		v.push_back(columns[14] + " = " + std::to_string(e.caston_z));
-		v.push_back(columns[15] + " = " + std::to_string(e.ExtraDIChance));
-		v.push_back(columns[16] + " = " + std::to_string(e.instrument_mod));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.caster_level)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.caster_name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.ticsremaining)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.counters)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.numhits)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.melee_rune)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.magic_rune)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.persistent)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.dot_rune)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.caston_x)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.caston_y)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.caston_z)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.ExtraDIChance)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.instrument_mod)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -428,6 +462,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterBuffs FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterBuffs e{};
+
+		e.character_id   = row.Get<uint32_t>(0).value_or(0);
+		e.slot_id        = row.Get<uint8_t>(1).value_or(0);
+		e.spell_id       = row.Get<uint16_t>(2).value_or(0);
+		e.caster_level   = row.Get<uint8_t>(3).value_or(0);
+		e.caster_name    = row.GetStr(4).value_or("");
+		e.ticsremaining  = row.Get<int32_t>(5).value_or(0);
+		e.counters       = row.Get<uint32_t>(6).value_or(0);
+		e.numhits        = row.Get<uint32_t>(7).value_or(0);
+		e.melee_rune     = row.Get<uint32_t>(8).value_or(0);
+		e.magic_rune     = row.Get<uint32_t>(9).value_or(0);
+		e.persistent     = row.Get<uint8_t>(10).value_or(0);
+		e.dot_rune       = row.Get<int32_t>(11).value_or(0);
+		e.caston_x       = row.Get<int32_t>(12).value_or(0);
+		e.caston_y       = row.Get<int32_t>(13).value_or(0);
+		e.caston_z       = row.Get<int32_t>(14).value_or(0);
+		e.ExtraDIChance  = row.Get<int32_t>(15).value_or(0);
+		e.instrument_mod = row.Get<int32_t>(16).value_or(10);
+
+		return e;
+	}
+
+	static CharacterBuffs FindOnePrepared(
+		Database& db,
+		int character_buffs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_buffs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterBuffs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterBuffs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -531,7 +631,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.character_id));
@@ -555,13 +663,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
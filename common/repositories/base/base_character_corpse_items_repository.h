@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterCorpseItemsRepository {
@@ -34,6 +36,9 @@ public:
 		uint32_t    ornamenticon;
 		uint32_t    ornamentidfile;
 		uint32_t    ornament_hero_model;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterCorpseItems &e,
+		const CharacterCorpseItems &original
+	)
+	{
+		e.changed_columns[0] = e.corpse_id != original.corpse_id;
+		e.changed_columns[1] = e.equip_slot != original.equip_slot;
+		e.changed_columns[2] = e.item_id != original.item_id;
+		e.changed_columns[3] = e.charges != original.charges;
+		e.changed_columns[4] = e.aug_1 != original.aug_1;
+		e.changed_columns[5] = e.aug_2 != original.aug_2;
+		e.changed_columns[6] = e.aug_3 != original.aug_3;
+		e.changed_columns[7] = e.aug_4 != original.aug_4;
+		e.changed_columns[8] = e.aug_5 != original.aug_5;
+		e.changed_columns[9] = e.aug_6 != original.aug_6;
+		e.changed_columns[10] = e.attuned != original.attuned;
+		e.changed_columns[11] = e.custom_data != original.custom_data;
+		e.changed_columns[12] = e.ornamenticon != original.ornamenticon;
+		e.changed_columns[13] = e.ornamentidfile != original.ornamentidfile;
+		e.changed_columns[14] = e.ornament_hero_model != original.ornament_hero_model;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterCorpseItems &e
@@ -219,21 +247,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.corpse_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.equip_slot));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.charges));
-		v.push_back(columns[4] + " = " + std::to_string(e.aug_1));
-		v.push_back(columns[5] + " = " + std::to_string(e.aug_2));
-		v.push_back(columns[6] + " = " + std::to_string(e.aug_3));
-		v.push_back(columns[7] + " = " + std::to_string(e.aug_4));
-		v.push_back(columns[8] + " = " + std::to_string(e.aug_5));
-		v.push_back(columns[9] + " = " + std::to_string(e.aug_6));
-		v.push_back(columns[10] + " = " + std::to_string(e.attuned));
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.custom_data) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.ornamenticon));
-		v.push_back(columns[13] + " = " + std::to_string(e.ornamentidfile));
-		v.push_back(columns[14] + " = " + std::to_string(e.ornament_hero_model));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.corpse_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.equip_slot)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.aug_1)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.aug_2)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aug_3)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.aug_4)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.aug_5)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.aug_6)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.attuned)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.custom_data) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.ornamenticon)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.ornamentidfile)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.ornament_hero_model)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -408,6 +440,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterCorpseItems FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterCorpseItems e{};
+
+		e.corpse_id           = row.Get<uint32_t>(0).value_or(0);
+		e.equip_slot          = row.Get<uint32_t>(1).value_or(0);
+		e.item_id             = row.Get<uint32_t>(2).value_or(0);
+		e.charges             = row.Get<uint32_t>(3).value_or(0);
+		e.aug_1               = row.Get<uint32_t>(4).value_or(0);
+		e.aug_2               = row.Get<uint32_t>(5).value_or(0);
+		e.aug_3               = row.Get<uint32_t>(6).value_or(0);
+		e.aug_4               = row.Get<uint32_t>(7).value_or(0);
+		e.aug_5               = row.Get<uint32_t>(8).value_or(0);
+		e.aug_6               = row.Get<int32_t>(9).value_or(0);
+		e.attuned             = row.Get<int16_t>(10).value_or(0);
+		e.custom_data         = row.GetStr(11).value_or("");
+		e.ornamenticon        = row.Get<uint32_t>(12).value_or(0);
+		e.ornamentidfile      = row.Get<uint32_t>(13).value_or(0);
+		e.ornament_hero_model = row.Get<uint32_t>(14).value_or(0);
+
+		return e;
+	}
+
+	static CharacterCorpseItems FindOnePrepared(
+		Database& db,
+		int character_corpse_items_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_corpse_items_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterCorpseItems> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterCorpseItems> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -509,7 +605,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.corpse_id));
@@ -531,13 +635,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
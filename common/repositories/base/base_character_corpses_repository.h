@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterCorpsesRepository {
@@ -70,6 +72,9 @@ public:
 		uint32_t    gm_exp;
 		uint32_t    killed_by;
 		uint8_t     rezzable;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<51> changed_columns = std::bitset<51>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -390,6 +395,65 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterCorpses &e,
+		const CharacterCorpses &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.charid != original.charid;
+		e.changed_columns[2] = e.charname != original.charname;
+		e.changed_columns[3] = e.zone_id != original.zone_id;
+		e.changed_columns[4] = e.instance_id != original.instance_id;
+		e.changed_columns[5] = e.x != original.x;
+		e.changed_columns[6] = e.y != original.y;
+		e.changed_columns[7] = e.z != original.z;
+		e.changed_columns[8] = e.heading != original.heading;
+		e.changed_columns[9] = e.time_of_death != original.time_of_death;
+		e.changed_columns[10] = e.guild_consent_id != original.guild_consent_id;
+		e.changed_columns[11] = e.is_rezzed != original.is_rezzed;
+		e.changed_columns[12] = e.is_buried != original.is_buried;
+		e.changed_columns[13] = e.was_at_graveyard != original.was_at_graveyard;
+		e.changed_columns[14] = e.is_locked != original.is_locked;
+		e.changed_columns[15] = e.exp != original.exp;
+		e.changed_columns[16] = e.size != original.size;
+		e.changed_columns[17] = e.level != original.level;
+		e.changed_columns[18] = e.race != original.race;
+		e.changed_columns[19] = e.gender != original.gender;
+		e.changed_columns[20] = e.class_ != original.class_;
+		e.changed_columns[21] = e.deity != original.deity;
+		e.changed_columns[22] = e.texture != original.texture;
+		e.changed_columns[23] = e.helm_texture != original.helm_texture;
+		e.changed_columns[24] = e.copper != original.copper;
+		e.changed_columns[25] = e.silver != original.silver;
+		e.changed_columns[26] = e.gold != original.gold;
+		e.changed_columns[27] = e.platinum != original.platinum;
+		e.changed_columns[28] = e.hair_color != original.hair_color;
+		e.changed_columns[29] = e.beard_color != original.beard_color;
+		e.changed_columns[30] = e.eye_color_1 != original.eye_color_1;
+		e.changed_columns[31] = e.eye_color_2 != original.eye_color_2;
+		e.changed_columns[32] = e.hair_style != original.hair_style;
+		e.changed_columns[33] = e.face != original.face;
+		e.changed_columns[34] = e.beard != original.beard;
+		e.changed_columns[35] = e.drakkin_heritage != original.drakkin_heritage;
+		e.changed_columns[36] = e.drakkin_tattoo != original.drakkin_tattoo;
+		e.changed_columns[37] = e.drakkin_details != original.drakkin_details;
+		e.changed_columns[38] = e.wc_1 != original.wc_1;
+		e.changed_columns[39] = e.wc_2 != original.wc_2;
+		e.changed_columns[40] = e.wc_3 != original.wc_3;
+		e.changed_columns[41] = e.wc_4 != original.wc_4;
+		e.changed_columns[42] = e.wc_5 != original.wc_5;
+		e.changed_columns[43] = e.wc_6 != original.wc_6;
+		e.changed_columns[44] = e.wc_7 != original.wc_7;
+		e.changed_columns[45] = e.wc_8 != original.wc_8;
+		e.changed_columns[46] = e.wc_9 != original.wc_9;
+		e.changed_columns[47] = e.rez_time != original.rez_time;
+		e.changed_columns[48] = e.gm_exp != original.gm_exp;
+		e.changed_columns[49] = e.killed_by != original.killed_by;
+		e.changed_columns[50] = e.rezzable != original.rezzable;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterCorpses &e
@@ -399,56 +463,60 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.charid));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.x));
-		v.push_back(columns[6] + " = " + std::to_string(e.y));
-		v.push_back(columns[7] + " = " + std::to_string(e.z));
-		v.push_back(columns[8] + " = " + std::to_string(e.heading));
-		v.push_back(columns[9] + " = FROM_UNIXTIME(" + (e.time_of_death > 0 ? std::to_string(e.time_of_death) : "null") + ")");
-		v.push_back(columns[10] + " = " + std::to_string(e.guild_consent_id));
-		v.push_back(columns[11] + " = " + std::to_string(e.is_rezzed));
-		v.push_back(columns[12] + " = " + std::to_string(e.is_buried));
-		v.push_back(columns[13] + " = " + std::to_string(e.was_at_graveyard));
-		v.push_back(columns[14] + " = " + std::to_string(e.is_locked));
-		v.push_back(columns[15] + " = " + std::to_string(e.exp));
-		v.push_back(columns[16] + " = " + std::to_string(e.size));
-		v.push_back(columns[17] + " = " + std::to_string(e.level));
-		v.push_back(columns[18] + " = " + std::to_string(e.race));
-		v.push_back(columns[19] + " = " + std::to_string(e.gender));
-		v.push_back(columns[20] + " = " + std::to_string(e.class_));
-		v.push_back(columns[21] + " = " + std::to_string(e.deity));
-		v.push_back(columns[22] + " = " + std::to_string(e.texture));
-		v.push_back(columns[23] + " = " + std::to_string(e.helm_texture));
-		v.push_back(columns[24] + " = " + std::to_string(e.copper));
-		v.push_back(columns[25] + " = " + std::to_string(e.silver));
-		v.push_back(columns[26] + " = " + std::to_string(e.gold));
-		v.push_back(columns[27] + " = " + std::to_string(e.platinum));
-		v.push_back(columns[28] + " = " + std::to_string(e.hair_color));
-		v.push_back(columns[29] + " = " + std::to_string(e.beard_color));
-		v.push_back(columns[30] + " = " + std::to_string(e.eye_color_1));
-		v.push_back(columns[31] + " = " + std::to_string(e.eye_color_2));
-		v.push_back(columns[32] + " = " + std::to_string(e.hair_style));
-		v.push_back(columns[33] + " = " + std::to_string(e.face));
-		v.push_back(columns[34] + " = " + std::to_string(e.beard));
-		v.push_back(columns[35] + " = " + std::to_string(e.drakkin_heritage));
-		v.push_back(columns[36] + " = " + std::to_string(e.drakkin_tattoo));
-		v.push_back(columns[37] + " = " + std::to_string(e.drakkin_details));
-		v.push_back(columns[38] + " = " + std::to_string(e.wc_1));
-		v.push_back(columns[39] + " = " + std::to_string(e.wc_2));
-		v.push_back(columns[40] + " = " + std::to_string(e.wc_3));
-		v.push_back(columns[41] + " = " + std::to_string(e.wc_4));
-		v.push_back(columns[42] + " = " + std::to_string(e.wc_5));
-		v.push_back(columns[43] + " = " + std::to_string(e.wc_6));
-		v.push_back(columns[44] + " = " + std::to_string(e.wc_7));
-		v.push_back(columns[45] + " = " + std::to_string(e.wc_8));
-		v.push_back(columns[46] + " = " + std::to_string(e.wc_9));
-		v.push_back(columns[47] + " = " + std::to_string(e.rez_time));
-		v.push_back(columns[48] + " = " + std::to_string(e.gm_exp));
-		v.push_back(columns[49] + " = " + std::to_string(e.killed_by));
-		v.push_back(columns[50] + " = " + std::to_string(e.rezzable));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.charid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = FROM_UNIXTIME(" + (e.time_of_death > 0 ? std::to_string(e.time_of_death) : "null") + ")"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.guild_consent_id)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.is_rezzed)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.is_buried)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.was_at_graveyard)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.is_locked)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.exp)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.gender)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.deity)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.texture)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.helm_texture)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.copper)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.silver)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.gold)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.platinum)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.hair_color)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.beard_color)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.eye_color_1)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.eye_color_2)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.hair_style)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.face)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.beard)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.drakkin_heritage)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.drakkin_tattoo)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.drakkin_details)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.wc_1)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.wc_2)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.wc_3)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.wc_4)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.wc_5)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.wc_6)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.wc_7)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.wc_8)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.wc_9)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.rez_time)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.gm_exp)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.killed_by)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.rezzable)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -767,6 +835,106 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterCorpses FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterCorpses e{};
+
+		e.id               = row.Get<uint32_t>(0).value_or(0);
+		e.charid           = row.Get<uint32_t>(1).value_or(0);
+		e.charname         = row.GetStr(2).value_or("");
+		e.zone_id          = row.Get<int16_t>(3).value_or(0);
+		e.instance_id      = row.Get<uint16_t>(4).value_or(0);
+		e.x                = row.Get<float>(5).value_or(0);
+		e.y                = row.Get<float>(6).value_or(0);
+		e.z                = row.Get<float>(7).value_or(0);
+		e.heading          = row.Get<float>(8).value_or(0);
+		e.time_of_death    = row.Get<int64_t>(9).value_or(-1);
+		e.guild_consent_id = row.Get<uint32_t>(10).value_or(0);
+		e.is_rezzed        = row.Get<uint8_t>(11).value_or(0);
+		e.is_buried        = row.Get<int8_t>(12).value_or(0);
+		e.was_at_graveyard = row.Get<int8_t>(13).value_or(0);
+		e.is_locked        = row.Get<int8_t>(14).value_or(0);
+		e.exp              = row.Get<uint32_t>(15).value_or(0);
+		e.size             = row.Get<uint32_t>(16).value_or(0);
+		e.level            = row.Get<uint32_t>(17).value_or(0);
+		e.race             = row.Get<uint32_t>(18).value_or(0);
+		e.gender           = row.Get<uint32_t>(19).value_or(0);
+		e.class_           = row.Get<uint32_t>(20).value_or(0);
+		e.deity            = row.Get<uint32_t>(21).value_or(0);
+		e.texture          = row.Get<uint32_t>(22).value_or(0);
+		e.helm_texture     = row.Get<uint32_t>(23).value_or(0);
+		e.copper           = row.Get<uint32_t>(24).value_or(0);
+		e.silver           = row.Get<uint32_t>(25).value_or(0);
+		e.gold             = row.Get<uint32_t>(26).value_or(0);
+		e.platinum         = row.Get<uint32_t>(27).value_or(0);
+		e.hair_color       = row.Get<uint32_t>(28).value_or(0);
+		e.beard_color      = row.Get<uint32_t>(29).value_or(0);
+		e.eye_color_1      = row.Get<uint32_t>(30).value_or(0);
+		e.eye_color_2      = row.Get<uint32_t>(31).value_or(0);
+		e.hair_style       = row.Get<uint32_t>(32).value_or(0);
+		e.face             = row.Get<uint32_t>(33).value_or(0);
+		e.beard            = row.Get<uint32_t>(34).value_or(0);
+		e.drakkin_heritage = row.Get<uint32_t>(35).value_or(0);
+		e.drakkin_tattoo   = row.Get<uint32_t>(36).value_or(0);
+		e.drakkin_details  = row.Get<uint32_t>(37).value_or(0);
+		e.wc_1             = row.Get<uint32_t>(38).value_or(0);
+		e.wc_2             = row.Get<uint32_t>(39).value_or(0);
+		e.wc_3             = row.Get<uint32_t>(40).value_or(0);
+		e.wc_4             = row.Get<uint32_t>(41).value_or(0);
+		e.wc_5             = row.Get<uint32_t>(42).value_or(0);
+		e.wc_6             = row.Get<uint32_t>(43).value_or(0);
+		e.wc_7             = row.Get<uint32_t>(44).value_or(0);
+		e.wc_8             = row.Get<uint32_t>(45).value_or(0);
+		e.wc_9             = row.Get<uint32_t>(46).value_or(0);
+		e.rez_time         = row.Get<uint32_t>(47).value_or(0);
+		e.gm_exp           = row.Get<uint32_t>(48).value_or(0);
+		e.killed_by        = row.Get<uint32_t>(49).value_or(0);
+		e.rezzable         = row.Get<uint8_t>(50).value_or(0);
+
+		return e;
+	}
+
+	static CharacterCorpses FindOnePrepared(
+		Database& db,
+		int character_corpses_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_corpses_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterCorpses> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterCorpses> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -904,7 +1072,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<51> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -962,13 +1138,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
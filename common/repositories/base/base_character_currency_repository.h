@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterCurrencyRepository {
@@ -36,6 +38,9 @@ public:
 		uint32_t career_radiant_crystals;
 		uint32_t ebon_crystals;
 		uint32_t career_ebon_crystals;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterCurrency &e,
+		const CharacterCurrency &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.platinum != original.platinum;
+		e.changed_columns[2] = e.gold != original.gold;
+		e.changed_columns[3] = e.silver != original.silver;
+		e.changed_columns[4] = e.copper != original.copper;
+		e.changed_columns[5] = e.platinum_bank != original.platinum_bank;
+		e.changed_columns[6] = e.gold_bank != original.gold_bank;
+		e.changed_columns[7] = e.silver_bank != original.silver_bank;
+		e.changed_columns[8] = e.copper_bank != original.copper_bank;
+		e.changed_columns[9] = e.platinum_cursor != original.platinum_cursor;
+		e.changed_columns[10] = e.gold_cursor != original.gold_cursor;
+		e.changed_columns[11] = e.silver_cursor != original.silver_cursor;
+		e.changed_columns[12] = e.copper_cursor != original.copper_cursor;
+		e.changed_columns[13] = e.radiant_crystals != original.radiant_crystals;
+		e.changed_columns[14] = e.career_radiant_crystals != original.career_radiant_crystals;
+		e.changed_columns[15] = e.ebon_crystals != original.ebon_crystals;
+		e.changed_columns[16] = e.career_ebon_crystals != original.career_ebon_crystals;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterCurrency &e
@@ -229,23 +259,27 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.platinum));
-		v.push_back(columns[2] + " = " + std::to_string(e.gold));
-		v.push_back(columns[3] + " = " + std::to_string(e.silver));
-		v.push_back(columns[4] + " = " + std::to_string(e.copper));
-		v.push_back(columns[5] + " = " + std::to_string(e.platinum_bank));
-		v.push_back(columns[6] + " = " + std::to_string(e.gold_bank));
-		v.push_back(columns[7] + " = " + std::to_string(e.silver_bank));
-		v.push_back(columns[8] + " = " + std::to_string(e.copper_bank));
-		v.push_back(columns[9] + " = " + std::to_string(e.platinum_cursor));
-		v.push_back(columns[10] + " = " + std::to_string(e.gold_cursor));
-		v.push_back(columns[11] + " = " + std::to_string(e.silver_cursor));
-		v.push_back(columns[12] + " = " + std::to_string(e.copper_cursor));
-		v.push_back(columns[13] + " = " + std::to_string(e.radiant_crystals));
-		v.push_back(columns[14] + " = " + std::to_string(e.career_radiant_crystals));
-		v.push_back(columns[15] + " = " + std::to_string(e.ebon_crystals));
-		v.push_back(columns[16] + " = " + std::to_string(e.career_ebon_crystals));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.platinum)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.gold)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.silver)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.copper)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.platinum_bank)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.gold_bank)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.silver_bank)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.copper_bank)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.platinum_cursor)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.gold_cursor)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.silver_cursor)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.copper_cursor)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.radiant_crystals)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.career_radiant_crystals)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.ebon_crystals)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.career_ebon_crystals)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -428,6 +462,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterCurrency FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterCurrency e{};
+
+		e.id                      = row.Get<uint32_t>(0).value_or(0);
+		e.platinum                = row.Get<uint32_t>(1).value_or(0);
+		e.gold                    = row.Get<uint32_t>(2).value_or(0);
+		e.silver                  = row.Get<uint32_t>(3).value_or(0);
+		e.copper                  = row.Get<uint32_t>(4).value_or(0);
+		e.platinum_bank           = row.Get<uint32_t>(5).value_or(0);
+		e.gold_bank               = row.Get<uint32_t>(6).value_or(0);
+		e.silver_bank             = row.Get<uint32_t>(7).value_or(0);
+		e.copper_bank             = row.Get<uint32_t>(8).value_or(0);
+		e.platinum_cursor         = row.Get<uint32_t>(9).value_or(0);
+		e.gold_cursor             = row.Get<uint32_t>(10).value_or(0);
+		e.silver_cursor           = row.Get<uint32_t>(11).value_or(0);
+		e.copper_cursor           = row.Get<uint32_t>(12).value_or(0);
+		e.radiant_crystals        = row.Get<uint32_t>(13).value_or(0);
+		e.career_radiant_crystals = row.Get<uint32_t>(14).value_or(0);
+		e.ebon_crystals           = row.Get<uint32_t>(15).value_or(0);
+		e.career_ebon_crystals    = row.Get<uint32_t>(16).value_or(0);
+
+		return e;
+	}
+
+	static CharacterCurrency FindOnePrepared(
+		Database& db,
+		int character_currency_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_currency_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterCurrency> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterCurrency> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -531,7 +631,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -555,13 +663,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
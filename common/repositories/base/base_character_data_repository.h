@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterDataRepository {
@@ -124,6 +126,9 @@ public:
 		uint32_t    e_last_invsnapshot;
 		time_t      deleted_at;
 		uint8_t     illusion_block;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<105> changed_columns = std::bitset<105>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -660,6 +665,119 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterData &e,
+		const CharacterData &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.account_id != original.account_id;
+		e.changed_columns[2] = e.name != original.name;
+		e.changed_columns[3] = e.last_name != original.last_name;
+		e.changed_columns[4] = e.title != original.title;
+		e.changed_columns[5] = e.suffix != original.suffix;
+		e.changed_columns[6] = e.zone_id != original.zone_id;
+		e.changed_columns[7] = e.zone_instance != original.zone_instance;
+		e.changed_columns[8] = e.y != original.y;
+		e.changed_columns[9] = e.x != original.x;
+		e.changed_columns[10] = e.z != original.z;
+		e.changed_columns[11] = e.heading != original.heading;
+		e.changed_columns[12] = e.gender != original.gender;
+		e.changed_columns[13] = e.race != original.race;
+		e.changed_columns[14] = e.class_ != original.class_;
+		e.changed_columns[15] = e.level != original.level;
+		e.changed_columns[16] = e.deity != original.deity;
+		e.changed_columns[17] = e.birthday != original.birthday;
+		e.changed_columns[18] = e.last_login != original.last_login;
+		e.changed_columns[19] = e.time_played != original.time_played;
+		e.changed_columns[20] = e.level2 != original.level2;
+		e.changed_columns[21] = e.anon != original.anon;
+		e.changed_columns[22] = e.gm != original.gm;
+		e.changed_columns[23] = e.face != original.face;
+		e.changed_columns[24] = e.hair_color != original.hair_color;
+		e.changed_columns[25] = e.hair_style != original.hair_style;
+		e.changed_columns[26] = e.beard != original.beard;
+		e.changed_columns[27] = e.beard_color != original.beard_color;
+		e.changed_columns[28] = e.eye_color_1 != original.eye_color_1;
+		e.changed_columns[29] = e.eye_color_2 != original.eye_color_2;
+		e.changed_columns[30] = e.drakkin_heritage != original.drakkin_heritage;
+		e.changed_columns[31] = e.drakkin_tattoo != original.drakkin_tattoo;
+		e.changed_columns[32] = e.drakkin_details != original.drakkin_details;
+		e.changed_columns[33] = e.ability_time_seconds != original.ability_time_seconds;
+		e.changed_columns[34] = e.ability_number != original.ability_number;
+		e.changed_columns[35] = e.ability_time_minutes != original.ability_time_minutes;
+		e.changed_columns[36] = e.ability_time_hours != original.ability_time_hours;
+		e.changed_columns[37] = e.exp != original.exp;
+		e.changed_columns[38] = e.exp_enabled != original.exp_enabled;
+		e.changed_columns[39] = e.aa_points_spent != original.aa_points_spent;
+		e.changed_columns[40] = e.aa_exp != original.aa_exp;
+		e.changed_columns[41] = e.aa_points != original.aa_points;
+		e.changed_columns[42] = e.group_leadership_exp != original.group_leadership_exp;
+		e.changed_columns[43] = e.raid_leadership_exp != original.raid_leadership_exp;
+		e.changed_columns[44] = e.group_leadership_points != original.group_leadership_points;
+		e.changed_columns[45] = e.raid_leadership_points != original.raid_leadership_points;
+		e.changed_columns[46] = e.points != original.points;
+		e.changed_columns[47] = e.cur_hp != original.cur_hp;
+		e.changed_columns[48] = e.mana != original.mana;
+		e.changed_columns[49] = e.endurance != original.endurance;
+		e.changed_columns[50] = e.intoxication != original.intoxication;
+		e.changed_columns[51] = e.str != original.str;
+		e.changed_columns[52] = e.sta != original.sta;
+		e.changed_columns[53] = e.cha != original.cha;
+		e.changed_columns[54] = e.dex != original.dex;
+		e.changed_columns[55] = e.int_ != original.int_;
+		e.changed_columns[56] = e.agi != original.agi;
+		e.changed_columns[57] = e.wis != original.wis;
+		e.changed_columns[58] = e.extra_haste != original.extra_haste;
+		e.changed_columns[59] = e.zone_change_count != original.zone_change_count;
+		e.changed_columns[60] = e.toxicity != original.toxicity;
+		e.changed_columns[61] = e.hunger_level != original.hunger_level;
+		e.changed_columns[62] = e.thirst_level != original.thirst_level;
+		e.changed_columns[63] = e.ability_up != original.ability_up;
+		e.changed_columns[64] = e.ldon_points_guk != original.ldon_points_guk;
+		e.changed_columns[65] = e.ldon_points_mir != original.ldon_points_mir;
+		e.changed_columns[66] = e.ldon_points_mmc != original.ldon_points_mmc;
+		e.changed_columns[67] = e.ldon_points_ruj != original.ldon_points_ruj;
+		e.changed_columns[68] = e.ldon_points_tak != original.ldon_points_tak;
+		e.changed_columns[69] = e.ldon_points_available != original.ldon_points_available;
+		e.changed_columns[70] = e.tribute_time_remaining != original.tribute_time_remaining;
+		e.changed_columns[71] = e.career_tribute_points != original.career_tribute_points;
+		e.changed_columns[72] = e.tribute_points != original.tribute_points;
+		e.changed_columns[73] = e.tribute_active != original.tribute_active;
+		e.changed_columns[74] = e.pvp_status != original.pvp_status;
+		e.changed_columns[75] = e.pvp_kills != original.pvp_kills;
+		e.changed_columns[76] = e.pvp_deaths != original.pvp_deaths;
+		e.changed_columns[77] = e.pvp_current_points != original.pvp_current_points;
+		e.changed_columns[78] = e.pvp_career_points != original.pvp_career_points;
+		e.changed_columns[79] = e.pvp_best_kill_streak != original.pvp_best_kill_streak;
+		e.changed_columns[80] = e.pvp_worst_death_streak != original.pvp_worst_death_streak;
+		e.changed_columns[81] = e.pvp_current_kill_streak != original.pvp_current_kill_streak;
+		e.changed_columns[82] = e.pvp2 != original.pvp2;
+		e.changed_columns[83] = e.pvp_type != original.pvp_type;
+		e.changed_columns[84] = e.show_helm != original.show_helm;
+		e.changed_columns[85] = e.group_auto_consent != original.group_auto_consent;
+		e.changed_columns[86] = e.raid_auto_consent != original.raid_auto_consent;
+		e.changed_columns[87] = e.guild_auto_consent != original.guild_auto_consent;
+		e.changed_columns[88] = e.leadership_exp_on != original.leadership_exp_on;
+		e.changed_columns[89] = e.RestTimer != original.RestTimer;
+		e.changed_columns[90] = e.air_remaining != original.air_remaining;
+		e.changed_columns[91] = e.autosplit_enabled != original.autosplit_enabled;
+		e.changed_columns[92] = e.lfp != original.lfp;
+		e.changed_columns[93] = e.lfg != original.lfg;
+		e.changed_columns[94] = e.mailkey != original.mailkey;
+		e.changed_columns[95] = e.xtargets != original.xtargets;
+		e.changed_columns[96] = e.firstlogon != original.firstlogon;
+		e.changed_columns[97] = e.e_aa_effects != original.e_aa_effects;
+		e.changed_columns[98] = e.e_percent_to_aa != original.e_percent_to_aa;
+		e.changed_columns[99] = e.e_expended_aa_spent != original.e_expended_aa_spent;
+		e.changed_columns[100] = e.aa_points_spent_old != original.aa_points_spent_old;
+		e.changed_columns[101] = e.aa_points_old != original.aa_points_old;
+		e.changed_columns[102] = e.e_last_invsnapshot != original.e_last_invsnapshot;
+		e.changed_columns[103] = e.deleted_at != original.deleted_at;
+		e.changed_columns[104] = e.illusion_block != original.illusion_block;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterData &e
@@ -669,110 +787,114 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.last_name) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.title) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.suffix) + "'");
-		v.push_back(columns[6] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.zone_instance));
-		v.push_back(columns[8] + " = " + std::to_string(e.y));
-		v.push_back(columns[9] + " = " + std::to_string(e.x));
-		v.push_back(columns[10] + " = " + std::to_string(e.z));
-		v.push_back(columns[11] + " = " + std::to_string(e.heading));
-		v.push_back(columns[12] + " = " + std::to_string(e.gender));
-		v.push_back(columns[13] + " = " + std::to_string(e.race));
-		v.push_back(columns[14] + " = " + std::to_string(e.class_));
-		v.push_back(columns[15] + " = " + std::to_string(e.level));
-		v.push_back(columns[16] + " = " + std::to_string(e.deity));
-		v.push_back(columns[17] + " = " + std::to_string(e.birthday));
-		v.push_back(columns[18] + " = " + std::to_string(e.last_login));
-		v.push_back(columns[19] + " = " + std::to_string(e.time_played));
-		v.push_back(columns[20] + " = " + std::to_string(e.level2));
-		v.push_back(columns[21] + " = " + std::to_string(e.anon));
-		v.push_back(columns[22] + " = " + std::to_string(e.gm));
-		v.push_back(columns[23] + " = " + std::to_string(e.face));
-		v.push_back(columns[24] + " = " + std::to_string(e.hair_color));
-		v.push_back(columns[25] + " = " + std::to_string(e.hair_style));
-		v.push_back(columns[26] + " = " + std::to_string(e.beard));
-		v.push_back(columns[27] + " = " + std::to_string(e.beard_color));
-		v.push_back(columns[28] + " = " + std::to_string(e.eye_color_1));
-		v.push_back(columns[29] + " = " + std::to_string(e.eye_color_2));
-		v.push_back(columns[30] + " = " + std::to_string(e.drakkin_heritage));
-		v.push_back(columns[31] + " = " + std::to_string(e.drakkin_tattoo));
-		v.push_back(columns[32] + " = " + std::to_string(e.drakkin_details));
-		v.push_back(columns[33] + " = " + std::to_string(e.ability_time_seconds));
-		v.push_back(columns[34] + " = " + std::to_string(e.ability_number));
-		v.push_back(columns[35] + " = " + std::to_string(e.ability_time_minutes));
-		v.push_back(columns[36] + " = " + std::to_string(e.ability_time_hours));
-		v.push_back(columns[37] + " = " + std::to_string(e.exp));
-		v.push_back(columns[38] + " = " + std::to_string(e.exp_enabled));
-		v.push_back(columns[39] + " = " + std::to_string(e.aa_points_spent));
-		v.push_back(columns[40] + " = " + std::to_string(e.aa_exp));
-		v.push_back(columns[41] + " = " + std::to_string(e.aa_points));
-		v.push_back(columns[42] + " = " + std::to_string(e.group_leadership_exp));
-		v.push_back(columns[43] + " = " + std::to_string(e.raid_leadership_exp));
-		v.push_back(columns[44] + " = " + std::to_string(e.group_leadership_points));
-		v.push_back(columns[45] + " = " + std::to_string(e.raid_leadership_points));
-		v.push_back(columns[46] + " = " + std::to_string(e.points));
-		v.push_back(columns[47] + " = " + std::to_string(e.cur_hp));
-		v.push_back(columns[48] + " = " + std::to_string(e.mana));
-		v.push_back(columns[49] + " = " + std::to_string(e.endurance));
-		v.push_back(columns[50] + " = " + std::to_string(e.intoxication));
-		v.push_back(columns[51] + " = " + std::to_string(e.str));
-		v.push_back(columns[52] + " = " + std::to_string(e.sta));
-		v.push_back(columns[53] + " = " + std::to_string(e.cha));
-		v.push_back(columns[54] + " = " + std::to_string(e.dex));
-		v.push_back(columns[55] + " = " + std::to_string(e.int_));
-		v.push_back(columns[56] + " = " + std::to_string(e.agi));
-		v.push_back(columns[57] + " = " + std::to_string(e.wis));
-		v.push_back(columns[58] + " = " + std::to_string(e.extra_haste));
-		v.push_back(columns[59] + " = " + std::to_string(e.zone_change_count));
-		v.push_back(columns[60] + " = " + std::to_string(e.toxicity));
-		v.push_back(columns[61] + " = " + std::to_string(e.hunger_level));
-		v.push_back(columns[62] + " = " + std::to_string(e.thirst_level));
-		v.push_back(columns[63] + " = " + std::to_string(e.ability_up));
-		v.push_back(columns[64] + " = " + std::to_string(e.ldon_points_guk));
-		v.push_back(columns[65] + " = " + std::to_string(e.ldon_points_mir));
-		v.push_back(columns[66] + " = " + std::to_string(e.ldon_points_mmc));
-		v.push_back(columns[67] + " = " + std::to_string(e.ldon_points_ruj));
-		v.push_back(columns[68] + " = " + std::to_string(e.ldon_points_tak));
-		v.push_back(columns[69] + " = " + std::to_string(e.ldon_points_available));
-		v.push_back(columns[70] + " = " + std::to_string(e.tribute_time_remaining));
-		v.push_back(columns[71] + " = " + std::to_string(e.career_tribute_points));
-		v.push_back(columns[72] + " = " + std::to_string(e.tribute_points));
-		v.push_back(columns[73] + " = " + std::to_string(e.tribute_active));
-		v.push_back(columns[74] + " = " + std::to_string(e.pvp_status));
-		v.push_back(columns[75] + " = " + std::to_string(e.pvp_kills));
-		v.push_back(columns[76] + " = " + std::to_string(e.pvp_deaths));
-		v.push_back(columns[77] + " = " + std::to_string(e.pvp_current_points));
-		v.push_back(columns[78] + " = " + std::to_string(e.pvp_career_points));
-		v.push_back(columns[79] + " = " + std::to_string(e.pvp_best_kill_streak));
-		v.push_back(columns[80] + " = " + std::to_string(e.pvp_worst_death_streak));
-		v.push_back(columns[81] + " = " + std::to_string(e.pvp_current_kill_streak));
-		v.push_back(columns[82] + " = " + std::to_string(e.pvp2));
-		v.push_back(columns[83] + " = " + std::to_string(e.pvp_type));
-		v.push_back(columns[84] + " = " + std::to_string(e.show_helm));
-		v.push_back(columns[85] + " = " + std::to_string(e.group_auto_consent));
-		v.push_back(columns[86] + " = " + std::to_string(e.raid_auto_consent));
-		v.push_back(columns[87] + " = " + std::to_string(e.guild_auto_consent));
-		v.push_back(columns[88] + " = " + std::to_string(e.leadership_exp_on));
-		v.push_back(columns[89] + " = " + std::to_string(e.RestTimer));
-		v.push_back(columns[90] + " = " + std::to_string(e.air_remaining));
-		v.push_back(columns[91] + " = " + std::to_string(e.autosplit_enabled));
-		v.push_back(columns[92] + " = " + std::to_string(e.lfp));
-		v.push_back(columns[93] + " = " + std::to_string(e.lfg));
-		v.push_back(columns[94] + " = '" + Strings::Escape(e.mailkey) + "'");
-		v.push_back(columns[95] + " = " + std::to_string(e.xtargets));
-		v.push_back(columns[96] + " = " + std::to_string(e.firstlogon));
-		v.push_back(columns[97] + " = " + std::to_string(e.e_aa_effects));
-		v.push_back(columns[98] + " = " + std::to_string(e.e_percent_to_aa));
-		v.push_back(columns[99] + " = " + std::to_string(e.e_expended_aa_spent));
-		v.push_back(columns[100] + " = " + std::to_string(e.aa_points_spent_old));
-		v.push_back(columns[101] + " = " + std::to_string(e.aa_points_old));
-		v.push_back(columns[102] + " = " + std::to_string(e.e_last_invsnapshot));
-		v.push_back(columns[103] + " = FROM_UNIXTIME(" + (e.deleted_at > 0 ? std::to_string(e.deleted_at) : "null") + ")");
-		v.push_back(columns[104] + " = " + std::to_string(e.illusion_block));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.last_name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.title) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.suffix) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.zone_instance)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.gender)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.deity)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.birthday)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.last_login)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.time_played)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.level2)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.anon)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.gm)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.face)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.hair_color)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.hair_style)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.beard)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.beard_color)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.eye_color_1)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.eye_color_2)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.drakkin_heritage)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.drakkin_tattoo)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.drakkin_details)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.ability_time_seconds)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.ability_number)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.ability_time_minutes)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.ability_time_hours)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.exp)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.exp_enabled)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.aa_points_spent)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.aa_exp)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.aa_points)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.group_leadership_exp)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.raid_leadership_exp)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.group_leadership_points)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.raid_leadership_points)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.points)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.cur_hp)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.endurance)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.intoxication)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.str)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.sta)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.cha)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.dex)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.int_)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.agi)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.wis)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = " + std::to_string(e.extra_haste)); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.zone_change_count)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.toxicity)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.hunger_level)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.thirst_level)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.ability_up)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.ldon_points_guk)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.ldon_points_mir)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.ldon_points_mmc)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.ldon_points_ruj)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.ldon_points_tak)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.ldon_points_available)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.tribute_time_remaining)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = " + std::to_string(e.career_tribute_points)); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = " + std::to_string(e.tribute_points)); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = " + std::to_string(e.tribute_active)); }
+		if (e.changed_columns[74]) { v.push_back(columns[74] + " = " + std::to_string(e.pvp_status)); }
+		if (e.changed_columns[75]) { v.push_back(columns[75] + " = " + std::to_string(e.pvp_kills)); }
+		if (e.changed_columns[76]) { v.push_back(columns[76] + " = " + std::to_string(e.pvp_deaths)); }
+		if (e.changed_columns[77]) { v.push_back(columns[77] + " = " + std::to_string(e.pvp_current_points)); }
+		if (e.changed_columns[78]) { v.push_back(columns[78] + " = " + std::to_string(e.pvp_career_points)); }
+		if (e.changed_columns[79]) { v.push_back(columns[79] + " = " + std::to_string(e.pvp_best_kill_streak)); }
+		if (e.changed_columns[80]) { v.push_back(columns[80] + " = " + std::to_string(e.pvp_worst_death_streak)); }
+		if (e.changed_columns[81]) { v.push_back(columns[81] + " = " + std::to_string(e.pvp_current_kill_streak)); }
+		if (e.changed_columns[82]) { v.push_back(columns[82] + " = " + std::to_string(e.pvp2)); }
+		if (e.changed_columns[83]) { v.push_back(columns[83] + " = " + std::to_string(e.pvp_type)); }
+		if (e.changed_columns[84]) { v.push_back(columns[84] + " = " + std::to_string(e.show_helm)); }
+		if (e.changed_columns[85]) { v.push_back(columns[85] + " = " + std::to_string(e.group_auto_consent)); }
+		if (e.changed_columns[86]) { v.push_back(columns[86] + " = " + std::to_string(e.raid_auto_consent)); }
+		if (e.changed_columns[87]) { v.push_back(columns[87] + " = " + std::to_string(e.guild_auto_consent)); }
+		if (e.changed_columns[88]) { v.push_back(columns[88] + " = " + std::to_string(e.leadership_exp_on)); }
+		if (e.changed_columns[89]) { v.push_back(columns[89] + " = " + std::to_string(e.RestTimer)); }
+		if (e.changed_columns[90]) { v.push_back(columns[90] + " = " + std::to_string(e.air_remaining)); }
+		if (e.changed_columns[91]) { v.push_back(columns[91] + " = " + std::to_string(e.autosplit_enabled)); }
+		if (e.changed_columns[92]) { v.push_back(columns[92] + " = " + std::to_string(e.lfp)); }
+		if (e.changed_columns[93]) { v.push_back(columns[93] + " = " + std::to_string(e.lfg)); }
+		if (e.changed_columns[94]) { v.push_back(columns[94] + " = '" + Strings::Escape(e.mailkey) + "'"); }
+		if (e.changed_columns[95]) { v.push_back(columns[95] + " = " + std::to_string(e.xtargets)); }
+		if (e.changed_columns[96]) { v.push_back(columns[96] + " = " + std::to_string(e.firstlogon)); }
+		if (e.changed_columns[97]) { v.push_back(columns[97] + " = " + std::to_string(e.e_aa_effects)); }
+		if (e.changed_columns[98]) { v.push_back(columns[98] + " = " + std::to_string(e.e_percent_to_aa)); }
+		if (e.changed_columns[99]) { v.push_back(columns[99] + " = " + std::to_string(e.e_expended_aa_spent)); }
+		if (e.changed_columns[100]) { v.push_back(columns[100] + " = " + std::to_string(e.aa_points_spent_old)); }
+		if (e.changed_columns[101]) { v.push_back(columns[101] + " = " + std::to_string(e.aa_points_old)); }
+		if (e.changed_columns[102]) { v.push_back(columns[102] + " = " + std::to_string(e.e_last_invsnapshot)); }
+		if (e.changed_columns[103]) { v.push_back(columns[103] + " = FROM_UNIXTIME(" + (e.deleted_at > 0 ? std::to_string(e.deleted_at) : "null") + ")"); }
+		if (e.changed_columns[104]) { v.push_back(columns[104] + " = " + std::to_string(e.illusion_block)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -1307,6 +1429,160 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterData FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterData e{};
+
+		e.id                      = row.Get<uint32_t>(0).value_or(0);
+		e.account_id              = row.Get<int32_t>(1).value_or(0);
+		e.name                    = row.GetStr(2).value_or("");
+		e.last_name               = row.GetStr(3).value_or("");
+		e.title                   = row.GetStr(4).value_or("");
+		e.suffix                  = row.GetStr(5).value_or("");
+		e.zone_id                 = row.Get<uint32_t>(6).value_or(0);
+		e.zone_instance           = row.Get<uint32_t>(7).value_or(0);
+		e.y                       = row.Get<float>(8).value_or(0);
+		e.x                       = row.Get<float>(9).value_or(0);
+		e.z                       = row.Get<float>(10).value_or(0);
+		e.heading                 = row.Get<float>(11).value_or(0);
+		e.gender                  = row.Get<uint8_t>(12).value_or(0);
+		e.race                    = row.Get<uint16_t>(13).value_or(0);
+		e.class_                  = row.Get<uint8_t>(14).value_or(0);
+		e.level                   = row.Get<uint32_t>(15).value_or(0);
+		e.deity                   = row.Get<uint32_t>(16).value_or(0);
+		e.birthday                = row.Get<uint32_t>(17).value_or(0);
+		e.last_login              = row.Get<uint32_t>(18).value_or(0);
+		e.time_played             = row.Get<uint32_t>(19).value_or(0);
+		e.level2                  = row.Get<uint8_t>(20).value_or(0);
+		e.anon                    = row.Get<uint8_t>(21).value_or(0);
+		e.gm                      = row.Get<uint8_t>(22).value_or(0);
+		e.face                    = row.Get<uint32_t>(23).value_or(0);
+		e.hair_color              = row.Get<uint8_t>(24).value_or(0);
+		e.hair_style              = row.Get<uint8_t>(25).value_or(0);
+		e.beard                   = row.Get<uint8_t>(26).value_or(0);
+		e.beard_color             = row.Get<uint8_t>(27).value_or(0);
+		e.eye_color_1             = row.Get<uint8_t>(28).value_or(0);
+		e.eye_color_2             = row.Get<uint8_t>(29).value_or(0);
+		e.drakkin_heritage        = row.Get<uint32_t>(30).value_or(0);
+		e.drakkin_tattoo          = row.Get<uint32_t>(31).value_or(0);
+		e.drakkin_details         = row.Get<uint32_t>(32).value_or(0);
+		e.ability_time_seconds    = row.Get<uint8_t>(33).value_or(0);
+		e.ability_number          = row.Get<uint8_t>(34).value_or(0);
+		e.ability_time_minutes    = row.Get<uint8_t>(35).value_or(0);
+		e.ability_time_hours      = row.Get<uint8_t>(36).value_or(0);
+		e.exp                     = row.Get<uint32_t>(37).value_or(0);
+		e.exp_enabled             = row.Get<uint8_t>(38).value_or(1);
+		e.aa_points_spent         = row.Get<uint32_t>(39).value_or(0);
+		e.aa_exp                  = row.Get<uint32_t>(40).value_or(0);
+		e.aa_points               = row.Get<uint32_t>(41).value_or(0);
+		e.group_leadership_exp    = row.Get<uint32_t>(42).value_or(0);
+		e.raid_leadership_exp     = row.Get<uint32_t>(43).value_or(0);
+		e.group_leadership_points = row.Get<uint32_t>(44).value_or(0);
+		e.raid_leadership_points  = row.Get<uint32_t>(45).value_or(0);
+		e.points                  = row.Get<uint32_t>(46).value_or(0);
+		e.cur_hp                  = row.Get<uint32_t>(47).value_or(0);
+		e.mana                    = row.Get<uint32_t>(48).value_or(0);
+		e.endurance               = row.Get<uint32_t>(49).value_or(0);
+		e.intoxication            = row.Get<uint32_t>(50).value_or(0);
+		e.str                     = row.Get<uint32_t>(51).value_or(0);
+		e.sta                     = row.Get<uint32_t>(52).value_or(0);
+		e.cha                     = row.Get<uint32_t>(53).value_or(0);
+		e.dex                     = row.Get<uint32_t>(54).value_or(0);
+		e.int_                    = row.Get<uint32_t>(55).value_or(0);
+		e.agi                     = row.Get<uint32_t>(56).value_or(0);
+		e.wis                     = row.Get<uint32_t>(57).value_or(0);
+		e.extra_haste             = row.Get<int32_t>(58).value_or(0);
+		e.zone_change_count       = row.Get<uint32_t>(59).value_or(0);
+		e.toxicity                = row.Get<uint32_t>(60).value_or(0);
+		e.hunger_level            = row.Get<uint32_t>(61).value_or(0);
+		e.thirst_level            = row.Get<uint32_t>(62).value_or(0);
+		e.ability_up              = row.Get<uint32_t>(63).value_or(0);
+		e.ldon_points_guk         = row.Get<uint32_t>(64).value_or(0);
+		e.ldon_points_mir         = row.Get<uint32_t>(65).value_or(0);
+		e.ldon_points_mmc         = row.Get<uint32_t>(66).value_or(0);
+		e.ldon_points_ruj         = row.Get<uint32_t>(67).value_or(0);
+		e.ldon_points_tak         = row.Get<uint32_t>(68).value_or(0);
+		e.ldon_points_available   = row.Get<uint32_t>(69).value_or(0);
+		e.tribute_time_remaining  = row.Get<uint32_t>(70).value_or(0);
+		e.career_tribute_points   = row.Get<uint32_t>(71).value_or(0);
+		e.tribute_points          = row.Get<uint32_t>(72).value_or(0);
+		e.tribute_active          = row.Get<uint32_t>(73).value_or(0);
+		e.pvp_status              = row.Get<uint8_t>(74).value_or(0);
+		e.pvp_kills               = row.Get<uint32_t>(75).value_or(0);
+		e.pvp_deaths              = row.Get<uint32_t>(76).value_or(0);
+		e.pvp_current_points      = row.Get<uint32_t>(77).value_or(0);
+		e.pvp_career_points       = row.Get<uint32_t>(78).value_or(0);
+		e.pvp_best_kill_streak    = row.Get<uint32_t>(79).value_or(0);
+		e.pvp_worst_death_streak  = row.Get<uint32_t>(80).value_or(0);
+		e.pvp_current_kill_streak = row.Get<uint32_t>(81).value_or(0);
+		e.pvp2                    = row.Get<uint32_t>(82).value_or(0);
+		e.pvp_type                = row.Get<uint32_t>(83).value_or(0);
+		e.show_helm               = row.Get<uint32_t>(84).value_or(0);
+		e.group_auto_consent      = row.Get<uint8_t>(85).value_or(0);
+		e.raid_auto_consent       = row.Get<uint8_t>(86).value_or(0);
+		e.guild_auto_consent      = row.Get<uint8_t>(87).value_or(0);
+		e.leadership_exp_on       = row.Get<uint8_t>(88).value_or(0);
+		e.RestTimer               = row.Get<uint32_t>(89).value_or(0);
+		e.air_remaining           = row.Get<uint32_t>(90).value_or(0);
+		e.autosplit_enabled       = row.Get<uint32_t>(91).value_or(0);
+		e.lfp                     = row.Get<uint8_t>(92).value_or(0);
+		e.lfg                     = row.Get<uint8_t>(93).value_or(0);
+		e.mailkey                 = row.GetStr(94).value_or("");
+		e.xtargets                = row.Get<uint8_t>(95).value_or(5);
+		e.firstlogon              = row.Get<int8_t>(96).value_or(0);
+		e.e_aa_effects            = row.Get<uint32_t>(97).value_or(0);
+		e.e_percent_to_aa         = row.Get<uint32_t>(98).value_or(0);
+		e.e_expended_aa_spent     = row.Get<uint32_t>(99).value_or(0);
+		e.aa_points_spent_old     = row.Get<uint32_t>(100).value_or(0);
+		e.aa_points_old           = row.Get<uint32_t>(101).value_or(0);
+		e.e_last_invsnapshot      = row.Get<uint32_t>(102).value_or(0);
+		e.deleted_at              = row.Get<int64_t>(103).value_or(-1);
+		e.illusion_block          = row.Get<uint8_t>(104).value_or(0);
+
+		return e;
+	}
+
+	static CharacterData FindOnePrepared(
+		Database& db,
+		int character_data_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_data_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterData> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterData> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -1498,7 +1774,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<105> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -1610,13 +1894,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterMaterialRepository {
@@ -26,6 +28,9 @@ public:
 		uint8_t  red;
 		uint8_t  use_tint;
 		uint32_t color;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -170,6 +175,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterMaterial &e,
+		const CharacterMaterial &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.slot != original.slot;
+		e.changed_columns[2] = e.blue != original.blue;
+		e.changed_columns[3] = e.green != original.green;
+		e.changed_columns[4] = e.red != original.red;
+		e.changed_columns[5] = e.use_tint != original.use_tint;
+		e.changed_columns[6] = e.color != original.color;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterMaterial &e
@@ -179,12 +199,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.slot));
-		v.push_back(columns[2] + " = " + std::to_string(e.blue));
-		v.push_back(columns[3] + " = " + std::to_string(e.green));
-		v.push_back(columns[4] + " = " + std::to_string(e.red));
-		v.push_back(columns[5] + " = " + std::to_string(e.use_tint));
-		v.push_back(columns[6] + " = " + std::to_string(e.color));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.slot)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.blue)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.green)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.red)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.use_tint)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.color)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -327,6 +351,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterMaterial FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterMaterial e{};
+
+		e.id       = row.Get<uint32_t>(0).value_or(0);
+		e.slot     = row.Get<uint8_t>(1).value_or(0);
+		e.blue     = row.Get<uint8_t>(2).value_or(0);
+		e.green    = row.Get<uint8_t>(3).value_or(0);
+		e.red      = row.Get<uint8_t>(4).value_or(0);
+		e.use_tint = row.Get<uint8_t>(5).value_or(0);
+		e.color    = row.Get<uint32_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static CharacterMaterial FindOnePrepared(
+		Database& db,
+		int character_material_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_material_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterMaterial> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterMaterial> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -420,7 +500,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -434,13 +522,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
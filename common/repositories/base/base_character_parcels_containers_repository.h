@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterParcelsContainersRepository {
@@ -30,6 +32,9 @@ public:
 		uint32_t aug_slot_5;
 		uint32_t aug_slot_6;
 		uint32_t quantity;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<11> changed_columns = std::bitset<11>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -190,6 +195,25 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterParcelsContainers &e,
+		const CharacterParcelsContainers &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.parcels_id != original.parcels_id;
+		e.changed_columns[2] = e.slot_id != original.slot_id;
+		e.changed_columns[3] = e.item_id != original.item_id;
+		e.changed_columns[4] = e.aug_slot_1 != original.aug_slot_1;
+		e.changed_columns[5] = e.aug_slot_2 != original.aug_slot_2;
+		e.changed_columns[6] = e.aug_slot_3 != original.aug_slot_3;
+		e.changed_columns[7] = e.aug_slot_4 != original.aug_slot_4;
+		e.changed_columns[8] = e.aug_slot_5 != original.aug_slot_5;
+		e.changed_columns[9] = e.aug_slot_6 != original.aug_slot_6;
+		e.changed_columns[10] = e.quantity != original.quantity;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterParcelsContainers &e
@@ -199,16 +223,20 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.parcels_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_1));
-		v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_2));
-		v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_3));
-		v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_4));
-		v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_5));
-		v.push_back(columns[9] + " = " + std::to_string(e.aug_slot_6));
-		v.push_back(columns[10] + " = " + std::to_string(e.quantity));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.parcels_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_1)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_2)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_3)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_4)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_5)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.aug_slot_6)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.quantity)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -367,6 +395,66 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterParcelsContainers FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterParcelsContainers e{};
+
+		e.id         = row.Get<uint32_t>(0).value_or(0);
+		e.parcels_id = row.Get<uint32_t>(1).value_or(0);
+		e.slot_id    = row.Get<uint32_t>(2).value_or(0);
+		e.item_id    = row.Get<uint32_t>(3).value_or(0);
+		e.aug_slot_1 = row.Get<uint32_t>(4).value_or(0);
+		e.aug_slot_2 = row.Get<uint32_t>(5).value_or(0);
+		e.aug_slot_3 = row.Get<uint32_t>(6).value_or(0);
+		e.aug_slot_4 = row.Get<uint32_t>(7).value_or(0);
+		e.aug_slot_5 = row.Get<uint32_t>(8).value_or(0);
+		e.aug_slot_6 = row.Get<uint32_t>(9).value_or(0);
+		e.quantity   = row.Get<uint32_t>(10).value_or(0);
+
+		return e;
+	}
+
+	static CharacterParcelsContainers FindOnePrepared(
+		Database& db,
+		int character_parcels_containers_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_parcels_containers_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterParcelsContainers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterParcelsContainers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -464,7 +552,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<11> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -482,13 +578,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterParcelsRepository {
@@ -33,6 +35,9 @@ public:
 		std::string from_name;
 		std::string note;
 		time_t      sent_date;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<14> changed_columns = std::bitset<14>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -205,6 +210,28 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterParcels &e,
+		const CharacterParcels &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.char_id != original.char_id;
+		e.changed_columns[2] = e.item_id != original.item_id;
+		e.changed_columns[3] = e.aug_slot_1 != original.aug_slot_1;
+		e.changed_columns[4] = e.aug_slot_2 != original.aug_slot_2;
+		e.changed_columns[5] = e.aug_slot_3 != original.aug_slot_3;
+		e.changed_columns[6] = e.aug_slot_4 != original.aug_slot_4;
+		e.changed_columns[7] = e.aug_slot_5 != original.aug_slot_5;
+		e.changed_columns[8] = e.aug_slot_6 != original.aug_slot_6;
+		e.changed_columns[9] = e.slot_id != original.slot_id;
+		e.changed_columns[10] = e.quantity != original.quantity;
+		e.changed_columns[11] = e.from_name != original.from_name;
+		e.changed_columns[12] = e.note != original.note;
+		e.changed_columns[13] = e.sent_date != original.sent_date;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterParcels &e
@@ -214,19 +241,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.aug_slot_1));
-		v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_2));
-		v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_3));
-		v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_4));
-		v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_5));
-		v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_6));
-		v.push_back(columns[9] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.quantity));
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.from_name) + "'");
-		v.push_back(columns[12] + " = '" + Strings::Escape(e.note) + "'");
-		v.push_back(columns[13] + " = FROM_UNIXTIME(" + (e.sent_date > 0 ? std::to_string(e.sent_date) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.aug_slot_1)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_2)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_3)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_4)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_5)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_6)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.quantity)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.from_name) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = '" + Strings::Escape(e.note) + "'"); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = FROM_UNIXTIME(" + (e.sent_date > 0 ? std::to_string(e.sent_date) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -397,6 +428,69 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterParcels FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterParcels e{};
+
+		e.id         = row.Get<uint32_t>(0).value_or(0);
+		e.char_id    = row.Get<uint32_t>(1).value_or(0);
+		e.item_id    = row.Get<uint32_t>(2).value_or(0);
+		e.aug_slot_1 = row.Get<uint32_t>(3).value_or(0);
+		e.aug_slot_2 = row.Get<uint32_t>(4).value_or(0);
+		e.aug_slot_3 = row.Get<uint32_t>(5).value_or(0);
+		e.aug_slot_4 = row.Get<uint32_t>(6).value_or(0);
+		e.aug_slot_5 = row.Get<uint32_t>(7).value_or(0);
+		e.aug_slot_6 = row.Get<uint32_t>(8).value_or(0);
+		e.slot_id    = row.Get<uint32_t>(9).value_or(0);
+		e.quantity   = row.Get<uint32_t>(10).value_or(0);
+		e.from_name  = row.GetStr(11).value_or("");
+		e.note       = row.GetStr(12).value_or("");
+		e.sent_date  = row.Get<int64_t>(13).value_or(-1);
+
+		return e;
+	}
+
+	static CharacterParcels FindOnePrepared(
+		Database& db,
+		int character_parcels_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_parcels_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterParcels> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterParcels> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -497,7 +591,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<14> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -518,13 +620,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
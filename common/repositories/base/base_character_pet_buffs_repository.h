@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterPetBuffsRepository {
@@ -30,6 +32,9 @@ public:
 		int32_t     numhits;
 		int32_t     rune;
 		uint8_t     instrument_mod;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<11> changed_columns = std::bitset<11>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -190,6 +195,25 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterPetBuffs &e,
+		const CharacterPetBuffs &original
+	)
+	{
+		e.changed_columns[0] = e.char_id != original.char_id;
+		e.changed_columns[1] = e.pet != original.pet;
+		e.changed_columns[2] = e.slot != original.slot;
+		e.changed_columns[3] = e.spell_id != original.spell_id;
+		e.changed_columns[4] = e.caster_level != original.caster_level;
+		e.changed_columns[5] = e.castername != original.castername;
+		e.changed_columns[6] = e.ticsremaining != original.ticsremaining;
+		e.changed_columns[7] = e.counters != original.counters;
+		e.changed_columns[8] = e.numhits != original.numhits;
+		e.changed_columns[9] = e.rune != original.rune;
+		e.changed_columns[10] = e.instrument_mod != original.instrument_mod;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterPetBuffs &e
@@ -199,17 +223,21 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.pet));
-		v.push_back(columns[2] + " = " + std::to_string(e.slot));
-		v.push_back(columns[3] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.caster_level));
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.castername) + "'");
-		v.push_back(columns[6] + " = " + std::to_string(e.ticsremaining));
-		v.push_back(columns[7] + " = " + std::to_string(e.counters));
-		v.push_back(columns[8] + " = " + std::to_string(e.numhits));
-		v.push_back(columns[9] + " = " + std::to_string(e.rune));
-		v.push_back(columns[10] + " = " + std::to_string(e.instrument_mod));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.pet)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.slot)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.caster_level)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.castername) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.ticsremaining)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.counters)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.numhits)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.rune)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.instrument_mod)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -368,6 +396,66 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterPetBuffs FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterPetBuffs e{};
+
+		e.char_id        = row.Get<int32_t>(0).value_or(0);
+		e.pet            = row.Get<int32_t>(1).value_or(0);
+		e.slot           = row.Get<int32_t>(2).value_or(0);
+		e.spell_id       = row.Get<int32_t>(3).value_or(0);
+		e.caster_level   = row.Get<int8_t>(4).value_or(0);
+		e.castername     = row.GetStr(5).value_or("");
+		e.ticsremaining  = row.Get<int32_t>(6).value_or(0);
+		e.counters       = row.Get<int32_t>(7).value_or(0);
+		e.numhits        = row.Get<int32_t>(8).value_or(0);
+		e.rune           = row.Get<int32_t>(9).value_or(0);
+		e.instrument_mod = row.Get<uint8_t>(10).value_or(10);
+
+		return e;
+	}
+
+	static CharacterPetBuffs FindOnePrepared(
+		Database& db,
+		int character_pet_buffs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_pet_buffs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterPetBuffs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterPetBuffs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -465,7 +553,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<11> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.char_id));
@@ -483,13 +579,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
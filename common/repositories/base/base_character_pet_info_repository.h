@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterPetInfoRepository {
@@ -28,6 +30,9 @@ public:
 		int32_t     mana;
 		float       size;
 		int8_t      taunting;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterPetInfo &e,
+		const CharacterPetInfo &original
+	)
+	{
+		e.changed_columns[0] = e.char_id != original.char_id;
+		e.changed_columns[1] = e.pet != original.pet;
+		e.changed_columns[2] = e.petname != original.petname;
+		e.changed_columns[3] = e.petpower != original.petpower;
+		e.changed_columns[4] = e.spell_id != original.spell_id;
+		e.changed_columns[5] = e.hp != original.hp;
+		e.changed_columns[6] = e.mana != original.mana;
+		e.changed_columns[7] = e.size != original.size;
+		e.changed_columns[8] = e.taunting != original.taunting;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterPetInfo &e
@@ -189,15 +211,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.pet));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.petname) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.petpower));
-		v.push_back(columns[4] + " = " + std::to_string(e.spell_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.hp));
-		v.push_back(columns[6] + " = " + std::to_string(e.mana));
-		v.push_back(columns[7] + " = " + std::to_string(e.size));
-		v.push_back(columns[8] + " = " + std::to_string(e.taunting));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.pet)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.petname) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.petpower)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.spell_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.taunting)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -348,6 +374,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterPetInfo FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterPetInfo e{};
+
+		e.char_id  = row.Get<int32_t>(0).value_or(0);
+		e.pet      = row.Get<int32_t>(1).value_or(0);
+		e.petname  = row.GetStr(2).value_or("");
+		e.petpower = row.Get<int32_t>(3).value_or(0);
+		e.spell_id = row.Get<int32_t>(4).value_or(0);
+		e.hp       = row.Get<int32_t>(5).value_or(0);
+		e.mana     = row.Get<int32_t>(6).value_or(0);
+		e.size     = row.Get<float>(7).value_or(0);
+		e.taunting = row.Get<int8_t>(8).value_or(1);
+
+		return e;
+	}
+
+	static CharacterPetInfo FindOnePrepared(
+		Database& db,
+		int character_pet_info_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_pet_info_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterPetInfo> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterPetInfo> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -443,7 +527,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.char_id));
@@ -459,13 +551,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
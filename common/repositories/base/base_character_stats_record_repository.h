@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterStatsRecordRepository {
@@ -93,6 +95,9 @@ public:
 		int32_t     tinkering;
 		time_t      created_at;
 		time_t      updated_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<74> changed_columns = std::bitset<74>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -505,6 +510,88 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterStatsRecord &e,
+		const CharacterStatsRecord &original
+	)
+	{
+		e.changed_columns[0] = e.character_id != original.character_id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.status != original.status;
+		e.changed_columns[3] = e.level != original.level;
+		e.changed_columns[4] = e.class_ != original.class_;
+		e.changed_columns[5] = e.race != original.race;
+		e.changed_columns[6] = e.aa_points != original.aa_points;
+		e.changed_columns[7] = e.hp != original.hp;
+		e.changed_columns[8] = e.mana != original.mana;
+		e.changed_columns[9] = e.endurance != original.endurance;
+		e.changed_columns[10] = e.ac != original.ac;
+		e.changed_columns[11] = e.strength != original.strength;
+		e.changed_columns[12] = e.stamina != original.stamina;
+		e.changed_columns[13] = e.dexterity != original.dexterity;
+		e.changed_columns[14] = e.agility != original.agility;
+		e.changed_columns[15] = e.intelligence != original.intelligence;
+		e.changed_columns[16] = e.wisdom != original.wisdom;
+		e.changed_columns[17] = e.charisma != original.charisma;
+		e.changed_columns[18] = e.magic_resist != original.magic_resist;
+		e.changed_columns[19] = e.fire_resist != original.fire_resist;
+		e.changed_columns[20] = e.cold_resist != original.cold_resist;
+		e.changed_columns[21] = e.poison_resist != original.poison_resist;
+		e.changed_columns[22] = e.disease_resist != original.disease_resist;
+		e.changed_columns[23] = e.corruption_resist != original.corruption_resist;
+		e.changed_columns[24] = e.heroic_strength != original.heroic_strength;
+		e.changed_columns[25] = e.heroic_stamina != original.heroic_stamina;
+		e.changed_columns[26] = e.heroic_dexterity != original.heroic_dexterity;
+		e.changed_columns[27] = e.heroic_agility != original.heroic_agility;
+		e.changed_columns[28] = e.heroic_intelligence != original.heroic_intelligence;
+		e.changed_columns[29] = e.heroic_wisdom != original.heroic_wisdom;
+		e.changed_columns[30] = e.heroic_charisma != original.heroic_charisma;
+		e.changed_columns[31] = e.heroic_magic_resist != original.heroic_magic_resist;
+		e.changed_columns[32] = e.heroic_fire_resist != original.heroic_fire_resist;
+		e.changed_columns[33] = e.heroic_cold_resist != original.heroic_cold_resist;
+		e.changed_columns[34] = e.heroic_poison_resist != original.heroic_poison_resist;
+		e.changed_columns[35] = e.heroic_disease_resist != original.heroic_disease_resist;
+		e.changed_columns[36] = e.heroic_corruption_resist != original.heroic_corruption_resist;
+		e.changed_columns[37] = e.haste != original.haste;
+		e.changed_columns[38] = e.accuracy != original.accuracy;
+		e.changed_columns[39] = e.attack != original.attack;
+		e.changed_columns[40] = e.avoidance != original.avoidance;
+		e.changed_columns[41] = e.clairvoyance != original.clairvoyance;
+		e.changed_columns[42] = e.combat_effects != original.combat_effects;
+		e.changed_columns[43] = e.damage_shield_mitigation != original.damage_shield_mitigation;
+		e.changed_columns[44] = e.damage_shield != original.damage_shield;
+		e.changed_columns[45] = e.dot_shielding != original.dot_shielding;
+		e.changed_columns[46] = e.hp_regen != original.hp_regen;
+		e.changed_columns[47] = e.mana_regen != original.mana_regen;
+		e.changed_columns[48] = e.endurance_regen != original.endurance_regen;
+		e.changed_columns[49] = e.shielding != original.shielding;
+		e.changed_columns[50] = e.spell_damage != original.spell_damage;
+		e.changed_columns[51] = e.spell_shielding != original.spell_shielding;
+		e.changed_columns[52] = e.strikethrough != original.strikethrough;
+		e.changed_columns[53] = e.stun_resist != original.stun_resist;
+		e.changed_columns[54] = e.backstab != original.backstab;
+		e.changed_columns[55] = e.wind != original.wind;
+		e.changed_columns[56] = e.brass != original.brass;
+		e.changed_columns[57] = e.string != original.string;
+		e.changed_columns[58] = e.percussion != original.percussion;
+		e.changed_columns[59] = e.singing != original.singing;
+		e.changed_columns[60] = e.baking != original.baking;
+		e.changed_columns[61] = e.alchemy != original.alchemy;
+		e.changed_columns[62] = e.tailoring != original.tailoring;
+		e.changed_columns[63] = e.blacksmithing != original.blacksmithing;
+		e.changed_columns[64] = e.fletching != original.fletching;
+		e.changed_columns[65] = e.brewing != original.brewing;
+		e.changed_columns[66] = e.jewelry != original.jewelry;
+		e.changed_columns[67] = e.pottery != original.pottery;
+		e.changed_columns[68] = e.research != original.research;
+		e.changed_columns[69] = e.alcohol != original.alcohol;
+		e.changed_columns[70] = e.fishing != original.fishing;
+		e.changed_columns[71] = e.tinkering != original.tinkering;
+		e.changed_columns[72] = e.created_at != original.created_at;
+		e.changed_columns[73] = e.updated_at != original.updated_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterStatsRecord &e
@@ -514,80 +601,84 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.status));
-		v.push_back(columns[3] + " = " + std::to_string(e.level));
-		v.push_back(columns[4] + " = " + std::to_string(e.class_));
-		v.push_back(columns[5] + " = " + std::to_string(e.race));
-		v.push_back(columns[6] + " = " + std::to_string(e.aa_points));
-		v.push_back(columns[7] + " = " + std::to_string(e.hp));
-		v.push_back(columns[8] + " = " + std::to_string(e.mana));
-		v.push_back(columns[9] + " = " + std::to_string(e.endurance));
-		v.push_back(columns[10] + " = " + std::to_string(e.ac));
-		v.push_back(columns[11] + " = " + std::to_string(e.strength));
-		v.push_back(columns[12] + " = " + std::to_string(e.stamina));
-		v.push_back(columns[13] + " = " + std::to_string(e.dexterity));
-		v.push_back(columns[14] + " = " + std::to_string(e.agility));
-		v.push_back(columns[15] + " = " + std::to_string(e.intelligence));
-		v.push_back(columns[16] + " = " + std::to_string(e.wisdom));
-		v.push_back(columns[17] + " = " + std::to_string(e.charisma));
-		v.push_back(columns[18] + " = " + std::to_string(e.magic_resist));
-		v.push_back(columns[19] + " = " + std::to_string(e.fire_resist));
-		v.push_back(columns[20] + " = " + std::to_string(e.cold_resist));
-		v.push_back(columns[21] + " = " + std::to_string(e.poison_resist));
-		v.push_back(columns[22] + " = " + std::to_string(e.disease_resist));
-		v.push_back(columns[23] + " = " + std::to_string(e.corruption_resist));
-		v.push_back(columns[24] + " = " + std::to_string(e.heroic_strength));
-		v.push_back(columns[25] + " = " + std::to_string(e.heroic_stamina));
-		v.push_back(columns[26] + " = " + std::to_string(e.heroic_dexterity));
-		v.push_back(columns[27] + " = " + std::to_string(e.heroic_agility));
-		v.push_back(columns[28] + " = " + std::to_string(e.heroic_intelligence));
-		v.push_back(columns[29] + " = " + std::to_string(e.heroic_wisdom));
-		v.push_back(columns[30] + " = " + std::to_string(e.heroic_charisma));
-		v.push_back(columns[31] + " = " + std::to_string(e.heroic_magic_resist));
-		v.push_back(columns[32] + " = " + std::to_string(e.heroic_fire_resist));
-		v.push_back(columns[33] + " = " + std::to_string(e.heroic_cold_resist));
-		v.push_back(columns[34] + " = " + std::to_string(e.heroic_poison_resist));
-		v.push_back(columns[35] + " = " + std::to_string(e.heroic_disease_resist));
-		v.push_back(columns[36] + " = " + std::to_string(e.heroic_corruption_resist));
-		v.push_back(columns[37] + " = " + std::to_string(e.haste));
-		v.push_back(columns[38] + " = " + std::to_string(e.accuracy));
-		v.push_back(columns[39] + " = " + std::to_string(e.attack));
-		v.push_back(columns[40] + " = " + std::to_string(e.avoidance));
-		v.push_back(columns[41] + " = " + std::to_string(e.clairvoyance));
-		v.push_back(columns[42] + " = " + std::to_string(e.combat_effects));
-		v.push_back(columns[43] + " = " + std::to_string(e.damage_shield_mitigation));
-		v.push_back(columns[44] + " = " + std::to_string(e.damage_shield));
-		v.push_back(columns[45] + " = " + std::to_string(e.dot_shielding));
-		v.push_back(columns[46] + " = " + std::to_string(e.hp_regen));
-		v.push_back(columns[47] + " = " + std::to_string(e.mana_regen));
-		v.push_back(columns[48] + " = " + std::to_string(e.endurance_regen));
-		v.push_back(columns[49] + " = " + std::to_string(e.shielding));
-		v.push_back(columns[50] + " = " + std::to_string(e.spell_damage));
-		v.push_back(columns[51] + " = " + std::to_string(e.spell_shielding));
-		v.push_back(columns[52] + " = " + std::to_string(e.strikethrough));
-		v.push_back(columns[53] + " = " + std::to_string(e.stun_resist));
-		v.push_back(columns[54] + " = " + std::to_string(e.backstab));
-		v.push_back(columns[55] + " = " + std::to_string(e.wind));
-		v.push_back(columns[56] + " = " + std::to_string(e.brass));
-		v.push_back(columns[57] + " = " + std::to_string(e.string));
-		v.push_back(columns[58] + " = " + std::to_string(e.percussion));
-		v.push_back(columns[59] + " = " + std::to_string(e.singing));
-		v.push_back(columns[60] + " = " + std::to_string(e.baking));
-		v.push_back(columns[61] + " = " + std::to_string(e.alchemy));
-		v.push_back(columns[62] + " = " + std::to_string(e.tailoring));
-		v.push_back(columns[63] + " = " + std::to_string(e.blacksmithing));
-		v.push_back(columns[64] + " = " + std::to_string(e.fletching));
-		v.push_back(columns[65] + " = " + std::to_string(e.brewing));
-		v.push_back(columns[66] + " = " + std::to_string(e.jewelry));
-		v.push_back(columns[67] + " = " + std::to_string(e.pottery));
-		v.push_back(columns[68] + " = " + std::to_string(e.research));
-		v.push_back(columns[69] + " = " + std::to_string(e.alcohol));
-		v.push_back(columns[70] + " = " + std::to_string(e.fishing));
-		v.push_back(columns[71] + " = " + std::to_string(e.tinkering));
-		v.push_back(columns[72] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
-		v.push_back(columns[73] + " = FROM_UNIXTIME(" + (e.updated_at > 0 ? std::to_string(e.updated_at) : "null") + ")");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.status)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aa_points)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.endurance)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.ac)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.strength)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.stamina)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.dexterity)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.agility)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.intelligence)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.wisdom)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.charisma)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.magic_resist)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.fire_resist)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.cold_resist)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.poison_resist)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.disease_resist)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.corruption_resist)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.heroic_strength)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.heroic_stamina)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.heroic_dexterity)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.heroic_agility)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.heroic_intelligence)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.heroic_wisdom)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.heroic_charisma)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.heroic_magic_resist)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.heroic_fire_resist)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.heroic_cold_resist)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.heroic_poison_resist)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.heroic_disease_resist)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.heroic_corruption_resist)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.haste)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.accuracy)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.attack)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.avoidance)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.clairvoyance)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.combat_effects)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.damage_shield_mitigation)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.damage_shield)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.dot_shielding)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.hp_regen)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.mana_regen)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.endurance_regen)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.shielding)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.spell_damage)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.spell_shielding)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.strikethrough)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.stun_resist)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.backstab)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.wind)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.brass)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.string)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = " + std::to_string(e.percussion)); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.singing)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.baking)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.alchemy)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.tailoring)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.blacksmithing)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.fletching)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.brewing)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.jewelry)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.pottery)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.research)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.alcohol)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.fishing)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = " + std::to_string(e.tinkering)); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = FROM_UNIXTIME(" + (e.updated_at > 0 ? std::to_string(e.updated_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -998,6 +1089,129 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterStatsRecord FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterStatsRecord e{};
+
+		e.character_id             = row.Get<int32_t>(0).value_or(0);
+		e.name                     = row.GetStr(1).value_or("");
+		e.status                   = row.Get<int32_t>(2).value_or(0);
+		e.level                    = row.Get<int32_t>(3).value_or(0);
+		e.class_                   = row.Get<int32_t>(4).value_or(0);
+		e.race                     = row.Get<int32_t>(5).value_or(0);
+		e.aa_points                = row.Get<int32_t>(6).value_or(0);
+		e.hp                       = row.Get<int64_t>(7).value_or(0);
+		e.mana                     = row.Get<int64_t>(8).value_or(0);
+		e.endurance                = row.Get<int64_t>(9).value_or(0);
+		e.ac                       = row.Get<int32_t>(10).value_or(0);
+		e.strength                 = row.Get<int32_t>(11).value_or(0);
+		e.stamina                  = row.Get<int32_t>(12).value_or(0);
+		e.dexterity                = row.Get<int32_t>(13).value_or(0);
+		e.agility                  = row.Get<int32_t>(14).value_or(0);
+		e.intelligence             = row.Get<int32_t>(15).value_or(0);
+		e.wisdom                   = row.Get<int32_t>(16).value_or(0);
+		e.charisma                 = row.Get<int32_t>(17).value_or(0);
+		e.magic_resist             = row.Get<int32_t>(18).value_or(0);
+		e.fire_resist              = row.Get<int32_t>(19).value_or(0);
+		e.cold_resist              = row.Get<int32_t>(20).value_or(0);
+		e.poison_resist            = row.Get<int32_t>(21).value_or(0);
+		e.disease_resist           = row.Get<int32_t>(22).value_or(0);
+		e.corruption_resist        = row.Get<int32_t>(23).value_or(0);
+		e.heroic_strength          = row.Get<int32_t>(24).value_or(0);
+		e.heroic_stamina           = row.Get<int32_t>(25).value_or(0);
+		e.heroic_dexterity         = row.Get<int32_t>(26).value_or(0);
+		e.heroic_agility           = row.Get<int32_t>(27).value_or(0);
+		e.heroic_intelligence      = row.Get<int32_t>(28).value_or(0);
+		e.heroic_wisdom            = row.Get<int32_t>(29).value_or(0);
+		e.heroic_charisma          = row.Get<int32_t>(30).value_or(0);
+		e.heroic_magic_resist      = row.Get<int32_t>(31).value_or(0);
+		e.heroic_fire_resist       = row.Get<int32_t>(32).value_or(0);
+		e.heroic_cold_resist       = row.Get<int32_t>(33).value_or(0);
+		e.heroic_poison_resist     = row.Get<int32_t>(34).value_or(0);
+		e.heroic_disease_resist    = row.Get<int32_t>(35).value_or(0);
+		e.heroic_corruption_resist = row.Get<int32_t>(36).value_or(0);
+		e.haste                    = row.Get<int32_t>(37).value_or(0);
+		e.accuracy                 = row.Get<int32_t>(38).value_or(0);
+		e.attack                   = row.Get<int32_t>(39).value_or(0);
+		e.avoidance                = row.Get<int32_t>(40).value_or(0);
+		e.clairvoyance             = row.Get<int32_t>(41).value_or(0);
+		e.combat_effects           = row.Get<int32_t>(42).value_or(0);
+		e.damage_shield_mitigation = row.Get<int32_t>(43).value_or(0);
+		e.damage_shield            = row.Get<int32_t>(44).value_or(0);
+		e.dot_shielding            = row.Get<int32_t>(45).value_or(0);
+		e.hp_regen                 = row.Get<int32_t>(46).value_or(0);
+		e.mana_regen               = row.Get<int32_t>(47).value_or(0);
+		e.endurance_regen          = row.Get<int32_t>(48).value_or(0);
+		e.shielding                = row.Get<int32_t>(49).value_or(0);
+		e.spell_damage             = row.Get<int32_t>(50).value_or(0);
+		e.spell_shielding          = row.Get<int32_t>(51).value_or(0);
+		e.strikethrough            = row.Get<int32_t>(52).value_or(0);
+		e.stun_resist              = row.Get<int32_t>(53).value_or(0);
+		e.backstab                 = row.Get<int32_t>(54).value_or(0);
+		e.wind                     = row.Get<int32_t>(55).value_or(0);
+		e.brass                    = row.Get<int32_t>(56).value_or(0);
+		e.string                   = row.Get<int32_t>(57).value_or(0);
+		e.percussion               = row.Get<int32_t>(58).value_or(0);
+		e.singing                  = row.Get<int32_t>(59).value_or(0);
+		e.baking                   = row.Get<int32_t>(60).value_or(0);
+		e.alchemy                  = row.Get<int32_t>(61).value_or(0);
+		e.tailoring                = row.Get<int32_t>(62).value_or(0);
+		e.blacksmithing            = row.Get<int32_t>(63).value_or(0);
+		e.fletching                = row.Get<int32_t>(64).value_or(0);
+		e.brewing                  = row.Get<int32_t>(65).value_or(0);
+		e.jewelry                  = row.Get<int32_t>(66).value_or(0);
+		e.pottery                  = row.Get<int32_t>(67).value_or(0);
+		e.research                 = row.Get<int32_t>(68).value_or(0);
+		e.alcohol                  = row.Get<int32_t>(69).value_or(0);
+		e.fishing                  = row.Get<int32_t>(70).value_or(0);
+		e.tinkering                = row.Get<int32_t>(71).value_or(0);
+		e.created_at               = row.Get<int64_t>(72).value_or(-1);
+		e.updated_at               = row.Get<int64_t>(73).value_or(-1);
+
+		return e;
+	}
+
+	static CharacterStatsRecord FindOnePrepared(
+		Database& db,
+		int character_stats_record_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_stats_record_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterStatsRecord> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterStatsRecord> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -1158,7 +1372,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<74> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.character_id));
@@ -1239,13 +1461,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCharacterTaskTimersRepository {
@@ -25,6 +27,9 @@ public:
 		int32_t  timer_type;
 		int32_t  timer_group;
 		time_t   expire_time;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<6> changed_columns = std::bitset<6>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -165,6 +170,20 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CharacterTaskTimers &e,
+		const CharacterTaskTimers &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.character_id != original.character_id;
+		e.changed_columns[2] = e.task_id != original.task_id;
+		e.changed_columns[3] = e.timer_type != original.timer_type;
+		e.changed_columns[4] = e.timer_group != original.timer_group;
+		e.changed_columns[5] = e.expire_time != original.expire_time;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CharacterTaskTimers &e
@@ -174,11 +193,15 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.task_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.timer_type));
-		v.push_back(columns[4] + " = " + std::to_string(e.timer_group));
-		v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.expire_time > 0 ? std::to_string(e.expire_time) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.task_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.timer_type)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.timer_group)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.expire_time > 0 ? std::to_string(e.expire_time) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -317,6 +340,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CharacterTaskTimers FromStmtRow(const mysql::StmtRow &row)
+	{
+		CharacterTaskTimers e{};
+
+		e.id           = row.Get<uint32_t>(0).value_or(0);
+		e.character_id = row.Get<uint32_t>(1).value_or(0);
+		e.task_id      = row.Get<uint32_t>(2).value_or(0);
+		e.timer_type   = row.Get<int32_t>(3).value_or(0);
+		e.timer_group  = row.Get<int32_t>(4).value_or(0);
+		e.expire_time  = row.Get<int64_t>(5).value_or(-1);
+
+		return e;
+	}
+
+	static CharacterTaskTimers FindOnePrepared(
+		Database& db,
+		int character_task_timers_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { character_task_timers_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CharacterTaskTimers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CharacterTaskTimers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -409,7 +487,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<6> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -422,13 +508,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseCompletedTasksRepository {
@@ -23,6 +25,9 @@ public:
 		uint32_t completedtime;
 		uint32_t taskid;
 		int32_t  activityid;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<4> changed_columns = std::bitset<4>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -155,6 +160,18 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		CompletedTasks &e,
+		const CompletedTasks &original
+	)
+	{
+		e.changed_columns[0] = e.charid != original.charid;
+		e.changed_columns[1] = e.completedtime != original.completedtime;
+		e.changed_columns[2] = e.taskid != original.taskid;
+		e.changed_columns[3] = e.activityid != original.activityid;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const CompletedTasks &e
@@ -164,10 +181,14 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.charid));
-		v.push_back(columns[1] + " = " + std::to_string(e.completedtime));
-		v.push_back(columns[2] + " = " + std::to_string(e.taskid));
-		v.push_back(columns[3] + " = " + std::to_string(e.activityid));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.charid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.completedtime)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.taskid)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.activityid)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -298,6 +319,59 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static CompletedTasks FromStmtRow(const mysql::StmtRow &row)
+	{
+		CompletedTasks e{};
+
+		e.charid        = row.Get<uint32_t>(0).value_or(0);
+		e.completedtime = row.Get<uint32_t>(1).value_or(0);
+		e.taskid        = row.Get<uint32_t>(2).value_or(0);
+		e.activityid    = row.Get<int32_t>(3).value_or(0);
+
+		return e;
+	}
+
+	static CompletedTasks FindOnePrepared(
+		Database& db,
+		int completed_tasks_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { completed_tasks_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<CompletedTasks> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<CompletedTasks> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -388,7 +462,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<4> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.charid));
@@ -399,13 +481,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
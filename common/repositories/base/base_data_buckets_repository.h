@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 #include <cereal/cereal.hpp>
 class BaseDataBucketsRepository {
@@ -47,6 +49,9 @@ public:
 				CEREAL_NVP(instance_id)
 			);
 		}
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -203,6 +208,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		DataBuckets &e,
+		const DataBuckets &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.key_ != original.key_;
+		e.changed_columns[2] = e.value != original.value;
+		e.changed_columns[3] = e.expires != original.expires;
+		e.changed_columns[4] = e.account_id != original.account_id;
+		e.changed_columns[5] = e.character_id != original.character_id;
+		e.changed_columns[6] = e.npc_id != original.npc_id;
+		e.changed_columns[7] = e.bot_id != original.bot_id;
+		e.changed_columns[8] = e.zone_id != original.zone_id;
+		e.changed_columns[9] = e.instance_id != original.instance_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const DataBuckets &e
@@ -212,15 +235,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.key_) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.value) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.expires));
-		v.push_back(columns[4] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.npc_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.instance_id));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.key_) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.value) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.expires)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.npc_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.instance_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -375,6 +402,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static DataBuckets FromStmtRow(const mysql::StmtRow &row)
+	{
+		DataBuckets e{};
+
+		e.id           = row.Get<uint64_t>(0).value_or(0);
+		e.key_         = row.GetStr(1).value_or("");
+		e.value        = row.GetStr(2).value_or("");
+		e.expires      = row.Get<uint32_t>(3).value_or(0);
+		e.account_id   = row.Get<uint64_t>(4).value_or(0);
+		e.character_id = row.Get<uint64_t>(5).value_or(0);
+		e.npc_id       = row.Get<uint32_t>(6).value_or(0);
+		e.bot_id       = row.Get<uint32_t>(7).value_or(0);
+		e.zone_id      = row.Get<uint16_t>(8).value_or(0);
+		e.instance_id  = row.Get<uint16_t>(9).value_or(0);
+
+		return e;
+	}
+
+	static DataBuckets FindOnePrepared(
+		Database& db,
+		int data_buckets_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { data_buckets_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<DataBuckets> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<DataBuckets> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -471,7 +557,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -488,13 +582,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseDoorsRepository {
@@ -56,6 +58,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<37> changed_columns = std::bitset<37>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -320,6 +325,51 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Doors &e,
+		const Doors &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.doorid != original.doorid;
+		e.changed_columns[2] = e.zone != original.zone;
+		e.changed_columns[3] = e.version != original.version;
+		e.changed_columns[4] = e.name != original.name;
+		e.changed_columns[5] = e.pos_y != original.pos_y;
+		e.changed_columns[6] = e.pos_x != original.pos_x;
+		e.changed_columns[7] = e.pos_z != original.pos_z;
+		e.changed_columns[8] = e.heading != original.heading;
+		e.changed_columns[9] = e.opentype != original.opentype;
+		e.changed_columns[10] = e.guild != original.guild;
+		e.changed_columns[11] = e.lockpick != original.lockpick;
+		e.changed_columns[12] = e.keyitem != original.keyitem;
+		e.changed_columns[13] = e.nokeyring != original.nokeyring;
+		e.changed_columns[14] = e.triggerdoor != original.triggerdoor;
+		e.changed_columns[15] = e.triggertype != original.triggertype;
+		e.changed_columns[16] = e.disable_timer != original.disable_timer;
+		e.changed_columns[17] = e.doorisopen != original.doorisopen;
+		e.changed_columns[18] = e.door_param != original.door_param;
+		e.changed_columns[19] = e.dest_zone != original.dest_zone;
+		e.changed_columns[20] = e.dest_instance != original.dest_instance;
+		e.changed_columns[21] = e.dest_x != original.dest_x;
+		e.changed_columns[22] = e.dest_y != original.dest_y;
+		e.changed_columns[23] = e.dest_z != original.dest_z;
+		e.changed_columns[24] = e.dest_heading != original.dest_heading;
+		e.changed_columns[25] = e.invert_state != original.invert_state;
+		e.changed_columns[26] = e.incline != original.incline;
+		e.changed_columns[27] = e.size != original.size;
+		e.changed_columns[28] = e.buffer != original.buffer;
+		e.changed_columns[29] = e.client_version_mask != original.client_version_mask;
+		e.changed_columns[30] = e.is_ldon_door != original.is_ldon_door;
+		e.changed_columns[31] = e.close_timer_ms != original.close_timer_ms;
+		e.changed_columns[32] = e.dz_switch_id != original.dz_switch_id;
+		e.changed_columns[33] = e.min_expansion != original.min_expansion;
+		e.changed_columns[34] = e.max_expansion != original.max_expansion;
+		e.changed_columns[35] = e.content_flags != original.content_flags;
+		e.changed_columns[36] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Doors &e
@@ -329,42 +379,46 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.doorid));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.version));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.pos_y));
-		v.push_back(columns[6] + " = " + std::to_string(e.pos_x));
-		v.push_back(columns[7] + " = " + std::to_string(e.pos_z));
-		v.push_back(columns[8] + " = " + std::to_string(e.heading));
-		v.push_back(columns[9] + " = " + std::to_string(e.opentype));
-		v.push_back(columns[10] + " = " + std::to_string(e.guild));
-		v.push_back(columns[11] + " = " + std::to_string(e.lockpick));
-		v.push_back(columns[12] + " = " + std::to_string(e.keyitem));
-		v.push_back(columns[13] + " = " + std::to_string(e.nokeyring));
-		v.push_back(columns[14] + " = " + std::to_string(e.triggerdoor));
-		v.push_back(columns[15] + " = " + std::to_string(e.triggertype));
-		v.push_back(columns[16] + " = " + std::to_string(e.disable_timer));
-		v.push_back(columns[17] + " = " + std::to_string(e.doorisopen));
-		v.push_back(columns[18] + " = " + std::to_string(e.door_param));
-		v.push_back(columns[19] + " = '" + Strings::Escape(e.dest_zone) + "'");
-		v.push_back(columns[20] + " = " + std::to_string(e.dest_instance));
-		v.push_back(columns[21] + " = " + std::to_string(e.dest_x));
-		v.push_back(columns[22] + " = " + std::to_string(e.dest_y));
-		v.push_back(columns[23] + " = " + std::to_string(e.dest_z));
-		v.push_back(columns[24] + " = " + std::to_string(e.dest_heading));
-		v.push_back(columns[25] + " = " + std::to_string(e.invert_state));
-		v.push_back(columns[26] + " = " + std::to_string(e.incline));
-		v.push_back(columns[27] + " = " + std::to_string(e.size));
-		v.push_back(columns[28] + " = " + std::to_string(e.buffer));
-		v.push_back(columns[29] + " = " + std::to_string(e.client_version_mask));
-		v.push_back(columns[30] + " = " + std::to_string(e.is_ldon_door));
-		v.push_back(columns[31] + " = " + std::to_string(e.close_timer_ms));
-		v.push_back(columns[32] + " = " + std::to_string(e.dz_switch_id));
-		v.push_back(columns[33] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[34] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[35] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[36] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.doorid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.pos_y)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.pos_x)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.pos_z)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.opentype)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.guild)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.lockpick)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.keyitem)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.nokeyring)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.triggerdoor)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.triggertype)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.disable_timer)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.doorisopen)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.door_param)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = '" + Strings::Escape(e.dest_zone) + "'"); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.dest_instance)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.dest_x)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.dest_y)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.dest_z)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.dest_heading)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.invert_state)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.incline)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.buffer)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.client_version_mask)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.is_ldon_door)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.close_timer_ms)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.dz_switch_id)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -627,6 +681,92 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Doors FromStmtRow(const mysql::StmtRow &row)
+	{
+		Doors e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.doorid                 = row.Get<int16_t>(1).value_or(0);
+		e.zone                   = row.GetStr(2).value_or("");
+		e.version                = row.Get<int16_t>(3).value_or(0);
+		e.name                   = row.GetStr(4).value_or("");
+		e.pos_y                  = row.Get<float>(5).value_or(0);
+		e.pos_x                  = row.Get<float>(6).value_or(0);
+		e.pos_z                  = row.Get<float>(7).value_or(0);
+		e.heading                = row.Get<float>(8).value_or(0);
+		e.opentype               = row.Get<int16_t>(9).value_or(0);
+		e.guild                  = row.Get<int16_t>(10).value_or(0);
+		e.lockpick               = row.Get<int16_t>(11).value_or(0);
+		e.keyitem                = row.Get<int32_t>(12).value_or(0);
+		e.nokeyring              = row.Get<uint8_t>(13).value_or(0);
+		e.triggerdoor            = row.Get<int16_t>(14).value_or(0);
+		e.triggertype            = row.Get<int16_t>(15).value_or(0);
+		e.disable_timer          = row.Get<int8_t>(16).value_or(0);
+		e.doorisopen             = row.Get<int16_t>(17).value_or(0);
+		e.door_param             = row.Get<int32_t>(18).value_or(0);
+		e.dest_zone              = row.GetStr(19).value_or("NONE");
+		e.dest_instance          = row.Get<uint32_t>(20).value_or(0);
+		e.dest_x                 = row.Get<float>(21).value_or(0);
+		e.dest_y                 = row.Get<float>(22).value_or(0);
+		e.dest_z                 = row.Get<float>(23).value_or(0);
+		e.dest_heading           = row.Get<float>(24).value_or(0);
+		e.invert_state           = row.Get<int32_t>(25).value_or(0);
+		e.incline                = row.Get<int32_t>(26).value_or(0);
+		e.size                   = row.Get<uint16_t>(27).value_or(100);
+		e.buffer                 = row.Get<float>(28).value_or(0);
+		e.client_version_mask    = row.Get<uint32_t>(29).value_or(4294967295);
+		e.is_ldon_door           = row.Get<int16_t>(30).value_or(0);
+		e.close_timer_ms         = row.Get<int16_t>(31).value_or(5000);
+		e.dz_switch_id           = row.Get<int32_t>(32).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(33).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(34).value_or(-1);
+		e.content_flags          = row.GetStr(35).value_or("");
+		e.content_flags_disabled = row.GetStr(36).value_or("");
+
+		return e;
+	}
+
+	static Doors FindOnePrepared(
+		Database& db,
+		int doors_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { doors_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Doors> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Doors> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -750,7 +890,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<37> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -794,13 +942,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
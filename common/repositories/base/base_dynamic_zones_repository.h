@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseDynamicZonesRepository {
@@ -44,6 +46,9 @@ public:
 		uint8_t     has_zone_in;
 		int8_t      is_locked;
 		int8_t      add_replay;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<25> changed_columns = std::bitset<25>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -260,6 +265,39 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		DynamicZones &e,
+		const DynamicZones &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.instance_id != original.instance_id;
+		e.changed_columns[2] = e.type != original.type;
+		e.changed_columns[3] = e.uuid != original.uuid;
+		e.changed_columns[4] = e.name != original.name;
+		e.changed_columns[5] = e.leader_id != original.leader_id;
+		e.changed_columns[6] = e.min_players != original.min_players;
+		e.changed_columns[7] = e.max_players != original.max_players;
+		e.changed_columns[8] = e.dz_switch_id != original.dz_switch_id;
+		e.changed_columns[9] = e.compass_zone_id != original.compass_zone_id;
+		e.changed_columns[10] = e.compass_x != original.compass_x;
+		e.changed_columns[11] = e.compass_y != original.compass_y;
+		e.changed_columns[12] = e.compass_z != original.compass_z;
+		e.changed_columns[13] = e.safe_return_zone_id != original.safe_return_zone_id;
+		e.changed_columns[14] = e.safe_return_x != original.safe_return_x;
+		e.changed_columns[15] = e.safe_return_y != original.safe_return_y;
+		e.changed_columns[16] = e.safe_return_z != original.safe_return_z;
+		e.changed_columns[17] = e.safe_return_heading != original.safe_return_heading;
+		e.changed_columns[18] = e.zone_in_x != original.zone_in_x;
+		e.changed_columns[19] = e.zone_in_y != original.zone_in_y;
+		e.changed_columns[20] = e.zone_in_z != original.zone_in_z;
+		e.changed_columns[21] = e.zone_in_heading != original.zone_in_heading;
+		e.changed_columns[22] = e.has_zone_in != original.has_zone_in;
+		e.changed_columns[23] = e.is_locked != original.is_locked;
+		e.changed_columns[24] = e.add_replay != original.add_replay;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const DynamicZones &e
@@ -269,30 +307,34 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.type));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.uuid) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.leader_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.min_players));
-		v.push_back(columns[7] + " = " + std::to_string(e.max_players));
-		v.push_back(columns[8] + " = " + std::to_string(e.dz_switch_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.compass_zone_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.compass_x));
-		v.push_back(columns[11] + " = " + std::to_string(e.compass_y));
-		v.push_back(columns[12] + " = " + std::to_string(e.compass_z));
-		v.push_back(columns[13] + " = " + std::to_string(e.safe_return_zone_id));
-		v.push_back(columns[14] + " = " + std::to_string(e.safe_return_x));
-		v.push_back(columns[15] + " = " + std::to_string(e.safe_return_y));
-		v.push_back(columns[16] + " = " + std::to_string(e.safe_return_z));
-		v.push_back(columns[17] + " = " + std::to_string(e.safe_return_heading));
-		v.push_back(columns[18] + " = " + std::to_string(e.zone_in_x));
-		v.push_back(columns[19] + " = " + std::to_string(e.zone_in_y));
-		v.push_back(columns[20] + " = " + std::to_string(e.zone_in_z));
-		v.push_back(columns[21] + " = " + std::to_string(e.zone_in_heading));
-		v.push_back(columns[22] + " = " + std::to_string(e.has_zone_in));
-		v.push_back(columns[23] + " = " + std::to_string(e.is_locked));
-		v.push_back(columns[24] + " = " + std::to_string(e.add_replay));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.uuid) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.leader_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.min_players)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.max_players)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.dz_switch_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.compass_zone_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.compass_x)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.compass_y)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.compass_z)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.safe_return_zone_id)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.safe_return_x)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.safe_return_y)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.safe_return_z)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.safe_return_heading)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.zone_in_x)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.zone_in_y)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.zone_in_z)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.zone_in_heading)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.has_zone_in)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.is_locked)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.add_replay)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -507,6 +549,80 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static DynamicZones FromStmtRow(const mysql::StmtRow &row)
+	{
+		DynamicZones e{};
+
+		e.id                  = row.Get<uint32_t>(0).value_or(0);
+		e.instance_id         = row.Get<int32_t>(1).value_or(0);
+		e.type                = row.Get<uint8_t>(2).value_or(0);
+		e.uuid                = row.GetStr(3).value_or("");
+		e.name                = row.GetStr(4).value_or("");
+		e.leader_id           = row.Get<uint32_t>(5).value_or(0);
+		e.min_players         = row.Get<uint32_t>(6).value_or(0);
+		e.max_players         = row.Get<uint32_t>(7).value_or(0);
+		e.dz_switch_id        = row.Get<int32_t>(8).value_or(0);
+		e.compass_zone_id     = row.Get<uint32_t>(9).value_or(0);
+		e.compass_x           = row.Get<float>(10).value_or(0);
+		e.compass_y           = row.Get<float>(11).value_or(0);
+		e.compass_z           = row.Get<float>(12).value_or(0);
+		e.safe_return_zone_id = row.Get<uint32_t>(13).value_or(0);
+		e.safe_return_x       = row.Get<float>(14).value_or(0);
+		e.safe_return_y       = row.Get<float>(15).value_or(0);
+		e.safe_return_z       = row.Get<float>(16).value_or(0);
+		e.safe_return_heading = row.Get<float>(17).value_or(0);
+		e.zone_in_x           = row.Get<float>(18).value_or(0);
+		e.zone_in_y           = row.Get<float>(19).value_or(0);
+		e.zone_in_z           = row.Get<float>(20).value_or(0);
+		e.zone_in_heading     = row.Get<float>(21).value_or(0);
+		e.has_zone_in         = row.Get<uint8_t>(22).value_or(0);
+		e.is_locked           = row.Get<int8_t>(23).value_or(0);
+		e.add_replay          = row.Get<int8_t>(24).value_or(1);
+
+		return e;
+	}
+
+	static DynamicZones FindOnePrepared(
+		Database& db,
+		int dynamic_zones_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { dynamic_zones_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<DynamicZones> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<DynamicZones> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -618,7 +734,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<25> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -650,13 +774,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseFactionAssociationRepository {
@@ -40,6 +42,9 @@ public:
 		float   mod_9;
 		int32_t id_10;
 		float   mod_10;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<21> changed_columns = std::bitset<21>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -240,6 +245,35 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		FactionAssociation &e,
+		const FactionAssociation &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.id_1 != original.id_1;
+		e.changed_columns[2] = e.mod_1 != original.mod_1;
+		e.changed_columns[3] = e.id_2 != original.id_2;
+		e.changed_columns[4] = e.mod_2 != original.mod_2;
+		e.changed_columns[5] = e.id_3 != original.id_3;
+		e.changed_columns[6] = e.mod_3 != original.mod_3;
+		e.changed_columns[7] = e.id_4 != original.id_4;
+		e.changed_columns[8] = e.mod_4 != original.mod_4;
+		e.changed_columns[9] = e.id_5 != original.id_5;
+		e.changed_columns[10] = e.mod_5 != original.mod_5;
+		e.changed_columns[11] = e.id_6 != original.id_6;
+		e.changed_columns[12] = e.mod_6 != original.mod_6;
+		e.changed_columns[13] = e.id_7 != original.id_7;
+		e.changed_columns[14] = e.mod_7 != original.mod_7;
+		e.changed_columns[15] = e.id_8 != original.id_8;
+		e.changed_columns[16] = e.mod_8 != original.mod_8;
+		e.changed_columns[17] = e.id_9 != original.id_9;
+		e.changed_columns[18] = e.mod_9 != original.mod_9;
+		e.changed_columns[19] = e.id_10 != original.id_10;
+		e.changed_columns[20] = e.mod_10 != original.mod_10;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const FactionAssociation &e
@@ -249,27 +283,31 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.id_1));
-		v.push_back(columns[2] + " = " + std::to_string(e.mod_1));
-		v.push_back(columns[3] + " = " + std::to_string(e.id_2));
-		v.push_back(columns[4] + " = " + std::to_string(e.mod_2));
-		v.push_back(columns[5] + " = " + std::to_string(e.id_3));
-		v.push_back(columns[6] + " = " + std::to_string(e.mod_3));
-		v.push_back(columns[7] + " = " + std::to_string(e.id_4));
-		v.push_back(columns[8] + " = " + std::to_string(e.mod_4));
-		v.push_back(columns[9] + " = " + std::to_string(e.id_5));
-		v.push_back(columns[10] + " = " + std::to_string(e.mod_5));
-		v.push_back(columns[11] + " = " + std::to_string(e.id_6));
-		v.push_back(columns[12] + " = " + std::to_string(e.mod_6));
-		v.push_back(columns[13] + " = " + std::to_string(e.id_7));
-		v.push_back(columns[14] + " = " + std::to_string(e.mod_7));
-		v.push_back(columns[15] + " = " + std::to_string(e.id_8));
-		v.push_back(columns[16] + " = " + std::to_string(e.mod_8));
-		v.push_back(columns[17] + " = " + std::to_string(e.id_9));
-		v.push_back(columns[18] + " = " + std::to_string(e.mod_9));
-		v.push_back(columns[19] + " = " + std::to_string(e.id_10));
-		v.push_back(columns[20] + " = " + std::to_string(e.mod_10));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.id_1)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.mod_1)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.id_2)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.mod_2)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.id_3)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.mod_3)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.id_4)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mod_4)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.id_5)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.mod_5)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.id_6)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.mod_6)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.id_7)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.mod_7)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.id_8)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.mod_8)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.id_9)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.mod_9)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.id_10)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.mod_10)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -468,6 +506,76 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static FactionAssociation FromStmtRow(const mysql::StmtRow &row)
+	{
+		FactionAssociation e{};
+
+		e.id     = row.Get<int32_t>(0).value_or(0);
+		e.id_1   = row.Get<int32_t>(1).value_or(0);
+		e.mod_1  = row.Get<float>(2).value_or(0);
+		e.id_2   = row.Get<int32_t>(3).value_or(0);
+		e.mod_2  = row.Get<float>(4).value_or(0);
+		e.id_3   = row.Get<int32_t>(5).value_or(0);
+		e.mod_3  = row.Get<float>(6).value_or(0);
+		e.id_4   = row.Get<int32_t>(7).value_or(0);
+		e.mod_4  = row.Get<float>(8).value_or(0);
+		e.id_5   = row.Get<int32_t>(9).value_or(0);
+		e.mod_5  = row.Get<float>(10).value_or(0);
+		e.id_6   = row.Get<int32_t>(11).value_or(0);
+		e.mod_6  = row.Get<float>(12).value_or(0);
+		e.id_7   = row.Get<int32_t>(13).value_or(0);
+		e.mod_7  = row.Get<float>(14).value_or(0);
+		e.id_8   = row.Get<int32_t>(15).value_or(0);
+		e.mod_8  = row.Get<float>(16).value_or(0);
+		e.id_9   = row.Get<int32_t>(17).value_or(0);
+		e.mod_9  = row.Get<float>(18).value_or(0);
+		e.id_10  = row.Get<int32_t>(19).value_or(0);
+		e.mod_10 = row.Get<float>(20).value_or(0);
+
+		return e;
+	}
+
+	static FactionAssociation FindOnePrepared(
+		Database& db,
+		int faction_association_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { faction_association_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<FactionAssociation> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<FactionAssociation> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -575,7 +683,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<21> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -603,13 +719,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
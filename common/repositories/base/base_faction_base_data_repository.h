@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseFactionBaseDataRepository {
@@ -25,6 +27,9 @@ public:
 		int16_t unk_hero1;
 		int16_t unk_hero2;
 		int16_t unk_hero3;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<6> changed_columns = std::bitset<6>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -165,6 +170,20 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		FactionBaseData &e,
+		const FactionBaseData &original
+	)
+	{
+		e.changed_columns[0] = e.client_faction_id != original.client_faction_id;
+		e.changed_columns[1] = e.min != original.min;
+		e.changed_columns[2] = e.max != original.max;
+		e.changed_columns[3] = e.unk_hero1 != original.unk_hero1;
+		e.changed_columns[4] = e.unk_hero2 != original.unk_hero2;
+		e.changed_columns[5] = e.unk_hero3 != original.unk_hero3;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const FactionBaseData &e
@@ -174,12 +193,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.client_faction_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.min));
-		v.push_back(columns[2] + " = " + std::to_string(e.max));
-		v.push_back(columns[3] + " = " + std::to_string(e.unk_hero1));
-		v.push_back(columns[4] + " = " + std::to_string(e.unk_hero2));
-		v.push_back(columns[5] + " = " + std::to_string(e.unk_hero3));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.client_faction_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.min)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.max)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.unk_hero1)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.unk_hero2)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.unk_hero3)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -318,6 +341,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static FactionBaseData FromStmtRow(const mysql::StmtRow &row)
+	{
+		FactionBaseData e{};
+
+		e.client_faction_id = row.Get<int16_t>(0).value_or(0);
+		e.min               = row.Get<int16_t>(1).value_or(-2000);
+		e.max               = row.Get<int16_t>(2).value_or(2000);
+		e.unk_hero1         = row.Get<int16_t>(3).value_or(0);
+		e.unk_hero2         = row.Get<int16_t>(4).value_or(0);
+		e.unk_hero3         = row.Get<int16_t>(5).value_or(0);
+
+		return e;
+	}
+
+	static FactionBaseData FindOnePrepared(
+		Database& db,
+		int faction_base_data_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { faction_base_data_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<FactionBaseData> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<FactionBaseData> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -410,7 +488,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<6> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.client_faction_id));
@@ -423,13 +509,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
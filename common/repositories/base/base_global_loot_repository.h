@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGlobalLootRepository {
@@ -36,6 +38,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GlobalLoot &e,
+		const GlobalLoot &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.description != original.description;
+		e.changed_columns[2] = e.loottable_id != original.loottable_id;
+		e.changed_columns[3] = e.enabled != original.enabled;
+		e.changed_columns[4] = e.min_level != original.min_level;
+		e.changed_columns[5] = e.max_level != original.max_level;
+		e.changed_columns[6] = e.rare != original.rare;
+		e.changed_columns[7] = e.raid != original.raid;
+		e.changed_columns[8] = e.race != original.race;
+		e.changed_columns[9] = e.class_ != original.class_;
+		e.changed_columns[10] = e.bodytype != original.bodytype;
+		e.changed_columns[11] = e.zone != original.zone;
+		e.changed_columns[12] = e.hot_zone != original.hot_zone;
+		e.changed_columns[13] = e.min_expansion != original.min_expansion;
+		e.changed_columns[14] = e.max_expansion != original.max_expansion;
+		e.changed_columns[15] = e.content_flags != original.content_flags;
+		e.changed_columns[16] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GlobalLoot &e
@@ -229,22 +259,26 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.description) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.loottable_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.enabled));
-		v.push_back(columns[4] + " = " + std::to_string(e.min_level));
-		v.push_back(columns[5] + " = " + std::to_string(e.max_level));
-		v.push_back(columns[6] + " = " + std::to_string(e.rare));
-		v.push_back(columns[7] + " = " + std::to_string(e.raid));
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.race) + "'");
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.class_) + "'");
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.bodytype) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.hot_zone));
-		v.push_back(columns[13] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[14] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[16] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.description) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.loottable_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.enabled)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.min_level)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.max_level)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.rare)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.raid)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.race) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.class_) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.bodytype) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.hot_zone)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -427,6 +461,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GlobalLoot FromStmtRow(const mysql::StmtRow &row)
+	{
+		GlobalLoot e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.description            = row.GetStr(1).value_or("");
+		e.loottable_id           = row.Get<int32_t>(2).value_or(0);
+		e.enabled                = row.Get<int8_t>(3).value_or(1);
+		e.min_level              = row.Get<int32_t>(4).value_or(0);
+		e.max_level              = row.Get<int32_t>(5).value_or(0);
+		e.rare                   = row.Get<int8_t>(6).value_or(0);
+		e.raid                   = row.Get<int8_t>(7).value_or(0);
+		e.race                   = row.GetStr(8).value_or("");
+		e.class_                 = row.GetStr(9).value_or("");
+		e.bodytype               = row.GetStr(10).value_or("");
+		e.zone                   = row.GetStr(11).value_or("");
+		e.hot_zone               = row.Get<int8_t>(12).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(13).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(14).value_or(-1);
+		e.content_flags          = row.GetStr(15).value_or("");
+		e.content_flags_disabled = row.GetStr(16).value_or("");
+
+		return e;
+	}
+
+	static GlobalLoot FindOnePrepared(
+		Database& db,
+		int global_loot_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { global_loot_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GlobalLoot> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GlobalLoot> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -530,7 +630,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -554,13 +662,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
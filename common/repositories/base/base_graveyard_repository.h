@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGraveyardRepository {
@@ -25,6 +27,9 @@ public:
 		float   y;
 		float   z;
 		float   heading;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<6> changed_columns = std::bitset<6>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -165,6 +170,20 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Graveyard &e,
+		const Graveyard &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone_id != original.zone_id;
+		e.changed_columns[2] = e.x != original.x;
+		e.changed_columns[3] = e.y != original.y;
+		e.changed_columns[4] = e.z != original.z;
+		e.changed_columns[5] = e.heading != original.heading;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Graveyard &e
@@ -174,11 +193,15 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.x));
-		v.push_back(columns[3] + " = " + std::to_string(e.y));
-		v.push_back(columns[4] + " = " + std::to_string(e.z));
-		v.push_back(columns[5] + " = " + std::to_string(e.heading));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.heading)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -317,6 +340,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Graveyard FromStmtRow(const mysql::StmtRow &row)
+	{
+		Graveyard e{};
+
+		e.id      = row.Get<int32_t>(0).value_or(0);
+		e.zone_id = row.Get<int32_t>(1).value_or(0);
+		e.x       = row.Get<float>(2).value_or(0);
+		e.y       = row.Get<float>(3).value_or(0);
+		e.z       = row.Get<float>(4).value_or(0);
+		e.heading = row.Get<float>(5).value_or(0);
+
+		return e;
+	}
+
+	static Graveyard FindOnePrepared(
+		Database& db,
+		int graveyard_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { graveyard_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Graveyard> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Graveyard> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -409,7 +487,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<6> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -422,13 +508,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
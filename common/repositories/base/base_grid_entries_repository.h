@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGridEntriesRepository {
@@ -28,6 +30,9 @@ public:
 		float   heading;
 		int32_t pause;
 		int8_t  centerpoint;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GridEntries &e,
+		const GridEntries &original
+	)
+	{
+		e.changed_columns[0] = e.gridid != original.gridid;
+		e.changed_columns[1] = e.zoneid != original.zoneid;
+		e.changed_columns[2] = e.number != original.number;
+		e.changed_columns[3] = e.x != original.x;
+		e.changed_columns[4] = e.y != original.y;
+		e.changed_columns[5] = e.z != original.z;
+		e.changed_columns[6] = e.heading != original.heading;
+		e.changed_columns[7] = e.pause != original.pause;
+		e.changed_columns[8] = e.centerpoint != original.centerpoint;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GridEntries &e
@@ -189,15 +211,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.gridid));
-		v.push_back(columns[1] + " = " + std::to_string(e.zoneid));
-		v.push_back(columns[2] + " = " + std::to_string(e.number));
-		v.push_back(columns[3] + " = " + std::to_string(e.x));
-		v.push_back(columns[4] + " = " + std::to_string(e.y));
-		v.push_back(columns[5] + " = " + std::to_string(e.z));
-		v.push_back(columns[6] + " = " + std::to_string(e.heading));
-		v.push_back(columns[7] + " = " + std::to_string(e.pause));
-		v.push_back(columns[8] + " = " + std::to_string(e.centerpoint));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.gridid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zoneid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.number)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.pause)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.centerpoint)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -348,6 +374,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GridEntries FromStmtRow(const mysql::StmtRow &row)
+	{
+		GridEntries e{};
+
+		e.gridid      = row.Get<int32_t>(0).value_or(0);
+		e.zoneid      = row.Get<int32_t>(1).value_or(0);
+		e.number      = row.Get<int32_t>(2).value_or(0);
+		e.x           = row.Get<float>(3).value_or(0);
+		e.y           = row.Get<float>(4).value_or(0);
+		e.z           = row.Get<float>(5).value_or(0);
+		e.heading     = row.Get<float>(6).value_or(0);
+		e.pause       = row.Get<int32_t>(7).value_or(0);
+		e.centerpoint = row.Get<int8_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static GridEntries FindOnePrepared(
+		Database& db,
+		int grid_entries_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { grid_entries_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GridEntries> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GridEntries> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -443,7 +527,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.gridid));
@@ -459,13 +551,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
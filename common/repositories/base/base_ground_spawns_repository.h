@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGroundSpawnsRepository {
@@ -38,6 +40,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<19> changed_columns = std::bitset<19>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -230,6 +235,33 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GroundSpawns &e,
+		const GroundSpawns &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zoneid != original.zoneid;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.max_x != original.max_x;
+		e.changed_columns[4] = e.max_y != original.max_y;
+		e.changed_columns[5] = e.max_z != original.max_z;
+		e.changed_columns[6] = e.min_x != original.min_x;
+		e.changed_columns[7] = e.min_y != original.min_y;
+		e.changed_columns[8] = e.heading != original.heading;
+		e.changed_columns[9] = e.name != original.name;
+		e.changed_columns[10] = e.item != original.item;
+		e.changed_columns[11] = e.max_allowed != original.max_allowed;
+		e.changed_columns[12] = e.comment != original.comment;
+		e.changed_columns[13] = e.respawn_timer != original.respawn_timer;
+		e.changed_columns[14] = e.fix_z != original.fix_z;
+		e.changed_columns[15] = e.min_expansion != original.min_expansion;
+		e.changed_columns[16] = e.max_expansion != original.max_expansion;
+		e.changed_columns[17] = e.content_flags != original.content_flags;
+		e.changed_columns[18] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GroundSpawns &e
@@ -239,24 +271,28 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zoneid));
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = " + std::to_string(e.max_x));
-		v.push_back(columns[4] + " = " + std::to_string(e.max_y));
-		v.push_back(columns[5] + " = " + std::to_string(e.max_z));
-		v.push_back(columns[6] + " = " + std::to_string(e.min_x));
-		v.push_back(columns[7] + " = " + std::to_string(e.min_y));
-		v.push_back(columns[8] + " = " + std::to_string(e.heading));
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[10] + " = " + std::to_string(e.item));
-		v.push_back(columns[11] + " = " + std::to_string(e.max_allowed));
-		v.push_back(columns[12] + " = '" + Strings::Escape(e.comment) + "'");
-		v.push_back(columns[13] + " = " + std::to_string(e.respawn_timer));
-		v.push_back(columns[14] + " = " + std::to_string(e.fix_z));
-		v.push_back(columns[15] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[16] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zoneid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.max_x)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.max_y)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.max_z)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.min_x)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.min_y)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.item)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.max_allowed)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = '" + Strings::Escape(e.comment) + "'"); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.respawn_timer)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.fix_z)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -447,6 +483,74 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GroundSpawns FromStmtRow(const mysql::StmtRow &row)
+	{
+		GroundSpawns e{};
+
+		e.id                     = row.Get<uint32_t>(0).value_or(0);
+		e.zoneid                 = row.Get<uint32_t>(1).value_or(0);
+		e.version                = row.Get<int16_t>(2).value_or(0);
+		e.max_x                  = row.Get<float>(3).value_or(2000);
+		e.max_y                  = row.Get<float>(4).value_or(2000);
+		e.max_z                  = row.Get<float>(5).value_or(10000);
+		e.min_x                  = row.Get<float>(6).value_or(-2000);
+		e.min_y                  = row.Get<float>(7).value_or(-2000);
+		e.heading                = row.Get<float>(8).value_or(0);
+		e.name                   = row.GetStr(9).value_or("");
+		e.item                   = row.Get<uint32_t>(10).value_or(0);
+		e.max_allowed            = row.Get<uint32_t>(11).value_or(1);
+		e.comment                = row.GetStr(12).value_or("");
+		e.respawn_timer          = row.Get<uint32_t>(13).value_or(300);
+		e.fix_z                  = row.Get<uint8_t>(14).value_or(1);
+		e.min_expansion          = row.Get<int8_t>(15).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(16).value_or(-1);
+		e.content_flags          = row.GetStr(17).value_or("");
+		e.content_flags_disabled = row.GetStr(18).value_or("");
+
+		return e;
+	}
+
+	static GroundSpawns FindOnePrepared(
+		Database& db,
+		int ground_spawns_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { ground_spawns_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GroundSpawns> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GroundSpawns> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -552,7 +656,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<19> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -578,13 +690,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
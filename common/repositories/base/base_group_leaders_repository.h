@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGroupLeadersRepository {
@@ -28,6 +30,9 @@ public:
 		std::string puller;
 		std::string mentoree;
 		int32_t     mentor_percent;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GroupLeaders &e,
+		const GroupLeaders &original
+	)
+	{
+		e.changed_columns[0] = e.gid != original.gid;
+		e.changed_columns[1] = e.leadername != original.leadername;
+		e.changed_columns[2] = e.marknpc != original.marknpc;
+		e.changed_columns[3] = e.leadershipaa != original.leadershipaa;
+		e.changed_columns[4] = e.maintank != original.maintank;
+		e.changed_columns[5] = e.assist != original.assist;
+		e.changed_columns[6] = e.puller != original.puller;
+		e.changed_columns[7] = e.mentoree != original.mentoree;
+		e.changed_columns[8] = e.mentor_percent != original.mentor_percent;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GroupLeaders &e
@@ -189,15 +211,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.gid));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.leadername) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.marknpc) + "'");
-		v.push_back(columns[3] + " = '" + e.leadershipaa + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.maintank) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.assist) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.puller) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.mentoree) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.mentor_percent));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.gid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.leadername) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.marknpc) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + e.leadershipaa + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.maintank) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.assist) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.puller) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.mentoree) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mentor_percent)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -348,6 +374,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GroupLeaders FromStmtRow(const mysql::StmtRow &row)
+	{
+		GroupLeaders e{};
+
+		e.gid            = row.Get<int32_t>(0).value_or(0);
+		e.leadername     = row.GetStr(1).value_or("");
+		e.marknpc        = row.GetStr(2).value_or("");
+		e.leadershipaa   = row.GetStr(3).value_or("");
+		e.maintank       = row.GetStr(4).value_or("");
+		e.assist         = row.GetStr(5).value_or("");
+		e.puller         = row.GetStr(6).value_or("");
+		e.mentoree       = row.GetStr(7).value_or("");
+		e.mentor_percent = row.Get<int32_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static GroupLeaders FindOnePrepared(
+		Database& db,
+		int group_leaders_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { group_leaders_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GroupLeaders> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GroupLeaders> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -443,7 +527,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.gid));
@@ -459,13 +551,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
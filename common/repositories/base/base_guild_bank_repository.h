@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGuildBankRepository {
@@ -34,6 +36,9 @@ public:
 		std::string donator;
 		uint8_t     permissions;
 		std::string who_for;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GuildBank &e,
+		const GuildBank &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.guild_id != original.guild_id;
+		e.changed_columns[2] = e.area != original.area;
+		e.changed_columns[3] = e.slot != original.slot;
+		e.changed_columns[4] = e.item_id != original.item_id;
+		e.changed_columns[5] = e.augment_one_id != original.augment_one_id;
+		e.changed_columns[6] = e.augment_two_id != original.augment_two_id;
+		e.changed_columns[7] = e.augment_three_id != original.augment_three_id;
+		e.changed_columns[8] = e.augment_four_id != original.augment_four_id;
+		e.changed_columns[9] = e.augment_five_id != original.augment_five_id;
+		e.changed_columns[10] = e.augment_six_id != original.augment_six_id;
+		e.changed_columns[11] = e.quantity != original.quantity;
+		e.changed_columns[12] = e.donator != original.donator;
+		e.changed_columns[13] = e.permissions != original.permissions;
+		e.changed_columns[14] = e.who_for != original.who_for;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GuildBank &e
@@ -219,20 +247,24 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.guild_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.area));
-		v.push_back(columns[3] + " = " + std::to_string(e.slot));
-		v.push_back(columns[4] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.augment_one_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.augment_two_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.augment_three_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.augment_four_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.augment_five_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.augment_six_id));
-		v.push_back(columns[11] + " = " + std::to_string(e.quantity));
-		v.push_back(columns[12] + " = '" + Strings::Escape(e.donator) + "'");
-		v.push_back(columns[13] + " = " + std::to_string(e.permissions));
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.who_for) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.guild_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.area)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.slot)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.augment_one_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.augment_two_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augment_three_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augment_four_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augment_five_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.augment_six_id)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.quantity)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = '" + Strings::Escape(e.donator) + "'"); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.permissions)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.who_for) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -407,6 +439,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GuildBank FromStmtRow(const mysql::StmtRow &row)
+	{
+		GuildBank e{};
+
+		e.id               = row.Get<uint32_t>(0).value_or(0);
+		e.guild_id         = row.Get<uint32_t>(1).value_or(0);
+		e.area             = row.Get<uint8_t>(2).value_or(0);
+		e.slot             = row.Get<uint32_t>(3).value_or(0);
+		e.item_id          = row.Get<uint32_t>(4).value_or(0);
+		e.augment_one_id   = row.Get<uint32_t>(5).value_or(0);
+		e.augment_two_id   = row.Get<uint32_t>(6).value_or(0);
+		e.augment_three_id = row.Get<uint32_t>(7).value_or(0);
+		e.augment_four_id  = row.Get<uint32_t>(8).value_or(0);
+		e.augment_five_id  = row.Get<uint32_t>(9).value_or(0);
+		e.augment_six_id   = row.Get<uint32_t>(10).value_or(0);
+		e.quantity         = row.Get<int32_t>(11).value_or(0);
+		e.donator          = row.GetStr(12).value_or("");
+		e.permissions      = row.Get<uint8_t>(13).value_or(0);
+		e.who_for          = row.GetStr(14).value_or("");
+
+		return e;
+	}
+
+	static GuildBank FindOnePrepared(
+		Database& db,
+		int guild_bank_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { guild_bank_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GuildBank> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GuildBank> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -508,7 +604,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -530,13 +634,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseGuildMembersRepository {
@@ -29,6 +31,9 @@ public:
 		std::string public_note;
 		uint8_t     alt;
 		uint8_t     online;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -185,6 +190,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GuildMembers &e,
+		const GuildMembers &original
+	)
+	{
+		e.changed_columns[0] = e.char_id != original.char_id;
+		e.changed_columns[1] = e.guild_id != original.guild_id;
+		e.changed_columns[2] = e.rank_ != original.rank_;
+		e.changed_columns[3] = e.tribute_enable != original.tribute_enable;
+		e.changed_columns[4] = e.total_tribute != original.total_tribute;
+		e.changed_columns[5] = e.last_tribute != original.last_tribute;
+		e.changed_columns[6] = e.banker != original.banker;
+		e.changed_columns[7] = e.public_note != original.public_note;
+		e.changed_columns[8] = e.alt != original.alt;
+		e.changed_columns[9] = e.online != original.online;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GuildMembers &e
@@ -194,16 +217,20 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.guild_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.rank_));
-		v.push_back(columns[3] + " = " + std::to_string(e.tribute_enable));
-		v.push_back(columns[4] + " = " + std::to_string(e.total_tribute));
-		v.push_back(columns[5] + " = " + std::to_string(e.last_tribute));
-		v.push_back(columns[6] + " = " + std::to_string(e.banker));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.public_note) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.alt));
-		v.push_back(columns[9] + " = " + std::to_string(e.online));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.guild_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.rank_)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.tribute_enable)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.total_tribute)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.last_tribute)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.banker)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.public_note) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.alt)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.online)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -358,6 +385,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GuildMembers FromStmtRow(const mysql::StmtRow &row)
+	{
+		GuildMembers e{};
+
+		e.char_id        = row.Get<int32_t>(0).value_or(0);
+		e.guild_id       = row.Get<uint32_t>(1).value_or(0);
+		e.rank_          = row.Get<uint8_t>(2).value_or(0);
+		e.tribute_enable = row.Get<uint8_t>(3).value_or(0);
+		e.total_tribute  = row.Get<uint32_t>(4).value_or(0);
+		e.last_tribute   = row.Get<uint32_t>(5).value_or(0);
+		e.banker         = row.Get<uint8_t>(6).value_or(0);
+		e.public_note    = row.GetStr(7).value_or("");
+		e.alt            = row.Get<uint8_t>(8).value_or(0);
+		e.online         = row.Get<uint8_t>(9).value_or(0);
+
+		return e;
+	}
+
+	static GuildMembers FindOnePrepared(
+		Database& db,
+		int guild_members_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { guild_members_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GuildMembers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GuildMembers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -454,7 +540,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.char_id));
@@ -471,13 +565,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
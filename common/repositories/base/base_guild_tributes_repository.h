@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 
@@ -27,6 +29,9 @@ public:
 		uint32_t tribute_id_2_tier;
 		uint32_t time_remaining;
 		uint32_t enabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -171,6 +176,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		GuildTributes &e,
+		const GuildTributes &original
+	)
+	{
+		e.changed_columns[0] = e.guild_id != original.guild_id;
+		e.changed_columns[1] = e.tribute_id_1 != original.tribute_id_1;
+		e.changed_columns[2] = e.tribute_id_1_tier != original.tribute_id_1_tier;
+		e.changed_columns[3] = e.tribute_id_2 != original.tribute_id_2;
+		e.changed_columns[4] = e.tribute_id_2_tier != original.tribute_id_2_tier;
+		e.changed_columns[5] = e.time_remaining != original.time_remaining;
+		e.changed_columns[6] = e.enabled != original.enabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const GuildTributes &e
@@ -180,13 +200,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.guild_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.tribute_id_1));
-		v.push_back(columns[2] + " = " + std::to_string(e.tribute_id_1_tier));
-		v.push_back(columns[3] + " = " + std::to_string(e.tribute_id_2));
-		v.push_back(columns[4] + " = " + std::to_string(e.tribute_id_2_tier));
-		v.push_back(columns[5] + " = " + std::to_string(e.time_remaining));
-		v.push_back(columns[6] + " = " + std::to_string(e.enabled));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.guild_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.tribute_id_1)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.tribute_id_1_tier)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.tribute_id_2)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.tribute_id_2_tier)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.time_remaining)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.enabled)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -329,6 +353,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static GuildTributes FromStmtRow(const mysql::StmtRow &row)
+	{
+		GuildTributes e{};
+
+		e.guild_id          = row.Get<uint32_t>(0).value_or(0);
+		e.tribute_id_1      = row.Get<uint32_t>(1).value_or(0);
+		e.tribute_id_1_tier = row.Get<uint32_t>(2).value_or(0);
+		e.tribute_id_2      = row.Get<uint32_t>(3).value_or(0);
+		e.tribute_id_2_tier = row.Get<uint32_t>(4).value_or(0);
+		e.time_remaining    = row.Get<uint32_t>(5).value_or(0);
+		e.enabled           = row.Get<uint32_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static GuildTributes FindOnePrepared(
+		Database& db,
+		int guild_tributes_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { guild_tributes_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<GuildTributes> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<GuildTributes> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -422,7 +502,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.guild_id));
@@ -436,13 +524,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 
@@ -30,6 +32,9 @@ public:
 		std::string channel;
 		std::string url;
 		uint32_t    favor;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -186,6 +191,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Guilds &e,
+		const Guilds &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.leader != original.leader;
+		e.changed_columns[3] = e.minstatus != original.minstatus;
+		e.changed_columns[4] = e.motd != original.motd;
+		e.changed_columns[5] = e.tribute != original.tribute;
+		e.changed_columns[6] = e.motd_setter != original.motd_setter;
+		e.changed_columns[7] = e.channel != original.channel;
+		e.changed_columns[8] = e.url != original.url;
+		e.changed_columns[9] = e.favor != original.favor;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Guilds &e
@@ -195,15 +218,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.leader));
-		v.push_back(columns[3] + " = " + std::to_string(e.minstatus));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.motd) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.tribute));
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.motd_setter) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.channel) + "'");
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.url) + "'");
-		v.push_back(columns[9] + " = " + std::to_string(e.favor));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.leader)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.minstatus)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.motd) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.tribute)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.motd_setter) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.channel) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.url) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.favor)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -358,6 +385,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Guilds FromStmtRow(const mysql::StmtRow &row)
+	{
+		Guilds e{};
+
+		e.id          = row.Get<int32_t>(0).value_or(0);
+		e.name        = row.GetStr(1).value_or("");
+		e.leader      = row.Get<int32_t>(2).value_or(0);
+		e.minstatus   = row.Get<int16_t>(3).value_or(0);
+		e.motd        = row.GetStr(4).value_or("");
+		e.tribute     = row.Get<uint32_t>(5).value_or(0);
+		e.motd_setter = row.GetStr(6).value_or("");
+		e.channel     = row.GetStr(7).value_or("");
+		e.url         = row.GetStr(8).value_or("");
+		e.favor       = row.Get<uint32_t>(9).value_or(0);
+
+		return e;
+	}
+
+	static Guilds FindOnePrepared(
+		Database& db,
+		int guilds_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { guilds_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Guilds> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Guilds> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -454,7 +540,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -471,13 +565,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
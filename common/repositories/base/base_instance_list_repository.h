@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseInstanceListRepository {
@@ -27,6 +29,9 @@ public:
 		uint32_t    duration;
 		uint8_t     never_expires;
 		std::string notes;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		InstanceList &e,
+		const InstanceList &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.is_global != original.is_global;
+		e.changed_columns[4] = e.start_time != original.start_time;
+		e.changed_columns[5] = e.duration != original.duration;
+		e.changed_columns[6] = e.never_expires != original.never_expires;
+		e.changed_columns[7] = e.notes != original.notes;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const InstanceList &e
@@ -184,13 +205,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zone));
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = " + std::to_string(e.is_global));
-		v.push_back(columns[4] + " = " + std::to_string(e.start_time));
-		v.push_back(columns[5] + " = " + std::to_string(e.duration));
-		v.push_back(columns[6] + " = " + std::to_string(e.never_expires));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.notes) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zone)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.is_global)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.start_time)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.duration)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.never_expires)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.notes) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -337,6 +362,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static InstanceList FromStmtRow(const mysql::StmtRow &row)
+	{
+		InstanceList e{};
+
+		e.id            = row.Get<int32_t>(0).value_or(0);
+		e.zone          = row.Get<uint32_t>(1).value_or(0);
+		e.version       = row.Get<uint8_t>(2).value_or(0);
+		e.is_global     = row.Get<uint8_t>(3).value_or(0);
+		e.start_time    = row.Get<uint32_t>(4).value_or(0);
+		e.duration      = row.Get<uint32_t>(5).value_or(0);
+		e.never_expires = row.Get<uint8_t>(6).value_or(0);
+		e.notes         = row.GetStr(7).value_or("");
+
+		return e;
+	}
+
+	static InstanceList FindOnePrepared(
+		Database& db,
+		int instance_list_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { instance_list_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<InstanceList> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<InstanceList> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -431,7 +513,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -446,13 +536,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
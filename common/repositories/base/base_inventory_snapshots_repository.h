@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseInventorySnapshotsRepository {
@@ -37,6 +39,9 @@ public:
 		uint32_t    ornamentidfile;
 		int32_t     ornament_hero_model;
 		uint64_t    guid;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<18> changed_columns = std::bitset<18>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -225,6 +230,32 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		InventorySnapshots &e,
+		const InventorySnapshots &original
+	)
+	{
+		e.changed_columns[0] = e.time_index != original.time_index;
+		e.changed_columns[1] = e.charid != original.charid;
+		e.changed_columns[2] = e.slotid != original.slotid;
+		e.changed_columns[3] = e.itemid != original.itemid;
+		e.changed_columns[4] = e.charges != original.charges;
+		e.changed_columns[5] = e.color != original.color;
+		e.changed_columns[6] = e.augslot1 != original.augslot1;
+		e.changed_columns[7] = e.augslot2 != original.augslot2;
+		e.changed_columns[8] = e.augslot3 != original.augslot3;
+		e.changed_columns[9] = e.augslot4 != original.augslot4;
+		e.changed_columns[10] = e.augslot5 != original.augslot5;
+		e.changed_columns[11] = e.augslot6 != original.augslot6;
+		e.changed_columns[12] = e.instnodrop != original.instnodrop;
+		e.changed_columns[13] = e.custom_data != original.custom_data;
+		e.changed_columns[14] = e.ornamenticon != original.ornamenticon;
+		e.changed_columns[15] = e.ornamentidfile != original.ornamentidfile;
+		e.changed_columns[16] = e.ornament_hero_model != original.ornament_hero_model;
+		e.changed_columns[17] = e.guid != original.guid;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const InventorySnapshots &e
@@ -234,24 +265,28 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.time_index));
-		v.push_back(columns[1] + " = " + std::to_string(e.charid));
-		v.push_back(columns[2] + " = " + std::to_string(e.slotid));
-		v.push_back(columns[3] + " = " + std::to_string(e.itemid));
-		v.push_back(columns[4] + " = " + std::to_string(e.charges));
-		v.push_back(columns[5] + " = " + std::to_string(e.color));
-		v.push_back(columns[6] + " = " + std::to_string(e.augslot1));
-		v.push_back(columns[7] + " = " + std::to_string(e.augslot2));
-		v.push_back(columns[8] + " = " + std::to_string(e.augslot3));
-		v.push_back(columns[9] + " = " + std::to_string(e.augslot4));
-		v.push_back(columns[10] + " = " + std::to_string(e.augslot5));
-		v.push_back(columns[11] + " = " + std::to_string(e.augslot6));
-		v.push_back(columns[12] + " = " + std::to_string(e.instnodrop));
-		v.push_back(columns[13] + " = '" + Strings::Escape(e.custom_data) + "'");
-		v.push_back(columns[14] + " = " + std::to_string(e.ornamenticon));
-		v.push_back(columns[15] + " = " + std::to_string(e.ornamentidfile));
-		v.push_back(columns[16] + " = " + std::to_string(e.ornament_hero_model));
-		v.push_back(columns[17] + " = " + std::to_string(e.guid));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.time_index)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.charid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.slotid)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.itemid)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.color)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.augslot1)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augslot2)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augslot3)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augslot4)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.augslot5)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.augslot6)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.instnodrop)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = '" + Strings::Escape(e.custom_data) + "'"); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.ornamenticon)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.ornamentidfile)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.ornament_hero_model)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.guid)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -438,6 +473,73 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static InventorySnapshots FromStmtRow(const mysql::StmtRow &row)
+	{
+		InventorySnapshots e{};
+
+		e.time_index          = row.Get<uint32_t>(0).value_or(0);
+		e.charid              = row.Get<uint32_t>(1).value_or(0);
+		e.slotid              = row.Get<uint32_t>(2).value_or(0);
+		e.itemid              = row.Get<uint32_t>(3).value_or(0);
+		e.charges             = row.Get<uint16_t>(4).value_or(0);
+		e.color               = row.Get<uint32_t>(5).value_or(0);
+		e.augslot1            = row.Get<uint32_t>(6).value_or(0);
+		e.augslot2            = row.Get<uint32_t>(7).value_or(0);
+		e.augslot3            = row.Get<uint32_t>(8).value_or(0);
+		e.augslot4            = row.Get<uint32_t>(9).value_or(0);
+		e.augslot5            = row.Get<uint32_t>(10).value_or(0);
+		e.augslot6            = row.Get<int32_t>(11).value_or(0);
+		e.instnodrop          = row.Get<uint8_t>(12).value_or(0);
+		e.custom_data         = row.GetStr(13).value_or("");
+		e.ornamenticon        = row.Get<uint32_t>(14).value_or(0);
+		e.ornamentidfile      = row.Get<uint32_t>(15).value_or(0);
+		e.ornament_hero_model = row.Get<int32_t>(16).value_or(0);
+		e.guid                = row.Get<uint64_t>(17).value_or(0);
+
+		return e;
+	}
+
+	static InventorySnapshots FindOnePrepared(
+		Database& db,
+		int inventory_snapshots_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { inventory_snapshots_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<InventorySnapshots> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<InventorySnapshots> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -542,7 +644,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<18> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.time_index));
@@ -567,13 +677,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
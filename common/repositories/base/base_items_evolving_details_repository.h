@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseItemsEvolvingDetailsRepository {
@@ -26,6 +28,9 @@ public:
 		uint32_t    type;
 		std::string sub_type;
 		int64_t     required_amount;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -170,6 +175,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		ItemsEvolvingDetails &e,
+		const ItemsEvolvingDetails &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.item_evo_id != original.item_evo_id;
+		e.changed_columns[2] = e.item_evolve_level != original.item_evolve_level;
+		e.changed_columns[3] = e.item_id != original.item_id;
+		e.changed_columns[4] = e.type != original.type;
+		e.changed_columns[5] = e.sub_type != original.sub_type;
+		e.changed_columns[6] = e.required_amount != original.required_amount;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const ItemsEvolvingDetails &e
@@ -179,12 +199,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.item_evo_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_evolve_level));
-		v.push_back(columns[3] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.type));
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.sub_type) + "'");
-		v.push_back(columns[6] + " = " + std::to_string(e.required_amount));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.item_evo_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_evolve_level)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.sub_type) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.required_amount)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -327,6 +351,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static ItemsEvolvingDetails FromStmtRow(const mysql::StmtRow &row)
+	{
+		ItemsEvolvingDetails e{};
+
+		e.id                = row.Get<uint32_t>(0).value_or(0);
+		e.item_evo_id       = row.Get<uint32_t>(1).value_or(0);
+		e.item_evolve_level = row.Get<uint32_t>(2).value_or(0);
+		e.item_id           = row.Get<uint32_t>(3).value_or(0);
+		e.type              = row.Get<uint32_t>(4).value_or(0);
+		e.sub_type          = row.GetStr(5).value_or("0");
+		e.required_amount   = row.Get<int64_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static ItemsEvolvingDetails FindOnePrepared(
+		Database& db,
+		int items_evolving_details_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { items_evolving_details_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<ItemsEvolvingDetails> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<ItemsEvolvingDetails> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -420,7 +500,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -434,13 +522,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseItemsRepository {
@@ -304,6 +306,9 @@ public:
 		int32_t     UNK240;
 		int32_t     UNK241;
 		int32_t     epicitem;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<285> changed_columns = std::bitset<285>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -1560,6 +1565,299 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Items &e,
+		const Items &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.minstatus != original.minstatus;
+		e.changed_columns[2] = e.Name != original.Name;
+		e.changed_columns[3] = e.aagi != original.aagi;
+		e.changed_columns[4] = e.ac != original.ac;
+		e.changed_columns[5] = e.accuracy != original.accuracy;
+		e.changed_columns[6] = e.acha != original.acha;
+		e.changed_columns[7] = e.adex != original.adex;
+		e.changed_columns[8] = e.aint != original.aint;
+		e.changed_columns[9] = e.artifactflag != original.artifactflag;
+		e.changed_columns[10] = e.asta != original.asta;
+		e.changed_columns[11] = e.astr != original.astr;
+		e.changed_columns[12] = e.attack != original.attack;
+		e.changed_columns[13] = e.augrestrict != original.augrestrict;
+		e.changed_columns[14] = e.augslot1type != original.augslot1type;
+		e.changed_columns[15] = e.augslot1visible != original.augslot1visible;
+		e.changed_columns[16] = e.augslot2type != original.augslot2type;
+		e.changed_columns[17] = e.augslot2visible != original.augslot2visible;
+		e.changed_columns[18] = e.augslot3type != original.augslot3type;
+		e.changed_columns[19] = e.augslot3visible != original.augslot3visible;
+		e.changed_columns[20] = e.augslot4type != original.augslot4type;
+		e.changed_columns[21] = e.augslot4visible != original.augslot4visible;
+		e.changed_columns[22] = e.augslot5type != original.augslot5type;
+		e.changed_columns[23] = e.augslot5visible != original.augslot5visible;
+		e.changed_columns[24] = e.augslot6type != original.augslot6type;
+		e.changed_columns[25] = e.augslot6visible != original.augslot6visible;
+		e.changed_columns[26] = e.augtype != original.augtype;
+		e.changed_columns[27] = e.avoidance != original.avoidance;
+		e.changed_columns[28] = e.awis != original.awis;
+		e.changed_columns[29] = e.bagsize != original.bagsize;
+		e.changed_columns[30] = e.bagslots != original.bagslots;
+		e.changed_columns[31] = e.bagtype != original.bagtype;
+		e.changed_columns[32] = e.bagwr != original.bagwr;
+		e.changed_columns[33] = e.banedmgamt != original.banedmgamt;
+		e.changed_columns[34] = e.banedmgraceamt != original.banedmgraceamt;
+		e.changed_columns[35] = e.banedmgbody != original.banedmgbody;
+		e.changed_columns[36] = e.banedmgrace != original.banedmgrace;
+		e.changed_columns[37] = e.bardtype != original.bardtype;
+		e.changed_columns[38] = e.bardvalue != original.bardvalue;
+		e.changed_columns[39] = e.book != original.book;
+		e.changed_columns[40] = e.casttime != original.casttime;
+		e.changed_columns[41] = e.casttime_ != original.casttime_;
+		e.changed_columns[42] = e.charmfile != original.charmfile;
+		e.changed_columns[43] = e.charmfileid != original.charmfileid;
+		e.changed_columns[44] = e.classes != original.classes;
+		e.changed_columns[45] = e.color != original.color;
+		e.changed_columns[46] = e.combateffects != original.combateffects;
+		e.changed_columns[47] = e.extradmgskill != original.extradmgskill;
+		e.changed_columns[48] = e.extradmgamt != original.extradmgamt;
+		e.changed_columns[49] = e.price != original.price;
+		e.changed_columns[50] = e.cr != original.cr;
+		e.changed_columns[51] = e.damage != original.damage;
+		e.changed_columns[52] = e.damageshield != original.damageshield;
+		e.changed_columns[53] = e.deity != original.deity;
+		e.changed_columns[54] = e.delay != original.delay;
+		e.changed_columns[55] = e.augdistiller != original.augdistiller;
+		e.changed_columns[56] = e.dotshielding != original.dotshielding;
+		e.changed_columns[57] = e.dr != original.dr;
+		e.changed_columns[58] = e.clicktype != original.clicktype;
+		e.changed_columns[59] = e.clicklevel2 != original.clicklevel2;
+		e.changed_columns[60] = e.elemdmgtype != original.elemdmgtype;
+		e.changed_columns[61] = e.elemdmgamt != original.elemdmgamt;
+		e.changed_columns[62] = e.endur != original.endur;
+		e.changed_columns[63] = e.factionamt1 != original.factionamt1;
+		e.changed_columns[64] = e.factionamt2 != original.factionamt2;
+		e.changed_columns[65] = e.factionamt3 != original.factionamt3;
+		e.changed_columns[66] = e.factionamt4 != original.factionamt4;
+		e.changed_columns[67] = e.factionmod1 != original.factionmod1;
+		e.changed_columns[68] = e.factionmod2 != original.factionmod2;
+		e.changed_columns[69] = e.factionmod3 != original.factionmod3;
+		e.changed_columns[70] = e.factionmod4 != original.factionmod4;
+		e.changed_columns[71] = e.filename != original.filename;
+		e.changed_columns[72] = e.focuseffect != original.focuseffect;
+		e.changed_columns[73] = e.fr != original.fr;
+		e.changed_columns[74] = e.fvnodrop != original.fvnodrop;
+		e.changed_columns[75] = e.haste != original.haste;
+		e.changed_columns[76] = e.clicklevel != original.clicklevel;
+		e.changed_columns[77] = e.hp != original.hp;
+		e.changed_columns[78] = e.regen != original.regen;
+		e.changed_columns[79] = e.icon != original.icon;
+		e.changed_columns[80] = e.idfile != original.idfile;
+		e.changed_columns[81] = e.itemclass != original.itemclass;
+		e.changed_columns[82] = e.itemtype != original.itemtype;
+		e.changed_columns[83] = e.ldonprice != original.ldonprice;
+		e.changed_columns[84] = e.ldontheme != original.ldontheme;
+		e.changed_columns[85] = e.ldonsold != original.ldonsold;
+		e.changed_columns[86] = e.light != original.light;
+		e.changed_columns[87] = e.lore != original.lore;
+		e.changed_columns[88] = e.loregroup != original.loregroup;
+		e.changed_columns[89] = e.magic != original.magic;
+		e.changed_columns[90] = e.mana != original.mana;
+		e.changed_columns[91] = e.manaregen != original.manaregen;
+		e.changed_columns[92] = e.enduranceregen != original.enduranceregen;
+		e.changed_columns[93] = e.material != original.material;
+		e.changed_columns[94] = e.herosforgemodel != original.herosforgemodel;
+		e.changed_columns[95] = e.maxcharges != original.maxcharges;
+		e.changed_columns[96] = e.mr != original.mr;
+		e.changed_columns[97] = e.nodrop != original.nodrop;
+		e.changed_columns[98] = e.norent != original.norent;
+		e.changed_columns[99] = e.pendingloreflag != original.pendingloreflag;
+		e.changed_columns[100] = e.pr != original.pr;
+		e.changed_columns[101] = e.procrate != original.procrate;
+		e.changed_columns[102] = e.races != original.races;
+		e.changed_columns[103] = e.range_ != original.range_;
+		e.changed_columns[104] = e.reclevel != original.reclevel;
+		e.changed_columns[105] = e.recskill != original.recskill;
+		e.changed_columns[106] = e.reqlevel != original.reqlevel;
+		e.changed_columns[107] = e.sellrate != original.sellrate;
+		e.changed_columns[108] = e.shielding != original.shielding;
+		e.changed_columns[109] = e.size != original.size;
+		e.changed_columns[110] = e.skillmodtype != original.skillmodtype;
+		e.changed_columns[111] = e.skillmodvalue != original.skillmodvalue;
+		e.changed_columns[112] = e.slots != original.slots;
+		e.changed_columns[113] = e.clickeffect != original.clickeffect;
+		e.changed_columns[114] = e.spellshield != original.spellshield;
+		e.changed_columns[115] = e.strikethrough != original.strikethrough;
+		e.changed_columns[116] = e.stunresist != original.stunresist;
+		e.changed_columns[117] = e.summonedflag != original.summonedflag;
+		e.changed_columns[118] = e.tradeskills != original.tradeskills;
+		e.changed_columns[119] = e.favor != original.favor;
+		e.changed_columns[120] = e.weight != original.weight;
+		e.changed_columns[121] = e.UNK012 != original.UNK012;
+		e.changed_columns[122] = e.UNK013 != original.UNK013;
+		e.changed_columns[123] = e.benefitflag != original.benefitflag;
+		e.changed_columns[124] = e.UNK054 != original.UNK054;
+		e.changed_columns[125] = e.UNK059 != original.UNK059;
+		e.changed_columns[126] = e.booktype != original.booktype;
+		e.changed_columns[127] = e.recastdelay != original.recastdelay;
+		e.changed_columns[128] = e.recasttype != original.recasttype;
+		e.changed_columns[129] = e.guildfavor != original.guildfavor;
+		e.changed_columns[130] = e.UNK123 != original.UNK123;
+		e.changed_columns[131] = e.UNK124 != original.UNK124;
+		e.changed_columns[132] = e.attuneable != original.attuneable;
+		e.changed_columns[133] = e.nopet != original.nopet;
+		e.changed_columns[134] = e.updated != original.updated;
+		e.changed_columns[135] = e.comment != original.comment;
+		e.changed_columns[136] = e.UNK127 != original.UNK127;
+		e.changed_columns[137] = e.pointtype != original.pointtype;
+		e.changed_columns[138] = e.potionbelt != original.potionbelt;
+		e.changed_columns[139] = e.potionbeltslots != original.potionbeltslots;
+		e.changed_columns[140] = e.stacksize != original.stacksize;
+		e.changed_columns[141] = e.notransfer != original.notransfer;
+		e.changed_columns[142] = e.stackable != original.stackable;
+		e.changed_columns[143] = e.UNK134 != original.UNK134;
+		e.changed_columns[144] = e.UNK137 != original.UNK137;
+		e.changed_columns[145] = e.proceffect != original.proceffect;
+		e.changed_columns[146] = e.proctype != original.proctype;
+		e.changed_columns[147] = e.proclevel2 != original.proclevel2;
+		e.changed_columns[148] = e.proclevel != original.proclevel;
+		e.changed_columns[149] = e.UNK142 != original.UNK142;
+		e.changed_columns[150] = e.worneffect != original.worneffect;
+		e.changed_columns[151] = e.worntype != original.worntype;
+		e.changed_columns[152] = e.wornlevel2 != original.wornlevel2;
+		e.changed_columns[153] = e.wornlevel != original.wornlevel;
+		e.changed_columns[154] = e.UNK147 != original.UNK147;
+		e.changed_columns[155] = e.focustype != original.focustype;
+		e.changed_columns[156] = e.focuslevel2 != original.focuslevel2;
+		e.changed_columns[157] = e.focuslevel != original.focuslevel;
+		e.changed_columns[158] = e.UNK152 != original.UNK152;
+		e.changed_columns[159] = e.scrolleffect != original.scrolleffect;
+		e.changed_columns[160] = e.scrolltype != original.scrolltype;
+		e.changed_columns[161] = e.scrolllevel2 != original.scrolllevel2;
+		e.changed_columns[162] = e.scrolllevel != original.scrolllevel;
+		e.changed_columns[163] = e.UNK157 != original.UNK157;
+		e.changed_columns[164] = e.serialized != original.serialized;
+		e.changed_columns[165] = e.verified != original.verified;
+		e.changed_columns[166] = e.serialization != original.serialization;
+		e.changed_columns[167] = e.source != original.source;
+		e.changed_columns[168] = e.UNK033 != original.UNK033;
+		e.changed_columns[169] = e.lorefile != original.lorefile;
+		e.changed_columns[170] = e.UNK014 != original.UNK014;
+		e.changed_columns[171] = e.svcorruption != original.svcorruption;
+		e.changed_columns[172] = e.skillmodmax != original.skillmodmax;
+		e.changed_columns[173] = e.UNK060 != original.UNK060;
+		e.changed_columns[174] = e.augslot1unk2 != original.augslot1unk2;
+		e.changed_columns[175] = e.augslot2unk2 != original.augslot2unk2;
+		e.changed_columns[176] = e.augslot3unk2 != original.augslot3unk2;
+		e.changed_columns[177] = e.augslot4unk2 != original.augslot4unk2;
+		e.changed_columns[178] = e.augslot5unk2 != original.augslot5unk2;
+		e.changed_columns[179] = e.augslot6unk2 != original.augslot6unk2;
+		e.changed_columns[180] = e.UNK120 != original.UNK120;
+		e.changed_columns[181] = e.UNK121 != original.UNK121;
+		e.changed_columns[182] = e.questitemflag != original.questitemflag;
+		e.changed_columns[183] = e.UNK132 != original.UNK132;
+		e.changed_columns[184] = e.clickunk5 != original.clickunk5;
+		e.changed_columns[185] = e.clickunk6 != original.clickunk6;
+		e.changed_columns[186] = e.clickunk7 != original.clickunk7;
+		e.changed_columns[187] = e.procunk1 != original.procunk1;
+		e.changed_columns[188] = e.procunk2 != original.procunk2;
+		e.changed_columns[189] = e.procunk3 != original.procunk3;
+		e.changed_columns[190] = e.procunk4 != original.procunk4;
+		e.changed_columns[191] = e.procunk6 != original.procunk6;
+		e.changed_columns[192] = e.procunk7 != original.procunk7;
+		e.changed_columns[193] = e.wornunk1 != original.wornunk1;
+		e.changed_columns[194] = e.wornunk2 != original.wornunk2;
+		e.changed_columns[195] = e.wornunk3 != original.wornunk3;
+		e.changed_columns[196] = e.wornunk4 != original.wornunk4;
+		e.changed_columns[197] = e.wornunk5 != original.wornunk5;
+		e.changed_columns[198] = e.wornunk6 != original.wornunk6;
+		e.changed_columns[199] = e.wornunk7 != original.wornunk7;
+		e.changed_columns[200] = e.focusunk1 != original.focusunk1;
+		e.changed_columns[201] = e.focusunk2 != original.focusunk2;
+		e.changed_columns[202] = e.focusunk3 != original.focusunk3;
+		e.changed_columns[203] = e.focusunk4 != original.focusunk4;
+		e.changed_columns[204] = e.focusunk5 != original.focusunk5;
+		e.changed_columns[205] = e.focusunk6 != original.focusunk6;
+		e.changed_columns[206] = e.focusunk7 != original.focusunk7;
+		e.changed_columns[207] = e.scrollunk1 != original.scrollunk1;
+		e.changed_columns[208] = e.scrollunk2 != original.scrollunk2;
+		e.changed_columns[209] = e.scrollunk3 != original.scrollunk3;
+		e.changed_columns[210] = e.scrollunk4 != original.scrollunk4;
+		e.changed_columns[211] = e.scrollunk5 != original.scrollunk5;
+		e.changed_columns[212] = e.scrollunk6 != original.scrollunk6;
+		e.changed_columns[213] = e.scrollunk7 != original.scrollunk7;
+		e.changed_columns[214] = e.UNK193 != original.UNK193;
+		e.changed_columns[215] = e.purity != original.purity;
+		e.changed_columns[216] = e.evoitem != original.evoitem;
+		e.changed_columns[217] = e.evoid != original.evoid;
+		e.changed_columns[218] = e.evolvinglevel != original.evolvinglevel;
+		e.changed_columns[219] = e.evomax != original.evomax;
+		e.changed_columns[220] = e.clickname != original.clickname;
+		e.changed_columns[221] = e.procname != original.procname;
+		e.changed_columns[222] = e.wornname != original.wornname;
+		e.changed_columns[223] = e.focusname != original.focusname;
+		e.changed_columns[224] = e.scrollname != original.scrollname;
+		e.changed_columns[225] = e.dsmitigation != original.dsmitigation;
+		e.changed_columns[226] = e.heroic_str != original.heroic_str;
+		e.changed_columns[227] = e.heroic_int != original.heroic_int;
+		e.changed_columns[228] = e.heroic_wis != original.heroic_wis;
+		e.changed_columns[229] = e.heroic_agi != original.heroic_agi;
+		e.changed_columns[230] = e.heroic_dex != original.heroic_dex;
+		e.changed_columns[231] = e.heroic_sta != original.heroic_sta;
+		e.changed_columns[232] = e.heroic_cha != original.heroic_cha;
+		e.changed_columns[233] = e.heroic_pr != original.heroic_pr;
+		e.changed_columns[234] = e.heroic_dr != original.heroic_dr;
+		e.changed_columns[235] = e.heroic_fr != original.heroic_fr;
+		e.changed_columns[236] = e.heroic_cr != original.heroic_cr;
+		e.changed_columns[237] = e.heroic_mr != original.heroic_mr;
+		e.changed_columns[238] = e.heroic_svcorrup != original.heroic_svcorrup;
+		e.changed_columns[239] = e.healamt != original.healamt;
+		e.changed_columns[240] = e.spelldmg != original.spelldmg;
+		e.changed_columns[241] = e.clairvoyance != original.clairvoyance;
+		e.changed_columns[242] = e.backstabdmg != original.backstabdmg;
+		e.changed_columns[243] = e.created != original.created;
+		e.changed_columns[244] = e.elitematerial != original.elitematerial;
+		e.changed_columns[245] = e.ldonsellbackrate != original.ldonsellbackrate;
+		e.changed_columns[246] = e.scriptfileid != original.scriptfileid;
+		e.changed_columns[247] = e.expendablearrow != original.expendablearrow;
+		e.changed_columns[248] = e.powersourcecapacity != original.powersourcecapacity;
+		e.changed_columns[249] = e.bardeffect != original.bardeffect;
+		e.changed_columns[250] = e.bardeffecttype != original.bardeffecttype;
+		e.changed_columns[251] = e.bardlevel2 != original.bardlevel2;
+		e.changed_columns[252] = e.bardlevel != original.bardlevel;
+		e.changed_columns[253] = e.bardunk1 != original.bardunk1;
+		e.changed_columns[254] = e.bardunk2 != original.bardunk2;
+		e.changed_columns[255] = e.bardunk3 != original.bardunk3;
+		e.changed_columns[256] = e.bardunk4 != original.bardunk4;
+		e.changed_columns[257] = e.bardunk5 != original.bardunk5;
+		e.changed_columns[258] = e.bardname != original.bardname;
+		e.changed_columns[259] = e.bardunk7 != original.bardunk7;
+		e.changed_columns[260] = e.UNK214 != original.UNK214;
+		e.changed_columns[261] = e.subtype != original.subtype;
+		e.changed_columns[262] = e.UNK220 != original.UNK220;
+		e.changed_columns[263] = e.UNK221 != original.UNK221;
+		e.changed_columns[264] = e.heirloom != original.heirloom;
+		e.changed_columns[265] = e.UNK223 != original.UNK223;
+		e.changed_columns[266] = e.UNK224 != original.UNK224;
+		e.changed_columns[267] = e.UNK225 != original.UNK225;
+		e.changed_columns[268] = e.UNK226 != original.UNK226;
+		e.changed_columns[269] = e.UNK227 != original.UNK227;
+		e.changed_columns[270] = e.UNK228 != original.UNK228;
+		e.changed_columns[271] = e.UNK229 != original.UNK229;
+		e.changed_columns[272] = e.UNK230 != original.UNK230;
+		e.changed_columns[273] = e.UNK231 != original.UNK231;
+		e.changed_columns[274] = e.UNK232 != original.UNK232;
+		e.changed_columns[275] = e.UNK233 != original.UNK233;
+		e.changed_columns[276] = e.UNK234 != original.UNK234;
+		e.changed_columns[277] = e.placeable != original.placeable;
+		e.changed_columns[278] = e.UNK236 != original.UNK236;
+		e.changed_columns[279] = e.UNK237 != original.UNK237;
+		e.changed_columns[280] = e.UNK238 != original.UNK238;
+		e.changed_columns[281] = e.UNK239 != original.UNK239;
+		e.changed_columns[282] = e.UNK240 != original.UNK240;
+		e.changed_columns[283] = e.UNK241 != original.UNK241;
+		e.changed_columns[284] = e.epicitem != original.epicitem;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Items &e
@@ -1569,291 +1867,295 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.minstatus));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.Name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.aagi));
-		v.push_back(columns[4] + " = " + std::to_string(e.ac));
-		v.push_back(columns[5] + " = " + std::to_string(e.accuracy));
-		v.push_back(columns[6] + " = " + std::to_string(e.acha));
-		v.push_back(columns[7] + " = " + std::to_string(e.adex));
-		v.push_back(columns[8] + " = " + std::to_string(e.aint));
-		v.push_back(columns[9] + " = " + std::to_string(e.artifactflag));
-		v.push_back(columns[10] + " = " + std::to_string(e.asta));
-		v.push_back(columns[11] + " = " + std::to_string(e.astr));
-		v.push_back(columns[12] + " = " + std::to_string(e.attack));
-		v.push_back(columns[13] + " = " + std::to_string(e.augrestrict));
-		v.push_back(columns[14] + " = " + std::to_string(e.augslot1type));
-		v.push_back(columns[15] + " = " + std::to_string(e.augslot1visible));
-		v.push_back(columns[16] + " = " + std::to_string(e.augslot2type));
-		v.push_back(columns[17] + " = " + std::to_string(e.augslot2visible));
-		v.push_back(columns[18] + " = " + std::to_string(e.augslot3type));
-		v.push_back(columns[19] + " = " + std::to_string(e.augslot3visible));
-		v.push_back(columns[20] + " = " + std::to_string(e.augslot4type));
-		v.push_back(columns[21] + " = " + std::to_string(e.augslot4visible));
-		v.push_back(columns[22] + " = " + std::to_string(e.augslot5type));
-		v.push_back(columns[23] + " = " + std::to_string(e.augslot5visible));
-		v.push_back(columns[24] + " = " + std::to_string(e.augslot6type));
-		v.push_back(columns[25] + " = " + std::to_string(e.augslot6visible));
-		v.push_back(columns[26] + " = " + std::to_string(e.augtype));
-		v.push_back(columns[27] + " = " + std::to_string(e.avoidance));
-		v.push_back(columns[28] + " = " + std::to_string(e.awis));
-		v.push_back(columns[29] + " = " + std::to_string(e.bagsize));
-		v.push_back(columns[30] + " = " + std::to_string(e.bagslots));
-		v.push_back(columns[31] + " = " + std::to_string(e.bagtype));
-		v.push_back(columns[32] + " = " + std::to_string(e.bagwr));
-		v.push_back(columns[33] + " = " + std::to_string(e.banedmgamt));
-		v.push_back(columns[34] + " = " + std::to_string(e.banedmgraceamt));
-		v.push_back(columns[35] + " = " + std::to_string(e.banedmgbody));
-		v.push_back(columns[36] + " = " + std::to_string(e.banedmgrace));
-		v.push_back(columns[37] + " = " + std::to_string(e.bardtype));
-		v.push_back(columns[38] + " = " + std::to_string(e.bardvalue));
-		v.push_back(columns[39] + " = " + std::to_string(e.book));
-		v.push_back(columns[40] + " = " + std::to_string(e.casttime));
-		v.push_back(columns[41] + " = " + std::to_string(e.casttime_));
-		v.push_back(columns[42] + " = '" + Strings::Escape(e.charmfile) + "'");
-		v.push_back(columns[43] + " = '" + Strings::Escape(e.charmfileid) + "'");
-		v.push_back(columns[44] + " = " + std::to_string(e.classes));
-		v.push_back(columns[45] + " = " + std::to_string(e.color));
-		v.push_back(columns[46] + " = '" + Strings::Escape(e.combateffects) + "'");
-		v.push_back(columns[47] + " = " + std::to_string(e.extradmgskill));
-		v.push_back(columns[48] + " = " + std::to_string(e.extradmgamt));
-		v.push_back(columns[49] + " = " + std::to_string(e.price));
-		v.push_back(columns[50] + " = " + std::to_string(e.cr));
-		v.push_back(columns[51] + " = " + std::to_string(e.damage));
-		v.push_back(columns[52] + " = " + std::to_string(e.damageshield));
-		v.push_back(columns[53] + " = " + std::to_string(e.deity));
-		v.push_back(columns[54] + " = " + std::to_string(e.delay));
-		v.push_back(columns[55] + " = " + std::to_string(e.augdistiller));
-		v.push_back(columns[56] + " = " + std::to_string(e.dotshielding));
-		v.push_back(columns[57] + " = " + std::to_string(e.dr));
-		v.push_back(columns[58] + " = " + std::to_string(e.clicktype));
-		v.push_back(columns[59] + " = " + std::to_string(e.clicklevel2));
-		v.push_back(columns[60] + " = " + std::to_string(e.elemdmgtype));
-		v.push_back(columns[61] + " = " + std::to_string(e.elemdmgamt));
-		v.push_back(columns[62] + " = " + std::to_string(e.endur));
-		v.push_back(columns[63] + " = " + std::to_string(e.factionamt1));
-		v.push_back(columns[64] + " = " + std::to_string(e.factionamt2));
-		v.push_back(columns[65] + " = " + std::to_string(e.factionamt3));
-		v.push_back(columns[66] + " = " + std::to_string(e.factionamt4));
-		v.push_back(columns[67] + " = " + std::to_string(e.factionmod1));
-		v.push_back(columns[68] + " = " + std::to_string(e.factionmod2));
-		v.push_back(columns[69] + " = " + std::to_string(e.factionmod3));
-		v.push_back(columns[70] + " = " + std::to_string(e.factionmod4));
-		v.push_back(columns[71] + " = '" + Strings::Escape(e.filename) + "'");
-		v.push_back(columns[72] + " = " + std::to_string(e.focuseffect));
-		v.push_back(columns[73] + " = " + std::to_string(e.fr));
-		v.push_back(columns[74] + " = " + std::to_string(e.fvnodrop));
-		v.push_back(columns[75] + " = " + std::to_string(e.haste));
-		v.push_back(columns[76] + " = " + std::to_string(e.clicklevel));
-		v.push_back(columns[77] + " = " + std::to_string(e.hp));
-		v.push_back(columns[78] + " = " + std::to_string(e.regen));
-		v.push_back(columns[79] + " = " + std::to_string(e.icon));
-		v.push_back(columns[80] + " = '" + Strings::Escape(e.idfile) + "'");
-		v.push_back(columns[81] + " = " + std::to_string(e.itemclass));
-		v.push_back(columns[82] + " = " + std::to_string(e.itemtype));
-		v.push_back(columns[83] + " = " + std::to_string(e.ldonprice));
-		v.push_back(columns[84] + " = " + std::to_string(e.ldontheme));
-		v.push_back(columns[85] + " = " + std::to_string(e.ldonsold));
-		v.push_back(columns[86] + " = " + std::to_string(e.light));
-		v.push_back(columns[87] + " = '" + Strings::Escape(e.lore) + "'");
-		v.push_back(columns[88] + " = " + std::to_string(e.loregroup));
-		v.push_back(columns[89] + " = " + std::to_string(e.magic));
-		v.push_back(columns[90] + " = " + std::to_string(e.mana));
-		v.push_back(columns[91] + " = " + std::to_string(e.manaregen));
-		v.push_back(columns[92] + " = " + std::to_string(e.enduranceregen));
-		v.push_back(columns[93] + " = " + std::to_string(e.material));
-		v.push_back(columns[94] + " = " + std::to_string(e.herosforgemodel));
-		v.push_back(columns[95] + " = " + std::to_string(e.maxcharges));
-		v.push_back(columns[96] + " = " + std::to_string(e.mr));
-		v.push_back(columns[97] + " = " + std::to_string(e.nodrop));
-		v.push_back(columns[98] + " = " + std::to_string(e.norent));
-		v.push_back(columns[99] + " = " + std::to_string(e.pendingloreflag));
-		v.push_back(columns[100] + " = " + std::to_string(e.pr));
-		v.push_back(columns[101] + " = " + std::to_string(e.procrate));
-		v.push_back(columns[102] + " = " + std::to_string(e.races));
-		v.push_back(columns[103] + " = " + std::to_string(e.range_));
-		v.push_back(columns[104] + " = " + std::to_string(e.reclevel));
-		v.push_back(columns[105] + " = " + std::to_string(e.recskill));
-		v.push_back(columns[106] + " = " + std::to_string(e.reqlevel));
-		v.push_back(columns[107] + " = " + std::to_string(e.sellrate));
-		v.push_back(columns[108] + " = " + std::to_string(e.shielding));
-		v.push_back(columns[109] + " = " + std::to_string(e.size));
-		v.push_back(columns[110] + " = " + std::to_string(e.skillmodtype));
-		v.push_back(columns[111] + " = " + std::to_string(e.skillmodvalue));
-		v.push_back(columns[112] + " = " + std::to_string(e.slots));
-		v.push_back(columns[113] + " = " + std::to_string(e.clickeffect));
-		v.push_back(columns[114] + " = " + std::to_string(e.spellshield));
-		v.push_back(columns[115] + " = " + std::to_string(e.strikethrough));
-		v.push_back(columns[116] + " = " + std::to_string(e.stunresist));
-		v.push_back(columns[117] + " = " + std::to_string(e.summonedflag));
-		v.push_back(columns[118] + " = " + std::to_string(e.tradeskills));
-		v.push_back(columns[119] + " = " + std::to_string(e.favor));
-		v.push_back(columns[120] + " = " + std::to_string(e.weight));
-		v.push_back(columns[121] + " = " + std::to_string(e.UNK012));
-		v.push_back(columns[122] + " = " + std::to_string(e.UNK013));
-		v.push_back(columns[123] + " = " + std::to_string(e.benefitflag));
-		v.push_back(columns[124] + " = " + std::to_string(e.UNK054));
-		v.push_back(columns[125] + " = " + std::to_string(e.UNK059));
-		v.push_back(columns[126] + " = " + std::to_string(e.booktype));
-		v.push_back(columns[127] + " = " + std::to_string(e.recastdelay));
-		v.push_back(columns[128] + " = " + std::to_string(e.recasttype));
-		v.push_back(columns[129] + " = " + std::to_string(e.guildfavor));
-		v.push_back(columns[130] + " = " + std::to_string(e.UNK123));
-		v.push_back(columns[131] + " = " + std::to_string(e.UNK124));
-		v.push_back(columns[132] + " = " + std::to_string(e.attuneable));
-		v.push_back(columns[133] + " = " + std::to_string(e.nopet));
-		v.push_back(columns[134] + " = FROM_UNIXTIME(" + (e.updated > 0 ? std::to_string(e.updated) : "null") + ")");
-		v.push_back(columns[135] + " = '" + Strings::Escape(e.comment) + "'");
-		v.push_back(columns[136] + " = " + std::to_string(e.UNK127));
-		v.push_back(columns[137] + " = " + std::to_string(e.pointtype));
-		v.push_back(columns[138] + " = " + std::to_string(e.potionbelt));
-		v.push_back(columns[139] + " = " + std::to_string(e.potionbeltslots));
-		v.push_back(columns[140] + " = " + std::to_string(e.stacksize));
-		v.push_back(columns[141] + " = " + std::to_string(e.notransfer));
-		v.push_back(columns[142] + " = " + std::to_string(e.stackable));
-		v.push_back(columns[143] + " = '" + Strings::Escape(e.UNK134) + "'");
-		v.push_back(columns[144] + " = " + std::to_string(e.UNK137));
-		v.push_back(columns[145] + " = " + std::to_string(e.proceffect));
-		v.push_back(columns[146] + " = " + std::to_string(e.proctype));
-		v.push_back(columns[147] + " = " + std::to_string(e.proclevel2));
-		v.push_back(columns[148] + " = " + std::to_string(e.proclevel));
-		v.push_back(columns[149] + " = " + std::to_string(e.UNK142));
-		v.push_back(columns[150] + " = " + std::to_string(e.worneffect));
-		v.push_back(columns[151] + " = " + std::to_string(e.worntype));
-		v.push_back(columns[152] + " = " + std::to_string(e.wornlevel2));
-		v.push_back(columns[153] + " = " + std::to_string(e.wornlevel));
-		v.push_back(columns[154] + " = " + std::to_string(e.UNK147));
-		v.push_back(columns[155] + " = " + std::to_string(e.focustype));
-		v.push_back(columns[156] + " = " + std::to_string(e.focuslevel2));
-		v.push_back(columns[157] + " = " + std::to_string(e.focuslevel));
-		v.push_back(columns[158] + " = " + std::to_string(e.UNK152));
-		v.push_back(columns[159] + " = " + std::to_string(e.scrolleffect));
-		v.push_back(columns[160] + " = " + std::to_string(e.scrolltype));
-		v.push_back(columns[161] + " = " + std::to_string(e.scrolllevel2));
-		v.push_back(columns[162] + " = " + std::to_string(e.scrolllevel));
-		v.push_back(columns[163] + " = " + std::to_string(e.UNK157));
-		v.push_back(columns[164] + " = FROM_UNIXTIME(" + (e.serialized > 0 ? std::to_string(e.serialized) : "null") + ")");
-		v.push_back(columns[165] + " = FROM_UNIXTIME(" + (e.verified > 0 ? std::to_string(e.verified) : "null") + ")");
-		v.push_back(columns[166] + " = '" + Strings::Escape(e.serialization) + "'");
-		v.push_back(columns[167] + " = '" + Strings::Escape(e.source) + "'");
-		v.push_back(columns[168] + " = " + std::to_string(e.UNK033));
-		v.push_back(columns[169] + " = '" + Strings::Escape(e.lorefile) + "'");
-		v.push_back(columns[170] + " = " + std::to_string(e.UNK014));
-		v.push_back(columns[171] + " = " + std::to_string(e.svcorruption));
-		v.push_back(columns[172] + " = " + std::to_string(e.skillmodmax));
-		v.push_back(columns[173] + " = " + std::to_string(e.UNK060));
-		v.push_back(columns[174] + " = " + std::to_string(e.augslot1unk2));
-		v.push_back(columns[175] + " = " + std::to_string(e.augslot2unk2));
-		v.push_back(columns[176] + " = " + std::to_string(e.augslot3unk2));
-		v.push_back(columns[177] + " = " + std::to_string(e.augslot4unk2));
-		v.push_back(columns[178] + " = " + std::to_string(e.augslot5unk2));
-		v.push_back(columns[179] + " = " + std::to_string(e.augslot6unk2));
-		v.push_back(columns[180] + " = " + std::to_string(e.UNK120));
-		v.push_back(columns[181] + " = " + std::to_string(e.UNK121));
-		v.push_back(columns[182] + " = " + std::to_string(e.questitemflag));
-		v.push_back(columns[183] + " = '" + Strings::Escape(e.UNK132) + "'");
-		v.push_back(columns[184] + " = " + std::to_string(e.clickunk5));
-		v.push_back(columns[185] + " = '" + Strings::Escape(e.clickunk6) + "'");
-		v.push_back(columns[186] + " = " + std::to_string(e.clickunk7));
-		v.push_back(columns[187] + " = " + std::to_string(e.procunk1));
-		v.push_back(columns[188] + " = " + std::to_string(e.procunk2));
-		v.push_back(columns[189] + " = " + std::to_string(e.procunk3));
-		v.push_back(columns[190] + " = " + std::to_string(e.procunk4));
-		v.push_back(columns[191] + " = '" + Strings::Escape(e.procunk6) + "'");
-		v.push_back(columns[192] + " = " + std::to_string(e.procunk7));
-		v.push_back(columns[193] + " = " + std::to_string(e.wornunk1));
-		v.push_back(columns[194] + " = " + std::to_string(e.wornunk2));
-		v.push_back(columns[195] + " = " + std::to_string(e.wornunk3));
-		v.push_back(columns[196] + " = " + std::to_string(e.wornunk4));
-		v.push_back(columns[197] + " = " + std::to_string(e.wornunk5));
-		v.push_back(columns[198] + " = '" + Strings::Escape(e.wornunk6) + "'");
-		v.push_back(columns[199] + " = " + std::to_string(e.wornunk7));
-		v.push_back(columns[200] + " = " + std::to_string(e.focusunk1));
-		v.push_back(columns[201] + " = " + std::to_string(e.focusunk2));
-		v.push_back(columns[202] + " = " + std::to_string(e.focusunk3));
-		v.push_back(columns[203] + " = " + std::to_string(e.focusunk4));
-		v.push_back(columns[204] + " = " + std::to_string(e.focusunk5));
-		v.push_back(columns[205] + " = '" + Strings::Escape(e.focusunk6) + "'");
-		v.push_back(columns[206] + " = " + std::to_string(e.focusunk7));
-		v.push_back(columns[207] + " = " + std::to_string(e.scrollunk1));
-		v.push_back(columns[208] + " = " + std::to_string(e.scrollunk2));
-		v.push_back(columns[209] + " = " + std::to_string(e.scrollunk3));
-		v.push_back(columns[210] + " = " + std::to_string(e.scrollunk4));
-		v.push_back(columns[211] + " = " + std::to_string(e.scrollunk5));
-		v.push_back(columns[212] + " = '" + Strings::Escape(e.scrollunk6) + "'");
-		v.push_back(columns[213] + " = " + std::to_string(e.scrollunk7));
-		v.push_back(columns[214] + " = " + std::to_string(e.UNK193));
-		v.push_back(columns[215] + " = " + std::to_string(e.purity));
-		v.push_back(columns[216] + " = " + std::to_string(e.evoitem));
-		v.push_back(columns[217] + " = " + std::to_string(e.evoid));
-		v.push_back(columns[218] + " = " + std::to_string(e.evolvinglevel));
-		v.push_back(columns[219] + " = " + std::to_string(e.evomax));
-		v.push_back(columns[220] + " = '" + Strings::Escape(e.clickname) + "'");
-		v.push_back(columns[221] + " = '" + Strings::Escape(e.procname) + "'");
-		v.push_back(columns[222] + " = '" + Strings::Escape(e.wornname) + "'");
-		v.push_back(columns[223] + " = '" + Strings::Escape(e.focusname) + "'");
-		v.push_back(columns[224] + " = '" + Strings::Escape(e.scrollname) + "'");
-		v.push_back(columns[225] + " = " + std::to_string(e.dsmitigation));
-		v.push_back(columns[226] + " = " + std::to_string(e.heroic_str));
-		v.push_back(columns[227] + " = " + std::to_string(e.heroic_int));
-		v.push_back(columns[228] + " = " + std::to_string(e.heroic_wis));
-		v.push_back(columns[229] + " = " + std::to_string(e.heroic_agi));
-		v.push_back(columns[230] + " = " + std::to_string(e.heroic_dex));
-		v.push_back(columns[231] + " = " + std::to_string(e.heroic_sta));
-		v.push_back(columns[232] + " = " + std::to_string(e.heroic_cha));
-		v.push_back(columns[233] + " = " + std::to_string(e.heroic_pr));
-		v.push_back(columns[234] + " = " + std::to_string(e.heroic_dr));
-		v.push_back(columns[235] + " = " + std::to_string(e.heroic_fr));
-		v.push_back(columns[236] + " = " + std::to_string(e.heroic_cr));
-		v.push_back(columns[237] + " = " + std::to_string(e.heroic_mr));
-		v.push_back(columns[238] + " = " + std::to_string(e.heroic_svcorrup));
-		v.push_back(columns[239] + " = " + std::to_string(e.healamt));
-		v.push_back(columns[240] + " = " + std::to_string(e.spelldmg));
-		v.push_back(columns[241] + " = " + std::to_string(e.clairvoyance));
-		v.push_back(columns[242] + " = " + std::to_string(e.backstabdmg));
-		v.push_back(columns[243] + " = '" + Strings::Escape(e.created) + "'");
-		v.push_back(columns[244] + " = " + std::to_string(e.elitematerial));
-		v.push_back(columns[245] + " = " + std::to_string(e.ldonsellbackrate));
-		v.push_back(columns[246] + " = " + std::to_string(e.scriptfileid));
-		v.push_back(columns[247] + " = " + std::to_string(e.expendablearrow));
-		v.push_back(columns[248] + " = " + std::to_string(e.powersourcecapacity));
-		v.push_back(columns[249] + " = " + std::to_string(e.bardeffect));
-		v.push_back(columns[250] + " = " + std::to_string(e.bardeffecttype));
-		v.push_back(columns[251] + " = " + std::to_string(e.bardlevel2));
-		v.push_back(columns[252] + " = " + std::to_string(e.bardlevel));
-		v.push_back(columns[253] + " = " + std::to_string(e.bardunk1));
-		v.push_back(columns[254] + " = " + std::to_string(e.bardunk2));
-		v.push_back(columns[255] + " = " + std::to_string(e.bardunk3));
-		v.push_back(columns[256] + " = " + std::to_string(e.bardunk4));
-		v.push_back(columns[257] + " = " + std::to_string(e.bardunk5));
-		v.push_back(columns[258] + " = '" + Strings::Escape(e.bardname) + "'");
-		v.push_back(columns[259] + " = " + std::to_string(e.bardunk7));
-		v.push_back(columns[260] + " = " + std::to_string(e.UNK214));
-		v.push_back(columns[261] + " = " + std::to_string(e.subtype));
-		v.push_back(columns[262] + " = " + std::to_string(e.UNK220));
-		v.push_back(columns[263] + " = " + std::to_string(e.UNK221));
-		v.push_back(columns[264] + " = " + std::to_string(e.heirloom));
-		v.push_back(columns[265] + " = " + std::to_string(e.UNK223));
-		v.push_back(columns[266] + " = " + std::to_string(e.UNK224));
-		v.push_back(columns[267] + " = " + std::to_string(e.UNK225));
-		v.push_back(columns[268] + " = " + std::to_string(e.UNK226));
-		v.push_back(columns[269] + " = " + std::to_string(e.UNK227));
-		v.push_back(columns[270] + " = " + std::to_string(e.UNK228));
-		v.push_back(columns[271] + " = " + std::to_string(e.UNK229));
-		v.push_back(columns[272] + " = " + std::to_string(e.UNK230));
-		v.push_back(columns[273] + " = " + std::to_string(e.UNK231));
-		v.push_back(columns[274] + " = " + std::to_string(e.UNK232));
-		v.push_back(columns[275] + " = " + std::to_string(e.UNK233));
-		v.push_back(columns[276] + " = " + std::to_string(e.UNK234));
-		v.push_back(columns[277] + " = " + std::to_string(e.placeable));
-		v.push_back(columns[278] + " = " + std::to_string(e.UNK236));
-		v.push_back(columns[279] + " = " + std::to_string(e.UNK237));
-		v.push_back(columns[280] + " = " + std::to_string(e.UNK238));
-		v.push_back(columns[281] + " = " + std::to_string(e.UNK239));
-		v.push_back(columns[282] + " = " + std::to_string(e.UNK240));
-		v.push_back(columns[283] + " = " + std::to_string(e.UNK241));
-		v.push_back(columns[284] + " = " + std::to_string(e.epicitem));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.minstatus)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.Name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.aagi)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.ac)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.accuracy)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.acha)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.adex)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.aint)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.artifactflag)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.asta)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.astr)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.attack)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.augrestrict)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.augslot1type)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.augslot1visible)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.augslot2type)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.augslot2visible)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.augslot3type)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.augslot3visible)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.augslot4type)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.augslot4visible)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.augslot5type)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.augslot5visible)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.augslot6type)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.augslot6visible)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.augtype)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.avoidance)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.awis)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.bagsize)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.bagslots)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.bagtype)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.bagwr)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.banedmgamt)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.banedmgraceamt)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.banedmgbody)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.banedmgrace)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.bardtype)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.bardvalue)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.book)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.casttime)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.casttime_)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = '" + Strings::Escape(e.charmfile) + "'"); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = '" + Strings::Escape(e.charmfileid) + "'"); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.classes)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.color)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = '" + Strings::Escape(e.combateffects) + "'"); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.extradmgskill)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.extradmgamt)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.price)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.cr)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.damage)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.damageshield)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.deity)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.delay)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.augdistiller)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.dotshielding)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.dr)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = " + std::to_string(e.clicktype)); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.clicklevel2)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.elemdmgtype)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.elemdmgamt)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.endur)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.factionamt1)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.factionamt2)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.factionamt3)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.factionamt4)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.factionmod1)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.factionmod2)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.factionmod3)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.factionmod4)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = '" + Strings::Escape(e.filename) + "'"); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = " + std::to_string(e.focuseffect)); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = " + std::to_string(e.fr)); }
+		if (e.changed_columns[74]) { v.push_back(columns[74] + " = " + std::to_string(e.fvnodrop)); }
+		if (e.changed_columns[75]) { v.push_back(columns[75] + " = " + std::to_string(e.haste)); }
+		if (e.changed_columns[76]) { v.push_back(columns[76] + " = " + std::to_string(e.clicklevel)); }
+		if (e.changed_columns[77]) { v.push_back(columns[77] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[78]) { v.push_back(columns[78] + " = " + std::to_string(e.regen)); }
+		if (e.changed_columns[79]) { v.push_back(columns[79] + " = " + std::to_string(e.icon)); }
+		if (e.changed_columns[80]) { v.push_back(columns[80] + " = '" + Strings::Escape(e.idfile) + "'"); }
+		if (e.changed_columns[81]) { v.push_back(columns[81] + " = " + std::to_string(e.itemclass)); }
+		if (e.changed_columns[82]) { v.push_back(columns[82] + " = " + std::to_string(e.itemtype)); }
+		if (e.changed_columns[83]) { v.push_back(columns[83] + " = " + std::to_string(e.ldonprice)); }
+		if (e.changed_columns[84]) { v.push_back(columns[84] + " = " + std::to_string(e.ldontheme)); }
+		if (e.changed_columns[85]) { v.push_back(columns[85] + " = " + std::to_string(e.ldonsold)); }
+		if (e.changed_columns[86]) { v.push_back(columns[86] + " = " + std::to_string(e.light)); }
+		if (e.changed_columns[87]) { v.push_back(columns[87] + " = '" + Strings::Escape(e.lore) + "'"); }
+		if (e.changed_columns[88]) { v.push_back(columns[88] + " = " + std::to_string(e.loregroup)); }
+		if (e.changed_columns[89]) { v.push_back(columns[89] + " = " + std::to_string(e.magic)); }
+		if (e.changed_columns[90]) { v.push_back(columns[90] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[91]) { v.push_back(columns[91] + " = " + std::to_string(e.manaregen)); }
+		if (e.changed_columns[92]) { v.push_back(columns[92] + " = " + std::to_string(e.enduranceregen)); }
+		if (e.changed_columns[93]) { v.push_back(columns[93] + " = " + std::to_string(e.material)); }
+		if (e.changed_columns[94]) { v.push_back(columns[94] + " = " + std::to_string(e.herosforgemodel)); }
+		if (e.changed_columns[95]) { v.push_back(columns[95] + " = " + std::to_string(e.maxcharges)); }
+		if (e.changed_columns[96]) { v.push_back(columns[96] + " = " + std::to_string(e.mr)); }
+		if (e.changed_columns[97]) { v.push_back(columns[97] + " = " + std::to_string(e.nodrop)); }
+		if (e.changed_columns[98]) { v.push_back(columns[98] + " = " + std::to_string(e.norent)); }
+		if (e.changed_columns[99]) { v.push_back(columns[99] + " = " + std::to_string(e.pendingloreflag)); }
+		if (e.changed_columns[100]) { v.push_back(columns[100] + " = " + std::to_string(e.pr)); }
+		if (e.changed_columns[101]) { v.push_back(columns[101] + " = " + std::to_string(e.procrate)); }
+		if (e.changed_columns[102]) { v.push_back(columns[102] + " = " + std::to_string(e.races)); }
+		if (e.changed_columns[103]) { v.push_back(columns[103] + " = " + std::to_string(e.range_)); }
+		if (e.changed_columns[104]) { v.push_back(columns[104] + " = " + std::to_string(e.reclevel)); }
+		if (e.changed_columns[105]) { v.push_back(columns[105] + " = " + std::to_string(e.recskill)); }
+		if (e.changed_columns[106]) { v.push_back(columns[106] + " = " + std::to_string(e.reqlevel)); }
+		if (e.changed_columns[107]) { v.push_back(columns[107] + " = " + std::to_string(e.sellrate)); }
+		if (e.changed_columns[108]) { v.push_back(columns[108] + " = " + std::to_string(e.shielding)); }
+		if (e.changed_columns[109]) { v.push_back(columns[109] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[110]) { v.push_back(columns[110] + " = " + std::to_string(e.skillmodtype)); }
+		if (e.changed_columns[111]) { v.push_back(columns[111] + " = " + std::to_string(e.skillmodvalue)); }
+		if (e.changed_columns[112]) { v.push_back(columns[112] + " = " + std::to_string(e.slots)); }
+		if (e.changed_columns[113]) { v.push_back(columns[113] + " = " + std::to_string(e.clickeffect)); }
+		if (e.changed_columns[114]) { v.push_back(columns[114] + " = " + std::to_string(e.spellshield)); }
+		if (e.changed_columns[115]) { v.push_back(columns[115] + " = " + std::to_string(e.strikethrough)); }
+		if (e.changed_columns[116]) { v.push_back(columns[116] + " = " + std::to_string(e.stunresist)); }
+		if (e.changed_columns[117]) { v.push_back(columns[117] + " = " + std::to_string(e.summonedflag)); }
+		if (e.changed_columns[118]) { v.push_back(columns[118] + " = " + std::to_string(e.tradeskills)); }
+		if (e.changed_columns[119]) { v.push_back(columns[119] + " = " + std::to_string(e.favor)); }
+		if (e.changed_columns[120]) { v.push_back(columns[120] + " = " + std::to_string(e.weight)); }
+		if (e.changed_columns[121]) { v.push_back(columns[121] + " = " + std::to_string(e.UNK012)); }
+		if (e.changed_columns[122]) { v.push_back(columns[122] + " = " + std::to_string(e.UNK013)); }
+		if (e.changed_columns[123]) { v.push_back(columns[123] + " = " + std::to_string(e.benefitflag)); }
+		if (e.changed_columns[124]) { v.push_back(columns[124] + " = " + std::to_string(e.UNK054)); }
+		if (e.changed_columns[125]) { v.push_back(columns[125] + " = " + std::to_string(e.UNK059)); }
+		if (e.changed_columns[126]) { v.push_back(columns[126] + " = " + std::to_string(e.booktype)); }
+		if (e.changed_columns[127]) { v.push_back(columns[127] + " = " + std::to_string(e.recastdelay)); }
+		if (e.changed_columns[128]) { v.push_back(columns[128] + " = " + std::to_string(e.recasttype)); }
+		if (e.changed_columns[129]) { v.push_back(columns[129] + " = " + std::to_string(e.guildfavor)); }
+		if (e.changed_columns[130]) { v.push_back(columns[130] + " = " + std::to_string(e.UNK123)); }
+		if (e.changed_columns[131]) { v.push_back(columns[131] + " = " + std::to_string(e.UNK124)); }
+		if (e.changed_columns[132]) { v.push_back(columns[132] + " = " + std::to_string(e.attuneable)); }
+		if (e.changed_columns[133]) { v.push_back(columns[133] + " = " + std::to_string(e.nopet)); }
+		if (e.changed_columns[134]) { v.push_back(columns[134] + " = FROM_UNIXTIME(" + (e.updated > 0 ? std::to_string(e.updated) : "null") + ")"); }
+		if (e.changed_columns[135]) { v.push_back(columns[135] + " = '" + Strings::Escape(e.comment) + "'"); }
+		if (e.changed_columns[136]) { v.push_back(columns[136] + " = " + std::to_string(e.UNK127)); }
+		if (e.changed_columns[137]) { v.push_back(columns[137] + " = " + std::to_string(e.pointtype)); }
+		if (e.changed_columns[138]) { v.push_back(columns[138] + " = " + std::to_string(e.potionbelt)); }
+		if (e.changed_columns[139]) { v.push_back(columns[139] + " = " + std::to_string(e.potionbeltslots)); }
+		if (e.changed_columns[140]) { v.push_back(columns[140] + " = " + std::to_string(e.stacksize)); }
+		if (e.changed_columns[141]) { v.push_back(columns[141] + " = " + std::to_string(e.notransfer)); }
+		if (e.changed_columns[142]) { v.push_back(columns[142] + " = " + std::to_string(e.stackable)); }
+		if (e.changed_columns[143]) { v.push_back(columns[143] + " = '" + Strings::Escape(e.UNK134) + "'"); }
+		if (e.changed_columns[144]) { v.push_back(columns[144] + " = " + std::to_string(e.UNK137)); }
+		if (e.changed_columns[145]) { v.push_back(columns[145] + " = " + std::to_string(e.proceffect)); }
+		if (e.changed_columns[146]) { v.push_back(columns[146] + " = " + std::to_string(e.proctype)); }
+		if (e.changed_columns[147]) { v.push_back(columns[147] + " = " + std::to_string(e.proclevel2)); }
+		if (e.changed_columns[148]) { v.push_back(columns[148] + " = " + std::to_string(e.proclevel)); }
+		if (e.changed_columns[149]) { v.push_back(columns[149] + " = " + std::to_string(e.UNK142)); }
+		if (e.changed_columns[150]) { v.push_back(columns[150] + " = " + std::to_string(e.worneffect)); }
+		if (e.changed_columns[151]) { v.push_back(columns[151] + " = " + std::to_string(e.worntype)); }
+		if (e.changed_columns[152]) { v.push_back(columns[152] + " = " + std::to_string(e.wornlevel2)); }
+		if (e.changed_columns[153]) { v.push_back(columns[153] + " = " + std::to_string(e.wornlevel)); }
+		if (e.changed_columns[154]) { v.push_back(columns[154] + " = " + std::to_string(e.UNK147)); }
+		if (e.changed_columns[155]) { v.push_back(columns[155] + " = " + std::to_string(e.focustype)); }
+		if (e.changed_columns[156]) { v.push_back(columns[156] + " = " + std::to_string(e.focuslevel2)); }
+		if (e.changed_columns[157]) { v.push_back(columns[157] + " = " + std::to_string(e.focuslevel)); }
+		if (e.changed_columns[158]) { v.push_back(columns[158] + " = " + std::to_string(e.UNK152)); }
+		if (e.changed_columns[159]) { v.push_back(columns[159] + " = " + std::to_string(e.scrolleffect)); }
+		if (e.changed_columns[160]) { v.push_back(columns[160] + " = " + std::to_string(e.scrolltype)); }
+		if (e.changed_columns[161]) { v.push_back(columns[161] + " = " + std::to_string(e.scrolllevel2)); }
+		if (e.changed_columns[162]) { v.push_back(columns[162] + " = " + std::to_string(e.scrolllevel)); }
+		if (e.changed_columns[163]) { v.push_back(columns[163] + " = " + std::to_string(e.UNK157)); }
+		if (e.changed_columns[164]) { v.push_back(columns[164] + " = FROM_UNIXTIME(" + (e.serialized > 0 ? std::to_string(e.serialized) : "null") + ")"); }
+		if (e.changed_columns[165]) { v.push_back(columns[165] + " = FROM_UNIXTIME(" + (e.verified > 0 ? std::to_string(e.verified) : "null") + ")"); }
+		if (e.changed_columns[166]) { v.push_back(columns[166] + " = '" + Strings::Escape(e.serialization) + "'"); }
+		if (e.changed_columns[167]) { v.push_back(columns[167] + " = '" + Strings::Escape(e.source) + "'"); }
+		if (e.changed_columns[168]) { v.push_back(columns[168] + " = " + std::to_string(e.UNK033)); }
+		if (e.changed_columns[169]) { v.push_back(columns[169] + " = '" + Strings::Escape(e.lorefile) + "'"); }
+		if (e.changed_columns[170]) { v.push_back(columns[170] + " = " + std::to_string(e.UNK014)); }
+		if (e.changed_columns[171]) { v.push_back(columns[171] + " = " + std::to_string(e.svcorruption)); }
+		if (e.changed_columns[172]) { v.push_back(columns[172] + " = " + std::to_string(e.skillmodmax)); }
+		if (e.changed_columns[173]) { v.push_back(columns[173] + " = " + std::to_string(e.UNK060)); }
+		if (e.changed_columns[174]) { v.push_back(columns[174] + " = " + std::to_string(e.augslot1unk2)); }
+		if (e.changed_columns[175]) { v.push_back(columns[175] + " = " + std::to_string(e.augslot2unk2)); }
+		if (e.changed_columns[176]) { v.push_back(columns[176] + " = " + std::to_string(e.augslot3unk2)); }
+		if (e.changed_columns[177]) { v.push_back(columns[177] + " = " + std::to_string(e.augslot4unk2)); }
+		if (e.changed_columns[178]) { v.push_back(columns[178] + " = " + std::to_string(e.augslot5unk2)); }
+		if (e.changed_columns[179]) { v.push_back(columns[179] + " = " + std::to_string(e.augslot6unk2)); }
+		if (e.changed_columns[180]) { v.push_back(columns[180] + " = " + std::to_string(e.UNK120)); }
+		if (e.changed_columns[181]) { v.push_back(columns[181] + " = " + std::to_string(e.UNK121)); }
+		if (e.changed_columns[182]) { v.push_back(columns[182] + " = " + std::to_string(e.questitemflag)); }
+		if (e.changed_columns[183]) { v.push_back(columns[183] + " = '" + Strings::Escape(e.UNK132) + "'"); }
+		if (e.changed_columns[184]) { v.push_back(columns[184] + " = " + std::to_string(e.clickunk5)); }
+		if (e.changed_columns[185]) { v.push_back(columns[185] + " = '" + Strings::Escape(e.clickunk6) + "'"); }
+		if (e.changed_columns[186]) { v.push_back(columns[186] + " = " + std::to_string(e.clickunk7)); }
+		if (e.changed_columns[187]) { v.push_back(columns[187] + " = " + std::to_string(e.procunk1)); }
+		if (e.changed_columns[188]) { v.push_back(columns[188] + " = " + std::to_string(e.procunk2)); }
+		if (e.changed_columns[189]) { v.push_back(columns[189] + " = " + std::to_string(e.procunk3)); }
+		if (e.changed_columns[190]) { v.push_back(columns[190] + " = " + std::to_string(e.procunk4)); }
+		if (e.changed_columns[191]) { v.push_back(columns[191] + " = '" + Strings::Escape(e.procunk6) + "'"); }
+		if (e.changed_columns[192]) { v.push_back(columns[192] + " = " + std::to_string(e.procunk7)); }
+		if (e.changed_columns[193]) { v.push_back(columns[193] + " = " + std::to_string(e.wornunk1)); }
+		if (e.changed_columns[194]) { v.push_back(columns[194] + " = " + std::to_string(e.wornunk2)); }
+		if (e.changed_columns[195]) { v.push_back(columns[195] + " = " + std::to_string(e.wornunk3)); }
+		if (e.changed_columns[196]) { v.push_back(columns[196] + " = " + std::to_string(e.wornunk4)); }
+		if (e.changed_columns[197]) { v.push_back(columns[197] + " = " + std::to_string(e.wornunk5)); }
+		if (e.changed_columns[198]) { v.push_back(columns[198] + " = '" + Strings::Escape(e.wornunk6) + "'"); }
+		if (e.changed_columns[199]) { v.push_back(columns[199] + " = " + std::to_string(e.wornunk7)); }
+		if (e.changed_columns[200]) { v.push_back(columns[200] + " = " + std::to_string(e.focusunk1)); }
+		if (e.changed_columns[201]) { v.push_back(columns[201] + " = " + std::to_string(e.focusunk2)); }
+		if (e.changed_columns[202]) { v.push_back(columns[202] + " = " + std::to_string(e.focusunk3)); }
+		if (e.changed_columns[203]) { v.push_back(columns[203] + " = " + std::to_string(e.focusunk4)); }
+		if (e.changed_columns[204]) { v.push_back(columns[204] + " = " + std::to_string(e.focusunk5)); }
+		if (e.changed_columns[205]) { v.push_back(columns[205] + " = '" + Strings::Escape(e.focusunk6) + "'"); }
+		if (e.changed_columns[206]) { v.push_back(columns[206] + " = " + std::to_string(e.focusunk7)); }
+		if (e.changed_columns[207]) { v.push_back(columns[207] + " = " + std::to_string(e.scrollunk1)); }
+		if (e.changed_columns[208]) { v.push_back(columns[208] + " = " + std::to_string(e.scrollunk2)); }
+		if (e.changed_columns[209]) { v.push_back(columns[209] + " = " + std::to_string(e.scrollunk3)); }
+		if (e.changed_columns[210]) { v.push_back(columns[210] + " = " + std::to_string(e.scrollunk4)); }
+		if (e.changed_columns[211]) { v.push_back(columns[211] + " = " + std::to_string(e.scrollunk5)); }
+		if (e.changed_columns[212]) { v.push_back(columns[212] + " = '" + Strings::Escape(e.scrollunk6) + "'"); }
+		if (e.changed_columns[213]) { v.push_back(columns[213] + " = " + std::to_string(e.scrollunk7)); }
+		if (e.changed_columns[214]) { v.push_back(columns[214] + " = " + std::to_string(e.UNK193)); }
+		if (e.changed_columns[215]) { v.push_back(columns[215] + " = " + std::to_string(e.purity)); }
+		if (e.changed_columns[216]) { v.push_back(columns[216] + " = " + std::to_string(e.evoitem)); }
+		if (e.changed_columns[217]) { v.push_back(columns[217] + " = " + std::to_string(e.evoid)); }
+		if (e.changed_columns[218]) { v.push_back(columns[218] + " = " + std::to_string(e.evolvinglevel)); }
+		if (e.changed_columns[219]) { v.push_back(columns[219] + " = " + std::to_string(e.evomax)); }
+		if (e.changed_columns[220]) { v.push_back(columns[220] + " = '" + Strings::Escape(e.clickname) + "'"); }
+		if (e.changed_columns[221]) { v.push_back(columns[221] + " = '" + Strings::Escape(e.procname) + "'"); }
+		if (e.changed_columns[222]) { v.push_back(columns[222] + " = '" + Strings::Escape(e.wornname) + "'"); }
+		if (e.changed_columns[223]) { v.push_back(columns[223] + " = '" + Strings::Escape(e.focusname) + "'"); }
+		if (e.changed_columns[224]) { v.push_back(columns[224] + " = '" + Strings::Escape(e.scrollname) + "'"); }
+		if (e.changed_columns[225]) { v.push_back(columns[225] + " = " + std::to_string(e.dsmitigation)); }
+		if (e.changed_columns[226]) { v.push_back(columns[226] + " = " + std::to_string(e.heroic_str)); }
+		if (e.changed_columns[227]) { v.push_back(columns[227] + " = " + std::to_string(e.heroic_int)); }
+		if (e.changed_columns[228]) { v.push_back(columns[228] + " = " + std::to_string(e.heroic_wis)); }
+		if (e.changed_columns[229]) { v.push_back(columns[229] + " = " + std::to_string(e.heroic_agi)); }
+		if (e.changed_columns[230]) { v.push_back(columns[230] + " = " + std::to_string(e.heroic_dex)); }
+		if (e.changed_columns[231]) { v.push_back(columns[231] + " = " + std::to_string(e.heroic_sta)); }
+		if (e.changed_columns[232]) { v.push_back(columns[232] + " = " + std::to_string(e.heroic_cha)); }
+		if (e.changed_columns[233]) { v.push_back(columns[233] + " = " + std::to_string(e.heroic_pr)); }
+		if (e.changed_columns[234]) { v.push_back(columns[234] + " = " + std::to_string(e.heroic_dr)); }
+		if (e.changed_columns[235]) { v.push_back(columns[235] + " = " + std::to_string(e.heroic_fr)); }
+		if (e.changed_columns[236]) { v.push_back(columns[236] + " = " + std::to_string(e.heroic_cr)); }
+		if (e.changed_columns[237]) { v.push_back(columns[237] + " = " + std::to_string(e.heroic_mr)); }
+		if (e.changed_columns[238]) { v.push_back(columns[238] + " = " + std::to_string(e.heroic_svcorrup)); }
+		if (e.changed_columns[239]) { v.push_back(columns[239] + " = " + std::to_string(e.healamt)); }
+		if (e.changed_columns[240]) { v.push_back(columns[240] + " = " + std::to_string(e.spelldmg)); }
+		if (e.changed_columns[241]) { v.push_back(columns[241] + " = " + std::to_string(e.clairvoyance)); }
+		if (e.changed_columns[242]) { v.push_back(columns[242] + " = " + std::to_string(e.backstabdmg)); }
+		if (e.changed_columns[243]) { v.push_back(columns[243] + " = '" + Strings::Escape(e.created) + "'"); }
+		if (e.changed_columns[244]) { v.push_back(columns[244] + " = " + std::to_string(e.elitematerial)); }
+		if (e.changed_columns[245]) { v.push_back(columns[245] + " = " + std::to_string(e.ldonsellbackrate)); }
+		if (e.changed_columns[246]) { v.push_back(columns[246] + " = " + std::to_string(e.scriptfileid)); }
+		if (e.changed_columns[247]) { v.push_back(columns[247] + " = " + std::to_string(e.expendablearrow)); }
+		if (e.changed_columns[248]) { v.push_back(columns[248] + " = " + std::to_string(e.powersourcecapacity)); }
+		if (e.changed_columns[249]) { v.push_back(columns[249] + " = " + std::to_string(e.bardeffect)); }
+		if (e.changed_columns[250]) { v.push_back(columns[250] + " = " + std::to_string(e.bardeffecttype)); }
+		if (e.changed_columns[251]) { v.push_back(columns[251] + " = " + std::to_string(e.bardlevel2)); }
+		if (e.changed_columns[252]) { v.push_back(columns[252] + " = " + std::to_string(e.bardlevel)); }
+		if (e.changed_columns[253]) { v.push_back(columns[253] + " = " + std::to_string(e.bardunk1)); }
+		if (e.changed_columns[254]) { v.push_back(columns[254] + " = " + std::to_string(e.bardunk2)); }
+		if (e.changed_columns[255]) { v.push_back(columns[255] + " = " + std::to_string(e.bardunk3)); }
+		if (e.changed_columns[256]) { v.push_back(columns[256] + " = " + std::to_string(e.bardunk4)); }
+		if (e.changed_columns[257]) { v.push_back(columns[257] + " = " + std::to_string(e.bardunk5)); }
+		if (e.changed_columns[258]) { v.push_back(columns[258] + " = '" + Strings::Escape(e.bardname) + "'"); }
+		if (e.changed_columns[259]) { v.push_back(columns[259] + " = " + std::to_string(e.bardunk7)); }
+		if (e.changed_columns[260]) { v.push_back(columns[260] + " = " + std::to_string(e.UNK214)); }
+		if (e.changed_columns[261]) { v.push_back(columns[261] + " = " + std::to_string(e.subtype)); }
+		if (e.changed_columns[262]) { v.push_back(columns[262] + " = " + std::to_string(e.UNK220)); }
+		if (e.changed_columns[263]) { v.push_back(columns[263] + " = " + std::to_string(e.UNK221)); }
+		if (e.changed_columns[264]) { v.push_back(columns[264] + " = " + std::to_string(e.heirloom)); }
+		if (e.changed_columns[265]) { v.push_back(columns[265] + " = " + std::to_string(e.UNK223)); }
+		if (e.changed_columns[266]) { v.push_back(columns[266] + " = " + std::to_string(e.UNK224)); }
+		if (e.changed_columns[267]) { v.push_back(columns[267] + " = " + std::to_string(e.UNK225)); }
+		if (e.changed_columns[268]) { v.push_back(columns[268] + " = " + std::to_string(e.UNK226)); }
+		if (e.changed_columns[269]) { v.push_back(columns[269] + " = " + std::to_string(e.UNK227)); }
+		if (e.changed_columns[270]) { v.push_back(columns[270] + " = " + std::to_string(e.UNK228)); }
+		if (e.changed_columns[271]) { v.push_back(columns[271] + " = " + std::to_string(e.UNK229)); }
+		if (e.changed_columns[272]) { v.push_back(columns[272] + " = " + std::to_string(e.UNK230)); }
+		if (e.changed_columns[273]) { v.push_back(columns[273] + " = " + std::to_string(e.UNK231)); }
+		if (e.changed_columns[274]) { v.push_back(columns[274] + " = " + std::to_string(e.UNK232)); }
+		if (e.changed_columns[275]) { v.push_back(columns[275] + " = " + std::to_string(e.UNK233)); }
+		if (e.changed_columns[276]) { v.push_back(columns[276] + " = " + std::to_string(e.UNK234)); }
+		if (e.changed_columns[277]) { v.push_back(columns[277] + " = " + std::to_string(e.placeable)); }
+		if (e.changed_columns[278]) { v.push_back(columns[278] + " = " + std::to_string(e.UNK236)); }
+		if (e.changed_columns[279]) { v.push_back(columns[279] + " = " + std::to_string(e.UNK237)); }
+		if (e.changed_columns[280]) { v.push_back(columns[280] + " = " + std::to_string(e.UNK238)); }
+		if (e.changed_columns[281]) { v.push_back(columns[281] + " = " + std::to_string(e.UNK239)); }
+		if (e.changed_columns[282]) { v.push_back(columns[282] + " = " + std::to_string(e.UNK240)); }
+		if (e.changed_columns[283]) { v.push_back(columns[283] + " = " + std::to_string(e.UNK241)); }
+		if (e.changed_columns[284]) { v.push_back(columns[284] + " = " + std::to_string(e.epicitem)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -3108,6 +3410,340 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Items FromStmtRow(const mysql::StmtRow &row)
+	{
+		Items e{};
+
+		e.id                  = row.Get<int32_t>(0).value_or(0);
+		e.minstatus           = row.Get<int16_t>(1).value_or(0);
+		e.Name                = row.GetStr(2).value_or("");
+		e.aagi                = row.Get<int32_t>(3).value_or(0);
+		e.ac                  = row.Get<int32_t>(4).value_or(0);
+		e.accuracy            = row.Get<int32_t>(5).value_or(0);
+		e.acha                = row.Get<int32_t>(6).value_or(0);
+		e.adex                = row.Get<int32_t>(7).value_or(0);
+		e.aint                = row.Get<int32_t>(8).value_or(0);
+		e.artifactflag        = row.Get<uint8_t>(9).value_or(0);
+		e.asta                = row.Get<int32_t>(10).value_or(0);
+		e.astr                = row.Get<int32_t>(11).value_or(0);
+		e.attack              = row.Get<int32_t>(12).value_or(0);
+		e.augrestrict         = row.Get<int32_t>(13).value_or(0);
+		e.augslot1type        = row.Get<int8_t>(14).value_or(0);
+		e.augslot1visible     = row.Get<int8_t>(15).value_or(0);
+		e.augslot2type        = row.Get<int8_t>(16).value_or(0);
+		e.augslot2visible     = row.Get<int8_t>(17).value_or(0);
+		e.augslot3type        = row.Get<int8_t>(18).value_or(0);
+		e.augslot3visible     = row.Get<int8_t>(19).value_or(0);
+		e.augslot4type        = row.Get<int8_t>(20).value_or(0);
+		e.augslot4visible     = row.Get<int8_t>(21).value_or(0);
+		e.augslot5type        = row.Get<int8_t>(22).value_or(0);
+		e.augslot5visible     = row.Get<int8_t>(23).value_or(0);
+		e.augslot6type        = row.Get<int8_t>(24).value_or(0);
+		e.augslot6visible     = row.Get<int8_t>(25).value_or(0);
+		e.augtype             = row.Get<int32_t>(26).value_or(0);
+		e.avoidance           = row.Get<int32_t>(27).value_or(0);
+		e.awis                = row.Get<int32_t>(28).value_or(0);
+		e.bagsize             = row.Get<int32_t>(29).value_or(0);
+		e.bagslots            = row.Get<int32_t>(30).value_or(0);
+		e.bagtype             = row.Get<int32_t>(31).value_or(0);
+		e.bagwr               = row.Get<int32_t>(32).value_or(0);
+		e.banedmgamt          = row.Get<int32_t>(33).value_or(0);
+		e.banedmgraceamt      = row.Get<int32_t>(34).value_or(0);
+		e.banedmgbody         = row.Get<int32_t>(35).value_or(0);
+		e.banedmgrace         = row.Get<int32_t>(36).value_or(0);
+		e.bardtype            = row.Get<int32_t>(37).value_or(0);
+		e.bardvalue           = row.Get<int32_t>(38).value_or(0);
+		e.book                = row.Get<int32_t>(39).value_or(0);
+		e.casttime            = row.Get<int32_t>(40).value_or(0);
+		e.casttime_           = row.Get<int32_t>(41).value_or(0);
+		e.charmfile           = row.GetStr(42).value_or("");
+		e.charmfileid         = row.GetStr(43).value_or("");
+		e.classes             = row.Get<int32_t>(44).value_or(0);
+		e.color               = row.Get<uint32_t>(45).value_or(0);
+		e.combateffects       = row.GetStr(46).value_or("");
+		e.extradmgskill       = row.Get<int32_t>(47).value_or(0);
+		e.extradmgamt         = row.Get<int32_t>(48).value_or(0);
+		e.price               = row.Get<int32_t>(49).value_or(0);
+		e.cr                  = row.Get<int32_t>(50).value_or(0);
+		e.damage              = row.Get<int32_t>(51).value_or(0);
+		e.damageshield        = row.Get<int32_t>(52).value_or(0);
+		e.deity               = row.Get<int32_t>(53).value_or(0);
+		e.delay               = row.Get<int32_t>(54).value_or(0);
+		e.augdistiller        = row.Get<uint32_t>(55).value_or(0);
+		e.dotshielding        = row.Get<int32_t>(56).value_or(0);
+		e.dr                  = row.Get<int32_t>(57).value_or(0);
+		e.clicktype           = row.Get<int32_t>(58).value_or(0);
+		e.clicklevel2         = row.Get<int32_t>(59).value_or(0);
+		e.elemdmgtype         = row.Get<int32_t>(60).value_or(0);
+		e.elemdmgamt          = row.Get<int32_t>(61).value_or(0);
+		e.endur               = row.Get<int32_t>(62).value_or(0);
+		e.factionamt1         = row.Get<int32_t>(63).value_or(0);
+		e.factionamt2         = row.Get<int32_t>(64).value_or(0);
+		e.factionamt3         = row.Get<int32_t>(65).value_or(0);
+		e.factionamt4         = row.Get<int32_t>(66).value_or(0);
+		e.factionmod1         = row.Get<int32_t>(67).value_or(0);
+		e.factionmod2         = row.Get<int32_t>(68).value_or(0);
+		e.factionmod3         = row.Get<int32_t>(69).value_or(0);
+		e.factionmod4         = row.Get<int32_t>(70).value_or(0);
+		e.filename            = row.GetStr(71).value_or("");
+		e.focuseffect         = row.Get<int32_t>(72).value_or(0);
+		e.fr                  = row.Get<int32_t>(73).value_or(0);
+		e.fvnodrop            = row.Get<int32_t>(74).value_or(0);
+		e.haste               = row.Get<int32_t>(75).value_or(0);
+		e.clicklevel          = row.Get<int32_t>(76).value_or(0);
+		e.hp                  = row.Get<int32_t>(77).value_or(0);
+		e.regen               = row.Get<int32_t>(78).value_or(0);
+		e.icon                = row.Get<int32_t>(79).value_or(0);
+		e.idfile              = row.GetStr(80).value_or("");
+		e.itemclass           = row.Get<int32_t>(81).value_or(0);
+		e.itemtype            = row.Get<int32_t>(82).value_or(0);
+		e.ldonprice           = row.Get<int32_t>(83).value_or(0);
+		e.ldontheme           = row.Get<int32_t>(84).value_or(0);
+		e.ldonsold            = row.Get<int32_t>(85).value_or(0);
+		e.light               = row.Get<int32_t>(86).value_or(0);
+		e.lore                = row.GetStr(87).value_or("");
+		e.loregroup           = row.Get<int32_t>(88).value_or(0);
+		e.magic               = row.Get<int32_t>(89).value_or(0);
+		e.mana                = row.Get<int32_t>(90).value_or(0);
+		e.manaregen           = row.Get<int32_t>(91).value_or(0);
+		e.enduranceregen      = row.Get<int32_t>(92).value_or(0);
+		e.material            = row.Get<int32_t>(93).value_or(0);
+		e.herosforgemodel     = row.Get<int32_t>(94).value_or(0);
+		e.maxcharges          = row.Get<int32_t>(95).value_or(0);
+		e.mr                  = row.Get<int32_t>(96).value_or(0);
+		e.nodrop              = row.Get<int32_t>(97).value_or(0);
+		e.norent              = row.Get<int32_t>(98).value_or(0);
+		e.pendingloreflag     = row.Get<uint8_t>(99).value_or(0);
+		e.pr                  = row.Get<int32_t>(100).value_or(0);
+		e.procrate            = row.Get<int32_t>(101).value_or(0);
+		e.races               = row.Get<int32_t>(102).value_or(0);
+		e.range_              = row.Get<int32_t>(103).value_or(0);
+		e.reclevel            = row.Get<int32_t>(104).value_or(0);
+		e.recskill            = row.Get<int32_t>(105).value_or(0);
+		e.reqlevel            = row.Get<int32_t>(106).value_or(0);
+		e.sellrate            = row.Get<float>(107).value_or(0);
+		e.shielding           = row.Get<int32_t>(108).value_or(0);
+		e.size                = row.Get<int32_t>(109).value_or(0);
+		e.skillmodtype        = row.Get<int32_t>(110).value_or(0);
+		e.skillmodvalue       = row.Get<int32_t>(111).value_or(0);
+		e.slots               = row.Get<int32_t>(112).value_or(0);
+		e.clickeffect         = row.Get<int32_t>(113).value_or(0);
+		e.spellshield         = row.Get<int32_t>(114).value_or(0);
+		e.strikethrough       = row.Get<int32_t>(115).value_or(0);
+		e.stunresist          = row.Get<int32_t>(116).value_or(0);
+		e.summonedflag        = row.Get<uint8_t>(117).value_or(0);
+		e.tradeskills         = row.Get<int32_t>(118).value_or(0);
+		e.favor               = row.Get<int32_t>(119).value_or(0);
+		e.weight              = row.Get<int32_t>(120).value_or(0);
+		e.UNK012              = row.Get<int32_t>(121).value_or(0);
+		e.UNK013              = row.Get<int32_t>(122).value_or(0);
+		e.benefitflag         = row.Get<int32_t>(123).value_or(0);
+		e.UNK054              = row.Get<int32_t>(124).value_or(0);
+		e.UNK059              = row.Get<int32_t>(125).value_or(0);
+		e.booktype            = row.Get<int32_t>(126).value_or(0);
+		e.recastdelay         = row.Get<int32_t>(127).value_or(0);
+		e.recasttype          = row.Get<int32_t>(128).value_or(0);
+		e.guildfavor          = row.Get<int32_t>(129).value_or(0);
+		e.UNK123              = row.Get<int32_t>(130).value_or(0);
+		e.UNK124              = row.Get<int32_t>(131).value_or(0);
+		e.attuneable          = row.Get<int32_t>(132).value_or(0);
+		e.nopet               = row.Get<int32_t>(133).value_or(0);
+		e.updated             = row.Get<int64_t>(134).value_or(-1);
+		e.comment             = row.GetStr(135).value_or("");
+		e.UNK127              = row.Get<int32_t>(136).value_or(0);
+		e.pointtype           = row.Get<int32_t>(137).value_or(0);
+		e.potionbelt          = row.Get<int32_t>(138).value_or(0);
+		e.potionbeltslots     = row.Get<int32_t>(139).value_or(0);
+		e.stacksize           = row.Get<int32_t>(140).value_or(0);
+		e.notransfer          = row.Get<int32_t>(141).value_or(0);
+		e.stackable           = row.Get<int32_t>(142).value_or(0);
+		e.UNK134              = row.GetStr(143).value_or("");
+		e.UNK137              = row.Get<int32_t>(144).value_or(0);
+		e.proceffect          = row.Get<int32_t>(145).value_or(0);
+		e.proctype            = row.Get<int32_t>(146).value_or(0);
+		e.proclevel2          = row.Get<int32_t>(147).value_or(0);
+		e.proclevel           = row.Get<int32_t>(148).value_or(0);
+		e.UNK142              = row.Get<int32_t>(149).value_or(0);
+		e.worneffect          = row.Get<int32_t>(150).value_or(0);
+		e.worntype            = row.Get<int32_t>(151).value_or(0);
+		e.wornlevel2          = row.Get<int32_t>(152).value_or(0);
+		e.wornlevel           = row.Get<int32_t>(153).value_or(0);
+		e.UNK147              = row.Get<int32_t>(154).value_or(0);
+		e.focustype           = row.Get<int32_t>(155).value_or(0);
+		e.focuslevel2         = row.Get<int32_t>(156).value_or(0);
+		e.focuslevel          = row.Get<int32_t>(157).value_or(0);
+		e.UNK152              = row.Get<int32_t>(158).value_or(0);
+		e.scrolleffect        = row.Get<int32_t>(159).value_or(0);
+		e.scrolltype          = row.Get<int32_t>(160).value_or(0);
+		e.scrolllevel2        = row.Get<int32_t>(161).value_or(0);
+		e.scrolllevel         = row.Get<int32_t>(162).value_or(0);
+		e.UNK157              = row.Get<int32_t>(163).value_or(0);
+		e.serialized          = row.Get<int64_t>(164).value_or(-1);
+		e.verified            = row.Get<int64_t>(165).value_or(-1);
+		e.serialization       = row.GetStr(166).value_or("");
+		e.source              = row.GetStr(167).value_or("");
+		e.UNK033              = row.Get<int32_t>(168).value_or(0);
+		e.lorefile            = row.GetStr(169).value_or("");
+		e.UNK014              = row.Get<int32_t>(170).value_or(0);
+		e.svcorruption        = row.Get<int32_t>(171).value_or(0);
+		e.skillmodmax         = row.Get<int32_t>(172).value_or(0);
+		e.UNK060              = row.Get<int32_t>(173).value_or(0);
+		e.augslot1unk2        = row.Get<int32_t>(174).value_or(0);
+		e.augslot2unk2        = row.Get<int32_t>(175).value_or(0);
+		e.augslot3unk2        = row.Get<int32_t>(176).value_or(0);
+		e.augslot4unk2        = row.Get<int32_t>(177).value_or(0);
+		e.augslot5unk2        = row.Get<int32_t>(178).value_or(0);
+		e.augslot6unk2        = row.Get<int32_t>(179).value_or(0);
+		e.UNK120              = row.Get<int32_t>(180).value_or(0);
+		e.UNK121              = row.Get<int32_t>(181).value_or(0);
+		e.questitemflag       = row.Get<int32_t>(182).value_or(0);
+		e.UNK132              = row.GetStr(183).value_or("");
+		e.clickunk5           = row.Get<int32_t>(184).value_or(0);
+		e.clickunk6           = row.GetStr(185).value_or("");
+		e.clickunk7           = row.Get<int32_t>(186).value_or(0);
+		e.procunk1            = row.Get<int32_t>(187).value_or(0);
+		e.procunk2            = row.Get<int32_t>(188).value_or(0);
+		e.procunk3            = row.Get<int32_t>(189).value_or(0);
+		e.procunk4            = row.Get<int32_t>(190).value_or(0);
+		e.procunk6            = row.GetStr(191).value_or("");
+		e.procunk7            = row.Get<int32_t>(192).value_or(0);
+		e.wornunk1            = row.Get<int32_t>(193).value_or(0);
+		e.wornunk2            = row.Get<int32_t>(194).value_or(0);
+		e.wornunk3            = row.Get<int32_t>(195).value_or(0);
+		e.wornunk4            = row.Get<int32_t>(196).value_or(0);
+		e.wornunk5            = row.Get<int32_t>(197).value_or(0);
+		e.wornunk6            = row.GetStr(198).value_or("");
+		e.wornunk7            = row.Get<int32_t>(199).value_or(0);
+		e.focusunk1           = row.Get<int32_t>(200).value_or(0);
+		e.focusunk2           = row.Get<int32_t>(201).value_or(0);
+		e.focusunk3           = row.Get<int32_t>(202).value_or(0);
+		e.focusunk4           = row.Get<int32_t>(203).value_or(0);
+		e.focusunk5           = row.Get<int32_t>(204).value_or(0);
+		e.focusunk6           = row.GetStr(205).value_or("");
+		e.focusunk7           = row.Get<int32_t>(206).value_or(0);
+		e.scrollunk1          = row.Get<uint32_t>(207).value_or(0);
+		e.scrollunk2          = row.Get<int32_t>(208).value_or(0);
+		e.scrollunk3          = row.Get<int32_t>(209).value_or(0);
+		e.scrollunk4          = row.Get<int32_t>(210).value_or(0);
+		e.scrollunk5          = row.Get<int32_t>(211).value_or(0);
+		e.scrollunk6          = row.GetStr(212).value_or("");
+		e.scrollunk7          = row.Get<int32_t>(213).value_or(0);
+		e.UNK193              = row.Get<int32_t>(214).value_or(0);
+		e.purity              = row.Get<int32_t>(215).value_or(0);
+		e.evoitem             = row.Get<int32_t>(216).value_or(0);
+		e.evoid               = row.Get<int32_t>(217).value_or(0);
+		e.evolvinglevel       = row.Get<int32_t>(218).value_or(0);
+		e.evomax              = row.Get<int32_t>(219).value_or(0);
+		e.clickname           = row.GetStr(220).value_or("");
+		e.procname            = row.GetStr(221).value_or("");
+		e.wornname            = row.GetStr(222).value_or("");
+		e.focusname           = row.GetStr(223).value_or("");
+		e.scrollname          = row.GetStr(224).value_or("");
+		e.dsmitigation        = row.Get<int16_t>(225).value_or(0);
+		e.heroic_str          = row.Get<int16_t>(226).value_or(0);
+		e.heroic_int          = row.Get<int16_t>(227).value_or(0);
+		e.heroic_wis          = row.Get<int16_t>(228).value_or(0);
+		e.heroic_agi          = row.Get<int16_t>(229).value_or(0);
+		e.heroic_dex          = row.Get<int16_t>(230).value_or(0);
+		e.heroic_sta          = row.Get<int16_t>(231).value_or(0);
+		e.heroic_cha          = row.Get<int16_t>(232).value_or(0);
+		e.heroic_pr           = row.Get<int16_t>(233).value_or(0);
+		e.heroic_dr           = row.Get<int16_t>(234).value_or(0);
+		e.heroic_fr           = row.Get<int16_t>(235).value_or(0);
+		e.heroic_cr           = row.Get<int16_t>(236).value_or(0);
+		e.heroic_mr           = row.Get<int16_t>(237).value_or(0);
+		e.heroic_svcorrup     = row.Get<int16_t>(238).value_or(0);
+		e.healamt             = row.Get<int16_t>(239).value_or(0);
+		e.spelldmg            = row.Get<int16_t>(240).value_or(0);
+		e.clairvoyance        = row.Get<int16_t>(241).value_or(0);
+		e.backstabdmg         = row.Get<int16_t>(242).value_or(0);
+		e.created             = row.GetStr(243).value_or("");
+		e.elitematerial       = row.Get<int16_t>(244).value_or(0);
+		e.ldonsellbackrate    = row.Get<int16_t>(245).value_or(0);
+		e.scriptfileid        = row.Get<int32_t>(246).value_or(0);
+		e.expendablearrow     = row.Get<int16_t>(247).value_or(0);
+		e.powersourcecapacity = row.Get<int32_t>(248).value_or(0);
+		e.bardeffect          = row.Get<int32_t>(249).value_or(0);
+		e.bardeffecttype      = row.Get<int16_t>(250).value_or(0);
+		e.bardlevel2          = row.Get<int16_t>(251).value_or(0);
+		e.bardlevel           = row.Get<int16_t>(252).value_or(0);
+		e.bardunk1            = row.Get<int16_t>(253).value_or(0);
+		e.bardunk2            = row.Get<int16_t>(254).value_or(0);
+		e.bardunk3            = row.Get<int16_t>(255).value_or(0);
+		e.bardunk4            = row.Get<int16_t>(256).value_or(0);
+		e.bardunk5            = row.Get<int16_t>(257).value_or(0);
+		e.bardname            = row.GetStr(258).value_or("");
+		e.bardunk7            = row.Get<int16_t>(259).value_or(0);
+		e.UNK214              = row.Get<int16_t>(260).value_or(0);
+		e.subtype             = row.Get<int32_t>(261).value_or(0);
+		e.UNK220              = row.Get<int32_t>(262).value_or(0);
+		e.UNK221              = row.Get<int32_t>(263).value_or(0);
+		e.heirloom            = row.Get<int32_t>(264).value_or(0);
+		e.UNK223              = row.Get<int32_t>(265).value_or(0);
+		e.UNK224              = row.Get<int32_t>(266).value_or(0);
+		e.UNK225              = row.Get<int32_t>(267).value_or(0);
+		e.UNK226              = row.Get<int32_t>(268).value_or(0);
+		e.UNK227              = row.Get<int32_t>(269).value_or(0);
+		e.UNK228              = row.Get<int32_t>(270).value_or(0);
+		e.UNK229              = row.Get<int32_t>(271).value_or(0);
+		e.UNK230              = row.Get<int32_t>(272).value_or(0);
+		e.UNK231              = row.Get<int32_t>(273).value_or(0);
+		e.UNK232              = row.Get<int32_t>(274).value_or(0);
+		e.UNK233              = row.Get<int32_t>(275).value_or(0);
+		e.UNK234              = row.Get<int32_t>(276).value_or(0);
+		e.placeable           = row.Get<int32_t>(277).value_or(0);
+		e.UNK236              = row.Get<int32_t>(278).value_or(0);
+		e.UNK237              = row.Get<int32_t>(279).value_or(0);
+		e.UNK238              = row.Get<int32_t>(280).value_or(0);
+		e.UNK239              = row.Get<int32_t>(281).value_or(0);
+		e.UNK240              = row.Get<int32_t>(282).value_or(0);
+		e.UNK241              = row.Get<int32_t>(283).value_or(0);
+		e.epicitem            = row.Get<int32_t>(284).value_or(0);
+
+		return e;
+	}
+
+	static Items FindOnePrepared(
+		Database& db,
+		int items_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { items_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Items> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Items> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -3479,7 +4115,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<285> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -3771,13 +4415,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLfguildRepository {
@@ -28,6 +30,9 @@ public:
 		uint32_t    aacount;
 		uint32_t    timezone;
 		uint32_t    timeposted;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Lfguild &e,
+		const Lfguild &original
+	)
+	{
+		e.changed_columns[0] = e.type != original.type;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.comment != original.comment;
+		e.changed_columns[3] = e.fromlevel != original.fromlevel;
+		e.changed_columns[4] = e.tolevel != original.tolevel;
+		e.changed_columns[5] = e.classes != original.classes;
+		e.changed_columns[6] = e.aacount != original.aacount;
+		e.changed_columns[7] = e.timezone != original.timezone;
+		e.changed_columns[8] = e.timeposted != original.timeposted;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Lfguild &e
@@ -189,15 +211,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.type));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.comment) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.fromlevel));
-		v.push_back(columns[4] + " = " + std::to_string(e.tolevel));
-		v.push_back(columns[5] + " = " + std::to_string(e.classes));
-		v.push_back(columns[6] + " = " + std::to_string(e.aacount));
-		v.push_back(columns[7] + " = " + std::to_string(e.timezone));
-		v.push_back(columns[8] + " = " + std::to_string(e.timeposted));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.comment) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.fromlevel)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.tolevel)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.classes)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aacount)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.timezone)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.timeposted)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -348,6 +374,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Lfguild FromStmtRow(const mysql::StmtRow &row)
+	{
+		Lfguild e{};
+
+		e.type       = row.Get<uint8_t>(0).value_or(0);
+		e.name       = row.GetStr(1).value_or("");
+		e.comment    = row.GetStr(2).value_or("");
+		e.fromlevel  = row.Get<uint8_t>(3).value_or(0);
+		e.tolevel    = row.Get<uint8_t>(4).value_or(0);
+		e.classes    = row.Get<uint32_t>(5).value_or(0);
+		e.aacount    = row.Get<uint32_t>(6).value_or(0);
+		e.timezone   = row.Get<uint32_t>(7).value_or(0);
+		e.timeposted = row.Get<uint32_t>(8).value_or(0);
+
+		return e;
+	}
+
+	static Lfguild FindOnePrepared(
+		Database& db,
+		int lfguild_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { lfguild_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Lfguild> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Lfguild> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -443,7 +527,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.type));
@@ -459,13 +551,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLoginServerAdminsRepository {
@@ -27,6 +29,9 @@ public:
 		std::string email;
 		time_t      registration_date;
 		std::string registration_ip_address;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		LoginServerAdmins &e,
+		const LoginServerAdmins &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.account_name != original.account_name;
+		e.changed_columns[2] = e.account_password != original.account_password;
+		e.changed_columns[3] = e.first_name != original.first_name;
+		e.changed_columns[4] = e.last_name != original.last_name;
+		e.changed_columns[5] = e.email != original.email;
+		e.changed_columns[6] = e.registration_date != original.registration_date;
+		e.changed_columns[7] = e.registration_ip_address != original.registration_ip_address;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const LoginServerAdmins &e
@@ -184,13 +205,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.account_name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.account_password) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.first_name) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.last_name) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.email) + "'");
-		v.push_back(columns[6] + " = FROM_UNIXTIME(" + (e.registration_date > 0 ? std::to_string(e.registration_date) : "null") + ")");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.registration_ip_address) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.account_name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.account_password) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.first_name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.last_name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.email) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = FROM_UNIXTIME(" + (e.registration_date > 0 ? std::to_string(e.registration_date) : "null") + ")"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.registration_ip_address) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -337,6 +362,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static LoginServerAdmins FromStmtRow(const mysql::StmtRow &row)
+	{
+		LoginServerAdmins e{};
+
+		e.id                      = row.Get<uint32_t>(0).value_or(0);
+		e.account_name            = row.GetStr(1).value_or("");
+		e.account_password        = row.GetStr(2).value_or("");
+		e.first_name              = row.GetStr(3).value_or("");
+		e.last_name               = row.GetStr(4).value_or("");
+		e.email                   = row.GetStr(5).value_or("");
+		e.registration_date       = row.Get<int64_t>(6).value_or(-1);
+		e.registration_ip_address = row.GetStr(7).value_or("");
+
+		return e;
+	}
+
+	static LoginServerAdmins FindOnePrepared(
+		Database& db,
+		int login_server_admins_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { login_server_admins_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<LoginServerAdmins> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<LoginServerAdmins> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -431,7 +513,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -446,13 +536,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
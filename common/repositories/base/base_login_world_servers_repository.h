@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLoginWorldServersRepository {
@@ -29,6 +31,9 @@ public:
 		int32_t     login_server_admin_id;
 		int32_t     is_server_trusted;
 		std::string note;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -185,6 +190,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		LoginWorldServers &e,
+		const LoginWorldServers &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.long_name != original.long_name;
+		e.changed_columns[2] = e.short_name != original.short_name;
+		e.changed_columns[3] = e.tag_description != original.tag_description;
+		e.changed_columns[4] = e.login_server_list_type_id != original.login_server_list_type_id;
+		e.changed_columns[5] = e.last_login_date != original.last_login_date;
+		e.changed_columns[6] = e.last_ip_address != original.last_ip_address;
+		e.changed_columns[7] = e.login_server_admin_id != original.login_server_admin_id;
+		e.changed_columns[8] = e.is_server_trusted != original.is_server_trusted;
+		e.changed_columns[9] = e.note != original.note;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const LoginWorldServers &e
@@ -194,15 +217,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.long_name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.short_name) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.tag_description) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.login_server_list_type_id));
-		v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.last_login_date > 0 ? std::to_string(e.last_login_date) : "null") + ")");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.last_ip_address) + "'");
-		v.push_back(columns[7] + " = " + std::to_string(e.login_server_admin_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.is_server_trusted));
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.note) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.long_name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.short_name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.tag_description) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.login_server_list_type_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.last_login_date > 0 ? std::to_string(e.last_login_date) : "null") + ")"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.last_ip_address) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.login_server_admin_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.is_server_trusted)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.note) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -357,6 +384,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static LoginWorldServers FromStmtRow(const mysql::StmtRow &row)
+	{
+		LoginWorldServers e{};
+
+		e.id                        = row.Get<uint32_t>(0).value_or(0);
+		e.long_name                 = row.GetStr(1).value_or("");
+		e.short_name                = row.GetStr(2).value_or("");
+		e.tag_description           = row.GetStr(3).value_or("");
+		e.login_server_list_type_id = row.Get<int32_t>(4).value_or(0);
+		e.last_login_date           = row.Get<int64_t>(5).value_or(-1);
+		e.last_ip_address           = row.GetStr(6).value_or("");
+		e.login_server_admin_id     = row.Get<int32_t>(7).value_or(0);
+		e.is_server_trusted         = row.Get<int32_t>(8).value_or(0);
+		e.note                      = row.GetStr(9).value_or("");
+
+		return e;
+	}
+
+	static LoginWorldServers FindOnePrepared(
+		Database& db,
+		int login_world_servers_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { login_world_servers_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<LoginWorldServers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<LoginWorldServers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -453,7 +539,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -470,13 +564,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
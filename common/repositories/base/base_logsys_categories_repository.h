@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLogsysCategoriesRepository {
@@ -26,6 +28,9 @@ public:
 		int16_t     log_to_gmsay;
 		int16_t     log_to_discord;
 		int32_t     discord_webhook_id;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -170,6 +175,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		LogsysCategories &e,
+		const LogsysCategories &original
+	)
+	{
+		e.changed_columns[0] = e.log_category_id != original.log_category_id;
+		e.changed_columns[1] = e.log_category_description != original.log_category_description;
+		e.changed_columns[2] = e.log_to_console != original.log_to_console;
+		e.changed_columns[3] = e.log_to_file != original.log_to_file;
+		e.changed_columns[4] = e.log_to_gmsay != original.log_to_gmsay;
+		e.changed_columns[5] = e.log_to_discord != original.log_to_discord;
+		e.changed_columns[6] = e.discord_webhook_id != original.discord_webhook_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const LogsysCategories &e
@@ -179,13 +199,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.log_category_id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.log_category_description) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.log_to_console));
-		v.push_back(columns[3] + " = " + std::to_string(e.log_to_file));
-		v.push_back(columns[4] + " = " + std::to_string(e.log_to_gmsay));
-		v.push_back(columns[5] + " = " + std::to_string(e.log_to_discord));
-		v.push_back(columns[6] + " = " + std::to_string(e.discord_webhook_id));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.log_category_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.log_category_description) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.log_to_console)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.log_to_file)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.log_to_gmsay)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.log_to_discord)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.discord_webhook_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -328,6 +352,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static LogsysCategories FromStmtRow(const mysql::StmtRow &row)
+	{
+		LogsysCategories e{};
+
+		e.log_category_id          = row.Get<int32_t>(0).value_or(0);
+		e.log_category_description = row.GetStr(1).value_or("");
+		e.log_to_console           = row.Get<int16_t>(2).value_or(0);
+		e.log_to_file              = row.Get<int16_t>(3).value_or(0);
+		e.log_to_gmsay             = row.Get<int16_t>(4).value_or(0);
+		e.log_to_discord           = row.Get<int16_t>(5).value_or(0);
+		e.discord_webhook_id       = row.Get<int32_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static LogsysCategories FindOnePrepared(
+		Database& db,
+		int logsys_categories_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { logsys_categories_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<LogsysCategories> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<LogsysCategories> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -421,7 +501,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.log_category_id));
@@ -435,13 +523,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLootdropEntriesRepository {
@@ -34,6 +36,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<15> changed_columns = std::bitset<15>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -210,6 +215,29 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		LootdropEntries &e,
+		const LootdropEntries &original
+	)
+	{
+		e.changed_columns[0] = e.lootdrop_id != original.lootdrop_id;
+		e.changed_columns[1] = e.item_id != original.item_id;
+		e.changed_columns[2] = e.item_charges != original.item_charges;
+		e.changed_columns[3] = e.equip_item != original.equip_item;
+		e.changed_columns[4] = e.chance != original.chance;
+		e.changed_columns[5] = e.disabled_chance != original.disabled_chance;
+		e.changed_columns[6] = e.trivial_min_level != original.trivial_min_level;
+		e.changed_columns[7] = e.trivial_max_level != original.trivial_max_level;
+		e.changed_columns[8] = e.multiplier != original.multiplier;
+		e.changed_columns[9] = e.npc_min_level != original.npc_min_level;
+		e.changed_columns[10] = e.npc_max_level != original.npc_max_level;
+		e.changed_columns[11] = e.min_expansion != original.min_expansion;
+		e.changed_columns[12] = e.max_expansion != original.max_expansion;
+		e.changed_columns[13] = e.content_flags != original.content_flags;
+		e.changed_columns[14] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const LootdropEntries &e
@@ -219,21 +247,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.lootdrop_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_charges));
-		v.push_back(columns[3] + " = " + std::to_string(e.equip_item));
-		v.push_back(columns[4] + " = " + std::to_string(e.chance));
-		v.push_back(columns[5] + " = " + std::to_string(e.disabled_chance));
-		v.push_back(columns[6] + " = " + std::to_string(e.trivial_min_level));
-		v.push_back(columns[7] + " = " + std::to_string(e.trivial_max_level));
-		v.push_back(columns[8] + " = " + std::to_string(e.multiplier));
-		v.push_back(columns[9] + " = " + std::to_string(e.npc_min_level));
-		v.push_back(columns[10] + " = " + std::to_string(e.npc_max_level));
-		v.push_back(columns[11] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[12] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[13] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.lootdrop_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_charges)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.equip_item)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.chance)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.disabled_chance)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.trivial_min_level)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.trivial_max_level)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.multiplier)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.npc_min_level)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.npc_max_level)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -408,6 +440,70 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static LootdropEntries FromStmtRow(const mysql::StmtRow &row)
+	{
+		LootdropEntries e{};
+
+		e.lootdrop_id            = row.Get<uint32_t>(0).value_or(0);
+		e.item_id                = row.Get<int32_t>(1).value_or(0);
+		e.item_charges           = row.Get<uint16_t>(2).value_or(1);
+		e.equip_item             = row.Get<uint8_t>(3).value_or(0);
+		e.chance                 = row.Get<float>(4).value_or(1);
+		e.disabled_chance        = row.Get<float>(5).value_or(0);
+		e.trivial_min_level      = row.Get<uint16_t>(6).value_or(0);
+		e.trivial_max_level      = row.Get<uint16_t>(7).value_or(0);
+		e.multiplier             = row.Get<uint8_t>(8).value_or(1);
+		e.npc_min_level          = row.Get<uint16_t>(9).value_or(0);
+		e.npc_max_level          = row.Get<uint16_t>(10).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(11).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(12).value_or(-1);
+		e.content_flags          = row.GetStr(13).value_or("");
+		e.content_flags_disabled = row.GetStr(14).value_or("");
+
+		return e;
+	}
+
+	static LootdropEntries FindOnePrepared(
+		Database& db,
+		int lootdrop_entries_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { lootdrop_entries_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<LootdropEntries> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<LootdropEntries> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -509,7 +605,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<15> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.lootdrop_id));
@@ -531,13 +635,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLoottableEntriesRepository {
@@ -25,6 +27,9 @@ public:
 		uint8_t  droplimit;
 		uint8_t  mindrop;
 		float    probability;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<6> changed_columns = std::bitset<6>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -165,6 +170,20 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		LoottableEntries &e,
+		const LoottableEntries &original
+	)
+	{
+		e.changed_columns[0] = e.loottable_id != original.loottable_id;
+		e.changed_columns[1] = e.lootdrop_id != original.lootdrop_id;
+		e.changed_columns[2] = e.multiplier != original.multiplier;
+		e.changed_columns[3] = e.droplimit != original.droplimit;
+		e.changed_columns[4] = e.mindrop != original.mindrop;
+		e.changed_columns[5] = e.probability != original.probability;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const LoottableEntries &e
@@ -174,12 +193,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.loottable_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.lootdrop_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.multiplier));
-		v.push_back(columns[3] + " = " + std::to_string(e.droplimit));
-		v.push_back(columns[4] + " = " + std::to_string(e.mindrop));
-		v.push_back(columns[5] + " = " + std::to_string(e.probability));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.loottable_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.lootdrop_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.multiplier)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.droplimit)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.mindrop)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.probability)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -318,6 +341,61 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static LoottableEntries FromStmtRow(const mysql::StmtRow &row)
+	{
+		LoottableEntries e{};
+
+		e.loottable_id = row.Get<uint32_t>(0).value_or(0);
+		e.lootdrop_id  = row.Get<uint32_t>(1).value_or(0);
+		e.multiplier   = row.Get<uint8_t>(2).value_or(1);
+		e.droplimit    = row.Get<uint8_t>(3).value_or(0);
+		e.mindrop      = row.Get<uint8_t>(4).value_or(0);
+		e.probability  = row.Get<float>(5).value_or(100);
+
+		return e;
+	}
+
+	static LoottableEntries FindOnePrepared(
+		Database& db,
+		int loottable_entries_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { loottable_entries_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<LoottableEntries> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<LoottableEntries> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -410,7 +488,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<6> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.loottable_id));
@@ -423,13 +509,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseLoottableRepository {
@@ -29,6 +31,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -185,6 +190,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Loottable &e,
+		const Loottable &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.mincash != original.mincash;
+		e.changed_columns[3] = e.maxcash != original.maxcash;
+		e.changed_columns[4] = e.avgcoin != original.avgcoin;
+		e.changed_columns[5] = e.done != original.done;
+		e.changed_columns[6] = e.min_expansion != original.min_expansion;
+		e.changed_columns[7] = e.max_expansion != original.max_expansion;
+		e.changed_columns[8] = e.content_flags != original.content_flags;
+		e.changed_columns[9] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Loottable &e
@@ -194,15 +217,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.mincash));
-		v.push_back(columns[3] + " = " + std::to_string(e.maxcash));
-		v.push_back(columns[4] + " = " + std::to_string(e.avgcoin));
-		v.push_back(columns[5] + " = " + std::to_string(e.done));
-		v.push_back(columns[6] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[7] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.mincash)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.maxcash)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.avgcoin)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.done)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -357,6 +384,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Loottable FromStmtRow(const mysql::StmtRow &row)
+	{
+		Loottable e{};
+
+		e.id                     = row.Get<uint32_t>(0).value_or(0);
+		e.name                   = row.GetStr(1).value_or("");
+		e.mincash                = row.Get<uint32_t>(2).value_or(0);
+		e.maxcash                = row.Get<uint32_t>(3).value_or(0);
+		e.avgcoin                = row.Get<uint32_t>(4).value_or(0);
+		e.done                   = row.Get<int8_t>(5).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(6).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(7).value_or(-1);
+		e.content_flags          = row.GetStr(8).value_or("");
+		e.content_flags_disabled = row.GetStr(9).value_or("");
+
+		return e;
+	}
+
+	static Loottable FindOnePrepared(
+		Database& db,
+		int loottable_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { loottable_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Loottable> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Loottable> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -453,7 +539,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -470,13 +564,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseMailRepository {
@@ -27,6 +29,9 @@ public:
 		std::string body;
 		std::string to;
 		int8_t      status;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Mail &e,
+		const Mail &original
+	)
+	{
+		e.changed_columns[0] = e.msgid != original.msgid;
+		e.changed_columns[1] = e.charid != original.charid;
+		e.changed_columns[2] = e.timestamp != original.timestamp;
+		e.changed_columns[3] = e.from != original.from;
+		e.changed_columns[4] = e.subject != original.subject;
+		e.changed_columns[5] = e.body != original.body;
+		e.changed_columns[6] = e.to != original.to;
+		e.changed_columns[7] = e.status != original.status;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Mail &e
@@ -184,13 +205,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.charid));
-		v.push_back(columns[2] + " = " + std::to_string(e.timestamp));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.from) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.subject) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.body) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.to) + "'");
-		v.push_back(columns[7] + " = " + std::to_string(e.status));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.charid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.timestamp)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.from) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.subject) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.body) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.to) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.status)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -337,6 +362,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Mail FromStmtRow(const mysql::StmtRow &row)
+	{
+		Mail e{};
+
+		e.msgid     = row.Get<uint32_t>(0).value_or(0);
+		e.charid    = row.Get<uint32_t>(1).value_or(0);
+		e.timestamp = row.Get<int32_t>(2).value_or(0);
+		e.from      = row.GetStr(3).value_or("");
+		e.subject   = row.GetStr(4).value_or("");
+		e.body      = row.GetStr(5).value_or("");
+		e.to        = row.GetStr(6).value_or("");
+		e.status    = row.Get<int8_t>(7).value_or(0);
+
+		return e;
+	}
+
+	static Mail FindOnePrepared(
+		Database& db,
+		int mail_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { mail_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Mail> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Mail> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -431,7 +513,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.msgid));
@@ -446,13 +536,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 
@@ -30,6 +32,9 @@ public:
 		uint8_t  armortint_red;
 		uint8_t  armortint_green;
 		uint8_t  armortint_blue;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -186,6 +191,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		MercArmorinfo &e,
+		const MercArmorinfo &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.merc_npc_type_id != original.merc_npc_type_id;
+		e.changed_columns[2] = e.minlevel != original.minlevel;
+		e.changed_columns[3] = e.maxlevel != original.maxlevel;
+		e.changed_columns[4] = e.texture != original.texture;
+		e.changed_columns[5] = e.helmtexture != original.helmtexture;
+		e.changed_columns[6] = e.armortint_id != original.armortint_id;
+		e.changed_columns[7] = e.armortint_red != original.armortint_red;
+		e.changed_columns[8] = e.armortint_green != original.armortint_green;
+		e.changed_columns[9] = e.armortint_blue != original.armortint_blue;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const MercArmorinfo &e
@@ -195,15 +218,19 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.merc_npc_type_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.minlevel));
-		v.push_back(columns[3] + " = " + std::to_string(e.maxlevel));
-		v.push_back(columns[4] + " = " + std::to_string(e.texture));
-		v.push_back(columns[5] + " = " + std::to_string(e.helmtexture));
-		v.push_back(columns[6] + " = " + std::to_string(e.armortint_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.armortint_red));
-		v.push_back(columns[8] + " = " + std::to_string(e.armortint_green));
-		v.push_back(columns[9] + " = " + std::to_string(e.armortint_blue));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.merc_npc_type_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.minlevel)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.maxlevel)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.texture)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.helmtexture)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.armortint_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.armortint_red)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.armortint_green)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.armortint_blue)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -358,6 +385,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static MercArmorinfo FromStmtRow(const mysql::StmtRow &row)
+	{
+		MercArmorinfo e{};
+
+		e.id               = row.Get<int32_t>(0).value_or(0);
+		e.merc_npc_type_id = row.Get<uint32_t>(1).value_or(0);
+		e.minlevel         = row.Get<uint8_t>(2).value_or(0);
+		e.maxlevel         = row.Get<uint8_t>(3).value_or(0);
+		e.texture          = row.Get<uint8_t>(4).value_or(0);
+		e.helmtexture      = row.Get<uint8_t>(5).value_or(0);
+		e.armortint_id     = row.Get<uint32_t>(6).value_or(0);
+		e.armortint_red    = row.Get<uint8_t>(7).value_or(0);
+		e.armortint_green  = row.Get<uint8_t>(8).value_or(0);
+		e.armortint_blue   = row.Get<uint8_t>(9).value_or(0);
+
+		return e;
+	}
+
+	static MercArmorinfo FindOnePrepared(
+		Database& db,
+		int merc_armorinfo_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { merc_armorinfo_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<MercArmorinfo> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<MercArmorinfo> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -454,7 +540,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -471,13 +565,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
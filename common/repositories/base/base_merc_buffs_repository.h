@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseMercBuffsRepository {
@@ -38,6 +40,9 @@ public:
 		int32_t  caston_y;
 		int32_t  caston_z;
 		int32_t  ExtraDIChance;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<19> changed_columns = std::bitset<19>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -230,6 +235,33 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		MercBuffs &e,
+		const MercBuffs &original
+	)
+	{
+		e.changed_columns[0] = e.MercBuffId != original.MercBuffId;
+		e.changed_columns[1] = e.MercId != original.MercId;
+		e.changed_columns[2] = e.SpellId != original.SpellId;
+		e.changed_columns[3] = e.CasterLevel != original.CasterLevel;
+		e.changed_columns[4] = e.DurationFormula != original.DurationFormula;
+		e.changed_columns[5] = e.TicsRemaining != original.TicsRemaining;
+		e.changed_columns[6] = e.PoisonCounters != original.PoisonCounters;
+		e.changed_columns[7] = e.DiseaseCounters != original.DiseaseCounters;
+		e.changed_columns[8] = e.CurseCounters != original.CurseCounters;
+		e.changed_columns[9] = e.CorruptionCounters != original.CorruptionCounters;
+		e.changed_columns[10] = e.HitCount != original.HitCount;
+		e.changed_columns[11] = e.MeleeRune != original.MeleeRune;
+		e.changed_columns[12] = e.MagicRune != original.MagicRune;
+		e.changed_columns[13] = e.dot_rune != original.dot_rune;
+		e.changed_columns[14] = e.caston_x != original.caston_x;
+		e.changed_columns[15] = e.Persistent != original.Persistent;
+		e.changed_columns[16] = e.caston_y != original.caston_y;
+		e.changed_columns[17] = e.caston_z != original.caston_z;
+		e.changed_columns[18] = e.ExtraDIChance != original.ExtraDIChance;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const MercBuffs &e
@@ -239,24 +271,28 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.MercId));
-		v.push_back(columns[2] + " = " + std::to_string(e.SpellId));
-		v.push_back(columns[3] + " = " + std::to_string(e.CasterLevel));
-		v.push_back(columns[4] + " = " + std::to_string(e.DurationFormula));
-		v.push_back(columns[5] + " = " + std::to_string(e.TicsRemaining));
-		v.push_back(columns[6] + " = " + std::to_string(e.PoisonCounters));
-		v.push_back(columns[7] + " = " + std::to_string(e.DiseaseCounters));
-		v.push_back(columns[8] + " = " + std::to_string(e.CurseCounters));
-		v.push_back(columns[9] + " = " + std::to_string(e.CorruptionCounters));
-		v.push_back(columns[10] + " = " + std::to_string(e.HitCount));
-		v.push_back(columns[11] + " = " + std::to_string(e.MeleeRune));
-		v.push_back(columns[12] + " = " + std::to_string(e.MagicRune));
-		v.push_back(columns[13] + " = " + std::to_string(e.dot_rune));
-		v.push_back(columns[14] + " = " + std::to_string(e.caston_x));
-		v.push_back(columns[15] + " = " + std::to_string(e.Persistent));
-		v.push_back(columns[16] + " = " + std::to_string(e.caston_y));
-		v.push_back(columns[17] + " = " + std::to_string(e.caston_z));
-		v.push_back(columns[18] + " = " + std::to_string(e.ExtraDIChance));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.MercId)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.SpellId)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.CasterLevel)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.DurationFormula)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.TicsRemaining)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.PoisonCounters)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.DiseaseCounters)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.CurseCounters)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.CorruptionCounters)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.HitCount)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.MeleeRune)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.MagicRune)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.dot_rune)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.caston_x)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.Persistent)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.caston_y)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.caston_z)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.ExtraDIChance)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -447,6 +483,74 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static MercBuffs FromStmtRow(const mysql::StmtRow &row)
+	{
+		MercBuffs e{};
+
+		e.MercBuffId         = row.Get<uint32_t>(0).value_or(0);
+		e.MercId             = row.Get<uint32_t>(1).value_or(0);
+		e.SpellId            = row.Get<uint32_t>(2).value_or(0);
+		e.CasterLevel        = row.Get<uint32_t>(3).value_or(0);
+		e.DurationFormula    = row.Get<uint32_t>(4).value_or(0);
+		e.TicsRemaining      = row.Get<int32_t>(5).value_or(0);
+		e.PoisonCounters     = row.Get<uint32_t>(6).value_or(0);
+		e.DiseaseCounters    = row.Get<uint32_t>(7).value_or(0);
+		e.CurseCounters      = row.Get<uint32_t>(8).value_or(0);
+		e.CorruptionCounters = row.Get<uint32_t>(9).value_or(0);
+		e.HitCount           = row.Get<uint32_t>(10).value_or(0);
+		e.MeleeRune          = row.Get<uint32_t>(11).value_or(0);
+		e.MagicRune          = row.Get<uint32_t>(12).value_or(0);
+		e.dot_rune           = row.Get<int32_t>(13).value_or(0);
+		e.caston_x           = row.Get<int32_t>(14).value_or(0);
+		e.Persistent         = row.Get<int8_t>(15).value_or(0);
+		e.caston_y           = row.Get<int32_t>(16).value_or(0);
+		e.caston_z           = row.Get<int32_t>(17).value_or(0);
+		e.ExtraDIChance      = row.Get<int32_t>(18).value_or(0);
+
+		return e;
+	}
+
+	static MercBuffs FindOnePrepared(
+		Database& db,
+		int merc_buffs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { merc_buffs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<MercBuffs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<MercBuffs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -552,7 +656,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<19> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.MercBuffId));
@@ -578,13 +690,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 
@@ -53,6 +55,9 @@ public:
 		int32_t     statscale;
 		float       spellscale;
 		float       healscale;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<33> changed_columns = std::bitset<33>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -301,6 +306,47 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		MercStats &e,
+		const MercStats &original
+	)
+	{
+		e.changed_columns[0] = e.merc_npc_type_id != original.merc_npc_type_id;
+		e.changed_columns[1] = e.clientlevel != original.clientlevel;
+		e.changed_columns[2] = e.level != original.level;
+		e.changed_columns[3] = e.hp != original.hp;
+		e.changed_columns[4] = e.mana != original.mana;
+		e.changed_columns[5] = e.AC != original.AC;
+		e.changed_columns[6] = e.ATK != original.ATK;
+		e.changed_columns[7] = e.STR != original.STR;
+		e.changed_columns[8] = e.STA != original.STA;
+		e.changed_columns[9] = e.DEX != original.DEX;
+		e.changed_columns[10] = e.AGI != original.AGI;
+		e.changed_columns[11] = e._INT != original._INT;
+		e.changed_columns[12] = e.WIS != original.WIS;
+		e.changed_columns[13] = e.CHA != original.CHA;
+		e.changed_columns[14] = e.MR != original.MR;
+		e.changed_columns[15] = e.CR != original.CR;
+		e.changed_columns[16] = e.DR != original.DR;
+		e.changed_columns[17] = e.FR != original.FR;
+		e.changed_columns[18] = e.PR != original.PR;
+		e.changed_columns[19] = e.Corrup != original.Corrup;
+		e.changed_columns[20] = e.mindmg != original.mindmg;
+		e.changed_columns[21] = e.maxdmg != original.maxdmg;
+		e.changed_columns[22] = e.attack_count != original.attack_count;
+		e.changed_columns[23] = e.attack_speed != original.attack_speed;
+		e.changed_columns[24] = e.attack_delay != original.attack_delay;
+		e.changed_columns[25] = e.special_abilities != original.special_abilities;
+		e.changed_columns[26] = e.Accuracy != original.Accuracy;
+		e.changed_columns[27] = e.hp_regen_rate != original.hp_regen_rate;
+		e.changed_columns[28] = e.mana_regen_rate != original.mana_regen_rate;
+		e.changed_columns[29] = e.runspeed != original.runspeed;
+		e.changed_columns[30] = e.statscale != original.statscale;
+		e.changed_columns[31] = e.spellscale != original.spellscale;
+		e.changed_columns[32] = e.healscale != original.healscale;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const MercStats &e
@@ -310,39 +356,43 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.merc_npc_type_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.clientlevel));
-		v.push_back(columns[2] + " = " + std::to_string(e.level));
-		v.push_back(columns[3] + " = " + std::to_string(e.hp));
-		v.push_back(columns[4] + " = " + std::to_string(e.mana));
-		v.push_back(columns[5] + " = " + std::to_string(e.AC));
-		v.push_back(columns[6] + " = " + std::to_string(e.ATK));
-		v.push_back(columns[7] + " = " + std::to_string(e.STR));
-		v.push_back(columns[8] + " = " + std::to_string(e.STA));
-		v.push_back(columns[9] + " = " + std::to_string(e.DEX));
-		v.push_back(columns[10] + " = " + std::to_string(e.AGI));
-		v.push_back(columns[11] + " = " + std::to_string(e._INT));
-		v.push_back(columns[12] + " = " + std::to_string(e.WIS));
-		v.push_back(columns[13] + " = " + std::to_string(e.CHA));
-		v.push_back(columns[14] + " = " + std::to_string(e.MR));
-		v.push_back(columns[15] + " = " + std::to_string(e.CR));
-		v.push_back(columns[16] + " = " + std::to_string(e.DR));
-		v.push_back(columns[17] + " = " + std::to_string(e.FR));
-		v.push_back(columns[18] + " = " + std::to_string(e.PR));
-		v.push_back(columns[19] + " = " + std::to_string(e.Corrup));
-		v.push_back(columns[20] + " = " + std::to_string(e.mindmg));
-		v.push_back(columns[21] + " = " + std::to_string(e.maxdmg));
-		v.push_back(columns[22] + " = " + std::to_string(e.attack_count));
-		v.push_back(columns[23] + " = " + std::to_string(e.attack_speed));
-		v.push_back(columns[24] + " = " + std::to_string(e.attack_delay));
-		v.push_back(columns[25] + " = '" + Strings::Escape(e.special_abilities) + "'");
-		v.push_back(columns[26] + " = " + std::to_string(e.Accuracy));
-		v.push_back(columns[27] + " = " + std::to_string(e.hp_regen_rate));
-		v.push_back(columns[28] + " = " + std::to_string(e.mana_regen_rate));
-		v.push_back(columns[29] + " = " + std::to_string(e.runspeed));
-		v.push_back(columns[30] + " = " + std::to_string(e.statscale));
-		v.push_back(columns[31] + " = " + std::to_string(e.spellscale));
-		v.push_back(columns[32] + " = " + std::to_string(e.healscale));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.merc_npc_type_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.clientlevel)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.AC)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.ATK)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.STR)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.STA)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.DEX)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.AGI)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e._INT)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.WIS)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.CHA)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.MR)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.CR)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.DR)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.FR)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.PR)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.Corrup)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.mindmg)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.maxdmg)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.attack_count)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.attack_speed)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.attack_delay)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = '" + Strings::Escape(e.special_abilities) + "'"); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.Accuracy)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.hp_regen_rate)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.mana_regen_rate)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.runspeed)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.statscale)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.spellscale)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.healscale)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -589,6 +639,88 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static MercStats FromStmtRow(const mysql::StmtRow &row)
+	{
+		MercStats e{};
+
+		e.merc_npc_type_id  = row.Get<uint32_t>(0).value_or(0);
+		e.clientlevel       = row.Get<uint8_t>(1).value_or(0);
+		e.level             = row.Get<uint8_t>(2).value_or(0);
+		e.hp                = row.Get<int32_t>(3).value_or(0);
+		e.mana              = row.Get<int32_t>(4).value_or(0);
+		e.AC                = row.Get<int16_t>(5).value_or(0);
+		e.ATK               = row.Get<int32_t>(6).value_or(0);
+		e.STR               = row.Get<uint32_t>(7).value_or(0);
+		e.STA               = row.Get<uint32_t>(8).value_or(0);
+		e.DEX               = row.Get<uint32_t>(9).value_or(0);
+		e.AGI               = row.Get<uint32_t>(10).value_or(0);
+		e._INT              = row.Get<uint32_t>(11).value_or(0);
+		e.WIS               = row.Get<uint32_t>(12).value_or(0);
+		e.CHA               = row.Get<uint32_t>(13).value_or(0);
+		e.MR                = row.Get<int16_t>(14).value_or(0);
+		e.CR                = row.Get<int16_t>(15).value_or(0);
+		e.DR                = row.Get<int16_t>(16).value_or(0);
+		e.FR                = row.Get<int16_t>(17).value_or(0);
+		e.PR                = row.Get<int16_t>(18).value_or(0);
+		e.Corrup            = row.Get<int16_t>(19).value_or(0);
+		e.mindmg            = row.Get<uint32_t>(20).value_or(0);
+		e.maxdmg            = row.Get<uint32_t>(21).value_or(0);
+		e.attack_count      = row.Get<int16_t>(22).value_or(0);
+		e.attack_speed      = row.Get<int8_t>(23).value_or(0);
+		e.attack_delay      = row.Get<uint8_t>(24).value_or(0);
+		e.special_abilities = row.GetStr(25).value_or("");
+		e.Accuracy          = row.Get<int32_t>(26).value_or(0);
+		e.hp_regen_rate     = row.Get<uint32_t>(27).value_or(0);
+		e.mana_regen_rate   = row.Get<uint32_t>(28).value_or(0);
+		e.runspeed          = row.Get<float>(29).value_or(0);
+		e.statscale         = row.Get<int32_t>(30).value_or(0);
+		e.spellscale        = row.Get<float>(31).value_or(0);
+		e.healscale         = row.Get<float>(32).value_or(0);
+
+		return e;
+	}
+
+	static MercStats FindOnePrepared(
+		Database& db,
+		int merc_stats_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { merc_stats_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<MercStats> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<MercStats> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -708,7 +840,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<33> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.merc_npc_type_id));
@@ -748,13 +888,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 
@@ -27,6 +29,9 @@ public:
 		std::string dbstring;
 		int8_t      name_type_id;
 		uint32_t    clientversion;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -171,6 +176,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		MercTemplates &e,
+		const MercTemplates &original
+	)
+	{
+		e.changed_columns[0] = e.merc_template_id != original.merc_template_id;
+		e.changed_columns[1] = e.merc_type_id != original.merc_type_id;
+		e.changed_columns[2] = e.merc_subtype_id != original.merc_subtype_id;
+		e.changed_columns[3] = e.merc_npc_type_id != original.merc_npc_type_id;
+		e.changed_columns[4] = e.dbstring != original.dbstring;
+		e.changed_columns[5] = e.name_type_id != original.name_type_id;
+		e.changed_columns[6] = e.clientversion != original.clientversion;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const MercTemplates &e
@@ -180,12 +200,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.merc_type_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.merc_subtype_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.merc_npc_type_id));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.dbstring) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.name_type_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.clientversion));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.merc_type_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.merc_subtype_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.merc_npc_type_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.dbstring) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.name_type_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.clientversion)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -328,6 +352,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static MercTemplates FromStmtRow(const mysql::StmtRow &row)
+	{
+		MercTemplates e{};
+
+		e.merc_template_id = row.Get<uint32_t>(0).value_or(0);
+		e.merc_type_id     = row.Get<uint32_t>(1).value_or(0);
+		e.merc_subtype_id  = row.Get<uint32_t>(2).value_or(0);
+		e.merc_npc_type_id = row.Get<uint32_t>(3).value_or(0);
+		e.dbstring         = row.GetStr(4).value_or("");
+		e.name_type_id     = row.Get<int8_t>(5).value_or(0);
+		e.clientversion    = row.Get<uint32_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static MercTemplates FindOnePrepared(
+		Database& db,
+		int merc_templates_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { merc_templates_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<MercTemplates> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<MercTemplates> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -421,7 +501,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.merc_template_id));
@@ -435,13 +523,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
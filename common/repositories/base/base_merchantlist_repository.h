@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseMerchantlistRepository {
@@ -36,6 +38,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Merchantlist &e,
+		const Merchantlist &original
+	)
+	{
+		e.changed_columns[0] = e.merchantid != original.merchantid;
+		e.changed_columns[1] = e.slot != original.slot;
+		e.changed_columns[2] = e.item != original.item;
+		e.changed_columns[3] = e.faction_required != original.faction_required;
+		e.changed_columns[4] = e.level_required != original.level_required;
+		e.changed_columns[5] = e.min_status != original.min_status;
+		e.changed_columns[6] = e.max_status != original.max_status;
+		e.changed_columns[7] = e.alt_currency_cost != original.alt_currency_cost;
+		e.changed_columns[8] = e.classes_required != original.classes_required;
+		e.changed_columns[9] = e.probability != original.probability;
+		e.changed_columns[10] = e.bucket_name != original.bucket_name;
+		e.changed_columns[11] = e.bucket_value != original.bucket_value;
+		e.changed_columns[12] = e.bucket_comparison != original.bucket_comparison;
+		e.changed_columns[13] = e.min_expansion != original.min_expansion;
+		e.changed_columns[14] = e.max_expansion != original.max_expansion;
+		e.changed_columns[15] = e.content_flags != original.content_flags;
+		e.changed_columns[16] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Merchantlist &e
@@ -229,23 +259,27 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.merchantid));
-		v.push_back(columns[1] + " = " + std::to_string(e.slot));
-		v.push_back(columns[2] + " = " + std::to_string(e.item));
-		v.push_back(columns[3] + " = " + std::to_string(e.faction_required));
-		v.push_back(columns[4] + " = " + std::to_string(e.level_required));
-		v.push_back(columns[5] + " = " + std::to_string(e.min_status));
-		v.push_back(columns[6] + " = " + std::to_string(e.max_status));
-		v.push_back(columns[7] + " = " + std::to_string(e.alt_currency_cost));
-		v.push_back(columns[8] + " = " + std::to_string(e.classes_required));
-		v.push_back(columns[9] + " = " + std::to_string(e.probability));
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.bucket_name) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.bucket_value) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.bucket_comparison));
-		v.push_back(columns[13] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[14] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[16] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.merchantid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.slot)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.faction_required)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.level_required)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.min_status)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.max_status)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.alt_currency_cost)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.classes_required)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.probability)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.bucket_name) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.bucket_value) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.bucket_comparison)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -428,6 +462,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Merchantlist FromStmtRow(const mysql::StmtRow &row)
+	{
+		Merchantlist e{};
+
+		e.merchantid             = row.Get<int32_t>(0).value_or(0);
+		e.slot                   = row.Get<uint32_t>(1).value_or(0);
+		e.item                   = row.Get<int32_t>(2).value_or(0);
+		e.faction_required       = row.Get<int16_t>(3).value_or(-100);
+		e.level_required         = row.Get<uint8_t>(4).value_or(0);
+		e.min_status             = row.Get<uint8_t>(5).value_or(0);
+		e.max_status             = row.Get<uint8_t>(6).value_or(255);
+		e.alt_currency_cost      = row.Get<uint16_t>(7).value_or(0);
+		e.classes_required       = row.Get<int32_t>(8).value_or(65535);
+		e.probability            = row.Get<int32_t>(9).value_or(100);
+		e.bucket_name            = row.GetStr(10).value_or("");
+		e.bucket_value           = row.GetStr(11).value_or("");
+		e.bucket_comparison      = row.Get<uint8_t>(12).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(13).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(14).value_or(-1);
+		e.content_flags          = row.GetStr(15).value_or("");
+		e.content_flags_disabled = row.GetStr(16).value_or("");
+
+		return e;
+	}
+
+	static Merchantlist FindOnePrepared(
+		Database& db,
+		int merchantlist_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { merchantlist_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Merchantlist> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Merchantlist> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -531,7 +631,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.merchantid));
@@ -555,13 +663,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseMercsRepository {
@@ -43,6 +45,9 @@ public:
 		uint32_t    DrakkinHeritage;
 		uint32_t    DrakkinTattoo;
 		uint32_t    DrakkinDetails;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<24> changed_columns = std::bitset<24>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -255,6 +260,38 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Mercs &e,
+		const Mercs &original
+	)
+	{
+		e.changed_columns[0] = e.MercID != original.MercID;
+		e.changed_columns[1] = e.OwnerCharacterID != original.OwnerCharacterID;
+		e.changed_columns[2] = e.Slot != original.Slot;
+		e.changed_columns[3] = e.Name != original.Name;
+		e.changed_columns[4] = e.TemplateID != original.TemplateID;
+		e.changed_columns[5] = e.SuspendedTime != original.SuspendedTime;
+		e.changed_columns[6] = e.IsSuspended != original.IsSuspended;
+		e.changed_columns[7] = e.TimerRemaining != original.TimerRemaining;
+		e.changed_columns[8] = e.Gender != original.Gender;
+		e.changed_columns[9] = e.MercSize != original.MercSize;
+		e.changed_columns[10] = e.StanceID != original.StanceID;
+		e.changed_columns[11] = e.HP != original.HP;
+		e.changed_columns[12] = e.Mana != original.Mana;
+		e.changed_columns[13] = e.Endurance != original.Endurance;
+		e.changed_columns[14] = e.Face != original.Face;
+		e.changed_columns[15] = e.LuclinHairStyle != original.LuclinHairStyle;
+		e.changed_columns[16] = e.LuclinHairColor != original.LuclinHairColor;
+		e.changed_columns[17] = e.LuclinEyeColor != original.LuclinEyeColor;
+		e.changed_columns[18] = e.LuclinEyeColor2 != original.LuclinEyeColor2;
+		e.changed_columns[19] = e.LuclinBeardColor != original.LuclinBeardColor;
+		e.changed_columns[20] = e.LuclinBeard != original.LuclinBeard;
+		e.changed_columns[21] = e.DrakkinHeritage != original.DrakkinHeritage;
+		e.changed_columns[22] = e.DrakkinTattoo != original.DrakkinTattoo;
+		e.changed_columns[23] = e.DrakkinDetails != original.DrakkinDetails;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Mercs &e
@@ -264,29 +301,33 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.OwnerCharacterID));
-		v.push_back(columns[2] + " = " + std::to_string(e.Slot));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.Name) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.TemplateID));
-		v.push_back(columns[5] + " = " + std::to_string(e.SuspendedTime));
-		v.push_back(columns[6] + " = " + std::to_string(e.IsSuspended));
-		v.push_back(columns[7] + " = " + std::to_string(e.TimerRemaining));
-		v.push_back(columns[8] + " = " + std::to_string(e.Gender));
-		v.push_back(columns[9] + " = " + std::to_string(e.MercSize));
-		v.push_back(columns[10] + " = " + std::to_string(e.StanceID));
-		v.push_back(columns[11] + " = " + std::to_string(e.HP));
-		v.push_back(columns[12] + " = " + std::to_string(e.Mana));
-		v.push_back(columns[13] + " = " + std::to_string(e.Endurance));
-		v.push_back(columns[14] + " = " + std::to_string(e.Face));
-		v.push_back(columns[15] + " = " + std::to_string(e.LuclinHairStyle));
-		v.push_back(columns[16] + " = " + std::to_string(e.LuclinHairColor));
-		v.push_back(columns[17] + " = " + std::to_string(e.LuclinEyeColor));
-		v.push_back(columns[18] + " = " + std::to_string(e.LuclinEyeColor2));
-		v.push_back(columns[19] + " = " + std::to_string(e.LuclinBeardColor));
-		v.push_back(columns[20] + " = " + std::to_string(e.LuclinBeard));
-		v.push_back(columns[21] + " = " + std::to_string(e.DrakkinHeritage));
-		v.push_back(columns[22] + " = " + std::to_string(e.DrakkinTattoo));
-		v.push_back(columns[23] + " = " + std::to_string(e.DrakkinDetails));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.OwnerCharacterID)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.Slot)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.Name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.TemplateID)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.SuspendedTime)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.IsSuspended)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.TimerRemaining)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.Gender)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.MercSize)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.StanceID)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.HP)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.Mana)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.Endurance)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.Face)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.LuclinHairStyle)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.LuclinHairColor)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.LuclinEyeColor)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.LuclinEyeColor2)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.LuclinBeardColor)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.LuclinBeard)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.DrakkinHeritage)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.DrakkinTattoo)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.DrakkinDetails)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -497,6 +538,79 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Mercs FromStmtRow(const mysql::StmtRow &row)
+	{
+		Mercs e{};
+
+		e.MercID           = row.Get<uint32_t>(0).value_or(0);
+		e.OwnerCharacterID = row.Get<uint32_t>(1).value_or(0);
+		e.Slot             = row.Get<uint8_t>(2).value_or(0);
+		e.Name             = row.GetStr(3).value_or("");
+		e.TemplateID       = row.Get<uint32_t>(4).value_or(0);
+		e.SuspendedTime    = row.Get<uint32_t>(5).value_or(0);
+		e.IsSuspended      = row.Get<uint8_t>(6).value_or(0);
+		e.TimerRemaining   = row.Get<uint32_t>(7).value_or(0);
+		e.Gender           = row.Get<uint8_t>(8).value_or(0);
+		e.MercSize         = row.Get<float>(9).value_or(5);
+		e.StanceID         = row.Get<uint8_t>(10).value_or(0);
+		e.HP               = row.Get<uint32_t>(11).value_or(0);
+		e.Mana             = row.Get<uint32_t>(12).value_or(0);
+		e.Endurance        = row.Get<uint32_t>(13).value_or(0);
+		e.Face             = row.Get<uint32_t>(14).value_or(1);
+		e.LuclinHairStyle  = row.Get<uint32_t>(15).value_or(1);
+		e.LuclinHairColor  = row.Get<uint32_t>(16).value_or(1);
+		e.LuclinEyeColor   = row.Get<uint32_t>(17).value_or(1);
+		e.LuclinEyeColor2  = row.Get<uint32_t>(18).value_or(1);
+		e.LuclinBeardColor = row.Get<uint32_t>(19).value_or(1);
+		e.LuclinBeard      = row.Get<uint32_t>(20).value_or(0);
+		e.DrakkinHeritage  = row.Get<uint32_t>(21).value_or(0);
+		e.DrakkinTattoo    = row.Get<uint32_t>(22).value_or(0);
+		e.DrakkinDetails   = row.Get<uint32_t>(23).value_or(0);
+
+		return e;
+	}
+
+	static Mercs FindOnePrepared(
+		Database& db,
+		int mercs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { mercs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Mercs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Mercs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -607,7 +721,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<24> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.MercID));
@@ -638,13 +760,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseNpcScaleGlobalBaseRepository {
@@ -52,6 +54,9 @@ public:
 		uint32_t    avoidance;
 		int32_t     heroic_strikethrough;
 		std::string special_abilities;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<33> changed_columns = std::bitset<33>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -300,6 +305,47 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		NpcScaleGlobalBase &e,
+		const NpcScaleGlobalBase &original
+	)
+	{
+		e.changed_columns[0] = e.type != original.type;
+		e.changed_columns[1] = e.level != original.level;
+		e.changed_columns[2] = e.zone_id_list != original.zone_id_list;
+		e.changed_columns[3] = e.instance_version_list != original.instance_version_list;
+		e.changed_columns[4] = e.ac != original.ac;
+		e.changed_columns[5] = e.hp != original.hp;
+		e.changed_columns[6] = e.accuracy != original.accuracy;
+		e.changed_columns[7] = e.slow_mitigation != original.slow_mitigation;
+		e.changed_columns[8] = e.attack != original.attack;
+		e.changed_columns[9] = e.strength != original.strength;
+		e.changed_columns[10] = e.stamina != original.stamina;
+		e.changed_columns[11] = e.dexterity != original.dexterity;
+		e.changed_columns[12] = e.agility != original.agility;
+		e.changed_columns[13] = e.intelligence != original.intelligence;
+		e.changed_columns[14] = e.wisdom != original.wisdom;
+		e.changed_columns[15] = e.charisma != original.charisma;
+		e.changed_columns[16] = e.magic_resist != original.magic_resist;
+		e.changed_columns[17] = e.cold_resist != original.cold_resist;
+		e.changed_columns[18] = e.fire_resist != original.fire_resist;
+		e.changed_columns[19] = e.poison_resist != original.poison_resist;
+		e.changed_columns[20] = e.disease_resist != original.disease_resist;
+		e.changed_columns[21] = e.corruption_resist != original.corruption_resist;
+		e.changed_columns[22] = e.physical_resist != original.physical_resist;
+		e.changed_columns[23] = e.min_dmg != original.min_dmg;
+		e.changed_columns[24] = e.max_dmg != original.max_dmg;
+		e.changed_columns[25] = e.hp_regen_rate != original.hp_regen_rate;
+		e.changed_columns[26] = e.hp_regen_per_second != original.hp_regen_per_second;
+		e.changed_columns[27] = e.attack_delay != original.attack_delay;
+		e.changed_columns[28] = e.spell_scale != original.spell_scale;
+		e.changed_columns[29] = e.heal_scale != original.heal_scale;
+		e.changed_columns[30] = e.avoidance != original.avoidance;
+		e.changed_columns[31] = e.heroic_strikethrough != original.heroic_strikethrough;
+		e.changed_columns[32] = e.special_abilities != original.special_abilities;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const NpcScaleGlobalBase &e
@@ -309,39 +355,43 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.type));
-		v.push_back(columns[1] + " = " + std::to_string(e.level));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.zone_id_list) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.instance_version_list) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.ac));
-		v.push_back(columns[5] + " = " + std::to_string(e.hp));
-		v.push_back(columns[6] + " = " + std::to_string(e.accuracy));
-		v.push_back(columns[7] + " = " + std::to_string(e.slow_mitigation));
-		v.push_back(columns[8] + " = " + std::to_string(e.attack));
-		v.push_back(columns[9] + " = " + std::to_string(e.strength));
-		v.push_back(columns[10] + " = " + std::to_string(e.stamina));
-		v.push_back(columns[11] + " = " + std::to_string(e.dexterity));
-		v.push_back(columns[12] + " = " + std::to_string(e.agility));
-		v.push_back(columns[13] + " = " + std::to_string(e.intelligence));
-		v.push_back(columns[14] + " = " + std::to_string(e.wisdom));
-		v.push_back(columns[15] + " = " + std::to_string(e.charisma));
-		v.push_back(columns[16] + " = " + std::to_string(e.magic_resist));
-		v.push_back(columns[17] + " = " + std::to_string(e.cold_resist));
-		v.push_back(columns[18] + " = " + std::to_string(e.fire_resist));
-		v.push_back(columns[19] + " = " + std::to_string(e.poison_resist));
-		v.push_back(columns[20] + " = " + std::to_string(e.disease_resist));
-		v.push_back(columns[21] + " = " + std::to_string(e.corruption_resist));
-		v.push_back(columns[22] + " = " + std::to_string(e.physical_resist));
-		v.push_back(columns[23] + " = " + std::to_string(e.min_dmg));
-		v.push_back(columns[24] + " = " + std::to_string(e.max_dmg));
-		v.push_back(columns[25] + " = " + std::to_string(e.hp_regen_rate));
-		v.push_back(columns[26] + " = " + std::to_string(e.hp_regen_per_second));
-		v.push_back(columns[27] + " = " + std::to_string(e.attack_delay));
-		v.push_back(columns[28] + " = " + std::to_string(e.spell_scale));
-		v.push_back(columns[29] + " = " + std::to_string(e.heal_scale));
-		v.push_back(columns[30] + " = " + std::to_string(e.avoidance));
-		v.push_back(columns[31] + " = " + std::to_string(e.heroic_strikethrough));
-		v.push_back(columns[32] + " = '" + Strings::Escape(e.special_abilities) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.zone_id_list) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.instance_version_list) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.ac)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.accuracy)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.slow_mitigation)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.attack)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.strength)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.stamina)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.dexterity)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.agility)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.intelligence)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.wisdom)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.charisma)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.magic_resist)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.cold_resist)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.fire_resist)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.poison_resist)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.disease_resist)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.corruption_resist)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.physical_resist)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.min_dmg)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.max_dmg)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.hp_regen_rate)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.hp_regen_per_second)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.attack_delay)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.spell_scale)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.heal_scale)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.avoidance)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.heroic_strikethrough)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = '" + Strings::Escape(e.special_abilities) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -588,6 +638,88 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static NpcScaleGlobalBase FromStmtRow(const mysql::StmtRow &row)
+	{
+		NpcScaleGlobalBase e{};
+
+		e.type                  = row.Get<int32_t>(0).value_or(0);
+		e.level                 = row.Get<int32_t>(1).value_or(0);
+		e.zone_id_list          = row.GetStr(2).value_or("");
+		e.instance_version_list = row.GetStr(3).value_or("");
+		e.ac                    = row.Get<int32_t>(4).value_or(0);
+		e.hp                    = row.Get<int64_t>(5).value_or(0);
+		e.accuracy              = row.Get<int32_t>(6).value_or(0);
+		e.slow_mitigation       = row.Get<int32_t>(7).value_or(0);
+		e.attack                = row.Get<int32_t>(8).value_or(0);
+		e.strength              = row.Get<int32_t>(9).value_or(0);
+		e.stamina               = row.Get<int32_t>(10).value_or(0);
+		e.dexterity             = row.Get<int32_t>(11).value_or(0);
+		e.agility               = row.Get<int32_t>(12).value_or(0);
+		e.intelligence          = row.Get<int32_t>(13).value_or(0);
+		e.wisdom                = row.Get<int32_t>(14).value_or(0);
+		e.charisma              = row.Get<int32_t>(15).value_or(0);
+		e.magic_resist          = row.Get<int32_t>(16).value_or(0);
+		e.cold_resist           = row.Get<int32_t>(17).value_or(0);
+		e.fire_resist           = row.Get<int32_t>(18).value_or(0);
+		e.poison_resist         = row.Get<int32_t>(19).value_or(0);
+		e.disease_resist        = row.Get<int32_t>(20).value_or(0);
+		e.corruption_resist     = row.Get<int32_t>(21).value_or(0);
+		e.physical_resist       = row.Get<int32_t>(22).value_or(0);
+		e.min_dmg               = row.Get<int32_t>(23).value_or(0);
+		e.max_dmg               = row.Get<int32_t>(24).value_or(0);
+		e.hp_regen_rate         = row.Get<int64_t>(25).value_or(0);
+		e.hp_regen_per_second   = row.Get<int64_t>(26).value_or(0);
+		e.attack_delay          = row.Get<int32_t>(27).value_or(0);
+		e.spell_scale           = row.Get<int32_t>(28).value_or(100);
+		e.heal_scale            = row.Get<int32_t>(29).value_or(100);
+		e.avoidance             = row.Get<uint32_t>(30).value_or(0);
+		e.heroic_strikethrough  = row.Get<int32_t>(31).value_or(0);
+		e.special_abilities     = row.GetStr(32).value_or("");
+
+		return e;
+	}
+
+	static NpcScaleGlobalBase FindOnePrepared(
+		Database& db,
+		int npc_scale_global_base_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { npc_scale_global_base_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<NpcScaleGlobalBase> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<NpcScaleGlobalBase> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -707,7 +839,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<33> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.type));
@@ -747,13 +887,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseNpcSpellsEffectsEntriesRepository {
@@ -27,6 +29,9 @@ public:
 		int32_t  se_base;
 		int32_t  se_limit;
 		int32_t  se_max;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<8> changed_columns = std::bitset<8>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -175,6 +180,22 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		NpcSpellsEffectsEntries &e,
+		const NpcSpellsEffectsEntries &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.npc_spells_effects_id != original.npc_spells_effects_id;
+		e.changed_columns[2] = e.spell_effect_id != original.spell_effect_id;
+		e.changed_columns[3] = e.minlevel != original.minlevel;
+		e.changed_columns[4] = e.maxlevel != original.maxlevel;
+		e.changed_columns[5] = e.se_base != original.se_base;
+		e.changed_columns[6] = e.se_limit != original.se_limit;
+		e.changed_columns[7] = e.se_max != original.se_max;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const NpcSpellsEffectsEntries &e
@@ -184,13 +205,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.npc_spells_effects_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.spell_effect_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.minlevel));
-		v.push_back(columns[4] + " = " + std::to_string(e.maxlevel));
-		v.push_back(columns[5] + " = " + std::to_string(e.se_base));
-		v.push_back(columns[6] + " = " + std::to_string(e.se_limit));
-		v.push_back(columns[7] + " = " + std::to_string(e.se_max));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npc_spells_effects_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spell_effect_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.minlevel)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.maxlevel)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.se_base)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.se_limit)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.se_max)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -337,6 +362,63 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static NpcSpellsEffectsEntries FromStmtRow(const mysql::StmtRow &row)
+	{
+		NpcSpellsEffectsEntries e{};
+
+		e.id                    = row.Get<uint32_t>(0).value_or(0);
+		e.npc_spells_effects_id = row.Get<int32_t>(1).value_or(0);
+		e.spell_effect_id       = row.Get<int16_t>(2).value_or(0);
+		e.minlevel              = row.Get<uint8_t>(3).value_or(0);
+		e.maxlevel              = row.Get<uint8_t>(4).value_or(255);
+		e.se_base               = row.Get<int32_t>(5).value_or(0);
+		e.se_limit              = row.Get<int32_t>(6).value_or(0);
+		e.se_max                = row.Get<int32_t>(7).value_or(0);
+
+		return e;
+	}
+
+	static NpcSpellsEffectsEntries FindOnePrepared(
+		Database& db,
+		int npc_spells_effects_entries_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { npc_spells_effects_entries_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<NpcSpellsEffectsEntries> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<NpcSpellsEffectsEntries> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -431,7 +513,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<8> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -446,13 +536,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseNpcSpellsRepository {
@@ -40,6 +42,9 @@ public:
 		uint32_t    idle_no_sp_recast_min;
 		uint32_t    idle_no_sp_recast_max;
 		uint8_t     idle_b_chance;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<21> changed_columns = std::bitset<21>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -240,6 +245,35 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		NpcSpells &e,
+		const NpcSpells &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.parent_list != original.parent_list;
+		e.changed_columns[3] = e.attack_proc != original.attack_proc;
+		e.changed_columns[4] = e.proc_chance != original.proc_chance;
+		e.changed_columns[5] = e.range_proc != original.range_proc;
+		e.changed_columns[6] = e.rproc_chance != original.rproc_chance;
+		e.changed_columns[7] = e.defensive_proc != original.defensive_proc;
+		e.changed_columns[8] = e.dproc_chance != original.dproc_chance;
+		e.changed_columns[9] = e.fail_recast != original.fail_recast;
+		e.changed_columns[10] = e.engaged_no_sp_recast_min != original.engaged_no_sp_recast_min;
+		e.changed_columns[11] = e.engaged_no_sp_recast_max != original.engaged_no_sp_recast_max;
+		e.changed_columns[12] = e.engaged_b_self_chance != original.engaged_b_self_chance;
+		e.changed_columns[13] = e.engaged_b_other_chance != original.engaged_b_other_chance;
+		e.changed_columns[14] = e.engaged_d_chance != original.engaged_d_chance;
+		e.changed_columns[15] = e.pursue_no_sp_recast_min != original.pursue_no_sp_recast_min;
+		e.changed_columns[16] = e.pursue_no_sp_recast_max != original.pursue_no_sp_recast_max;
+		e.changed_columns[17] = e.pursue_d_chance != original.pursue_d_chance;
+		e.changed_columns[18] = e.idle_no_sp_recast_min != original.idle_no_sp_recast_min;
+		e.changed_columns[19] = e.idle_no_sp_recast_max != original.idle_no_sp_recast_max;
+		e.changed_columns[20] = e.idle_b_chance != original.idle_b_chance;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const NpcSpells &e
@@ -249,26 +283,30 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.parent_list));
-		v.push_back(columns[3] + " = " + std::to_string(e.attack_proc));
-		v.push_back(columns[4] + " = " + std::to_string(e.proc_chance));
-		v.push_back(columns[5] + " = " + std::to_string(e.range_proc));
-		v.push_back(columns[6] + " = " + std::to_string(e.rproc_chance));
-		v.push_back(columns[7] + " = " + std::to_string(e.defensive_proc));
-		v.push_back(columns[8] + " = " + std::to_string(e.dproc_chance));
-		v.push_back(columns[9] + " = " + std::to_string(e.fail_recast));
-		v.push_back(columns[10] + " = " + std::to_string(e.engaged_no_sp_recast_min));
-		v.push_back(columns[11] + " = " + std::to_string(e.engaged_no_sp_recast_max));
-		v.push_back(columns[12] + " = " + std::to_string(e.engaged_b_self_chance));
-		v.push_back(columns[13] + " = " + std::to_string(e.engaged_b_other_chance));
-		v.push_back(columns[14] + " = " + std::to_string(e.engaged_d_chance));
-		v.push_back(columns[15] + " = " + std::to_string(e.pursue_no_sp_recast_min));
-		v.push_back(columns[16] + " = " + std::to_string(e.pursue_no_sp_recast_max));
-		v.push_back(columns[17] + " = " + std::to_string(e.pursue_d_chance));
-		v.push_back(columns[18] + " = " + std::to_string(e.idle_no_sp_recast_min));
-		v.push_back(columns[19] + " = " + std::to_string(e.idle_no_sp_recast_max));
-		v.push_back(columns[20] + " = " + std::to_string(e.idle_b_chance));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.parent_list)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.attack_proc)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.proc_chance)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.range_proc)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.rproc_chance)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.defensive_proc)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.dproc_chance)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.fail_recast)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.engaged_no_sp_recast_min)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.engaged_no_sp_recast_max)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.engaged_b_self_chance)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.engaged_b_other_chance)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.engaged_d_chance)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.pursue_no_sp_recast_min)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.pursue_no_sp_recast_max)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.pursue_d_chance)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.idle_no_sp_recast_min)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.idle_no_sp_recast_max)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.idle_b_chance)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -467,6 +505,76 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static NpcSpells FromStmtRow(const mysql::StmtRow &row)
+	{
+		NpcSpells e{};
+
+		e.id                       = row.Get<uint32_t>(0).value_or(0);
+		e.name                     = row.GetStr(1).value_or("");
+		e.parent_list              = row.Get<uint32_t>(2).value_or(0);
+		e.attack_proc              = row.Get<int16_t>(3).value_or(-1);
+		e.proc_chance              = row.Get<int8_t>(4).value_or(3);
+		e.range_proc               = row.Get<int16_t>(5).value_or(-1);
+		e.rproc_chance             = row.Get<int16_t>(6).value_or(0);
+		e.defensive_proc           = row.Get<int16_t>(7).value_or(-1);
+		e.dproc_chance             = row.Get<int16_t>(8).value_or(0);
+		e.fail_recast              = row.Get<uint32_t>(9).value_or(0);
+		e.engaged_no_sp_recast_min = row.Get<uint32_t>(10).value_or(0);
+		e.engaged_no_sp_recast_max = row.Get<uint32_t>(11).value_or(0);
+		e.engaged_b_self_chance    = row.Get<uint8_t>(12).value_or(0);
+		e.engaged_b_other_chance   = row.Get<uint8_t>(13).value_or(0);
+		e.engaged_d_chance         = row.Get<uint8_t>(14).value_or(0);
+		e.pursue_no_sp_recast_min  = row.Get<uint32_t>(15).value_or(0);
+		e.pursue_no_sp_recast_max  = row.Get<uint32_t>(16).value_or(0);
+		e.pursue_d_chance          = row.Get<uint8_t>(17).value_or(0);
+		e.idle_no_sp_recast_min    = row.Get<uint32_t>(18).value_or(0);
+		e.idle_no_sp_recast_max    = row.Get<uint32_t>(19).value_or(0);
+		e.idle_b_chance            = row.Get<uint8_t>(20).value_or(0);
+
+		return e;
+	}
+
+	static NpcSpells FindOnePrepared(
+		Database& db,
+		int npc_spells_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { npc_spells_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<NpcSpells> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<NpcSpells> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -574,7 +682,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<21> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -602,13 +718,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseNpcTypesRepository {
@@ -149,6 +151,9 @@ public:
 		uint8_t     keeps_sold_items;
 		uint8_t     is_parcel_merchant;
 		uint8_t     multiquest_enabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<130> changed_columns = std::bitset<130>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -785,6 +790,144 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		NpcTypes &e,
+		const NpcTypes &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.lastname != original.lastname;
+		e.changed_columns[3] = e.level != original.level;
+		e.changed_columns[4] = e.race != original.race;
+		e.changed_columns[5] = e.class_ != original.class_;
+		e.changed_columns[6] = e.bodytype != original.bodytype;
+		e.changed_columns[7] = e.hp != original.hp;
+		e.changed_columns[8] = e.mana != original.mana;
+		e.changed_columns[9] = e.gender != original.gender;
+		e.changed_columns[10] = e.texture != original.texture;
+		e.changed_columns[11] = e.helmtexture != original.helmtexture;
+		e.changed_columns[12] = e.herosforgemodel != original.herosforgemodel;
+		e.changed_columns[13] = e.size != original.size;
+		e.changed_columns[14] = e.hp_regen_rate != original.hp_regen_rate;
+		e.changed_columns[15] = e.hp_regen_per_second != original.hp_regen_per_second;
+		e.changed_columns[16] = e.mana_regen_rate != original.mana_regen_rate;
+		e.changed_columns[17] = e.loottable_id != original.loottable_id;
+		e.changed_columns[18] = e.merchant_id != original.merchant_id;
+		e.changed_columns[19] = e.greed != original.greed;
+		e.changed_columns[20] = e.alt_currency_id != original.alt_currency_id;
+		e.changed_columns[21] = e.npc_spells_id != original.npc_spells_id;
+		e.changed_columns[22] = e.npc_spells_effects_id != original.npc_spells_effects_id;
+		e.changed_columns[23] = e.npc_faction_id != original.npc_faction_id;
+		e.changed_columns[24] = e.adventure_template_id != original.adventure_template_id;
+		e.changed_columns[25] = e.trap_template != original.trap_template;
+		e.changed_columns[26] = e.mindmg != original.mindmg;
+		e.changed_columns[27] = e.maxdmg != original.maxdmg;
+		e.changed_columns[28] = e.attack_count != original.attack_count;
+		e.changed_columns[29] = e.npcspecialattks != original.npcspecialattks;
+		e.changed_columns[30] = e.special_abilities != original.special_abilities;
+		e.changed_columns[31] = e.aggroradius != original.aggroradius;
+		e.changed_columns[32] = e.assistradius != original.assistradius;
+		e.changed_columns[33] = e.face != original.face;
+		e.changed_columns[34] = e.luclin_hairstyle != original.luclin_hairstyle;
+		e.changed_columns[35] = e.luclin_haircolor != original.luclin_haircolor;
+		e.changed_columns[36] = e.luclin_eyecolor != original.luclin_eyecolor;
+		e.changed_columns[37] = e.luclin_eyecolor2 != original.luclin_eyecolor2;
+		e.changed_columns[38] = e.luclin_beardcolor != original.luclin_beardcolor;
+		e.changed_columns[39] = e.luclin_beard != original.luclin_beard;
+		e.changed_columns[40] = e.drakkin_heritage != original.drakkin_heritage;
+		e.changed_columns[41] = e.drakkin_tattoo != original.drakkin_tattoo;
+		e.changed_columns[42] = e.drakkin_details != original.drakkin_details;
+		e.changed_columns[43] = e.armortint_id != original.armortint_id;
+		e.changed_columns[44] = e.armortint_red != original.armortint_red;
+		e.changed_columns[45] = e.armortint_green != original.armortint_green;
+		e.changed_columns[46] = e.armortint_blue != original.armortint_blue;
+		e.changed_columns[47] = e.d_melee_texture1 != original.d_melee_texture1;
+		e.changed_columns[48] = e.d_melee_texture2 != original.d_melee_texture2;
+		e.changed_columns[49] = e.ammo_idfile != original.ammo_idfile;
+		e.changed_columns[50] = e.prim_melee_type != original.prim_melee_type;
+		e.changed_columns[51] = e.sec_melee_type != original.sec_melee_type;
+		e.changed_columns[52] = e.ranged_type != original.ranged_type;
+		e.changed_columns[53] = e.runspeed != original.runspeed;
+		e.changed_columns[54] = e.MR != original.MR;
+		e.changed_columns[55] = e.CR != original.CR;
+		e.changed_columns[56] = e.DR != original.DR;
+		e.changed_columns[57] = e.FR != original.FR;
+		e.changed_columns[58] = e.PR != original.PR;
+		e.changed_columns[59] = e.Corrup != original.Corrup;
+		e.changed_columns[60] = e.PhR != original.PhR;
+		e.changed_columns[61] = e.see_invis != original.see_invis;
+		e.changed_columns[62] = e.see_invis_undead != original.see_invis_undead;
+		e.changed_columns[63] = e.qglobal != original.qglobal;
+		e.changed_columns[64] = e.AC != original.AC;
+		e.changed_columns[65] = e.npc_aggro != original.npc_aggro;
+		e.changed_columns[66] = e.spawn_limit != original.spawn_limit;
+		e.changed_columns[67] = e.attack_speed != original.attack_speed;
+		e.changed_columns[68] = e.attack_delay != original.attack_delay;
+		e.changed_columns[69] = e.findable != original.findable;
+		e.changed_columns[70] = e.STR != original.STR;
+		e.changed_columns[71] = e.STA != original.STA;
+		e.changed_columns[72] = e.DEX != original.DEX;
+		e.changed_columns[73] = e.AGI != original.AGI;
+		e.changed_columns[74] = e._INT != original._INT;
+		e.changed_columns[75] = e.WIS != original.WIS;
+		e.changed_columns[76] = e.CHA != original.CHA;
+		e.changed_columns[77] = e.see_hide != original.see_hide;
+		e.changed_columns[78] = e.see_improved_hide != original.see_improved_hide;
+		e.changed_columns[79] = e.trackable != original.trackable;
+		e.changed_columns[80] = e.isbot != original.isbot;
+		e.changed_columns[81] = e.exclude != original.exclude;
+		e.changed_columns[82] = e.ATK != original.ATK;
+		e.changed_columns[83] = e.Accuracy != original.Accuracy;
+		e.changed_columns[84] = e.Avoidance != original.Avoidance;
+		e.changed_columns[85] = e.slow_mitigation != original.slow_mitigation;
+		e.changed_columns[86] = e.version != original.version;
+		e.changed_columns[87] = e.maxlevel != original.maxlevel;
+		e.changed_columns[88] = e.scalerate != original.scalerate;
+		e.changed_columns[89] = e.private_corpse != original.private_corpse;
+		e.changed_columns[90] = e.unique_spawn_by_name != original.unique_spawn_by_name;
+		e.changed_columns[91] = e.underwater != original.underwater;
+		e.changed_columns[92] = e.isquest != original.isquest;
+		e.changed_columns[93] = e.emoteid != original.emoteid;
+		e.changed_columns[94] = e.spellscale != original.spellscale;
+		e.changed_columns[95] = e.healscale != original.healscale;
+		e.changed_columns[96] = e.no_target_hotkey != original.no_target_hotkey;
+		e.changed_columns[97] = e.raid_target != original.raid_target;
+		e.changed_columns[98] = e.armtexture != original.armtexture;
+		e.changed_columns[99] = e.bracertexture != original.bracertexture;
+		e.changed_columns[100] = e.handtexture != original.handtexture;
+		e.changed_columns[101] = e.legtexture != original.legtexture;
+		e.changed_columns[102] = e.feettexture != original.feettexture;
+		e.changed_columns[103] = e.light != original.light;
+		e.changed_columns[104] = e.walkspeed != original.walkspeed;
+		e.changed_columns[105] = e.peqid != original.peqid;
+		e.changed_columns[106] = e.unique_ != original.unique_;
+		e.changed_columns[107] = e.fixed != original.fixed;
+		e.changed_columns[108] = e.ignore_despawn != original.ignore_despawn;
+		e.changed_columns[109] = e.show_name != original.show_name;
+		e.changed_columns[110] = e.untargetable != original.untargetable;
+		e.changed_columns[111] = e.charm_ac != original.charm_ac;
+		e.changed_columns[112] = e.charm_min_dmg != original.charm_min_dmg;
+		e.changed_columns[113] = e.charm_max_dmg != original.charm_max_dmg;
+		e.changed_columns[114] = e.charm_attack_delay != original.charm_attack_delay;
+		e.changed_columns[115] = e.charm_accuracy_rating != original.charm_accuracy_rating;
+		e.changed_columns[116] = e.charm_avoidance_rating != original.charm_avoidance_rating;
+		e.changed_columns[117] = e.charm_atk != original.charm_atk;
+		e.changed_columns[118] = e.skip_global_loot != original.skip_global_loot;
+		e.changed_columns[119] = e.rare_spawn != original.rare_spawn;
+		e.changed_columns[120] = e.stuck_behavior != original.stuck_behavior;
+		e.changed_columns[121] = e.model != original.model;
+		e.changed_columns[122] = e.flymode != original.flymode;
+		e.changed_columns[123] = e.always_aggro != original.always_aggro;
+		e.changed_columns[124] = e.exp_mod != original.exp_mod;
+		e.changed_columns[125] = e.heroic_strikethrough != original.heroic_strikethrough;
+		e.changed_columns[126] = e.faction_amount != original.faction_amount;
+		e.changed_columns[127] = e.keeps_sold_items != original.keeps_sold_items;
+		e.changed_columns[128] = e.is_parcel_merchant != original.is_parcel_merchant;
+		e.changed_columns[129] = e.multiquest_enabled != original.multiquest_enabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const NpcTypes &e
@@ -794,135 +937,139 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.lastname) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.level));
-		v.push_back(columns[4] + " = " + std::to_string(e.race));
-		v.push_back(columns[5] + " = " + std::to_string(e.class_));
-		v.push_back(columns[6] + " = " + std::to_string(e.bodytype));
-		v.push_back(columns[7] + " = " + std::to_string(e.hp));
-		v.push_back(columns[8] + " = " + std::to_string(e.mana));
-		v.push_back(columns[9] + " = " + std::to_string(e.gender));
-		v.push_back(columns[10] + " = " + std::to_string(e.texture));
-		v.push_back(columns[11] + " = " + std::to_string(e.helmtexture));
-		v.push_back(columns[12] + " = " + std::to_string(e.herosforgemodel));
-		v.push_back(columns[13] + " = " + std::to_string(e.size));
-		v.push_back(columns[14] + " = " + std::to_string(e.hp_regen_rate));
-		v.push_back(columns[15] + " = " + std::to_string(e.hp_regen_per_second));
-		v.push_back(columns[16] + " = " + std::to_string(e.mana_regen_rate));
-		v.push_back(columns[17] + " = " + std::to_string(e.loottable_id));
-		v.push_back(columns[18] + " = " + std::to_string(e.merchant_id));
-		v.push_back(columns[19] + " = " + std::to_string(e.greed));
-		v.push_back(columns[20] + " = " + std::to_string(e.alt_currency_id));
-		v.push_back(columns[21] + " = " + std::to_string(e.npc_spells_id));
-		v.push_back(columns[22] + " = " + std::to_string(e.npc_spells_effects_id));
-		v.push_back(columns[23] + " = " + std::to_string(e.npc_faction_id));
-		v.push_back(columns[24] + " = " + std::to_string(e.adventure_template_id));
-		v.push_back(columns[25] + " = " + std::to_string(e.trap_template));
-		v.push_back(columns[26] + " = " + std::to_string(e.mindmg));
-		v.push_back(columns[27] + " = " + std::to_string(e.maxdmg));
-		v.push_back(columns[28] + " = " + std::to_string(e.attack_count));
-		v.push_back(columns[29] + " = '" + Strings::Escape(e.npcspecialattks) + "'");
-		v.push_back(columns[30] + " = '" + Strings::Escape(e.special_abilities) + "'");
-		v.push_back(columns[31] + " = " + std::to_string(e.aggroradius));
-		v.push_back(columns[32] + " = " + std::to_string(e.assistradius));
-		v.push_back(columns[33] + " = " + std::to_string(e.face));
-		v.push_back(columns[34] + " = " + std::to_string(e.luclin_hairstyle));
-		v.push_back(columns[35] + " = " + std::to_string(e.luclin_haircolor));
-		v.push_back(columns[36] + " = " + std::to_string(e.luclin_eyecolor));
-		v.push_back(columns[37] + " = " + std::to_string(e.luclin_eyecolor2));
-		v.push_back(columns[38] + " = " + std::to_string(e.luclin_beardcolor));
-		v.push_back(columns[39] + " = " + std::to_string(e.luclin_beard));
-		v.push_back(columns[40] + " = " + std::to_string(e.drakkin_heritage));
-		v.push_back(columns[41] + " = " + std::to_string(e.drakkin_tattoo));
-		v.push_back(columns[42] + " = " + std::to_string(e.drakkin_details));
-		v.push_back(columns[43] + " = " + std::to_string(e.armortint_id));
-		v.push_back(columns[44] + " = " + std::to_string(e.armortint_red));
-		v.push_back(columns[45] + " = " + std::to_string(e.armortint_green));
-		v.push_back(columns[46] + " = " + std::to_string(e.armortint_blue));
-		v.push_back(columns[47] + " = " + std::to_string(e.d_melee_texture1));
-		v.push_back(columns[48] + " = " + std::to_string(e.d_melee_texture2));
-		v.push_back(columns[49] + " = '" + Strings::Escape(e.ammo_idfile) + "'");
-		v.push_back(columns[50] + " = " + std::to_string(e.prim_melee_type));
-		v.push_back(columns[51] + " = " + std::to_string(e.sec_melee_type));
-		v.push_back(columns[52] + " = " + std::to_string(e.ranged_type));
-		v.push_back(columns[53] + " = " + std::to_string(e.runspeed));
-		v.push_back(columns[54] + " = " + std::to_string(e.MR));
-		v.push_back(columns[55] + " = " + std::to_string(e.CR));
-		v.push_back(columns[56] + " = " + std::to_string(e.DR));
-		v.push_back(columns[57] + " = " + std::to_string(e.FR));
-		v.push_back(columns[58] + " = " + std::to_string(e.PR));
-		v.push_back(columns[59] + " = " + std::to_string(e.Corrup));
-		v.push_back(columns[60] + " = " + std::to_string(e.PhR));
-		v.push_back(columns[61] + " = " + std::to_string(e.see_invis));
-		v.push_back(columns[62] + " = " + std::to_string(e.see_invis_undead));
-		v.push_back(columns[63] + " = " + std::to_string(e.qglobal));
-		v.push_back(columns[64] + " = " + std::to_string(e.AC));
-		v.push_back(columns[65] + " = " + std::to_string(e.npc_aggro));
-		v.push_back(columns[66] + " = " + std::to_string(e.spawn_limit));
-		v.push_back(columns[67] + " = " + std::to_string(e.attack_speed));
-		v.push_back(columns[68] + " = " + std::to_string(e.attack_delay));
-		v.push_back(columns[69] + " = " + std::to_string(e.findable));
-		v.push_back(columns[70] + " = " + std::to_string(e.STR));
-		v.push_back(columns[71] + " = " + std::to_string(e.STA));
-		v.push_back(columns[72] + " = " + std::to_string(e.DEX));
-		v.push_back(columns[73] + " = " + std::to_string(e.AGI));
-		v.push_back(columns[74] + " = " + std::to_string(e._INT));
-		v.push_back(columns[75] + " = " + std::to_string(e.WIS));
-		v.push_back(columns[76] + " = " + std::to_string(e.CHA));
-		v.push_back(columns[77] + " = " + std::to_string(e.see_hide));
-		v.push_back(columns[78] + " = " + std::to_string(e.see_improved_hide));
-		v.push_back(columns[79] + " = " + std::to_string(e.trackable));
-		v.push_back(columns[80] + " = " + std::to_string(e.isbot));
-		v.push_back(columns[81] + " = " + std::to_string(e.exclude));
-		v.push_back(columns[82] + " = " + std::to_string(e.ATK));
-		v.push_back(columns[83] + " = " + std::to_string(e.Accuracy));
-		v.push_back(columns[84] + " = " + std::to_string(e.Avoidance));
-		v.push_back(columns[85] + " = " + std::to_string(e.slow_mitigation));
-		v.push_back(columns[86] + " = " + std::to_string(e.version));
-		v.push_back(columns[87] + " = " + std::to_string(e.maxlevel));
-		v.push_back(columns[88] + " = " + std::to_string(e.scalerate));
-		v.push_back(columns[89] + " = " + std::to_string(e.private_corpse));
-		v.push_back(columns[90] + " = " + std::to_string(e.unique_spawn_by_name));
-		v.push_back(columns[91] + " = " + std::to_string(e.underwater));
-		v.push_back(columns[92] + " = " + std::to_string(e.isquest));
-		v.push_back(columns[93] + " = " + std::to_string(e.emoteid));
-		v.push_back(columns[94] + " = " + std::to_string(e.spellscale));
-		v.push_back(columns[95] + " = " + std::to_string(e.healscale));
-		v.push_back(columns[96] + " = " + std::to_string(e.no_target_hotkey));
-		v.push_back(columns[97] + " = " + std::to_string(e.raid_target));
-		v.push_back(columns[98] + " = " + std::to_string(e.armtexture));
-		v.push_back(columns[99] + " = " + std::to_string(e.bracertexture));
-		v.push_back(columns[100] + " = " + std::to_string(e.handtexture));
-		v.push_back(columns[101] + " = " + std::to_string(e.legtexture));
-		v.push_back(columns[102] + " = " + std::to_string(e.feettexture));
-		v.push_back(columns[103] + " = " + std::to_string(e.light));
-		v.push_back(columns[104] + " = " + std::to_string(e.walkspeed));
-		v.push_back(columns[105] + " = " + std::to_string(e.peqid));
-		v.push_back(columns[106] + " = " + std::to_string(e.unique_));
-		v.push_back(columns[107] + " = " + std::to_string(e.fixed));
-		v.push_back(columns[108] + " = " + std::to_string(e.ignore_despawn));
-		v.push_back(columns[109] + " = " + std::to_string(e.show_name));
-		v.push_back(columns[110] + " = " + std::to_string(e.untargetable));
-		v.push_back(columns[111] + " = " + std::to_string(e.charm_ac));
-		v.push_back(columns[112] + " = " + std::to_string(e.charm_min_dmg));
-		v.push_back(columns[113] + " = " + std::to_string(e.charm_max_dmg));
-		v.push_back(columns[114] + " = " + std::to_string(e.charm_attack_delay));
-		v.push_back(columns[115] + " = " + std::to_string(e.charm_accuracy_rating));
-		v.push_back(columns[116] + " = " + std::to_string(e.charm_avoidance_rating));
-		v.push_back(columns[117] + " = " + std::to_string(e.charm_atk));
-		v.push_back(columns[118] + " = " + std::to_string(e.skip_global_loot));
-		v.push_back(columns[119] + " = " + std::to_string(e.rare_spawn));
-		v.push_back(columns[120] + " = " + std::to_string(e.stuck_behavior));
-		v.push_back(columns[121] + " = " + std::to_string(e.model));
-		v.push_back(columns[122] + " = " + std::to_string(e.flymode));
-		v.push_back(columns[123] + " = " + std::to_string(e.always_aggro));
-		v.push_back(columns[124] + " = " + std::to_string(e.exp_mod));
-		v.push_back(columns[125] + " = " + std::to_string(e.heroic_strikethrough));
-		v.push_back(columns[126] + " = " + std::to_string(e.faction_amount));
-		v.push_back(columns[127] + " = " + std::to_string(e.keeps_sold_items));
-		v.push_back(columns[128] + " = " + std::to_string(e.is_parcel_merchant));
-		v.push_back(columns[129] + " = " + std::to_string(e.multiquest_enabled));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.lastname) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.race)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.class_)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.bodytype)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.gender)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.texture)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.helmtexture)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.herosforgemodel)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.hp_regen_rate)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.hp_regen_per_second)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.mana_regen_rate)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.loottable_id)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.merchant_id)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.greed)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.alt_currency_id)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.npc_spells_id)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.npc_spells_effects_id)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.npc_faction_id)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.adventure_template_id)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.trap_template)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.mindmg)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.maxdmg)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.attack_count)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = '" + Strings::Escape(e.npcspecialattks) + "'"); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = '" + Strings::Escape(e.special_abilities) + "'"); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.aggroradius)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.assistradius)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.face)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.luclin_hairstyle)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.luclin_haircolor)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.luclin_eyecolor)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.luclin_eyecolor2)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.luclin_beardcolor)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.luclin_beard)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.drakkin_heritage)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.drakkin_tattoo)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.drakkin_details)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.armortint_id)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.armortint_red)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.armortint_green)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.armortint_blue)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.d_melee_texture1)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.d_melee_texture2)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = '" + Strings::Escape(e.ammo_idfile) + "'"); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.prim_melee_type)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.sec_melee_type)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.ranged_type)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.runspeed)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.MR)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.CR)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.DR)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.FR)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = " + std::to_string(e.PR)); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.Corrup)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.PhR)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.see_invis)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.see_invis_undead)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.qglobal)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.AC)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.npc_aggro)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.spawn_limit)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.attack_speed)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.attack_delay)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.findable)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.STR)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = " + std::to_string(e.STA)); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = " + std::to_string(e.DEX)); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = " + std::to_string(e.AGI)); }
+		if (e.changed_columns[74]) { v.push_back(columns[74] + " = " + std::to_string(e._INT)); }
+		if (e.changed_columns[75]) { v.push_back(columns[75] + " = " + std::to_string(e.WIS)); }
+		if (e.changed_columns[76]) { v.push_back(columns[76] + " = " + std::to_string(e.CHA)); }
+		if (e.changed_columns[77]) { v.push_back(columns[77] + " = " + std::to_string(e.see_hide)); }
+		if (e.changed_columns[78]) { v.push_back(columns[78] + " = " + std::to_string(e.see_improved_hide)); }
+		if (e.changed_columns[79]) { v.push_back(columns[79] + " = " + std::to_string(e.trackable)); }
+		if (e.changed_columns[80]) { v.push_back(columns[80] + " = " + std::to_string(e.isbot)); }
+		if (e.changed_columns[81]) { v.push_back(columns[81] + " = " + std::to_string(e.exclude)); }
+		if (e.changed_columns[82]) { v.push_back(columns[82] + " = " + std::to_string(e.ATK)); }
+		if (e.changed_columns[83]) { v.push_back(columns[83] + " = " + std::to_string(e.Accuracy)); }
+		if (e.changed_columns[84]) { v.push_back(columns[84] + " = " + std::to_string(e.Avoidance)); }
+		if (e.changed_columns[85]) { v.push_back(columns[85] + " = " + std::to_string(e.slow_mitigation)); }
+		if (e.changed_columns[86]) { v.push_back(columns[86] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[87]) { v.push_back(columns[87] + " = " + std::to_string(e.maxlevel)); }
+		if (e.changed_columns[88]) { v.push_back(columns[88] + " = " + std::to_string(e.scalerate)); }
+		if (e.changed_columns[89]) { v.push_back(columns[89] + " = " + std::to_string(e.private_corpse)); }
+		if (e.changed_columns[90]) { v.push_back(columns[90] + " = " + std::to_string(e.unique_spawn_by_name)); }
+		if (e.changed_columns[91]) { v.push_back(columns[91] + " = " + std::to_string(e.underwater)); }
+		if (e.changed_columns[92]) { v.push_back(columns[92] + " = " + std::to_string(e.isquest)); }
+		if (e.changed_columns[93]) { v.push_back(columns[93] + " = " + std::to_string(e.emoteid)); }
+		if (e.changed_columns[94]) { v.push_back(columns[94] + " = " + std::to_string(e.spellscale)); }
+		if (e.changed_columns[95]) { v.push_back(columns[95] + " = " + std::to_string(e.healscale)); }
+		if (e.changed_columns[96]) { v.push_back(columns[96] + " = " + std::to_string(e.no_target_hotkey)); }
+		if (e.changed_columns[97]) { v.push_back(columns[97] + " = " + std::to_string(e.raid_target)); }
+		if (e.changed_columns[98]) { v.push_back(columns[98] + " = " + std::to_string(e.armtexture)); }
+		if (e.changed_columns[99]) { v.push_back(columns[99] + " = " + std::to_string(e.bracertexture)); }
+		if (e.changed_columns[100]) { v.push_back(columns[100] + " = " + std::to_string(e.handtexture)); }
+		if (e.changed_columns[101]) { v.push_back(columns[101] + " = " + std::to_string(e.legtexture)); }
+		if (e.changed_columns[102]) { v.push_back(columns[102] + " = " + std::to_string(e.feettexture)); }
+		if (e.changed_columns[103]) { v.push_back(columns[103] + " = " + std::to_string(e.light)); }
+		if (e.changed_columns[104]) { v.push_back(columns[104] + " = " + std::to_string(e.walkspeed)); }
+		if (e.changed_columns[105]) { v.push_back(columns[105] + " = " + std::to_string(e.peqid)); }
+		if (e.changed_columns[106]) { v.push_back(columns[106] + " = " + std::to_string(e.unique_)); }
+		if (e.changed_columns[107]) { v.push_back(columns[107] + " = " + std::to_string(e.fixed)); }
+		if (e.changed_columns[108]) { v.push_back(columns[108] + " = " + std::to_string(e.ignore_despawn)); }
+		if (e.changed_columns[109]) { v.push_back(columns[109] + " = " + std::to_string(e.show_name)); }
+		if (e.changed_columns[110]) { v.push_back(columns[110] + " = " + std::to_string(e.untargetable)); }
+		if (e.changed_columns[111]) { v.push_back(columns[111] + " = " + std::to_string(e.charm_ac)); }
+		if (e.changed_columns[112]) { v.push_back(columns[112] + " = " + std::to_string(e.charm_min_dmg)); }
+		if (e.changed_columns[113]) { v.push_back(columns[113] + " = " + std::to_string(e.charm_max_dmg)); }
+		if (e.changed_columns[114]) { v.push_back(columns[114] + " = " + std::to_string(e.charm_attack_delay)); }
+		if (e.changed_columns[115]) { v.push_back(columns[115] + " = " + std::to_string(e.charm_accuracy_rating)); }
+		if (e.changed_columns[116]) { v.push_back(columns[116] + " = " + std::to_string(e.charm_avoidance_rating)); }
+		if (e.changed_columns[117]) { v.push_back(columns[117] + " = " + std::to_string(e.charm_atk)); }
+		if (e.changed_columns[118]) { v.push_back(columns[118] + " = " + std::to_string(e.skip_global_loot)); }
+		if (e.changed_columns[119]) { v.push_back(columns[119] + " = " + std::to_string(e.rare_spawn)); }
+		if (e.changed_columns[120]) { v.push_back(columns[120] + " = " + std::to_string(e.stuck_behavior)); }
+		if (e.changed_columns[121]) { v.push_back(columns[121] + " = " + std::to_string(e.model)); }
+		if (e.changed_columns[122]) { v.push_back(columns[122] + " = " + std::to_string(e.flymode)); }
+		if (e.changed_columns[123]) { v.push_back(columns[123] + " = " + std::to_string(e.always_aggro)); }
+		if (e.changed_columns[124]) { v.push_back(columns[124] + " = " + std::to_string(e.exp_mod)); }
+		if (e.changed_columns[125]) { v.push_back(columns[125] + " = " + std::to_string(e.heroic_strikethrough)); }
+		if (e.changed_columns[126]) { v.push_back(columns[126] + " = " + std::to_string(e.faction_amount)); }
+		if (e.changed_columns[127]) { v.push_back(columns[127] + " = " + std::to_string(e.keeps_sold_items)); }
+		if (e.changed_columns[128]) { v.push_back(columns[128] + " = " + std::to_string(e.is_parcel_merchant)); }
+		if (e.changed_columns[129]) { v.push_back(columns[129] + " = " + std::to_string(e.multiquest_enabled)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -1557,6 +1704,185 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static NpcTypes FromStmtRow(const mysql::StmtRow &row)
+	{
+		NpcTypes e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.name                   = row.GetStr(1).value_or("");
+		e.lastname               = row.GetStr(2).value_or("");
+		e.level                  = row.Get<uint8_t>(3).value_or(0);
+		e.race                   = row.Get<uint16_t>(4).value_or(0);
+		e.class_                 = row.Get<uint8_t>(5).value_or(0);
+		e.bodytype               = row.Get<int32_t>(6).value_or(1);
+		e.hp                     = row.Get<int64_t>(7).value_or(0);
+		e.mana                   = row.Get<int64_t>(8).value_or(0);
+		e.gender                 = row.Get<uint8_t>(9).value_or(0);
+		e.texture                = row.Get<uint8_t>(10).value_or(0);
+		e.helmtexture            = row.Get<uint8_t>(11).value_or(0);
+		e.herosforgemodel        = row.Get<int32_t>(12).value_or(0);
+		e.size                   = row.Get<float>(13).value_or(0);
+		e.hp_regen_rate          = row.Get<int64_t>(14).value_or(0);
+		e.hp_regen_per_second    = row.Get<int64_t>(15).value_or(0);
+		e.mana_regen_rate        = row.Get<int64_t>(16).value_or(0);
+		e.loottable_id           = row.Get<uint32_t>(17).value_or(0);
+		e.merchant_id            = row.Get<uint32_t>(18).value_or(0);
+		e.greed                  = row.Get<uint8_t>(19).value_or(0);
+		e.alt_currency_id        = row.Get<uint32_t>(20).value_or(0);
+		e.npc_spells_id          = row.Get<uint32_t>(21).value_or(0);
+		e.npc_spells_effects_id  = row.Get<uint32_t>(22).value_or(0);
+		e.npc_faction_id         = row.Get<int32_t>(23).value_or(0);
+		e.adventure_template_id  = row.Get<uint32_t>(24).value_or(0);
+		e.trap_template          = row.Get<uint32_t>(25).value_or(0);
+		e.mindmg                 = row.Get<uint32_t>(26).value_or(0);
+		e.maxdmg                 = row.Get<uint32_t>(27).value_or(0);
+		e.attack_count           = row.Get<int16_t>(28).value_or(-1);
+		e.npcspecialattks        = row.GetStr(29).value_or("");
+		e.special_abilities      = row.GetStr(30).value_or("");
+		e.aggroradius            = row.Get<uint32_t>(31).value_or(0);
+		e.assistradius           = row.Get<uint32_t>(32).value_or(0);
+		e.face                   = row.Get<uint32_t>(33).value_or(1);
+		e.luclin_hairstyle       = row.Get<uint32_t>(34).value_or(1);
+		e.luclin_haircolor       = row.Get<uint32_t>(35).value_or(1);
+		e.luclin_eyecolor        = row.Get<uint32_t>(36).value_or(1);
+		e.luclin_eyecolor2       = row.Get<uint32_t>(37).value_or(1);
+		e.luclin_beardcolor      = row.Get<uint32_t>(38).value_or(1);
+		e.luclin_beard           = row.Get<uint32_t>(39).value_or(0);
+		e.drakkin_heritage       = row.Get<int32_t>(40).value_or(0);
+		e.drakkin_tattoo         = row.Get<int32_t>(41).value_or(0);
+		e.drakkin_details        = row.Get<int32_t>(42).value_or(0);
+		e.armortint_id           = row.Get<uint32_t>(43).value_or(0);
+		e.armortint_red          = row.Get<uint8_t>(44).value_or(0);
+		e.armortint_green        = row.Get<uint8_t>(45).value_or(0);
+		e.armortint_blue         = row.Get<uint8_t>(46).value_or(0);
+		e.d_melee_texture1       = row.Get<uint32_t>(47).value_or(0);
+		e.d_melee_texture2       = row.Get<uint32_t>(48).value_or(0);
+		e.ammo_idfile            = row.GetStr(49).value_or("IT10");
+		e.prim_melee_type        = row.Get<uint8_t>(50).value_or(28);
+		e.sec_melee_type         = row.Get<uint8_t>(51).value_or(28);
+		e.ranged_type            = row.Get<uint8_t>(52).value_or(7);
+		e.runspeed               = row.Get<float>(53).value_or(0);
+		e.MR                     = row.Get<int16_t>(54).value_or(0);
+		e.CR                     = row.Get<int16_t>(55).value_or(0);
+		e.DR                     = row.Get<int16_t>(56).value_or(0);
+		e.FR                     = row.Get<int16_t>(57).value_or(0);
+		e.PR                     = row.Get<int16_t>(58).value_or(0);
+		e.Corrup                 = row.Get<int16_t>(59).value_or(0);
+		e.PhR                    = row.Get<uint16_t>(60).value_or(0);
+		e.see_invis              = row.Get<int16_t>(61).value_or(0);
+		e.see_invis_undead       = row.Get<int16_t>(62).value_or(0);
+		e.qglobal                = row.Get<uint32_t>(63).value_or(0);
+		e.AC                     = row.Get<int16_t>(64).value_or(0);
+		e.npc_aggro              = row.Get<int8_t>(65).value_or(0);
+		e.spawn_limit            = row.Get<int8_t>(66).value_or(0);
+		e.attack_speed           = row.Get<float>(67).value_or(0);
+		e.attack_delay           = row.Get<uint8_t>(68).value_or(30);
+		e.findable               = row.Get<int8_t>(69).value_or(0);
+		e.STR                    = row.Get<uint32_t>(70).value_or(75);
+		e.STA                    = row.Get<uint32_t>(71).value_or(75);
+		e.DEX                    = row.Get<uint32_t>(72).value_or(75);
+		e.AGI                    = row.Get<uint32_t>(73).value_or(75);
+		e._INT                   = row.Get<uint32_t>(74).value_or(80);
+		e.WIS                    = row.Get<uint32_t>(75).value_or(75);
+		e.CHA                    = row.Get<uint32_t>(76).value_or(75);
+		e.see_hide               = row.Get<int8_t>(77).value_or(0);
+		e.see_improved_hide      = row.Get<int8_t>(78).value_or(0);
+		e.trackable              = row.Get<int8_t>(79).value_or(1);
+		e.isbot                  = row.Get<int8_t>(80).value_or(0);
+		e.exclude                = row.Get<int8_t>(81).value_or(1);
+		e.ATK                    = row.Get<int32_t>(82).value_or(0);
+		e.Accuracy               = row.Get<int32_t>(83).value_or(0);
+		e.Avoidance              = row.Get<uint32_t>(84).value_or(0);
+		e.slow_mitigation        = row.Get<int16_t>(85).value_or(0);
+		e.version                = row.Get<uint16_t>(86).value_or(0);
+		e.maxlevel               = row.Get<int8_t>(87).value_or(0);
+		e.scalerate              = row.Get<int32_t>(88).value_or(100);
+		e.private_corpse         = row.Get<uint8_t>(89).value_or(0);
+		e.unique_spawn_by_name   = row.Get<uint8_t>(90).value_or(0);
+		e.underwater             = row.Get<uint8_t>(91).value_or(0);
+		e.isquest                = row.Get<int8_t>(92).value_or(0);
+		e.emoteid                = row.Get<uint32_t>(93).value_or(0);
+		e.spellscale             = row.Get<float>(94).value_or(100);
+		e.healscale              = row.Get<float>(95).value_or(100);
+		e.no_target_hotkey       = row.Get<uint8_t>(96).value_or(0);
+		e.raid_target            = row.Get<uint8_t>(97).value_or(0);
+		e.armtexture             = row.Get<int8_t>(98).value_or(0);
+		e.bracertexture          = row.Get<int8_t>(99).value_or(0);
+		e.handtexture            = row.Get<int8_t>(100).value_or(0);
+		e.legtexture             = row.Get<int8_t>(101).value_or(0);
+		e.feettexture            = row.Get<int8_t>(102).value_or(0);
+		e.light                  = row.Get<int8_t>(103).value_or(0);
+		e.walkspeed              = row.Get<float>(104).value_or(0);
+		e.peqid                  = row.Get<int32_t>(105).value_or(0);
+		e.unique_                = row.Get<int8_t>(106).value_or(0);
+		e.fixed                  = row.Get<int8_t>(107).value_or(0);
+		e.ignore_despawn         = row.Get<int8_t>(108).value_or(0);
+		e.show_name              = row.Get<int8_t>(109).value_or(1);
+		e.untargetable           = row.Get<int8_t>(110).value_or(0);
+		e.charm_ac               = row.Get<int16_t>(111).value_or(0);
+		e.charm_min_dmg          = row.Get<int32_t>(112).value_or(0);
+		e.charm_max_dmg          = row.Get<int32_t>(113).value_or(0);
+		e.charm_attack_delay     = row.Get<int8_t>(114).value_or(0);
+		e.charm_accuracy_rating  = row.Get<int32_t>(115).value_or(0);
+		e.charm_avoidance_rating = row.Get<int32_t>(116).value_or(0);
+		e.charm_atk              = row.Get<int32_t>(117).value_or(0);
+		e.skip_global_loot       = row.Get<int8_t>(118).value_or(0);
+		e.rare_spawn             = row.Get<int8_t>(119).value_or(0);
+		e.stuck_behavior         = row.Get<int8_t>(120).value_or(0);
+		e.model                  = row.Get<int16_t>(121).value_or(0);
+		e.flymode                = row.Get<int8_t>(122).value_or(-1);
+		e.always_aggro           = row.Get<int8_t>(123).value_or(0);
+		e.exp_mod                = row.Get<int32_t>(124).value_or(100);
+		e.heroic_strikethrough   = row.Get<int32_t>(125).value_or(0);
+		e.faction_amount         = row.Get<int32_t>(126).value_or(0);
+		e.keeps_sold_items       = row.Get<uint8_t>(127).value_or(1);
+		e.is_parcel_merchant     = row.Get<uint8_t>(128).value_or(0);
+		e.multiquest_enabled     = row.Get<uint8_t>(129).value_or(0);
+
+		return e;
+	}
+
+	static NpcTypes FindOnePrepared(
+		Database& db,
+		int npc_types_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { npc_types_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<NpcTypes> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<NpcTypes> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -1773,7 +2099,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<130> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -1910,13 +2244,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseNpcTypesTintRepository {
@@ -48,6 +50,9 @@ public:
 		uint8_t     red9x;
 		uint8_t     grn9x;
 		uint8_t     blu9x;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<29> changed_columns = std::bitset<29>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -280,6 +285,43 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		NpcTypesTint &e,
+		const NpcTypesTint &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.tint_set_name != original.tint_set_name;
+		e.changed_columns[2] = e.red1h != original.red1h;
+		e.changed_columns[3] = e.grn1h != original.grn1h;
+		e.changed_columns[4] = e.blu1h != original.blu1h;
+		e.changed_columns[5] = e.red2c != original.red2c;
+		e.changed_columns[6] = e.grn2c != original.grn2c;
+		e.changed_columns[7] = e.blu2c != original.blu2c;
+		e.changed_columns[8] = e.red3a != original.red3a;
+		e.changed_columns[9] = e.grn3a != original.grn3a;
+		e.changed_columns[10] = e.blu3a != original.blu3a;
+		e.changed_columns[11] = e.red4b != original.red4b;
+		e.changed_columns[12] = e.grn4b != original.grn4b;
+		e.changed_columns[13] = e.blu4b != original.blu4b;
+		e.changed_columns[14] = e.red5g != original.red5g;
+		e.changed_columns[15] = e.grn5g != original.grn5g;
+		e.changed_columns[16] = e.blu5g != original.blu5g;
+		e.changed_columns[17] = e.red6l != original.red6l;
+		e.changed_columns[18] = e.grn6l != original.grn6l;
+		e.changed_columns[19] = e.blu6l != original.blu6l;
+		e.changed_columns[20] = e.red7f != original.red7f;
+		e.changed_columns[21] = e.grn7f != original.grn7f;
+		e.changed_columns[22] = e.blu7f != original.blu7f;
+		e.changed_columns[23] = e.red8x != original.red8x;
+		e.changed_columns[24] = e.grn8x != original.grn8x;
+		e.changed_columns[25] = e.blu8x != original.blu8x;
+		e.changed_columns[26] = e.red9x != original.red9x;
+		e.changed_columns[27] = e.grn9x != original.grn9x;
+		e.changed_columns[28] = e.blu9x != original.blu9x;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const NpcTypesTint &e
@@ -289,35 +331,39 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.tint_set_name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.red1h));
-		v.push_back(columns[3] + " = " + std::to_string(e.grn1h));
-		v.push_back(columns[4] + " = " + std::to_string(e.blu1h));
-		v.push_back(columns[5] + " = " + std::to_string(e.red2c));
-		v.push_back(columns[6] + " = " + std::to_string(e.grn2c));
-		v.push_back(columns[7] + " = " + std::to_string(e.blu2c));
-		v.push_back(columns[8] + " = " + std::to_string(e.red3a));
-		v.push_back(columns[9] + " = " + std::to_string(e.grn3a));
-		v.push_back(columns[10] + " = " + std::to_string(e.blu3a));
-		v.push_back(columns[11] + " = " + std::to_string(e.red4b));
-		v.push_back(columns[12] + " = " + std::to_string(e.grn4b));
-		v.push_back(columns[13] + " = " + std::to_string(e.blu4b));
-		v.push_back(columns[14] + " = " + std::to_string(e.red5g));
-		v.push_back(columns[15] + " = " + std::to_string(e.grn5g));
-		v.push_back(columns[16] + " = " + std::to_string(e.blu5g));
-		v.push_back(columns[17] + " = " + std::to_string(e.red6l));
-		v.push_back(columns[18] + " = " + std::to_string(e.grn6l));
-		v.push_back(columns[19] + " = " + std::to_string(e.blu6l));
-		v.push_back(columns[20] + " = " + std::to_string(e.red7f));
-		v.push_back(columns[21] + " = " + std::to_string(e.grn7f));
-		v.push_back(columns[22] + " = " + std::to_string(e.blu7f));
-		v.push_back(columns[23] + " = " + std::to_string(e.red8x));
-		v.push_back(columns[24] + " = " + std::to_string(e.grn8x));
-		v.push_back(columns[25] + " = " + std::to_string(e.blu8x));
-		v.push_back(columns[26] + " = " + std::to_string(e.red9x));
-		v.push_back(columns[27] + " = " + std::to_string(e.grn9x));
-		v.push_back(columns[28] + " = " + std::to_string(e.blu9x));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.tint_set_name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.red1h)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.grn1h)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.blu1h)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.red2c)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.grn2c)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.blu2c)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.red3a)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.grn3a)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.blu3a)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.red4b)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.grn4b)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.blu4b)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.red5g)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.grn5g)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.blu5g)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.red6l)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.grn6l)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.blu6l)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.red7f)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.grn7f)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.blu7f)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.red8x)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.grn8x)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.blu8x)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.red9x)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.grn9x)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.blu9x)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -548,6 +594,84 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static NpcTypesTint FromStmtRow(const mysql::StmtRow &row)
+	{
+		NpcTypesTint e{};
+
+		e.id            = row.Get<uint32_t>(0).value_or(0);
+		e.tint_set_name = row.GetStr(1).value_or("");
+		e.red1h         = row.Get<uint8_t>(2).value_or(0);
+		e.grn1h         = row.Get<uint8_t>(3).value_or(0);
+		e.blu1h         = row.Get<uint8_t>(4).value_or(0);
+		e.red2c         = row.Get<uint8_t>(5).value_or(0);
+		e.grn2c         = row.Get<uint8_t>(6).value_or(0);
+		e.blu2c         = row.Get<uint8_t>(7).value_or(0);
+		e.red3a         = row.Get<uint8_t>(8).value_or(0);
+		e.grn3a         = row.Get<uint8_t>(9).value_or(0);
+		e.blu3a         = row.Get<uint8_t>(10).value_or(0);
+		e.red4b         = row.Get<uint8_t>(11).value_or(0);
+		e.grn4b         = row.Get<uint8_t>(12).value_or(0);
+		e.blu4b         = row.Get<uint8_t>(13).value_or(0);
+		e.red5g         = row.Get<uint8_t>(14).value_or(0);
+		e.grn5g         = row.Get<uint8_t>(15).value_or(0);
+		e.blu5g         = row.Get<uint8_t>(16).value_or(0);
+		e.red6l         = row.Get<uint8_t>(17).value_or(0);
+		e.grn6l         = row.Get<uint8_t>(18).value_or(0);
+		e.blu6l         = row.Get<uint8_t>(19).value_or(0);
+		e.red7f         = row.Get<uint8_t>(20).value_or(0);
+		e.grn7f         = row.Get<uint8_t>(21).value_or(0);
+		e.blu7f         = row.Get<uint8_t>(22).value_or(0);
+		e.red8x         = row.Get<uint8_t>(23).value_or(0);
+		e.grn8x         = row.Get<uint8_t>(24).value_or(0);
+		e.blu8x         = row.Get<uint8_t>(25).value_or(0);
+		e.red9x         = row.Get<uint8_t>(26).value_or(0);
+		e.grn9x         = row.Get<uint8_t>(27).value_or(0);
+		e.blu9x         = row.Get<uint8_t>(28).value_or(0);
+
+		return e;
+	}
+
+	static NpcTypesTint FindOnePrepared(
+		Database& db,
+		int npc_types_tint_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { npc_types_tint_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<NpcTypesTint> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<NpcTypesTint> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -663,7 +787,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<29> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -699,13 +831,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseObjectContentsRepository {
@@ -31,6 +33,9 @@ public:
 		uint32_t augslot4;
 		uint32_t augslot5;
 		int32_t  augslot6;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<12> changed_columns = std::bitset<12>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -195,6 +200,26 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		ObjectContents &e,
+		const ObjectContents &original
+	)
+	{
+		e.changed_columns[0] = e.zoneid != original.zoneid;
+		e.changed_columns[1] = e.parentid != original.parentid;
+		e.changed_columns[2] = e.bagidx != original.bagidx;
+		e.changed_columns[3] = e.itemid != original.itemid;
+		e.changed_columns[4] = e.charges != original.charges;
+		e.changed_columns[5] = e.droptime != original.droptime;
+		e.changed_columns[6] = e.augslot1 != original.augslot1;
+		e.changed_columns[7] = e.augslot2 != original.augslot2;
+		e.changed_columns[8] = e.augslot3 != original.augslot3;
+		e.changed_columns[9] = e.augslot4 != original.augslot4;
+		e.changed_columns[10] = e.augslot5 != original.augslot5;
+		e.changed_columns[11] = e.augslot6 != original.augslot6;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const ObjectContents &e
@@ -204,18 +229,22 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.zoneid));
-		v.push_back(columns[1] + " = " + std::to_string(e.parentid));
-		v.push_back(columns[2] + " = " + std::to_string(e.bagidx));
-		v.push_back(columns[3] + " = " + std::to_string(e.itemid));
-		v.push_back(columns[4] + " = " + std::to_string(e.charges));
-		v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.droptime > 0 ? std::to_string(e.droptime) : "null") + ")");
-		v.push_back(columns[6] + " = " + std::to_string(e.augslot1));
-		v.push_back(columns[7] + " = " + std::to_string(e.augslot2));
-		v.push_back(columns[8] + " = " + std::to_string(e.augslot3));
-		v.push_back(columns[9] + " = " + std::to_string(e.augslot4));
-		v.push_back(columns[10] + " = " + std::to_string(e.augslot5));
-		v.push_back(columns[11] + " = " + std::to_string(e.augslot6));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.zoneid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.parentid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.bagidx)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.itemid)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = FROM_UNIXTIME(" + (e.droptime > 0 ? std::to_string(e.droptime) : "null") + ")"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.augslot1)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augslot2)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augslot3)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augslot4)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.augslot5)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.augslot6)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -378,6 +407,67 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static ObjectContents FromStmtRow(const mysql::StmtRow &row)
+	{
+		ObjectContents e{};
+
+		e.zoneid   = row.Get<uint32_t>(0).value_or(0);
+		e.parentid = row.Get<uint32_t>(1).value_or(0);
+		e.bagidx   = row.Get<uint32_t>(2).value_or(0);
+		e.itemid   = row.Get<uint32_t>(3).value_or(0);
+		e.charges  = row.Get<int16_t>(4).value_or(0);
+		e.droptime = row.Get<int64_t>(5).value_or(-1);
+		e.augslot1 = row.Get<uint32_t>(6).value_or(0);
+		e.augslot2 = row.Get<uint32_t>(7).value_or(0);
+		e.augslot3 = row.Get<uint32_t>(8).value_or(0);
+		e.augslot4 = row.Get<uint32_t>(9).value_or(0);
+		e.augslot5 = row.Get<uint32_t>(10).value_or(0);
+		e.augslot6 = row.Get<int32_t>(11).value_or(0);
+
+		return e;
+	}
+
+	static ObjectContents FindOnePrepared(
+		Database& db,
+		int object_contents_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { object_contents_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<ObjectContents> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<ObjectContents> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -476,7 +566,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<12> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.zoneid));
@@ -495,13 +593,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseObjectRepository {
@@ -49,6 +51,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<30> changed_columns = std::bitset<30>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -285,6 +290,44 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Object &e,
+		const Object &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zoneid != original.zoneid;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.xpos != original.xpos;
+		e.changed_columns[4] = e.ypos != original.ypos;
+		e.changed_columns[5] = e.zpos != original.zpos;
+		e.changed_columns[6] = e.heading != original.heading;
+		e.changed_columns[7] = e.itemid != original.itemid;
+		e.changed_columns[8] = e.charges != original.charges;
+		e.changed_columns[9] = e.objectname != original.objectname;
+		e.changed_columns[10] = e.type != original.type;
+		e.changed_columns[11] = e.icon != original.icon;
+		e.changed_columns[12] = e.size_percentage != original.size_percentage;
+		e.changed_columns[13] = e.unknown24 != original.unknown24;
+		e.changed_columns[14] = e.unknown60 != original.unknown60;
+		e.changed_columns[15] = e.unknown64 != original.unknown64;
+		e.changed_columns[16] = e.unknown68 != original.unknown68;
+		e.changed_columns[17] = e.unknown72 != original.unknown72;
+		e.changed_columns[18] = e.unknown76 != original.unknown76;
+		e.changed_columns[19] = e.unknown84 != original.unknown84;
+		e.changed_columns[20] = e.size != original.size;
+		e.changed_columns[21] = e.solid_type != original.solid_type;
+		e.changed_columns[22] = e.incline != original.incline;
+		e.changed_columns[23] = e.tilt_x != original.tilt_x;
+		e.changed_columns[24] = e.tilt_y != original.tilt_y;
+		e.changed_columns[25] = e.display_name != original.display_name;
+		e.changed_columns[26] = e.min_expansion != original.min_expansion;
+		e.changed_columns[27] = e.max_expansion != original.max_expansion;
+		e.changed_columns[28] = e.content_flags != original.content_flags;
+		e.changed_columns[29] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Object &e
@@ -294,35 +337,39 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zoneid));
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = " + std::to_string(e.xpos));
-		v.push_back(columns[4] + " = " + std::to_string(e.ypos));
-		v.push_back(columns[5] + " = " + std::to_string(e.zpos));
-		v.push_back(columns[6] + " = " + std::to_string(e.heading));
-		v.push_back(columns[7] + " = " + std::to_string(e.itemid));
-		v.push_back(columns[8] + " = " + std::to_string(e.charges));
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.objectname) + "'");
-		v.push_back(columns[10] + " = " + std::to_string(e.type));
-		v.push_back(columns[11] + " = " + std::to_string(e.icon));
-		v.push_back(columns[12] + " = " + std::to_string(e.size_percentage));
-		v.push_back(columns[13] + " = " + std::to_string(e.unknown24));
-		v.push_back(columns[14] + " = " + std::to_string(e.unknown60));
-		v.push_back(columns[15] + " = " + std::to_string(e.unknown64));
-		v.push_back(columns[16] + " = " + std::to_string(e.unknown68));
-		v.push_back(columns[17] + " = " + std::to_string(e.unknown72));
-		v.push_back(columns[18] + " = " + std::to_string(e.unknown76));
-		v.push_back(columns[19] + " = " + std::to_string(e.unknown84));
-		v.push_back(columns[20] + " = " + std::to_string(e.size));
-		v.push_back(columns[21] + " = " + std::to_string(e.solid_type));
-		v.push_back(columns[22] + " = " + std::to_string(e.incline));
-		v.push_back(columns[23] + " = " + std::to_string(e.tilt_x));
-		v.push_back(columns[24] + " = " + std::to_string(e.tilt_y));
-		v.push_back(columns[25] + " = '" + Strings::Escape(e.display_name) + "'");
-		v.push_back(columns[26] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[27] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[28] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[29] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zoneid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.xpos)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.ypos)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.zpos)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.itemid)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.objectname) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.icon)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.size_percentage)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.unknown24)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.unknown60)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.unknown64)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.unknown68)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.unknown72)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.unknown76)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.unknown84)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.size)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.solid_type)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.incline)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.tilt_x)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.tilt_y)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = '" + Strings::Escape(e.display_name) + "'"); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -557,6 +604,85 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Object FromStmtRow(const mysql::StmtRow &row)
+	{
+		Object e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.zoneid                 = row.Get<uint32_t>(1).value_or(0);
+		e.version                = row.Get<int16_t>(2).value_or(0);
+		e.xpos                   = row.Get<float>(3).value_or(0);
+		e.ypos                   = row.Get<float>(4).value_or(0);
+		e.zpos                   = row.Get<float>(5).value_or(0);
+		e.heading                = row.Get<float>(6).value_or(0);
+		e.itemid                 = row.Get<int32_t>(7).value_or(0);
+		e.charges                = row.Get<uint16_t>(8).value_or(0);
+		e.objectname             = row.GetStr(9).value_or("");
+		e.type                   = row.Get<int32_t>(10).value_or(0);
+		e.icon                   = row.Get<int32_t>(11).value_or(0);
+		e.size_percentage        = row.Get<float>(12).value_or(0);
+		e.unknown24              = row.Get<int32_t>(13).value_or(0);
+		e.unknown60              = row.Get<int32_t>(14).value_or(0);
+		e.unknown64              = row.Get<int32_t>(15).value_or(0);
+		e.unknown68              = row.Get<int32_t>(16).value_or(0);
+		e.unknown72              = row.Get<int32_t>(17).value_or(0);
+		e.unknown76              = row.Get<int32_t>(18).value_or(0);
+		e.unknown84              = row.Get<int32_t>(19).value_or(0);
+		e.size                   = row.Get<float>(20).value_or(100);
+		e.solid_type             = row.Get<int32_t>(21).value_or(0);
+		e.incline                = row.Get<int32_t>(22).value_or(0);
+		e.tilt_x                 = row.Get<float>(23).value_or(0);
+		e.tilt_y                 = row.Get<float>(24).value_or(0);
+		e.display_name           = row.GetStr(25).value_or("");
+		e.min_expansion          = row.Get<int8_t>(26).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(27).value_or(-1);
+		e.content_flags          = row.GetStr(28).value_or("");
+		e.content_flags_disabled = row.GetStr(29).value_or("");
+
+		return e;
+	}
+
+	static Object FindOnePrepared(
+		Database& db,
+		int object_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { object_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Object> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Object> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -673,7 +799,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<30> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -710,13 +844,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
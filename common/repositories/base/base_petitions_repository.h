@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePetitionsRepository {
@@ -35,6 +37,9 @@ public:
 		int32_t     unavailables;
 		int8_t      ischeckedout;
 		int64_t     senttime;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<16> changed_columns = std::bitset<16>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -215,6 +220,30 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Petitions &e,
+		const Petitions &original
+	)
+	{
+		e.changed_columns[0] = e.dib != original.dib;
+		e.changed_columns[1] = e.petid != original.petid;
+		e.changed_columns[2] = e.charname != original.charname;
+		e.changed_columns[3] = e.accountname != original.accountname;
+		e.changed_columns[4] = e.lastgm != original.lastgm;
+		e.changed_columns[5] = e.petitiontext != original.petitiontext;
+		e.changed_columns[6] = e.gmtext != original.gmtext;
+		e.changed_columns[7] = e.zone != original.zone;
+		e.changed_columns[8] = e.urgency != original.urgency;
+		e.changed_columns[9] = e.charclass != original.charclass;
+		e.changed_columns[10] = e.charrace != original.charrace;
+		e.changed_columns[11] = e.charlevel != original.charlevel;
+		e.changed_columns[12] = e.checkouts != original.checkouts;
+		e.changed_columns[13] = e.unavailables != original.unavailables;
+		e.changed_columns[14] = e.ischeckedout != original.ischeckedout;
+		e.changed_columns[15] = e.senttime != original.senttime;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Petitions &e
@@ -224,21 +253,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.petid));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.accountname) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.lastgm) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.petitiontext) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.gmtext) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.urgency));
-		v.push_back(columns[9] + " = " + std::to_string(e.charclass));
-		v.push_back(columns[10] + " = " + std::to_string(e.charrace));
-		v.push_back(columns[11] + " = " + std::to_string(e.charlevel));
-		v.push_back(columns[12] + " = " + std::to_string(e.checkouts));
-		v.push_back(columns[13] + " = " + std::to_string(e.unavailables));
-		v.push_back(columns[14] + " = " + std::to_string(e.ischeckedout));
-		v.push_back(columns[15] + " = " + std::to_string(e.senttime));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.petid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.charname) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.accountname) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.lastgm) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.petitiontext) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.gmtext) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.urgency)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.charclass)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.charrace)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.charlevel)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.checkouts)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.unavailables)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.ischeckedout)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.senttime)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -417,6 +450,71 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Petitions FromStmtRow(const mysql::StmtRow &row)
+	{
+		Petitions e{};
+
+		e.dib          = row.Get<uint32_t>(0).value_or(0);
+		e.petid        = row.Get<uint32_t>(1).value_or(0);
+		e.charname     = row.GetStr(2).value_or("");
+		e.accountname  = row.GetStr(3).value_or("");
+		e.lastgm       = row.GetStr(4).value_or("");
+		e.petitiontext = row.GetStr(5).value_or("");
+		e.gmtext       = row.GetStr(6).value_or("");
+		e.zone         = row.GetStr(7).value_or("");
+		e.urgency      = row.Get<int32_t>(8).value_or(0);
+		e.charclass    = row.Get<int32_t>(9).value_or(0);
+		e.charrace     = row.Get<int32_t>(10).value_or(0);
+		e.charlevel    = row.Get<int32_t>(11).value_or(0);
+		e.checkouts    = row.Get<int32_t>(12).value_or(0);
+		e.unavailables = row.Get<int32_t>(13).value_or(0);
+		e.ischeckedout = row.Get<int8_t>(14).value_or(0);
+		e.senttime     = row.Get<int64_t>(15).value_or(0);
+
+		return e;
+	}
+
+	static Petitions FindOnePrepared(
+		Database& db,
+		int petitions_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { petitions_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Petitions> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Petitions> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -519,7 +617,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<16> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.dib));
@@ -542,13 +648,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePetsBeastlordDataRepository {
@@ -26,6 +28,9 @@ public:
 		uint8_t  gender;
 		float    size_modifier;
 		uint8_t  face;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -170,6 +175,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		PetsBeastlordData &e,
+		const PetsBeastlordData &original
+	)
+	{
+		e.changed_columns[0] = e.player_race != original.player_race;
+		e.changed_columns[1] = e.pet_race != original.pet_race;
+		e.changed_columns[2] = e.texture != original.texture;
+		e.changed_columns[3] = e.helm_texture != original.helm_texture;
+		e.changed_columns[4] = e.gender != original.gender;
+		e.changed_columns[5] = e.size_modifier != original.size_modifier;
+		e.changed_columns[6] = e.face != original.face;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const PetsBeastlordData &e
@@ -179,13 +199,17 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.player_race));
-		v.push_back(columns[1] + " = " + std::to_string(e.pet_race));
-		v.push_back(columns[2] + " = " + std::to_string(e.texture));
-		v.push_back(columns[3] + " = " + std::to_string(e.helm_texture));
-		v.push_back(columns[4] + " = " + std::to_string(e.gender));
-		v.push_back(columns[5] + " = " + std::to_string(e.size_modifier));
-		v.push_back(columns[6] + " = " + std::to_string(e.face));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.player_race)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.pet_race)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.texture)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.helm_texture)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.gender)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.size_modifier)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.face)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -328,6 +352,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static PetsBeastlordData FromStmtRow(const mysql::StmtRow &row)
+	{
+		PetsBeastlordData e{};
+
+		e.player_race   = row.Get<uint32_t>(0).value_or(1);
+		e.pet_race      = row.Get<uint32_t>(1).value_or(42);
+		e.texture       = row.Get<uint8_t>(2).value_or(0);
+		e.helm_texture  = row.Get<uint8_t>(3).value_or(0);
+		e.gender        = row.Get<uint8_t>(4).value_or(2);
+		e.size_modifier = row.Get<float>(5).value_or(0.0f) > 0.0f ? *row.Get<float>(5) : 1;
+		e.face          = row.Get<uint8_t>(6).value_or(0);
+
+		return e;
+	}
+
+	static PetsBeastlordData FindOnePrepared(
+		Database& db,
+		int pets_beastlord_data_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { pets_beastlord_data_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<PetsBeastlordData> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<PetsBeastlordData> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -421,7 +501,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.player_race));
@@ -435,13 +523,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePetsRepository {
@@ -28,6 +30,9 @@ public:
 		int8_t      petnaming;
 		int8_t      monsterflag;
 		int32_t     equipmentset;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<9> changed_columns = std::bitset<9>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -180,6 +185,23 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Pets &e,
+		const Pets &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.type != original.type;
+		e.changed_columns[2] = e.petpower != original.petpower;
+		e.changed_columns[3] = e.npcID != original.npcID;
+		e.changed_columns[4] = e.temp != original.temp;
+		e.changed_columns[5] = e.petcontrol != original.petcontrol;
+		e.changed_columns[6] = e.petnaming != original.petnaming;
+		e.changed_columns[7] = e.monsterflag != original.monsterflag;
+		e.changed_columns[8] = e.equipmentset != original.equipmentset;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Pets &e
@@ -189,14 +211,18 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.type) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.petpower));
-		v.push_back(columns[3] + " = " + std::to_string(e.npcID));
-		v.push_back(columns[4] + " = " + std::to_string(e.temp));
-		v.push_back(columns[5] + " = " + std::to_string(e.petcontrol));
-		v.push_back(columns[6] + " = " + std::to_string(e.petnaming));
-		v.push_back(columns[7] + " = " + std::to_string(e.monsterflag));
-		v.push_back(columns[8] + " = " + std::to_string(e.equipmentset));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.type) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.petpower)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.npcID)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.temp)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.petcontrol)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.petnaming)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.monsterflag)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.equipmentset)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -347,6 +373,64 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Pets FromStmtRow(const mysql::StmtRow &row)
+	{
+		Pets e{};
+
+		e.id           = row.Get<int32_t>(0).value_or(0);
+		e.type         = row.GetStr(1).value_or("");
+		e.petpower     = row.Get<int32_t>(2).value_or(0);
+		e.npcID        = row.Get<int32_t>(3).value_or(0);
+		e.temp         = row.Get<int8_t>(4).value_or(0);
+		e.petcontrol   = row.Get<int8_t>(5).value_or(0);
+		e.petnaming    = row.Get<int8_t>(6).value_or(0);
+		e.monsterflag  = row.Get<int8_t>(7).value_or(0);
+		e.equipmentset = row.Get<int32_t>(8).value_or(-1);
+
+		return e;
+	}
+
+	static Pets FindOnePrepared(
+		Database& db,
+		int pets_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { pets_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Pets> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Pets> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -442,7 +526,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<9> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -458,13 +550,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePlayerEventKilledRaidNpcRepository {
@@ -26,6 +28,9 @@ public:
 		uint64_t    total_damage_per_second_taken;
 		uint64_t    total_heal_per_second_taken;
 		time_t      created_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<7> changed_columns = std::bitset<7>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -170,6 +175,21 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		PlayerEventKilledRaidNpc &e,
+		const PlayerEventKilledRaidNpc &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.npc_id != original.npc_id;
+		e.changed_columns[2] = e.npc_name != original.npc_name;
+		e.changed_columns[3] = e.combat_time_seconds != original.combat_time_seconds;
+		e.changed_columns[4] = e.total_damage_per_second_taken != original.total_damage_per_second_taken;
+		e.changed_columns[5] = e.total_heal_per_second_taken != original.total_heal_per_second_taken;
+		e.changed_columns[6] = e.created_at != original.created_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const PlayerEventKilledRaidNpc &e
@@ -179,12 +199,16 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.npc_id));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.npc_name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.combat_time_seconds));
-		v.push_back(columns[4] + " = " + std::to_string(e.total_damage_per_second_taken));
-		v.push_back(columns[5] + " = " + std::to_string(e.total_heal_per_second_taken));
-		v.push_back(columns[6] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npc_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.npc_name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.combat_time_seconds)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.total_damage_per_second_taken)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.total_heal_per_second_taken)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -327,6 +351,62 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static PlayerEventKilledRaidNpc FromStmtRow(const mysql::StmtRow &row)
+	{
+		PlayerEventKilledRaidNpc e{};
+
+		e.id                            = row.Get<uint64_t>(0).value_or(0);
+		e.npc_id                        = row.Get<uint32_t>(1).value_or(0);
+		e.npc_name                      = row.GetStr(2).value_or("");
+		e.combat_time_seconds           = row.Get<uint32_t>(3).value_or(0);
+		e.total_damage_per_second_taken = row.Get<uint64_t>(4).value_or(0);
+		e.total_heal_per_second_taken   = row.Get<uint64_t>(5).value_or(0);
+		e.created_at                    = row.Get<int64_t>(6).value_or(-1);
+
+		return e;
+	}
+
+	static PlayerEventKilledRaidNpc FindOnePrepared(
+		Database& db,
+		int player_event_killed_raid_npc_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { player_event_killed_raid_npc_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<PlayerEventKilledRaidNpc> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<PlayerEventKilledRaidNpc> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -420,7 +500,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<7> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -434,13 +522,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
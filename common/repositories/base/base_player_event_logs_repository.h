@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 #include <cereal/cereal.hpp>
 class BasePlayerEventLogsRepository {
@@ -55,6 +57,9 @@ public:
 				CEREAL_NVP(created_at)
 			);
 		}
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<14> changed_columns = std::bitset<14>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -227,6 +232,28 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		PlayerEventLogs &e,
+		const PlayerEventLogs &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.account_id != original.account_id;
+		e.changed_columns[2] = e.character_id != original.character_id;
+		e.changed_columns[3] = e.zone_id != original.zone_id;
+		e.changed_columns[4] = e.instance_id != original.instance_id;
+		e.changed_columns[5] = e.x != original.x;
+		e.changed_columns[6] = e.y != original.y;
+		e.changed_columns[7] = e.z != original.z;
+		e.changed_columns[8] = e.heading != original.heading;
+		e.changed_columns[9] = e.event_type_id != original.event_type_id;
+		e.changed_columns[10] = e.event_type_name != original.event_type_name;
+		e.changed_columns[11] = e.event_data != original.event_data;
+		e.changed_columns[12] = e.etl_table_id != original.etl_table_id;
+		e.changed_columns[13] = e.created_at != original.created_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const PlayerEventLogs &e
@@ -236,19 +263,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.character_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.x));
-		v.push_back(columns[6] + " = " + std::to_string(e.y));
-		v.push_back(columns[7] + " = " + std::to_string(e.z));
-		v.push_back(columns[8] + " = " + std::to_string(e.heading));
-		v.push_back(columns[9] + " = " + std::to_string(e.event_type_id));
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.event_type_name) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.event_data) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.etl_table_id));
-		v.push_back(columns[13] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.character_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.event_type_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.event_type_name) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.event_data) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.etl_table_id)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -419,6 +450,69 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static PlayerEventLogs FromStmtRow(const mysql::StmtRow &row)
+	{
+		PlayerEventLogs e{};
+
+		e.id              = row.Get<int64_t>(0).value_or(0);
+		e.account_id      = row.Get<int64_t>(1).value_or(0);
+		e.character_id    = row.Get<int64_t>(2).value_or(0);
+		e.zone_id         = row.Get<int32_t>(3).value_or(0);
+		e.instance_id     = row.Get<int32_t>(4).value_or(0);
+		e.x               = row.Get<float>(5).value_or(0);
+		e.y               = row.Get<float>(6).value_or(0);
+		e.z               = row.Get<float>(7).value_or(0);
+		e.heading         = row.Get<float>(8).value_or(0);
+		e.event_type_id   = row.Get<int32_t>(9).value_or(0);
+		e.event_type_name = row.GetStr(10).value_or("");
+		e.event_data      = row.GetStr(11).value_or("");
+		e.etl_table_id    = row.Get<int64_t>(12).value_or(0);
+		e.created_at      = row.Get<int64_t>(13).value_or(-1);
+
+		return e;
+	}
+
+	static PlayerEventLogs FindOnePrepared(
+		Database& db,
+		int player_event_logs_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { player_event_logs_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<PlayerEventLogs> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<PlayerEventLogs> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -519,7 +613,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<14> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -540,13 +642,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePlayerEventLootItemsRepository {
@@ -32,6 +34,9 @@ public:
 		uint32_t    npc_id;
 		std::string corpse_name;
 		time_t      created_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		PlayerEventLootItems &e,
+		const PlayerEventLootItems &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.item_id != original.item_id;
+		e.changed_columns[2] = e.item_name != original.item_name;
+		e.changed_columns[3] = e.charges != original.charges;
+		e.changed_columns[4] = e.augment_1_id != original.augment_1_id;
+		e.changed_columns[5] = e.augment_2_id != original.augment_2_id;
+		e.changed_columns[6] = e.augment_3_id != original.augment_3_id;
+		e.changed_columns[7] = e.augment_4_id != original.augment_4_id;
+		e.changed_columns[8] = e.augment_5_id != original.augment_5_id;
+		e.changed_columns[9] = e.augment_6_id != original.augment_6_id;
+		e.changed_columns[10] = e.npc_id != original.npc_id;
+		e.changed_columns[11] = e.corpse_name != original.corpse_name;
+		e.changed_columns[12] = e.created_at != original.created_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const PlayerEventLootItems &e
@@ -209,18 +235,22 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.item_name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.charges));
-		v.push_back(columns[4] + " = " + std::to_string(e.augment_1_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.augment_2_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.augment_3_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.augment_4_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.augment_5_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.augment_6_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.npc_id));
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.corpse_name) + "'");
-		v.push_back(columns[12] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.item_name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.augment_1_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.augment_2_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.augment_3_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augment_4_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augment_5_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augment_6_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.npc_id)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.corpse_name) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -387,6 +417,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static PlayerEventLootItems FromStmtRow(const mysql::StmtRow &row)
+	{
+		PlayerEventLootItems e{};
+
+		e.id           = row.Get<uint64_t>(0).value_or(0);
+		e.item_id      = row.Get<uint32_t>(1).value_or(0);
+		e.item_name    = row.GetStr(2).value_or("");
+		e.charges      = row.Get<int32_t>(3).value_or(0);
+		e.augment_1_id = row.Get<uint32_t>(4).value_or(0);
+		e.augment_2_id = row.Get<uint32_t>(5).value_or(0);
+		e.augment_3_id = row.Get<uint32_t>(6).value_or(0);
+		e.augment_4_id = row.Get<uint32_t>(7).value_or(0);
+		e.augment_5_id = row.Get<uint32_t>(8).value_or(0);
+		e.augment_6_id = row.Get<uint32_t>(9).value_or(0);
+		e.npc_id       = row.Get<uint32_t>(10).value_or(0);
+		e.corpse_name  = row.GetStr(11).value_or("");
+		e.created_at   = row.Get<int64_t>(12).value_or(-1);
+
+		return e;
+	}
+
+	static PlayerEventLootItems FindOnePrepared(
+		Database& db,
+		int player_event_loot_items_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { player_event_loot_items_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<PlayerEventLootItems> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<PlayerEventLootItems> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -486,7 +578,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -506,13 +606,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BasePlayerEventNpcHandinRepository {
@@ -32,6 +34,9 @@ public:
 		uint64_t    return_platinum;
 		uint8_t     is_quest_handin;
 		time_t      created_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		PlayerEventNpcHandin &e,
+		const PlayerEventNpcHandin &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.npc_id != original.npc_id;
+		e.changed_columns[2] = e.npc_name != original.npc_name;
+		e.changed_columns[3] = e.handin_copper != original.handin_copper;
+		e.changed_columns[4] = e.handin_silver != original.handin_silver;
+		e.changed_columns[5] = e.handin_gold != original.handin_gold;
+		e.changed_columns[6] = e.handin_platinum != original.handin_platinum;
+		e.changed_columns[7] = e.return_copper != original.return_copper;
+		e.changed_columns[8] = e.return_silver != original.return_silver;
+		e.changed_columns[9] = e.return_gold != original.return_gold;
+		e.changed_columns[10] = e.return_platinum != original.return_platinum;
+		e.changed_columns[11] = e.is_quest_handin != original.is_quest_handin;
+		e.changed_columns[12] = e.created_at != original.created_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const PlayerEventNpcHandin &e
@@ -209,18 +235,22 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.npc_id));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.npc_name) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.handin_copper));
-		v.push_back(columns[4] + " = " + std::to_string(e.handin_silver));
-		v.push_back(columns[5] + " = " + std::to_string(e.handin_gold));
-		v.push_back(columns[6] + " = " + std::to_string(e.handin_platinum));
-		v.push_back(columns[7] + " = " + std::to_string(e.return_copper));
-		v.push_back(columns[8] + " = " + std::to_string(e.return_silver));
-		v.push_back(columns[9] + " = " + std::to_string(e.return_gold));
-		v.push_back(columns[10] + " = " + std::to_string(e.return_platinum));
-		v.push_back(columns[11] + " = " + std::to_string(e.is_quest_handin));
-		v.push_back(columns[12] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npc_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.npc_name) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.handin_copper)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.handin_silver)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.handin_gold)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.handin_platinum)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.return_copper)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.return_silver)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.return_gold)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.return_platinum)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.is_quest_handin)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -387,6 +417,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static PlayerEventNpcHandin FromStmtRow(const mysql::StmtRow &row)
+	{
+		PlayerEventNpcHandin e{};
+
+		e.id              = row.Get<uint64_t>(0).value_or(0);
+		e.npc_id          = row.Get<uint32_t>(1).value_or(0);
+		e.npc_name        = row.GetStr(2).value_or("");
+		e.handin_copper   = row.Get<uint64_t>(3).value_or(0);
+		e.handin_silver   = row.Get<uint64_t>(4).value_or(0);
+		e.handin_gold     = row.Get<uint64_t>(5).value_or(0);
+		e.handin_platinum = row.Get<uint64_t>(6).value_or(0);
+		e.return_copper   = row.Get<uint64_t>(7).value_or(0);
+		e.return_silver   = row.Get<uint64_t>(8).value_or(0);
+		e.return_gold     = row.Get<uint64_t>(9).value_or(0);
+		e.return_platinum = row.Get<uint64_t>(10).value_or(0);
+		e.is_quest_handin = row.Get<uint8_t>(11).value_or(0);
+		e.created_at      = row.Get<int64_t>(12).value_or(-1);
+
+		return e;
+	}
+
+	static PlayerEventNpcHandin FindOnePrepared(
+		Database& db,
+		int player_event_npc_handin_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { player_event_npc_handin_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<PlayerEventNpcHandin> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<PlayerEventNpcHandin> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -486,7 +578,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -506,13 +606,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseRaidDetailsRepository {
@@ -32,6 +34,9 @@ public:
 		uint32_t    marked_npc_3_entity_id;
 		uint32_t    marked_npc_3_zone_id;
 		uint32_t    marked_npc_3_instance_id;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		RaidDetails &e,
+		const RaidDetails &original
+	)
+	{
+		e.changed_columns[0] = e.raidid != original.raidid;
+		e.changed_columns[1] = e.loottype != original.loottype;
+		e.changed_columns[2] = e.locked != original.locked;
+		e.changed_columns[3] = e.motd != original.motd;
+		e.changed_columns[4] = e.marked_npc_1_entity_id != original.marked_npc_1_entity_id;
+		e.changed_columns[5] = e.marked_npc_1_zone_id != original.marked_npc_1_zone_id;
+		e.changed_columns[6] = e.marked_npc_1_instance_id != original.marked_npc_1_instance_id;
+		e.changed_columns[7] = e.marked_npc_2_entity_id != original.marked_npc_2_entity_id;
+		e.changed_columns[8] = e.marked_npc_2_zone_id != original.marked_npc_2_zone_id;
+		e.changed_columns[9] = e.marked_npc_2_instance_id != original.marked_npc_2_instance_id;
+		e.changed_columns[10] = e.marked_npc_3_entity_id != original.marked_npc_3_entity_id;
+		e.changed_columns[11] = e.marked_npc_3_zone_id != original.marked_npc_3_zone_id;
+		e.changed_columns[12] = e.marked_npc_3_instance_id != original.marked_npc_3_instance_id;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const RaidDetails &e
@@ -209,19 +235,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.raidid));
-		v.push_back(columns[1] + " = " + std::to_string(e.loottype));
-		v.push_back(columns[2] + " = " + std::to_string(e.locked));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.motd) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.marked_npc_1_entity_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.marked_npc_1_zone_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.marked_npc_1_instance_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.marked_npc_2_entity_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.marked_npc_2_zone_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.marked_npc_2_instance_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.marked_npc_3_entity_id));
-		v.push_back(columns[11] + " = " + std::to_string(e.marked_npc_3_zone_id));
-		v.push_back(columns[12] + " = " + std::to_string(e.marked_npc_3_instance_id));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.raidid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.loottype)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.locked)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.motd) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.marked_npc_1_entity_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.marked_npc_1_zone_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.marked_npc_1_instance_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.marked_npc_2_entity_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.marked_npc_2_zone_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.marked_npc_2_instance_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.marked_npc_3_entity_id)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.marked_npc_3_zone_id)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.marked_npc_3_instance_id)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -388,6 +418,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static RaidDetails FromStmtRow(const mysql::StmtRow &row)
+	{
+		RaidDetails e{};
+
+		e.raidid                   = row.Get<int32_t>(0).value_or(0);
+		e.loottype                 = row.Get<int32_t>(1).value_or(0);
+		e.locked                   = row.Get<int8_t>(2).value_or(0);
+		e.motd                     = row.GetStr(3).value_or("");
+		e.marked_npc_1_entity_id   = row.Get<uint32_t>(4).value_or(0);
+		e.marked_npc_1_zone_id     = row.Get<uint32_t>(5).value_or(0);
+		e.marked_npc_1_instance_id = row.Get<uint32_t>(6).value_or(0);
+		e.marked_npc_2_entity_id   = row.Get<uint32_t>(7).value_or(0);
+		e.marked_npc_2_zone_id     = row.Get<uint32_t>(8).value_or(0);
+		e.marked_npc_2_instance_id = row.Get<uint32_t>(9).value_or(0);
+		e.marked_npc_3_entity_id   = row.Get<uint32_t>(10).value_or(0);
+		e.marked_npc_3_zone_id     = row.Get<uint32_t>(11).value_or(0);
+		e.marked_npc_3_instance_id = row.Get<uint32_t>(12).value_or(0);
+
+		return e;
+	}
+
+	static RaidDetails FindOnePrepared(
+		Database& db,
+		int raid_details_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { raid_details_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<RaidDetails> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<RaidDetails> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -487,7 +579,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.raidid));
@@ -507,13 +607,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseRaidMembersRepository {
@@ -33,6 +35,9 @@ public:
 		uint8_t     is_marker;
 		uint8_t     is_assister;
 		std::string note;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<14> changed_columns = std::bitset<14>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -205,6 +210,28 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		RaidMembers &e,
+		const RaidMembers &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.raidid != original.raidid;
+		e.changed_columns[2] = e.charid != original.charid;
+		e.changed_columns[3] = e.bot_id != original.bot_id;
+		e.changed_columns[4] = e.groupid != original.groupid;
+		e.changed_columns[5] = e._class != original._class;
+		e.changed_columns[6] = e.level != original.level;
+		e.changed_columns[7] = e.name != original.name;
+		e.changed_columns[8] = e.isgroupleader != original.isgroupleader;
+		e.changed_columns[9] = e.israidleader != original.israidleader;
+		e.changed_columns[10] = e.islooter != original.islooter;
+		e.changed_columns[11] = e.is_marker != original.is_marker;
+		e.changed_columns[12] = e.is_assister != original.is_assister;
+		e.changed_columns[13] = e.note != original.note;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const RaidMembers &e
@@ -214,19 +241,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.raidid));
-		v.push_back(columns[2] + " = " + std::to_string(e.charid));
-		v.push_back(columns[3] + " = " + std::to_string(e.bot_id));
-		v.push_back(columns[4] + " = " + std::to_string(e.groupid));
-		v.push_back(columns[5] + " = " + std::to_string(e._class));
-		v.push_back(columns[6] + " = " + std::to_string(e.level));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.isgroupleader));
-		v.push_back(columns[9] + " = " + std::to_string(e.israidleader));
-		v.push_back(columns[10] + " = " + std::to_string(e.islooter));
-		v.push_back(columns[11] + " = " + std::to_string(e.is_marker));
-		v.push_back(columns[12] + " = " + std::to_string(e.is_assister));
-		v.push_back(columns[13] + " = '" + Strings::Escape(e.note) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.raidid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.charid)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.bot_id)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.groupid)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e._class)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.isgroupleader)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.israidleader)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.islooter)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.is_marker)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.is_assister)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = '" + Strings::Escape(e.note) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -397,6 +428,69 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static RaidMembers FromStmtRow(const mysql::StmtRow &row)
+	{
+		RaidMembers e{};
+
+		e.id            = row.Get<uint64_t>(0).value_or(0);
+		e.raidid        = row.Get<int32_t>(1).value_or(0);
+		e.charid        = row.Get<int32_t>(2).value_or(0);
+		e.bot_id        = row.Get<int32_t>(3).value_or(0);
+		e.groupid       = row.Get<uint32_t>(4).value_or(0);
+		e._class        = row.Get<int8_t>(5).value_or(0);
+		e.level         = row.Get<int8_t>(6).value_or(0);
+		e.name          = row.GetStr(7).value_or("");
+		e.isgroupleader = row.Get<int8_t>(8).value_or(0);
+		e.israidleader  = row.Get<int8_t>(9).value_or(0);
+		e.islooter      = row.Get<int8_t>(10).value_or(0);
+		e.is_marker     = row.Get<uint8_t>(11).value_or(0);
+		e.is_assister   = row.Get<uint8_t>(12).value_or(0);
+		e.note          = row.GetStr(13).value_or("");
+
+		return e;
+	}
+
+	static RaidMembers FindOnePrepared(
+		Database& db,
+		int raid_members_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { raid_members_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<RaidMembers> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<RaidMembers> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -497,7 +591,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<14> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -518,13 +620,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseServerScheduledEventsRepository {
@@ -36,6 +38,9 @@ public:
 		std::string cron_expression;
 		time_t      created_at;
 		time_t      deleted_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<17> changed_columns = std::bitset<17>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -220,6 +225,31 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		ServerScheduledEvents &e,
+		const ServerScheduledEvents &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.description != original.description;
+		e.changed_columns[2] = e.event_type != original.event_type;
+		e.changed_columns[3] = e.event_data != original.event_data;
+		e.changed_columns[4] = e.minute_start != original.minute_start;
+		e.changed_columns[5] = e.hour_start != original.hour_start;
+		e.changed_columns[6] = e.day_start != original.day_start;
+		e.changed_columns[7] = e.month_start != original.month_start;
+		e.changed_columns[8] = e.year_start != original.year_start;
+		e.changed_columns[9] = e.minute_end != original.minute_end;
+		e.changed_columns[10] = e.hour_end != original.hour_end;
+		e.changed_columns[11] = e.day_end != original.day_end;
+		e.changed_columns[12] = e.month_end != original.month_end;
+		e.changed_columns[13] = e.year_end != original.year_end;
+		e.changed_columns[14] = e.cron_expression != original.cron_expression;
+		e.changed_columns[15] = e.created_at != original.created_at;
+		e.changed_columns[16] = e.deleted_at != original.deleted_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const ServerScheduledEvents &e
@@ -229,22 +259,26 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.description) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.event_type) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.event_data) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.minute_start));
-		v.push_back(columns[5] + " = " + std::to_string(e.hour_start));
-		v.push_back(columns[6] + " = " + std::to_string(e.day_start));
-		v.push_back(columns[7] + " = " + std::to_string(e.month_start));
-		v.push_back(columns[8] + " = " + std::to_string(e.year_start));
-		v.push_back(columns[9] + " = " + std::to_string(e.minute_end));
-		v.push_back(columns[10] + " = " + std::to_string(e.hour_end));
-		v.push_back(columns[11] + " = " + std::to_string(e.day_end));
-		v.push_back(columns[12] + " = " + std::to_string(e.month_end));
-		v.push_back(columns[13] + " = " + std::to_string(e.year_end));
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.cron_expression) + "'");
-		v.push_back(columns[15] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
-		v.push_back(columns[16] + " = FROM_UNIXTIME(" + (e.deleted_at > 0 ? std::to_string(e.deleted_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.description) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.event_type) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.event_data) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.minute_start)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.hour_start)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.day_start)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.month_start)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.year_start)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.minute_end)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.hour_end)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.day_end)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.month_end)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.year_end)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.cron_expression) + "'"); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = FROM_UNIXTIME(" + (e.deleted_at > 0 ? std::to_string(e.deleted_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -427,6 +461,72 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static ServerScheduledEvents FromStmtRow(const mysql::StmtRow &row)
+	{
+		ServerScheduledEvents e{};
+
+		e.id              = row.Get<int32_t>(0).value_or(0);
+		e.description     = row.GetStr(1).value_or("");
+		e.event_type      = row.GetStr(2).value_or("");
+		e.event_data      = row.GetStr(3).value_or("");
+		e.minute_start    = row.Get<int32_t>(4).value_or(0);
+		e.hour_start      = row.Get<int32_t>(5).value_or(0);
+		e.day_start       = row.Get<int32_t>(6).value_or(0);
+		e.month_start     = row.Get<int32_t>(7).value_or(0);
+		e.year_start      = row.Get<int32_t>(8).value_or(0);
+		e.minute_end      = row.Get<int32_t>(9).value_or(0);
+		e.hour_end        = row.Get<int32_t>(10).value_or(0);
+		e.day_end         = row.Get<int32_t>(11).value_or(0);
+		e.month_end       = row.Get<int32_t>(12).value_or(0);
+		e.year_end        = row.Get<int32_t>(13).value_or(0);
+		e.cron_expression = row.GetStr(14).value_or("");
+		e.created_at      = row.Get<int64_t>(15).value_or(-1);
+		e.deleted_at      = row.Get<int64_t>(16).value_or(-1);
+
+		return e;
+	}
+
+	static ServerScheduledEvents FindOnePrepared(
+		Database& db,
+		int server_scheduled_events_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { server_scheduled_events_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<ServerScheduledEvents> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<ServerScheduledEvents> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -530,7 +630,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<17> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -554,13 +662,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
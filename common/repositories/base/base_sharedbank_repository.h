@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSharedbankRepository {
@@ -35,6 +37,9 @@ public:
 		uint32_t    ornament_idfile;
 		int32_t     ornament_hero_model;
 		uint64_t    guid;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<16> changed_columns = std::bitset<16>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -215,6 +220,30 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Sharedbank &e,
+		const Sharedbank &original
+	)
+	{
+		e.changed_columns[0] = e.account_id != original.account_id;
+		e.changed_columns[1] = e.slot_id != original.slot_id;
+		e.changed_columns[2] = e.item_id != original.item_id;
+		e.changed_columns[3] = e.charges != original.charges;
+		e.changed_columns[4] = e.color != original.color;
+		e.changed_columns[5] = e.augment_one != original.augment_one;
+		e.changed_columns[6] = e.augment_two != original.augment_two;
+		e.changed_columns[7] = e.augment_three != original.augment_three;
+		e.changed_columns[8] = e.augment_four != original.augment_four;
+		e.changed_columns[9] = e.augment_five != original.augment_five;
+		e.changed_columns[10] = e.augment_six != original.augment_six;
+		e.changed_columns[11] = e.custom_data != original.custom_data;
+		e.changed_columns[12] = e.ornament_icon != original.ornament_icon;
+		e.changed_columns[13] = e.ornament_idfile != original.ornament_idfile;
+		e.changed_columns[14] = e.ornament_hero_model != original.ornament_hero_model;
+		e.changed_columns[15] = e.guid != original.guid;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Sharedbank &e
@@ -224,22 +253,26 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.account_id));
-		v.push_back(columns[1] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.charges));
-		v.push_back(columns[4] + " = " + std::to_string(e.color));
-		v.push_back(columns[5] + " = " + std::to_string(e.augment_one));
-		v.push_back(columns[6] + " = " + std::to_string(e.augment_two));
-		v.push_back(columns[7] + " = " + std::to_string(e.augment_three));
-		v.push_back(columns[8] + " = " + std::to_string(e.augment_four));
-		v.push_back(columns[9] + " = " + std::to_string(e.augment_five));
-		v.push_back(columns[10] + " = " + std::to_string(e.augment_six));
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.custom_data) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.ornament_icon));
-		v.push_back(columns[13] + " = " + std::to_string(e.ornament_idfile));
-		v.push_back(columns[14] + " = " + std::to_string(e.ornament_hero_model));
-		v.push_back(columns[15] + " = " + std::to_string(e.guid));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.account_id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.charges)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.color)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.augment_one)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.augment_two)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augment_three)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augment_four)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augment_five)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.augment_six)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.custom_data) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.ornament_icon)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.ornament_idfile)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.ornament_hero_model)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.guid)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -418,6 +451,71 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Sharedbank FromStmtRow(const mysql::StmtRow &row)
+	{
+		Sharedbank e{};
+
+		e.account_id          = row.Get<uint32_t>(0).value_or(0);
+		e.slot_id             = row.Get<uint32_t>(1).value_or(0);
+		e.item_id             = row.Get<uint32_t>(2).value_or(0);
+		e.charges             = row.Get<uint16_t>(3).value_or(0);
+		e.color               = row.Get<uint32_t>(4).value_or(0);
+		e.augment_one         = row.Get<uint32_t>(5).value_or(0);
+		e.augment_two         = row.Get<uint32_t>(6).value_or(0);
+		e.augment_three       = row.Get<uint32_t>(7).value_or(0);
+		e.augment_four        = row.Get<uint32_t>(8).value_or(0);
+		e.augment_five        = row.Get<uint32_t>(9).value_or(0);
+		e.augment_six         = row.Get<uint32_t>(10).value_or(0);
+		e.custom_data         = row.GetStr(11).value_or("");
+		e.ornament_icon       = row.Get<uint32_t>(12).value_or(0);
+		e.ornament_idfile     = row.Get<uint32_t>(13).value_or(0);
+		e.ornament_hero_model = row.Get<int32_t>(14).value_or(0);
+		e.guid                = row.Get<uint64_t>(15).value_or(0);
+
+		return e;
+	}
+
+	static Sharedbank FindOnePrepared(
+		Database& db,
+		int sharedbank_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { sharedbank_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Sharedbank> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Sharedbank> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -520,7 +618,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<16> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.account_id));
@@ -543,13 +649,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpawn2Repository {
@@ -38,6 +40,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<19> changed_columns = std::bitset<19>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -230,6 +235,33 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Spawn2 &e,
+		const Spawn2 &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.spawngroupID != original.spawngroupID;
+		e.changed_columns[2] = e.zone != original.zone;
+		e.changed_columns[3] = e.version != original.version;
+		e.changed_columns[4] = e.x != original.x;
+		e.changed_columns[5] = e.y != original.y;
+		e.changed_columns[6] = e.z != original.z;
+		e.changed_columns[7] = e.heading != original.heading;
+		e.changed_columns[8] = e.respawntime != original.respawntime;
+		e.changed_columns[9] = e.variance != original.variance;
+		e.changed_columns[10] = e.pathgrid != original.pathgrid;
+		e.changed_columns[11] = e.path_when_zone_idle != original.path_when_zone_idle;
+		e.changed_columns[12] = e._condition != original._condition;
+		e.changed_columns[13] = e.cond_value != original.cond_value;
+		e.changed_columns[14] = e.animation != original.animation;
+		e.changed_columns[15] = e.min_expansion != original.min_expansion;
+		e.changed_columns[16] = e.max_expansion != original.max_expansion;
+		e.changed_columns[17] = e.content_flags != original.content_flags;
+		e.changed_columns[18] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Spawn2 &e
@@ -239,24 +271,28 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.spawngroupID));
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[3] + " = " + std::to_string(e.version));
-		v.push_back(columns[4] + " = " + std::to_string(e.x));
-		v.push_back(columns[5] + " = " + std::to_string(e.y));
-		v.push_back(columns[6] + " = " + std::to_string(e.z));
-		v.push_back(columns[7] + " = " + std::to_string(e.heading));
-		v.push_back(columns[8] + " = " + std::to_string(e.respawntime));
-		v.push_back(columns[9] + " = " + std::to_string(e.variance));
-		v.push_back(columns[10] + " = " + std::to_string(e.pathgrid));
-		v.push_back(columns[11] + " = " + std::to_string(e.path_when_zone_idle));
-		v.push_back(columns[12] + " = " + std::to_string(e._condition));
-		v.push_back(columns[13] + " = " + std::to_string(e.cond_value));
-		v.push_back(columns[14] + " = " + std::to_string(e.animation));
-		v.push_back(columns[15] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[16] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.spawngroupID)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.respawntime)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.variance)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.pathgrid)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.path_when_zone_idle)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e._condition)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.cond_value)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.animation)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -447,6 +483,74 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Spawn2 FromStmtRow(const mysql::StmtRow &row)
+	{
+		Spawn2 e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.spawngroupID           = row.Get<int32_t>(1).value_or(0);
+		e.zone                   = row.GetStr(2).value_or("");
+		e.version                = row.Get<int16_t>(3).value_or(0);
+		e.x                      = row.Get<float>(4).value_or(0.000000);
+		e.y                      = row.Get<float>(5).value_or(0.000000);
+		e.z                      = row.Get<float>(6).value_or(0.000000);
+		e.heading                = row.Get<float>(7).value_or(0.000000);
+		e.respawntime            = row.Get<int32_t>(8).value_or(0);
+		e.variance               = row.Get<int32_t>(9).value_or(0);
+		e.pathgrid               = row.Get<int32_t>(10).value_or(0);
+		e.path_when_zone_idle    = row.Get<int8_t>(11).value_or(0);
+		e._condition             = row.Get<uint32_t>(12).value_or(0);
+		e.cond_value             = row.Get<int32_t>(13).value_or(1);
+		e.animation              = row.Get<uint8_t>(14).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(15).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(16).value_or(-1);
+		e.content_flags          = row.GetStr(17).value_or("");
+		e.content_flags_disabled = row.GetStr(18).value_or("");
+
+		return e;
+	}
+
+	static Spawn2 FindOnePrepared(
+		Database& db,
+		int spawn2_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spawn2_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Spawn2> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Spawn2> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -552,7 +656,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<19> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -578,13 +690,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpawnConditionsRepository {
@@ -24,6 +26,9 @@ public:
 		int32_t     value;
 		uint8_t     onchange;
 		std::string name;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<5> changed_columns = std::bitset<5>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -160,6 +165,19 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		SpawnConditions &e,
+		const SpawnConditions &original
+	)
+	{
+		e.changed_columns[0] = e.zone != original.zone;
+		e.changed_columns[1] = e.id != original.id;
+		e.changed_columns[2] = e.value != original.value;
+		e.changed_columns[3] = e.onchange != original.onchange;
+		e.changed_columns[4] = e.name != original.name;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const SpawnConditions &e
@@ -169,11 +187,15 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[1] + " = " + std::to_string(e.id));
-		v.push_back(columns[2] + " = " + std::to_string(e.value));
-		v.push_back(columns[3] + " = " + std::to_string(e.onchange));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.value)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.onchange)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.name) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -308,6 +330,60 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static SpawnConditions FromStmtRow(const mysql::StmtRow &row)
+	{
+		SpawnConditions e{};
+
+		e.zone     = row.GetStr(0).value_or("");
+		e.id       = row.Get<uint32_t>(1).value_or(1);
+		e.value    = row.Get<int32_t>(2).value_or(0);
+		e.onchange = row.Get<uint8_t>(3).value_or(0);
+		e.name     = row.GetStr(4).value_or("");
+
+		return e;
+	}
+
+	static SpawnConditions FindOnePrepared(
+		Database& db,
+		int spawn_conditions_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spawn_conditions_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<SpawnConditions> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<SpawnConditions> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -399,7 +475,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<5> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back("'" + Strings::Escape(e.zone) + "'");
@@ -411,13 +495,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
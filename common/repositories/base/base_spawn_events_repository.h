@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpawnEventsRepository {
@@ -33,6 +35,9 @@ public:
 		uint8_t     action;
 		int32_t     argument;
 		int8_t      strict;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<14> changed_columns = std::bitset<14>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -205,6 +210,28 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		SpawnEvents &e,
+		const SpawnEvents &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.cond_id != original.cond_id;
+		e.changed_columns[3] = e.name != original.name;
+		e.changed_columns[4] = e.period != original.period;
+		e.changed_columns[5] = e.next_minute != original.next_minute;
+		e.changed_columns[6] = e.next_hour != original.next_hour;
+		e.changed_columns[7] = e.next_day != original.next_day;
+		e.changed_columns[8] = e.next_month != original.next_month;
+		e.changed_columns[9] = e.next_year != original.next_year;
+		e.changed_columns[10] = e.enabled != original.enabled;
+		e.changed_columns[11] = e.action != original.action;
+		e.changed_columns[12] = e.argument != original.argument;
+		e.changed_columns[13] = e.strict != original.strict;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const SpawnEvents &e
@@ -214,19 +241,23 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.cond_id));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[4] + " = " + std::to_string(e.period));
-		v.push_back(columns[5] + " = " + std::to_string(e.next_minute));
-		v.push_back(columns[6] + " = " + std::to_string(e.next_hour));
-		v.push_back(columns[7] + " = " + std::to_string(e.next_day));
-		v.push_back(columns[8] + " = " + std::to_string(e.next_month));
-		v.push_back(columns[9] + " = " + std::to_string(e.next_year));
-		v.push_back(columns[10] + " = " + std::to_string(e.enabled));
-		v.push_back(columns[11] + " = " + std::to_string(e.action));
-		v.push_back(columns[12] + " = " + std::to_string(e.argument));
-		v.push_back(columns[13] + " = " + std::to_string(e.strict));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.cond_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.period)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.next_minute)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.next_hour)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.next_day)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.next_month)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.next_year)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.enabled)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.action)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.argument)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.strict)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -397,6 +428,69 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static SpawnEvents FromStmtRow(const mysql::StmtRow &row)
+	{
+		SpawnEvents e{};
+
+		e.id          = row.Get<uint32_t>(0).value_or(0);
+		e.zone        = row.GetStr(1).value_or("");
+		e.cond_id     = row.Get<uint32_t>(2).value_or(0);
+		e.name        = row.GetStr(3).value_or("");
+		e.period      = row.Get<uint32_t>(4).value_or(0);
+		e.next_minute = row.Get<uint8_t>(5).value_or(0);
+		e.next_hour   = row.Get<uint8_t>(6).value_or(0);
+		e.next_day    = row.Get<uint8_t>(7).value_or(0);
+		e.next_month  = row.Get<uint8_t>(8).value_or(0);
+		e.next_year   = row.Get<uint32_t>(9).value_or(0);
+		e.enabled     = row.Get<int8_t>(10).value_or(1);
+		e.action      = row.Get<uint8_t>(11).value_or(0);
+		e.argument    = row.Get<int32_t>(12).value_or(0);
+		e.strict      = row.Get<int8_t>(13).value_or(0);
+
+		return e;
+	}
+
+	static SpawnEvents FindOnePrepared(
+		Database& db,
+		int spawn_events_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spawn_events_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<SpawnEvents> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<SpawnEvents> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -497,7 +591,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<14> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -518,13 +620,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
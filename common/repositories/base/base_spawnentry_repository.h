@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpawnentryRepository {
@@ -29,6 +31,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<10> changed_columns = std::bitset<10>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -185,6 +190,24 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Spawnentry &e,
+		const Spawnentry &original
+	)
+	{
+		e.changed_columns[0] = e.spawngroupID != original.spawngroupID;
+		e.changed_columns[1] = e.npcID != original.npcID;
+		e.changed_columns[2] = e.chance != original.chance;
+		e.changed_columns[3] = e.condition_value_filter != original.condition_value_filter;
+		e.changed_columns[4] = e.min_time != original.min_time;
+		e.changed_columns[5] = e.max_time != original.max_time;
+		e.changed_columns[6] = e.min_expansion != original.min_expansion;
+		e.changed_columns[7] = e.max_expansion != original.max_expansion;
+		e.changed_columns[8] = e.content_flags != original.content_flags;
+		e.changed_columns[9] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Spawnentry &e
@@ -194,16 +217,20 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.spawngroupID));
-		v.push_back(columns[1] + " = " + std::to_string(e.npcID));
-		v.push_back(columns[2] + " = " + std::to_string(e.chance));
-		v.push_back(columns[3] + " = " + std::to_string(e.condition_value_filter));
-		v.push_back(columns[4] + " = " + std::to_string(e.min_time));
-		v.push_back(columns[5] + " = " + std::to_string(e.max_time));
-		v.push_back(columns[6] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[7] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.spawngroupID)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.npcID)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.chance)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.condition_value_filter)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.min_time)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.max_time)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -358,6 +385,65 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Spawnentry FromStmtRow(const mysql::StmtRow &row)
+	{
+		Spawnentry e{};
+
+		e.spawngroupID           = row.Get<int32_t>(0).value_or(0);
+		e.npcID                  = row.Get<int32_t>(1).value_or(0);
+		e.chance                 = row.Get<int16_t>(2).value_or(0);
+		e.condition_value_filter = row.Get<int32_t>(3).value_or(1);
+		e.min_time               = row.Get<int16_t>(4).value_or(0);
+		e.max_time               = row.Get<int16_t>(5).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(6).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(7).value_or(-1);
+		e.content_flags          = row.GetStr(8).value_or("");
+		e.content_flags_disabled = row.GetStr(9).value_or("");
+
+		return e;
+	}
+
+	static Spawnentry FindOnePrepared(
+		Database& db,
+		int spawnentry_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spawnentry_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Spawnentry> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Spawnentry> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -454,7 +540,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<10> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.spawngroupID));
@@ -471,13 +565,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpawngroupRepository {
@@ -32,6 +34,9 @@ public:
 		int8_t      despawn;
 		int32_t     despawn_timer;
 		uint8_t     wp_spawns;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<13> changed_columns = std::bitset<13>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -200,6 +205,27 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Spawngroup &e,
+		const Spawngroup &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.spawn_limit != original.spawn_limit;
+		e.changed_columns[3] = e.dist != original.dist;
+		e.changed_columns[4] = e.max_x != original.max_x;
+		e.changed_columns[5] = e.min_x != original.min_x;
+		e.changed_columns[6] = e.max_y != original.max_y;
+		e.changed_columns[7] = e.min_y != original.min_y;
+		e.changed_columns[8] = e.delay != original.delay;
+		e.changed_columns[9] = e.mindelay != original.mindelay;
+		e.changed_columns[10] = e.despawn != original.despawn;
+		e.changed_columns[11] = e.despawn_timer != original.despawn_timer;
+		e.changed_columns[12] = e.wp_spawns != original.wp_spawns;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Spawngroup &e
@@ -209,18 +235,22 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.spawn_limit));
-		v.push_back(columns[3] + " = " + std::to_string(e.dist));
-		v.push_back(columns[4] + " = " + std::to_string(e.max_x));
-		v.push_back(columns[5] + " = " + std::to_string(e.min_x));
-		v.push_back(columns[6] + " = " + std::to_string(e.max_y));
-		v.push_back(columns[7] + " = " + std::to_string(e.min_y));
-		v.push_back(columns[8] + " = " + std::to_string(e.delay));
-		v.push_back(columns[9] + " = " + std::to_string(e.mindelay));
-		v.push_back(columns[10] + " = " + std::to_string(e.despawn));
-		v.push_back(columns[11] + " = " + std::to_string(e.despawn_timer));
-		v.push_back(columns[12] + " = " + std::to_string(e.wp_spawns));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.spawn_limit)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.dist)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.max_x)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.min_x)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.max_y)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.min_y)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.delay)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.mindelay)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.despawn)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.despawn_timer)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.wp_spawns)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -387,6 +417,68 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Spawngroup FromStmtRow(const mysql::StmtRow &row)
+	{
+		Spawngroup e{};
+
+		e.id            = row.Get<int32_t>(0).value_or(0);
+		e.name          = row.GetStr(1).value_or("");
+		e.spawn_limit   = row.Get<int8_t>(2).value_or(0);
+		e.dist          = row.Get<float>(3).value_or(0);
+		e.max_x         = row.Get<float>(4).value_or(0);
+		e.min_x         = row.Get<float>(5).value_or(0);
+		e.max_y         = row.Get<float>(6).value_or(0);
+		e.min_y         = row.Get<float>(7).value_or(0);
+		e.delay         = row.Get<int32_t>(8).value_or(45000);
+		e.mindelay      = row.Get<int32_t>(9).value_or(15000);
+		e.despawn       = row.Get<int8_t>(10).value_or(0);
+		e.despawn_timer = row.Get<int32_t>(11).value_or(100);
+		e.wp_spawns     = row.Get<uint8_t>(12).value_or(0);
+
+		return e;
+	}
+
+	static Spawngroup FindOnePrepared(
+		Database& db,
+		int spawngroup_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spawngroup_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Spawngroup> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Spawngroup> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -486,7 +578,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<13> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -506,13 +606,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
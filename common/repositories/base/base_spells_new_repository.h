@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseSpellsNewRepository {
@@ -256,6 +258,9 @@ public:
 		int32_t     field234;
 		int32_t     field235;
 		int32_t     field236;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<237> changed_columns = std::bitset<237>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -1320,6 +1325,251 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		SpellsNew &e,
+		const SpellsNew &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.player_1 != original.player_1;
+		e.changed_columns[3] = e.teleport_zone != original.teleport_zone;
+		e.changed_columns[4] = e.you_cast != original.you_cast;
+		e.changed_columns[5] = e.other_casts != original.other_casts;
+		e.changed_columns[6] = e.cast_on_you != original.cast_on_you;
+		e.changed_columns[7] = e.cast_on_other != original.cast_on_other;
+		e.changed_columns[8] = e.spell_fades != original.spell_fades;
+		e.changed_columns[9] = e.range_ != original.range_;
+		e.changed_columns[10] = e.aoerange != original.aoerange;
+		e.changed_columns[11] = e.pushback != original.pushback;
+		e.changed_columns[12] = e.pushup != original.pushup;
+		e.changed_columns[13] = e.cast_time != original.cast_time;
+		e.changed_columns[14] = e.recovery_time != original.recovery_time;
+		e.changed_columns[15] = e.recast_time != original.recast_time;
+		e.changed_columns[16] = e.buffdurationformula != original.buffdurationformula;
+		e.changed_columns[17] = e.buffduration != original.buffduration;
+		e.changed_columns[18] = e.AEDuration != original.AEDuration;
+		e.changed_columns[19] = e.mana != original.mana;
+		e.changed_columns[20] = e.effect_base_value1 != original.effect_base_value1;
+		e.changed_columns[21] = e.effect_base_value2 != original.effect_base_value2;
+		e.changed_columns[22] = e.effect_base_value3 != original.effect_base_value3;
+		e.changed_columns[23] = e.effect_base_value4 != original.effect_base_value4;
+		e.changed_columns[24] = e.effect_base_value5 != original.effect_base_value5;
+		e.changed_columns[25] = e.effect_base_value6 != original.effect_base_value6;
+		e.changed_columns[26] = e.effect_base_value7 != original.effect_base_value7;
+		e.changed_columns[27] = e.effect_base_value8 != original.effect_base_value8;
+		e.changed_columns[28] = e.effect_base_value9 != original.effect_base_value9;
+		e.changed_columns[29] = e.effect_base_value10 != original.effect_base_value10;
+		e.changed_columns[30] = e.effect_base_value11 != original.effect_base_value11;
+		e.changed_columns[31] = e.effect_base_value12 != original.effect_base_value12;
+		e.changed_columns[32] = e.effect_limit_value1 != original.effect_limit_value1;
+		e.changed_columns[33] = e.effect_limit_value2 != original.effect_limit_value2;
+		e.changed_columns[34] = e.effect_limit_value3 != original.effect_limit_value3;
+		e.changed_columns[35] = e.effect_limit_value4 != original.effect_limit_value4;
+		e.changed_columns[36] = e.effect_limit_value5 != original.effect_limit_value5;
+		e.changed_columns[37] = e.effect_limit_value6 != original.effect_limit_value6;
+		e.changed_columns[38] = e.effect_limit_value7 != original.effect_limit_value7;
+		e.changed_columns[39] = e.effect_limit_value8 != original.effect_limit_value8;
+		e.changed_columns[40] = e.effect_limit_value9 != original.effect_limit_value9;
+		e.changed_columns[41] = e.effect_limit_value10 != original.effect_limit_value10;
+		e.changed_columns[42] = e.effect_limit_value11 != original.effect_limit_value11;
+		e.changed_columns[43] = e.effect_limit_value12 != original.effect_limit_value12;
+		e.changed_columns[44] = e.max1 != original.max1;
+		e.changed_columns[45] = e.max2 != original.max2;
+		e.changed_columns[46] = e.max3 != original.max3;
+		e.changed_columns[47] = e.max4 != original.max4;
+		e.changed_columns[48] = e.max5 != original.max5;
+		e.changed_columns[49] = e.max6 != original.max6;
+		e.changed_columns[50] = e.max7 != original.max7;
+		e.changed_columns[51] = e.max8 != original.max8;
+		e.changed_columns[52] = e.max9 != original.max9;
+		e.changed_columns[53] = e.max10 != original.max10;
+		e.changed_columns[54] = e.max11 != original.max11;
+		e.changed_columns[55] = e.max12 != original.max12;
+		e.changed_columns[56] = e.icon != original.icon;
+		e.changed_columns[57] = e.memicon != original.memicon;
+		e.changed_columns[58] = e.components1 != original.components1;
+		e.changed_columns[59] = e.components2 != original.components2;
+		e.changed_columns[60] = e.components3 != original.components3;
+		e.changed_columns[61] = e.components4 != original.components4;
+		e.changed_columns[62] = e.component_counts1 != original.component_counts1;
+		e.changed_columns[63] = e.component_counts2 != original.component_counts2;
+		e.changed_columns[64] = e.component_counts3 != original.component_counts3;
+		e.changed_columns[65] = e.component_counts4 != original.component_counts4;
+		e.changed_columns[66] = e.NoexpendReagent1 != original.NoexpendReagent1;
+		e.changed_columns[67] = e.NoexpendReagent2 != original.NoexpendReagent2;
+		e.changed_columns[68] = e.NoexpendReagent3 != original.NoexpendReagent3;
+		e.changed_columns[69] = e.NoexpendReagent4 != original.NoexpendReagent4;
+		e.changed_columns[70] = e.formula1 != original.formula1;
+		e.changed_columns[71] = e.formula2 != original.formula2;
+		e.changed_columns[72] = e.formula3 != original.formula3;
+		e.changed_columns[73] = e.formula4 != original.formula4;
+		e.changed_columns[74] = e.formula5 != original.formula5;
+		e.changed_columns[75] = e.formula6 != original.formula6;
+		e.changed_columns[76] = e.formula7 != original.formula7;
+		e.changed_columns[77] = e.formula8 != original.formula8;
+		e.changed_columns[78] = e.formula9 != original.formula9;
+		e.changed_columns[79] = e.formula10 != original.formula10;
+		e.changed_columns[80] = e.formula11 != original.formula11;
+		e.changed_columns[81] = e.formula12 != original.formula12;
+		e.changed_columns[82] = e.LightType != original.LightType;
+		e.changed_columns[83] = e.goodEffect != original.goodEffect;
+		e.changed_columns[84] = e.Activated != original.Activated;
+		e.changed_columns[85] = e.resisttype != original.resisttype;
+		e.changed_columns[86] = e.effectid1 != original.effectid1;
+		e.changed_columns[87] = e.effectid2 != original.effectid2;
+		e.changed_columns[88] = e.effectid3 != original.effectid3;
+		e.changed_columns[89] = e.effectid4 != original.effectid4;
+		e.changed_columns[90] = e.effectid5 != original.effectid5;
+		e.changed_columns[91] = e.effectid6 != original.effectid6;
+		e.changed_columns[92] = e.effectid7 != original.effectid7;
+		e.changed_columns[93] = e.effectid8 != original.effectid8;
+		e.changed_columns[94] = e.effectid9 != original.effectid9;
+		e.changed_columns[95] = e.effectid10 != original.effectid10;
+		e.changed_columns[96] = e.effectid11 != original.effectid11;
+		e.changed_columns[97] = e.effectid12 != original.effectid12;
+		e.changed_columns[98] = e.targettype != original.targettype;
+		e.changed_columns[99] = e.basediff != original.basediff;
+		e.changed_columns[100] = e.skill != original.skill;
+		e.changed_columns[101] = e.zonetype != original.zonetype;
+		e.changed_columns[102] = e.EnvironmentType != original.EnvironmentType;
+		e.changed_columns[103] = e.TimeOfDay != original.TimeOfDay;
+		e.changed_columns[104] = e.classes1 != original.classes1;
+		e.changed_columns[105] = e.classes2 != original.classes2;
+		e.changed_columns[106] = e.classes3 != original.classes3;
+		e.changed_columns[107] = e.classes4 != original.classes4;
+		e.changed_columns[108] = e.classes5 != original.classes5;
+		e.changed_columns[109] = e.classes6 != original.classes6;
+		e.changed_columns[110] = e.classes7 != original.classes7;
+		e.changed_columns[111] = e.classes8 != original.classes8;
+		e.changed_columns[112] = e.classes9 != original.classes9;
+		e.changed_columns[113] = e.classes10 != original.classes10;
+		e.changed_columns[114] = e.classes11 != original.classes11;
+		e.changed_columns[115] = e.classes12 != original.classes12;
+		e.changed_columns[116] = e.classes13 != original.classes13;
+		e.changed_columns[117] = e.classes14 != original.classes14;
+		e.changed_columns[118] = e.classes15 != original.classes15;
+		e.changed_columns[119] = e.classes16 != original.classes16;
+		e.changed_columns[120] = e.CastingAnim != original.CastingAnim;
+		e.changed_columns[121] = e.TargetAnim != original.TargetAnim;
+		e.changed_columns[122] = e.TravelType != original.TravelType;
+		e.changed_columns[123] = e.SpellAffectIndex != original.SpellAffectIndex;
+		e.changed_columns[124] = e.disallow_sit != original.disallow_sit;
+		e.changed_columns[125] = e.deities0 != original.deities0;
+		e.changed_columns[126] = e.deities1 != original.deities1;
+		e.changed_columns[127] = e.deities2 != original.deities2;
+		e.changed_columns[128] = e.deities3 != original.deities3;
+		e.changed_columns[129] = e.deities4 != original.deities4;
+		e.changed_columns[130] = e.deities5 != original.deities5;
+		e.changed_columns[131] = e.deities6 != original.deities6;
+		e.changed_columns[132] = e.deities7 != original.deities7;
+		e.changed_columns[133] = e.deities8 != original.deities8;
+		e.changed_columns[134] = e.deities9 != original.deities9;
+		e.changed_columns[135] = e.deities10 != original.deities10;
+		e.changed_columns[136] = e.deities11 != original.deities11;
+		e.changed_columns[137] = e.deities12 != original.deities12;
+		e.changed_columns[138] = e.deities13 != original.deities13;
+		e.changed_columns[139] = e.deities14 != original.deities14;
+		e.changed_columns[140] = e.deities15 != original.deities15;
+		e.changed_columns[141] = e.deities16 != original.deities16;
+		e.changed_columns[142] = e.field142 != original.field142;
+		e.changed_columns[143] = e.field143 != original.field143;
+		e.changed_columns[144] = e.new_icon != original.new_icon;
+		e.changed_columns[145] = e.spellanim != original.spellanim;
+		e.changed_columns[146] = e.uninterruptable != original.uninterruptable;
+		e.changed_columns[147] = e.ResistDiff != original.ResistDiff;
+		e.changed_columns[148] = e.dot_stacking_exempt != original.dot_stacking_exempt;
+		e.changed_columns[149] = e.deleteable != original.deleteable;
+		e.changed_columns[150] = e.RecourseLink != original.RecourseLink;
+		e.changed_columns[151] = e.no_partial_resist != original.no_partial_resist;
+		e.changed_columns[152] = e.field152 != original.field152;
+		e.changed_columns[153] = e.field153 != original.field153;
+		e.changed_columns[154] = e.short_buff_box != original.short_buff_box;
+		e.changed_columns[155] = e.descnum != original.descnum;
+		e.changed_columns[156] = e.typedescnum != original.typedescnum;
+		e.changed_columns[157] = e.effectdescnum != original.effectdescnum;
+		e.changed_columns[158] = e.effectdescnum2 != original.effectdescnum2;
+		e.changed_columns[159] = e.npc_no_los != original.npc_no_los;
+		e.changed_columns[160] = e.field160 != original.field160;
+		e.changed_columns[161] = e.reflectable != original.reflectable;
+		e.changed_columns[162] = e.bonushate != original.bonushate;
+		e.changed_columns[163] = e.field163 != original.field163;
+		e.changed_columns[164] = e.field164 != original.field164;
+		e.changed_columns[165] = e.ldon_trap != original.ldon_trap;
+		e.changed_columns[166] = e.EndurCost != original.EndurCost;
+		e.changed_columns[167] = e.EndurTimerIndex != original.EndurTimerIndex;
+		e.changed_columns[168] = e.IsDiscipline != original.IsDiscipline;
+		e.changed_columns[169] = e.field169 != original.field169;
+		e.changed_columns[170] = e.field170 != original.field170;
+		e.changed_columns[171] = e.field171 != original.field171;
+		e.changed_columns[172] = e.field172 != original.field172;
+		e.changed_columns[173] = e.HateAdded != original.HateAdded;
+		e.changed_columns[174] = e.EndurUpkeep != original.EndurUpkeep;
+		e.changed_columns[175] = e.numhitstype != original.numhitstype;
+		e.changed_columns[176] = e.numhits != original.numhits;
+		e.changed_columns[177] = e.pvpresistbase != original.pvpresistbase;
+		e.changed_columns[178] = e.pvpresistcalc != original.pvpresistcalc;
+		e.changed_columns[179] = e.pvpresistcap != original.pvpresistcap;
+		e.changed_columns[180] = e.spell_category != original.spell_category;
+		e.changed_columns[181] = e.pvp_duration != original.pvp_duration;
+		e.changed_columns[182] = e.pvp_duration_cap != original.pvp_duration_cap;
+		e.changed_columns[183] = e.pcnpc_only_flag != original.pcnpc_only_flag;
+		e.changed_columns[184] = e.cast_not_standing != original.cast_not_standing;
+		e.changed_columns[185] = e.can_mgb != original.can_mgb;
+		e.changed_columns[186] = e.nodispell != original.nodispell;
+		e.changed_columns[187] = e.npc_category != original.npc_category;
+		e.changed_columns[188] = e.npc_usefulness != original.npc_usefulness;
+		e.changed_columns[189] = e.MinResist != original.MinResist;
+		e.changed_columns[190] = e.MaxResist != original.MaxResist;
+		e.changed_columns[191] = e.viral_targets != original.viral_targets;
+		e.changed_columns[192] = e.viral_timer != original.viral_timer;
+		e.changed_columns[193] = e.nimbuseffect != original.nimbuseffect;
+		e.changed_columns[194] = e.ConeStartAngle != original.ConeStartAngle;
+		e.changed_columns[195] = e.ConeStopAngle != original.ConeStopAngle;
+		e.changed_columns[196] = e.sneaking != original.sneaking;
+		e.changed_columns[197] = e.not_extendable != original.not_extendable;
+		e.changed_columns[198] = e.field198 != original.field198;
+		e.changed_columns[199] = e.field199 != original.field199;
+		e.changed_columns[200] = e.suspendable != original.suspendable;
+		e.changed_columns[201] = e.viral_range != original.viral_range;
+		e.changed_columns[202] = e.songcap != original.songcap;
+		e.changed_columns[203] = e.field203 != original.field203;
+		e.changed_columns[204] = e.field204 != original.field204;
+		e.changed_columns[205] = e.no_block != original.no_block;
+		e.changed_columns[206] = e.field206 != original.field206;
+		e.changed_columns[207] = e.spellgroup != original.spellgroup;
+		e.changed_columns[208] = e.rank_ != original.rank_;
+		e.changed_columns[209] = e.field209 != original.field209;
+		e.changed_columns[210] = e.field210 != original.field210;
+		e.changed_columns[211] = e.CastRestriction != original.CastRestriction;
+		e.changed_columns[212] = e.allowrest != original.allowrest;
+		e.changed_columns[213] = e.InCombat != original.InCombat;
+		e.changed_columns[214] = e.OutofCombat != original.OutofCombat;
+		e.changed_columns[215] = e.field215 != original.field215;
+		e.changed_columns[216] = e.field216 != original.field216;
+		e.changed_columns[217] = e.field217 != original.field217;
+		e.changed_columns[218] = e.aemaxtargets != original.aemaxtargets;
+		e.changed_columns[219] = e.maxtargets != original.maxtargets;
+		e.changed_columns[220] = e.field220 != original.field220;
+		e.changed_columns[221] = e.field221 != original.field221;
+		e.changed_columns[222] = e.field222 != original.field222;
+		e.changed_columns[223] = e.field223 != original.field223;
+		e.changed_columns[224] = e.persistdeath != original.persistdeath;
+		e.changed_columns[225] = e.field225 != original.field225;
+		e.changed_columns[226] = e.field226 != original.field226;
+		e.changed_columns[227] = e.min_dist != original.min_dist;
+		e.changed_columns[228] = e.min_dist_mod != original.min_dist_mod;
+		e.changed_columns[229] = e.max_dist != original.max_dist;
+		e.changed_columns[230] = e.max_dist_mod != original.max_dist_mod;
+		e.changed_columns[231] = e.min_range != original.min_range;
+		e.changed_columns[232] = e.field232 != original.field232;
+		e.changed_columns[233] = e.field233 != original.field233;
+		e.changed_columns[234] = e.field234 != original.field234;
+		e.changed_columns[235] = e.field235 != original.field235;
+		e.changed_columns[236] = e.field236 != original.field236;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const SpellsNew &e
@@ -1329,243 +1579,247 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.player_1) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.teleport_zone) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.you_cast) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.other_casts) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.cast_on_you) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.cast_on_other) + "'");
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.spell_fades) + "'");
-		v.push_back(columns[9] + " = " + std::to_string(e.range_));
-		v.push_back(columns[10] + " = " + std::to_string(e.aoerange));
-		v.push_back(columns[11] + " = " + std::to_string(e.pushback));
-		v.push_back(columns[12] + " = " + std::to_string(e.pushup));
-		v.push_back(columns[13] + " = " + std::to_string(e.cast_time));
-		v.push_back(columns[14] + " = " + std::to_string(e.recovery_time));
-		v.push_back(columns[15] + " = " + std::to_string(e.recast_time));
-		v.push_back(columns[16] + " = " + std::to_string(e.buffdurationformula));
-		v.push_back(columns[17] + " = " + std::to_string(e.buffduration));
-		v.push_back(columns[18] + " = " + std::to_string(e.AEDuration));
-		v.push_back(columns[19] + " = " + std::to_string(e.mana));
-		v.push_back(columns[20] + " = " + std::to_string(e.effect_base_value1));
-		v.push_back(columns[21] + " = " + std::to_string(e.effect_base_value2));
-		v.push_back(columns[22] + " = " + std::to_string(e.effect_base_value3));
-		v.push_back(columns[23] + " = " + std::to_string(e.effect_base_value4));
-		v.push_back(columns[24] + " = " + std::to_string(e.effect_base_value5));
-		v.push_back(columns[25] + " = " + std::to_string(e.effect_base_value6));
-		v.push_back(columns[26] + " = " + std::to_string(e.effect_base_value7));
-		v.push_back(columns[27] + " = " + std::to_string(e.effect_base_value8));
-		v.push_back(columns[28] + " = " + std::to_string(e.effect_base_value9));
-		v.push_back(columns[29] + " = " + std::to_string(e.effect_base_value10));
-		v.push_back(columns[30] + " = " + std::to_string(e.effect_base_value11));
-		v.push_back(columns[31] + " = " + std::to_string(e.effect_base_value12));
-		v.push_back(columns[32] + " = " + std::to_string(e.effect_limit_value1));
-		v.push_back(columns[33] + " = " + std::to_string(e.effect_limit_value2));
-		v.push_back(columns[34] + " = " + std::to_string(e.effect_limit_value3));
-		v.push_back(columns[35] + " = " + std::to_string(e.effect_limit_value4));
-		v.push_back(columns[36] + " = " + std::to_string(e.effect_limit_value5));
-		v.push_back(columns[37] + " = " + std::to_string(e.effect_limit_value6));
-		v.push_back(columns[38] + " = " + std::to_string(e.effect_limit_value7));
-		v.push_back(columns[39] + " = " + std::to_string(e.effect_limit_value8));
-		v.push_back(columns[40] + " = " + std::to_string(e.effect_limit_value9));
-		v.push_back(columns[41] + " = " + std::to_string(e.effect_limit_value10));
-		v.push_back(columns[42] + " = " + std::to_string(e.effect_limit_value11));
-		v.push_back(columns[43] + " = " + std::to_string(e.effect_limit_value12));
-		v.push_back(columns[44] + " = " + std::to_string(e.max1));
-		v.push_back(columns[45] + " = " + std::to_string(e.max2));
-		v.push_back(columns[46] + " = " + std::to_string(e.max3));
-		v.push_back(columns[47] + " = " + std::to_string(e.max4));
-		v.push_back(columns[48] + " = " + std::to_string(e.max5));
-		v.push_back(columns[49] + " = " + std::to_string(e.max6));
-		v.push_back(columns[50] + " = " + std::to_string(e.max7));
-		v.push_back(columns[51] + " = " + std::to_string(e.max8));
-		v.push_back(columns[52] + " = " + std::to_string(e.max9));
-		v.push_back(columns[53] + " = " + std::to_string(e.max10));
-		v.push_back(columns[54] + " = " + std::to_string(e.max11));
-		v.push_back(columns[55] + " = " + std::to_string(e.max12));
-		v.push_back(columns[56] + " = " + std::to_string(e.icon));
-		v.push_back(columns[57] + " = " + std::to_string(e.memicon));
-		v.push_back(columns[58] + " = " + std::to_string(e.components1));
-		v.push_back(columns[59] + " = " + std::to_string(e.components2));
-		v.push_back(columns[60] + " = " + std::to_string(e.components3));
-		v.push_back(columns[61] + " = " + std::to_string(e.components4));
-		v.push_back(columns[62] + " = " + std::to_string(e.component_counts1));
-		v.push_back(columns[63] + " = " + std::to_string(e.component_counts2));
-		v.push_back(columns[64] + " = " + std::to_string(e.component_counts3));
-		v.push_back(columns[65] + " = " + std::to_string(e.component_counts4));
-		v.push_back(columns[66] + " = " + std::to_string(e.NoexpendReagent1));
-		v.push_back(columns[67] + " = " + std::to_string(e.NoexpendReagent2));
-		v.push_back(columns[68] + " = " + std::to_string(e.NoexpendReagent3));
-		v.push_back(columns[69] + " = " + std::to_string(e.NoexpendReagent4));
-		v.push_back(columns[70] + " = " + std::to_string(e.formula1));
-		v.push_back(columns[71] + " = " + std::to_string(e.formula2));
-		v.push_back(columns[72] + " = " + std::to_string(e.formula3));
-		v.push_back(columns[73] + " = " + std::to_string(e.formula4));
-		v.push_back(columns[74] + " = " + std::to_string(e.formula5));
-		v.push_back(columns[75] + " = " + std::to_string(e.formula6));
-		v.push_back(columns[76] + " = " + std::to_string(e.formula7));
-		v.push_back(columns[77] + " = " + std::to_string(e.formula8));
-		v.push_back(columns[78] + " = " + std::to_string(e.formula9));
-		v.push_back(columns[79] + " = " + std::to_string(e.formula10));
-		v.push_back(columns[80] + " = " + std::to_string(e.formula11));
-		v.push_back(columns[81] + " = " + std::to_string(e.formula12));
-		v.push_back(columns[82] + " = " + std::to_string(e.LightType));
-		v.push_back(columns[83] + " = " + std::to_string(e.goodEffect));
-		v.push_back(columns[84] + " = " + std::to_string(e.Activated));
-		v.push_back(columns[85] + " = " + std::to_string(e.resisttype));
-		v.push_back(columns[86] + " = " + std::to_string(e.effectid1));
-		v.push_back(columns[87] + " = " + std::to_string(e.effectid2));
-		v.push_back(columns[88] + " = " + std::to_string(e.effectid3));
-		v.push_back(columns[89] + " = " + std::to_string(e.effectid4));
-		v.push_back(columns[90] + " = " + std::to_string(e.effectid5));
-		v.push_back(columns[91] + " = " + std::to_string(e.effectid6));
-		v.push_back(columns[92] + " = " + std::to_string(e.effectid7));
-		v.push_back(columns[93] + " = " + std::to_string(e.effectid8));
-		v.push_back(columns[94] + " = " + std::to_string(e.effectid9));
-		v.push_back(columns[95] + " = " + std::to_string(e.effectid10));
-		v.push_back(columns[96] + " = " + std::to_string(e.effectid11));
-		v.push_back(columns[97] + " = " + std::to_string(e.effectid12));
-		v.push_back(columns[98] + " = " + std::to_string(e.targettype));
-		v.push_back(columns[99] + " = " + std::to_string(e.basediff));
-		v.push_back(columns[100] + " = " + std::to_string(e.skill));
-		v.push_back(columns[101] + " = " + std::to_string(e.zonetype));
-		v.push_back(columns[102] + " = " + std::to_string(e.EnvironmentType));
-		v.push_back(columns[103] + " = " + std::to_string(e.TimeOfDay));
-		v.push_back(columns[104] + " = " + std::to_string(e.classes1));
-		v.push_back(columns[105] + " = " + std::to_string(e.classes2));
-		v.push_back(columns[106] + " = " + std::to_string(e.classes3));
-		v.push_back(columns[107] + " = " + std::to_string(e.classes4));
-		v.push_back(columns[108] + " = " + std::to_string(e.classes5));
-		v.push_back(columns[109] + " = " + std::to_string(e.classes6));
-		v.push_back(columns[110] + " = " + std::to_string(e.classes7));
-		v.push_back(columns[111] + " = " + std::to_string(e.classes8));
-		v.push_back(columns[112] + " = " + std::to_string(e.classes9));
-		v.push_back(columns[113] + " = " + std::to_string(e.classes10));
-		v.push_back(columns[114] + " = " + std::to_string(e.classes11));
-		v.push_back(columns[115] + " = " + std::to_string(e.classes12));
-		v.push_back(columns[116] + " = " + std::to_string(e.classes13));
-		v.push_back(columns[117] + " = " + std::to_string(e.classes14));
-		v.push_back(columns[118] + " = " + std::to_string(e.classes15));
-		v.push_back(columns[119] + " = " + std::to_string(e.classes16));
-		v.push_back(columns[120] + " = " + std::to_string(e.CastingAnim));
-		v.push_back(columns[121] + " = " + std::to_string(e.TargetAnim));
-		v.push_back(columns[122] + " = " + std::to_string(e.TravelType));
-		v.push_back(columns[123] + " = " + std::to_string(e.SpellAffectIndex));
-		v.push_back(columns[124] + " = " + std::to_string(e.disallow_sit));
-		v.push_back(columns[125] + " = " + std::to_string(e.deities0));
-		v.push_back(columns[126] + " = " + std::to_string(e.deities1));
-		v.push_back(columns[127] + " = " + std::to_string(e.deities2));
-		v.push_back(columns[128] + " = " + std::to_string(e.deities3));
-		v.push_back(columns[129] + " = " + std::to_string(e.deities4));
-		v.push_back(columns[130] + " = " + std::to_string(e.deities5));
-		v.push_back(columns[131] + " = " + std::to_string(e.deities6));
-		v.push_back(columns[132] + " = " + std::to_string(e.deities7));
-		v.push_back(columns[133] + " = " + std::to_string(e.deities8));
-		v.push_back(columns[134] + " = " + std::to_string(e.deities9));
-		v.push_back(columns[135] + " = " + std::to_string(e.deities10));
-		v.push_back(columns[136] + " = " + std::to_string(e.deities11));
-		v.push_back(columns[137] + " = " + std::to_string(e.deities12));
-		v.push_back(columns[138] + " = " + std::to_string(e.deities13));
-		v.push_back(columns[139] + " = " + std::to_string(e.deities14));
-		v.push_back(columns[140] + " = " + std::to_string(e.deities15));
-		v.push_back(columns[141] + " = " + std::to_string(e.deities16));
-		v.push_back(columns[142] + " = " + std::to_string(e.field142));
-		v.push_back(columns[143] + " = " + std::to_string(e.field143));
-		v.push_back(columns[144] + " = " + std::to_string(e.new_icon));
-		v.push_back(columns[145] + " = " + std::to_string(e.spellanim));
-		v.push_back(columns[146] + " = " + std::to_string(e.uninterruptable));
-		v.push_back(columns[147] + " = " + std::to_string(e.ResistDiff));
-		v.push_back(columns[148] + " = " + std::to_string(e.dot_stacking_exempt));
-		v.push_back(columns[149] + " = " + std::to_string(e.deleteable));
-		v.push_back(columns[150] + " = " + std::to_string(e.RecourseLink));
-		v.push_back(columns[151] + " = " + std::to_string(e.no_partial_resist));
-		v.push_back(columns[152] + " = " + std::to_string(e.field152));
-		v.push_back(columns[153] + " = " + std::to_string(e.field153));
-		v.push_back(columns[154] + " = " + std::to_string(e.short_buff_box));
-		v.push_back(columns[155] + " = " + std::to_string(e.descnum));
-		v.push_back(columns[156] + " = " + std::to_string(e.typedescnum));
-		v.push_back(columns[157] + " = " + std::to_string(e.effectdescnum));
-		v.push_back(columns[158] + " = " + std::to_string(e.effectdescnum2));
-		v.push_back(columns[159] + " = " + std::to_string(e.npc_no_los));
-		v.push_back(columns[160] + " = " + std::to_string(e.field160));
-		v.push_back(columns[161] + " = " + std::to_string(e.reflectable));
-		v.push_back(columns[162] + " = " + std::to_string(e.bonushate));
-		v.push_back(columns[163] + " = " + std::to_string(e.field163));
-		v.push_back(columns[164] + " = " + std::to_string(e.field164));
-		v.push_back(columns[165] + " = " + std::to_string(e.ldon_trap));
-		v.push_back(columns[166] + " = " + std::to_string(e.EndurCost));
-		v.push_back(columns[167] + " = " + std::to_string(e.EndurTimerIndex));
-		v.push_back(columns[168] + " = " + std::to_string(e.IsDiscipline));
-		v.push_back(columns[169] + " = " + std::to_string(e.field169));
-		v.push_back(columns[170] + " = " + std::to_string(e.field170));
-		v.push_back(columns[171] + " = " + std::to_string(e.field171));
-		v.push_back(columns[172] + " = " + std::to_string(e.field172));
-		v.push_back(columns[173] + " = " + std::to_string(e.HateAdded));
-		v.push_back(columns[174] + " = " + std::to_string(e.EndurUpkeep));
-		v.push_back(columns[175] + " = " + std::to_string(e.numhitstype));
-		v.push_back(columns[176] + " = " + std::to_string(e.numhits));
-		v.push_back(columns[177] + " = " + std::to_string(e.pvpresistbase));
-		v.push_back(columns[178] + " = " + std::to_string(e.pvpresistcalc));
-		v.push_back(columns[179] + " = " + std::to_string(e.pvpresistcap));
-		v.push_back(columns[180] + " = " + std::to_string(e.spell_category));
-		v.push_back(columns[181] + " = " + std::to_string(e.pvp_duration));
-		v.push_back(columns[182] + " = " + std::to_string(e.pvp_duration_cap));
-		v.push_back(columns[183] + " = " + std::to_string(e.pcnpc_only_flag));
-		v.push_back(columns[184] + " = " + std::to_string(e.cast_not_standing));
-		v.push_back(columns[185] + " = " + std::to_string(e.can_mgb));
-		v.push_back(columns[186] + " = " + std::to_string(e.nodispell));
-		v.push_back(columns[187] + " = " + std::to_string(e.npc_category));
-		v.push_back(columns[188] + " = " + std::to_string(e.npc_usefulness));
-		v.push_back(columns[189] + " = " + std::to_string(e.MinResist));
-		v.push_back(columns[190] + " = " + std::to_string(e.MaxResist));
-		v.push_back(columns[191] + " = " + std::to_string(e.viral_targets));
-		v.push_back(columns[192] + " = " + std::to_string(e.viral_timer));
-		v.push_back(columns[193] + " = " + std::to_string(e.nimbuseffect));
-		v.push_back(columns[194] + " = " + std::to_string(e.ConeStartAngle));
-		v.push_back(columns[195] + " = " + std::to_string(e.ConeStopAngle));
-		v.push_back(columns[196] + " = " + std::to_string(e.sneaking));
-		v.push_back(columns[197] + " = " + std::to_string(e.not_extendable));
-		v.push_back(columns[198] + " = " + std::to_string(e.field198));
-		v.push_back(columns[199] + " = " + std::to_string(e.field199));
-		v.push_back(columns[200] + " = " + std::to_string(e.suspendable));
-		v.push_back(columns[201] + " = " + std::to_string(e.viral_range));
-		v.push_back(columns[202] + " = " + std::to_string(e.songcap));
-		v.push_back(columns[203] + " = " + std::to_string(e.field203));
-		v.push_back(columns[204] + " = " + std::to_string(e.field204));
-		v.push_back(columns[205] + " = " + std::to_string(e.no_block));
-		v.push_back(columns[206] + " = " + std::to_string(e.field206));
-		v.push_back(columns[207] + " = " + std::to_string(e.spellgroup));
-		v.push_back(columns[208] + " = " + std::to_string(e.rank_));
-		v.push_back(columns[209] + " = " + std::to_string(e.field209));
-		v.push_back(columns[210] + " = " + std::to_string(e.field210));
-		v.push_back(columns[211] + " = " + std::to_string(e.CastRestriction));
-		v.push_back(columns[212] + " = " + std::to_string(e.allowrest));
-		v.push_back(columns[213] + " = " + std::to_string(e.InCombat));
-		v.push_back(columns[214] + " = " + std::to_string(e.OutofCombat));
-		v.push_back(columns[215] + " = " + std::to_string(e.field215));
-		v.push_back(columns[216] + " = " + std::to_string(e.field216));
-		v.push_back(columns[217] + " = " + std::to_string(e.field217));
-		v.push_back(columns[218] + " = " + std::to_string(e.aemaxtargets));
-		v.push_back(columns[219] + " = " + std::to_string(e.maxtargets));
-		v.push_back(columns[220] + " = " + std::to_string(e.field220));
-		v.push_back(columns[221] + " = " + std::to_string(e.field221));
-		v.push_back(columns[222] + " = " + std::to_string(e.field222));
-		v.push_back(columns[223] + " = " + std::to_string(e.field223));
-		v.push_back(columns[224] + " = " + std::to_string(e.persistdeath));
-		v.push_back(columns[225] + " = " + std::to_string(e.field225));
-		v.push_back(columns[226] + " = " + std::to_string(e.field226));
-		v.push_back(columns[227] + " = " + std::to_string(e.min_dist));
-		v.push_back(columns[228] + " = " + std::to_string(e.min_dist_mod));
-		v.push_back(columns[229] + " = " + std::to_string(e.max_dist));
-		v.push_back(columns[230] + " = " + std::to_string(e.max_dist_mod));
-		v.push_back(columns[231] + " = " + std::to_string(e.min_range));
-		v.push_back(columns[232] + " = " + std::to_string(e.field232));
-		v.push_back(columns[233] + " = " + std::to_string(e.field233));
-		v.push_back(columns[234] + " = " + std::to_string(e.field234));
-		v.push_back(columns[235] + " = " + std::to_string(e.field235));
-		v.push_back(columns[236] + " = " + std::to_string(e.field236));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.player_1) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.teleport_zone) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.you_cast) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.other_casts) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.cast_on_you) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.cast_on_other) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.spell_fades) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.range_)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.aoerange)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.pushback)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.pushup)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.cast_time)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.recovery_time)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.recast_time)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.buffdurationformula)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.buffduration)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.AEDuration)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.effect_base_value1)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.effect_base_value2)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.effect_base_value3)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.effect_base_value4)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.effect_base_value5)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.effect_base_value6)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.effect_base_value7)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.effect_base_value8)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.effect_base_value9)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.effect_base_value10)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.effect_base_value11)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.effect_base_value12)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.effect_limit_value1)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.effect_limit_value2)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.effect_limit_value3)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.effect_limit_value4)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.effect_limit_value5)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.effect_limit_value6)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.effect_limit_value7)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.effect_limit_value8)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.effect_limit_value9)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.effect_limit_value10)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.effect_limit_value11)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.effect_limit_value12)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.max1)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.max2)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.max3)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.max4)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.max5)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.max6)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.max7)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.max8)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.max9)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.max10)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.max11)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.max12)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.icon)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.memicon)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = " + std::to_string(e.components1)); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.components2)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.components3)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.components4)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.component_counts1)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.component_counts2)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.component_counts3)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.component_counts4)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.NoexpendReagent1)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.NoexpendReagent2)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.NoexpendReagent3)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.NoexpendReagent4)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.formula1)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = " + std::to_string(e.formula2)); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = " + std::to_string(e.formula3)); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = " + std::to_string(e.formula4)); }
+		if (e.changed_columns[74]) { v.push_back(columns[74] + " = " + std::to_string(e.formula5)); }
+		if (e.changed_columns[75]) { v.push_back(columns[75] + " = " + std::to_string(e.formula6)); }
+		if (e.changed_columns[76]) { v.push_back(columns[76] + " = " + std::to_string(e.formula7)); }
+		if (e.changed_columns[77]) { v.push_back(columns[77] + " = " + std::to_string(e.formula8)); }
+		if (e.changed_columns[78]) { v.push_back(columns[78] + " = " + std::to_string(e.formula9)); }
+		if (e.changed_columns[79]) { v.push_back(columns[79] + " = " + std::to_string(e.formula10)); }
+		if (e.changed_columns[80]) { v.push_back(columns[80] + " = " + std::to_string(e.formula11)); }
+		if (e.changed_columns[81]) { v.push_back(columns[81] + " = " + std::to_string(e.formula12)); }
+		if (e.changed_columns[82]) { v.push_back(columns[82] + " = " + std::to_string(e.LightType)); }
+		if (e.changed_columns[83]) { v.push_back(columns[83] + " = " + std::to_string(e.goodEffect)); }
+		if (e.changed_columns[84]) { v.push_back(columns[84] + " = " + std::to_string(e.Activated)); }
+		if (e.changed_columns[85]) { v.push_back(columns[85] + " = " + std::to_string(e.resisttype)); }
+		if (e.changed_columns[86]) { v.push_back(columns[86] + " = " + std::to_string(e.effectid1)); }
+		if (e.changed_columns[87]) { v.push_back(columns[87] + " = " + std::to_string(e.effectid2)); }
+		if (e.changed_columns[88]) { v.push_back(columns[88] + " = " + std::to_string(e.effectid3)); }
+		if (e.changed_columns[89]) { v.push_back(columns[89] + " = " + std::to_string(e.effectid4)); }
+		if (e.changed_columns[90]) { v.push_back(columns[90] + " = " + std::to_string(e.effectid5)); }
+		if (e.changed_columns[91]) { v.push_back(columns[91] + " = " + std::to_string(e.effectid6)); }
+		if (e.changed_columns[92]) { v.push_back(columns[92] + " = " + std::to_string(e.effectid7)); }
+		if (e.changed_columns[93]) { v.push_back(columns[93] + " = " + std::to_string(e.effectid8)); }
+		if (e.changed_columns[94]) { v.push_back(columns[94] + " = " + std::to_string(e.effectid9)); }
+		if (e.changed_columns[95]) { v.push_back(columns[95] + " = " + std::to_string(e.effectid10)); }
+		if (e.changed_columns[96]) { v.push_back(columns[96] + " = " + std::to_string(e.effectid11)); }
+		if (e.changed_columns[97]) { v.push_back(columns[97] + " = " + std::to_string(e.effectid12)); }
+		if (e.changed_columns[98]) { v.push_back(columns[98] + " = " + std::to_string(e.targettype)); }
+		if (e.changed_columns[99]) { v.push_back(columns[99] + " = " + std::to_string(e.basediff)); }
+		if (e.changed_columns[100]) { v.push_back(columns[100] + " = " + std::to_string(e.skill)); }
+		if (e.changed_columns[101]) { v.push_back(columns[101] + " = " + std::to_string(e.zonetype)); }
+		if (e.changed_columns[102]) { v.push_back(columns[102] + " = " + std::to_string(e.EnvironmentType)); }
+		if (e.changed_columns[103]) { v.push_back(columns[103] + " = " + std::to_string(e.TimeOfDay)); }
+		if (e.changed_columns[104]) { v.push_back(columns[104] + " = " + std::to_string(e.classes1)); }
+		if (e.changed_columns[105]) { v.push_back(columns[105] + " = " + std::to_string(e.classes2)); }
+		if (e.changed_columns[106]) { v.push_back(columns[106] + " = " + std::to_string(e.classes3)); }
+		if (e.changed_columns[107]) { v.push_back(columns[107] + " = " + std::to_string(e.classes4)); }
+		if (e.changed_columns[108]) { v.push_back(columns[108] + " = " + std::to_string(e.classes5)); }
+		if (e.changed_columns[109]) { v.push_back(columns[109] + " = " + std::to_string(e.classes6)); }
+		if (e.changed_columns[110]) { v.push_back(columns[110] + " = " + std::to_string(e.classes7)); }
+		if (e.changed_columns[111]) { v.push_back(columns[111] + " = " + std::to_string(e.classes8)); }
+		if (e.changed_columns[112]) { v.push_back(columns[112] + " = " + std::to_string(e.classes9)); }
+		if (e.changed_columns[113]) { v.push_back(columns[113] + " = " + std::to_string(e.classes10)); }
+		if (e.changed_columns[114]) { v.push_back(columns[114] + " = " + std::to_string(e.classes11)); }
+		if (e.changed_columns[115]) { v.push_back(columns[115] + " = " + std::to_string(e.classes12)); }
+		if (e.changed_columns[116]) { v.push_back(columns[116] + " = " + std::to_string(e.classes13)); }
+		if (e.changed_columns[117]) { v.push_back(columns[117] + " = " + std::to_string(e.classes14)); }
+		if (e.changed_columns[118]) { v.push_back(columns[118] + " = " + std::to_string(e.classes15)); }
+		if (e.changed_columns[119]) { v.push_back(columns[119] + " = " + std::to_string(e.classes16)); }
+		if (e.changed_columns[120]) { v.push_back(columns[120] + " = " + std::to_string(e.CastingAnim)); }
+		if (e.changed_columns[121]) { v.push_back(columns[121] + " = " + std::to_string(e.TargetAnim)); }
+		if (e.changed_columns[122]) { v.push_back(columns[122] + " = " + std::to_string(e.TravelType)); }
+		if (e.changed_columns[123]) { v.push_back(columns[123] + " = " + std::to_string(e.SpellAffectIndex)); }
+		if (e.changed_columns[124]) { v.push_back(columns[124] + " = " + std::to_string(e.disallow_sit)); }
+		if (e.changed_columns[125]) { v.push_back(columns[125] + " = " + std::to_string(e.deities0)); }
+		if (e.changed_columns[126]) { v.push_back(columns[126] + " = " + std::to_string(e.deities1)); }
+		if (e.changed_columns[127]) { v.push_back(columns[127] + " = " + std::to_string(e.deities2)); }
+		if (e.changed_columns[128]) { v.push_back(columns[128] + " = " + std::to_string(e.deities3)); }
+		if (e.changed_columns[129]) { v.push_back(columns[129] + " = " + std::to_string(e.deities4)); }
+		if (e.changed_columns[130]) { v.push_back(columns[130] + " = " + std::to_string(e.deities5)); }
+		if (e.changed_columns[131]) { v.push_back(columns[131] + " = " + std::to_string(e.deities6)); }
+		if (e.changed_columns[132]) { v.push_back(columns[132] + " = " + std::to_string(e.deities7)); }
+		if (e.changed_columns[133]) { v.push_back(columns[133] + " = " + std::to_string(e.deities8)); }
+		if (e.changed_columns[134]) { v.push_back(columns[134] + " = " + std::to_string(e.deities9)); }
+		if (e.changed_columns[135]) { v.push_back(columns[135] + " = " + std::to_string(e.deities10)); }
+		if (e.changed_columns[136]) { v.push_back(columns[136] + " = " + std::to_string(e.deities11)); }
+		if (e.changed_columns[137]) { v.push_back(columns[137] + " = " + std::to_string(e.deities12)); }
+		if (e.changed_columns[138]) { v.push_back(columns[138] + " = " + std::to_string(e.deities13)); }
+		if (e.changed_columns[139]) { v.push_back(columns[139] + " = " + std::to_string(e.deities14)); }
+		if (e.changed_columns[140]) { v.push_back(columns[140] + " = " + std::to_string(e.deities15)); }
+		if (e.changed_columns[141]) { v.push_back(columns[141] + " = " + std::to_string(e.deities16)); }
+		if (e.changed_columns[142]) { v.push_back(columns[142] + " = " + std::to_string(e.field142)); }
+		if (e.changed_columns[143]) { v.push_back(columns[143] + " = " + std::to_string(e.field143)); }
+		if (e.changed_columns[144]) { v.push_back(columns[144] + " = " + std::to_string(e.new_icon)); }
+		if (e.changed_columns[145]) { v.push_back(columns[145] + " = " + std::to_string(e.spellanim)); }
+		if (e.changed_columns[146]) { v.push_back(columns[146] + " = " + std::to_string(e.uninterruptable)); }
+		if (e.changed_columns[147]) { v.push_back(columns[147] + " = " + std::to_string(e.ResistDiff)); }
+		if (e.changed_columns[148]) { v.push_back(columns[148] + " = " + std::to_string(e.dot_stacking_exempt)); }
+		if (e.changed_columns[149]) { v.push_back(columns[149] + " = " + std::to_string(e.deleteable)); }
+		if (e.changed_columns[150]) { v.push_back(columns[150] + " = " + std::to_string(e.RecourseLink)); }
+		if (e.changed_columns[151]) { v.push_back(columns[151] + " = " + std::to_string(e.no_partial_resist)); }
+		if (e.changed_columns[152]) { v.push_back(columns[152] + " = " + std::to_string(e.field152)); }
+		if (e.changed_columns[153]) { v.push_back(columns[153] + " = " + std::to_string(e.field153)); }
+		if (e.changed_columns[154]) { v.push_back(columns[154] + " = " + std::to_string(e.short_buff_box)); }
+		if (e.changed_columns[155]) { v.push_back(columns[155] + " = " + std::to_string(e.descnum)); }
+		if (e.changed_columns[156]) { v.push_back(columns[156] + " = " + std::to_string(e.typedescnum)); }
+		if (e.changed_columns[157]) { v.push_back(columns[157] + " = " + std::to_string(e.effectdescnum)); }
+		if (e.changed_columns[158]) { v.push_back(columns[158] + " = " + std::to_string(e.effectdescnum2)); }
+		if (e.changed_columns[159]) { v.push_back(columns[159] + " = " + std::to_string(e.npc_no_los)); }
+		if (e.changed_columns[160]) { v.push_back(columns[160] + " = " + std::to_string(e.field160)); }
+		if (e.changed_columns[161]) { v.push_back(columns[161] + " = " + std::to_string(e.reflectable)); }
+		if (e.changed_columns[162]) { v.push_back(columns[162] + " = " + std::to_string(e.bonushate)); }
+		if (e.changed_columns[163]) { v.push_back(columns[163] + " = " + std::to_string(e.field163)); }
+		if (e.changed_columns[164]) { v.push_back(columns[164] + " = " + std::to_string(e.field164)); }
+		if (e.changed_columns[165]) { v.push_back(columns[165] + " = " + std::to_string(e.ldon_trap)); }
+		if (e.changed_columns[166]) { v.push_back(columns[166] + " = " + std::to_string(e.EndurCost)); }
+		if (e.changed_columns[167]) { v.push_back(columns[167] + " = " + std::to_string(e.EndurTimerIndex)); }
+		if (e.changed_columns[168]) { v.push_back(columns[168] + " = " + std::to_string(e.IsDiscipline)); }
+		if (e.changed_columns[169]) { v.push_back(columns[169] + " = " + std::to_string(e.field169)); }
+		if (e.changed_columns[170]) { v.push_back(columns[170] + " = " + std::to_string(e.field170)); }
+		if (e.changed_columns[171]) { v.push_back(columns[171] + " = " + std::to_string(e.field171)); }
+		if (e.changed_columns[172]) { v.push_back(columns[172] + " = " + std::to_string(e.field172)); }
+		if (e.changed_columns[173]) { v.push_back(columns[173] + " = " + std::to_string(e.HateAdded)); }
+		if (e.changed_columns[174]) { v.push_back(columns[174] + " = " + std::to_string(e.EndurUpkeep)); }
+		if (e.changed_columns[175]) { v.push_back(columns[175] + " = " + std::to_string(e.numhitstype)); }
+		if (e.changed_columns[176]) { v.push_back(columns[176] + " = " + std::to_string(e.numhits)); }
+		if (e.changed_columns[177]) { v.push_back(columns[177] + " = " + std::to_string(e.pvpresistbase)); }
+		if (e.changed_columns[178]) { v.push_back(columns[178] + " = " + std::to_string(e.pvpresistcalc)); }
+		if (e.changed_columns[179]) { v.push_back(columns[179] + " = " + std::to_string(e.pvpresistcap)); }
+		if (e.changed_columns[180]) { v.push_back(columns[180] + " = " + std::to_string(e.spell_category)); }
+		if (e.changed_columns[181]) { v.push_back(columns[181] + " = " + std::to_string(e.pvp_duration)); }
+		if (e.changed_columns[182]) { v.push_back(columns[182] + " = " + std::to_string(e.pvp_duration_cap)); }
+		if (e.changed_columns[183]) { v.push_back(columns[183] + " = " + std::to_string(e.pcnpc_only_flag)); }
+		if (e.changed_columns[184]) { v.push_back(columns[184] + " = " + std::to_string(e.cast_not_standing)); }
+		if (e.changed_columns[185]) { v.push_back(columns[185] + " = " + std::to_string(e.can_mgb)); }
+		if (e.changed_columns[186]) { v.push_back(columns[186] + " = " + std::to_string(e.nodispell)); }
+		if (e.changed_columns[187]) { v.push_back(columns[187] + " = " + std::to_string(e.npc_category)); }
+		if (e.changed_columns[188]) { v.push_back(columns[188] + " = " + std::to_string(e.npc_usefulness)); }
+		if (e.changed_columns[189]) { v.push_back(columns[189] + " = " + std::to_string(e.MinResist)); }
+		if (e.changed_columns[190]) { v.push_back(columns[190] + " = " + std::to_string(e.MaxResist)); }
+		if (e.changed_columns[191]) { v.push_back(columns[191] + " = " + std::to_string(e.viral_targets)); }
+		if (e.changed_columns[192]) { v.push_back(columns[192] + " = " + std::to_string(e.viral_timer)); }
+		if (e.changed_columns[193]) { v.push_back(columns[193] + " = " + std::to_string(e.nimbuseffect)); }
+		if (e.changed_columns[194]) { v.push_back(columns[194] + " = " + std::to_string(e.ConeStartAngle)); }
+		if (e.changed_columns[195]) { v.push_back(columns[195] + " = " + std::to_string(e.ConeStopAngle)); }
+		if (e.changed_columns[196]) { v.push_back(columns[196] + " = " + std::to_string(e.sneaking)); }
+		if (e.changed_columns[197]) { v.push_back(columns[197] + " = " + std::to_string(e.not_extendable)); }
+		if (e.changed_columns[198]) { v.push_back(columns[198] + " = " + std::to_string(e.field198)); }
+		if (e.changed_columns[199]) { v.push_back(columns[199] + " = " + std::to_string(e.field199)); }
+		if (e.changed_columns[200]) { v.push_back(columns[200] + " = " + std::to_string(e.suspendable)); }
+		if (e.changed_columns[201]) { v.push_back(columns[201] + " = " + std::to_string(e.viral_range)); }
+		if (e.changed_columns[202]) { v.push_back(columns[202] + " = " + std::to_string(e.songcap)); }
+		if (e.changed_columns[203]) { v.push_back(columns[203] + " = " + std::to_string(e.field203)); }
+		if (e.changed_columns[204]) { v.push_back(columns[204] + " = " + std::to_string(e.field204)); }
+		if (e.changed_columns[205]) { v.push_back(columns[205] + " = " + std::to_string(e.no_block)); }
+		if (e.changed_columns[206]) { v.push_back(columns[206] + " = " + std::to_string(e.field206)); }
+		if (e.changed_columns[207]) { v.push_back(columns[207] + " = " + std::to_string(e.spellgroup)); }
+		if (e.changed_columns[208]) { v.push_back(columns[208] + " = " + std::to_string(e.rank_)); }
+		if (e.changed_columns[209]) { v.push_back(columns[209] + " = " + std::to_string(e.field209)); }
+		if (e.changed_columns[210]) { v.push_back(columns[210] + " = " + std::to_string(e.field210)); }
+		if (e.changed_columns[211]) { v.push_back(columns[211] + " = " + std::to_string(e.CastRestriction)); }
+		if (e.changed_columns[212]) { v.push_back(columns[212] + " = " + std::to_string(e.allowrest)); }
+		if (e.changed_columns[213]) { v.push_back(columns[213] + " = " + std::to_string(e.InCombat)); }
+		if (e.changed_columns[214]) { v.push_back(columns[214] + " = " + std::to_string(e.OutofCombat)); }
+		if (e.changed_columns[215]) { v.push_back(columns[215] + " = " + std::to_string(e.field215)); }
+		if (e.changed_columns[216]) { v.push_back(columns[216] + " = " + std::to_string(e.field216)); }
+		if (e.changed_columns[217]) { v.push_back(columns[217] + " = " + std::to_string(e.field217)); }
+		if (e.changed_columns[218]) { v.push_back(columns[218] + " = " + std::to_string(e.aemaxtargets)); }
+		if (e.changed_columns[219]) { v.push_back(columns[219] + " = " + std::to_string(e.maxtargets)); }
+		if (e.changed_columns[220]) { v.push_back(columns[220] + " = " + std::to_string(e.field220)); }
+		if (e.changed_columns[221]) { v.push_back(columns[221] + " = " + std::to_string(e.field221)); }
+		if (e.changed_columns[222]) { v.push_back(columns[222] + " = " + std::to_string(e.field222)); }
+		if (e.changed_columns[223]) { v.push_back(columns[223] + " = " + std::to_string(e.field223)); }
+		if (e.changed_columns[224]) { v.push_back(columns[224] + " = " + std::to_string(e.persistdeath)); }
+		if (e.changed_columns[225]) { v.push_back(columns[225] + " = " + std::to_string(e.field225)); }
+		if (e.changed_columns[226]) { v.push_back(columns[226] + " = " + std::to_string(e.field226)); }
+		if (e.changed_columns[227]) { v.push_back(columns[227] + " = " + std::to_string(e.min_dist)); }
+		if (e.changed_columns[228]) { v.push_back(columns[228] + " = " + std::to_string(e.min_dist_mod)); }
+		if (e.changed_columns[229]) { v.push_back(columns[229] + " = " + std::to_string(e.max_dist)); }
+		if (e.changed_columns[230]) { v.push_back(columns[230] + " = " + std::to_string(e.max_dist_mod)); }
+		if (e.changed_columns[231]) { v.push_back(columns[231] + " = " + std::to_string(e.min_range)); }
+		if (e.changed_columns[232]) { v.push_back(columns[232] + " = " + std::to_string(e.field232)); }
+		if (e.changed_columns[233]) { v.push_back(columns[233] + " = " + std::to_string(e.field233)); }
+		if (e.changed_columns[234]) { v.push_back(columns[234] + " = " + std::to_string(e.field234)); }
+		if (e.changed_columns[235]) { v.push_back(columns[235] + " = " + std::to_string(e.field235)); }
+		if (e.changed_columns[236]) { v.push_back(columns[236] + " = " + std::to_string(e.field236)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -2628,6 +2882,292 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static SpellsNew FromStmtRow(const mysql::StmtRow &row)
+	{
+		SpellsNew e{};
+
+		e.id                   = row.Get<int32_t>(0).value_or(0);
+		e.name                 = row.GetStr(1).value_or("");
+		e.player_1             = row.GetStr(2).value_or("BLUE_TRAIL");
+		e.teleport_zone        = row.GetStr(3).value_or("");
+		e.you_cast             = row.GetStr(4).value_or("");
+		e.other_casts          = row.GetStr(5).value_or("");
+		e.cast_on_you          = row.GetStr(6).value_or("");
+		e.cast_on_other        = row.GetStr(7).value_or("");
+		e.spell_fades          = row.GetStr(8).value_or("");
+		e.range_               = row.Get<int32_t>(9).value_or(100);
+		e.aoerange             = row.Get<int32_t>(10).value_or(0);
+		e.pushback             = row.Get<int32_t>(11).value_or(0);
+		e.pushup               = row.Get<int32_t>(12).value_or(0);
+		e.cast_time            = row.Get<int32_t>(13).value_or(0);
+		e.recovery_time        = row.Get<int32_t>(14).value_or(0);
+		e.recast_time          = row.Get<int32_t>(15).value_or(0);
+		e.buffdurationformula  = row.Get<int32_t>(16).value_or(7);
+		e.buffduration         = row.Get<int32_t>(17).value_or(65);
+		e.AEDuration           = row.Get<int32_t>(18).value_or(0);
+		e.mana                 = row.Get<int32_t>(19).value_or(0);
+		e.effect_base_value1   = row.Get<int32_t>(20).value_or(100);
+		e.effect_base_value2   = row.Get<int32_t>(21).value_or(0);
+		e.effect_base_value3   = row.Get<int32_t>(22).value_or(0);
+		e.effect_base_value4   = row.Get<int32_t>(23).value_or(0);
+		e.effect_base_value5   = row.Get<int32_t>(24).value_or(0);
+		e.effect_base_value6   = row.Get<int32_t>(25).value_or(0);
+		e.effect_base_value7   = row.Get<int32_t>(26).value_or(0);
+		e.effect_base_value8   = row.Get<int32_t>(27).value_or(0);
+		e.effect_base_value9   = row.Get<int32_t>(28).value_or(0);
+		e.effect_base_value10  = row.Get<int32_t>(29).value_or(0);
+		e.effect_base_value11  = row.Get<int32_t>(30).value_or(0);
+		e.effect_base_value12  = row.Get<int32_t>(31).value_or(0);
+		e.effect_limit_value1  = row.Get<int32_t>(32).value_or(0);
+		e.effect_limit_value2  = row.Get<int32_t>(33).value_or(0);
+		e.effect_limit_value3  = row.Get<int32_t>(34).value_or(0);
+		e.effect_limit_value4  = row.Get<int32_t>(35).value_or(0);
+		e.effect_limit_value5  = row.Get<int32_t>(36).value_or(0);
+		e.effect_limit_value6  = row.Get<int32_t>(37).value_or(0);
+		e.effect_limit_value7  = row.Get<int32_t>(38).value_or(0);
+		e.effect_limit_value8  = row.Get<int32_t>(39).value_or(0);
+		e.effect_limit_value9  = row.Get<int32_t>(40).value_or(0);
+		e.effect_limit_value10 = row.Get<int32_t>(41).value_or(0);
+		e.effect_limit_value11 = row.Get<int32_t>(42).value_or(0);
+		e.effect_limit_value12 = row.Get<int32_t>(43).value_or(0);
+		e.max1                 = row.Get<int32_t>(44).value_or(0);
+		e.max2                 = row.Get<int32_t>(45).value_or(0);
+		e.max3                 = row.Get<int32_t>(46).value_or(0);
+		e.max4                 = row.Get<int32_t>(47).value_or(0);
+		e.max5                 = row.Get<int32_t>(48).value_or(0);
+		e.max6                 = row.Get<int32_t>(49).value_or(0);
+		e.max7                 = row.Get<int32_t>(50).value_or(0);
+		e.max8                 = row.Get<int32_t>(51).value_or(0);
+		e.max9                 = row.Get<int32_t>(52).value_or(0);
+		e.max10                = row.Get<int32_t>(53).value_or(0);
+		e.max11                = row.Get<int32_t>(54).value_or(0);
+		e.max12                = row.Get<int32_t>(55).value_or(0);
+		e.icon                 = row.Get<int32_t>(56).value_or(0);
+		e.memicon              = row.Get<int32_t>(57).value_or(0);
+		e.components1          = row.Get<int32_t>(58).value_or(-1);
+		e.components2          = row.Get<int32_t>(59).value_or(-1);
+		e.components3          = row.Get<int32_t>(60).value_or(-1);
+		e.components4          = row.Get<int32_t>(61).value_or(-1);
+		e.component_counts1    = row.Get<int32_t>(62).value_or(1);
+		e.component_counts2    = row.Get<int32_t>(63).value_or(1);
+		e.component_counts3    = row.Get<int32_t>(64).value_or(1);
+		e.component_counts4    = row.Get<int32_t>(65).value_or(1);
+		e.NoexpendReagent1     = row.Get<int32_t>(66).value_or(-1);
+		e.NoexpendReagent2     = row.Get<int32_t>(67).value_or(-1);
+		e.NoexpendReagent3     = row.Get<int32_t>(68).value_or(-1);
+		e.NoexpendReagent4     = row.Get<int32_t>(69).value_or(-1);
+		e.formula1             = row.Get<int32_t>(70).value_or(100);
+		e.formula2             = row.Get<int32_t>(71).value_or(100);
+		e.formula3             = row.Get<int32_t>(72).value_or(100);
+		e.formula4             = row.Get<int32_t>(73).value_or(100);
+		e.formula5             = row.Get<int32_t>(74).value_or(100);
+		e.formula6             = row.Get<int32_t>(75).value_or(100);
+		e.formula7             = row.Get<int32_t>(76).value_or(100);
+		e.formula8             = row.Get<int32_t>(77).value_or(100);
+		e.formula9             = row.Get<int32_t>(78).value_or(100);
+		e.formula10            = row.Get<int32_t>(79).value_or(100);
+		e.formula11            = row.Get<int32_t>(80).value_or(100);
+		e.formula12            = row.Get<int32_t>(81).value_or(100);
+		e.LightType            = row.Get<int32_t>(82).value_or(0);
+		e.goodEffect           = row.Get<int32_t>(83).value_or(0);
+		e.Activated            = row.Get<int32_t>(84).value_or(0);
+		e.resisttype           = row.Get<int32_t>(85).value_or(0);
+		e.effectid1            = row.Get<int32_t>(86).value_or(254);
+		e.effectid2            = row.Get<int32_t>(87).value_or(254);
+		e.effectid3            = row.Get<int32_t>(88).value_or(254);
+		e.effectid4            = row.Get<int32_t>(89).value_or(254);
+		e.effectid5            = row.Get<int32_t>(90).value_or(254);
+		e.effectid6            = row.Get<int32_t>(91).value_or(254);
+		e.effectid7            = row.Get<int32_t>(92).value_or(254);
+		e.effectid8            = row.Get<int32_t>(93).value_or(254);
+		e.effectid9            = row.Get<int32_t>(94).value_or(254);
+		e.effectid10           = row.Get<int32_t>(95).value_or(254);
+		e.effectid11           = row.Get<int32_t>(96).value_or(254);
+		e.effectid12           = row.Get<int32_t>(97).value_or(254);
+		e.targettype           = row.Get<int32_t>(98).value_or(2);
+		e.basediff             = row.Get<int32_t>(99).value_or(0);
+		e.skill                = row.Get<int32_t>(100).value_or(98);
+		e.zonetype             = row.Get<int32_t>(101).value_or(-1);
+		e.EnvironmentType      = row.Get<int32_t>(102).value_or(0);
+		e.TimeOfDay            = row.Get<int32_t>(103).value_or(0);
+		e.classes1             = row.Get<int32_t>(104).value_or(255);
+		e.classes2             = row.Get<int32_t>(105).value_or(255);
+		e.classes3             = row.Get<int32_t>(106).value_or(255);
+		e.classes4             = row.Get<int32_t>(107).value_or(255);
+		e.classes5             = row.Get<int32_t>(108).value_or(255);
+		e.classes6             = row.Get<int32_t>(109).value_or(255);
+		e.classes7             = row.Get<int32_t>(110).value_or(255);
+		e.classes8             = row.Get<int32_t>(111).value_or(255);
+		e.classes9             = row.Get<int32_t>(112).value_or(255);
+		e.classes10            = row.Get<int32_t>(113).value_or(255);
+		e.classes11            = row.Get<int32_t>(114).value_or(255);
+		e.classes12            = row.Get<int32_t>(115).value_or(255);
+		e.classes13            = row.Get<int32_t>(116).value_or(255);
+		e.classes14            = row.Get<int32_t>(117).value_or(255);
+		e.classes15            = row.Get<int32_t>(118).value_or(255);
+		e.classes16            = row.Get<int32_t>(119).value_or(255);
+		e.CastingAnim          = row.Get<int32_t>(120).value_or(44);
+		e.TargetAnim           = row.Get<int32_t>(121).value_or(13);
+		e.TravelType           = row.Get<int32_t>(122).value_or(0);
+		e.SpellAffectIndex     = row.Get<int32_t>(123).value_or(-1);
+		e.disallow_sit         = row.Get<int32_t>(124).value_or(0);
+		e.deities0             = row.Get<int32_t>(125).value_or(0);
+		e.deities1             = row.Get<int32_t>(126).value_or(0);
+		e.deities2             = row.Get<int32_t>(127).value_or(0);
+		e.deities3             = row.Get<int32_t>(128).value_or(0);
+		e.deities4             = row.Get<int32_t>(129).value_or(0);
+		e.deities5             = row.Get<int32_t>(130).value_or(0);
+		e.deities6             = row.Get<int32_t>(131).value_or(0);
+		e.deities7             = row.Get<int32_t>(132).value_or(0);
+		e.deities8             = row.Get<int32_t>(133).value_or(0);
+		e.deities9             = row.Get<int32_t>(134).value_or(0);
+		e.deities10            = row.Get<int32_t>(135).value_or(0);
+		e.deities11            = row.Get<int32_t>(136).value_or(0);
+		e.deities12            = row.Get<int32_t>(137).value_or(0);
+		e.deities13            = row.Get<int32_t>(138).value_or(0);
+		e.deities14            = row.Get<int32_t>(139).value_or(0);
+		e.deities15            = row.Get<int32_t>(140).value_or(0);
+		e.deities16            = row.Get<int32_t>(141).value_or(0);
+		e.field142             = row.Get<int32_t>(142).value_or(100);
+		e.field143             = row.Get<int32_t>(143).value_or(0);
+		e.new_icon             = row.Get<int32_t>(144).value_or(161);
+		e.spellanim            = row.Get<int32_t>(145).value_or(0);
+		e.uninterruptable      = row.Get<int32_t>(146).value_or(0);
+		e.ResistDiff           = row.Get<int32_t>(147).value_or(-150);
+		e.dot_stacking_exempt  = row.Get<int32_t>(148).value_or(0);
+		e.deleteable           = row.Get<int32_t>(149).value_or(0);
+		e.RecourseLink         = row.Get<int32_t>(150).value_or(0);
+		e.no_partial_resist    = row.Get<int32_t>(151).value_or(0);
+		e.field152             = row.Get<int32_t>(152).value_or(0);
+		e.field153             = row.Get<int32_t>(153).value_or(0);
+		e.short_buff_box       = row.Get<int32_t>(154).value_or(-1);
+		e.descnum              = row.Get<int32_t>(155).value_or(0);
+		e.typedescnum          = row.Get<int32_t>(156).value_or(0);
+		e.effectdescnum        = row.Get<int32_t>(157).value_or(0);
+		e.effectdescnum2       = row.Get<int32_t>(158).value_or(0);
+		e.npc_no_los           = row.Get<int32_t>(159).value_or(0);
+		e.field160             = row.Get<int32_t>(160).value_or(0);
+		e.reflectable          = row.Get<int32_t>(161).value_or(0);
+		e.bonushate            = row.Get<int32_t>(162).value_or(0);
+		e.field163             = row.Get<int32_t>(163).value_or(100);
+		e.field164             = row.Get<int32_t>(164).value_or(-150);
+		e.ldon_trap            = row.Get<int32_t>(165).value_or(0);
+		e.EndurCost            = row.Get<int32_t>(166).value_or(0);
+		e.EndurTimerIndex      = row.Get<int32_t>(167).value_or(0);
+		e.IsDiscipline         = row.Get<int32_t>(168).value_or(0);
+		e.field169             = row.Get<int32_t>(169).value_or(0);
+		e.field170             = row.Get<int32_t>(170).value_or(0);
+		e.field171             = row.Get<int32_t>(171).value_or(0);
+		e.field172             = row.Get<int32_t>(172).value_or(0);
+		e.HateAdded            = row.Get<int32_t>(173).value_or(0);
+		e.EndurUpkeep          = row.Get<int32_t>(174).value_or(0);
+		e.numhitstype          = row.Get<int32_t>(175).value_or(0);
+		e.numhits              = row.Get<int32_t>(176).value_or(0);
+		e.pvpresistbase        = row.Get<int32_t>(177).value_or(-150);
+		e.pvpresistcalc        = row.Get<int32_t>(178).value_or(100);
+		e.pvpresistcap         = row.Get<int32_t>(179).value_or(-150);
+		e.spell_category       = row.Get<int32_t>(180).value_or(-99);
+		e.pvp_duration         = row.Get<int32_t>(181).value_or(0);
+		e.pvp_duration_cap     = row.Get<int32_t>(182).value_or(0);
+		e.pcnpc_only_flag      = row.Get<int32_t>(183).value_or(0);
+		e.cast_not_standing    = row.Get<int32_t>(184).value_or(0);
+		e.can_mgb              = row.Get<int32_t>(185).value_or(0);
+		e.nodispell            = row.Get<int32_t>(186).value_or(-1);
+		e.npc_category         = row.Get<int32_t>(187).value_or(0);
+		e.npc_usefulness       = row.Get<int32_t>(188).value_or(0);
+		e.MinResist            = row.Get<int32_t>(189).value_or(0);
+		e.MaxResist            = row.Get<int32_t>(190).value_or(0);
+		e.viral_targets        = row.Get<int32_t>(191).value_or(0);
+		e.viral_timer          = row.Get<int32_t>(192).value_or(0);
+		e.nimbuseffect         = row.Get<int32_t>(193).value_or(0);
+		e.ConeStartAngle       = row.Get<int32_t>(194).value_or(0);
+		e.ConeStopAngle        = row.Get<int32_t>(195).value_or(0);
+		e.sneaking             = row.Get<int32_t>(196).value_or(0);
+		e.not_extendable       = row.Get<int32_t>(197).value_or(0);
+		e.field198             = row.Get<int32_t>(198).value_or(0);
+		e.field199             = row.Get<int32_t>(199).value_or(1);
+		e.suspendable          = row.Get<int32_t>(200).value_or(0);
+		e.viral_range          = row.Get<int32_t>(201).value_or(0);
+		e.songcap              = row.Get<int32_t>(202).value_or(0);
+		e.field203             = row.Get<int32_t>(203).value_or(0);
+		e.field204             = row.Get<int32_t>(204).value_or(0);
+		e.no_block             = row.Get<int32_t>(205).value_or(0);
+		e.field206             = row.Get<int32_t>(206).value_or(-1);
+		e.spellgroup           = row.Get<int32_t>(207).value_or(0);
+		e.rank_                = row.Get<int32_t>(208).value_or(0);
+		e.field209             = row.Get<int32_t>(209).value_or(0);
+		e.field210             = row.Get<int32_t>(210).value_or(1);
+		e.CastRestriction      = row.Get<int32_t>(211).value_or(0);
+		e.allowrest            = row.Get<int32_t>(212).value_or(0);
+		e.InCombat             = row.Get<int32_t>(213).value_or(0);
+		e.OutofCombat          = row.Get<int32_t>(214).value_or(0);
+		e.field215             = row.Get<int32_t>(215).value_or(0);
+		e.field216             = row.Get<int32_t>(216).value_or(0);
+		e.field217             = row.Get<int32_t>(217).value_or(0);
+		e.aemaxtargets         = row.Get<int32_t>(218).value_or(0);
+		e.maxtargets           = row.Get<int32_t>(219).value_or(0);
+		e.field220             = row.Get<int32_t>(220).value_or(0);
+		e.field221             = row.Get<int32_t>(221).value_or(0);
+		e.field222             = row.Get<int32_t>(222).value_or(0);
+		e.field223             = row.Get<int32_t>(223).value_or(0);
+		e.persistdeath         = row.Get<int32_t>(224).value_or(0);
+		e.field225             = row.Get<int32_t>(225).value_or(0);
+		e.field226             = row.Get<int32_t>(226).value_or(0);
+		e.min_dist             = row.Get<float>(227).value_or(0);
+		e.min_dist_mod         = row.Get<float>(228).value_or(0);
+		e.max_dist             = row.Get<float>(229).value_or(0);
+		e.max_dist_mod         = row.Get<float>(230).value_or(0);
+		e.min_range            = row.Get<int32_t>(231).value_or(0);
+		e.field232             = row.Get<int32_t>(232).value_or(0);
+		e.field233             = row.Get<int32_t>(233).value_or(0);
+		e.field234             = row.Get<int32_t>(234).value_or(0);
+		e.field235             = row.Get<int32_t>(235).value_or(0);
+		e.field236             = row.Get<int32_t>(236).value_or(0);
+
+		return e;
+	}
+
+	static SpellsNew FindOnePrepared(
+		Database& db,
+		int spells_new_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { spells_new_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<SpellsNew> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<SpellsNew> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -2951,7 +3491,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<237> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -3195,13 +3743,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
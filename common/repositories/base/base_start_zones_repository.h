@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseStartZonesRepository {
@@ -38,6 +40,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<19> changed_columns = std::bitset<19>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -230,6 +235,33 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		StartZones &e,
+		const StartZones &original
+	)
+	{
+		e.changed_columns[0] = e.x != original.x;
+		e.changed_columns[1] = e.y != original.y;
+		e.changed_columns[2] = e.z != original.z;
+		e.changed_columns[3] = e.heading != original.heading;
+		e.changed_columns[4] = e.zone_id != original.zone_id;
+		e.changed_columns[5] = e.bind_id != original.bind_id;
+		e.changed_columns[6] = e.player_choice != original.player_choice;
+		e.changed_columns[7] = e.player_class != original.player_class;
+		e.changed_columns[8] = e.player_deity != original.player_deity;
+		e.changed_columns[9] = e.player_race != original.player_race;
+		e.changed_columns[10] = e.start_zone != original.start_zone;
+		e.changed_columns[11] = e.bind_x != original.bind_x;
+		e.changed_columns[12] = e.bind_y != original.bind_y;
+		e.changed_columns[13] = e.bind_z != original.bind_z;
+		e.changed_columns[14] = e.select_rank != original.select_rank;
+		e.changed_columns[15] = e.min_expansion != original.min_expansion;
+		e.changed_columns[16] = e.max_expansion != original.max_expansion;
+		e.changed_columns[17] = e.content_flags != original.content_flags;
+		e.changed_columns[18] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const StartZones &e
@@ -239,25 +271,29 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.x));
-		v.push_back(columns[1] + " = " + std::to_string(e.y));
-		v.push_back(columns[2] + " = " + std::to_string(e.z));
-		v.push_back(columns[3] + " = " + std::to_string(e.heading));
-		v.push_back(columns[4] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[5] + " = " + std::to_string(e.bind_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.player_choice));
-		v.push_back(columns[7] + " = " + std::to_string(e.player_class));
-		v.push_back(columns[8] + " = " + std::to_string(e.player_deity));
-		v.push_back(columns[9] + " = " + std::to_string(e.player_race));
-		v.push_back(columns[10] + " = " + std::to_string(e.start_zone));
-		v.push_back(columns[11] + " = " + std::to_string(e.bind_x));
-		v.push_back(columns[12] + " = " + std::to_string(e.bind_y));
-		v.push_back(columns[13] + " = " + std::to_string(e.bind_z));
-		v.push_back(columns[14] + " = " + std::to_string(e.select_rank));
-		v.push_back(columns[15] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[16] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.bind_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.player_choice)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.player_class)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.player_deity)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.player_race)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.start_zone)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.bind_x)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.bind_y)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.bind_z)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.select_rank)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -448,6 +484,74 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static StartZones FromStmtRow(const mysql::StmtRow &row)
+	{
+		StartZones e{};
+
+		e.x                      = row.Get<float>(0).value_or(0);
+		e.y                      = row.Get<float>(1).value_or(0);
+		e.z                      = row.Get<float>(2).value_or(0);
+		e.heading                = row.Get<float>(3).value_or(0);
+		e.zone_id                = row.Get<int32_t>(4).value_or(0);
+		e.bind_id                = row.Get<int32_t>(5).value_or(0);
+		e.player_choice          = row.Get<int32_t>(6).value_or(0);
+		e.player_class           = row.Get<int32_t>(7).value_or(0);
+		e.player_deity           = row.Get<int32_t>(8).value_or(0);
+		e.player_race            = row.Get<int32_t>(9).value_or(0);
+		e.start_zone             = row.Get<int32_t>(10).value_or(0);
+		e.bind_x                 = row.Get<float>(11).value_or(0);
+		e.bind_y                 = row.Get<float>(12).value_or(0);
+		e.bind_z                 = row.Get<float>(13).value_or(0);
+		e.select_rank            = row.Get<uint8_t>(14).value_or(50);
+		e.min_expansion          = row.Get<int8_t>(15).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(16).value_or(-1);
+		e.content_flags          = row.GetStr(17).value_or("");
+		e.content_flags_disabled = row.GetStr(18).value_or("");
+
+		return e;
+	}
+
+	static StartZones FindOnePrepared(
+		Database& db,
+		int start_zones_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { start_zones_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<StartZones> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<StartZones> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -553,7 +657,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<19> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.x));
@@ -579,13 +691,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
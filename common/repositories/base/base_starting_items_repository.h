@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseStartingItemsRepository {
@@ -38,6 +40,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<19> changed_columns = std::bitset<19>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -230,6 +235,33 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		StartingItems &e,
+		const StartingItems &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.class_list != original.class_list;
+		e.changed_columns[2] = e.race_list != original.race_list;
+		e.changed_columns[3] = e.deity_list != original.deity_list;
+		e.changed_columns[4] = e.zone_id_list != original.zone_id_list;
+		e.changed_columns[5] = e.item_id != original.item_id;
+		e.changed_columns[6] = e.item_charges != original.item_charges;
+		e.changed_columns[7] = e.augment_one != original.augment_one;
+		e.changed_columns[8] = e.augment_two != original.augment_two;
+		e.changed_columns[9] = e.augment_three != original.augment_three;
+		e.changed_columns[10] = e.augment_four != original.augment_four;
+		e.changed_columns[11] = e.augment_five != original.augment_five;
+		e.changed_columns[12] = e.augment_six != original.augment_six;
+		e.changed_columns[13] = e.status != original.status;
+		e.changed_columns[14] = e.inventory_slot != original.inventory_slot;
+		e.changed_columns[15] = e.min_expansion != original.min_expansion;
+		e.changed_columns[16] = e.max_expansion != original.max_expansion;
+		e.changed_columns[17] = e.content_flags != original.content_flags;
+		e.changed_columns[18] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const StartingItems &e
@@ -239,24 +271,28 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.class_list) + "'");
-		v.push_back(columns[2] + " = '" + Strings::Escape(e.race_list) + "'");
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.deity_list) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.zone_id_list) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[6] + " = " + std::to_string(e.item_charges));
-		v.push_back(columns[7] + " = " + std::to_string(e.augment_one));
-		v.push_back(columns[8] + " = " + std::to_string(e.augment_two));
-		v.push_back(columns[9] + " = " + std::to_string(e.augment_three));
-		v.push_back(columns[10] + " = " + std::to_string(e.augment_four));
-		v.push_back(columns[11] + " = " + std::to_string(e.augment_five));
-		v.push_back(columns[12] + " = " + std::to_string(e.augment_six));
-		v.push_back(columns[13] + " = " + std::to_string(e.status));
-		v.push_back(columns[14] + " = " + std::to_string(e.inventory_slot));
-		v.push_back(columns[15] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[16] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.class_list) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = '" + Strings::Escape(e.race_list) + "'"); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.deity_list) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.zone_id_list) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.item_charges)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.augment_one)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.augment_two)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.augment_three)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.augment_four)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.augment_five)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.augment_six)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.status)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.inventory_slot)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -447,6 +483,74 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static StartingItems FromStmtRow(const mysql::StmtRow &row)
+	{
+		StartingItems e{};
+
+		e.id                     = row.Get<uint32_t>(0).value_or(0);
+		e.class_list             = row.GetStr(1).value_or("");
+		e.race_list              = row.GetStr(2).value_or("");
+		e.deity_list             = row.GetStr(3).value_or("");
+		e.zone_id_list           = row.GetStr(4).value_or("");
+		e.item_id                = row.Get<uint32_t>(5).value_or(0);
+		e.item_charges           = row.Get<uint8_t>(6).value_or(1);
+		e.augment_one            = row.Get<uint32_t>(7).value_or(0);
+		e.augment_two            = row.Get<uint32_t>(8).value_or(0);
+		e.augment_three          = row.Get<uint32_t>(9).value_or(0);
+		e.augment_four           = row.Get<uint32_t>(10).value_or(0);
+		e.augment_five           = row.Get<uint32_t>(11).value_or(0);
+		e.augment_six            = row.Get<uint32_t>(12).value_or(0);
+		e.status                 = row.Get<int32_t>(13).value_or(0);
+		e.inventory_slot         = row.Get<int32_t>(14).value_or(-1);
+		e.min_expansion          = row.Get<int8_t>(15).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(16).value_or(-1);
+		e.content_flags          = row.GetStr(17).value_or("");
+		e.content_flags_disabled = row.GetStr(18).value_or("");
+
+		return e;
+	}
+
+	static StartingItems FindOnePrepared(
+		Database& db,
+		int starting_items_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { starting_items_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<StartingItems> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<StartingItems> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -552,7 +656,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<19> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -578,13 +690,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
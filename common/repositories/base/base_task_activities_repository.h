@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseTaskActivitiesRepository {
@@ -44,6 +46,9 @@ public:
 		int32_t     zone_version;
 		int8_t      optional;
 		uint8_t     list_group;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<25> changed_columns = std::bitset<25>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -260,6 +265,39 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		TaskActivities &e,
+		const TaskActivities &original
+	)
+	{
+		e.changed_columns[0] = e.taskid != original.taskid;
+		e.changed_columns[1] = e.activityid != original.activityid;
+		e.changed_columns[2] = e.req_activity_id != original.req_activity_id;
+		e.changed_columns[3] = e.step != original.step;
+		e.changed_columns[4] = e.activitytype != original.activitytype;
+		e.changed_columns[5] = e.target_name != original.target_name;
+		e.changed_columns[6] = e.goalmethod != original.goalmethod;
+		e.changed_columns[7] = e.goalcount != original.goalcount;
+		e.changed_columns[8] = e.description_override != original.description_override;
+		e.changed_columns[9] = e.npc_match_list != original.npc_match_list;
+		e.changed_columns[10] = e.item_id_list != original.item_id_list;
+		e.changed_columns[11] = e.item_list != original.item_list;
+		e.changed_columns[12] = e.dz_switch_id != original.dz_switch_id;
+		e.changed_columns[13] = e.min_x != original.min_x;
+		e.changed_columns[14] = e.min_y != original.min_y;
+		e.changed_columns[15] = e.min_z != original.min_z;
+		e.changed_columns[16] = e.max_x != original.max_x;
+		e.changed_columns[17] = e.max_y != original.max_y;
+		e.changed_columns[18] = e.max_z != original.max_z;
+		e.changed_columns[19] = e.skill_list != original.skill_list;
+		e.changed_columns[20] = e.spell_list != original.spell_list;
+		e.changed_columns[21] = e.zones != original.zones;
+		e.changed_columns[22] = e.zone_version != original.zone_version;
+		e.changed_columns[23] = e.optional != original.optional;
+		e.changed_columns[24] = e.list_group != original.list_group;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const TaskActivities &e
@@ -269,31 +307,35 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.taskid));
-		v.push_back(columns[1] + " = " + std::to_string(e.activityid));
-		v.push_back(columns[2] + " = " + std::to_string(e.req_activity_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.step));
-		v.push_back(columns[4] + " = " + std::to_string(e.activitytype));
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.target_name) + "'");
-		v.push_back(columns[6] + " = " + std::to_string(e.goalmethod));
-		v.push_back(columns[7] + " = " + std::to_string(e.goalcount));
-		v.push_back(columns[8] + " = '" + Strings::Escape(e.description_override) + "'");
-		v.push_back(columns[9] + " = '" + Strings::Escape(e.npc_match_list) + "'");
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.item_id_list) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.item_list) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.dz_switch_id));
-		v.push_back(columns[13] + " = " + std::to_string(e.min_x));
-		v.push_back(columns[14] + " = " + std::to_string(e.min_y));
-		v.push_back(columns[15] + " = " + std::to_string(e.min_z));
-		v.push_back(columns[16] + " = " + std::to_string(e.max_x));
-		v.push_back(columns[17] + " = " + std::to_string(e.max_y));
-		v.push_back(columns[18] + " = " + std::to_string(e.max_z));
-		v.push_back(columns[19] + " = '" + Strings::Escape(e.skill_list) + "'");
-		v.push_back(columns[20] + " = '" + Strings::Escape(e.spell_list) + "'");
-		v.push_back(columns[21] + " = '" + Strings::Escape(e.zones) + "'");
-		v.push_back(columns[22] + " = " + std::to_string(e.zone_version));
-		v.push_back(columns[23] + " = " + std::to_string(e.optional));
-		v.push_back(columns[24] + " = " + std::to_string(e.list_group));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.taskid)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.activityid)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.req_activity_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.step)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.activitytype)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.target_name) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.goalmethod)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.goalcount)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = '" + Strings::Escape(e.description_override) + "'"); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = '" + Strings::Escape(e.npc_match_list) + "'"); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.item_id_list) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.item_list) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.dz_switch_id)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.min_x)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.min_y)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.min_z)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.max_x)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.max_y)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.max_z)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = '" + Strings::Escape(e.skill_list) + "'"); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = '" + Strings::Escape(e.spell_list) + "'"); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = '" + Strings::Escape(e.zones) + "'"); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.zone_version)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.optional)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.list_group)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -508,6 +550,80 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static TaskActivities FromStmtRow(const mysql::StmtRow &row)
+	{
+		TaskActivities e{};
+
+		e.taskid               = row.Get<uint32_t>(0).value_or(0);
+		e.activityid           = row.Get<uint32_t>(1).value_or(0);
+		e.req_activity_id      = row.Get<int32_t>(2).value_or(-1);
+		e.step                 = row.Get<int32_t>(3).value_or(0);
+		e.activitytype         = row.Get<uint8_t>(4).value_or(0);
+		e.target_name          = row.GetStr(5).value_or("");
+		e.goalmethod           = row.Get<uint32_t>(6).value_or(0);
+		e.goalcount            = row.Get<int32_t>(7).value_or(1);
+		e.description_override = row.GetStr(8).value_or("");
+		e.npc_match_list       = row.GetStr(9).value_or("");
+		e.item_id_list         = row.GetStr(10).value_or("");
+		e.item_list            = row.GetStr(11).value_or("");
+		e.dz_switch_id         = row.Get<int32_t>(12).value_or(0);
+		e.min_x                = row.Get<float>(13).value_or(0);
+		e.min_y                = row.Get<float>(14).value_or(0);
+		e.min_z                = row.Get<float>(15).value_or(0);
+		e.max_x                = row.Get<float>(16).value_or(0);
+		e.max_y                = row.Get<float>(17).value_or(0);
+		e.max_z                = row.Get<float>(18).value_or(0);
+		e.skill_list           = row.GetStr(19).value_or("-1");
+		e.spell_list           = row.GetStr(20).value_or("0");
+		e.zones                = row.GetStr(21).value_or("");
+		e.zone_version         = row.Get<int32_t>(22).value_or(-1);
+		e.optional             = row.Get<int8_t>(23).value_or(0);
+		e.list_group           = row.Get<uint8_t>(24).value_or(0);
+
+		return e;
+	}
+
+	static TaskActivities FindOnePrepared(
+		Database& db,
+		int task_activities_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { task_activities_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<TaskActivities> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<TaskActivities> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -619,7 +735,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<25> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.taskid));
@@ -651,13 +775,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseTasksRepository {
@@ -48,6 +50,9 @@ public:
 		int32_t     lock_activity_id;
 		int32_t     faction_amount;
 		int16_t     enabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<29> changed_columns = std::bitset<29>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -280,6 +285,43 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Tasks &e,
+		const Tasks &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.type != original.type;
+		e.changed_columns[2] = e.duration != original.duration;
+		e.changed_columns[3] = e.duration_code != original.duration_code;
+		e.changed_columns[4] = e.title != original.title;
+		e.changed_columns[5] = e.description != original.description;
+		e.changed_columns[6] = e.reward_text != original.reward_text;
+		e.changed_columns[7] = e.reward_id_list != original.reward_id_list;
+		e.changed_columns[8] = e.cash_reward != original.cash_reward;
+		e.changed_columns[9] = e.exp_reward != original.exp_reward;
+		e.changed_columns[10] = e.reward_method != original.reward_method;
+		e.changed_columns[11] = e.reward_points != original.reward_points;
+		e.changed_columns[12] = e.reward_point_type != original.reward_point_type;
+		e.changed_columns[13] = e.min_level != original.min_level;
+		e.changed_columns[14] = e.max_level != original.max_level;
+		e.changed_columns[15] = e.level_spread != original.level_spread;
+		e.changed_columns[16] = e.min_players != original.min_players;
+		e.changed_columns[17] = e.max_players != original.max_players;
+		e.changed_columns[18] = e.repeatable != original.repeatable;
+		e.changed_columns[19] = e.faction_reward != original.faction_reward;
+		e.changed_columns[20] = e.completion_emote != original.completion_emote;
+		e.changed_columns[21] = e.replay_timer_group != original.replay_timer_group;
+		e.changed_columns[22] = e.replay_timer_seconds != original.replay_timer_seconds;
+		e.changed_columns[23] = e.request_timer_group != original.request_timer_group;
+		e.changed_columns[24] = e.request_timer_seconds != original.request_timer_seconds;
+		e.changed_columns[25] = e.dz_template_id != original.dz_template_id;
+		e.changed_columns[26] = e.lock_activity_id != original.lock_activity_id;
+		e.changed_columns[27] = e.faction_amount != original.faction_amount;
+		e.changed_columns[28] = e.enabled != original.enabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Tasks &e
@@ -289,35 +331,39 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[0] + " = " + std::to_string(e.id));
-		v.push_back(columns[1] + " = " + std::to_string(e.type));
-		v.push_back(columns[2] + " = " + std::to_string(e.duration));
-		v.push_back(columns[3] + " = " + std::to_string(e.duration_code));
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.title) + "'");
-		v.push_back(columns[5] + " = '" + Strings::Escape(e.description) + "'");
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.reward_text) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.reward_id_list) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.cash_reward));
-		v.push_back(columns[9] + " = " + std::to_string(e.exp_reward));
-		v.push_back(columns[10] + " = " + std::to_string(e.reward_method));
-		v.push_back(columns[11] + " = " + std::to_string(e.reward_points));
-		v.push_back(columns[12] + " = " + std::to_string(e.reward_point_type));
-		v.push_back(columns[13] + " = " + std::to_string(e.min_level));
-		v.push_back(columns[14] + " = " + std::to_string(e.max_level));
-		v.push_back(columns[15] + " = " + std::to_string(e.level_spread));
-		v.push_back(columns[16] + " = " + std::to_string(e.min_players));
-		v.push_back(columns[17] + " = " + std::to_string(e.max_players));
-		v.push_back(columns[18] + " = " + std::to_string(e.repeatable));
-		v.push_back(columns[19] + " = " + std::to_string(e.faction_reward));
-		v.push_back(columns[20] + " = '" + Strings::Escape(e.completion_emote) + "'");
-		v.push_back(columns[21] + " = " + std::to_string(e.replay_timer_group));
-		v.push_back(columns[22] + " = " + std::to_string(e.replay_timer_seconds));
-		v.push_back(columns[23] + " = " + std::to_string(e.request_timer_group));
-		v.push_back(columns[24] + " = " + std::to_string(e.request_timer_seconds));
-		v.push_back(columns[25] + " = " + std::to_string(e.dz_template_id));
-		v.push_back(columns[26] + " = " + std::to_string(e.lock_activity_id));
-		v.push_back(columns[27] + " = " + std::to_string(e.faction_amount));
-		v.push_back(columns[28] + " = " + std::to_string(e.enabled));
+		if (e.changed_columns[0]) { v.push_back(columns[0] + " = " + std::to_string(e.id)); }
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.duration)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.duration_code)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.title) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = '" + Strings::Escape(e.description) + "'"); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.reward_text) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.reward_id_list) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.cash_reward)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.exp_reward)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.reward_method)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.reward_points)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.reward_point_type)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.min_level)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.max_level)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.level_spread)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.min_players)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.max_players)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.repeatable)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.faction_reward)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = '" + Strings::Escape(e.completion_emote) + "'"); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.replay_timer_group)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.replay_timer_seconds)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.request_timer_group)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.request_timer_seconds)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.dz_template_id)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.lock_activity_id)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.faction_amount)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.enabled)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -548,6 +594,84 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Tasks FromStmtRow(const mysql::StmtRow &row)
+	{
+		Tasks e{};
+
+		e.id                    = row.Get<uint32_t>(0).value_or(0);
+		e.type                  = row.Get<int8_t>(1).value_or(0);
+		e.duration              = row.Get<uint32_t>(2).value_or(0);
+		e.duration_code         = row.Get<int8_t>(3).value_or(0);
+		e.title                 = row.GetStr(4).value_or("");
+		e.description           = row.GetStr(5).value_or("");
+		e.reward_text           = row.GetStr(6).value_or("");
+		e.reward_id_list        = row.GetStr(7).value_or("");
+		e.cash_reward           = row.Get<uint32_t>(8).value_or(0);
+		e.exp_reward            = row.Get<int32_t>(9).value_or(0);
+		e.reward_method         = row.Get<uint8_t>(10).value_or(0);
+		e.reward_points         = row.Get<int32_t>(11).value_or(0);
+		e.reward_point_type     = row.Get<int32_t>(12).value_or(0);
+		e.min_level             = row.Get<uint8_t>(13).value_or(0);
+		e.max_level             = row.Get<uint8_t>(14).value_or(0);
+		e.level_spread          = row.Get<uint32_t>(15).value_or(0);
+		e.min_players           = row.Get<uint32_t>(16).value_or(0);
+		e.max_players           = row.Get<uint32_t>(17).value_or(0);
+		e.repeatable            = row.Get<uint8_t>(18).value_or(1);
+		e.faction_reward        = row.Get<int32_t>(19).value_or(0);
+		e.completion_emote      = row.GetStr(20).value_or("");
+		e.replay_timer_group    = row.Get<uint32_t>(21).value_or(0);
+		e.replay_timer_seconds  = row.Get<uint32_t>(22).value_or(0);
+		e.request_timer_group   = row.Get<uint32_t>(23).value_or(0);
+		e.request_timer_seconds = row.Get<uint32_t>(24).value_or(0);
+		e.dz_template_id        = row.Get<uint32_t>(25).value_or(0);
+		e.lock_activity_id      = row.Get<int32_t>(26).value_or(-1);
+		e.faction_amount        = row.Get<int32_t>(27).value_or(0);
+		e.enabled               = row.Get<int16_t>(28).value_or(1);
+
+		return e;
+	}
+
+	static Tasks FindOnePrepared(
+		Database& db,
+		int tasks_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { tasks_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Tasks> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Tasks> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -663,7 +787,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<29> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -699,13 +831,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseTraderRepository {
@@ -37,6 +39,9 @@ public:
 		int32_t  char_zone_instance_id;
 		uint8_t  active_transaction;
 		time_t   listing_date;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<18> changed_columns = std::bitset<18>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -225,6 +230,32 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Trader &e,
+		const Trader &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.char_id != original.char_id;
+		e.changed_columns[2] = e.item_id != original.item_id;
+		e.changed_columns[3] = e.aug_slot_1 != original.aug_slot_1;
+		e.changed_columns[4] = e.aug_slot_2 != original.aug_slot_2;
+		e.changed_columns[5] = e.aug_slot_3 != original.aug_slot_3;
+		e.changed_columns[6] = e.aug_slot_4 != original.aug_slot_4;
+		e.changed_columns[7] = e.aug_slot_5 != original.aug_slot_5;
+		e.changed_columns[8] = e.aug_slot_6 != original.aug_slot_6;
+		e.changed_columns[9] = e.item_sn != original.item_sn;
+		e.changed_columns[10] = e.item_charges != original.item_charges;
+		e.changed_columns[11] = e.item_cost != original.item_cost;
+		e.changed_columns[12] = e.slot_id != original.slot_id;
+		e.changed_columns[13] = e.char_entity_id != original.char_entity_id;
+		e.changed_columns[14] = e.char_zone_id != original.char_zone_id;
+		e.changed_columns[15] = e.char_zone_instance_id != original.char_zone_instance_id;
+		e.changed_columns[16] = e.active_transaction != original.active_transaction;
+		e.changed_columns[17] = e.listing_date != original.listing_date;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Trader &e
@@ -234,23 +265,27 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.char_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.item_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.aug_slot_1));
-		v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_2));
-		v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_3));
-		v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_4));
-		v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_5));
-		v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_6));
-		v.push_back(columns[9] + " = " + std::to_string(e.item_sn));
-		v.push_back(columns[10] + " = " + std::to_string(e.item_charges));
-		v.push_back(columns[11] + " = " + std::to_string(e.item_cost));
-		v.push_back(columns[12] + " = " + std::to_string(e.slot_id));
-		v.push_back(columns[13] + " = " + std::to_string(e.char_entity_id));
-		v.push_back(columns[14] + " = " + std::to_string(e.char_zone_id));
-		v.push_back(columns[15] + " = " + std::to_string(e.char_zone_instance_id));
-		v.push_back(columns[16] + " = " + std::to_string(e.active_transaction));
-		v.push_back(columns[17] + " = FROM_UNIXTIME(" + (e.listing_date > 0 ? std::to_string(e.listing_date) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.char_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.item_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.aug_slot_1)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.aug_slot_2)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.aug_slot_3)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.aug_slot_4)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.aug_slot_5)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.aug_slot_6)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.item_sn)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.item_charges)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.item_cost)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.slot_id)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.char_entity_id)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.char_zone_id)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.char_zone_instance_id)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.active_transaction)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = FROM_UNIXTIME(" + (e.listing_date > 0 ? std::to_string(e.listing_date) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -437,6 +472,73 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Trader FromStmtRow(const mysql::StmtRow &row)
+	{
+		Trader e{};
+
+		e.id                    = row.Get<uint64_t>(0).value_or(0);
+		e.char_id               = row.Get<uint32_t>(1).value_or(0);
+		e.item_id               = row.Get<uint32_t>(2).value_or(0);
+		e.aug_slot_1            = row.Get<uint32_t>(3).value_or(0);
+		e.aug_slot_2            = row.Get<uint32_t>(4).value_or(0);
+		e.aug_slot_3            = row.Get<uint32_t>(5).value_or(0);
+		e.aug_slot_4            = row.Get<uint32_t>(6).value_or(0);
+		e.aug_slot_5            = row.Get<uint32_t>(7).value_or(0);
+		e.aug_slot_6            = row.Get<uint32_t>(8).value_or(0);
+		e.item_sn               = row.Get<uint32_t>(9).value_or(0);
+		e.item_charges          = row.Get<int32_t>(10).value_or(0);
+		e.item_cost             = row.Get<uint32_t>(11).value_or(0);
+		e.slot_id               = row.Get<uint8_t>(12).value_or(0);
+		e.char_entity_id        = row.Get<uint32_t>(13).value_or(0);
+		e.char_zone_id          = row.Get<uint32_t>(14).value_or(0);
+		e.char_zone_instance_id = row.Get<int32_t>(15).value_or(0);
+		e.active_transaction    = row.Get<uint8_t>(16).value_or(0);
+		e.listing_date          = row.Get<int64_t>(17).value_or(-1);
+
+		return e;
+	}
+
+	static Trader FindOnePrepared(
+		Database& db,
+		int trader_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { trader_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Trader> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Trader> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -541,7 +643,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<18> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -566,13 +676,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
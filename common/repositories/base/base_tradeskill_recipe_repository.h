@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseTradeskillRecipeRepository {
@@ -35,6 +37,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<16> changed_columns = std::bitset<16>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -215,6 +220,30 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		TradeskillRecipe &e,
+		const TradeskillRecipe &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.name != original.name;
+		e.changed_columns[2] = e.tradeskill != original.tradeskill;
+		e.changed_columns[3] = e.skillneeded != original.skillneeded;
+		e.changed_columns[4] = e.trivial != original.trivial;
+		e.changed_columns[5] = e.nofail != original.nofail;
+		e.changed_columns[6] = e.replace_container != original.replace_container;
+		e.changed_columns[7] = e.notes != original.notes;
+		e.changed_columns[8] = e.must_learn != original.must_learn;
+		e.changed_columns[9] = e.learned_by_item_id != original.learned_by_item_id;
+		e.changed_columns[10] = e.quest != original.quest;
+		e.changed_columns[11] = e.enabled != original.enabled;
+		e.changed_columns[12] = e.min_expansion != original.min_expansion;
+		e.changed_columns[13] = e.max_expansion != original.max_expansion;
+		e.changed_columns[14] = e.content_flags != original.content_flags;
+		e.changed_columns[15] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const TradeskillRecipe &e
@@ -224,21 +253,25 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.tradeskill));
-		v.push_back(columns[3] + " = " + std::to_string(e.skillneeded));
-		v.push_back(columns[4] + " = " + std::to_string(e.trivial));
-		v.push_back(columns[5] + " = " + std::to_string(e.nofail));
-		v.push_back(columns[6] + " = " + std::to_string(e.replace_container));
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.notes) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.must_learn));
-		v.push_back(columns[9] + " = " + std::to_string(e.learned_by_item_id));
-		v.push_back(columns[10] + " = " + std::to_string(e.quest));
-		v.push_back(columns[11] + " = " + std::to_string(e.enabled));
-		v.push_back(columns[12] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[13] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.name) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.tradeskill)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.skillneeded)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.trivial)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.nofail)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.replace_container)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.notes) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.must_learn)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.learned_by_item_id)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.quest)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.enabled)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -417,6 +450,71 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static TradeskillRecipe FromStmtRow(const mysql::StmtRow &row)
+	{
+		TradeskillRecipe e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.name                   = row.GetStr(1).value_or("");
+		e.tradeskill             = row.Get<int16_t>(2).value_or(0);
+		e.skillneeded            = row.Get<int16_t>(3).value_or(0);
+		e.trivial                = row.Get<int16_t>(4).value_or(0);
+		e.nofail                 = row.Get<int8_t>(5).value_or(0);
+		e.replace_container      = row.Get<int8_t>(6).value_or(0);
+		e.notes                  = row.GetStr(7).value_or("");
+		e.must_learn             = row.Get<int8_t>(8).value_or(0);
+		e.learned_by_item_id     = row.Get<int32_t>(9).value_or(0);
+		e.quest                  = row.Get<int8_t>(10).value_or(0);
+		e.enabled                = row.Get<int8_t>(11).value_or(1);
+		e.min_expansion          = row.Get<int8_t>(12).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(13).value_or(-1);
+		e.content_flags          = row.GetStr(14).value_or("");
+		e.content_flags_disabled = row.GetStr(15).value_or("");
+
+		return e;
+	}
+
+	static TradeskillRecipe FindOnePrepared(
+		Database& db,
+		int tradeskill_recipe_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { tradeskill_recipe_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<TradeskillRecipe> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<TradeskillRecipe> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -519,7 +617,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<16> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -542,13 +648,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
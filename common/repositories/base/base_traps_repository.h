@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseTrapsRepository {
@@ -44,6 +46,9 @@ public:
 		int8_t      max_expansion;
 		std::string content_flags;
 		std::string content_flags_disabled;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<25> changed_columns = std::bitset<25>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -260,6 +265,39 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Traps &e,
+		const Traps &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.x != original.x;
+		e.changed_columns[4] = e.y != original.y;
+		e.changed_columns[5] = e.z != original.z;
+		e.changed_columns[6] = e.chance != original.chance;
+		e.changed_columns[7] = e.maxzdiff != original.maxzdiff;
+		e.changed_columns[8] = e.radius != original.radius;
+		e.changed_columns[9] = e.effect != original.effect;
+		e.changed_columns[10] = e.effectvalue != original.effectvalue;
+		e.changed_columns[11] = e.effectvalue2 != original.effectvalue2;
+		e.changed_columns[12] = e.message != original.message;
+		e.changed_columns[13] = e.skill != original.skill;
+		e.changed_columns[14] = e.level != original.level;
+		e.changed_columns[15] = e.respawn_time != original.respawn_time;
+		e.changed_columns[16] = e.respawn_var != original.respawn_var;
+		e.changed_columns[17] = e.triggered_number != original.triggered_number;
+		e.changed_columns[18] = e.group_ != original.group_;
+		e.changed_columns[19] = e.despawn_when_triggered != original.despawn_when_triggered;
+		e.changed_columns[20] = e.undetectable != original.undetectable;
+		e.changed_columns[21] = e.min_expansion != original.min_expansion;
+		e.changed_columns[22] = e.max_expansion != original.max_expansion;
+		e.changed_columns[23] = e.content_flags != original.content_flags;
+		e.changed_columns[24] = e.content_flags_disabled != original.content_flags_disabled;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Traps &e
@@ -269,30 +307,34 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = " + std::to_string(e.x));
-		v.push_back(columns[4] + " = " + std::to_string(e.y));
-		v.push_back(columns[5] + " = " + std::to_string(e.z));
-		v.push_back(columns[6] + " = " + std::to_string(e.chance));
-		v.push_back(columns[7] + " = " + std::to_string(e.maxzdiff));
-		v.push_back(columns[8] + " = " + std::to_string(e.radius));
-		v.push_back(columns[9] + " = " + std::to_string(e.effect));
-		v.push_back(columns[10] + " = " + std::to_string(e.effectvalue));
-		v.push_back(columns[11] + " = " + std::to_string(e.effectvalue2));
-		v.push_back(columns[12] + " = '" + Strings::Escape(e.message) + "'");
-		v.push_back(columns[13] + " = " + std::to_string(e.skill));
-		v.push_back(columns[14] + " = " + std::to_string(e.level));
-		v.push_back(columns[15] + " = " + std::to_string(e.respawn_time));
-		v.push_back(columns[16] + " = " + std::to_string(e.respawn_var));
-		v.push_back(columns[17] + " = " + std::to_string(e.triggered_number));
-		v.push_back(columns[18] + " = " + std::to_string(e.group_));
-		v.push_back(columns[19] + " = " + std::to_string(e.despawn_when_triggered));
-		v.push_back(columns[20] + " = " + std::to_string(e.undetectable));
-		v.push_back(columns[21] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[22] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[23] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[24] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.chance)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.maxzdiff)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.radius)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.effect)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.effectvalue)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.effectvalue2)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = '" + Strings::Escape(e.message) + "'"); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.skill)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.level)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.respawn_time)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.respawn_var)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.triggered_number)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.group_)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.despawn_when_triggered)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.undetectable)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -507,6 +549,80 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Traps FromStmtRow(const mysql::StmtRow &row)
+	{
+		Traps e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.zone                   = row.GetStr(1).value_or("");
+		e.version                = row.Get<uint16_t>(2).value_or(0);
+		e.x                      = row.Get<int32_t>(3).value_or(0);
+		e.y                      = row.Get<int32_t>(4).value_or(0);
+		e.z                      = row.Get<int32_t>(5).value_or(0);
+		e.chance                 = row.Get<int8_t>(6).value_or(0);
+		e.maxzdiff               = row.Get<float>(7).value_or(0);
+		e.radius                 = row.Get<float>(8).value_or(0);
+		e.effect                 = row.Get<int32_t>(9).value_or(0);
+		e.effectvalue            = row.Get<int32_t>(10).value_or(0);
+		e.effectvalue2           = row.Get<int32_t>(11).value_or(0);
+		e.message                = row.GetStr(12).value_or("");
+		e.skill                  = row.Get<int32_t>(13).value_or(0);
+		e.level                  = row.Get<uint32_t>(14).value_or(1);
+		e.respawn_time           = row.Get<uint32_t>(15).value_or(60);
+		e.respawn_var            = row.Get<uint32_t>(16).value_or(0);
+		e.triggered_number       = row.Get<int8_t>(17).value_or(0);
+		e.group_                 = row.Get<int8_t>(18).value_or(0);
+		e.despawn_when_triggered = row.Get<int8_t>(19).value_or(0);
+		e.undetectable           = row.Get<int8_t>(20).value_or(0);
+		e.min_expansion          = row.Get<int8_t>(21).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(22).value_or(-1);
+		e.content_flags          = row.GetStr(23).value_or("");
+		e.content_flags_disabled = row.GetStr(24).value_or("");
+
+		return e;
+	}
+
+	static Traps FindOnePrepared(
+		Database& db,
+		int traps_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { traps_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Traps> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Traps> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -618,7 +734,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<25> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -650,13 +774,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
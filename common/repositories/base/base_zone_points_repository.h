@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseZonePointsRepository {
@@ -43,6 +45,9 @@ public:
 		int8_t      is_virtual;
 		int32_t     height;
 		int32_t     width;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<24> changed_columns = std::bitset<24>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -255,6 +260,38 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		ZonePoints &e,
+		const ZonePoints &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone != original.zone;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.number != original.number;
+		e.changed_columns[4] = e.y != original.y;
+		e.changed_columns[5] = e.x != original.x;
+		e.changed_columns[6] = e.z != original.z;
+		e.changed_columns[7] = e.heading != original.heading;
+		e.changed_columns[8] = e.target_y != original.target_y;
+		e.changed_columns[9] = e.target_x != original.target_x;
+		e.changed_columns[10] = e.target_z != original.target_z;
+		e.changed_columns[11] = e.target_heading != original.target_heading;
+		e.changed_columns[12] = e.zoneinst != original.zoneinst;
+		e.changed_columns[13] = e.target_zone_id != original.target_zone_id;
+		e.changed_columns[14] = e.target_instance != original.target_instance;
+		e.changed_columns[15] = e.buffer != original.buffer;
+		e.changed_columns[16] = e.client_version_mask != original.client_version_mask;
+		e.changed_columns[17] = e.min_expansion != original.min_expansion;
+		e.changed_columns[18] = e.max_expansion != original.max_expansion;
+		e.changed_columns[19] = e.content_flags != original.content_flags;
+		e.changed_columns[20] = e.content_flags_disabled != original.content_flags_disabled;
+		e.changed_columns[21] = e.is_virtual != original.is_virtual;
+		e.changed_columns[22] = e.height != original.height;
+		e.changed_columns[23] = e.width != original.width;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const ZonePoints &e
@@ -264,29 +301,33 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'");
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = " + std::to_string(e.number));
-		v.push_back(columns[4] + " = " + std::to_string(e.y));
-		v.push_back(columns[5] + " = " + std::to_string(e.x));
-		v.push_back(columns[6] + " = " + std::to_string(e.z));
-		v.push_back(columns[7] + " = " + std::to_string(e.heading));
-		v.push_back(columns[8] + " = " + std::to_string(e.target_y));
-		v.push_back(columns[9] + " = " + std::to_string(e.target_x));
-		v.push_back(columns[10] + " = " + std::to_string(e.target_z));
-		v.push_back(columns[11] + " = " + std::to_string(e.target_heading));
-		v.push_back(columns[12] + " = " + std::to_string(e.zoneinst));
-		v.push_back(columns[13] + " = " + std::to_string(e.target_zone_id));
-		v.push_back(columns[14] + " = " + std::to_string(e.target_instance));
-		v.push_back(columns[15] + " = " + std::to_string(e.buffer));
-		v.push_back(columns[16] + " = " + std::to_string(e.client_version_mask));
-		v.push_back(columns[17] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[18] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[19] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[20] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
-		v.push_back(columns[21] + " = " + std::to_string(e.is_virtual));
-		v.push_back(columns[22] + " = " + std::to_string(e.height));
-		v.push_back(columns[23] + " = " + std::to_string(e.width));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = '" + Strings::Escape(e.zone) + "'"); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.number)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.target_y)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.target_x)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.target_z)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.target_heading)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.zoneinst)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.target_zone_id)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.target_instance)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.buffer)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.client_version_mask)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.is_virtual)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.height)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.width)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -497,6 +538,79 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static ZonePoints FromStmtRow(const mysql::StmtRow &row)
+	{
+		ZonePoints e{};
+
+		e.id                     = row.Get<int32_t>(0).value_or(0);
+		e.zone                   = row.GetStr(1).value_or("");
+		e.version                = row.Get<int32_t>(2).value_or(0);
+		e.number                 = row.Get<uint16_t>(3).value_or(1);
+		e.y                      = row.Get<float>(4).value_or(0);
+		e.x                      = row.Get<float>(5).value_or(0);
+		e.z                      = row.Get<float>(6).value_or(0);
+		e.heading                = row.Get<float>(7).value_or(0);
+		e.target_y               = row.Get<float>(8).value_or(0);
+		e.target_x               = row.Get<float>(9).value_or(0);
+		e.target_z               = row.Get<float>(10).value_or(0);
+		e.target_heading         = row.Get<float>(11).value_or(0);
+		e.zoneinst               = row.Get<uint16_t>(12).value_or(0);
+		e.target_zone_id         = row.Get<uint32_t>(13).value_or(0);
+		e.target_instance        = row.Get<uint32_t>(14).value_or(0);
+		e.buffer                 = row.Get<float>(15).value_or(0);
+		e.client_version_mask    = row.Get<uint32_t>(16).value_or(4294967295);
+		e.min_expansion          = row.Get<int8_t>(17).value_or(-1);
+		e.max_expansion          = row.Get<int8_t>(18).value_or(-1);
+		e.content_flags          = row.GetStr(19).value_or("");
+		e.content_flags_disabled = row.GetStr(20).value_or("");
+		e.is_virtual             = row.Get<int8_t>(21).value_or(0);
+		e.height                 = row.Get<int32_t>(22).value_or(0);
+		e.width                  = row.Get<int32_t>(23).value_or(0);
+
+		return e;
+	}
+
+	static ZonePoints FindOnePrepared(
+		Database& db,
+		int zone_points_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { zone_points_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<ZonePoints> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<ZonePoints> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -607,7 +721,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<24> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -638,13 +760,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseZoneRepository {
@@ -118,6 +120,9 @@ public:
 		uint8_t     idle_when_empty;
 		uint32_t    seconds_before_idle;
 		int32_t     shard_at_player_count;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<99> changed_columns = std::bitset<99>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -630,6 +635,113 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		Zone &e,
+		const Zone &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zoneidnumber != original.zoneidnumber;
+		e.changed_columns[2] = e.version != original.version;
+		e.changed_columns[3] = e.short_name != original.short_name;
+		e.changed_columns[4] = e.long_name != original.long_name;
+		e.changed_columns[5] = e.min_status != original.min_status;
+		e.changed_columns[6] = e.map_file_name != original.map_file_name;
+		e.changed_columns[7] = e.note != original.note;
+		e.changed_columns[8] = e.min_expansion != original.min_expansion;
+		e.changed_columns[9] = e.max_expansion != original.max_expansion;
+		e.changed_columns[10] = e.content_flags != original.content_flags;
+		e.changed_columns[11] = e.content_flags_disabled != original.content_flags_disabled;
+		e.changed_columns[12] = e.expansion != original.expansion;
+		e.changed_columns[13] = e.file_name != original.file_name;
+		e.changed_columns[14] = e.safe_x != original.safe_x;
+		e.changed_columns[15] = e.safe_y != original.safe_y;
+		e.changed_columns[16] = e.safe_z != original.safe_z;
+		e.changed_columns[17] = e.safe_heading != original.safe_heading;
+		e.changed_columns[18] = e.graveyard_id != original.graveyard_id;
+		e.changed_columns[19] = e.min_level != original.min_level;
+		e.changed_columns[20] = e.max_level != original.max_level;
+		e.changed_columns[21] = e.timezone != original.timezone;
+		e.changed_columns[22] = e.maxclients != original.maxclients;
+		e.changed_columns[23] = e.ruleset != original.ruleset;
+		e.changed_columns[24] = e.underworld != original.underworld;
+		e.changed_columns[25] = e.minclip != original.minclip;
+		e.changed_columns[26] = e.maxclip != original.maxclip;
+		e.changed_columns[27] = e.fog_minclip != original.fog_minclip;
+		e.changed_columns[28] = e.fog_maxclip != original.fog_maxclip;
+		e.changed_columns[29] = e.fog_blue != original.fog_blue;
+		e.changed_columns[30] = e.fog_red != original.fog_red;
+		e.changed_columns[31] = e.fog_green != original.fog_green;
+		e.changed_columns[32] = e.sky != original.sky;
+		e.changed_columns[33] = e.ztype != original.ztype;
+		e.changed_columns[34] = e.zone_exp_multiplier != original.zone_exp_multiplier;
+		e.changed_columns[35] = e.walkspeed != original.walkspeed;
+		e.changed_columns[36] = e.time_type != original.time_type;
+		e.changed_columns[37] = e.fog_red1 != original.fog_red1;
+		e.changed_columns[38] = e.fog_green1 != original.fog_green1;
+		e.changed_columns[39] = e.fog_blue1 != original.fog_blue1;
+		e.changed_columns[40] = e.fog_minclip1 != original.fog_minclip1;
+		e.changed_columns[41] = e.fog_maxclip1 != original.fog_maxclip1;
+		e.changed_columns[42] = e.fog_red2 != original.fog_red2;
+		e.changed_columns[43] = e.fog_green2 != original.fog_green2;
+		e.changed_columns[44] = e.fog_blue2 != original.fog_blue2;
+		e.changed_columns[45] = e.fog_minclip2 != original.fog_minclip2;
+		e.changed_columns[46] = e.fog_maxclip2 != original.fog_maxclip2;
+		e.changed_columns[47] = e.fog_red3 != original.fog_red3;
+		e.changed_columns[48] = e.fog_green3 != original.fog_green3;
+		e.changed_columns[49] = e.fog_blue3 != original.fog_blue3;
+		e.changed_columns[50] = e.fog_minclip3 != original.fog_minclip3;
+		e.changed_columns[51] = e.fog_maxclip3 != original.fog_maxclip3;
+		e.changed_columns[52] = e.fog_red4 != original.fog_red4;
+		e.changed_columns[53] = e.fog_green4 != original.fog_green4;
+		e.changed_columns[54] = e.fog_blue4 != original.fog_blue4;
+		e.changed_columns[55] = e.fog_minclip4 != original.fog_minclip4;
+		e.changed_columns[56] = e.fog_maxclip4 != original.fog_maxclip4;
+		e.changed_columns[57] = e.fog_density != original.fog_density;
+		e.changed_columns[58] = e.flag_needed != original.flag_needed;
+		e.changed_columns[59] = e.canbind != original.canbind;
+		e.changed_columns[60] = e.cancombat != original.cancombat;
+		e.changed_columns[61] = e.canlevitate != original.canlevitate;
+		e.changed_columns[62] = e.castoutdoor != original.castoutdoor;
+		e.changed_columns[63] = e.hotzone != original.hotzone;
+		e.changed_columns[64] = e.insttype != original.insttype;
+		e.changed_columns[65] = e.shutdowndelay != original.shutdowndelay;
+		e.changed_columns[66] = e.peqzone != original.peqzone;
+		e.changed_columns[67] = e.bypass_expansion_check != original.bypass_expansion_check;
+		e.changed_columns[68] = e.suspendbuffs != original.suspendbuffs;
+		e.changed_columns[69] = e.rain_chance1 != original.rain_chance1;
+		e.changed_columns[70] = e.rain_chance2 != original.rain_chance2;
+		e.changed_columns[71] = e.rain_chance3 != original.rain_chance3;
+		e.changed_columns[72] = e.rain_chance4 != original.rain_chance4;
+		e.changed_columns[73] = e.rain_duration1 != original.rain_duration1;
+		e.changed_columns[74] = e.rain_duration2 != original.rain_duration2;
+		e.changed_columns[75] = e.rain_duration3 != original.rain_duration3;
+		e.changed_columns[76] = e.rain_duration4 != original.rain_duration4;
+		e.changed_columns[77] = e.snow_chance1 != original.snow_chance1;
+		e.changed_columns[78] = e.snow_chance2 != original.snow_chance2;
+		e.changed_columns[79] = e.snow_chance3 != original.snow_chance3;
+		e.changed_columns[80] = e.snow_chance4 != original.snow_chance4;
+		e.changed_columns[81] = e.snow_duration1 != original.snow_duration1;
+		e.changed_columns[82] = e.snow_duration2 != original.snow_duration2;
+		e.changed_columns[83] = e.snow_duration3 != original.snow_duration3;
+		e.changed_columns[84] = e.snow_duration4 != original.snow_duration4;
+		e.changed_columns[85] = e.gravity != original.gravity;
+		e.changed_columns[86] = e.type != original.type;
+		e.changed_columns[87] = e.skylock != original.skylock;
+		e.changed_columns[88] = e.fast_regen_hp != original.fast_regen_hp;
+		e.changed_columns[89] = e.fast_regen_mana != original.fast_regen_mana;
+		e.changed_columns[90] = e.fast_regen_endurance != original.fast_regen_endurance;
+		e.changed_columns[91] = e.npc_max_aggro_dist != original.npc_max_aggro_dist;
+		e.changed_columns[92] = e.client_update_range != original.client_update_range;
+		e.changed_columns[93] = e.underworld_teleport_index != original.underworld_teleport_index;
+		e.changed_columns[94] = e.lava_damage != original.lava_damage;
+		e.changed_columns[95] = e.min_lava_damage != original.min_lava_damage;
+		e.changed_columns[96] = e.idle_when_empty != original.idle_when_empty;
+		e.changed_columns[97] = e.seconds_before_idle != original.seconds_before_idle;
+		e.changed_columns[98] = e.shard_at_player_count != original.shard_at_player_count;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const Zone &e
@@ -639,104 +751,108 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zoneidnumber));
-		v.push_back(columns[2] + " = " + std::to_string(e.version));
-		v.push_back(columns[3] + " = '" + Strings::Escape(e.short_name) + "'");
-		v.push_back(columns[4] + " = '" + Strings::Escape(e.long_name) + "'");
-		v.push_back(columns[5] + " = " + std::to_string(e.min_status));
-		v.push_back(columns[6] + " = '" + Strings::Escape(e.map_file_name) + "'");
-		v.push_back(columns[7] + " = '" + Strings::Escape(e.note) + "'");
-		v.push_back(columns[8] + " = " + std::to_string(e.min_expansion));
-		v.push_back(columns[9] + " = " + std::to_string(e.max_expansion));
-		v.push_back(columns[10] + " = '" + Strings::Escape(e.content_flags) + "'");
-		v.push_back(columns[11] + " = '" + Strings::Escape(e.content_flags_disabled) + "'");
-		v.push_back(columns[12] + " = " + std::to_string(e.expansion));
-		v.push_back(columns[13] + " = '" + Strings::Escape(e.file_name) + "'");
-		v.push_back(columns[14] + " = " + std::to_string(e.safe_x));
-		v.push_back(columns[15] + " = " + std::to_string(e.safe_y));
-		v.push_back(columns[16] + " = " + std::to_string(e.safe_z));
-		v.push_back(columns[17] + " = " + std::to_string(e.safe_heading));
-		v.push_back(columns[18] + " = " + std::to_string(e.graveyard_id));
-		v.push_back(columns[19] + " = " + std::to_string(e.min_level));
-		v.push_back(columns[20] + " = " + std::to_string(e.max_level));
-		v.push_back(columns[21] + " = " + std::to_string(e.timezone));
-		v.push_back(columns[22] + " = " + std::to_string(e.maxclients));
-		v.push_back(columns[23] + " = " + std::to_string(e.ruleset));
-		v.push_back(columns[24] + " = " + std::to_string(e.underworld));
-		v.push_back(columns[25] + " = " + std::to_string(e.minclip));
-		v.push_back(columns[26] + " = " + std::to_string(e.maxclip));
-		v.push_back(columns[27] + " = " + std::to_string(e.fog_minclip));
-		v.push_back(columns[28] + " = " + std::to_string(e.fog_maxclip));
-		v.push_back(columns[29] + " = " + std::to_string(e.fog_blue));
-		v.push_back(columns[30] + " = " + std::to_string(e.fog_red));
-		v.push_back(columns[31] + " = " + std::to_string(e.fog_green));
-		v.push_back(columns[32] + " = " + std::to_string(e.sky));
-		v.push_back(columns[33] + " = " + std::to_string(e.ztype));
-		v.push_back(columns[34] + " = " + std::to_string(e.zone_exp_multiplier));
-		v.push_back(columns[35] + " = " + std::to_string(e.walkspeed));
-		v.push_back(columns[36] + " = " + std::to_string(e.time_type));
-		v.push_back(columns[37] + " = " + std::to_string(e.fog_red1));
-		v.push_back(columns[38] + " = " + std::to_string(e.fog_green1));
-		v.push_back(columns[39] + " = " + std::to_string(e.fog_blue1));
-		v.push_back(columns[40] + " = " + std::to_string(e.fog_minclip1));
-		v.push_back(columns[41] + " = " + std::to_string(e.fog_maxclip1));
-		v.push_back(columns[42] + " = " + std::to_string(e.fog_red2));
-		v.push_back(columns[43] + " = " + std::to_string(e.fog_green2));
-		v.push_back(columns[44] + " = " + std::to_string(e.fog_blue2));
-		v.push_back(columns[45] + " = " + std::to_string(e.fog_minclip2));
-		v.push_back(columns[46] + " = " + std::to_string(e.fog_maxclip2));
-		v.push_back(columns[47] + " = " + std::to_string(e.fog_red3));
-		v.push_back(columns[48] + " = " + std::to_string(e.fog_green3));
-		v.push_back(columns[49] + " = " + std::to_string(e.fog_blue3));
-		v.push_back(columns[50] + " = " + std::to_string(e.fog_minclip3));
-		v.push_back(columns[51] + " = " + std::to_string(e.fog_maxclip3));
-		v.push_back(columns[52] + " = " + std::to_string(e.fog_red4));
-		v.push_back(columns[53] + " = " + std::to_string(e.fog_green4));
-		v.push_back(columns[54] + " = " + std::to_string(e.fog_blue4));
-		v.push_back(columns[55] + " = " + std::to_string(e.fog_minclip4));
-		v.push_back(columns[56] + " = " + std::to_string(e.fog_maxclip4));
-		v.push_back(columns[57] + " = " + std::to_string(e.fog_density));
-		v.push_back(columns[58] + " = '" + Strings::Escape(e.flag_needed) + "'");
-		v.push_back(columns[59] + " = " + std::to_string(e.canbind));
-		v.push_back(columns[60] + " = " + std::to_string(e.cancombat));
-		v.push_back(columns[61] + " = " + std::to_string(e.canlevitate));
-		v.push_back(columns[62] + " = " + std::to_string(e.castoutdoor));
-		v.push_back(columns[63] + " = " + std::to_string(e.hotzone));
-		v.push_back(columns[64] + " = " + std::to_string(e.insttype));
-		v.push_back(columns[65] + " = " + std::to_string(e.shutdowndelay));
-		v.push_back(columns[66] + " = " + std::to_string(e.peqzone));
-		v.push_back(columns[67] + " = " + std::to_string(e.bypass_expansion_check));
-		v.push_back(columns[68] + " = " + std::to_string(e.suspendbuffs));
-		v.push_back(columns[69] + " = " + std::to_string(e.rain_chance1));
-		v.push_back(columns[70] + " = " + std::to_string(e.rain_chance2));
-		v.push_back(columns[71] + " = " + std::to_string(e.rain_chance3));
-		v.push_back(columns[72] + " = " + std::to_string(e.rain_chance4));
-		v.push_back(columns[73] + " = " + std::to_string(e.rain_duration1));
-		v.push_back(columns[74] + " = " + std::to_string(e.rain_duration2));
-		v.push_back(columns[75] + " = " + std::to_string(e.rain_duration3));
-		v.push_back(columns[76] + " = " + std::to_string(e.rain_duration4));
-		v.push_back(columns[77] + " = " + std::to_string(e.snow_chance1));
-		v.push_back(columns[78] + " = " + std::to_string(e.snow_chance2));
-		v.push_back(columns[79] + " = " + std::to_string(e.snow_chance3));
-		v.push_back(columns[80] + " = " + std::to_string(e.snow_chance4));
-		v.push_back(columns[81] + " = " + std::to_string(e.snow_duration1));
-		v.push_back(columns[82] + " = " + std::to_string(e.snow_duration2));
-		v.push_back(columns[83] + " = " + std::to_string(e.snow_duration3));
-		v.push_back(columns[84] + " = " + std::to_string(e.snow_duration4));
-		v.push_back(columns[85] + " = " + std::to_string(e.gravity));
-		v.push_back(columns[86] + " = " + std::to_string(e.type));
-		v.push_back(columns[87] + " = " + std::to_string(e.skylock));
-		v.push_back(columns[88] + " = " + std::to_string(e.fast_regen_hp));
-		v.push_back(columns[89] + " = " + std::to_string(e.fast_regen_mana));
-		v.push_back(columns[90] + " = " + std::to_string(e.fast_regen_endurance));
-		v.push_back(columns[91] + " = " + std::to_string(e.npc_max_aggro_dist));
-		v.push_back(columns[92] + " = " + std::to_string(e.client_update_range));
-		v.push_back(columns[93] + " = " + std::to_string(e.underworld_teleport_index));
-		v.push_back(columns[94] + " = " + std::to_string(e.lava_damage));
-		v.push_back(columns[95] + " = " + std::to_string(e.min_lava_damage));
-		v.push_back(columns[96] + " = " + std::to_string(e.idle_when_empty));
-		v.push_back(columns[97] + " = " + std::to_string(e.seconds_before_idle));
-		v.push_back(columns[98] + " = " + std::to_string(e.shard_at_player_count));
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zoneidnumber)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.version)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = '" + Strings::Escape(e.short_name) + "'"); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = '" + Strings::Escape(e.long_name) + "'"); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.min_status)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = '" + Strings::Escape(e.map_file_name) + "'"); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = '" + Strings::Escape(e.note) + "'"); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.min_expansion)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.max_expansion)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = '" + Strings::Escape(e.content_flags) + "'"); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = '" + Strings::Escape(e.content_flags_disabled) + "'"); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.expansion)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = '" + Strings::Escape(e.file_name) + "'"); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.safe_x)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.safe_y)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.safe_z)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.safe_heading)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.graveyard_id)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.min_level)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.max_level)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.timezone)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = " + std::to_string(e.maxclients)); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = " + std::to_string(e.ruleset)); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = " + std::to_string(e.underworld)); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.minclip)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.maxclip)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.fog_minclip)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = " + std::to_string(e.fog_maxclip)); }
+		if (e.changed_columns[29]) { v.push_back(columns[29] + " = " + std::to_string(e.fog_blue)); }
+		if (e.changed_columns[30]) { v.push_back(columns[30] + " = " + std::to_string(e.fog_red)); }
+		if (e.changed_columns[31]) { v.push_back(columns[31] + " = " + std::to_string(e.fog_green)); }
+		if (e.changed_columns[32]) { v.push_back(columns[32] + " = " + std::to_string(e.sky)); }
+		if (e.changed_columns[33]) { v.push_back(columns[33] + " = " + std::to_string(e.ztype)); }
+		if (e.changed_columns[34]) { v.push_back(columns[34] + " = " + std::to_string(e.zone_exp_multiplier)); }
+		if (e.changed_columns[35]) { v.push_back(columns[35] + " = " + std::to_string(e.walkspeed)); }
+		if (e.changed_columns[36]) { v.push_back(columns[36] + " = " + std::to_string(e.time_type)); }
+		if (e.changed_columns[37]) { v.push_back(columns[37] + " = " + std::to_string(e.fog_red1)); }
+		if (e.changed_columns[38]) { v.push_back(columns[38] + " = " + std::to_string(e.fog_green1)); }
+		if (e.changed_columns[39]) { v.push_back(columns[39] + " = " + std::to_string(e.fog_blue1)); }
+		if (e.changed_columns[40]) { v.push_back(columns[40] + " = " + std::to_string(e.fog_minclip1)); }
+		if (e.changed_columns[41]) { v.push_back(columns[41] + " = " + std::to_string(e.fog_maxclip1)); }
+		if (e.changed_columns[42]) { v.push_back(columns[42] + " = " + std::to_string(e.fog_red2)); }
+		if (e.changed_columns[43]) { v.push_back(columns[43] + " = " + std::to_string(e.fog_green2)); }
+		if (e.changed_columns[44]) { v.push_back(columns[44] + " = " + std::to_string(e.fog_blue2)); }
+		if (e.changed_columns[45]) { v.push_back(columns[45] + " = " + std::to_string(e.fog_minclip2)); }
+		if (e.changed_columns[46]) { v.push_back(columns[46] + " = " + std::to_string(e.fog_maxclip2)); }
+		if (e.changed_columns[47]) { v.push_back(columns[47] + " = " + std::to_string(e.fog_red3)); }
+		if (e.changed_columns[48]) { v.push_back(columns[48] + " = " + std::to_string(e.fog_green3)); }
+		if (e.changed_columns[49]) { v.push_back(columns[49] + " = " + std::to_string(e.fog_blue3)); }
+		if (e.changed_columns[50]) { v.push_back(columns[50] + " = " + std::to_string(e.fog_minclip3)); }
+		if (e.changed_columns[51]) { v.push_back(columns[51] + " = " + std::to_string(e.fog_maxclip3)); }
+		if (e.changed_columns[52]) { v.push_back(columns[52] + " = " + std::to_string(e.fog_red4)); }
+		if (e.changed_columns[53]) { v.push_back(columns[53] + " = " + std::to_string(e.fog_green4)); }
+		if (e.changed_columns[54]) { v.push_back(columns[54] + " = " + std::to_string(e.fog_blue4)); }
+		if (e.changed_columns[55]) { v.push_back(columns[55] + " = " + std::to_string(e.fog_minclip4)); }
+		if (e.changed_columns[56]) { v.push_back(columns[56] + " = " + std::to_string(e.fog_maxclip4)); }
+		if (e.changed_columns[57]) { v.push_back(columns[57] + " = " + std::to_string(e.fog_density)); }
+		if (e.changed_columns[58]) { v.push_back(columns[58] + " = '" + Strings::Escape(e.flag_needed) + "'"); }
+		if (e.changed_columns[59]) { v.push_back(columns[59] + " = " + std::to_string(e.canbind)); }
+		if (e.changed_columns[60]) { v.push_back(columns[60] + " = " + std::to_string(e.cancombat)); }
+		if (e.changed_columns[61]) { v.push_back(columns[61] + " = " + std::to_string(e.canlevitate)); }
+		if (e.changed_columns[62]) { v.push_back(columns[62] + " = " + std::to_string(e.castoutdoor)); }
+		if (e.changed_columns[63]) { v.push_back(columns[63] + " = " + std::to_string(e.hotzone)); }
+		if (e.changed_columns[64]) { v.push_back(columns[64] + " = " + std::to_string(e.insttype)); }
+		if (e.changed_columns[65]) { v.push_back(columns[65] + " = " + std::to_string(e.shutdowndelay)); }
+		if (e.changed_columns[66]) { v.push_back(columns[66] + " = " + std::to_string(e.peqzone)); }
+		if (e.changed_columns[67]) { v.push_back(columns[67] + " = " + std::to_string(e.bypass_expansion_check)); }
+		if (e.changed_columns[68]) { v.push_back(columns[68] + " = " + std::to_string(e.suspendbuffs)); }
+		if (e.changed_columns[69]) { v.push_back(columns[69] + " = " + std::to_string(e.rain_chance1)); }
+		if (e.changed_columns[70]) { v.push_back(columns[70] + " = " + std::to_string(e.rain_chance2)); }
+		if (e.changed_columns[71]) { v.push_back(columns[71] + " = " + std::to_string(e.rain_chance3)); }
+		if (e.changed_columns[72]) { v.push_back(columns[72] + " = " + std::to_string(e.rain_chance4)); }
+		if (e.changed_columns[73]) { v.push_back(columns[73] + " = " + std::to_string(e.rain_duration1)); }
+		if (e.changed_columns[74]) { v.push_back(columns[74] + " = " + std::to_string(e.rain_duration2)); }
+		if (e.changed_columns[75]) { v.push_back(columns[75] + " = " + std::to_string(e.rain_duration3)); }
+		if (e.changed_columns[76]) { v.push_back(columns[76] + " = " + std::to_string(e.rain_duration4)); }
+		if (e.changed_columns[77]) { v.push_back(columns[77] + " = " + std::to_string(e.snow_chance1)); }
+		if (e.changed_columns[78]) { v.push_back(columns[78] + " = " + std::to_string(e.snow_chance2)); }
+		if (e.changed_columns[79]) { v.push_back(columns[79] + " = " + std::to_string(e.snow_chance3)); }
+		if (e.changed_columns[80]) { v.push_back(columns[80] + " = " + std::to_string(e.snow_chance4)); }
+		if (e.changed_columns[81]) { v.push_back(columns[81] + " = " + std::to_string(e.snow_duration1)); }
+		if (e.changed_columns[82]) { v.push_back(columns[82] + " = " + std::to_string(e.snow_duration2)); }
+		if (e.changed_columns[83]) { v.push_back(columns[83] + " = " + std::to_string(e.snow_duration3)); }
+		if (e.changed_columns[84]) { v.push_back(columns[84] + " = " + std::to_string(e.snow_duration4)); }
+		if (e.changed_columns[85]) { v.push_back(columns[85] + " = " + std::to_string(e.gravity)); }
+		if (e.changed_columns[86]) { v.push_back(columns[86] + " = " + std::to_string(e.type)); }
+		if (e.changed_columns[87]) { v.push_back(columns[87] + " = " + std::to_string(e.skylock)); }
+		if (e.changed_columns[88]) { v.push_back(columns[88] + " = " + std::to_string(e.fast_regen_hp)); }
+		if (e.changed_columns[89]) { v.push_back(columns[89] + " = " + std::to_string(e.fast_regen_mana)); }
+		if (e.changed_columns[90]) { v.push_back(columns[90] + " = " + std::to_string(e.fast_regen_endurance)); }
+		if (e.changed_columns[91]) { v.push_back(columns[91] + " = " + std::to_string(e.npc_max_aggro_dist)); }
+		if (e.changed_columns[92]) { v.push_back(columns[92] + " = " + std::to_string(e.client_update_range)); }
+		if (e.changed_columns[93]) { v.push_back(columns[93] + " = " + std::to_string(e.underworld_teleport_index)); }
+		if (e.changed_columns[94]) { v.push_back(columns[94] + " = " + std::to_string(e.lava_damage)); }
+		if (e.changed_columns[95]) { v.push_back(columns[95] + " = " + std::to_string(e.min_lava_damage)); }
+		if (e.changed_columns[96]) { v.push_back(columns[96] + " = " + std::to_string(e.idle_when_empty)); }
+		if (e.changed_columns[97]) { v.push_back(columns[97] + " = " + std::to_string(e.seconds_before_idle)); }
+		if (e.changed_columns[98]) { v.push_back(columns[98] + " = " + std::to_string(e.shard_at_player_count)); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -1247,6 +1363,154 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static Zone FromStmtRow(const mysql::StmtRow &row)
+	{
+		Zone e{};
+
+		e.id                        = row.Get<int32_t>(0).value_or(0);
+		e.zoneidnumber              = row.Get<int32_t>(1).value_or(0);
+		e.version                   = row.Get<uint8_t>(2).value_or(0);
+		e.short_name                = row.GetStr(3).value_or("");
+		e.long_name                 = row.GetStr(4).value_or("");
+		e.min_status                = row.Get<uint8_t>(5).value_or(0);
+		e.map_file_name             = row.GetStr(6).value_or("");
+		e.note                      = row.GetStr(7).value_or("");
+		e.min_expansion             = row.Get<int8_t>(8).value_or(-1);
+		e.max_expansion             = row.Get<int8_t>(9).value_or(-1);
+		e.content_flags             = row.GetStr(10).value_or("");
+		e.content_flags_disabled    = row.GetStr(11).value_or("");
+		e.expansion                 = row.Get<int8_t>(12).value_or(0);
+		e.file_name                 = row.GetStr(13).value_or("");
+		e.safe_x                    = row.Get<float>(14).value_or(0);
+		e.safe_y                    = row.Get<float>(15).value_or(0);
+		e.safe_z                    = row.Get<float>(16).value_or(0);
+		e.safe_heading              = row.Get<float>(17).value_or(0);
+		e.graveyard_id              = row.Get<float>(18).value_or(0);
+		e.min_level                 = row.Get<uint8_t>(19).value_or(0);
+		e.max_level                 = row.Get<uint8_t>(20).value_or(255);
+		e.timezone                  = row.Get<int32_t>(21).value_or(0);
+		e.maxclients                = row.Get<int32_t>(22).value_or(0);
+		e.ruleset                   = row.Get<uint32_t>(23).value_or(0);
+		e.underworld                = row.Get<float>(24).value_or(0);
+		e.minclip                   = row.Get<float>(25).value_or(450);
+		e.maxclip                   = row.Get<float>(26).value_or(450);
+		e.fog_minclip               = row.Get<float>(27).value_or(450);
+		e.fog_maxclip               = row.Get<float>(28).value_or(450);
+		e.fog_blue                  = row.Get<uint8_t>(29).value_or(0);
+		e.fog_red                   = row.Get<uint8_t>(30).value_or(0);
+		e.fog_green                 = row.Get<uint8_t>(31).value_or(0);
+		e.sky                       = row.Get<uint8_t>(32).value_or(1);
+		e.ztype                     = row.Get<uint8_t>(33).value_or(1);
+		e.zone_exp_multiplier       = row.Get<float>(34).value_or(0.00);
+		e.walkspeed                 = row.Get<float>(35).value_or(0.4);
+		e.time_type                 = row.Get<uint8_t>(36).value_or(2);
+		e.fog_red1                  = row.Get<uint8_t>(37).value_or(0);
+		e.fog_green1                = row.Get<uint8_t>(38).value_or(0);
+		e.fog_blue1                 = row.Get<uint8_t>(39).value_or(0);
+		e.fog_minclip1              = row.Get<float>(40).value_or(450);
+		e.fog_maxclip1              = row.Get<float>(41).value_or(450);
+		e.fog_red2                  = row.Get<uint8_t>(42).value_or(0);
+		e.fog_green2                = row.Get<uint8_t>(43).value_or(0);
+		e.fog_blue2                 = row.Get<uint8_t>(44).value_or(0);
+		e.fog_minclip2              = row.Get<float>(45).value_or(450);
+		e.fog_maxclip2              = row.Get<float>(46).value_or(450);
+		e.fog_red3                  = row.Get<uint8_t>(47).value_or(0);
+		e.fog_green3                = row.Get<uint8_t>(48).value_or(0);
+		e.fog_blue3                 = row.Get<uint8_t>(49).value_or(0);
+		e.fog_minclip3              = row.Get<float>(50).value_or(450);
+		e.fog_maxclip3              = row.Get<float>(51).value_or(450);
+		e.fog_red4                  = row.Get<uint8_t>(52).value_or(0);
+		e.fog_green4                = row.Get<uint8_t>(53).value_or(0);
+		e.fog_blue4                 = row.Get<uint8_t>(54).value_or(0);
+		e.fog_minclip4              = row.Get<float>(55).value_or(450);
+		e.fog_maxclip4              = row.Get<float>(56).value_or(450);
+		e.fog_density               = row.Get<float>(57).value_or(0);
+		e.flag_needed               = row.GetStr(58).value_or("");
+		e.canbind                   = row.Get<int8_t>(59).value_or(1);
+		e.cancombat                 = row.Get<int8_t>(60).value_or(1);
+		e.canlevitate               = row.Get<int8_t>(61).value_or(1);
+		e.castoutdoor               = row.Get<int8_t>(62).value_or(1);
+		e.hotzone                   = row.Get<uint8_t>(63).value_or(0);
+		e.insttype                  = row.Get<uint8_t>(64).value_or(0);
+		e.shutdowndelay             = row.Get<uint64_t>(65).value_or(5000);
+		e.peqzone                   = row.Get<int8_t>(66).value_or(1);
+		e.bypass_expansion_check    = row.Get<int8_t>(67).value_or(0);
+		e.suspendbuffs              = row.Get<uint8_t>(68).value_or(0);
+		e.rain_chance1              = row.Get<int32_t>(69).value_or(0);
+		e.rain_chance2              = row.Get<int32_t>(70).value_or(0);
+		e.rain_chance3              = row.Get<int32_t>(71).value_or(0);
+		e.rain_chance4              = row.Get<int32_t>(72).value_or(0);
+		e.rain_duration1            = row.Get<int32_t>(73).value_or(0);
+		e.rain_duration2            = row.Get<int32_t>(74).value_or(0);
+		e.rain_duration3            = row.Get<int32_t>(75).value_or(0);
+		e.rain_duration4            = row.Get<int32_t>(76).value_or(0);
+		e.snow_chance1              = row.Get<int32_t>(77).value_or(0);
+		e.snow_chance2              = row.Get<int32_t>(78).value_or(0);
+		e.snow_chance3              = row.Get<int32_t>(79).value_or(0);
+		e.snow_chance4              = row.Get<int32_t>(80).value_or(0);
+		e.snow_duration1            = row.Get<int32_t>(81).value_or(0);
+		e.snow_duration2            = row.Get<int32_t>(82).value_or(0);
+		e.snow_duration3            = row.Get<int32_t>(83).value_or(0);
+		e.snow_duration4            = row.Get<int32_t>(84).value_or(0);
+		e.gravity                   = row.Get<float>(85).value_or(0.4);
+		e.type                      = row.Get<int32_t>(86).value_or(0);
+		e.skylock                   = row.Get<int8_t>(87).value_or(0);
+		e.fast_regen_hp             = row.Get<int32_t>(88).value_or(180);
+		e.fast_regen_mana           = row.Get<int32_t>(89).value_or(180);
+		e.fast_regen_endurance      = row.Get<int32_t>(90).value_or(180);
+		e.npc_max_aggro_dist        = row.Get<int32_t>(91).value_or(600);
+		e.client_update_range       = row.Get<uint32_t>(92).value_or(600);
+		e.underworld_teleport_index = row.Get<int32_t>(93).value_or(0);
+		e.lava_damage               = row.Get<int32_t>(94).value_or(50);
+		e.min_lava_damage           = row.Get<int32_t>(95).value_or(10);
+		e.idle_when_empty           = row.Get<uint8_t>(96).value_or(1);
+		e.seconds_before_idle       = row.Get<uint32_t>(97).value_or(60);
+		e.shard_at_player_count     = row.Get<int32_t>(98).value_or(0);
+
+		return e;
+	}
+
+	static Zone FindOnePrepared(
+		Database& db,
+		int zone_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { zone_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<Zone> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<Zone> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -1432,7 +1696,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<99> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -1538,13 +1810,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -14,6 +14,8 @@
 
 #include "../../database.h"
 #include "../../strings.h"
+#include "../../mysql_stmt.h"
+#include <bitset>
 #include <ctime>
 
 class BaseZoneStateSpawnsRepository {
@@ -48,6 +50,9 @@ public:
 		int64_t     mana;
 		int64_t     endurance;
 		time_t      created_at;
+
+		// columns UpdateOne and ReplaceMany write, all of them unless MarkChanged narrowed it down
+		std::bitset<29> changed_columns = std::bitset<29>().set();
 	};
 
 	static std::string PrimaryKey()
@@ -280,6 +285,43 @@ public:
 		return (results.Success() ? results.RowsAffected() : 0);
 	}
 
+	// keeps only the columns of e that differ from original, the next write leaves the rest alone
+	static void MarkChanged(
+		ZoneStateSpawns &e,
+		const ZoneStateSpawns &original
+	)
+	{
+		e.changed_columns[0] = e.id != original.id;
+		e.changed_columns[1] = e.zone_id != original.zone_id;
+		e.changed_columns[2] = e.instance_id != original.instance_id;
+		e.changed_columns[3] = e.is_corpse != original.is_corpse;
+		e.changed_columns[4] = e.is_zone != original.is_zone;
+		e.changed_columns[5] = e.decay_in_seconds != original.decay_in_seconds;
+		e.changed_columns[6] = e.npc_id != original.npc_id;
+		e.changed_columns[7] = e.spawn2_id != original.spawn2_id;
+		e.changed_columns[8] = e.spawngroup_id != original.spawngroup_id;
+		e.changed_columns[9] = e.x != original.x;
+		e.changed_columns[10] = e.y != original.y;
+		e.changed_columns[11] = e.z != original.z;
+		e.changed_columns[12] = e.heading != original.heading;
+		e.changed_columns[13] = e.respawn_time != original.respawn_time;
+		e.changed_columns[14] = e.variance != original.variance;
+		e.changed_columns[15] = e.grid != original.grid;
+		e.changed_columns[16] = e.current_waypoint != original.current_waypoint;
+		e.changed_columns[17] = e.path_when_zone_idle != original.path_when_zone_idle;
+		e.changed_columns[18] = e.condition_id != original.condition_id;
+		e.changed_columns[19] = e.condition_min_value != original.condition_min_value;
+		e.changed_columns[20] = e.enabled != original.enabled;
+		e.changed_columns[21] = e.anim != original.anim;
+		e.changed_columns[22] = e.loot_data != original.loot_data;
+		e.changed_columns[23] = e.entity_variables != original.entity_variables;
+		e.changed_columns[24] = e.buffs != original.buffs;
+		e.changed_columns[25] = e.hp != original.hp;
+		e.changed_columns[26] = e.mana != original.mana;
+		e.changed_columns[27] = e.endurance != original.endurance;
+		e.changed_columns[28] = e.created_at != original.created_at;
+	}
+
 	static int UpdateOne(
 		Database& db,
 		const ZoneStateSpawns &e
@@ -289,34 +331,38 @@ public:
 
 		auto columns = Columns();
 
-		v.push_back(columns[1] + " = " + std::to_string(e.zone_id));
-		v.push_back(columns[2] + " = " + std::to_string(e.instance_id));
-		v.push_back(columns[3] + " = " + std::to_string(e.is_corpse));
-		v.push_back(columns[4] + " = " + std::to_string(e.is_zone));
-		v.push_back(columns[5] + " = " + std::to_string(e.decay_in_seconds));
-		v.push_back(columns[6] + " = " + std::to_string(e.npc_id));
-		v.push_back(columns[7] + " = " + std::to_string(e.spawn2_id));
-		v.push_back(columns[8] + " = " + std::to_string(e.spawngroup_id));
-		v.push_back(columns[9] + " = " + std::to_string(e.x));
-		v.push_back(columns[10] + " = " + std::to_string(e.y));
-		v.push_back(columns[11] + " = " + std::to_string(e.z));
-		v.push_back(columns[12] + " = " + std::to_string(e.heading));
-		v.push_back(columns[13] + " = " + std::to_string(e.respawn_time));
-		v.push_back(columns[14] + " = " + std::to_string(e.variance));
-		v.push_back(columns[15] + " = " + std::to_string(e.grid));
-		v.push_back(columns[16] + " = " + std::to_string(e.current_waypoint));
-		v.push_back(columns[17] + " = " + std::to_string(e.path_when_zone_idle));
-		v.push_back(columns[18] + " = " + std::to_string(e.condition_id));
-		v.push_back(columns[19] + " = " + std::to_string(e.condition_min_value));
-		v.push_back(columns[20] + " = " + std::to_string(e.enabled));
-		v.push_back(columns[21] + " = " + std::to_string(e.anim));
-		v.push_back(columns[22] + " = '" + Strings::Escape(e.loot_data) + "'");
-		v.push_back(columns[23] + " = '" + Strings::Escape(e.entity_variables) + "'");
-		v.push_back(columns[24] + " = '" + Strings::Escape(e.buffs) + "'");
-		v.push_back(columns[25] + " = " + std::to_string(e.hp));
-		v.push_back(columns[26] + " = " + std::to_string(e.mana));
-		v.push_back(columns[27] + " = " + std::to_string(e.endurance));
-		v.push_back(columns[28] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")");
+		if (e.changed_columns[1]) { v.push_back(columns[1] + " = " + std::to_string(e.zone_id)); }
+		if (e.changed_columns[2]) { v.push_back(columns[2] + " = " + std::to_string(e.instance_id)); }
+		if (e.changed_columns[3]) { v.push_back(columns[3] + " = " + std::to_string(e.is_corpse)); }
+		if (e.changed_columns[4]) { v.push_back(columns[4] + " = " + std::to_string(e.is_zone)); }
+		if (e.changed_columns[5]) { v.push_back(columns[5] + " = " + std::to_string(e.decay_in_seconds)); }
+		if (e.changed_columns[6]) { v.push_back(columns[6] + " = " + std::to_string(e.npc_id)); }
+		if (e.changed_columns[7]) { v.push_back(columns[7] + " = " + std::to_string(e.spawn2_id)); }
+		if (e.changed_columns[8]) { v.push_back(columns[8] + " = " + std::to_string(e.spawngroup_id)); }
+		if (e.changed_columns[9]) { v.push_back(columns[9] + " = " + std::to_string(e.x)); }
+		if (e.changed_columns[10]) { v.push_back(columns[10] + " = " + std::to_string(e.y)); }
+		if (e.changed_columns[11]) { v.push_back(columns[11] + " = " + std::to_string(e.z)); }
+		if (e.changed_columns[12]) { v.push_back(columns[12] + " = " + std::to_string(e.heading)); }
+		if (e.changed_columns[13]) { v.push_back(columns[13] + " = " + std::to_string(e.respawn_time)); }
+		if (e.changed_columns[14]) { v.push_back(columns[14] + " = " + std::to_string(e.variance)); }
+		if (e.changed_columns[15]) { v.push_back(columns[15] + " = " + std::to_string(e.grid)); }
+		if (e.changed_columns[16]) { v.push_back(columns[16] + " = " + std::to_string(e.current_waypoint)); }
+		if (e.changed_columns[17]) { v.push_back(columns[17] + " = " + std::to_string(e.path_when_zone_idle)); }
+		if (e.changed_columns[18]) { v.push_back(columns[18] + " = " + std::to_string(e.condition_id)); }
+		if (e.changed_columns[19]) { v.push_back(columns[19] + " = " + std::to_string(e.condition_min_value)); }
+		if (e.changed_columns[20]) { v.push_back(columns[20] + " = " + std::to_string(e.enabled)); }
+		if (e.changed_columns[21]) { v.push_back(columns[21] + " = " + std::to_string(e.anim)); }
+		if (e.changed_columns[22]) { v.push_back(columns[22] + " = '" + Strings::Escape(e.loot_data) + "'"); }
+		if (e.changed_columns[23]) { v.push_back(columns[23] + " = '" + Strings::Escape(e.entity_variables) + "'"); }
+		if (e.changed_columns[24]) { v.push_back(columns[24] + " = '" + Strings::Escape(e.buffs) + "'"); }
+		if (e.changed_columns[25]) { v.push_back(columns[25] + " = " + std::to_string(e.hp)); }
+		if (e.changed_columns[26]) { v.push_back(columns[26] + " = " + std::to_string(e.mana)); }
+		if (e.changed_columns[27]) { v.push_back(columns[27] + " = " + std::to_string(e.endurance)); }
+		if (e.changed_columns[28]) { v.push_back(columns[28] + " = FROM_UNIXTIME(" + (e.created_at > 0 ? std::to_string(e.created_at) : "null") + ")"); }
+
+		if (v.empty()) {
+			return 0;
+		}
 
 		auto results = db.QueryDatabase(
 			fmt::format(
@@ -547,6 +593,84 @@ public:
 		return all_entries;
 	}
 
+	// binary protocol row, columns arrive in their server types so nothing is parsed from text
+	static ZoneStateSpawns FromStmtRow(const mysql::StmtRow &row)
+	{
+		ZoneStateSpawns e{};
+
+		e.id                  = row.Get<int64_t>(0).value_or(0);
+		e.zone_id             = row.Get<uint32_t>(1).value_or(0);
+		e.instance_id         = row.Get<uint32_t>(2).value_or(0);
+		e.is_corpse           = row.Get<int8_t>(3).value_or(0);
+		e.is_zone             = row.Get<int8_t>(4).value_or(0);
+		e.decay_in_seconds    = row.Get<int32_t>(5).value_or(0);
+		e.npc_id              = row.Get<uint32_t>(6).value_or(0);
+		e.spawn2_id           = row.Get<uint32_t>(7).value_or(0);
+		e.spawngroup_id       = row.Get<uint32_t>(8).value_or(0);
+		e.x                   = row.Get<float>(9).value_or(0);
+		e.y                   = row.Get<float>(10).value_or(0);
+		e.z                   = row.Get<float>(11).value_or(0);
+		e.heading             = row.Get<float>(12).value_or(0);
+		e.respawn_time        = row.Get<uint32_t>(13).value_or(0);
+		e.variance            = row.Get<uint32_t>(14).value_or(0);
+		e.grid                = row.Get<uint32_t>(15).value_or(0);
+		e.current_waypoint    = row.Get<int32_t>(16).value_or(0);
+		e.path_when_zone_idle = row.Get<int16_t>(17).value_or(0);
+		e.condition_id        = row.Get<uint16_t>(18).value_or(0);
+		e.condition_min_value = row.Get<int16_t>(19).value_or(0);
+		e.enabled             = row.Get<int16_t>(20).value_or(1);
+		e.anim                = row.Get<uint16_t>(21).value_or(0);
+		e.loot_data           = row.GetStr(22).value_or("");
+		e.entity_variables    = row.GetStr(23).value_or("");
+		e.buffs               = row.GetStr(24).value_or("");
+		e.hp                  = row.Get<int64_t>(25).value_or(0);
+		e.mana                = row.Get<int64_t>(26).value_or(0);
+		e.endurance           = row.Get<int64_t>(27).value_or(0);
+		e.created_at          = row.Get<int64_t>(28).value_or(-1);
+
+		return e;
+	}
+
+	static ZoneStateSpawns FindOnePrepared(
+		Database& db,
+		int zone_state_spawns_id
+	)
+	{
+		auto entries = GetWherePrepared(db, fmt::format("{} = ? LIMIT 1", PrimaryKey()), { zone_state_spawns_id });
+
+		return entries.size() == 1 ? entries.front() : NewEntity();
+	}
+
+	// where_filter takes ? placeholders bound from params, one statement is cached per filter
+	static std::vector<ZoneStateSpawns> GetWherePrepared(
+		Database& db,
+		const std::string &where_filter,
+		const std::vector<mysql::PreparedStmt::param_t> &params = {}
+	)
+	{
+		std::vector<ZoneStateSpawns> all_entries;
+
+		const auto query = fmt::format("{} WHERE {}", BaseSelect(), where_filter);
+
+		try {
+			auto &stmt   = db.PrepareCached(query);
+			auto results = stmt.Execute(params);
+
+			all_entries.reserve(results.RowCount());
+
+			for (auto row = stmt.Fetch(); row; row = stmt.Fetch()) {
+				all_entries.push_back(FromStmtRow(row));
+			}
+		}
+		catch (const std::exception &ex) {
+			LogMySQLError("[{}] [{}]", ex.what(), query);
+			db.ForgetPrepared(query);
+			all_entries.clear();
+		}
+
+		return all_entries;
+	}
+
 	static int DeleteWhere(Database& db, const std::string &where_filter)
 	{
 		auto results = db.QueryDatabase(
@@ -662,7 +786,15 @@ public:
 	{
 		std::vector<std::string> insert_chunks;
 
+		std::bitset<29> changed;
+
 		for (auto &e: entries) {
+			if (e.changed_columns.none()) {
+				continue;
+			}
+
+			changed |= e.changed_columns;
+
 			std::vector<std::string> v;
 
 			v.push_back(std::to_string(e.id));
@@ -698,13 +830,38 @@ public:
 			insert_chunks.push_back("(" + Strings::Implode(",", v) + ")");
 		}
 
+		if (insert_chunks.empty()) {
+			return 0;
+		}
+
+		if (changed.all()) {
+			auto results = db.QueryDatabase(
+				fmt::format(
+					"{} VALUES {}",
+					BaseReplace(),
+					Strings::Implode(",", insert_chunks)
+				)
+			);
+
+			return (results.Success() ? results.RowsAffected() : 0);
+		}
+
+		// existing rows only take the changed columns, new rows are inserted whole
 		std::vector<std::string> v;
 
+		auto columns = Columns();
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (changed[i]) {
+				v.push_back(fmt::format("{0} = VALUES({0})", columns[i]));
+			}
+		}
+
 		auto results = db.QueryDatabase(
 			fmt::format(
-				"{} VALUES {}",
-				BaseReplace(),
-				Strings::Implode(",", insert_chunks)
+				"{} VALUES {} ON DUPLICATE KEY UPDATE {}",
+				BaseInsert(),
+				Strings::Implode(",", insert_chunks),
+				Strings::Implode(", ", v)
 			)
 		);
 
@@ -45,6 +45,40 @@ public:
 
 	// Custom extended repository methods here
 
+	// same statement as UpdateOne, queued on the async pool with the bucket id as its order key
+	static void UpdateOneAsync(
+		Database& db,
+		const DataBuckets &e,
+		DBcore::AsyncQueryCallback callback = nullptr
+	)
+	{
+		std::vector<std::string> v;
+
+		auto columns = Columns();
+
+		v.push_back(columns[1] + " = '" + Strings::Escape(e.key_) + "'");
+		v.push_back(columns[2] + " = '" + Strings::Escape(e.value) + "'");
+		v.push_back(columns[3] + " = " + std::to_string(e.expires));
+		v.push_back(columns[4] + " = " + std::to_string(e.account_id));
+		v.push_back(columns[5] + " = " + std::to_string(e.character_id));
+		v.push_back(columns[6] + " = " + std::to_string(e.npc_id));
+		v.push_back(columns[7] + " = " + std::to_string(e.bot_id));
+		v.push_back(columns[8] + " = " + std::to_string(e.zone_id));
+		v.push_back(columns[9] + " = " + std::to_string(e.instance_id));
+
+		db.QueryDatabaseAsync(
+			fmt::format(
+				"UPDATE {} SET {} WHERE {} = {}",
+				TableName(),
+				Strings::Implode(", ", v),
+				PrimaryKey(),
+				e.id
+			),
+			std::move(callback),
+			e.id
+		);
+	}
+
 };
 
 #endif //EQEMU_DATA_BUCKETS_REPOSITORY_H
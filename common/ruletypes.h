@@ -161,6 +161,7 @@ RULE_INT(Character, IksarCommonTongue, 95, "Starting value for Common Tongue for
 RULE_INT(Character, OgreCommonTongue, 95, "Starting value for Common Tongue for Ogres")
 RULE_INT(Character, TrollCommonTongue, 95, "Starting value for Common Tongue for Trolls")
 RULE_BOOL(Character, ActiveInvSnapshots, false, "Takes a periodic snapshot of inventory contents from online players")
+RULE_BOOL(Character, TransactionalSaves, true, "Character saves only write the parts that changed since the last save and send them as one transaction")
 RULE_INT(Character, InvSnapshotMinIntervalM, 180, "Minimum time between inventory snapshots (minutes)")
 RULE_INT(Character, InvSnapshotMinRetryM, 30, "Time to re-attempt an inventory snapshot after a failure  (minutes)")
 RULE_INT(Character, InvSnapshotHistoryD, 30, "Time to keep snapshot entries (days)")
@@ -348,6 +349,13 @@ RULE_INT(World, CustomFilesAdminLevel, 20, "Admin level at which custom file key
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Zone)
+RULE_BOOL(Zone, FrameProfilerEnabled, false, "Record per stage, per NPC AI and per quest event timings of the zone loop, readable with #profiler and the get_frame_profile api call")
+RULE_BOOL(Zone, AILodEnabled, true, "Run AI for unengaged NPCs away from every client at a reduced rate, engaged and nearby NPCs still run every frame")
+RULE_INT(Zone, AILodFullRange, 600, "NPCs within this distance of a client run AI every frame")
+RULE_INT(Zone, AILodReducedRange, 1500, "NPCs within this distance of a client (and outside AILodFullRange) run AI every AILodReducedInterval frames, further NPCs every AILodDistantInterval frames")
+RULE_INT(Zone, AILodReducedInterval, 2, "Frames between AI runs for NPCs in the reduced tier")
+RULE_INT(Zone, AILodDistantInterval, 8, "Frames between AI runs for NPCs in the distant tier")
+RULE_INT(Zone, AsyncDatabaseConnections, 2, "Extra database connections used for queued writes like character autosaves and data bucket updates, 0 runs them inline")
 RULE_INT(Zone, ClientLinkdeadMS, 90000, "The time a client remains link dead on the server after a sudden disconnection (milliseconds)")
 RULE_INT(Zone, GraveyardTimeMS, 1200000, "Time until a player corpse is moved to a zone's graveyard, if one is specified for the zone (milliseconds)")
 RULE_BOOL(Zone, EnableShadowrest, 1, "Enables or disables the Shadowrest zone feature for player corpses. Default is turned on")
@@ -399,6 +407,10 @@ RULE_BOOL(Pathing, Fear, true, "Enable pathing for fear")
 RULE_REAL(Pathing, NavmeshStepSize, 100.0f, "Step size for the movement manager")
 RULE_REAL(Pathing, ShortMovementUpdateRange, 130.0f, "Range for short movement updates")
 RULE_INT(Pathing, MaxNavmeshNodes, 4092, "Maximum navmesh nodes in a traversable path")
+RULE_INT(Pathing, RouteCacheSize, 2048, "Maximum number of navmesh routes cached per zone, 0 disables the route cache")
+RULE_INT(Pathing, AsyncWorkerThreads, 2, "Worker threads running navmesh queries off the zone thread, 0 paths everything inline")
+RULE_INT(Pathing, AsyncMaxOutstandingRequests, 256, "Maximum async path requests in flight per zone, requests past this are pathed inline")
+RULE_REAL(Pathing, RouteCacheQuantization, 2.0f, "Grid size that route start and end positions are snapped to when looking up cached routes")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Watermap)
@@ -751,6 +763,7 @@ RULE_INT(Range, StunMessages, 75, "The packet range in which stun messages are s
 RULE_INT(Range, ClientPositionUpdates, 300, "Distance in which the own changed position is communicated to other clients")
 RULE_INT(Range, CriticalDamage, 80, "The packet range in which critical hit messages are sent")
 RULE_INT(Range, MobCloseScanDistance, 600, "Close scan distance")
+RULE_BOOL(Range, MobCloseScanUseSpatialGrid, true, "Use the zone spatial grid for close scans and ranged random mob lookups instead of walking the whole mob list")
 RULE_INT(Range, MaxDistanceToClickDoors, 100, "Max distance that a client can click a door from (Client says 'You can't reach that' at roughly 25-50 for most doors)")
 RULE_CATEGORY_END()
 
@@ -1009,6 +1022,7 @@ RULE_INT(Network, ResendDelayMinMS, 300, "Minimum timespan between two send retr
 RULE_INT(Network, ResendDelayMaxMS, 5000, "Maximum timespan between two send retries (milliseconds)")
 RULE_REAL(Network, ClientDataRate, 0.0, "KB / sec, 0.0 disabled")
 RULE_BOOL(Network, CompressZoneStream, true, "Setting whether the zone stream should be compressed for transmission")
+RULE_BOOL(Network, ZoneNetworkThread, false, "Run the zone's UDP socket, resends and acks on a thread of their own, apart from the game loop")
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(QueryServ)
@@ -1071,6 +1085,7 @@ RULE_CATEGORY_END()
 
 RULE_CATEGORY(Logging)
 RULE_BOOL(Logging, PrintFileFunctionAndLine, false, "Ex: [World Server] [net.cpp::main:309] Loading variables...")
+RULE_INT(Logging, AsyncSinkCapacity, 8192, "Messages the background log writer can hold before new ones are dropped, 0 writes console and file logs inline")
 RULE_BOOL(Logging, WorldGMSayLogging, true, "Relay worldserver logging to zone processes via GM say output")
 RULE_BOOL(Logging, PlayerEventsQSProcess, false, "Have query server process player events instead of world. Useful when wanting to use a dedicated server and database for processing player events on separate disk")
 RULE_INT(Logging, BatchPlayerEventProcessIntervalSeconds, 5, "This is the interval in which player events are processed in world or qs")
@@ -16,8 +16,14 @@
 	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 */
 
-#include <iostream>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
 #include <fmt/format.h>
 
 #if defined(_MSC_VER) && _MSC_VER >= 1800
@@ -968,18 +974,28 @@ void SharedDatabase::GetItemsCount(int32 &item_count, uint32 &max_id)
 }
 
 bool SharedDatabase::LoadItems(const std::string &prefix) {
-	items_mmf.reset(nullptr);
-
 	try {
 		const auto Config = EQEmuConfig::get();
 		EQ::IPCMutex mutex("items");
 		mutex.Lock();
 		std::string file_name = fmt::format("{}/{}{}", path.GetSharedMemoryPath(), prefix, std::string("items"));
-		items_mmf = std::make_unique<EQ::MemoryMappedFile>(file_name);
-		items_hash = std::make_unique<EQ::FixedMemoryHashSet<EQ::ItemData>>(static_cast<uint8*>(items_mmf->Get()), items_mmf->Size());
+		auto mmf  = std::make_shared<EQ::MemoryMappedFile>(file_name, GetSharedMemoryOptions());
+		auto hash = std::make_unique<EQ::FixedMemoryHashSet<EQ::ItemData>>(static_cast<uint8*>(mmf->Get()), mmf->Size());
+		const uint64 generation = ReadSharedMemoryGeneration(prefix);
 		mutex.Unlock();
 
-		LogInfo("Loaded [{}] items via shared memory", Strings::Commify(m_shared_items_count));
+		// the previous segment is unmapped once the last pin on it (see PinItems) is dropped
+		items_mmf  = std::move(mmf);
+		items_hash = std::move(hash);
+
+		m_items_generation = generation;
+		m_items_prefix     = prefix;
+
+		LogInfo(
+			"Loaded [{}] items via shared memory generation [{}]",
+			Strings::Commify(m_shared_items_count),
+			m_items_generation
+		);
 	} catch(std::exception& ex) {
 		LogError("Error Loading Items: {}", ex.what());
 		return false;
@@ -988,61 +1004,101 @@ bool SharedDatabase::LoadItems(const std::string &prefix) {
 	return true;
 }
 
-void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id)
+EQ::MemoryMappedFile::Options SharedDatabase::GetSharedMemoryOptions()
 {
-	EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(data), size, items, max_item_id);
+	const auto Config = EQEmuConfig::get();
 
-	std::string variable_buffer;
-
-	bool disable_attuneable = RuleB(Items, DisableAttuneable);
-	bool disable_bard_focus_effects = RuleB(Items, DisableBardFocusEffects);
-	bool disable_lore = RuleB(Items, DisableLore);
-	bool disable_no_drop = RuleB(Items, DisableNoDrop);
-	bool disable_no_pet = RuleB(Items, DisableNoPet);
-	bool disable_no_rent = RuleB(Items, DisableNoRent);
-	bool disable_no_transfer = RuleB(Items, DisableNoTransfer);
-	bool disable_potion_belt = RuleB(Items, DisablePotionBelt);
-	bool disable_spell_focus_effects = RuleB(Items, DisableSpellFocusEffects);
-
-	// Old Variable Code
-	if (GetVariable("disablelore", variable_buffer)) {
-		if (variable_buffer == "1") {
-			disable_lore = true;
-		}
-	}
+	EQ::MemoryMappedFile::Options options;
+	options.populate   = Config->SharedMemPopulate;
+	options.huge_pages = Config->SharedMemHugePages;
+	options.will_need  = Config->SharedMemWillNeed;
 
-	if (GetVariable("disablenodrop", variable_buffer)) {
-		if (variable_buffer == "1") {
-			disable_no_drop = true;
-		}
+	return options;
+}
+
+uint64 SharedDatabase::ReadSharedMemoryGeneration(const std::string &prefix)
+{
+	std::ifstream f(fmt::format("{}/{}generation", path.GetSharedMemoryPath(), prefix));
+
+	uint64 generation = 0;
+	if (f) {
+		f >> generation;
 	}
 
-	if (GetVariable("disablenorent", variable_buffer)) {
-		if (variable_buffer == "1") {
-			disable_no_rent = true;
+	return generation;
+}
+
+namespace {
+	struct ItemLoadFlags {
+		bool disable_attuneable          = false;
+		bool disable_bard_focus_effects  = false;
+		bool disable_lore                = false;
+		bool disable_no_drop             = false;
+		bool disable_no_pet              = false;
+		bool disable_no_rent             = false;
+		bool disable_no_transfer         = false;
+		bool disable_potion_belt         = false;
+		bool disable_spell_focus_effects = false;
+	};
+
+	// raw rows copied off the connection so workers can parse them while the next batch streams in
+	struct ItemRowBatch {
+		std::vector<char>         buffer;
+		std::vector<int64>        fields; // offset into buffer for each column of each row, -1 for NULL
+		std::vector<EQ::ItemData> items;
+		uint32                    columns = 0;
+		uint32                    rows    = 0;
+		bool                      parsed  = false;
+	};
+
+	constexpr uint32 ITEM_BATCH_ROWS = 256;
+
+	ItemLoadFlags GetItemLoadFlags(SharedDatabase *db)
+	{
+		ItemLoadFlags flags;
+
+		flags.disable_attuneable          = RuleB(Items, DisableAttuneable);
+		flags.disable_bard_focus_effects  = RuleB(Items, DisableBardFocusEffects);
+		flags.disable_lore                = RuleB(Items, DisableLore);
+		flags.disable_no_drop             = RuleB(Items, DisableNoDrop);
+		flags.disable_no_pet              = RuleB(Items, DisableNoPet);
+		flags.disable_no_rent             = RuleB(Items, DisableNoRent);
+		flags.disable_no_transfer         = RuleB(Items, DisableNoTransfer);
+		flags.disable_potion_belt         = RuleB(Items, DisablePotionBelt);
+		flags.disable_spell_focus_effects = RuleB(Items, DisableSpellFocusEffects);
+
+		std::string variable_buffer;
+
+		// Old Variable Code
+		if (db->GetVariable("disablelore", variable_buffer)) {
+			if (variable_buffer == "1") {
+				flags.disable_lore = true;
+			}
 		}
-	}
 
+		if (db->GetVariable("disablenodrop", variable_buffer)) {
+			if (variable_buffer == "1") {
+				flags.disable_no_drop = true;
+			}
+		}
 
-	if (GetVariable("disablenotransfer", variable_buffer)) {
-		if (variable_buffer == "1") {
-			disable_no_transfer = true;
+		if (db->GetVariable("disablenorent", variable_buffer)) {
+			if (variable_buffer == "1") {
+				flags.disable_no_rent = true;
+			}
 		}
-	}
 
-	EQ::ItemData item;
+		if (db->GetVariable("disablenotransfer", variable_buffer)) {
+			if (variable_buffer == "1") {
+				flags.disable_no_transfer = true;
+			}
+		}
 
-	const std::string query = "SELECT source,"
-#define F(x) "`"#x"`,"
-#include "item_fieldlist.h"
-#undef F
-		"updated, minstatus, comment FROM items ORDER BY id";
-	auto results = QueryDatabase(query);
-	if (!results.Success()) {
-		return;
+		return flags;
 	}
 
-	for (auto& row = results.begin(); row != results.end(); ++row) {
+	void ParseItemRow(MYSQL_ROW row, const ItemLoadFlags &flags, EQ::ItemData &item)
+	{
 		memset(&item, 0, sizeof(EQ::ItemData));
 
 		// Unique Identifier
@@ -1058,14 +1114,14 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 
 		// Flags
 		item.ArtifactFlag = Strings::ToBool(row[ItemField::artifactflag]);
-		item.Attuneable = !disable_attuneable && Strings::ToBool(row[ItemField::attuneable]);
+		item.Attuneable = !flags.disable_attuneable && Strings::ToBool(row[ItemField::attuneable]);
 		item.BenefitFlag = Strings::ToBool(row[ItemField::benefitflag]);
 		item.FVNoDrop = Strings::ToBool(row[ItemField::fvnodrop]);
 		item.Magic = Strings::ToBool(row[ItemField::magic]);
-		item.NoDrop = disable_no_drop ? static_cast<uint8>(255) : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::nodrop]));
-		item.NoPet = !disable_no_pet && Strings::ToBool(row[ItemField::nopet]);
-		item.NoRent = disable_no_rent ? static_cast<uint8>(255) : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::norent]));
-		item.NoTransfer = !disable_no_transfer && Strings::ToBool(row[ItemField::notransfer]);
+		item.NoDrop = flags.disable_no_drop ? static_cast<uint8>(255) : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::nodrop]));
+		item.NoPet = !flags.disable_no_pet && Strings::ToBool(row[ItemField::nopet]);
+		item.NoRent = flags.disable_no_rent ? static_cast<uint8>(255) : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::norent]));
+		item.NoTransfer = !flags.disable_no_transfer && Strings::ToBool(row[ItemField::notransfer]);
 		item.PendingLoreFlag = Strings::ToBool(row[ItemField::pendingloreflag]);
 		item.QuestItemFlag = Strings::ToBool(row[ItemField::questitemflag]);
 		item.Stackable = Strings::ToBool(row[ItemField::stackable]);
@@ -1073,8 +1129,8 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 		item.SummonedFlag = Strings::ToBool(row[ItemField::summonedflag]);
 
 		// Lore
-		item.LoreGroup = disable_lore ? 0 : Strings::ToInt(row[ItemField::loregroup]);
-		item.LoreFlag = !disable_lore && item.LoreGroup != 0;
+		item.LoreGroup = flags.disable_lore ? 0 : Strings::ToInt(row[ItemField::loregroup]);
+		item.LoreFlag = !flags.disable_lore && item.LoreGroup != 0;
 
 		// Type
 		item.AugType = Strings::ToUnsignedInt(row[ItemField::augtype]);
@@ -1090,8 +1146,8 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 		item.Weight = Strings::ToInt(row[ItemField::weight]);
 
 		// Potion Belt
-		item.PotionBelt = !disable_potion_belt && Strings::ToBool(row[ItemField::potionbelt]);
-		item.PotionBeltSlots = disable_potion_belt ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::potionbeltslots]));
+		item.PotionBelt = !flags.disable_potion_belt && Strings::ToBool(row[ItemField::potionbelt]);
+		item.PotionBeltSlots = flags.disable_potion_belt ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::potionbeltslots]));
 
 		// Merchant
 		item.Favor = Strings::ToUnsignedInt(row[ItemField::favor]);
@@ -1252,10 +1308,10 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 		item.BagWR = static_cast<uint8>(EQ::Clamp(Strings::ToInt(row[ItemField::bagwr]), 0, 100));
 
 		// Bard Effect
-		item.Bard.Effect = disable_bard_focus_effects ? 0 : Strings::ToInt(row[ItemField::bardeffect]);
-		item.Bard.Type = disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardtype]));
-		item.Bard.Level = disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardlevel]));
-		item.Bard.Level2 = disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardlevel2]));
+		item.Bard.Effect = flags.disable_bard_focus_effects ? 0 : Strings::ToInt(row[ItemField::bardeffect]);
+		item.Bard.Type = flags.disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardtype]));
+		item.Bard.Level = flags.disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardlevel]));
+		item.Bard.Level2 = flags.disable_bard_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::bardlevel2]));
 
 		// Book
 		item.Book = static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::book]));
@@ -1273,11 +1329,11 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 		item.RecastType = Strings::ToInt(row[ItemField::recasttype]);
 
 		// Focus Effect
-		item.Focus.Effect = disable_spell_focus_effects ? 0 : Strings::ToInt(row[ItemField::focuseffect]);
-		item.Focus.Type = disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focustype]));
-		item.Focus.Level = disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focuslevel]));
-		item.Focus.Level2 = disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focuslevel2]));
-		strn0cpy(item.FocusName, disable_spell_focus_effects ? "" : row[ItemField::focusname], sizeof(item.FocusName));
+		item.Focus.Effect = flags.disable_spell_focus_effects ? 0 : Strings::ToInt(row[ItemField::focuseffect]);
+		item.Focus.Type = flags.disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focustype]));
+		item.Focus.Level = flags.disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focuslevel]));
+		item.Focus.Level2 = flags.disable_spell_focus_effects ? 0 : static_cast<uint8>(Strings::ToUnsignedInt(row[ItemField::focuslevel2]));
+		strn0cpy(item.FocusName, flags.disable_spell_focus_effects ? "" : row[ItemField::focusname], sizeof(item.FocusName));
 
 		// Proc Effect
 		item.Proc.Effect = Strings::ToInt(row[ItemField::proceffect]);
@@ -1312,14 +1368,284 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 		strn0cpy(item.CharmFile, row[ItemField::charmfile], sizeof(item.CharmFile));
 		strn0cpy(item.Filename, row[ItemField::filename], sizeof(item.Filename));
 		item.ScriptFileID = Strings::ToUnsignedInt(row[ItemField::scriptfileid]);
+	}
+
+	void ParseItemBatch(ItemRowBatch &batch, const ItemLoadFlags &flags)
+	{
+		const uint32        columns = batch.columns;
+		std::vector<char *> row(columns);
+
+		batch.items.resize(batch.rows);
+		for (uint32 r = 0; r < batch.rows; ++r) {
+			for (uint32 c = 0; c < columns; ++c) {
+				const int64 offset = batch.fields[r * columns + c];
+				row[c] = offset < 0 ? nullptr : batch.buffer.data() + offset;
+			}
+
+			ParseItemRow(row.data(), flags, batch.items[r]);
+		}
+	}
+
+	// streams the items query and hands each parsed item to on_item on the calling thread, in query order
+	// with more than one worker, rows are copied off the connection in batches and parsed on a pool while
+	// the next batch streams in, on_item returning false stops the load
+	bool StreamItems(
+		SharedDatabase *db,
+		const std::string &where,
+		uint32 worker_threads,
+		std::string &last_updated,
+		const std::function<bool(const EQ::ItemData &)> &on_item
+	)
+	{
+		const auto flags = GetItemLoadFlags(db);
+
+		const std::string query = fmt::format(
+			"SELECT source,"
+#define F(x) "`"#x"`,"
+#include "item_fieldlist.h"
+#undef F
+			"updated, minstatus, comment FROM items {} ORDER BY id",
+			where
+		);
+
+		auto track_updated = [&](const char *updated) {
+			if (updated && last_updated.compare(updated) < 0) {
+				last_updated = updated;
+			}
+		};
+
+		if (worker_threads <= 1) {
+			EQ::ItemData item;
+			return db->QueryDatabaseStream(
+				query,
+				[&](MYSQL_ROW row, unsigned long *lengths, uint32 columns) {
+					track_updated(row[ItemField::updated]);
+					ParseItemRow(row, flags, item);
+					return on_item(item);
+				}
+			);
+		}
+
+		const size_t max_pending = worker_threads * 4;
+
+		std::mutex                                 lock;
+		std::condition_variable                    work_cv;
+		std::condition_variable                    done_cv;
+		std::deque<ItemRowBatch *>                 work;
+		std::deque<std::unique_ptr<ItemRowBatch>>  pending;
+		std::unique_ptr<ItemRowBatch>              batch;
+		bool                                       finished = false;
+		bool                                       stopped  = false;
+
+		std::vector<std::thread> workers;
+		for (uint32 i = 0; i < worker_threads; ++i) {
+			workers.emplace_back(
+				[&]() {
+					std::unique_lock<std::mutex> guard(lock);
+					for (;;) {
+						work_cv.wait(guard, [&]() { return !work.empty() || finished; });
+						if (work.empty()) {
+							return;
+						}
+
+						ItemRowBatch *b = work.front();
+						work.pop_front();
+
+						guard.unlock();
+						ParseItemBatch(*b, flags);
+						guard.lock();
+
+						b->parsed = true;
+						done_cv.notify_all();
+					}
+				}
+			);
+		}
+
+		// hands parsed batches to on_item in order, waiting on the oldest only when too many are queued
+		auto drain = [&](bool all) {
+			std::unique_lock<std::mutex> guard(lock);
+			while (!pending.empty() && !stopped) {
+				if (!pending.front()->parsed) {
+					if (!all && pending.size() < max_pending) {
+						return;
+					}
+
+					done_cv.wait(guard, [&]() { return pending.front()->parsed; });
+				}
+
+				auto b = std::move(pending.front());
+				pending.pop_front();
+
+				guard.unlock();
+				for (const auto &item : b->items) {
+					if (!on_item(item)) {
+						stopped = true;
+						break;
+					}
+				}
+				guard.lock();
+			}
+		};
+
+		auto submit = [&]() {
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				work.push_back(batch.get());
+				pending.push_back(std::move(batch));
+			}
+
+			work_cv.notify_one();
+			drain(false);
+		};
+
+		bool success = db->QueryDatabaseStream(
+			query,
+			[&](MYSQL_ROW row, unsigned long *lengths, uint32 columns) {
+				if (!batch) {
+					batch          = std::make_unique<ItemRowBatch>();
+					batch->columns = columns;
+					batch->fields.reserve(ITEM_BATCH_ROWS * columns);
+				}
+
+				track_updated(row[ItemField::updated]);
+
+				for (uint32 c = 0; c < columns; ++c) {
+					if (!row[c]) {
+						batch->fields.push_back(-1);
+						continue;
+					}
+
+					batch->fields.push_back(static_cast<int64>(batch->buffer.size()));
+					batch->buffer.insert(batch->buffer.end(), row[c], row[c] + lengths[c]);
+					batch->buffer.push_back('\0');
+				}
+
+				if (++batch->rows == ITEM_BATCH_ROWS) {
+					submit();
+				}
+
+				return !stopped;
+			}
+		);
+
+		if (batch && batch->rows > 0) {
+			submit();
+		}
+
+		drain(true);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			finished = true;
+		}
+
+		work_cv.notify_all();
+		for (auto &t : workers) {
+			t.join();
+		}
+
+		return success && !stopped;
+	}
+}
+
+bool SharedDatabase::LoadItems(
+	void *data,
+	uint32 size,
+	int32 items,
+	uint32 max_item_id,
+	uint32 worker_threads,
+	std::string &last_updated
+)
+{
+	EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(data), size, items, max_item_id);
+
+	return StreamItems(
+		this,
+		"",
+		worker_threads,
+		last_updated,
+		[&](const EQ::ItemData &item) {
+			try {
+				hash.insert(item.ID, item);
+			} catch (std::exception &ex) {
+				LogError("Database::LoadItems: {}", ex.what());
+				return false;
+			}
+
+			return true;
+		}
+	);
+}
+
+bool SharedDatabase::PatchItems(
+	void *data,
+	uint32 size,
+	int32 items,
+	const std::string &since,
+	uint32 worker_threads,
+	std::string &last_updated
+)
+{
+	EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(data), size);
+
+	uint32 patched = 0;
+
+	// anything stamped in the same second as the last build may have missed it, so take that second again
+	const bool success = StreamItems(
+		this,
+		fmt::format("WHERE updated >= '{}'", Escape(since)),
+		worker_threads,
+		last_updated,
+		[&](const EQ::ItemData &item) {
+			// new ids past the headroom the file was built with need a full build
+			if (!hash.exists(item.ID) && (item.ID > hash.max_key() || hash.size() >= hash.max_size())) {
+				return false;
+			}
 
-		try {
 			hash.insert(item.ID, item);
-		} catch (std::exception &ex) {
-			LogError("Database::LoadItems: {}", ex.what());
-			break;
+			patched++;
+			return true;
+		}
+	);
+
+	if (!success) {
+		return false;
+	}
+
+	// a deleted row leaves no updated stamp behind, so the ids have to be checked. with the counts equal, every
+	// id the database has being in the file leaves no room for one it has since dropped
+	if (hash.size() != static_cast<uint32>(items)) {
+		LogInfo("Patched file holds [{}] items but the database has [{}]", hash.size(), items);
+		return false;
+	}
+
+	uint32     missing_id = 0;
+	const bool checked    = QueryDatabaseStream(
+		"SELECT id FROM items",
+		[&](MYSQL_ROW row, unsigned long *lengths, uint32 columns) {
+			const uint32 id = Strings::ToUnsignedInt(row[0]);
+			if (!hash.exists(id)) {
+				missing_id = id;
+				return false;
+			}
+
+			return true;
 		}
+	);
+
+	if (missing_id) {
+		LogInfo("Patched file is missing item [{}], items were deleted and added since the last build", missing_id);
+		return false;
 	}
+
+	if (!checked) {
+		return false;
+	}
+
+	LogInfo("Patched [{}] items updated since [{}]", Strings::Commify(patched), since);
+
+	return true;
 }
 
 const EQ::ItemData *SharedDatabase::GetItem(uint32 id) const
@@ -1658,21 +1984,31 @@ int SharedDatabase::GetMaxSpellID() {
 }
 
 bool SharedDatabase::LoadSpells(const std::string &prefix, int32 *records, const SPDat_Spell_Struct **sp) {
-	spells_mmf.reset(nullptr);
-
 	try {
 		const auto Config = EQEmuConfig::get();
 		EQ::IPCMutex mutex("spells");
 		mutex.Lock();
 
 		std::string file_name = fmt::format("{}/{}{}", path.GetSharedMemoryPath(), prefix, std::string("spells"));
-		spells_mmf = std::make_unique<EQ::MemoryMappedFile>(file_name);
+		auto mmf = std::make_shared<EQ::MemoryMappedFile>(file_name, GetSharedMemoryOptions());
 		LogInfo("Loading [{}]", file_name);
-		*records = *static_cast<uint32*>(spells_mmf->Get());
-		*sp = reinterpret_cast<const SPDat_Spell_Struct*>(static_cast<char*>(spells_mmf->Get()) + 4);
+		const uint64 generation = ReadSharedMemoryGeneration(prefix);
 		mutex.Unlock();
 
-		LogInfo("Loaded [{}] spells via shared memory", Strings::Commify(m_shared_spells_count));
+		// the previous segment is unmapped once the last pin on it (see PinSpells) is dropped
+		*records = *static_cast<uint32*>(mmf->Get());
+		*sp = reinterpret_cast<const SPDat_Spell_Struct*>(static_cast<char*>(mmf->Get()) + 4);
+
+		spells_mmf = std::move(mmf);
+
+		m_spells_generation = generation;
+		m_spells_prefix     = prefix;
+
+		LogInfo(
+			"Loaded [{}] spells via shared memory generation [{}]",
+			Strings::Commify(m_shared_spells_count),
+			m_spells_generation
+		);
 	}
 	catch(std::exception& ex) {
 		LogError("Error Loading Spells: {}", ex.what());
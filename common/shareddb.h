@@ -26,6 +26,7 @@
 #include "spdat.h"
 #include "fixed_memory_hash_set.h"
 #include "fixed_memory_variable_hash_set.h"
+#include "memory_mapped_file.h"
 #include "say_link.h"
 #include "repositories/command_subsettings_repository.h"
 #include "repositories/items_evolving_details_repository.h"
@@ -48,7 +49,6 @@ namespace EQ {
 	struct ItemData;
 	class ItemInstance;
 	class InventoryProfile;
-	class MemoryMappedFile;
 }
 
 struct Book_Struct
@@ -159,8 +159,20 @@ public:
 	EQ::ItemInstance *CreateBaseItem(const EQ::ItemData *item, int16 charges = 0);
 
 	void GetItemsCount(int32 &item_count, uint32 &max_id);
-	void LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id);
+	// builds a fresh items hash in data, parsing on worker_threads threads while rows stream in
+	// last_updated is raised to the newest `updated` stamp loaded
+	bool LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id, uint32 worker_threads, std::string &last_updated);
+	// re-parses items updated since the given stamp into an existing hash, false when it needs a full build
+	bool PatchItems(void *data, uint32 size, int32 items, const std::string &since, uint32 worker_threads, std::string &last_updated);
 	bool LoadItems(const std::string &prefix);
+	// generation the shared_memory tool stamped on the items segment currently mapped
+	uint64 GetItemsGeneration() const { return m_items_generation; }
+	const std::string &GetItemsPrefix() const { return m_items_prefix; }
+	// keeps the items segment currently mapped alive for as long as the caller holds pointers into it
+	std::shared_ptr<const void> PinItems() const { return items_mmf; }
+	static uint64 ReadSharedMemoryGeneration(const std::string &prefix);
+	// paging hints from the shared_memory block of eqemu_config
+	static EQ::MemoryMappedFile::Options GetSharedMemoryOptions();
 	const EQ::ItemData *IterateItems(uint32 *id) const;
 	const EQ::ItemData *GetItem(uint32 id) const;
 	const EvolveInfo *GetEvolveInfo(uint32 loregroup);
@@ -176,6 +188,9 @@ public:
 	void LoadDamageShieldTypes(SPDat_Spell_Struct *sp, int32 iMaxSpellID);
 	uint32 GetSharedSpellsCount() { return m_shared_spells_count; }
 	uint32 GetSpellsCount();
+	uint64 GetSpellsGeneration() const { return m_spells_generation; }
+	const std::string &GetSpellsPrefix() const { return m_spells_prefix; }
+	std::shared_ptr<const void> PinSpells() const { return spells_mmf; }
 
 	std::string CreateItemLink(uint32 item_id) const
 	{
@@ -189,13 +204,13 @@ public:
 protected:
 
 	std::unique_ptr<EQ::MemoryMappedFile>                        skill_caps_mmf;
-	std::unique_ptr<EQ::MemoryMappedFile>                        items_mmf;
+	std::shared_ptr<EQ::MemoryMappedFile>                        items_mmf;
 	std::unique_ptr<EQ::FixedMemoryHashSet<EQ::ItemData>>        items_hash;
 	std::unique_ptr<EQ::MemoryMappedFile>                        faction_mmf;
 	std::unique_ptr<EQ::FixedMemoryHashSet<NPCFactionList>>      faction_hash;
 	std::unique_ptr<EQ::MemoryMappedFile>                        faction_associations_mmf;
 	std::unique_ptr<EQ::FixedMemoryHashSet<FactionAssociations>> faction_associations_hash;
-	std::unique_ptr<EQ::MemoryMappedFile>                        spells_mmf;
+	std::shared_ptr<EQ::MemoryMappedFile>                        spells_mmf;
 
 public:
 	void SetSharedItemsCount(uint32 shared_items_count);
@@ -203,6 +218,10 @@ public:
 protected:
 	uint32 m_shared_items_count = 0;
 	uint32 m_shared_spells_count = 0;
+	uint64 m_items_generation = 0;
+	std::string m_items_prefix;
+	uint64 m_spells_generation = 0;
+	std::string m_spells_prefix;
 };
 
 #endif /*SHAREDDB_H_*/
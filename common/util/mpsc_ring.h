@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace EQ
+{
+	namespace Util {
+		// Bounded lock free queue, any number of producers and a single consumer
+		//
+		// Each cell carries a sequence number that tells producers and the consumer whose turn it is,
+		// so a push is one CAS on the enqueue cursor and a pop touches no shared cursor at all.
+		// A full ring fails the push instead of blocking, callers decide what dropping means.
+		template<typename T>
+		class MPSCRing
+		{
+		public:
+			explicit MPSCRing(size_t capacity)
+			{
+				size_t size = 2;
+				while (size < capacity) {
+					size <<= 1;
+				}
+
+				m_mask  = size - 1;
+				m_cells = std::make_unique<Cell[]>(size);
+
+				for (size_t i = 0; i < size; ++i) {
+					m_cells[i].sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			MPSCRing(const MPSCRing &) = delete;
+			MPSCRing &operator=(const MPSCRing &) = delete;
+
+			bool TryPush(T &&value)
+			{
+				size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+				for (;;) {
+					Cell         &cell = m_cells[pos & m_mask];
+					const size_t seq   = cell.sequence.load(std::memory_order_acquire);
+					const auto   diff  = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+					if (diff == 0) {
+						if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+							cell.value = std::move(value);
+							cell.sequence.store(pos + 1, std::memory_order_release);
+							return true;
+						}
+					}
+					else if (diff < 0) {
+						return false;
+					}
+					else {
+						pos = m_enqueue_pos.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			// consumer side only
+			bool TryPop(T &out)
+			{
+				Cell         &cell = m_cells[m_dequeue_pos & m_mask];
+				const size_t seq   = cell.sequence.load(std::memory_order_acquire);
+
+				if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(m_dequeue_pos + 1) < 0) {
+					return false;
+				}
+
+				out = std::move(cell.value);
+				cell.sequence.store(m_dequeue_pos + m_mask + 1, std::memory_order_release);
+				++m_dequeue_pos;
+
+				return true;
+			}
+
+			size_t Capacity() const { return m_mask + 1; }
+
+		private:
+			struct Cell
+			{
+				std::atomic<size_t> sequence;
+				T                   value;
+			};
+
+			size_t                  m_mask;
+			std::unique_ptr<Cell[]> m_cells;
+
+			alignas(64) std::atomic<size_t> m_enqueue_pos{0};
+			alignas(64) size_t              m_dequeue_pos = 0;
+		};
+	}
+}
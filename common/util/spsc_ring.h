@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace EQ
+{
+	namespace Util {
+		// Bounded lock free queue between exactly one producer thread and one consumer thread
+		//
+		// Each side owns its own cursor and only reads the other's when its cached copy says the ring
+		// looks full or empty, so a push or pop is normally a plain store with no read of a shared line.
+		// A full ring fails the push instead of blocking, callers decide what waiting means.
+		template<typename T>
+		class SPSCRing
+		{
+		public:
+			explicit SPSCRing(size_t capacity)
+			{
+				size_t size = 2;
+				while (size < capacity) {
+					size <<= 1;
+				}
+
+				m_mask  = size - 1;
+				m_cells = std::make_unique<T[]>(size);
+			}
+
+			SPSCRing(const SPSCRing &) = delete;
+			SPSCRing &operator=(const SPSCRing &) = delete;
+
+			// producer side only, value is left untouched when the ring is full
+			bool TryPush(T &&value)
+			{
+				const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+				if (tail - m_cached_head > m_mask) {
+					m_cached_head = m_head.load(std::memory_order_acquire);
+					if (tail - m_cached_head > m_mask) {
+						return false;
+					}
+				}
+
+				m_cells[tail & m_mask] = std::move(value);
+				m_tail.store(tail + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// consumer side only
+			bool TryPop(T &out)
+			{
+				const size_t head = m_head.load(std::memory_order_relaxed);
+
+				if (head == m_cached_tail) {
+					m_cached_tail = m_tail.load(std::memory_order_acquire);
+					if (head == m_cached_tail) {
+						return false;
+					}
+				}
+
+				out = std::move(m_cells[head & m_mask]);
+				m_head.store(head + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			size_t Capacity() const { return m_mask + 1; }
+
+		private:
+			size_t               m_mask;
+			std::unique_ptr<T[]> m_cells;
+
+			alignas(64) std::atomic<size_t> m_head{0};
+			size_t                          m_cached_tail = 0;
+
+			alignas(64) std::atomic<size_t> m_tail{0};
+			size_t                          m_cached_head = 0;
+		};
+	}
+}
@@ -22,9 +22,20 @@
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
 #include "../common/eqemu_exception.h"
+#include "../common/eqemu_logsys.h"
 #include "../common/item_data.h"
 
-void LoadItems(SharedDatabase *database, const std::string &prefix) {
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// room a full build leaves for items added later so an incremental run can patch them in
+const uint32 ITEM_HEADROOM_MIN = 256;
+const uint32 ITEM_ID_HEADROOM  = 1000;
+
+void LoadItems(SharedDatabase *database, const std::string &prefix, bool incremental, uint32 worker_threads) {
 	EQ::IPCMutex mutex("items");
 	mutex.Lock();
 
@@ -35,14 +46,74 @@ void LoadItems(SharedDatabase *database, const std::string &prefix) {
 		EQ_EXCEPT("Shared Memory", "Unable to get any items from the database.");
 	}
 
-	uint32 size = static_cast<uint32>(EQ::FixedMemoryHashSet<EQ::ItemData>::estimated_size(items, max_item));
-
 	auto Config = EQEmuConfig::get();
-	std::string file_name = Config->SharedMemDir + prefix + std::string("items");
-	EQ::MemoryMappedFile mmf(file_name, size);
-	mmf.ZeroFile();
+	std::string file_name  = Config->SharedMemDir + prefix + std::string("items");
+	std::string temp_name  = file_name + ".tmp";
+	std::string stamp_name = file_name + ".updated";
+
+	// the newest `updated` stamp the current file was built from
+	std::string since;
+	if (incremental && fs::exists(file_name)) {
+		std::ifstream stamp(stamp_name);
+		std::getline(stamp, since);
+	}
+
+	// the new file is written to the side so zones never see it half built. windows zones keep the file
+	// mapped without FILE_SHARE_DELETE, it can't be replaced while one is up, so there it's written in place
+#ifdef _WINDOWS
+	const std::string build_name = file_name;
+#else
+	const std::string build_name = temp_name;
+#endif
+
+	std::error_code ec;
+	if (build_name != file_name) {
+		fs::remove(build_name, ec);
+	}
+
+	std::string last_updated = since;
+	bool        built        = false;
+
+	if (!since.empty()) {
+		if (build_name == file_name || fs::copy_file(file_name, build_name, ec)) {
+			EQ::MemoryMappedFile mmf(build_name);
+			built = database->PatchItems(mmf.Get(), mmf.Size(), items, since, worker_threads, last_updated);
+		}
+
+		if (!built) {
+			LogInfo("Unable to patch the existing items file, running a full build");
+		}
+	}
+
+	if (!built) {
+		last_updated.clear();
+
+		uint32 capacity = static_cast<uint32>(items) + std::max<uint32>(items / 50, ITEM_HEADROOM_MIN);
+		uint32 max_id   = max_item + ITEM_ID_HEADROOM;
+		uint32 size     = static_cast<uint32>(EQ::FixedMemoryHashSet<EQ::ItemData>::estimated_size(capacity, max_id));
+
+		EQ::MemoryMappedFile mmf(build_name, size);
+		mmf.ZeroFile();
+
+		if (!database->LoadItems(mmf.Get(), size, capacity, max_id, worker_threads, last_updated)) {
+			EQ_EXCEPT("Shared Memory", "Unable to load items from the database.");
+		}
+	}
+
+	// zones that already mapped the old file keep their view of it, anything mapping it afterwards gets the new one
+	if (build_name != file_name) {
+		fs::rename(build_name, file_name, ec);
+		if (ec) {
+			EQ_EXCEPT("Shared Memory", "Unable to replace the items file with the one just built.");
+		}
+	}
+
+	{
+		std::ofstream stamp(stamp_name + ".tmp", std::ios::trunc);
+		stamp << last_updated << std::endl;
+	}
+
+	fs::rename(stamp_name + ".tmp", stamp_name, ec);
 
-	void *ptr = mmf.Get();
-	database->LoadItems(ptr, size, items, max_item);
 	mutex.Unlock();
 }
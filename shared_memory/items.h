@@ -21,8 +21,9 @@
 
 #include <string>
 #include "../common/eqemu_config.h"
+#include "../common/types.h"
 
 class SharedDatabase;
-void LoadItems(SharedDatabase *database, const std::string &prefix);
+void LoadItems(SharedDatabase *database, const std::string &prefix, bool incremental, uint32 worker_threads);
 
 #endif
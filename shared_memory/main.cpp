@@ -16,7 +16,11 @@
 	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 */
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <stdio.h>
+#include <thread>
 
 #include "../common/eqemu_logsys.h"
 #include "../common/global_define.h"
@@ -78,6 +82,36 @@ inline bool MakeDirectory(const std::string &directory_name)
 	return false;
 }
 
+// bumped after every build, written to the side and renamed so readers never see a partial number
+bool WriteSharedMemoryGeneration(const std::string &file_name)
+{
+	uint64 generation = 0;
+	{
+		std::ifstream f(file_name);
+		if (f) {
+			f >> generation;
+		}
+	}
+
+	{
+		std::ofstream f(file_name + ".tmp", std::ios::trunc);
+		f << generation + 1 << std::endl;
+		if (!f) {
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(file_name + ".tmp", file_name, ec);
+	if (ec) {
+		return false;
+	}
+
+	LogInfo("Shared memory generation is now [{}]", generation + 1);
+
+	return true;
+}
+
 int main(int argc, char **argv)
 {
 	RegisterExecutablePlatform(ExePlatformSharedMemory);
@@ -187,6 +221,9 @@ int main(int argc, char **argv)
 	bool load_items      = false;
 	bool load_loot       = false;
 	bool load_spells     = false;
+	bool incremental     = false;
+
+	uint32 worker_threads = std::max(1u, std::thread::hardware_concurrency());
 
 	if (argc > 1) {
 		for (int i = 1; i < argc; ++i) {
@@ -213,6 +250,12 @@ int main(int argc, char **argv)
 							hotfix_name = argument;
 							load_all    = true;
 						}
+						else if (strcasecmp("-threads", command.c_str()) == 0) {
+							worker_threads = std::max(1u, Strings::ToUnsignedInt(argument));
+						}
+					}
+					else if (strcasecmp("-incremental", argv[i]) == 0) {
+						incremental = true;
 					}
 					break;
 				}
@@ -227,7 +270,7 @@ int main(int argc, char **argv)
 	if (load_all || load_items) {
 		LogInfo("Loading items");
 		try {
-			LoadItems(&content_db, hotfix_name);
+			LoadItems(&content_db, hotfix_name, incremental, worker_threads);
 		} catch (std::exception &ex) {
 			LogError("{}", ex.what());
 			return 1;
@@ -244,6 +287,12 @@ int main(int argc, char **argv)
 		}
 	}
 
+	// zones told to apply shared memory compare this with the generation they have mapped
+	if (!WriteSharedMemoryGeneration(shared_mem_directory + hotfix_name + "generation")) {
+		LogError("Unable to write the shared memory generation file");
+		return 1;
+	}
+
 	LogSys.CloseFileLogs();
 	return 0;
 }
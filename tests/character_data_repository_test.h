@@ -0,0 +1,128 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_CHARACTER_DATA_REPOSITORY_H
+#define __EQEMU_TESTS_CHARACTER_DATA_REPOSITORY_H
+
+#include "cppunit/cpptest.h"
+#include "../common/database.h"
+#include "../common/repositories/character_data_repository.h"
+#include <string>
+#include <vector>
+
+// writes are captured instead of sent, so none of these need a server
+class CharacterDataRepositoryTest : public Test::Suite {
+	typedef void(CharacterDataRepositoryTest::*TestFunction)(void);
+public:
+	CharacterDataRepositoryTest() {
+		TEST_ADD(CharacterDataRepositoryTest::UpdateChangedColumnsTest);
+		TEST_ADD(CharacterDataRepositoryTest::UpdateUnchangedTest);
+		TEST_ADD(CharacterDataRepositoryTest::ReplaceManyChangedColumnsTest);
+	}
+
+	~CharacterDataRepositoryTest() {
+	}
+
+	private:
+	CharacterDataRepository::CharacterData Loaded() {
+		auto e = CharacterDataRepository::NewEntity();
+		e.id     = 1;
+		e.name   = "Tester";
+		e.class_ = 1;
+		e.cur_hp = 100;
+
+		return e;
+	}
+
+	void UpdateChangedColumnsTest() {
+		Database                 db;
+		std::vector<std::string> statements;
+
+		const auto original = Loaded();
+		auto       e        = original;
+		e.class_ = 3;
+		e.cur_hp = 90;
+
+		CharacterDataRepository::MarkChanged(e, original);
+		TEST_ASSERT_EQUALS(e.changed_columns.count(), 2);
+
+		db.BeginWriteCapture(&statements);
+		CharacterDataRepository::UpdateOne(db, e);
+		db.EndWriteCapture();
+
+		TEST_ASSERT_EQUALS(statements.size(), 1);
+		if (statements.size() != 1) {
+			return;
+		}
+
+		TEST_ASSERT_EQUALS(statements[0], std::string("UPDATE character_data SET `class` = 3, cur_hp = 90 WHERE id = 1"));
+	}
+
+	void UpdateUnchangedTest() {
+		Database                 db;
+		std::vector<std::string> statements;
+
+		const auto original = Loaded();
+		auto       e        = original;
+
+		CharacterDataRepository::MarkChanged(e, original);
+		TEST_ASSERT(e.changed_columns.none());
+
+		db.BeginWriteCapture(&statements);
+		TEST_ASSERT_EQUALS(CharacterDataRepository::UpdateOne(db, e), 0);
+		db.EndWriteCapture();
+
+		TEST_ASSERT(statements.empty());
+	}
+
+	void ReplaceManyChangedColumnsTest() {
+		Database                 db;
+		std::vector<std::string> statements;
+
+		const auto original  = Loaded();
+		auto       unchanged = original;
+		auto       changed   = original;
+		changed.cur_hp = 50;
+
+		CharacterDataRepository::MarkChanged(unchanged, original);
+		CharacterDataRepository::MarkChanged(changed, original);
+
+		db.BeginWriteCapture(&statements);
+		CharacterDataRepository::ReplaceMany(db, { unchanged });
+		TEST_ASSERT(statements.empty());
+
+		// existing rows only take the changed column, the rest of what is stored stays
+		CharacterDataRepository::ReplaceMany(db, { unchanged, changed });
+		db.EndWriteCapture();
+
+		TEST_ASSERT_EQUALS(statements.size(), 1);
+		if (statements.size() != 1) {
+			return;
+		}
+
+		const std::string suffix = " ON DUPLICATE KEY UPDATE cur_hp = VALUES(cur_hp)";
+		TEST_ASSERT(statements[0].rfind("INSERT INTO character_data ", 0) == 0);
+		TEST_ASSERT(
+			statements[0].length() > suffix.length() &&
+			statements[0].compare(statements[0].length() - suffix.length(), suffix.length(), suffix) == 0
+		);
+	}
+};
+
+#endif
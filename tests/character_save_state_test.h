@@ -0,0 +1,186 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_CHARACTER_SAVE_STATE_H
+#define __EQEMU_TESTS_CHARACTER_SAVE_STATE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/character_save_state.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// stands in for a saver like the task system's, which only writes what is dirty, clears the flags as it
+// goes and advances a cursor past completed entries it has written
+struct SaveStateTestTasks {
+	std::vector<bool>        dirty = { false, false, false };
+	std::vector<std::string> completed;
+	size_t                   completed_saved = 0;
+
+	std::vector<std::string> Save() {
+		std::vector<std::string> out;
+		for (size_t i = 0; i < dirty.size(); ++i) {
+			if (dirty[i]) {
+				out.push_back("REPLACE INTO tasks VALUES (" + std::to_string(i) + ")");
+				dirty[i] = false;
+			}
+		}
+
+		for (; completed_saved < completed.size(); ++completed_saved) {
+			out.push_back("REPLACE INTO completed VALUES ('" + completed[completed_saved] + "')");
+		}
+
+		return out;
+	}
+};
+
+class CharacterSaveStateTest : public Test::Suite {
+	typedef void(CharacterSaveStateTest::*TestFunction)(void);
+public:
+	CharacterSaveStateTest() {
+		TEST_ADD(CharacterSaveStateTest::SkipUnchangedTest);
+		TEST_ADD(CharacterSaveStateTest::FailedTransactionTest);
+		TEST_ADD(CharacterSaveStateTest::CommittedTransactionTest);
+	}
+
+	~CharacterSaveStateTest() {
+	}
+
+	private:
+	// builds one save of the tasks section the way Client::Save does, returning what would be sent
+	std::vector<std::string> BuildSave(EQ::CharacterSaveState &state, SaveStateTestTasks &tasks, uint32 &save_id) {
+		auto dirty  = tasks.dirty;
+		auto cursor = tasks.completed_saved;
+		state.OnFailure([&tasks, dirty, cursor]() {
+			for (size_t i = 0; i < dirty.size(); ++i) {
+				if (dirty[i]) {
+					tasks.dirty[i] = true;
+				}
+			}
+
+			tasks.completed_saved = std::min(tasks.completed_saved, cursor);
+		});
+
+		auto statements = tasks.Save();
+		if (!state.Changed(0, statements)) {
+			statements.clear();
+		}
+
+		save_id = state.Finish();
+		return statements;
+	}
+
+	void SkipUnchangedTest() {
+		EQ::CharacterSaveState state;
+
+		std::vector<std::string> data = { "UPDATE character_data SET hp = 100" };
+		TEST_ASSERT(state.Changed(1, data));
+		TEST_ASSERT(!state.Changed(1, data));
+
+		data[0] = "UPDATE character_data SET hp = 90";
+		TEST_ASSERT(state.Changed(1, data));
+
+		// a section that writes nothing still goes out the first time
+		TEST_ASSERT(state.Changed(2, {}));
+		TEST_ASSERT(!state.Changed(2, {}));
+
+		state.Reset();
+		TEST_ASSERT(state.Changed(1, data));
+		TEST_ASSERT(state.Changed(2, {}));
+
+		// the rows were written by something else, the same statements have to go out again
+		state.Forget(1);
+		TEST_ASSERT(state.Changed(1, data));
+		TEST_ASSERT(!state.Changed(2, {}));
+		state.Forget(5);
+		TEST_ASSERT(state.Changed(5, data));
+	}
+
+	void FailedTransactionTest() {
+		EQ::CharacterSaveState state;
+		SaveStateTestTasks     tasks;
+
+		tasks.dirty[1] = true;
+		tasks.completed.push_back("first");
+
+		uint32 first_save = 0;
+		auto   first      = BuildSave(state, tasks, first_save);
+		TEST_ASSERT_EQUALS(first.size(), 2);
+		TEST_ASSERT(!tasks.dirty[1]);
+		TEST_ASSERT_EQUALS(tasks.completed_saved, 1);
+
+		// a second save goes out before the first's transaction is done, with new progress of its own
+		tasks.dirty[2] = true;
+		tasks.completed.push_back("second");
+
+		uint32 second_save = 0;
+		auto   second      = BuildSave(state, tasks, second_save);
+		TEST_ASSERT_EQUALS(second.size(), 2);
+		TEST_ASSERT_EQUALS(state.PendingSaves(), 2);
+
+		// the first transaction rolls back, the second commits
+		state.Failed(first_save);
+		state.Committed(second_save);
+		TEST_ASSERT_EQUALS(state.PendingSaves(), 0);
+
+		// what only the failed save wrote is dirty again, what the committed one wrote isn't
+		TEST_ASSERT(tasks.dirty[1]);
+		TEST_ASSERT(!tasks.dirty[2]);
+		TEST_ASSERT_EQUALS(tasks.completed_saved, 0);
+
+		uint32 retry_save = 0;
+		auto   retry      = BuildSave(state, tasks, retry_save);
+		state.Committed(retry_save);
+
+		std::vector<std::string> expected = {
+			"REPLACE INTO tasks VALUES (1)",
+			"REPLACE INTO completed VALUES ('first')",
+			"REPLACE INTO completed VALUES ('second')"
+		};
+
+		TEST_ASSERT(retry == expected);
+		TEST_ASSERT(!tasks.dirty[1]);
+		TEST_ASSERT_EQUALS(tasks.completed_saved, 2);
+	}
+
+	void CommittedTransactionTest() {
+		EQ::CharacterSaveState state;
+		SaveStateTestTasks     tasks;
+
+		tasks.dirty[0] = true;
+
+		uint32 save_id = 0;
+		auto   saved   = BuildSave(state, tasks, save_id);
+		TEST_ASSERT_EQUALS(saved.size(), 1);
+
+		state.Committed(save_id);
+		TEST_ASSERT_EQUALS(state.PendingSaves(), 0);
+
+		// a failure reported for a save that already committed has nothing to put back
+		state.Failed(save_id);
+		TEST_ASSERT(!tasks.dirty[0]);
+
+		// with nothing dirty there is nothing to send
+		TEST_ASSERT(BuildSave(state, tasks, save_id).empty());
+		state.Committed(save_id);
+		TEST_ASSERT_EQUALS(state.PendingSaves(), 0);
+	}
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_DAYBREAK_CONNECTION_H
+#define __EQEMU_TESTS_DAYBREAK_CONNECTION_H
+
+#include "cppunit/cpptest.h"
+#include "../common/net/daybreak_connection.h"
+#include "loop_until.h"
+#include <memory>
+#include <vector>
+
+class DaybreakConnectionTest : public Test::Suite {
+	typedef void(DaybreakConnectionTest::*TestFunction)(void);
+public:
+	DaybreakConnectionTest() {
+		TEST_ADD(DaybreakConnectionTest::BatchedLoopbackTest);
+		TEST_ADD(DaybreakConnectionTest::UnbatchedLoopbackTest);
+		TEST_ADD(DaybreakConnectionTest::LossyLoopbackTest);
+		TEST_ADD(DaybreakConnectionTest::WrappedWindowTest);
+	}
+
+	~DaybreakConnectionTest() {
+	}
+
+	private:
+	// a client sends packets of every size from a few bytes to many fragments over loopback, which
+	// has the batch carry acks, runs of same sized fragments for gso and single datagrams together
+	void Loopback(bool batched_io, size_t packet_loss = 0) {
+		EQ::Net::DaybreakConnectionManagerOptions server_options;
+		server_options.batched_io = batched_io;
+		server_options.encode_passes[0] = EQ::Net::EncodeCompression;
+		server_options.simulated_out_packet_loss = packet_loss;
+
+		EQ::Net::DaybreakConnectionManagerOptions client_options;
+		client_options.batched_io = batched_io;
+		client_options.simulated_out_packet_loss = packet_loss;
+
+		EQ::Net::DaybreakConnectionManager server(server_options);
+		EQ::Net::DaybreakConnectionManager client(client_options);
+
+		std::vector<std::string> sent;
+		for (int i = 0; i < 300; ++i) {
+			// a leading zero byte would read as a protocol opcode, as it does for EQStream
+			std::string data((i * 37) % 3000 + 5, (char) i);
+			data[0] = 0x40;
+			memcpy(&data[1], &i, sizeof(i));
+			sent.push_back(data);
+		}
+
+		std::vector<std::string> received;
+		std::shared_ptr<EQ::Net::DaybreakConnection> connection;
+		server.OnPacketRecv([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, const EQ::Net::Packet &p) {
+			received.push_back(std::string((const char *) p.Data(), p.Length()));
+		});
+
+		client.OnConnectionStateChange([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to) {
+			if (to != EQ::Net::StatusConnected) {
+				return;
+			}
+
+			connection = c;
+			for (auto &s : sent) {
+				EQ::Net::StaticPacket p(&s[0], s.length());
+				c->QueuePacket(p);
+			}
+		});
+
+		client.Connect("127.0.0.1", server.LocalPort());
+
+		LoopUntil([&]() { return received.size() >= sent.size(); });
+
+		TEST_ASSERT_EQUALS(received.size(), sent.size());
+		TEST_ASSERT(received == sent);
+
+		// the window drains as the acks come in, whatever had to be resent on the way
+		TEST_ASSERT(connection != nullptr);
+		if (!connection) {
+			return;
+		}
+
+		LoopUntil([&]() { return connection->GetStats().sent_window == 0; });
+
+		auto stats = connection->GetStats();
+		TEST_ASSERT_EQUALS(stats.sent_window, 0);
+		TEST_ASSERT(stats.max_sent_window > 0);
+		if (packet_loss > 0) {
+			TEST_ASSERT(stats.resent_packets > 0);
+		}
+	}
+
+	void BatchedLoopbackTest() {
+		Loopback(true);
+	}
+
+	void UnbatchedLoopbackTest() {
+		Loopback(false);
+	}
+
+	void LossyLoopbackTest() {
+		Loopback(true, 10);
+	}
+
+	// packets go out in rounds that are each acked before the next, so later rounds reuse the send
+	// window's slots and have to carry their own headers rather than what a slot held before
+	void WrappedWindowTest() {
+		EQ::Net::DaybreakConnectionManagerOptions server_options;
+		EQ::Net::DaybreakConnectionManagerOptions client_options;
+
+		EQ::Net::DaybreakConnectionManager server(server_options);
+		EQ::Net::DaybreakConnectionManager client(client_options);
+
+		std::vector<std::string> received;
+		std::shared_ptr<EQ::Net::DaybreakConnection> connection;
+		server.OnPacketRecv([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, const EQ::Net::Packet &p) {
+			received.push_back(std::string((const char *) p.Data(), p.Length()));
+		});
+
+		client.OnConnectionStateChange([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to) {
+			if (to == EQ::Net::StatusConnected) {
+				connection = c;
+			}
+		});
+
+		client.Connect("127.0.0.1", server.LocalPort());
+
+		LoopUntil([&]() { return connection != nullptr; });
+
+		TEST_ASSERT(connection != nullptr);
+		if (!connection) {
+			return;
+		}
+
+		std::vector<std::string> sent;
+		for (int round = 0; round < 6; ++round) {
+			for (int i = 0; i < 50; ++i) {
+				int n = round * 50 + i;
+				std::string data((n * 37) % 1500 + 5, (char) n);
+				data[0] = 0x40;
+				memcpy(&data[1], &n, sizeof(n));
+				sent.push_back(data);
+
+				EQ::Net::StaticPacket p(&data[0], data.length());
+				connection->QueuePacket(p);
+			}
+
+			LoopUntil([&]() { return received.size() >= sent.size() && connection->GetStats().sent_window == 0; });
+		}
+
+		TEST_ASSERT_EQUALS(received.size(), sent.size());
+		TEST_ASSERT(received == sent);
+		TEST_ASSERT_EQUALS(connection->GetStats().sent_window, 0);
+	}
+};
+
+#endif
@@ -0,0 +1,238 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_EQ_BROADCAST_PACKET_H
+#define __EQEMU_TESTS_EQ_BROADCAST_PACKET_H
+
+#include "cppunit/cpptest.h"
+#include "../common/eq_broadcast_packet.h"
+#include "../common/eq_stream_proxy.h"
+#include "../common/opcodemgr.h"
+#include "../common/struct_strategy.h"
+#include <cstring>
+#include <memory>
+
+// appends a marker byte for its version and follows up with a second, unacked packet
+class BroadcastTestStrategy : public StructStrategy {
+public:
+	BroadcastTestStrategy(EQ::versions::ClientVersion version) : m_version(version) {
+		encoders[OP_HPUpdate] = Encode_OP_HPUpdate;
+	}
+
+	virtual std::string Describe() const { return "Broadcast Test"; }
+	virtual const EQ::versions::ClientVersion ClientVersion() const { return m_version; }
+
+	static int &Encodes() {
+		static int encodes = 0;
+		return encodes;
+	}
+
+private:
+	static void Encode_OP_HPUpdate(EQApplicationPacket **p, std::shared_ptr<EQStreamInterface> dest, bool ack_req) {
+		EQApplicationPacket *in = *p;
+		*p = nullptr;
+
+		Encodes()++;
+
+		auto out = new EQApplicationPacket(OP_HPUpdate, in->size + 1);
+		memcpy(out->pBuffer, in->pBuffer, in->size);
+		out->pBuffer[in->size] = 0xAB;
+		delete in;
+
+		auto health = new EQApplicationPacket(OP_MobHealth, 1);
+		health->pBuffer[0] = 100;
+
+		dest->FastQueuePacket(&out, ack_req);
+		dest->FastQueuePacket(&health, false);
+	}
+
+	EQ::versions::ClientVersion m_version;
+};
+
+// records what a connection would be handed, opcode first, whichever path the packet took
+class BroadcastTestStream : public EQStreamInterface {
+public:
+	virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req) {
+		uint16      opcode = (*m_opcodes)->EmuToEQ(p->GetOpcode());
+		std::string wire((const char *) &opcode, sizeof(opcode));
+		wire.append((const char *) p->pBuffer, p->size);
+		sent.push_back(wire);
+		acks.push_back(ack_req);
+	}
+
+	virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req) {
+		QueuePacket(*p, ack_req);
+		delete *p;
+		*p = nullptr;
+	}
+
+	virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames) {
+		last_frames = frames.get();
+		for (auto &f : *frames) {
+			sent.push_back(std::string((const char *) f.data.Data(), f.data.Length()));
+			acks.push_back(f.ack_req);
+		}
+	}
+
+	virtual EQApplicationPacket *PopPacket() { return nullptr; }
+	virtual void Close() { }
+	virtual void ReleaseFromUse() { }
+	virtual void RemoveData() { }
+	virtual std::string GetRemoteAddr() const { return std::string(); }
+	virtual uint32 GetRemoteIP() const { return 0; }
+	virtual uint16 GetRemotePort() const { return 0; }
+	virtual bool CheckState(EQStreamState state) { return state == ESTABLISHED; }
+	virtual std::string Describe() const { return "Broadcast Test Stream"; }
+	virtual EQStreamState GetState() { return ESTABLISHED; }
+	virtual void SetOpcodeManager(OpcodeManager **opm) { m_opcodes = opm; }
+	virtual OpcodeManager *GetOpcodeManager() const { return *m_opcodes; }
+	virtual Stats GetStats() const { return Stats(); }
+	virtual void ResetStats() { }
+	virtual EQStreamManagerInterface *GetManager() const { return nullptr; }
+
+	std::vector<std::string>        sent;
+	std::vector<bool>               acks;
+	const EQBroadcastPacket::Frames *last_frames = nullptr;
+
+private:
+	OpcodeManager **m_opcodes = nullptr;
+};
+
+class EQBroadcastPacketTest : public Test::Suite {
+	typedef void(EQBroadcastPacketTest::*TestFunction)(void);
+public:
+	EQBroadcastPacketTest() {
+		TEST_ADD(EQBroadcastPacketTest::EncodeOncePerVersionTest);
+		TEST_ADD(EQBroadcastPacketTest::MatchesQueuePacketTest);
+		TEST_ADD(EQBroadcastPacketTest::AckTest);
+	}
+
+	~EQBroadcastPacketTest() {
+		delete m_opcodes;
+	}
+
+	private:
+	struct Recipient {
+		BroadcastTestStream           *stream;
+		std::unique_ptr<EQStreamProxy> proxy;
+	};
+
+	Recipient MakeRecipient(const StructStrategy *structs) {
+		auto      stream = std::make_shared<BroadcastTestStream>();
+		Recipient r;
+		r.stream = stream.get();
+
+		std::shared_ptr<EQStreamInterface> s = stream;
+		r.proxy.reset(new EQStreamProxy(s, structs, &m_opcodes));
+		return r;
+	}
+
+	void EncodeOncePerVersionTest() {
+		BroadcastTestStrategy rof2(EQ::versions::ClientVersion::RoF2);
+		BroadcastTestStrategy uf(EQ::versions::ClientVersion::UF);
+
+		std::vector<Recipient> recipients;
+		for (int i = 0; i < 6; ++i) {
+			recipients.push_back(MakeRecipient(i % 3 == 0 ? &uf : &rof2));
+		}
+
+		EQApplicationPacket app(OP_HPUpdate, 4);
+		memset(app.pBuffer, 7, 4);
+
+		Encodes() = 0;
+
+		EQBroadcastPacket broadcast(&app);
+		for (auto &r : recipients) {
+			r.proxy->QueueBroadcastPacket(broadcast);
+		}
+
+		TEST_ASSERT_EQUALS(Encodes(), 2);
+		TEST_ASSERT_EQUALS(broadcast.GetEncodeCount(), 2);
+
+		// every rof2 recipient was handed the very same frames
+		TEST_ASSERT(recipients[1].stream->last_frames != nullptr);
+		TEST_ASSERT(recipients[1].stream->last_frames == recipients[2].stream->last_frames);
+		TEST_ASSERT(recipients[1].stream->last_frames == recipients[5].stream->last_frames);
+		TEST_ASSERT(recipients[0].stream->last_frames == recipients[3].stream->last_frames);
+		TEST_ASSERT(recipients[0].stream->last_frames != recipients[1].stream->last_frames);
+
+		auto &sent = recipients[1].stream->sent;
+		TEST_ASSERT_EQUALS(sent.size(), 2);
+		TEST_ASSERT_EQUALS(sent[0].size(), 2 + 5);
+		TEST_ASSERT_EQUALS(*(uint16 *) sent[0].data(), 0x1234);
+		TEST_ASSERT_EQUALS((uint8) sent[0][6], 0xAB);
+		TEST_ASSERT_EQUALS(*(uint16 *) sent[1].data(), 0x4321);
+	}
+
+	void MatchesQueuePacketTest() {
+		BroadcastTestStrategy rof2(EQ::versions::ClientVersion::RoF2);
+
+		auto queued      = MakeRecipient(&rof2);
+		auto broadcasted = MakeRecipient(&rof2);
+
+		EQApplicationPacket hp(OP_HPUpdate, 4);
+		memset(hp.pBuffer, 3, 4);
+
+		// passes through the strategy untouched
+		EQApplicationPacket update(OP_ClientUpdate, 6);
+		memset(update.pBuffer, 9, 6);
+
+		for (auto app : { &hp, &update }) {
+			queued.proxy->QueuePacket(app);
+
+			EQBroadcastPacket broadcast(app);
+			broadcasted.proxy->QueueBroadcastPacket(broadcast);
+		}
+
+		TEST_ASSERT_EQUALS(queued.stream->sent.size(), 3);
+		TEST_ASSERT(queued.stream->sent == broadcasted.stream->sent);
+		TEST_ASSERT(queued.stream->acks == broadcasted.stream->acks);
+	}
+
+	void AckTest() {
+		BroadcastTestStrategy rof2(EQ::versions::ClientVersion::RoF2);
+
+		auto acked   = MakeRecipient(&rof2);
+		auto unacked = MakeRecipient(&rof2);
+
+		EQApplicationPacket app(OP_HPUpdate, 4);
+		EQBroadcastPacket   broadcast(&app);
+
+		acked.proxy->QueueBroadcastPacket(broadcast, true);
+		unacked.proxy->QueueBroadcastPacket(broadcast, false);
+
+		TEST_ASSERT_EQUALS(broadcast.GetEncodeCount(), 2);
+		TEST_ASSERT(acked.stream->acks[0]);
+		TEST_ASSERT(!unacked.stream->acks[0]);
+	}
+
+	int &Encodes() { return BroadcastTestStrategy::Encodes(); }
+
+	OpcodeManager *m_opcodes = MakeOpcodes();
+
+	static OpcodeManager *MakeOpcodes() {
+		auto opcodes = new EmptyOpcodeManager();
+		opcodes->SetOpcode(OP_HPUpdate, 0x1234);
+		opcodes->SetOpcode(OP_MobHealth, 0x4321);
+		opcodes->SetOpcode(OP_ClientUpdate, 0x5678);
+		return opcodes;
+	}
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_EQSTREAM_H
+#define __EQEMU_TESTS_EQSTREAM_H
+
+#include "cppunit/cpptest.h"
+#include "../common/net/eqstream.h"
+#include "../common/event/event_loop.h"
+#include "../common/opcodemgr.h"
+#include "loop_until.h"
+#include <memory>
+#include <vector>
+
+class EQStreamTest : public Test::Suite {
+	typedef void(EQStreamTest::*TestFunction)(void);
+public:
+	EQStreamTest() {
+		TEST_ADD(EQStreamTest::InlineEchoTest);
+		TEST_ADD(EQStreamTest::NetworkThreadEchoTest);
+	}
+
+	~EQStreamTest() {
+	}
+
+	private:
+	// a plain daybreak client sends packets to a stream, which echoes each back as it pops them
+	void Echo(bool network_thread) {
+		EmptyOpcodeManager opcodes;
+		opcodes.SetOpcode(OP_HPUpdate, 0x1234);
+		OpcodeManager *opcode_manager = &opcodes;
+
+		EQStreamManagerInterfaceOptions server_options(0, false, true);
+		server_options.network_thread = network_thread;
+
+		EQ::Net::DaybreakConnectionManagerOptions client_options;
+
+		std::vector<std::string> sent;
+		for (int i = 0; i < 200; ++i) {
+			std::string data((i * 53) % 2000 + 2 + sizeof(i), (char) i);
+			data[0] = 0x34;
+			data[1] = 0x12;
+			memcpy(&data[2], &i, sizeof(i));
+			sent.push_back(data);
+		}
+
+		std::vector<std::string> echoed;
+		std::shared_ptr<EQ::Net::EQStream> stream;
+		EQStreamState state = UNESTABLISHED;
+
+		{
+			EQ::Net::EQStreamManager server(server_options);
+			server.OnNewConnection([&](std::shared_ptr<EQ::Net::EQStream> s) {
+				stream = s;
+				stream->SetOpcodeManager(&opcode_manager);
+				state = stream->GetState();
+			});
+
+			EQ::Net::DaybreakConnectionManager client(client_options);
+			client.OnPacketRecv([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, const EQ::Net::Packet &p) {
+				echoed.push_back(std::string((const char *) p.Data(), p.Length()));
+			});
+
+			client.OnConnectionStateChange([&](std::shared_ptr<EQ::Net::DaybreakConnection> c, EQ::Net::DbProtocolStatus from, EQ::Net::DbProtocolStatus to) {
+				if (to != EQ::Net::StatusConnected) {
+					return;
+				}
+
+				for (auto &s : sent) {
+					EQ::Net::StaticPacket p(&s[0], s.length());
+					c->QueuePacket(p);
+				}
+			});
+
+			client.Connect("127.0.0.1", server.LocalPort());
+
+			bool opcodes_match = true;
+			LoopUntil([&]() {
+				if (stream) {
+					EQApplicationPacket *app;
+					while ((app = stream->PopPacket()) != nullptr) {
+						opcodes_match = opcodes_match && app->GetOpcode() == OP_HPUpdate;
+						stream->QueuePacket(app);
+						delete app;
+					}
+				}
+
+				return echoed.size() >= sent.size();
+			});
+
+			TEST_ASSERT(opcodes_match);
+			TEST_ASSERT(stream != nullptr);
+			TEST_ASSERT_EQUALS(state, ESTABLISHED);
+			TEST_ASSERT_EQUALS(echoed.size(), sent.size());
+			TEST_ASSERT(echoed == sent);
+
+			stream.reset();
+		}
+
+		// the manager has to let go of its loop handles, on whichever loop they were made
+		EQ::EventLoop::Get().Process();
+	}
+
+	void InlineEchoTest() {
+		Echo(false);
+	}
+
+	void NetworkThreadEchoTest() {
+		Echo(true);
+	}
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef __EQEMU_TESTS_LOOP_UNTIL_H
+#define __EQEMU_TESTS_LOOP_UNTIL_H
+
+#include "../common/event/event_loop.h"
+#include <chrono>
+#include <functional>
+
+// runs this thread's event loop until done returns true or the timeout passes. the loop blocks
+// waiting on its handles between checks, a timer of our own bounds the wait
+inline bool LoopUntil(const std::function<bool()> &done, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+{
+	if (done()) {
+		return true;
+	}
+
+	auto loop = EQ::EventLoop::Get().Handle();
+	bool timed_out = false;
+
+	uv_timer_t *timer = new uv_timer_t;
+	memset(timer, 0, sizeof(uv_timer_t));
+	uv_timer_init(loop, timer);
+	timer->data = &timed_out;
+	uv_timer_start(timer, [](uv_timer_t *handle) {
+		*(bool*)handle->data = true;
+	}, timeout.count(), 0);
+
+	bool result = false;
+	while (!(result = done()) && !timed_out) {
+		uv_run(loop, UV_RUN_ONCE);
+	}
+
+	uv_close((uv_handle_t*)timer, [](uv_handle_t *handle) {
+		delete (uv_timer_t*)handle;
+	});
+
+	return result;
+}
+
+#endif
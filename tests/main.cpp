@@ -32,6 +32,15 @@
 #include "data_verification_test.h"
 #include "skills_util_test.h"
 #include "task_state_test.h"
+#include "mpsc_ring_test.h"
+#include "spsc_ring_test.h"
+#include "timing_wheel_test.h"
+#include "eq_broadcast_packet_test.h"
+#include "daybreak_connection_test.h"
+#include "eqstream_test.h"
+#include "servertalk_test.h"
+#include "character_save_state_test.h"
+#include "character_data_repository_test.h"
 
 const EQEmuConfig *Config;
 EQEmuLogSys       LogSys;
@@ -58,6 +67,15 @@ int main()
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
 		tests.add(new TaskStateTest());
+		tests.add(new MPSCRingTest());
+		tests.add(new SPSCRingTest());
+		tests.add(new TimingWheelTest());
+		tests.add(new EQBroadcastPacketTest());
+		tests.add(new DaybreakConnectionTest());
+		tests.add(new EQStreamTest());
+		tests.add(new ServertalkTest());
+		tests.add(new CharacterSaveStateTest());
+		tests.add(new CharacterDataRepositoryTest());
 		tests.run(*output, true);
 	}
 	catch (std::exception &ex) {
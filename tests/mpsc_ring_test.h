@@ -0,0 +1,131 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_MPSC_RING_H
+#define __EQEMU_TESTS_MPSC_RING_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/mpsc_ring.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+class MPSCRingTest : public Test::Suite {
+	typedef void(MPSCRingTest::*TestFunction)(void);
+public:
+	MPSCRingTest() {
+		TEST_ADD(MPSCRingTest::CapacityTest);
+		TEST_ADD(MPSCRingTest::OrderTest);
+		TEST_ADD(MPSCRingTest::FullTest);
+		TEST_ADD(MPSCRingTest::WrapTest);
+		TEST_ADD(MPSCRingTest::ProducersTest);
+	}
+
+	~MPSCRingTest() {
+	}
+
+	private:
+	void CapacityTest() {
+		EQ::Util::MPSCRing<int> ring(100);
+		TEST_ASSERT_EQUALS(ring.Capacity(), 128);
+	}
+
+	void OrderTest() {
+		EQ::Util::MPSCRing<std::string> ring(8);
+		TEST_ASSERT(ring.TryPush(std::string("a")));
+		TEST_ASSERT(ring.TryPush(std::string("b")));
+
+		std::string out;
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, "a");
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, "b");
+		TEST_ASSERT(!ring.TryPop(out));
+	}
+
+	void FullTest() {
+		EQ::Util::MPSCRing<int> ring(4);
+		for (int i = 0; i < 4; ++i) {
+			TEST_ASSERT(ring.TryPush(int(i)));
+		}
+
+		TEST_ASSERT(!ring.TryPush(4));
+
+		int out = 0;
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, 0);
+		TEST_ASSERT(ring.TryPush(4));
+	}
+
+	void WrapTest() {
+		EQ::Util::MPSCRing<int> ring(4);
+		int out = 0;
+		for (int i = 0; i < 1000; ++i) {
+			TEST_ASSERT(ring.TryPush(int(i)));
+			TEST_ASSERT(ring.TryPop(out));
+			TEST_ASSERT_EQUALS(out, i);
+		}
+	}
+
+	void ProducersTest() {
+		const int producers    = 4;
+		const int per_producer = 20000;
+
+		EQ::Util::MPSCRing<int> ring(1024);
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; ++p) {
+			threads.emplace_back([&ring, p]() {
+				for (int i = 0; i < per_producer; ++i) {
+					while (!ring.TryPush(p * per_producer + i)) {
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		// every value arrives exactly once and each producer's values stay in order
+		std::vector<int> last(producers, -1);
+		int              received = 0;
+		bool             ordered  = true;
+		int              out      = 0;
+		while (received < producers * per_producer) {
+			if (!ring.TryPop(out)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			int p = out / per_producer;
+			if (out <= last[p]) {
+				ordered = false;
+			}
+
+			last[p] = out;
+			received++;
+		}
+
+		for (auto &t : threads) {
+			t.join();
+		}
+
+		TEST_ASSERT(ordered);
+		TEST_ASSERT_EQUALS(received, producers * per_producer);
+		TEST_ASSERT(!ring.TryPop(out));
+	}
+};
+
+#endif
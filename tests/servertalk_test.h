@@ -0,0 +1,107 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+
+#ifndef __EQEMU_TESTS_SERVERTALK_H
+#define __EQEMU_TESTS_SERVERTALK_H
+
+#include "cppunit/cpptest.h"
+#include "../common/servertalk.h"
+#include "../common/net/servertalk_server.h"
+#include "../common/net/servertalk_client_connection.h"
+#include "loop_until.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class ServertalkTest : public Test::Suite {
+	typedef void(ServertalkTest::*TestFunction)(void);
+public:
+	ServertalkTest() {
+		TEST_ADD(ServertalkTest::LoopbackTest);
+	}
+
+	~ServertalkTest() {
+	}
+
+	private:
+	// messages sent in the same loop iteration go out together, sizes run from empty to larger than
+	// a write chunk so a batch spans several, and each has to arrive whole and in order both ways
+	void LoopbackTest() {
+		EQ::Net::ServertalkServerOptions opts;
+		opts.port = 0;
+		opts.credentials = "test";
+
+		std::shared_ptr<EQ::Net::ServertalkServerConnection> zone;
+		EQ::Net::ServertalkServer server;
+		server.Listen(opts);
+
+		std::vector<std::string> sent;
+		for (int i = 0; i < 200; ++i) {
+			std::string data((i * 997) % 90000, (char) i);
+			if (data.length() >= sizeof(i)) {
+				memcpy(&data[0], &i, sizeof(i));
+			}
+
+			sent.push_back(data);
+		}
+
+		std::vector<std::string> received;
+		EQ::Net::ServertalkClient client("127.0.0.1", server.LocalPort(), false, "Zone", "test");
+		client.OnMessage(ServerOP_ChannelMessage, [&](uint16_t opcode, EQ::Net::Packet &p) {
+			received.push_back(std::string((const char *) p.Data(), p.Length()));
+		});
+
+		std::vector<std::string> echoed;
+		server.OnConnectionIdentified("Zone", [&](std::shared_ptr<EQ::Net::ServertalkServerConnection> c) {
+			zone = c;
+			zone->OnMessage(ServerOP_ChannelMessage, [&](uint16_t opcode, EQ::Net::Packet &p) {
+				echoed.push_back(std::string((const char *) p.Data(), p.Length()));
+			});
+		});
+
+		LoopUntil([&]() { return zone != nullptr; });
+
+		TEST_ASSERT(zone != nullptr);
+		if (!zone) {
+			return;
+		}
+
+		for (auto &s : sent) {
+			ServerPacket pack(ServerOP_ChannelMessage, s.length());
+			if (s.length() > 0) {
+				memcpy(pack.pBuffer, s.data(), s.length());
+			}
+
+			zone->SendPacket(&pack);
+			client.SendPacket(&pack);
+		}
+
+		LoopUntil([&]() { return received.size() >= sent.size() && echoed.size() >= sent.size(); });
+
+		// an empty message is padded to a single zero byte on the way out
+		sent[0] = std::string(1, '\0');
+
+		TEST_ASSERT_EQUALS(received.size(), sent.size());
+		TEST_ASSERT(received == sent);
+		TEST_ASSERT_EQUALS(echoed.size(), sent.size());
+		TEST_ASSERT(echoed == sent);
+	}
+};
+
+#endif
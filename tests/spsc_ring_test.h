@@ -0,0 +1,135 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SPSC_RING_H
+#define __EQEMU_TESTS_SPSC_RING_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/spsc_ring.h"
+#include <memory>
+#include <string>
+#include <thread>
+
+class SPSCRingTest : public Test::Suite {
+	typedef void(SPSCRingTest::*TestFunction)(void);
+public:
+	SPSCRingTest() {
+		TEST_ADD(SPSCRingTest::CapacityTest);
+		TEST_ADD(SPSCRingTest::OrderTest);
+		TEST_ADD(SPSCRingTest::FullTest);
+		TEST_ADD(SPSCRingTest::WrapTest);
+		TEST_ADD(SPSCRingTest::MoveOnlyTest);
+		TEST_ADD(SPSCRingTest::ThreadsTest);
+	}
+
+	~SPSCRingTest() {
+	}
+
+	private:
+	void CapacityTest() {
+		EQ::Util::SPSCRing<int> ring(100);
+		TEST_ASSERT_EQUALS(ring.Capacity(), 128);
+	}
+
+	void OrderTest() {
+		EQ::Util::SPSCRing<std::string> ring(8);
+		TEST_ASSERT(ring.TryPush(std::string("a")));
+		TEST_ASSERT(ring.TryPush(std::string("b")));
+
+		std::string out;
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, "a");
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, "b");
+		TEST_ASSERT(!ring.TryPop(out));
+	}
+
+	void FullTest() {
+		EQ::Util::SPSCRing<std::string> ring(4);
+		for (int i = 0; i < 4; ++i) {
+			TEST_ASSERT(ring.TryPush(std::to_string(i)));
+		}
+
+		// a failed push keeps the value for the caller to hold on to
+		std::string extra("4");
+		TEST_ASSERT(!ring.TryPush(std::move(extra)));
+		TEST_ASSERT_EQUALS(extra, "4");
+
+		std::string out;
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT_EQUALS(out, "0");
+		TEST_ASSERT(ring.TryPush(std::move(extra)));
+	}
+
+	void WrapTest() {
+		EQ::Util::SPSCRing<int> ring(4);
+		int out = 0;
+		for (int i = 0; i < 1000; ++i) {
+			TEST_ASSERT(ring.TryPush(int(i)));
+			TEST_ASSERT(ring.TryPop(out));
+			TEST_ASSERT_EQUALS(out, i);
+		}
+	}
+
+	void MoveOnlyTest() {
+		EQ::Util::SPSCRing<std::unique_ptr<int>> ring(4);
+		TEST_ASSERT(ring.TryPush(std::make_unique<int>(7)));
+
+		std::unique_ptr<int> out;
+		TEST_ASSERT(ring.TryPop(out));
+		TEST_ASSERT(out != nullptr);
+		TEST_ASSERT_EQUALS(*out, 7);
+	}
+
+	void ThreadsTest() {
+		const int count = 200000;
+
+		EQ::Util::SPSCRing<int> ring(256);
+		std::thread producer([&ring, count]() {
+			for (int i = 0; i < count; ++i) {
+				while (!ring.TryPush(int(i))) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		// every value arrives exactly once and in order
+		int  expected = 0;
+		bool ordered  = true;
+		int  out      = 0;
+		while (expected < count) {
+			if (!ring.TryPop(out)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			if (out != expected) {
+				ordered = false;
+			}
+
+			expected++;
+		}
+
+		producer.join();
+
+		TEST_ASSERT(ordered);
+		TEST_ASSERT(!ring.TryPop(out));
+	}
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_TIMING_WHEEL_H
+#define __EQEMU_TESTS_TIMING_WHEEL_H
+
+#include "cppunit/cpptest.h"
+#include "../common/event/timing_wheel.h"
+#include <memory>
+#include <vector>
+
+extern uint32 current_time;
+
+class TimingWheelTest : public Test::Suite {
+	typedef void(TimingWheelTest::*TestFunction)(void);
+public:
+	TimingWheelTest() {
+		TEST_ADD(TimingWheelTest::MatchesPolledTimerTest);
+		TEST_ADD(TimingWheelTest::LongTimerTest);
+		TEST_ADD(TimingWheelTest::DisableTest);
+		TEST_ADD(TimingWheelTest::CallbackTest);
+		TEST_ADD(TimingWheelTest::DestroyWhileDueTest);
+	}
+
+	~TimingWheelTest() {
+	}
+
+	private:
+	// steps the shared clock and the wheel the way the zone loop does
+	void Step(EQ::TimingWheel &wheel, uint32 ms) {
+		current_time += ms;
+		wheel.Advance(current_time);
+	}
+
+	void MatchesPolledTimerTest() {
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		std::vector<uint32> durations = { 1, 31, 32, 100, 2000, 6000, 70000 };
+		std::vector<std::unique_ptr<Timer>>          polled;
+		std::vector<std::unique_ptr<EQ::WheelTimer>> wheeled;
+		for (auto d : durations) {
+			polled.emplace_back(std::make_unique<Timer>(d));
+			wheeled.emplace_back(std::make_unique<EQ::WheelTimer>(d, false, wheel));
+		}
+
+		bool matched = true;
+		for (int frame = 0; frame < 5000; ++frame) {
+			Step(wheel, 32);
+			for (size_t i = 0; i < durations.size(); ++i) {
+				if (polled[i]->Check() != wheeled[i]->Check()) {
+					matched = false;
+				}
+			}
+		}
+
+		TEST_ASSERT(matched);
+	}
+
+	void LongTimerTest() {
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		// longer than the top level so it has to be parked and re-filed
+		const uint32   duration = 20000000;
+		EQ::WheelTimer t(duration, false, wheel);
+
+		Step(wheel, duration);
+		TEST_ASSERT(!t.Check());
+		Step(wheel, 1);
+		TEST_ASSERT(t.Check());
+		TEST_ASSERT(!t.Check());
+	}
+
+	void DisableTest() {
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		EQ::WheelTimer t(100, false, wheel);
+		TEST_ASSERT(t.Scheduled());
+
+		t.Disable();
+		TEST_ASSERT(!t.Scheduled());
+		Step(wheel, 200);
+		TEST_ASSERT(!t.Check());
+
+		t.Start(50);
+		Step(wheel, 50);
+		TEST_ASSERT(!t.Check());
+		Step(wheel, 1);
+		TEST_ASSERT(t.Check());
+
+		t.Trigger();
+		Step(wheel, 1);
+		TEST_ASSERT(t.Check());
+	}
+
+	void CallbackTest() {
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		int            fired = 0;
+		EQ::WheelTimer t(1000, false, wheel);
+		t.SetCallback([&fired]() { fired++; });
+
+		for (int i = 0; i < 100; ++i) {
+			Step(wheel, 32);
+		}
+
+		// 3200ms of frames fire a 1000ms timer three times
+		TEST_ASSERT_EQUALS(fired, 3);
+		TEST_ASSERT(t.Scheduled());
+	}
+
+	void DestroyWhileDueTest() {
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		// both land in the same slot and the first to fire destroys the other
+		std::unique_ptr<EQ::WheelTimer> victim;
+		EQ::WheelTimer                  killer(100, false, wheel);
+		killer.SetCallback([&victim]() { victim.reset(); });
+		victim = std::make_unique<EQ::WheelTimer>(100, false, wheel);
+
+		Step(wheel, 200);
+		TEST_ASSERT(!victim);
+		TEST_ASSERT_EQUALS(wheel.Count(), 1);
+	}
+};
+
+#endif
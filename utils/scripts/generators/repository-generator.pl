@@ -222,7 +222,9 @@ foreach my $table_to_generate (@tables) {
     my $table_struct_columns       = "";
     my $cereal_columns             = "";
     my $update_one_entries         = "";
+    my $mark_changed_entries       = "";
     my $all_entries                = "";
+    my $stmt_entries               = "";
     my $index                      = 0;
     my %table_data                 = ();
     my %table_primary_key          = ();
@@ -303,12 +305,16 @@ foreach my $table_to_generate (@tables) {
             }
 
             $update_one_entries .= sprintf(
-                "\t\t" . 'v.push_back(columns[%s] + " = %s' . "\n",
+                "\t\t" . 'if (e.changed_columns[%s]) { v.push_back(columns[%s] + " = %s }' . "\n",
+                $index,
                 $index,
                 $query_value
             );
         }
 
+        # mark changed
+        $mark_changed_entries .= sprintf("\t\te.changed_columns[%s] = e.%s != original.%s;\n", $index, $column_name_formatted, $column_name_formatted);
+
         # insert
         my $value = sprintf("\"'\" + Strings::Escape(e.%s) + \"'\"", $column_name_formatted);
         if ($data_type =~ /int|float|double|decimal/) {
@@ -365,6 +371,20 @@ foreach my $table_to_generate (@tables) {
             $find_one_entries .= sprintf("\t\t\te.%-${longest_column_length}s = row[%s] ? row[%s] : %s;\n", $column_name_formatted, $index, $index, $default_value);
         }
 
+        # find one / all (binary protocol, columns arrive in their server types)
+        if ($column_type =~ /unsigned/ && $data_type =~ /float|decimal/) {
+            $stmt_entries .= sprintf("\t\te.%-${longest_column_length}s = row.Get<float>(%s).value_or(0.0f) > 0.0f ? *row.Get<float>(%s) : %s;\n", $column_name_formatted, $index, $index, $default_value);
+        }
+        elsif ($data_type =~ /datetime|timestamp/) {
+            $stmt_entries .= sprintf("\t\te.%-${longest_column_length}s = row.Get<int64_t>(%s).value_or(-1);\n", $column_name_formatted, $index);
+        }
+        elsif ($struct_data_type eq "std::string") {
+            $stmt_entries .= sprintf("\t\te.%-${longest_column_length}s = row.GetStr(%s).value_or(%s);\n", $column_name_formatted, $index, $default_value);
+        }
+        else {
+            $stmt_entries .= sprintf("\t\te.%-${longest_column_length}s = row.Get<%s>(%s).value_or(%s);\n", $column_name_formatted, $struct_data_type, $index, $default_value);
+        }
+
         # print $column_name . "\n";
 
         # print "table_name [$table_name] column_name [$column_name] data_type [$data_type] column_type [$column_type]\n";
@@ -449,9 +469,11 @@ foreach my $table_to_generate (@tables) {
     chomp($table_struct_columns);
     chomp($default_entries);
     chomp($update_one_entries);
+    chomp($mark_changed_entries);
     chomp($insert_one_entries);
     chomp($insert_many_entries);
     chomp($all_entries);
+    chomp($stmt_entries);
 
     use POSIX qw(strftime);
     my $generated_date = strftime "%b%e, %Y", localtime;
@@ -475,9 +497,12 @@ foreach my $table_to_generate (@tables) {
     $new_base_repository =~ s/\{\{TABLE_STRUCT_COLUMNS}}/$table_struct_columns/g;
     $new_base_repository =~ s/\{\{FIND_ONE_ENTRIES}}/$find_one_entries/g;
     $new_base_repository =~ s/\{\{UPDATE_ONE_ENTRIES}}/$update_one_entries/g;
+    $new_base_repository =~ s/\{\{MARK_CHANGED_ENTRIES}}/$mark_changed_entries/g;
+    $new_base_repository =~ s/\{\{COLUMN_COUNT}}/$index/g;
     $new_base_repository =~ s/\{\{INSERT_ONE_ENTRIES}}/$insert_one_entries/g;
     $new_base_repository =~ s/\{\{INSERT_MANY_ENTRIES}}/$insert_many_entries/g;
     $new_base_repository =~ s/\{\{ALL_ENTRIES}}/$all_entries/g;
+    $new_base_repository =~ s/\{\{STMT_ENTRIES}}/$stmt_entries/g;
     $new_base_repository =~ s/\{\{GENERATED_DATE}}/$generated_date/g;
     $new_base_repository =~ s/\{\{ADDITIONAL_INCLUDES}}\n/$additional_includes/g;
 
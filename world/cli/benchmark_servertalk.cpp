@@ -0,0 +1,110 @@
+#include <chrono>
+#include <iostream>
+#include "../../common/strings.h"
+#include "../../common/servertalk.h"
+#include "../../common/event/event_loop.h"
+#include "../../common/net/servertalk_server.h"
+#include "../../common/net/servertalk_client_connection.h"
+
+void WorldserverCLI::BenchmarkServertalk(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark messages per second from world to a zone over a loopback servertalk link";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:servertalk [--messages=1000000] [--size=64] [--per-frame=500] [--port=9150]\n";
+		std::cout << "  --per-frame is how many messages are sent between each pass of the event loop\n";
+		return;
+	}
+
+	uint32 messages = 1000000;
+	if (!cmd("--messages").str().empty()) {
+		messages = std::max(1u, Strings::ToUnsignedInt(cmd("--messages").str(), messages));
+	}
+
+	uint32 size = 64;
+	if (!cmd("--size").str().empty()) {
+		size = std::max(1u, Strings::ToUnsignedInt(cmd("--size").str(), size));
+	}
+
+	uint32 per_frame = 500;
+	if (!cmd("--per-frame").str().empty()) {
+		per_frame = std::max(1u, Strings::ToUnsignedInt(cmd("--per-frame").str(), per_frame));
+	}
+
+	uint32 port = 9150;
+	if (!cmd("--port").str().empty()) {
+		port = Strings::ToUnsignedInt(cmd("--port").str(), port);
+	}
+
+	const std::string credentials = "benchmark";
+
+	EQ::Net::ServertalkServerOptions opts;
+	opts.port        = port;
+	opts.credentials = credentials;
+
+	std::shared_ptr<EQ::Net::ServertalkServerConnection> zone;
+
+	EQ::Net::ServertalkServer server;
+	server.Listen(opts);
+	server.OnConnectionIdentified(
+		"Zone", [&zone](std::shared_ptr<EQ::Net::ServertalkServerConnection> connection) {
+			zone = connection;
+		}
+	);
+
+	uint64 received       = 0;
+	uint64 received_bytes = 0;
+
+	EQ::Net::ServertalkClient client("127.0.0.1", port, false, "Zone", credentials);
+	client.OnMessage(
+		ServerOP_ChannelMessage, [&](uint16 opcode, EQ::Net::Packet &p) {
+			received++;
+			received_bytes += p.Length();
+		}
+	);
+
+	using clock = std::chrono::steady_clock;
+
+	auto &loop    = EQ::EventLoop::Get();
+	auto deadline = clock::now() + std::chrono::seconds(10);
+	while (!zone && clock::now() < deadline) {
+		loop.Process();
+	}
+
+	if (!zone) {
+		std::cout << fmt::format("Unable to link a zone to world over loopback port [{}]\n", port);
+		return;
+	}
+
+	std::cout << fmt::format(
+		"Messages [{}] size [{}] per frame [{}]\n",
+		Strings::Commify(messages),
+		size,
+		per_frame
+	);
+
+	ServerPacket pack(ServerOP_ChannelMessage, size);
+	memset(pack.pBuffer, 'm', size);
+
+	auto   start = clock::now();
+	uint32 sent  = 0;
+	deadline = start + std::chrono::seconds(60);
+	while (received < messages && clock::now() < deadline) {
+		for (uint32 i = 0; i < per_frame && sent < messages; ++i, ++sent) {
+			zone->SendPacket(&pack);
+		}
+
+		loop.Process();
+	}
+
+	const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+
+	std::cout << fmt::format(
+		"Received [{}] in [{:.3f}s] | [{:.2f}M messages/s] [{:.1f} MB/s]{}\n",
+		Strings::Commify(received),
+		elapsed,
+		received / elapsed / 1000000,
+		received_bytes / elapsed / (1024 * 1024),
+		received == messages ? "" : " (timed out)"
+	);
+}
@@ -16,6 +16,7 @@ void WorldserverCLI::CommandHandler(int argc, char **argv)
 	auto function_map = EQEmuCommand::function_map;
 
 	// Register commands
+	function_map["benchmark:servertalk"]        = &WorldserverCLI::BenchmarkServertalk;
 	function_map["bots:enable"]                 = &WorldserverCLI::BotsEnable;
 	function_map["bots:disable"]                = &WorldserverCLI::BotsDisable;
 	function_map["mercs:enable"]                = &WorldserverCLI::MercsEnable;
@@ -39,6 +40,7 @@ void WorldserverCLI::CommandHandler(int argc, char **argv)
 	EQEmuCommand::HandleMenu(function_map, cmd, argc, argv);
 }
 
+#include "cli/benchmark_servertalk.cpp"
 #include "cli/database_concurrency.cpp"
 #include "cli/bots_enable.cpp"
 #include "cli/bots_disable.cpp"
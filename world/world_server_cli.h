@@ -7,6 +7,7 @@
 class WorldserverCLI {
 public:
 	static void CommandHandler(int argc, char **argv);
+	static void BenchmarkServertalk(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void BotsEnable(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void BotsDisable(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void MercsEnable(int argc, char **argv, argh::parser &cmd, std::string &description);
@@ -0,0 +1,141 @@
+#include "ai_lod_scheduler.h"
+#include "client.h"
+#include "mob_spatial_grid.h"
+#include "npc.h"
+#include "zone_profiler.h"
+#include "../common/rulesys.h"
+
+AILodScheduler::AILodScheduler()
+{
+	m_intervals.fill(1);
+
+	auto &profiler = ZoneProfiler::Instance();
+	for (uint8 t = Full; t < TierCount; ++t) {
+		m_profile_keys[t] = profiler.GetKey(std::string("ai_lod_") + GetTierName(static_cast<Tier>(t)));
+	}
+}
+
+void AILodScheduler::BeginFrame(const std::unordered_map<uint16, Client *> &clients, const MobSpatialGrid &grid)
+{
+	for (uint8 t = Full; t < TierCount; ++t) {
+		m_stats[t].mobs = m_counting[t];
+		m_counting[t]   = 0;
+	}
+
+	m_enabled = RuleB(Zone, AILodEnabled);
+	if (!m_enabled) {
+		return;
+	}
+
+	m_intervals[Full]    = 1;
+	m_intervals[Reduced] = std::max(1, RuleI(Zone, AILodReducedInterval));
+	m_intervals[Distant] = std::max(1, RuleI(Zone, AILodDistantInterval));
+
+	// 0 is the stamp every mob starts with, never treat it as this frame's
+	if (++m_frame == 0) {
+		m_frame = 1;
+	}
+
+	const float full_range    = static_cast<float>(RuleI(Zone, AILodFullRange));
+	const float reduced_range = std::max(full_range, static_cast<float>(RuleI(Zone, AILodReducedRange)));
+	const float full_sq       = full_range * full_range;
+	const float reduced_sq    = reduced_range * reduced_range;
+
+	for (const auto &e : clients) {
+		const glm::vec3 position(e.second->GetPosition());
+
+		grid.ForEachInRange(
+			position,
+			reduced_range,
+			[&](Mob *mob) {
+				const float d = DistanceSquared(position, glm::vec3(mob->GetPosition()));
+				if (d > reduced_sq) {
+					return;
+				}
+
+				const uint8 tier = d <= full_sq ? Full : Reduced;
+				if (mob->m_ai_lod_frame != m_frame || tier < mob->m_ai_lod_tier) {
+					mob->m_ai_lod_frame = m_frame;
+					mob->m_ai_lod_tier  = tier;
+				}
+			}
+		);
+	}
+}
+
+AILodScheduler::Tier AILodScheduler::GetTier(Mob *mob) const
+{
+	if (!mob->IsNPC() || mob->IsMerc()) {
+		return Full;
+	}
+
+	if (
+		mob->IsEngaged() ||
+		mob->IsFleeing() ||
+		mob->GetOwnerID() ||
+		mob->CastToNPC()->GetDepop()
+	) {
+		return Full;
+	}
+
+	return mob->m_ai_lod_frame == m_frame ? static_cast<Tier>(mob->m_ai_lod_tier) : Distant;
+}
+
+bool AILodScheduler::Process(Mob *mob)
+{
+	if (!m_enabled) {
+		return mob->Process();
+	}
+
+	const Tier tier     = GetTier(mob);
+	auto       &stats   = m_stats[tier];
+	const auto interval = m_intervals[tier];
+
+	m_counting[tier]++;
+
+	if (interval > 1 && (m_frame + mob->GetID()) % interval != 0) {
+		stats.skipped++;
+		return true;
+	}
+
+	stats.processed++;
+
+	auto &profiler = ZoneProfiler::Instance();
+	if (!profiler.IsEnabled()) {
+		return mob->Process();
+	}
+
+	ZoneProfiler::Scope scope(m_profile_keys[tier]);
+
+	const auto start  = std::chrono::steady_clock::now();
+	const bool result = mob->Process();
+
+	stats.total_ns += static_cast<uint64>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+	);
+
+	return result;
+}
+
+void AILodScheduler::ResetStats()
+{
+	for (auto &s : m_stats) {
+		s.processed = 0;
+		s.skipped   = 0;
+		s.total_ns  = 0;
+	}
+}
+
+const char *AILodScheduler::GetTierName(Tier tier)
+{
+	switch (tier) {
+		case Full:
+			return "full";
+		case Reduced:
+			return "reduced";
+		case Distant:
+			return "distant";
+		default:
+			return "unknown";
+	}
+}
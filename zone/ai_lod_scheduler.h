@@ -0,0 +1,60 @@
+#ifndef EQEMU_AI_LOD_SCHEDULER_H
+#define EQEMU_AI_LOD_SCHEDULER_H
+
+#include <array>
+#include <unordered_map>
+#include "../common/types.h"
+
+class Client;
+class Mob;
+class MobSpatialGrid;
+
+// Distance based level of detail for EntityList::MobProcess
+//
+// At the start of each frame every client stamps the mobs around it (through the mob spatial grid) with
+// the closest tier they fall in, so an NPC's tier never costs a walk of the client list. Clients, bots,
+// mercs and any engaged, fleeing, owned or depopping NPC always run every frame; the rest run every
+// ReducedInterval or DistantInterval frames, staggered by entity id so each tier's work is spread evenly.
+// Mob timers and movement run on elapsed time, so a skipped frame is caught up by the next run
+class AILodScheduler {
+public:
+	enum Tier : uint8 {
+		Full = 0,
+		Reduced,
+		Distant,
+		TierCount
+	};
+
+	struct TierStats {
+		uint32 mobs      = 0; // mobs in the tier during the last full frame
+		uint64 processed = 0;
+		uint64 skipped   = 0;
+		uint64 total_ns  = 0; // only accumulated while the frame profiler is enabled
+	};
+
+	AILodScheduler();
+
+	void BeginFrame(const std::unordered_map<uint16, Client *> &clients, const MobSpatialGrid &grid);
+
+	// runs mob->Process() when it is the mob's turn, a skipped turn counts as still alive
+	bool Process(Mob *mob);
+
+	inline bool IsEnabled() const { return m_enabled; }
+	inline const std::array<TierStats, TierCount> &GetStats() const { return m_stats; }
+	inline uint32 GetInterval(Tier tier) const { return m_intervals[tier]; }
+	void ResetStats();
+
+	static const char *GetTierName(Tier tier);
+
+private:
+	Tier GetTier(Mob *mob) const;
+
+	bool                             m_enabled = false;
+	uint32                           m_frame   = 0;
+	std::array<uint32, TierCount>    m_intervals{};
+	std::array<uint32, TierCount>    m_counting{};
+	std::array<uint32, TierCount>    m_profile_keys{};
+	std::array<TierStats, TierCount> m_stats{};
+};
+
+#endif //EQEMU_AI_LOD_SCHEDULER_H
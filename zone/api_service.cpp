@@ -29,6 +29,7 @@
 #include "object.h"
 #include "zone.h"
 #include "doors.h"
+#include "zone_profiler.h"
 #include <iostream>
 
 extern Zone *zone;
@@ -99,6 +100,7 @@ Json::Value ApiGetPacketStatistics(EQ::Net::WebsocketServerConnection *connectio
 		row["max_ping"]                 = stats.max_ping;
 		row["last_ping"]                = stats.last_ping;
 		row["average_ping"]             = stats.avg_ping;
+		row["ping_deviation"]           = stats.ping_deviation;
 		row["realtime_receive_packets"] = stats.recv_packets;
 		row["realtime_sent_packets"]    = stats.sent_packets;
 		row["sync_recv_packets"]        = stats.sync_recv_packets;
@@ -112,6 +114,9 @@ Json::Value ApiGetPacketStatistics(EQ::Net::WebsocketServerConnection *connectio
 		row["resent_packets"]           = stats.resent_packets;
 		row["resent_fragments"]         = stats.resent_fragments;
 		row["resent_non_fragments"]     = stats.resent_full;
+		row["fast_resends"]             = stats.fast_resends;
+		row["sent_window"]              = stats.sent_window;
+		row["max_sent_window"]          = stats.max_sent_window;
 		row["dropped_datarate_packets"] = stats.dropped_datarate_packets;
 
 		Json::Value sent_packet_types;
@@ -880,6 +885,74 @@ Json::Value ApiSetLoggingLevel(EQ::Net::WebsocketServerConnection *connection, J
 	return response;
 }
 
+Json::Value ApiGetFrameProfile(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
+{
+	auto &profiler = ZoneProfiler::Instance();
+
+	Json::Value response;
+
+	response["enabled"] = profiler.IsEnabled();
+	response["frames"]  = profiler.GetFrameCount();
+	response["window"]  = static_cast<uint32>(ZoneProfiler::WINDOW_FRAMES);
+
+	Json::Value sections(Json::arrayValue);
+	for (const auto &s : profiler.GetSections()) {
+		Json::Value row;
+
+		row["name"]        = s.name;
+		row["depth"]       = s.depth;
+		row["calls"]       = s.calls;
+		row["p50_ms"]      = s.p50_ms;
+		row["p99_ms"]      = s.p99_ms;
+		row["max_ms"]      = s.max_ms;
+		row["avg_call_us"] = s.avg_call_us;
+
+		sections.append(row);
+	}
+
+	const auto npc_count = params.isArray() && params.size() > 0 && params[0].isInt() ? params[0].asInt() : 20;
+
+	Json::Value npcs(Json::arrayValue);
+	for (const auto &n : profiler.GetTopNpcs(std::max(npc_count, 1))) {
+		Json::Value row;
+
+		row["npc_type_id"] = n.npc_type_id;
+		row["name"]        = n.name;
+		row["calls"]       = n.calls;
+		row["total_ms"]    = n.total_ms;
+		row["avg_us"]      = n.avg_us;
+		row["max_us"]      = n.max_us;
+
+		npcs.append(row);
+	}
+
+	auto &lod = entity_list.GetAILod();
+
+	Json::Value ai_lod(Json::arrayValue);
+	for (uint8 t = AILodScheduler::Full; t < AILodScheduler::TierCount; ++t) {
+		const auto tier = static_cast<AILodScheduler::Tier>(t);
+		const auto &st  = lod.GetStats()[t];
+
+		Json::Value row;
+
+		row["tier"]      = AILodScheduler::GetTierName(tier);
+		row["interval"]  = lod.GetInterval(tier);
+		row["mobs"]      = st.mobs;
+		row["processed"] = st.processed;
+		row["skipped"]   = st.skipped;
+		row["total_ms"]  = st.total_ns / 1000000.0;
+		row["avg_us"]    = st.processed ? static_cast<double>(st.total_ns) / st.processed / 1000.0 : 0.0;
+
+		ai_lod.append(row);
+	}
+
+	response["sections"] = sections;
+	response["npcs"]     = npcs;
+	response["ai_lod"]   = ai_lod;
+
+	return response;
+}
+
 void RegisterApiLogEvent(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 {
 	LogSys.SetConsoleHandler(
@@ -892,6 +965,32 @@ void RegisterApiLogEvent(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 	);
 }
 
+Json::Value ApiGetCharacterSaveStats(EQ::Net::WebsocketServerConnection *connection, Json::Value params)
+{
+	const auto &stats = database.GetCharacterSaveStats();
+	const auto pool   = database.GetAsyncPoolStats();
+
+	Json::Value response;
+
+	response["saves"]            = static_cast<Json::UInt64>(stats.saves);
+	response["empty_saves"]      = static_cast<Json::UInt64>(stats.empty_saves);
+	response["sections_written"] = static_cast<Json::UInt64>(stats.sections_written);
+	response["sections_skipped"] = static_cast<Json::UInt64>(stats.sections_skipped);
+	response["statements"]       = static_cast<Json::UInt64>(stats.statements);
+	response["bytes_written"]    = static_cast<Json::UInt64>(stats.bytes_written);
+	response["failed"]           = static_cast<Json::UInt64>(stats.failed);
+	response["pending"]          = static_cast<Json::UInt64>(stats.pending);
+	response["max_latency_us"]   = static_cast<Json::UInt64>(stats.max_latency_us);
+
+	const auto committed = stats.saves - stats.empty_saves - stats.pending;
+
+	response["avg_latency_us"]         = committed ? static_cast<Json::UInt64>(stats.total_latency_us / committed) : 0;
+	response["async_connections"]      = pool.connections;
+	response["async_peak_queue_depth"] = static_cast<Json::UInt64>(pool.peak_depth);
+
+	return response;
+}
+
 void RegisterApiService(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 {
 	server->SetLoginHandler(CheckLogin);
@@ -906,6 +1005,8 @@ void RegisterApiService(std::unique_ptr<EQ::Net::WebsocketServer> &server)
 	server->SetMethodHandler("get_zone_attributes", &ApiGetZoneAttributes, 50);
 	server->SetMethodHandler("get_logsys_categories", &ApiGetLogsysCategories, 50);
 	server->SetMethodHandler("set_logging_level", &ApiSetLoggingLevel, 50);
+	server->SetMethodHandler("get_frame_profile", &ApiGetFrameProfile, 50);
+	server->SetMethodHandler("get_character_save_stats", &ApiGetCharacterSaveStats, 50);
 
 	RegisterApiLogEvent(server);
 }
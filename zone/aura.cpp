@@ -738,7 +738,9 @@ bool Aura::Process()
 	}
 
 	if (movement_type == AuraMovement::Follow && GetPosition() != owner->GetPosition() && movement_timer.Check()) {
-		m_Position = owner->GetPosition();
+		auto &position = owner->GetPosition();
+		SetPosition(position.x, position.y, position.z);
+		SetHeading(position.w);
 
 		static EQApplicationPacket packet(OP_ClientUpdate, sizeof(PlayerPositionUpdateServer_Struct));
 		auto                       spu = (PlayerPositionUpdateServer_Struct *) packet.pBuffer;
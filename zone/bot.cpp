@@ -3631,9 +3631,7 @@ bool Bot::Spawn(Client* botCharacterOwner) {
 		}
 
 		// Spawn the bot at the bot owner's loc
-		m_Position.x = botCharacterOwner->GetX();
-		m_Position.y = botCharacterOwner->GetY();
-		m_Position.z = botCharacterOwner->GetZ();
+		SetPosition(botCharacterOwner->GetX(), botCharacterOwner->GetY(), botCharacterOwner->GetZ());
 
 		// Make the bot look at the bot owner
 		FaceTarget(botCharacterOwner);
@@ -7524,6 +7522,7 @@ void EntityList::AddBot(Bot *new_bot, bool send_spawn_packet, bool dont_queue) {
 		new_bot->SetID(GetFreeID());
 		bot_list.emplace(std::pair<uint16, Bot*>(new_bot->GetID(), new_bot));
 		mob_list.emplace(std::pair<uint16, Mob*>(new_bot->GetID(), new_bot));
+		m_mob_grid.Add(new_bot);
 
 		if (parse->BotHasQuestSub(EVENT_SPAWN)) {
 			parse->EventBot(EVENT_SPAWN, new_bot, nullptr, "", 0);
@@ -0,0 +1,218 @@
+#include <chrono>
+#include <iostream>
+#include "../../common/strings.h"
+#include "../../common/eq_broadcast_packet.h"
+#include "../../common/eq_packet_structs.h"
+#include "../../common/eq_stream_ident.h"
+#include "../../common/eq_stream_proxy.h"
+#include "../../common/opcodemgr.h"
+#include "../../common/path_manager.h"
+#include "../../common/patches/patches.h"
+#include "../../common/patches/titanium.h"
+#include "../../common/patches/sof.h"
+#include "../../common/patches/sod.h"
+#include "../../common/patches/uf.h"
+#include "../../common/patches/rof.h"
+#include "../../common/patches/rof2.h"
+
+// stands in for EQ::Net::EQStream, doing the same framing before the point a packet would reach its connection
+class BenchmarkBroadcastStream : public EQStreamInterface {
+public:
+	virtual void QueuePacket(const EQApplicationPacket *p, bool ack_req)
+	{
+		EQ::Net::DynamicPacket out;
+		out.PutUInt16(0, (*m_opcodes)->EmuToEQ(p->GetOpcode()));
+		out.PutData(2, p->pBuffer, p->size);
+		bytes += out.Length();
+	}
+
+	virtual void FastQueuePacket(EQApplicationPacket **p, bool ack_req)
+	{
+		QueuePacket(*p, ack_req);
+		delete *p;
+		*p = nullptr;
+	}
+
+	virtual void QueueEncodedFrames(const std::shared_ptr<const EQBroadcastPacket::Frames> &frames)
+	{
+		for (auto &f : *frames) {
+			bytes += f.data.Length();
+		}
+	}
+
+	virtual EQApplicationPacket *PopPacket() { return nullptr; }
+	virtual void Close() { }
+	virtual void ReleaseFromUse() { }
+	virtual void RemoveData() { }
+	virtual std::string GetRemoteAddr() const { return std::string(); }
+	virtual uint32 GetRemoteIP() const { return 0; }
+	virtual uint16 GetRemotePort() const { return 0; }
+	virtual bool CheckState(EQStreamState state) { return state == ESTABLISHED; }
+	virtual std::string Describe() const { return "Benchmark Stream"; }
+	virtual EQStreamState GetState() { return ESTABLISHED; }
+	virtual void SetOpcodeManager(OpcodeManager **opm) { m_opcodes = opm; }
+	virtual OpcodeManager *GetOpcodeManager() const { return *m_opcodes; }
+	virtual Stats GetStats() const { return Stats(); }
+	virtual void ResetStats() { }
+	virtual EQStreamManagerInterface *GetManager() const { return nullptr; }
+
+	uint64 bytes = 0;
+
+private:
+	OpcodeManager **m_opcodes = nullptr;
+};
+
+void ZoneCLI::BenchmarkBroadcast(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark a broadcast to many clients, encoded per client versus once per client version";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:broadcast [--clients=200] [--broadcasts=20000] [--mixed]\n";
+		std::cout << "  --mixed spreads clients across every supported client version instead of all RoF2\n";
+		return;
+	}
+
+	uint32 clients = 200;
+	if (!cmd("--clients").str().empty()) {
+		clients = std::max(1u, Strings::ToUnsignedInt(cmd("--clients").str(), clients));
+	}
+
+	uint32 broadcasts = 20000;
+	if (!cmd("--broadcasts").str().empty()) {
+		broadcasts = std::max(1u, Strings::ToUnsignedInt(cmd("--broadcasts").str(), broadcasts));
+	}
+
+	// the patches' own opcode managers, encoders log through them
+	EQStreamIdentifier ident;
+	RegisterAllPatches(ident);
+
+	struct Version {
+		std::string                     name;
+		std::unique_ptr<StructStrategy> structs;
+		OpcodeManager                   *opcodes = nullptr;
+	};
+
+	std::vector<Version> versions(6);
+	versions[0].name    = "Titanium";
+	versions[0].structs = std::make_unique<Titanium::Strategy>();
+	versions[1].name    = "SoF";
+	versions[1].structs = std::make_unique<SoF::Strategy>();
+	versions[2].name    = "SoD";
+	versions[2].structs = std::make_unique<SoD::Strategy>();
+	versions[3].name    = "UF";
+	versions[3].structs = std::make_unique<UF::Strategy>();
+	versions[4].name    = "RoF";
+	versions[4].structs = std::make_unique<RoF::Strategy>();
+	versions[5].name    = "RoF2";
+	versions[5].structs = std::make_unique<RoF2::Strategy>();
+
+	for (auto &v : versions) {
+		auto opfile = fmt::format("{}/patch_{}.conf", path.GetPatchPath(), v.name);
+		auto opm    = new RegularOpcodeManager();
+		if (!opm->LoadOpcodes(opfile.c_str())) {
+			std::cout << fmt::format("Unable to load opcodes from [{}]\n", opfile);
+			delete opm;
+			for (auto &o : versions) {
+				delete o.opcodes;
+			}
+			return;
+		}
+
+		v.opcodes = opm;
+	}
+
+	const bool mixed = cmd[{"--mixed"}];
+
+	std::vector<BenchmarkBroadcastStream *>     streams;
+	std::vector<std::unique_ptr<EQStreamProxy>> proxies;
+	for (uint32 i = 0; i < clients; ++i) {
+		auto &v     = versions[mixed ? i % versions.size() : versions.size() - 1];
+		auto stream = std::make_shared<BenchmarkBroadcastStream>();
+		streams.push_back(stream.get());
+
+		std::shared_ptr<EQStreamInterface> s = stream;
+		proxies.emplace_back(std::make_unique<EQStreamProxy>(s, v.structs.get(), &v.opcodes));
+	}
+
+	// what QueueCloseClients sends most of, plus a spawn, which has the heaviest encoder
+	EQApplicationPacket hp(OP_HPUpdate, sizeof(SpawnHPUpdate_Struct));
+	auto                hpu = (SpawnHPUpdate_Struct *) hp.pBuffer;
+	hpu->spawn_id = 1234;
+	hpu->cur_hp   = 4500;
+	hpu->max_hp   = 5000;
+
+	EQApplicationPacket position(OP_ClientUpdate, sizeof(PlayerPositionUpdateServer_Struct));
+	auto                ppu = (PlayerPositionUpdateServer_Struct *) position.pBuffer;
+	ppu->spawn_id = 1234;
+	ppu->x_pos    = 100;
+	ppu->y_pos    = 200;
+
+	EQApplicationPacket spawn(OP_NewSpawn, sizeof(Spawn_Struct));
+	auto                sp = (Spawn_Struct *) spawn.pBuffer;
+	strn0cpy(sp->name, "a_benchmark_orc00", sizeof(sp->name));
+	sp->spawnId = 1234;
+	sp->level   = 50;
+	sp->race    = 54;
+	sp->size    = 6.0f;
+
+	std::cout << fmt::format(
+		"Clients [{}] versions [{}] broadcasts per packet [{}]\n",
+		clients,
+		mixed ? versions.size() : 1,
+		Strings::Commify(broadcasts)
+	);
+
+	using clock = std::chrono::steady_clock;
+
+	for (auto app : { &hp, &position, &spawn }) {
+		for (auto s : streams) {
+			s->bytes = 0;
+		}
+
+		auto start = clock::now();
+		for (uint32 b = 0; b < broadcasts; ++b) {
+			for (auto &p : proxies) {
+				p->QueuePacket(app);
+			}
+		}
+
+		const double per_client = std::chrono::duration<double>(clock::now() - start).count();
+
+		uint64 per_client_bytes = 0;
+		for (auto s : streams) {
+			per_client_bytes += s->bytes;
+			s->bytes = 0;
+		}
+
+		start = clock::now();
+		for (uint32 b = 0; b < broadcasts; ++b) {
+			EQBroadcastPacket broadcast(app);
+			for (auto &p : proxies) {
+				p->QueueBroadcastPacket(broadcast);
+			}
+		}
+
+		const double shared = std::chrono::duration<double>(clock::now() - start).count();
+
+		uint64 shared_bytes = 0;
+		for (auto s : streams) {
+			shared_bytes += s->bytes;
+		}
+
+		const double packets = static_cast<double>(broadcasts) * clients;
+
+		std::cout << fmt::format(
+			"{:<16} | per client [{:.2f}M packets/s] once per version [{:.2f}M packets/s] speedup [{:.1f}x]{}\n",
+			OpcodeManager::EmuToName(app->GetOpcode()),
+			packets / per_client / 1000000,
+			packets / shared / 1000000,
+			per_client / shared,
+			per_client_bytes == shared_bytes ? "" : " (output differs)"
+		);
+	}
+
+	proxies.clear();
+	for (auto &v : versions) {
+		delete v.opcodes;
+	}
+}
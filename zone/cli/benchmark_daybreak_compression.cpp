@@ -0,0 +1,131 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <zlib.h>
+#include "../../common/net/daybreak_connection.h"
+#include "../../common/strings.h"
+
+// what every packet paid before contexts were reused, kept here as the baseline
+uint32_t BenchmarkDeflatePerPacketInit(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+	z_stream zstream;
+	memset(&zstream, 0, sizeof(zstream));
+
+	zstream.next_in  = const_cast<unsigned char *>(in);
+	zstream.avail_in = in_len;
+
+	deflateInit(&zstream, Z_BEST_SPEED);
+	zstream.next_out  = out;
+	zstream.avail_out = out_len;
+
+	uint32_t total = deflate(&zstream, Z_FINISH) == Z_STREAM_END ? (uint32_t) zstream.total_out : 0;
+	deflateEnd(&zstream);
+
+	return total;
+}
+
+uint32_t BenchmarkInflatePerPacketInit(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+	z_stream zstream;
+	memset(&zstream, 0, sizeof(zstream));
+
+	zstream.next_in   = const_cast<unsigned char *>(in);
+	zstream.avail_in  = in_len;
+	zstream.next_out  = out;
+	zstream.avail_out = out_len;
+
+	if (inflateInit2(&zstream, 15) != Z_OK) {
+		return 0;
+	}
+
+	uint32_t total = inflate(&zstream, Z_FINISH) == Z_STREAM_END ? (uint32_t) zstream.total_out : 0;
+	inflateEnd(&zstream);
+
+	return total;
+}
+
+void ZoneCLI::BenchmarkDaybreakCompression(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark daybreak packet compression, per packet zlib init versus reused contexts";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:daybreak-compression [--packets=200000]\n";
+		return;
+	}
+
+	size_t packet_count = 200000;
+	if (!cmd("--packets").str().empty()) {
+		packet_count = strtoull(cmd("--packets").str().c_str(), nullptr, 10);
+	}
+
+	// packets shaped roughly like zone traffic, mostly small structs with repeated fields
+	std::mt19937                          rng(1337);
+	std::uniform_int_distribution<size_t> size_dist(31, 510);
+	std::uniform_int_distribution<int>    byte_dist(0, 15);
+
+	std::vector<std::vector<uint8_t>> packets(1024);
+	for (auto &p: packets) {
+		p.resize(size_dist(rng));
+		for (size_t i = 0; i < p.size(); ++i) {
+			p[i] = (i % 4 == 0) ? static_cast<uint8_t>(byte_dist(rng)) : static_cast<uint8_t>(i & 0x7);
+		}
+	}
+
+	std::vector<std::vector<uint8_t>> compressed(packets.size());
+	auto &context = EQ::Net::DaybreakCompressionContext::ForThread();
+	for (size_t i = 0; i < packets.size(); ++i) {
+		compressed[i].resize(4096);
+		compressed[i].resize(context.Deflate(packets[i].data(), (uint32_t) packets[i].size(), compressed[i].data(), 4096));
+	}
+
+	uint8_t out[4096];
+
+	auto run = [&](const std::string &name, auto &&fn) {
+		uint64_t bytes = 0;
+		auto     start = std::chrono::high_resolution_clock::now();
+
+		for (size_t i = 0; i < packet_count; ++i) {
+			bytes += fn(i % packets.size());
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+		std::cout << fmt::format(
+			"{:<35} | packets [{}] bytes [{}] time [{:.3f}s] packets/sec [{}]\n",
+			name,
+			Strings::Commify(static_cast<uint64>(packet_count)),
+			Strings::Commify(bytes),
+			elapsed.count(),
+			Strings::Commify(static_cast<uint64_t>(packet_count / elapsed.count()))
+		);
+	};
+
+	run("deflate (per packet init)", [&](size_t i) {
+		return BenchmarkDeflatePerPacketInit(packets[i].data(), (uint32_t) packets[i].size(), out, sizeof(out));
+	});
+
+	run("deflate (reused context)", [&](size_t i) {
+		return context.Deflate(packets[i].data(), (uint32_t) packets[i].size(), out, sizeof(out));
+	});
+
+	run("inflate (per packet init)", [&](size_t i) {
+		return BenchmarkInflatePerPacketInit(compressed[i].data(), (uint32_t) compressed[i].size(), out, sizeof(out));
+	});
+
+	run("inflate (reused context)", [&](size_t i) {
+		return context.Inflate(compressed[i].data(), (uint32_t) compressed[i].size(), out, sizeof(out));
+	});
+
+	// both paths must produce the exact same bytes on the wire
+	uint8_t legacy[4096];
+	size_t  mismatches = 0;
+	for (auto &p: packets) {
+		auto a = BenchmarkDeflatePerPacketInit(p.data(), (uint32_t) p.size(), legacy, sizeof(legacy));
+		auto b = context.Deflate(p.data(), (uint32_t) p.size(), out, sizeof(out));
+		if (a != b || memcmp(legacy, out, a) != 0) {
+			mismatches++;
+		}
+	}
+
+	std::cout << fmt::format("Output mismatches between paths [{}]\n", mismatches);
+}
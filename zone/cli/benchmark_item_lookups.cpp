@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include "../../common/strings.h"
+#include "../../common/item_data.h"
+#include "../../common/memory_mapped_file.h"
+#include "../../common/fixed_memory_hash_set.h"
+#include "../../common/path_manager.h"
+
+void ZoneCLI::BenchmarkItemLookups(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark random item lookups in the shared memory items segment under each mapping option";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:item-lookups [--prefix=] [--lookups=5000000] [--synthetic=0]\n";
+		std::cout << "  --synthetic=<count> builds a throwaway items segment of <count> items instead of mapping the real one\n";
+		return;
+	}
+
+	uint32 lookups = 5000000;
+	if (!cmd("--lookups").str().empty()) {
+		lookups = std::max(1u, Strings::ToUnsignedInt(cmd("--lookups").str(), lookups));
+	}
+
+	uint32 synthetic = 0;
+	if (!cmd("--synthetic").str().empty()) {
+		synthetic = Strings::ToUnsignedInt(cmd("--synthetic").str(), synthetic);
+	}
+
+	std::string file_name = fmt::format("{}/{}items", path.GetSharedMemoryPath(), cmd("--prefix").str());
+
+	std::mt19937 rng(1337);
+
+	// spread ids out the way a real items table is, with gaps between ranges
+	if (synthetic > 0) {
+		file_name = fmt::format("{}/benchmark_items", path.GetSharedMemoryPath());
+
+		const uint32 max_id = synthetic + synthetic / 2;
+		const uint32 size   = static_cast<uint32>(EQ::FixedMemoryHashSet<EQ::ItemData>::estimated_size(synthetic, max_id));
+
+		EQ::MemoryMappedFile                 mmf(file_name, size);
+		mmf.ZeroFile();
+		EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(mmf.Get()), size, synthetic, max_id);
+
+		std::uniform_int_distribution<uint32> id_dist(1, max_id);
+
+		EQ::ItemData item;
+		memset(&item, 0, sizeof(item));
+		while (hash.size() < synthetic) {
+			item.ID    = id_dist(rng);
+			item.Price = item.ID;
+			hash.insert(item.ID, item);
+		}
+	}
+
+	std::vector<uint32> ids;
+	try {
+		EQ::MemoryMappedFile                 mmf(file_name);
+		EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(mmf.Get()), mmf.Size());
+		for (uint32 id = 0; id <= hash.max_key(); ++id) {
+			if (hash.exists(id)) {
+				ids.push_back(id);
+			}
+		}
+
+		std::cout << fmt::format(
+			"Items [{}] segment [{}] size [{:.1f}MB] hugetlbfs [{}] lookups [{}]\n",
+			Strings::Commify(static_cast<uint64>(ids.size())),
+			file_name,
+			mmf.Size() / 1024.0 / 1024.0,
+			mmf.IsHugeTLB() ? "yes" : "no",
+			Strings::Commify(lookups)
+		);
+	} catch (std::exception &ex) {
+		std::cout << fmt::format("Unable to map [{}] ({}), run shared_memory first or pass --synthetic\n", file_name, ex.what());
+		return;
+	}
+
+	if (ids.empty()) {
+		std::cout << "No items in the segment\n";
+		return;
+	}
+
+	// a power of two ring of random ids, walked below with each step depending on the item just read so
+	// lookups measure a miss each the way gameplay code does, not how many loads the cpu can overlap
+	size_t ring = 1;
+	while (ring < lookups) {
+		ring <<= 1;
+	}
+
+	std::vector<uint32>                   order(ring);
+	std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+	for (auto &o : order) {
+		o = ids[pick(rng)];
+	}
+
+	std::vector<uint32> first_touch(ids);
+	std::shuffle(first_touch.begin(), first_touch.end(), rng);
+
+	struct Mode {
+		std::string                   name;
+		EQ::MemoryMappedFile::Options options;
+	};
+
+	std::vector<Mode> modes(5);
+	modes[0].name = "default";
+	modes[1].name = "populate";
+	modes[2].name = "will_need";
+	modes[3].name = "huge_pages";
+	modes[4].name = "populate+huge";
+
+	modes[1].options.populate   = true;
+	modes[2].options.will_need  = true;
+	modes[3].options.huge_pages = true;
+	modes[4].options.populate   = true;
+	modes[4].options.huge_pages = true;
+
+	using clock = std::chrono::steady_clock;
+
+	for (auto &m : modes) {
+		uint64 sum = 0;
+
+		// mapping and the first walk over every item carry the page faults a freshly booted zone pays
+		auto start = clock::now();
+
+		EQ::MemoryMappedFile                 mmf(file_name, m.options);
+		EQ::FixedMemoryHashSet<EQ::ItemData> hash(static_cast<uint8 *>(mmf.Get()), mmf.Size());
+
+		auto mapped = clock::now();
+
+		for (auto id : first_touch) {
+			sum += hash.at(id).Price;
+		}
+
+		auto touched = clock::now();
+
+		size_t at = 0;
+		for (uint32 i = 0; i < lookups; ++i) {
+			const auto &item = hash.at(order[at]);
+			sum += item.Price;
+			at = (at + 1 + (item.ID & 7)) & (ring - 1);
+		}
+
+		auto done = clock::now();
+
+		std::cout << fmt::format(
+			"{:<14} | map [{:.2f}ms] first touch [{:.2f}ms] random [{:.1f}ns/lookup] ({})\n",
+			m.name,
+			std::chrono::duration<double, std::milli>(mapped - start).count(),
+			std::chrono::duration<double, std::milli>(touched - mapped).count(),
+			std::chrono::duration<double, std::nano>(done - touched).count() / lookups,
+			sum
+		);
+	}
+
+	if (synthetic > 0) {
+		std::remove(file_name.c_str());
+	}
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <iostream>
+#include "../zonedb.h"
+#include "../../common/strings.h"
+#include "../../common/repositories/items_repository.h"
+#include "../../common/repositories/npc_types_repository.h"
+#include "../../common/repositories/spawn2_repository.h"
+
+template<typename Repository>
+void RunRepositoryLoadBenchmark(const std::string &name, uint32 rows, int iterations)
+{
+	const auto filter = fmt::format("TRUE ORDER BY {} LIMIT ", Repository::PrimaryKey());
+
+	size_t text_rows   = 0;
+	size_t binary_rows = 0;
+	double text_time   = 0;
+	double binary_time = 0;
+	size_t mismatches  = 0;
+
+	for (int i = 0; i < iterations; ++i) {
+		auto start = std::chrono::high_resolution_clock::now();
+		auto text  = Repository::GetWhere(content_db, filter + std::to_string(rows));
+		text_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		auto binary = Repository::GetWherePrepared(content_db, filter + "?", { rows });
+		binary_time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+		text_rows   = text.size();
+		binary_rows = binary.size();
+
+		if (i == 0) {
+			for (size_t r = 0; r < std::min(text.size(), binary.size()); ++r) {
+				if (text[r].id != binary[r].id) {
+					mismatches++;
+				}
+			}
+		}
+	}
+
+	auto report = [&](const std::string &protocol, size_t loaded, double elapsed) {
+		std::cout << fmt::format(
+			"{:<12} | {:<6} | rows [{}] avg [{:.3f}s] rows/sec [{}]\n",
+			name,
+			protocol,
+			Strings::Commify(static_cast<uint64>(loaded)),
+			elapsed / iterations,
+			Strings::Commify(static_cast<uint64>(elapsed > 0 ? loaded * iterations / elapsed : 0))
+		);
+	};
+
+	report("text", text_rows, text_time);
+	report("binary", binary_rows, binary_time);
+
+	if (text_rows != binary_rows || mismatches) {
+		std::cout << fmt::format(
+			"{:<12} | result mismatch text rows [{}] binary rows [{}] id mismatches [{}]\n",
+			name,
+			text_rows,
+			binary_rows,
+			mismatches
+		);
+	}
+}
+
+void ZoneCLI::BenchmarkRepositoryLoad(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark repository loads over the text protocol versus cached prepared statements (binary protocol)";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:repository-load [--rows=100000] [--iterations=5]\n";
+		return;
+	}
+
+	uint32 rows = 100000;
+	if (!cmd("--rows").str().empty()) {
+		rows = Strings::ToUnsignedInt(cmd("--rows").str(), rows);
+	}
+
+	int iterations = 5;
+	if (!cmd("--iterations").str().empty()) {
+		iterations = std::max(1, Strings::ToInt(cmd("--iterations").str(), iterations));
+	}
+
+	std::cout << fmt::format("Loading up to [{}] rows per table, iterations [{}]\n", Strings::Commify(rows), iterations);
+
+	RunRepositoryLoadBenchmark<NpcTypesRepository>("npc_types", rows, iterations);
+	RunRepositoryLoadBenchmark<Spawn2Repository>("spawn2", rows, iterations);
+	RunRepositoryLoadBenchmark<ItemsRepository>("items", rows, iterations);
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../../common/strings.h"
+#include "../../common/timer.h"
+#include "../../common/event/timing_wheel.h"
+
+extern uint32 current_time;
+
+void ZoneCLI::BenchmarkTimers(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark an idle zone's entity timers, polled Timer checks versus the timing wheel";
+
+	if (cmd[{"-h", "--help"}]) {
+		std::cout << "Usage: benchmark:timers [--entities=3000] [--timers=35] [--seconds=60] [--min-interval=0]\n";
+		return;
+	}
+
+	uint32 entities = 3000;
+	if (!cmd("--entities").str().empty()) {
+		entities = Strings::ToUnsignedInt(cmd("--entities").str(), entities);
+	}
+
+	uint32 timers = 35;
+	if (!cmd("--timers").str().empty()) {
+		timers = Strings::ToUnsignedInt(cmd("--timers").str(), timers);
+	}
+
+	uint32 seconds = 60;
+	if (!cmd("--seconds").str().empty()) {
+		seconds = Strings::ToUnsignedInt(cmd("--seconds").str(), seconds);
+	}
+
+	uint32 min_interval = 0;
+	if (!cmd("--min-interval").str().empty()) {
+		min_interval = Strings::ToUnsignedInt(cmd("--min-interval").str(), min_interval);
+	}
+
+	const uint32 frame_ms = 32;
+	const uint32 frames   = seconds * 1000 / frame_ms;
+	const size_t count    = static_cast<size_t>(entities) * timers;
+
+	// the spread of intervals mobs run idle, from movement and think timers up to autosave
+	std::mt19937                          rng(1337);
+	std::vector<uint32>                   intervals = { 100, 150, 500, 1000, 2000, 6000, 10000, 30000, 60000, 300000 };
+	intervals.erase(
+		std::remove_if(intervals.begin(), intervals.end(), [&](uint32 i) { return i < min_interval; }),
+		intervals.end()
+	);
+	if (intervals.empty()) {
+		intervals.push_back(min_interval);
+	}
+
+	std::uniform_int_distribution<size_t> pick(0, intervals.size() - 1);
+
+	std::vector<uint32> durations(count);
+	for (auto &d : durations) {
+		d = intervals[pick(rng)];
+	}
+
+	std::cout << fmt::format(
+		"Entities [{}] timers per entity [{}] simulated [{}s] frames [{}]\n",
+		Strings::Commify(entities),
+		timers,
+		seconds,
+		Strings::Commify(frames)
+	);
+
+	auto report = [&](const std::string &mode, double elapsed, uint64 fired) {
+		std::cout << fmt::format(
+			"{:<16} | total [{:.3f}s] per frame [{:.2f}us] fired [{}] cpu per simulated second [{:.3f}%]\n",
+			mode,
+			elapsed,
+			elapsed / frames * 1000000,
+			Strings::Commify(fired),
+			elapsed / seconds * 100
+		);
+	};
+
+	const uint32 base = current_time;
+
+	// every entity checks every timer each frame, the way Process() polls them today
+	{
+		std::vector<Timer> polled;
+		polled.reserve(count);
+		for (auto d : durations) {
+			polled.emplace_back(d);
+		}
+
+		uint64 fired = 0;
+		auto   start = std::chrono::high_resolution_clock::now();
+		for (uint32 f = 0; f < frames; ++f) {
+			current_time += frame_ms;
+			for (auto &t : polled) {
+				fired += t.Check();
+			}
+		}
+
+		report("polled", std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count(), fired);
+	}
+
+	// same checks, but each one is a flag the wheel set
+	{
+		current_time = base;
+
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		std::vector<std::unique_ptr<EQ::WheelTimer>> wheeled;
+		wheeled.reserve(count);
+		for (auto d : durations) {
+			wheeled.emplace_back(std::make_unique<EQ::WheelTimer>(d, false, wheel));
+		}
+
+		uint64 fired = 0;
+		auto   start = std::chrono::high_resolution_clock::now();
+		for (uint32 f = 0; f < frames; ++f) {
+			current_time += frame_ms;
+			wheel.Advance(current_time);
+			for (auto &t : wheeled) {
+				fired += t->Check();
+			}
+		}
+
+		report("wheel (checked)", std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count(), fired);
+	}
+
+	// callbacks, nothing touches a timer until it expires
+	{
+		current_time = base;
+
+		EQ::TimingWheel wheel;
+		wheel.Advance(current_time);
+
+		uint64 fired = 0;
+
+		std::vector<std::unique_ptr<EQ::WheelTimer>> wheeled;
+		wheeled.reserve(count);
+		for (auto d : durations) {
+			auto t = std::make_unique<EQ::WheelTimer>(d, false, wheel);
+			t->SetCallback([&fired]() { fired++; });
+			wheeled.emplace_back(std::move(t));
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32 f = 0; f < frames; ++f) {
+			current_time += frame_ms;
+			wheel.Advance(current_time);
+		}
+
+		report("wheel (callback)", std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count(), fired);
+	}
+
+	current_time = base;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../water_map.h"
+#include "../water_map_v2.h"
+#include "../zonedb.h"
+#include "../../common/strings.h"
+#include "../../common/zone_store.h"
+#include "../../common/repositories/spawn2_repository.h"
+#include "../../common/repositories/grid_entries_repository.h"
+
+void ZoneCLI::BenchmarkWaterMap(int argc, char **argv, argh::parser &cmd, std::string &description)
+{
+	description = "Benchmark water map region lookups, region tree versus linear scan, over recorded spawn and grid positions";
+
+	if (cmd[{"-h", "--help"}] || cmd("--zone").str().empty()) {
+		std::cout << "Usage: benchmark:water-map --zone=<short_name> [--iterations=20]\n";
+		return;
+	}
+
+	const std::string zone_name = cmd("--zone").str();
+
+	int iterations = 20;
+	if (!cmd("--iterations").str().empty()) {
+		iterations = Strings::ToInt(cmd("--iterations").str(), iterations);
+	}
+
+	std::unique_ptr<WaterMap> water_map(WaterMap::LoadWaterMapfile(zone_name));
+	auto                      v2 = dynamic_cast<WaterMapV2 *>(water_map.get());
+	if (!v2) {
+		std::cout << fmt::format("No V2 water map loaded for zone [{}]\n", zone_name);
+		return;
+	}
+
+	// positions mobs actually stand on, spawn points and the waypoints they walk between
+	std::vector<glm::vec3> positions;
+
+	for (const auto &e: Spawn2Repository::GetWhere(content_db, fmt::format("`zone` = '{}'", Strings::Escape(zone_name)))) {
+		positions.emplace_back(e.x, e.y, e.z);
+	}
+
+	if (zone_store.GetZones().empty()) {
+		zone_store.LoadZones(content_db);
+	}
+
+	const uint32 zone_id = ZoneID(zone_name);
+	for (const auto &e: GridEntriesRepository::GetWhere(content_db, fmt::format("`zoneid` = {}", zone_id))) {
+		positions.emplace_back(e.x, e.y, e.z);
+	}
+
+	if (positions.empty()) {
+		std::cout << fmt::format("No spawn2 or grid_entries positions found for zone [{}]\n", zone_name);
+		return;
+	}
+
+	// jitter around each recorded position to cover the paths between them
+	std::mt19937                          rng(1337);
+	std::uniform_real_distribution<float> jitter(-50.0f, 50.0f);
+
+	const size_t recorded = positions.size();
+	for (size_t i = 0; i < recorded; ++i) {
+		for (int j = 0; j < 8; ++j) {
+			positions.emplace_back(
+				positions[i].x + jitter(rng),
+				positions[i].y + jitter(rng),
+				positions[i].z + jitter(rng) * 0.2f
+			);
+		}
+	}
+
+	std::cout << fmt::format(
+		"Zone [{}] regions [{}] positions [{}] iterations [{}]\n",
+		zone_name,
+		v2->GetRegionCount(),
+		Strings::Commify(static_cast<uint64>(positions.size())),
+		iterations
+	);
+
+	auto run = [&](const std::string &name, auto &&fn) {
+		uint64 liquid = 0;
+		auto   start  = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < iterations; ++i) {
+			for (const auto &p: positions) {
+				auto type = fn(p);
+				if (type == RegionTypeWater || type == RegionTypeVWater || type == RegionTypeLava) {
+					liquid++;
+				}
+			}
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+		const uint64 lookups = static_cast<uint64>(positions.size()) * iterations;
+		std::cout << fmt::format(
+			"{:<15} | lookups [{}] liquid [{}] time [{:.3f}s] lookups/sec [{}]\n",
+			name,
+			Strings::Commify(lookups),
+			Strings::Commify(liquid),
+			elapsed.count(),
+			Strings::Commify(static_cast<uint64>(lookups / elapsed.count()))
+		);
+	};
+
+	run("linear", [&](const glm::vec3 &p) { return v2->ReturnRegionTypeLinear(p); });
+	run("region tree", [&](const glm::vec3 &p) { return v2->ReturnRegionType(p); });
+
+	size_t mismatches = 0;
+	for (const auto &p: positions) {
+		if (v2->ReturnRegionType(p) != v2->ReturnRegionTypeLinear(p)) {
+			mismatches++;
+		}
+	}
+
+	std::cout << fmt::format("Result mismatches between region tree and linear scan [{}]\n", mismatches);
+}
@@ -253,6 +253,21 @@ Client::Client() : Mob(
 	dead_timer.Disable();
 	camp_timer.Disable();
 	autosave_timer.Disable();
+	autosave_timer.SetCallback(
+		[this]() {
+			if ((Connected() || IsLD()) && !dead) {
+				Save(0);
+			}
+		}
+	);
+	mana_timer.SetCallback(
+		[this]() {
+			if (Connected() || IsLD()) {
+				CheckManaEndUpdate();
+			}
+		}
+	);
+	tic_timer.SetCallback([this]() { TicProcess(); });
 	GetMercTimer()->Disable();
 	instalog = false;
 	m_pp.autosplit = false;
@@ -564,6 +579,21 @@ Client::Client(EQStreamInterface *ieqs) : Mob(
 	camp_timer.Disable();
 	bot_camp_timer.Disable();
 	autosave_timer.Disable();
+	autosave_timer.SetCallback(
+		[this]() {
+			if ((Connected() || IsLD()) && !dead) {
+				Save(0);
+			}
+		}
+	);
+	mana_timer.SetCallback(
+		[this]() {
+			if (Connected() || IsLD()) {
+				CheckManaEndUpdate();
+			}
+		}
+	);
+	tic_timer.SetCallback([this]() { TicProcess(); });
 	GetMercTimer()->Disable();
 	instalog = false;
 	m_pp.autosplit = false;
@@ -785,9 +815,7 @@ Client::~Client() {
 	{
 		m_pp.zone_id = m_pp.binds[0].zone_id;
 		m_pp.zoneInstance = m_pp.binds[0].instance_id;
-		m_Position.x = m_pp.binds[0].x;
-		m_Position.y = m_pp.binds[0].y;
-		m_Position.z = m_pp.binds[0].z;
+		SetPosition(m_pp.binds[0].x, m_pp.binds[0].y, m_pp.binds[0].z);
 	}
 
 	// we save right now, because the client might be zoning and the world
@@ -991,6 +1019,33 @@ bool Client::Save(uint8 iCommitNow) {
 	if(!ClientDataLoaded())
 		return false;
 
+	const auto save_started = std::chrono::steady_clock::now();
+
+	// a sync save is what the next zone or world reads, nothing queued earlier may land after it and an
+	// earlier save that failed has to have put back what it skipped before this one is built
+	if (iCommitNow == 2) {
+		database.FlushAsyncQueries();
+	}
+
+	// each section's writes are collected and only the ones that changed go out, as one transaction
+	const bool               transactional    = RuleB(Character, TransactionalSaves);
+	std::vector<std::string> statements;
+	uint32                   sections_written = 0;
+	uint32                   sections_skipped = 0;
+
+	auto section = [&](SaveSection s, const std::function<void()> &save) {
+		if (!transactional) {
+			save();
+			return;
+		}
+
+		if (CaptureSaveSection(s, statements, save)) {
+			sections_written++;
+		} else {
+			sections_skipped++;
+		}
+	};
+
 	/* Wrote current basics to PP for saves */
 	if (!m_lock_save_position) {
 		m_pp.x       = m_Position.x;
@@ -1019,15 +1074,15 @@ bool Client::Save(uint8 iCommitNow) {
 	}
 
 	/* Save Character Currency */
-	database.SaveCharacterCurrency(CharacterID(), &m_pp);
+	section(SaveSectionCurrency, [&]() { database.SaveCharacterCurrency(CharacterID(), &m_pp); });
 
 	// save character binds
 	// this may not need to be called in Save() but it's here for now
 	// to maintain the current behavior
-	database.SaveCharacterBinds(this);
+	section(SaveSectionBinds, [&]() { database.SaveCharacterBinds(this); });
 
 	/* Save Character Buffs */
-	database.SaveBuffs(this);
+	section(SaveSectionBuffs, [&]() { database.SaveBuffs(this); });
 
 	/* Total Time Played */
 	TotalSecondsPlayed += (time(nullptr) - m_pp.lastlogin);
@@ -1061,7 +1116,7 @@ bool Client::Save(uint8 iCommitNow) {
 	} else {
 		memset(&m_petinfo, 0, sizeof(struct PetInfo));
 	}
-	database.SavePetInfo(this);
+	section(SaveSectionPetInfo, [&]() { database.SavePetInfo(this); });
 
 	if(tribute_timer.Enabled()) {
 		m_pp.tribute_time_remaining = tribute_timer.GetRemainingTime();
@@ -1076,10 +1131,24 @@ bool Client::Save(uint8 iCommitNow) {
 	if (m_pp.thirst_level < 0)
 		m_pp.thirst_level = 0;
 
-	p_timers.Store(&database);
+	section(SaveSectionTimers, [&]() { p_timers.Store(&database); });
 
-	database.SaveCharacterTribute(this);
-	SaveTaskState(); /* Save Character Task */
+	section(SaveSectionTribute, [&]() { database.SaveCharacterTribute(this); });
+	// saving tasks clears their dirty flags, which have to come back if the transaction doesn't commit
+	if (transactional && task_state) {
+		m_save_state.OnFailure([this, unsaved = task_state->GetUnsavedState()]() {
+			if (task_state) {
+				task_state->RestoreUnsavedState(unsaved);
+			}
+		});
+	}
+
+	/* Save Character Task */
+	section(SaveSectionTasks, [&]() {
+		if (task_manager) {
+			task_manager->SaveClientState(this, task_state);
+		}
+	});
 
 	LogFood("Client::Save - hunger_level: [{}] thirst_level: [{}]", m_pp.hunger_level, m_pp.thirst_level);
 
@@ -1093,14 +1162,53 @@ bool Client::Save(uint8 iCommitNow) {
 		}
 	}
 
-	database.SaveCharacterData(this, &m_pp, &m_epp); /* Save Character Data */
+	/* Save Character Data */
+	// only the columns that changed since the last save go out, after a rollback they all have to
+	if (transactional) {
+		m_save_state.OnFailure([this]() { m_saved_character_data.reset(); });
+	}
+
+	section(SaveSectionData, [&]() { database.SaveCharacterData(this, &m_pp, &m_epp, !transactional && iCommitNow != 2); });
 
-	database.SaveCharacterEXPModifier(this);
+	section(SaveSectionEXPModifier, [&]() { database.SaveCharacterEXPModifier(this); });
 
 	if (RuleB(Bots, Enabled)) {
-		database.botdb.SaveBotSettings(this);
+		section(SaveSectionBotSettings, [&]() { database.botdb.SaveBotSettings(this); });
 	}
 
+	if (transactional) {
+		database.CommitCharacterSave(
+			this,
+			std::move(statements),
+			sections_written,
+			sections_skipped,
+			save_started,
+			iCommitNow == 2,
+			m_save_state.Finish()
+		);
+	}
+
+	return true;
+}
+
+bool Client::CaptureSaveSection(SaveSection section, std::vector<std::string> &statements, const std::function<void()> &save)
+{
+	std::vector<std::string> captured;
+
+	database.BeginWriteCapture(&captured);
+	save();
+	database.EndWriteCapture();
+
+	if (!m_save_state.Changed(section, captured)) {
+		return false;
+	}
+
+	statements.insert(
+		statements.end(),
+		std::make_move_iterator(captured.begin()),
+		std::make_move_iterator(captured.end())
+	);
+
 	return true;
 }
 
@@ -1182,6 +1290,25 @@ void Client::QueuePacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CO
 	}
 }
 
+// same as QueuePacket, but the stream encodes through the broadcast so clients of one version share the work
+void Client::QueueBroadcastPacket(EQBroadcastPacket& broadcast, bool ack_req, CLIENT_CONN_STATUS required_state, eqFilterType filter) {
+	if (filter != FilterNone && GetFilter(filter) == FilterHide) {
+		return;
+	}
+
+	if (client_state != CLIENT_CONNECTED && required_state == CLIENT_CONNECTED) {
+		AddPacket(broadcast.GetPacket(), ack_req);
+		return;
+	}
+
+	if (required_state != CLIENT_CONNECTINGALL && client_state != required_state) {
+		AddPacket(broadcast.GetPacket(), ack_req);
+	}
+	else if (eqs) {
+		eqs->QueueBroadcastPacket(broadcast, ack_req);
+	}
+}
+
 void Client::FastQueuePacket(EQApplicationPacket** app, bool ack_req, CLIENT_CONN_STATUS required_state) {
 	// if the program doesnt care about the status or if the status isnt what we requested
 	if (required_state != CLIENT_CONNECTINGALL && client_state != required_state) {
@@ -51,6 +51,7 @@ namespace EQ
 #include "../common/seperator.h"
 #include "../common/inventory_profile.h"
 #include "../common/guilds.h"
+#include "../common/character_save_state.h"
 //#include "../common/item_data.h"
 #include "xtargetautohaters.h"
 #include "aggromanager.h"
@@ -73,6 +74,7 @@ namespace EQ
 #include "../common/guild_base.h"
 #include "../common/repositories/buyer_buy_lines_repository.h"
 #include "../common/repositories/character_evolving_items_repository.h"
+#include "../common/repositories/character_data_repository.h"
 
 #include "bot_structs.h"
 
@@ -89,6 +91,9 @@ namespace EQ
 #include <memory>
 #include <deque>
 #include <ctime>
+#include <array>
+#include <functional>
+#include <optional>
 
 
 #define CLIENT_LD_TIMEOUT 30000 // length of time client stays in zone after LDing
@@ -453,8 +458,10 @@ public:
 	void FillSpawnStruct(NewSpawn_Struct* ns, Mob* ForWho);
 	bool ShouldISpawnFor(Client *c) { return !GMHideMe(c) && !IsHoveringForRespawn(); }
 	virtual bool Process();
+	void TicProcess();
 	void QueuePacket(const EQApplicationPacket* app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL, eqFilterType filter=FilterNone);
 	void FastQueuePacket(EQApplicationPacket** app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL);
+	void QueueBroadcastPacket(EQBroadcastPacket& broadcast, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL, eqFilterType filter=FilterNone);
 	void ChannelMessageReceived(uint8 chan_num, uint8 language, uint8 lang_skill, const char* orig_message, const char* targetname = nullptr, bool is_silent = false);
 	void ChannelMessageSend(const char* from, const char* to, uint8 channel_id, uint8 language_id, uint8 language_skill, const char* message, ...);
 	void Message(uint32 type, const char* message, ...);
@@ -483,9 +490,13 @@ public:
 
 	virtual bool Save() { return Save(0); }
 	bool Save(uint8 iCommitNow); // 0 = delayed, 1=async now, 2=sync now
+	EQ::CharacterSaveState &GetSaveState() { return m_save_state; }
+	// character_data as this zone last wrote it, empty until the first save or after a failed one
+	std::optional<CharacterDataRepository::CharacterData> &GetSavedCharacterData() { return m_saved_character_data; }
 
 	/* New PP Save Functions */
-	bool SaveCurrency(){ return database.SaveCharacterCurrency(this->CharacterID(), &m_pp); }
+	// written outside of Save(), which can't skip currency next time
+	bool SaveCurrency(){ m_save_state.Forget(SaveSectionCurrency); return database.SaveCharacterCurrency(this->CharacterID(), &m_pp); }
 	bool SaveAA();
 	void RemoveExpendedAA(int aa_id);
 
@@ -1342,8 +1353,10 @@ public:
 			);
 		}
 	}
+	// Save() writes tasks itself, a save from elsewhere means it can't skip them next time
 	inline bool SaveTaskState()
 	{
+		m_save_state.Forget(SaveSectionTasks);
 		return task_manager != nullptr && task_manager->SaveClientState(this, task_state);
 	}
 	inline bool IsTaskStateLoaded() { return task_state != nullptr; }
@@ -2170,7 +2183,7 @@ private:
 	Timer global_channel_timer;
 	Timer fishing_timer;
 	Timer endupkeep_timer;
-	Timer autosave_timer;
+	EQ::WheelTimer autosave_timer;
 	Timer tribute_timer;
 
 	Timer proximity_timer;
@@ -2398,6 +2411,26 @@ private:
 	// full and partial mail key cache
 	std::string m_mail_key_full;
 	std::string m_mail_key;
+
+	// Save() runs each section with writes captured, a section that produces the same statements
+	// as last time is left out of the transaction
+	enum SaveSection : uint8 {
+		SaveSectionCurrency,
+		SaveSectionBinds,
+		SaveSectionBuffs,
+		SaveSectionPetInfo,
+		SaveSectionTimers,
+		SaveSectionTribute,
+		SaveSectionTasks,
+		SaveSectionData,
+		SaveSectionEXPModifier,
+		SaveSectionBotSettings,
+		SaveSectionCount
+	};
+
+	EQ::CharacterSaveState m_save_state;
+	std::optional<CharacterDataRepository::CharacterData> m_saved_character_data;
+	bool CaptureSaveSection(SaveSection section, std::vector<std::string> &statements, const std::function<void()> &save);
 public:
 	const std::string &GetMailKeyFull() const;
 	const std::string &GetMailKey() const;
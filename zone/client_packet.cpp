@@ -1415,10 +1415,8 @@ void Client::Handle_Connect_OP_ZoneEntry(const EQApplicationPacket *app)
 	/* Set Mob variables for spawn */
 	class_ = m_pp.class_;
 	level = m_pp.level;
-	m_Position.x = m_pp.x;
-	m_Position.y = m_pp.y;
-	m_Position.z = m_pp.z;
-	m_Position.w = m_pp.heading;
+	SetPosition(m_pp.x, m_pp.y, m_pp.z);
+	SetHeading(m_pp.heading);
 	race = m_pp.race;
 	base_race = m_pp.race;
 	gender = m_pp.gender;
@@ -4967,9 +4965,7 @@ void Client::Handle_OP_ClientUpdate(const EQApplicationPacket *app) {
 	int32 new_animation = ppu->animation;
 
 	/* Update internal server position from what the client has sent */
-	m_Position.x = cx;
-	m_Position.y = cy;
-	m_Position.z = cz;
+	SetPosition(cx, cy, cz);
 
 	/* Visual Debugging */
 	if (RuleB(Character, OPClientUpdateVisualDebug)) {
@@ -125,9 +125,6 @@ bool Client::Process() {
 			BroadcastPositionUpdate();
 		}
 
-		if (mana_timer.Check())
-			CheckManaEndUpdate();
-
 		if (dead && dead_timer.Check()) {
 			database.MoveCharacterToZone(GetName(), m_pp.binds[0].zone_id);
 
@@ -523,40 +520,6 @@ bool Client::Process() {
 		if (consume_food_timer.Check())
 			DoStaminaHungerUpdate();
 
-		if (tic_timer.Check() && !dead) {
-			CalcMaxHP();
-			CalcMaxMana();
-			CalcATK();
-			CalcMaxEndurance();
-			CalcRestState();
-			DoHPRegen();
-			DoManaRegen();
-			DoEnduranceRegen();
-			BuffProcess();
-
-			if (tribute_timer.Check()) {
-				ToggleTribute(true);	//re-activate the tribute.
-			}
-
-			if (fishing_timer.Check()) {
-				GoFish();
-			}
-
-			if (autosave_timer.Check()) {
-				Save(0);
-			}
-
-			if (GetIntoxication() > 0)
-			{
-				SetIntoxication(GetIntoxication()-1);
-				CalcBonuses();
-			}
-
-			if (ItemQuestTimer.Check())
-			{
-				ItemTimerCheck();
-			}
-		}
 	}
 
 	if (client_state == CLIENT_KICKED) {
@@ -688,6 +651,43 @@ bool Client::Process() {
 	return ret;
 }
 
+// runs from tic_timer's callback on the timing wheel rather than being polled in Process()
+void Client::TicProcess()
+{
+	if (!(Connected() || IsLD()) || dead) {
+		return;
+	}
+
+	CalcMaxHP();
+	CalcMaxMana();
+	CalcATK();
+	CalcMaxEndurance();
+	CalcRestState();
+	DoHPRegen();
+	DoManaRegen();
+	DoEnduranceRegen();
+	BuffProcess();
+
+	if (tribute_timer.Check()) {
+		ToggleTribute(true);	//re-activate the tribute.
+	}
+
+	if (fishing_timer.Check()) {
+		GoFish();
+	}
+
+	if (GetIntoxication() > 0)
+	{
+		SetIntoxication(GetIntoxication()-1);
+		CalcBonuses();
+	}
+
+	if (ItemQuestTimer.Check())
+	{
+		ItemTimerCheck();
+	}
+}
+
 /* Just a set of actions preformed all over in Client::Process */
 void Client::OnDisconnect(bool hard_disconnect) {
 	if (hard_disconnect) {
@@ -2187,9 +2187,7 @@ void Client::HandleRespawnFromHover(uint32 Option)
 
 			if (corpse)
 			{
-				m_Position.x = corpse->GetX();
-				m_Position.y = corpse->GetY();
-				m_Position.z = corpse->GetZ();
+				SetPosition(corpse->GetX(), corpse->GetY(), corpse->GetZ());
 			}
 
 			auto outapp =
@@ -2244,10 +2242,8 @@ void Client::HandleRespawnFromHover(uint32 Option)
 			RestoreMana();
 			RestoreEndurance();
 
-			m_Position.x = chosen->x;
-			m_Position.y = chosen->y;
-			m_Position.z = chosen->z;
-			m_Position.w = chosen->heading;
+			SetPosition(chosen->x, chosen->y, chosen->z);
+			SetHeading(chosen->heading);
 
 			ClearHover();
 			entity_list.RefreshClientXTargets(this);
@@ -12,6 +12,7 @@ extern WorldServer worldserver;
 const std::string  NESTED_KEY_DELIMITER = ".";
 
 std::vector<DataBucketsRepository::DataBuckets> g_data_bucket_cache = {};
+uint32                                          g_data_bucket_queued_writes = 0;
 
 void DataBucket::SetData(const std::string &bucket_key, const std::string &bucket_value, std::string expires_time)
 {
@@ -134,18 +135,33 @@ void DataBucket::SetData(const DataBucketKey &k_)
 
 	if (bucket_id) {
 		// update the cache if it exists
+		bool cached = false;
 		if (CanCache(k)) {
 			for (auto &e: g_data_bucket_cache) {
 				if (CheckBucketMatch(e, k)) {
-					e = b;
+					e      = b;
+					cached = true;
 					break;
 				}
 			}
 		}
 
-		DataBucketsRepository::UpdateOne(database, b);
+		// reads of a cached bucket never reach the database, so the write doesn't have to wait for it
+		if (cached) {
+			g_data_bucket_queued_writes++;
+			DataBucketsRepository::UpdateOneAsync(
+				database, b, [](MySQLRequestResult &) {
+					g_data_bucket_queued_writes--;
+				}
+			);
+		}
+		else {
+			WaitForQueuedWrites();
+			DataBucketsRepository::UpdateOne(database, b);
+		}
 	}
 	else {
+		WaitForQueuedWrites();
 		b = DataBucketsRepository::InsertOne(database, b);
 
 		// add to cache if it doesn't exist
@@ -254,6 +270,7 @@ DataBucketsRepository::DataBuckets DataBucket::GetData(const DataBucketKey &k_,
 	}
 
 	// Fetch the value from the database
+	WaitForQueuedWrites();
 	auto r = DataBucketsRepository::GetWhere(
 		database,
 		fmt::format(
@@ -368,6 +385,8 @@ bool DataBucket::GetDataBuckets(Mob *mob)
 
 bool DataBucket::DeleteData(const DataBucketKey &k)
 {
+	WaitForQueuedWrites();
+
 	bool is_nested_key = k.key.find(NESTED_KEY_DELIMITER) != std::string::npos;
 
 	if (!is_nested_key) {
@@ -581,6 +600,8 @@ bool DataBucket::CheckBucketMatch(const DataBucketsRepository::DataBuckets &dbe,
 
 void DataBucket::LoadZoneCache(uint16 zone_id, uint16 instance_id)
 {
+	WaitForQueuedWrites();
+
 	const auto &l = DataBucketsRepository::GetWhere(
 		database,
 		fmt::format(
@@ -666,6 +687,7 @@ void DataBucket::BulkLoadEntitiesToCache(DataBucketLoadType::Type t, std::vector
 			break;
 	}
 
+	WaitForQueuedWrites();
 	const auto &l = DataBucketsRepository::GetWhere(
 		database,
 		fmt::format(
@@ -858,3 +880,12 @@ bool DataBucket::CanCache(const DataBucketKey &key)
 
 	return false;
 }
+
+// a bucket evicted from the cache while its writes are still queued would be read back, or written over, out
+// of order. anything that goes to the database for buckets waits for those writes first
+void DataBucket::WaitForQueuedWrites()
+{
+	if (g_data_bucket_queued_writes > 0) {
+		database.FlushAsyncQueries();
+	}
+}
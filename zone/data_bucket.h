@@ -69,6 +69,7 @@ public:
 	static void DeleteFromCache(uint64 id, DataBucketLoadType::Type type);
 	static void DeleteZoneFromCache(uint16 zone_id, uint16 instance_id, DataBucketLoadType::Type type);
 	static bool CanCache(const DataBucketKey &key);
+	static void WaitForQueuedWrites();
 	static DataBucketsRepository::DataBuckets
 	ExtractNestedValue(const DataBucketsRepository::DataBuckets &bucket, const std::string &full_key);
 };
@@ -638,12 +638,12 @@ void Doors::Open(Mob *sender, bool alt_mode)
 				if (!m_disable_timer) {
 					m_close_timer.Start();
 				}
-				m_is_open = true;
+				SetOpenState(true);
 			}
 			else {
 				m_close_timer.Disable();
 				if (!m_disable_timer) {
-					m_is_open = false;
+					SetOpenState(false);
 				}
 			}
 		}
@@ -651,7 +651,7 @@ void Doors::Open(Mob *sender, bool alt_mode)
 			if (!m_disable_timer) {
 				m_close_timer.Start();
 			}
-			m_is_open = true;
+			SetOpenState(true);
 		}
 	}
 }
@@ -671,13 +671,13 @@ void Doors::ForceOpen(Mob *sender, bool alt_mode)
 				LogDoorsDetail("door_id [{}] starting timer", m_door_id);
 				m_close_timer.Start();
 			}
-			m_is_open = true;
+			SetOpenState(true);
 		}
 		else {
 			LogDoorsDetail("door_id [{}] disable timer", m_door_id);
 			m_close_timer.Disable();
 			if (!m_disable_timer) {
-				m_is_open = false;
+				SetOpenState(false);
 			}
 		}
 	}
@@ -686,7 +686,7 @@ void Doors::ForceOpen(Mob *sender, bool alt_mode)
 			LogDoorsDetail("door_id [{}] alt starting timer", m_door_id);
 			m_close_timer.Start();
 		}
-		m_is_open = true;
+		SetOpenState(true);
 	}
 }
 
@@ -705,11 +705,11 @@ void Doors::ForceClose(Mob *sender, bool alt_mode)
 			if (!m_disable_timer) {
 				m_close_timer.Start();
 			}
-			m_is_open = true;
+			SetOpenState(true);
 		}
 		else {
 			m_close_timer.Disable();
-			m_is_open = false;
+			SetOpenState(false);
 		}
 	}
 	else { // alternative function
@@ -733,11 +733,11 @@ void Doors::ToggleState(Mob *sender)
 
 	if (!m_is_open) {
 		move_door_packet->action = static_cast<uint8>(m_invert_state == 0 ? OPEN_DOOR : OPEN_INVDOOR);
-		m_is_open = true;
+		SetOpenState(true);
 	}
 	else {
 		move_door_packet->action = static_cast<uint8>(m_invert_state == 0 ? CLOSE_DOOR : CLOSE_INVDOOR);
-		m_is_open = false;
+		SetOpenState(false);
 	}
 
 	entity_list.QueueClients(sender, outapp, false);
@@ -785,6 +785,16 @@ std::vector<DoorsRepository::Doors> ZoneDatabase::LoadDoors(const std::string &z
 	return door_entries;
 }
 
+void Doors::SetOpenState(bool st)
+{
+	// routes planned around a closed door, or through an open one, no longer hold
+	if (m_is_open != st && zone && zone->pathing) {
+		zone->pathing->ClearRouteCache();
+	}
+
+	m_is_open = st;
+}
+
 void Doors::SetLocation(float x, float y, float z)
 {
 	entity_list.DespawnAllDoors();
@@ -426,7 +426,7 @@ int PerlembParser::EventNPC(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -434,7 +434,7 @@ int PerlembParser::EventNPC(
 	return EventCommon(
 		event_id,
 		npc->GetNPCTypeID(),
-		data.c_str(),
+		std::string(data).c_str(),
 		npc,
 		nullptr,
 		nullptr,
@@ -449,7 +449,7 @@ int PerlembParser::EventGlobalNPC(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -457,7 +457,7 @@ int PerlembParser::EventGlobalNPC(
 	return EventCommon(
 		event_id,
 		npc->GetNPCTypeID(),
-		data.c_str(),
+		std::string(data).c_str(),
 		npc,
 		nullptr,
 		nullptr,
@@ -471,7 +471,7 @@ int PerlembParser::EventGlobalNPC(
 int PerlembParser::EventPlayer(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -479,7 +479,7 @@ int PerlembParser::EventPlayer(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		nullptr,
 		nullptr,
 		nullptr,
@@ -493,7 +493,7 @@ int PerlembParser::EventPlayer(
 int PerlembParser::EventGlobalPlayer(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -501,7 +501,7 @@ int PerlembParser::EventGlobalPlayer(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		nullptr,
 		nullptr,
 		nullptr,
@@ -517,7 +517,7 @@ int PerlembParser::EventItem(
 	Client* client,
 	EQ::ItemInstance* inst,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -545,7 +545,7 @@ int PerlembParser::EventSpell(
 	Mob* mob,
 	Client* client,
 	uint32 spell_id,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -553,7 +553,7 @@ int PerlembParser::EventSpell(
 	return EventCommon(
 		event_id,
 		spell_id,
-		data.c_str(),
+		std::string(data).c_str(),
 		mob,
 		nullptr,
 		&spells[spell_id],
@@ -2627,7 +2627,7 @@ int PerlembParser::EventBot(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -2635,7 +2635,7 @@ int PerlembParser::EventBot(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		bot,
 		nullptr,
 		nullptr,
@@ -2650,7 +2650,7 @@ int PerlembParser::EventGlobalBot(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -2658,7 +2658,7 @@ int PerlembParser::EventGlobalBot(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		bot,
 		nullptr,
 		nullptr,
@@ -2747,7 +2747,7 @@ int PerlembParser::EventMerc(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -2755,7 +2755,7 @@ int PerlembParser::EventMerc(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		merc,
 		nullptr,
 		nullptr,
@@ -2770,7 +2770,7 @@ int PerlembParser::EventGlobalMerc(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -2778,7 +2778,7 @@ int PerlembParser::EventGlobalMerc(
 	return EventCommon(
 		event_id,
 		0,
-		data.c_str(),
+		std::string(data).c_str(),
 		merc,
 		nullptr,
 		nullptr,
@@ -331,6 +331,7 @@ void EntityList::AddClient(Client *client)
 	client->SetID(GetFreeID());
 	client_list.emplace(std::pair<uint16, Client *>(client->GetID(), client));
 	mob_list.emplace(std::pair<uint16, Mob *>(client->GetID(), client));
+	m_mob_grid.Add(client);
 }
 
 
@@ -475,6 +476,8 @@ void EntityList::MobProcess()
 {
 	bool mob_dead;
 
+	m_ai_lod.BeginFrame(client_list, m_mob_grid);
+
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
 		uint16 id = it->first;
@@ -529,14 +532,14 @@ void EntityList::MobProcess()
 				(mob && s2 && s2->PathWhenZoneIdle()) ||
 				mob_settle_timer->Enabled()
 			) {
-				mob_dead = !mob->Process();
+				mob_dead = !m_ai_lod.Process(mob);
 			} else {
 				// spawn_events can cause spawns and deaths while zone empty.
 				// At the very least, process that.
 				mob_dead = mob->CastToNPC()->GetDepop();
 			}
 		} else {
-			mob_dead = !mob->Process();
+			mob_dead = !m_ai_lod.Process(mob);
 		}
 
 		size_t a_sz = mob_list.size();
@@ -695,6 +698,7 @@ void EntityList::AddNPC(NPC *npc, bool send_spawn_packet, bool dont_queue)
 
 	npc_list.emplace(std::pair<uint16, NPC *>(npc->GetID(), npc));
 	mob_list.emplace(std::pair<uint16, Mob *>(npc->GetID(), npc));
+	m_mob_grid.Add(npc);
 
 	entity_list.ScanCloseMobs(npc);
 
@@ -776,6 +780,7 @@ void EntityList::AddMerc(Merc *merc, bool SendSpawnPacket, bool dontqueue)
 
 		merc_list.emplace(std::pair<uint16, Merc *>(merc->GetID(), merc));
 		mob_list.emplace(std::pair<uint16, Mob *>(merc->GetID(), merc));
+		m_mob_grid.Add(merc);
 
 		if (parse->MercHasQuestSub(EVENT_SPAWN)) {
 			parse->EventMerc(EVENT_SPAWN, merc, nullptr, "", 0);
@@ -1737,6 +1742,8 @@ void EntityList::QueueCloseClients(
 	}
 
 	float distance_squared = distance * distance;
+
+	EQBroadcastPacket broadcast(app);
 	for (auto &e : sender->GetCloseMobList(distance)) {
 		Mob *mob = e.second;
 		if (!mob) {
@@ -1766,7 +1773,7 @@ void EntityList::QueueCloseClients(
 				 (sender == client || (client->GetGroup() && client->GetGroup()->IsGroupMember(sender)))) ||
 				(client_filter == FilterShowSelfOnly && client == sender)
 				) {
-				client->QueuePacket(app, is_ack_required, Client::CLIENT_CONNECTED);
+				client->QueueBroadcastPacket(broadcast, is_ack_required, Client::CLIENT_CONNECTED);
 			}
 		}
 	}
@@ -1778,12 +1785,14 @@ void EntityList::QueueClients(
 	bool ignore_sender, bool ackreq
 )
 {
+	EQBroadcastPacket broadcast(app);
+
 	auto it = client_list.begin();
 	while (it != client_list.end()) {
 		Client *ent = it->second;
 
 		if ((!ignore_sender || ent != sender))
-			ent->QueuePacket(app, ackreq, Client::CLIENT_CONNECTED);
+			ent->QueueBroadcastPacket(broadcast, ackreq, Client::CLIENT_CONNECTED);
 
 		++it;
 	}
@@ -1889,15 +1898,31 @@ Bot* EntityList::GetRandomBot(const glm::vec3& location, float distance, Bot* ex
 
 	std::vector<Bot*> bots_in_range;
 
-	for (const auto& b : bot_list) {
-		if (
-			b.second != exclude_bot &&
-			(
-				is_whole_zone ||
-				DistanceSquared(static_cast<glm::vec3>(b.second->GetPosition()), location) <= distance_squared
+	if (!is_whole_zone && RuleB(Range, MobCloseScanUseSpatialGrid)) {
+		m_mob_grid.ForEachInRange(
+			location,
+			distance,
+			[&](Mob* m) {
+				if (
+					m->IsBot() &&
+					m != exclude_bot &&
+					DistanceSquared(static_cast<glm::vec3>(m->GetPosition()), location) <= distance_squared
+				) {
+					bots_in_range.push_back(m->CastToBot());
+				}
+			}
+		);
+	} else {
+		for (const auto& b : bot_list) {
+			if (
+				b.second != exclude_bot &&
+				(
+					is_whole_zone ||
+					DistanceSquared(static_cast<glm::vec3>(b.second->GetPosition()), location) <= distance_squared
 				)
-		) {
-			bots_in_range.push_back(b.second);
+			) {
+				bots_in_range.push_back(b.second);
+			}
 		}
 	}
 
@@ -1920,15 +1945,31 @@ Client *EntityList::GetRandomClient(const glm::vec3& location, float distance, C
 
 	std::vector<Client*> clients_in_range;
 
-	for (const auto& client : client_list) {
-		if (
-			client.second != exclude_client &&
-			(
-				is_whole_zone ||
-				DistanceSquared(static_cast<glm::vec3>(client.second->GetPosition()), location) <= distance_squared
-			)
-		) {
-			clients_in_range.push_back(client.second);
+	if (!is_whole_zone && RuleB(Range, MobCloseScanUseSpatialGrid)) {
+		m_mob_grid.ForEachInRange(
+			location,
+			distance,
+			[&](Mob* m) {
+				if (
+					m->IsClient() &&
+					m != exclude_client &&
+					DistanceSquared(static_cast<glm::vec3>(m->GetPosition()), location) <= distance_squared
+				) {
+					clients_in_range.push_back(m->CastToClient());
+				}
+			}
+		);
+	} else {
+		for (const auto& client : client_list) {
+			if (
+				client.second != exclude_client &&
+				(
+					is_whole_zone ||
+					DistanceSquared(static_cast<glm::vec3>(client.second->GetPosition()), location) <= distance_squared
+				)
+			) {
+				clients_in_range.push_back(client.second);
+			}
 		}
 	}
 
@@ -1950,15 +1991,31 @@ NPC* EntityList::GetRandomNPC(const glm::vec3& location, float distance, NPC* ex
 
 	std::vector<NPC*> npcs_in_range;
 
-	for (const auto& npc : npc_list) {
-		if (
-			npc.second != exclude_npc &&
-			(
-				is_whole_zone ||
-				DistanceSquared(static_cast<glm::vec3>(npc.second->GetPosition()), location) <= distance_squared
-			)
-		) {
-			npcs_in_range.push_back(npc.second);
+	if (!is_whole_zone && RuleB(Range, MobCloseScanUseSpatialGrid)) {
+		m_mob_grid.ForEachInRange(
+			location,
+			distance,
+			[&](Mob* m) {
+				if (
+					m->IsNPC() &&
+					m != exclude_npc &&
+					DistanceSquared(static_cast<glm::vec3>(m->GetPosition()), location) <= distance_squared
+				) {
+					npcs_in_range.push_back(m->CastToNPC());
+				}
+			}
+		);
+	} else {
+		for (const auto& npc : npc_list) {
+			if (
+				npc.second != exclude_npc &&
+				(
+					is_whole_zone ||
+					DistanceSquared(static_cast<glm::vec3>(npc.second->GetPosition()), location) <= distance_squared
+				)
+			) {
+				npcs_in_range.push_back(npc.second);
+			}
 		}
 	}
 
@@ -1980,15 +2037,30 @@ Mob* EntityList::GetRandomMob(const glm::vec3& location, float distance, Mob* ex
 
 	std::vector<Mob*> mobs_in_range;
 
-	for (const auto& mob : mob_list) {
-		if (
-			mob.second != exclude_mob &&
-			(
-				is_whole_zone ||
-				DistanceSquared(static_cast<glm::vec3>(mob.second->GetPosition()), location) <= distance_squared
-			)
-		) {
-			mobs_in_range.push_back(mob.second);
+	if (!is_whole_zone && RuleB(Range, MobCloseScanUseSpatialGrid)) {
+		m_mob_grid.ForEachInRange(
+			location,
+			distance,
+			[&](Mob* m) {
+				if (
+					m != exclude_mob &&
+					DistanceSquared(static_cast<glm::vec3>(m->GetPosition()), location) <= distance_squared
+				) {
+					mobs_in_range.push_back(m);
+				}
+			}
+		);
+	} else {
+		for (const auto& mob : mob_list) {
+			if (
+				mob.second != exclude_mob &&
+				(
+					is_whole_zone ||
+					DistanceSquared(static_cast<glm::vec3>(mob.second->GetPosition()), location) <= distance_squared
+				)
+			) {
+				mobs_in_range.push_back(mob.second);
+			}
 		}
 	}
 
@@ -2653,6 +2725,8 @@ void EntityList::RemoveAllMobs()
 		free_ids.push(it->first);
 		it = mob_list.erase(it);
 	}
+
+	m_mob_grid.Clear();
 }
 
 void EntityList::RemoveAllClients()
@@ -2795,6 +2869,7 @@ bool EntityList::RemoveMob(uint16 delete_id)
 		else if (client_list.count(delete_id)) {
 			entity_list.RemoveClient(delete_id);
 		}
+		m_mob_grid.Remove(it->second);
 		safe_delete(it->second);
 		if (!corpse_list.count(delete_id)) {
 			free_ids.push(it->first);
@@ -2840,6 +2915,8 @@ bool EntityList::RemoveMobFromCloseLists(Mob *mob)
 		entity_id
 	);
 
+	m_mob_grid.Remove(mob);
+
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
 		LogEntityManagement(
@@ -2905,9 +2982,22 @@ void EntityList::RemoveAuraFromMobs(Mob *aura)
 // All of the above makes a tremendous impact on the bottom line of cpu cycle performance because we run an order of magnitude
 // less checks by focusing our hot path logic down to a very small subset of relevant entities instead of looping an entire
 // entity list (zone wide)
+//
+// Candidates come from the zone spatial grid (MobSpatialGrid) rather than the whole mob list so a scan only touches
+// the cells around the scanning mob; Range:MobCloseScanUseSpatialGrid toggles back to the full list walk so both
+// can be compared through the AIScanClose log category
 
 BenchTimer g_scan_bench_timer;
 
+void EntityList::SyncMobGridCellSize()
+{
+	const float scan_range = RuleI(Range, MobCloseScanDistance);
+	if (m_mob_grid.GetCellSize() != scan_range) {
+		LogAIScanClose("Rebuilding mob spatial grid with cell size [{}]", scan_range);
+		m_mob_grid.Reset(scan_range);
+	}
+}
+
 void EntityList::ScanCloseMobs(Mob *scanning_mob)
 {
 	if (!scanning_mob) {
@@ -2930,15 +3020,20 @@ void EntityList::ScanCloseMobs(Mob *scanning_mob)
 
 	scanning_mob->m_close_mobs.clear();
 
-	for (auto &e : mob_list) {
-		auto mob = e.second;
+	const float scan_range_squared = scan_range * scan_range;
+	const auto &scan_position      = scanning_mob->GetPosition();
+
+	uint32 candidates = 0;
+
+	auto check_close = [&](Mob *mob) {
+		++candidates;
 
 		if (mob && (mob->GetID() <= 0 || mob->IsZoneController())) {
-			continue;
+			return;
 		}
 
-		float distance = Distance(scanning_mob->GetPosition(), mob->GetPosition());
-		if (distance <= scan_range || mob->GetAggroRange() >= scan_range) {
+		float distance_squared = DistanceSquared(scan_position, mob->GetPosition());
+		if (distance_squared <= scan_range_squared || mob->GetAggroRange() >= scan_range) {
 			// add mob to scanning_mob's close list and vice versa
 			// check if the mob is already in the close mobs list before inserting
 			if (mob->m_close_mobs.find(scanning_mob->GetID()) == mob->m_close_mobs.end()) {
@@ -2946,12 +3041,32 @@ void EntityList::ScanCloseMobs(Mob *scanning_mob)
 			}
 			scanning_mob->m_close_mobs[mob->GetID()] = mob;
 		}
+	};
+
+	const bool use_grid = RuleB(Range, MobCloseScanUseSpatialGrid);
+	if (use_grid) {
+		SyncMobGridCellSize();
+
+		// positions are not always routed through SetPosition, make sure our own cell is current
+		m_mob_grid.Update(scanning_mob);
+		m_mob_grid.ForEachInRange(glm::vec3(scan_position), scan_range, check_close);
+
+		// mobs whose aggro range covers the scan range are always close regardless of distance
+		m_mob_grid.ForEachWide(check_close);
+	}
+	else {
+		for (auto &e : mob_list) {
+			check_close(e.second);
+		}
 	}
 
 	LogAIScanClose(
-		"[{}] Scanning close list > list_size [{}] moving [{}] elapsed [{}] us",
+		"[{}] Scanning close list > list_size [{}] candidates [{}] of [{}] method [{}] moving [{}] elapsed [{}] us",
 		scanning_mob->GetCleanName(),
 		scanning_mob->m_close_mobs.size(),
+		candidates,
+		mob_list.size(),
+		use_grid ? "grid" : "list",
 		scanning_mob->IsMoving() ? "true" : "false",
 		g_scan_bench_timer.elapsedMicroseconds()
 	);
@@ -3855,6 +3970,7 @@ void EntityList::AddProximity(NPC *proximity_for)
 	RemoveProximity(proximity_for->GetID());
 
 	proximity_list.push_back(proximity_for);
+	m_proximity_grid_dirty = true;
 
 	proximity_for->proximity = new NPCProximity; // deleted in NPC::~NPC
 }
@@ -3867,12 +3983,14 @@ bool EntityList::RemoveProximity(uint16 delete_npc_id)
 		return false;
 
 	proximity_list.erase(it);
+	m_proximity_grid_dirty = true;
 	return true;
 }
 
 void EntityList::RemoveAllLocalities()
 {
 	proximity_list.clear();
+	m_proximity_grid_dirty = true;
 }
 
 struct quest_proximity_event {
@@ -3883,15 +4001,79 @@ struct quest_proximity_event {
 	int area_type;
 };
 
+// proximity bounds are assigned by the quest api after AddProximity, so the grid is only built
+// once something actually moves
+void EntityList::RebuildProximityGrid()
+{
+	m_proximity_grid.Reset();
+	m_proximity_index.clear();
+	m_proximity_index.reserve(proximity_list.size());
+
+	for (auto n : proximity_list) {
+		const auto index = static_cast<uint32>(m_proximity_index.size());
+		m_proximity_index.push_back(n);
+
+		auto p = n->proximity;
+		if (!p) {
+			continue;
+		}
+
+		if (!p->proximity_set) {
+			m_proximity_grid.InsertWide(index);
+			continue;
+		}
+
+		m_proximity_grid.Insert(index, p->min_x, p->max_x, p->min_y, p->max_y);
+	}
+
+	m_proximity_grid_dirty = false;
+}
+
+void EntityList::RebuildAreaGrid()
+{
+	m_area_grid.Reset();
+	m_area_index.clear();
+	m_area_index.reserve(area_list.size());
+
+	for (const auto &a : area_list) {
+		const auto index = static_cast<uint32>(m_area_index.size());
+		m_area_index.push_back(&a);
+		m_area_grid.Insert(index, a.min_x, a.max_x, a.min_y, a.max_y);
+	}
+
+	m_area_grid_dirty = false;
+}
+
+// fills m_box_candidates with the boxes that may hold either position, sorted so events keep list order
+void EntityList::GatherBoxCandidates(const QuestBoxGrid &grid, float x1, float y1, float x2, float y2)
+{
+	m_box_candidates.clear();
+	grid.Query(x1, y1, m_box_candidates);
+	grid.Query(x2, y2, m_box_candidates);
+
+	std::sort(m_box_candidates.begin(), m_box_candidates.end());
+	m_box_candidates.erase(std::unique(m_box_candidates.begin(), m_box_candidates.end()), m_box_candidates.end());
+}
+
 void EntityList::ProcessMove(Client *c, const glm::vec3& location)
 {
 	float last_x = c->ProximityX();
 	float last_y = c->ProximityY();
 	float last_z = c->ProximityZ();
 
-	std::list<quest_proximity_event> events;
-	for (auto iter = proximity_list.begin(); iter != proximity_list.end(); ++iter) {
-		NPC *d = (*iter);
+	if (m_proximity_grid_dirty) {
+		RebuildProximityGrid();
+	}
+
+	if (m_area_grid_dirty) {
+		RebuildAreaGrid();
+	}
+
+	std::vector<quest_proximity_event> events;
+
+	GatherBoxCandidates(m_proximity_grid, last_x, last_y, location.x, location.y);
+	for (auto index : m_box_candidates) {
+		NPC *d = m_proximity_index[index];
 		NPCProximity *l = d->proximity;
 		if (l == nullptr)
 			continue;
@@ -3930,8 +4112,9 @@ void EntityList::ProcessMove(Client *c, const glm::vec3& location)
 		}
 	}
 
-	for (auto iter = area_list.begin(); iter != area_list.end(); ++iter) {
-		Area& a = (*iter);
+	GatherBoxCandidates(m_area_grid, last_x, last_y, location.x, location.y);
+	for (auto index : m_box_candidates) {
+		const Area& a = *m_area_index[index];
 		bool old_in = true;
 		bool new_in = true;
 		if (last_x < a.min_x || last_x > a.max_x ||
@@ -4017,9 +4200,15 @@ void EntityList::ProcessMove(NPC *n, float x, float y, float z) {
 	float last_y = n->GetY();
 	float last_z = n->GetZ();
 
-	std::list<quest_proximity_event> events;
+	if (m_area_grid_dirty) {
+		RebuildAreaGrid();
+	}
+
+	std::vector<quest_proximity_event> events;
 
-	for (const auto& a : area_list) {
+	GatherBoxCandidates(m_area_grid, last_x, last_y, x, y);
+	for (auto index : m_box_candidates) {
+		const Area& a = *m_area_index[index];
 		bool old_in = true;
 		bool new_in = true;
 		if (
@@ -4115,6 +4304,7 @@ void EntityList::AddArea(int id, int type, float min_x, float max_x, float min_y
 	}
 
 	area_list.push_back(a);
+	m_area_grid_dirty = true;
 }
 
 void EntityList::RemoveArea(int id)
@@ -4125,11 +4315,13 @@ void EntityList::RemoveArea(int id)
 		return;
 
 	area_list.erase(it);
+	m_area_grid_dirty = true;
 }
 
 void EntityList::ClearAreas()
 {
 	area_list.clear();
+	m_area_grid_dirty = true;
 }
 
 void EntityList::ProcessProximitySay(const char *message, Client *c, uint8 language)
@@ -4138,7 +4330,22 @@ void EntityList::ProcessProximitySay(const char *message, Client *c, uint8 langu
 		return;
 	}
 
-	for (const auto& n : proximity_list) {
+	if (m_proximity_grid_dirty) {
+		RebuildProximityGrid();
+	}
+
+	m_box_candidates.clear();
+	m_proximity_grid.Query(c->GetX(), c->GetY(), m_box_candidates);
+	std::sort(m_box_candidates.begin(), m_box_candidates.end());
+
+	// copied out first, a say event may add or remove proximities and rebuild the index underneath us
+	std::vector<NPC *> candidates;
+	candidates.reserve(m_box_candidates.size());
+	for (auto index : m_box_candidates) {
+		candidates.push_back(m_proximity_index[index]);
+	}
+
+	for (const auto& n : candidates) {
 		auto* p = n->proximity;
 		if (!p || !p->say) {
 			continue;
@@ -28,6 +28,9 @@
 #include "../common/eq_constants.h"
 #include "../common/emu_constants.h"
 
+#include "ai_lod_scheduler.h"
+#include "mob_spatial_grid.h"
+#include "quest_box_grid.h"
 #include "position.h"
 #include "zonedump.h"
 #include "common.h"
@@ -570,6 +573,9 @@ public:
 	void RefreshClientXTargets(Client *c);
 	void SendAlternateAdvancementStats();
 	void ScanCloseMobs(Mob *scanning_mob);
+	inline void UpdateMobGridPosition(Mob *mob) { m_mob_grid.Update(mob); }
+	inline const MobSpatialGrid &GetMobGrid() const { return m_mob_grid; }
+	inline AILodScheduler &GetAILod() { return m_ai_lod; }
 
 	void GetTrapInfo(Client* c);
 	bool IsTrapGroupSpawned(uint32 trap_id, uint8 group);
@@ -613,6 +619,22 @@ private:
 	std::list<Area> area_list;
 	std::queue<uint16> free_ids;
 
+	// bucketed views of proximity_list and area_list, rebuilt on the next lookup after either changes
+	QuestBoxGrid m_proximity_grid;
+	QuestBoxGrid m_area_grid;
+	std::vector<NPC *> m_proximity_index;
+	std::vector<const Area *> m_area_index;
+	std::vector<uint32> m_box_candidates;
+	bool m_proximity_grid_dirty = true;
+	bool m_area_grid_dirty = true;
+	void RebuildProximityGrid();
+	void RebuildAreaGrid();
+	void GatherBoxCandidates(const QuestBoxGrid &grid, float x1, float y1, float x2, float y2);
+
+	MobSpatialGrid m_mob_grid;
+	AILodScheduler m_ai_lod;
+	void SyncMobGridCellSize();
+
 	Timer object_timer;
 	Timer door_timer;
 	Timer corpse_timer;
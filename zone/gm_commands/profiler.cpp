@@ -0,0 +1,133 @@
+#include "../client.h"
+#include "../zone_profiler.h"
+
+void command_profiler(Client *c, const Seperator *sep)
+{
+	int arguments = sep->argnum;
+
+	auto send_usage = [c]() {
+		c->Message(Chat::White, "Usage: #profiler on - Starts recording zone frame timings");
+		c->Message(Chat::White, "Usage: #profiler off - Stops recording zone frame timings");
+		c->Message(Chat::White, "Usage: #profiler reset - Clears all recorded timings");
+		c->Message(Chat::White, "Usage: #profiler show [Minimum p99 ms] - Shows the frame breakdown, sections under the minimum are hidden");
+		c->Message(Chat::White, "Usage: #profiler npcs [Count] - Shows the NPC types with the most AI time");
+		c->Message(Chat::White, "Usage: #profiler lod - Shows NPC counts and AI time per level of detail tier");
+	};
+
+	if (!arguments) {
+		send_usage();
+		return;
+	}
+
+	auto &profiler = ZoneProfiler::Instance();
+
+	const bool is_on    = !strcasecmp(sep->arg[1], "on");
+	const bool is_off   = !strcasecmp(sep->arg[1], "off");
+	const bool is_reset = !strcasecmp(sep->arg[1], "reset");
+	const bool is_show  = !strcasecmp(sep->arg[1], "show");
+	const bool is_npcs  = !strcasecmp(sep->arg[1], "npcs");
+	const bool is_lod   = !strcasecmp(sep->arg[1], "lod");
+
+	if (is_on || is_off) {
+		profiler.SetEnabled(is_on);
+		c->Message(Chat::White, fmt::format("Frame profiler is now {}.", is_on ? "enabled" : "disabled").c_str());
+	}
+	else if (is_reset) {
+		profiler.Reset();
+		entity_list.GetAILod().ResetStats();
+		c->Message(Chat::White, "Frame profiler timings have been reset.");
+	}
+	else if (is_show) {
+		const double minimum_ms = sep->IsNumber(2) ? Strings::ToFloat(sep->arg[2]) : 0.0;
+
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"Frame profile | {} | {} frame{} recorded (p50 / p99 / max per frame, average per call)",
+				profiler.IsEnabled() ? "Enabled" : "Disabled",
+				profiler.GetFrameCount(),
+				profiler.GetFrameCount() != 1 ? "s" : ""
+			).c_str()
+		);
+
+		for (const auto &s : profiler.GetSections()) {
+			if (s.depth > 0 && s.p99_ms < minimum_ms) {
+				continue;
+			}
+
+			c->Message(
+				Chat::White,
+				fmt::format(
+					"{}{} | {:.3f} / {:.3f} / {:.3f} ms | {:.1f} us x {}",
+					std::string(s.depth * 2, ' '),
+					s.name,
+					s.p50_ms,
+					s.p99_ms,
+					s.max_ms,
+					s.avg_call_us,
+					s.calls
+				).c_str()
+			);
+		}
+	}
+	else if (is_npcs) {
+		const size_t count = sep->IsNumber(2) ? std::max(Strings::ToInt(sep->arg[2]), 1) : 10;
+
+		const auto npcs = profiler.GetTopNpcs(count);
+		if (npcs.empty()) {
+			c->Message(Chat::White, "No NPC AI timings have been recorded.");
+			return;
+		}
+
+		for (const auto &n : npcs) {
+			c->Message(
+				Chat::White,
+				fmt::format(
+					"{} ({}) | {:.3f} ms total | {:.1f} us average | {:.1f} us max | {} call{}",
+					n.name,
+					n.npc_type_id,
+					n.total_ms,
+					n.avg_us,
+					n.max_us,
+					n.calls,
+					n.calls != 1 ? "s" : ""
+				).c_str()
+			);
+		}
+	}
+	else if (is_lod) {
+		auto &lod = entity_list.GetAILod();
+
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"AI level of detail | {} | AI time is only recorded while the profiler is enabled",
+				lod.IsEnabled() ? "Enabled" : "Disabled"
+			).c_str()
+		);
+
+		for (uint8 t = AILodScheduler::Full; t < AILodScheduler::TierCount; ++t) {
+			const auto tier = static_cast<AILodScheduler::Tier>(t);
+			const auto &st  = lod.GetStats()[t];
+
+			c->Message(
+				Chat::White,
+				fmt::format(
+					"{} (every {} frame{}) | {} mob{} | {} processed | {} skipped | {:.3f} ms total | {:.1f} us average",
+					AILodScheduler::GetTierName(tier),
+					lod.GetInterval(tier),
+					lod.GetInterval(tier) != 1 ? "s" : "",
+					st.mobs,
+					st.mobs != 1 ? "s" : "",
+					st.processed,
+					st.skipped,
+					st.total_ns / 1000000.0,
+					st.processed ? static_cast<double>(st.total_ns) / st.processed / 1000.0 : 0.0
+				).c_str()
+			);
+		}
+	}
+	else {
+		send_usage();
+	}
+}
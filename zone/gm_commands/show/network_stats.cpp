@@ -87,6 +87,11 @@ void ShowNetworkStats(Client *c, const Seperator *sep)
 		DialogueWindow::TableCell(Strings::Commify(stats.avg_ping))
 	);
 
+	popup_table += DialogueWindow::TableRow(
+		DialogueWindow::TableCell("Ping Deviation") +
+		DialogueWindow::TableCell(Strings::Commify(stats.ping_deviation))
+	);
+
 	popup_table += DialogueWindow::Break(2);
 
 	popup_table += DialogueWindow::TableRow(
@@ -204,6 +209,28 @@ void ShowNetworkStats(Client *c, const Seperator *sep)
 		)
 	);
 
+	popup_table += DialogueWindow::TableRow(
+		DialogueWindow::TableCell("Resent Early") +
+		DialogueWindow::TableCell(
+			fmt::format(
+				"{} ({:.2f} Per Second)",
+				Strings::Commify(stats.fast_resends),
+				stats.fast_resends / sec_since_stats_reset
+			)
+		)
+	);
+
+	popup_table += DialogueWindow::TableRow(
+		DialogueWindow::TableCell("Unacked Packets") +
+		DialogueWindow::TableCell(
+			fmt::format(
+				"{} (Max {})",
+				Strings::Commify(stats.sent_window),
+				Strings::Commify(stats.max_sent_window)
+			)
+		)
+	);
+
 	popup_table += DialogueWindow::Break(2);
 
 	popup_table += DialogueWindow::TableRow(
@@ -29,6 +29,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "zone.h"
 #include "water_map.h"
 
+#include <algorithm>
 #include <list>
 
 extern Zone *zone;
@@ -42,33 +43,139 @@ HateList::~HateList()
 {
 }
 
+struct_HateList *HateList::AllocateEntry()
+{
+	struct_HateList *e = nullptr;
+	if (!m_free.empty()) {
+		e = m_free.back();
+		m_free.pop_back();
+	} else {
+		e = &m_pool.emplace_back();
+	}
+
+	e->owner = this;
+	return e;
+}
+
+// drops the entry from the index and hands it back to the pool, the caller takes it out of list
+void HateList::ReleaseEntry(struct_HateList *entry)
+{
+	auto i = m_index.find(entry->entity_on_hatelist);
+	if (i != m_index.end() && i->second == entry) {
+		m_index.erase(i);
+	}
+
+	if (entry == m_top) {
+		m_top       = nullptr;
+		m_top_dirty = true;
+	}
+
+	// script handles still holding this entry see an empty one rather than freed memory
+	entry->entity_on_hatelist = nullptr;
+	entry->hatelist_damage    = 0;
+	entry->stored_hate_amount = 0;
+	entry->is_entity_frenzy   = false;
+	entry->oor_count          = 0;
+
+	m_free.push_back(entry);
+}
+
+void HateList::EraseEntry(struct_HateList *entry)
+{
+	auto i = std::find(list.begin(), list.end(), entry);
+	if (i == list.end()) {
+		return;
+	}
+
+	list.erase(i);
+	ReleaseEntry(entry);
+}
+
+void HateList::RebuildIndex()
+{
+	m_index.clear();
+	for (auto e : list) {
+		if (e->entity_on_hatelist) {
+			m_index.emplace(e->entity_on_hatelist, e); // first entry wins, same as a front to back Find
+		}
+	}
+}
+
+// the top entry only moves when someone passes it, ties go to whoever is earlier in the list
+void HateList::OnHateRaised(struct_HateList *entry)
+{
+	if (m_top_dirty || !entry->entity_on_hatelist || entry == m_top) {
+		return;
+	}
+
+	if (!m_top) {
+		if (entry->stored_hate_amount > -1) {
+			m_top = entry;
+		}
+
+		return;
+	}
+
+	if (entry->stored_hate_amount > m_top->stored_hate_amount) {
+		m_top = entry;
+	} else if (entry->stored_hate_amount == m_top->stored_hate_amount) {
+		m_top_dirty = true;
+	}
+}
+
+void HateList::OnHateLowered(struct_HateList *entry)
+{
+	if (entry == m_top) {
+		m_top_dirty = true;
+	}
+}
+
+void HateList::OnEntryModified(struct_HateList *entry)
+{
+	if (!entry || entry->owner != this) {
+		return;
+	}
+
+	RebuildIndex();
+	m_top_dirty = true;
+}
+
 void HateList::WipeHateList(bool npc_only) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		Mob *m = (*iterator)->entity_on_hatelist;
-		if (
-			m &&
-			(
-				m->IsOfClientBotMerc() ||
-				(m->IsPet() && m->GetOwner() && m->GetOwner()->IsOfClientBotMerc())
-			) &&
-			npc_only
-		) {
-			iterator++;
-		} else {
-			if (m) {
-				if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
-					parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
-				}
+	std::vector<Mob *> removed;
 
-				if (m->IsClient()) {
-					m->CastToClient()->DecrementAggroCount();
-					m->CastToClient()->RemoveXTarget(hate_owner, true);
-				}
+	std::erase_if(
+		list,
+		[&](struct_HateList *e) {
+			Mob *m = e->entity_on_hatelist;
+			if (
+				m &&
+				(
+					m->IsOfClientBotMerc() ||
+					(m->IsPet() && m->GetOwner() && m->GetOwner()->IsOfClientBotMerc())
+				) &&
+				npc_only
+			) {
+				return false;
+			}
 
-				delete (*iterator);
-				iterator = list.erase(iterator);
+			if (m) {
+				removed.push_back(m);
 			}
+
+			ReleaseEntry(e);
+			return true;
+		}
+	);
+
+	// events run once the list is settled so a script touching the hate list can't trip us up
+	for (auto m : removed) {
+		if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
+			parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+		}
+
+		if (m->IsClient()) {
+			m->CastToClient()->DecrementAggroCount();
+			m->CastToClient()->RemoveXTarget(hate_owner, true);
 		}
 	}
 }
@@ -84,13 +191,8 @@ struct_HateList* HateList::Find(Mob* m)
 		return nullptr;
 	}
 
-	for (auto e : list) {
-		if (e->entity_on_hatelist && e->entity_on_hatelist == m) {
-			return e;
-		}
-	}
-
-	return nullptr;
+	auto i = m_index.find(m);
+	return i != m_index.end() ? i->second : nullptr;
 }
 
 void HateList::SetHateAmountOnEnt(Mob* other, int64 in_hate, uint64 in_damage)
@@ -100,8 +202,14 @@ void HateList::SetHateAmountOnEnt(Mob* other, int64 in_hate, uint64 in_damage)
 	{
 		if (in_damage > 0)
 			entity->hatelist_damage = in_damage;
-		if (in_hate > 0)
+		if (in_hate > 0) {
+			const int64 old_hate = entity->stored_hate_amount;
 			entity->stored_hate_amount = in_hate;
+			if (in_hate > old_hate)
+				OnHateRaised(entity);
+			else if (in_hate < old_hate)
+				OnHateLowered(entity);
+		}
 		entity->last_modified = Timer::GetCurrentTime();
 	}
 }
@@ -225,6 +333,12 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 		entity->is_entity_frenzy = in_is_entity_frenzied;
 		entity->last_modified = Timer::GetCurrentTime();
 
+		if (in_hate > 0) {
+			OnHateRaised(entity);
+		} else if (in_hate < 0) {
+			OnHateLowered(entity);
+		}
+
 		LogHate(
 			"AddEntToHateList in_entity [{}] ({}) in_hate [{}] in_damage [{}] stored_hate_amount [{}] hatelist_damage [{}]",
 			in_entity->GetCleanName(),
@@ -235,7 +349,7 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 			entity->hatelist_damage
 		);
 	} else if (iAddIfNotExist) {
-		entity = new struct_HateList;
+		entity = AllocateEntry();
 		entity->entity_on_hatelist = in_entity;
 		entity->hatelist_damage = (in_damage >= 0) ? in_damage : 0;
 		entity->stored_hate_amount = in_hate;
@@ -243,6 +357,8 @@ void HateList::AddEntToHateList(Mob *in_entity, int64 in_hate, int64 in_damage,
 		entity->oor_count = 0;
 		entity->last_modified = Timer::GetCurrentTime();
 		list.push_back(entity);
+		m_index.emplace(in_entity, entity);
+		OnHateRaised(entity);
 
 		if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
 			parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "1", 0);
@@ -260,30 +376,22 @@ bool HateList::RemoveEntFromHateList(Mob *in_entity)
 		return false;
 	}
 
-	bool is_found = false;
-	auto iterator = list.begin();
-
-	while (iterator != list.end()) {
-		if ((*iterator)->entity_on_hatelist == in_entity) {
-			is_found = true;
+	struct_HateList *entity = Find(in_entity);
+	if (!entity) {
+		return false;
+	}
 
-			if (in_entity && in_entity->IsClient()) {
-				in_entity->CastToClient()->DecrementAggroCount();
-			}
+	if (in_entity->IsClient()) {
+		in_entity->CastToClient()->DecrementAggroCount();
+	}
 
-			delete (*iterator);
-			iterator = list.erase(iterator);
+	EraseEntry(entity);
 
-			if (in_entity) {
-				if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
-					parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "0", 0);
-				}
-			}
-		} else {
-			++iterator;
-		}
+	if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
+		parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), in_entity, "0", 0);
 	}
-	return is_found;
+
+	return true;
 }
 
 // so if faction_id and faction_value are set, we do RewardFaction, otherwise old stuff
@@ -556,38 +664,46 @@ Mob *HateList::GetMobWithMostHateOnList(
 }
 
 Mob *HateList::GetMobWithMostHateOnList(bool skip_mezzed){
+	if (m_top_dirty) {
+		m_top       = nullptr;
+		m_top_dirty = false;
+
+		for (auto cur : list) {
+			if (cur->entity_on_hatelist && cur->stored_hate_amount > (m_top ? m_top->stored_hate_amount : -1)) {
+				m_top = cur;
+			}
+		}
+	}
+
+	if (!m_top) {
+		return nullptr;
+	}
+
+	if (!skip_mezzed || !m_top->entity_on_hatelist->IsMezzed()) {
+		LogHateDetail(
+			"GetMobWithMostHateOnList [{}] hate [{}]",
+			m_top->entity_on_hatelist->GetMobDescription(),
+			m_top->stored_hate_amount
+		);
+
+		return m_top->entity_on_hatelist;
+	}
+
+	// the tracked top is mezzed, walk the list for the best one that isn't
 	Mob* top = nullptr;
 	int64 hate = -1;
 
-	auto iterator = list.begin();
-	while (iterator != list.end())
-	{
-		struct_HateList *cur = (*iterator);
-
-		if (cur) {
-			LogHateDetail(
-				"Looping GetMobWithMostHateOnList1 [{}] cur [{}] hate [{}] calc [{}]",
-				cur->entity_on_hatelist->GetMobDescription(),
-				cur->stored_hate_amount,
-				hate,
-				(cur->stored_hate_amount > hate)
-			);
-
-			if (cur->entity_on_hatelist != nullptr && (cur->stored_hate_amount > hate))
-			{
-				LogHateDetail(
-					"Looping GetMobWithMostHateOnList2 [{}]",
-					cur->entity_on_hatelist->GetMobDescription()
-				);
-
-				if (!skip_mezzed || !cur->entity_on_hatelist->IsMezzed()) {
-					top = cur->entity_on_hatelist;
-					hate = cur->stored_hate_amount;
-				}
-			}
+	for (auto cur : list) {
+		if (
+			cur->entity_on_hatelist &&
+			cur->stored_hate_amount > hate &&
+			!cur->entity_on_hatelist->IsMezzed()
+		) {
+			top  = cur->entity_on_hatelist;
+			hate = cur->stored_hate_amount;
 		}
-		++iterator;
 	}
+
 	return top;
 }
 
@@ -855,46 +971,54 @@ void HateList::SpellCast(Mob *caster, uint32 spell_id, float range, Mob* ae_cent
 
 void HateList::RemoveStaleEntries(int time_ms, float dist)
 {
-	auto it = list.begin();
-
 	auto cur_time = Timer::GetCurrentTime();
 
 	auto dist2 = dist * dist;
 
-	while (it != list.end()) {
-		auto m = (*it)->entity_on_hatelist;
-		if (m) {
+	std::vector<Mob *> removed;
+
+	std::erase_if(
+		list,
+		[&](struct_HateList *e) {
+			auto m = e->entity_on_hatelist;
+			if (!m) {
+				return false;
+			}
+
 			bool remove = false;
 
-			if (cur_time - (*it)->last_modified > time_ms) {
+			if (cur_time - e->last_modified > time_ms) {
 				remove = true;
 			}
 
 			if (!remove && DistanceSquaredNoZ(hate_owner->GetPosition(), m->GetPosition()) > dist2) {
-				(*it)->oor_count++;
-				if ((*it)->oor_count == 2) {
+				e->oor_count++;
+				if (e->oor_count == 2) {
 					remove = true;
 				}
-			} else if ((*it)->oor_count != 0) {
-				(*it)->oor_count = 0;
+			} else if (e->oor_count != 0) {
+				e->oor_count = 0;
 			}
 
-			if (remove) {
-				if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
-					parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
-				}
+			if (!remove) {
+				return false;
+			}
 
-				if (m->IsClient()) {
-					m->CastToClient()->DecrementAggroCount();
-					m->CastToClient()->RemoveXTarget(hate_owner, true);
-				}
+			removed.push_back(m);
+			ReleaseEntry(e);
+			return true;
+		}
+	);
 
-				delete (*it);
-				it = list.erase(it);
-				continue;
-			}
+	for (auto m : removed) {
+		if (parse->HasQuestSub(hate_owner->GetNPCTypeID(), EVENT_HATE_LIST)) {
+			parse->EventNPC(EVENT_HATE_LIST, hate_owner->CastToNPC(), m, "0", 0);
+		}
+
+		if (m->IsClient()) {
+			m->CastToClient()->DecrementAggroCount();
+			m->CastToClient()->RemoveXTarget(hate_owner, true);
 		}
-		++it;
 	}
 }
 
@@ -904,9 +1028,18 @@ void HateList::DamageHateList(int64 damage, uint32 distance, EntityFilterType fi
 		return;
 	}
 
-	const auto& l = GetFilteredHateList(filter_type, distance);
-	for (const auto& h : l) {
-		auto e = h->entity_on_hatelist;
+	// damage can kill and remove entries, returning them to the pool, so only ids are kept across it
+	std::vector<uint16> ids;
+	for (const auto& h : GetFilteredHateList(filter_type, distance)) {
+		ids.push_back(h->entity_on_hatelist->GetID());
+	}
+
+	for (const auto id : ids) {
+		auto e = entity_list.GetMob(id);
+		if (!e || !IsEntOnHateList(e)) {
+			continue;
+		}
+
 		if (is_percentage) {
 			const auto damage_percentage = EQ::Clamp(damage, static_cast<int64>(1), static_cast<int64>(100));
 			const auto total_damage = (e->GetMaxHP() / 100) * damage_percentage;
@@ -917,9 +1050,10 @@ void HateList::DamageHateList(int64 damage, uint32 distance, EntityFilterType fi
 	}
 }
 
-std::list<struct_HateList*> HateList::GetFilteredHateList(EntityFilterType filter_type, uint32 distance)
+std::vector<struct_HateList*> HateList::GetFilteredHateList(EntityFilterType filter_type, uint32 distance)
 {
-	std::list<struct_HateList*> l;
+	std::vector<struct_HateList*> l;
+	l.reserve(list.size());
 	const auto squared_distance = (distance * distance);
 	for (auto h : list) {
 		auto e = h->entity_on_hatelist;
@@ -21,8 +21,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "../common/emu_constants.h"
 
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
 class Client;
 class Group;
+class HateList;
 class Mob;
 class Raid;
 struct ExtraAttackOptions;
@@ -34,6 +39,7 @@ struct struct_HateList {
 	bool   is_entity_frenzy;
 	int8   oor_count; // count on how long we've been out of range
 	uint32 last_modified; // we need to remove this if it gets higher than 10 mins
+	HateList *owner; // list the entry is pooled in, scripts edit entries in place
 };
 
 enum class HateListCountType {
@@ -48,6 +54,9 @@ public:
 	HateList();
 	~HateList();
 
+	HateList(const HateList &) = delete;
+	HateList &operator=(const HateList &) = delete;
+
 	Mob *GetClosestEntOnHateList(Mob *hater, bool skip_mezzed = false, EntityFilterType filter_type = EntityFilterType::All);
 	Mob *GetDamageTopOnHateList(Mob *hater); // didn't add 'skip_mezzed' due to calls being in ::Death()
 	Mob *GetMobWithMostHateOnList(Mob *center, Mob *skip = nullptr, bool skip_mezzed = false, EntityFilterType filter_type = EntityFilterType::All);
@@ -66,9 +75,9 @@ public:
 
 	int64 GetEntHateAmount(Mob *ent, bool in_damage = false);
 
-	std::list<struct_HateList *> &GetHateList() { return list; }
+	std::vector<struct_HateList *> &GetHateList() { return list; }
 
-	std::list<struct_HateList *> GetFilteredHateList(
+	std::vector<struct_HateList *> GetFilteredHateList(
 		EntityFilterType filter_type = EntityFilterType::All,
 		uint32 distance = 0
 	);
@@ -95,12 +104,28 @@ public:
 	void WipeHateList(bool npc_only = false);
 	void RemoveStaleEntries(int time_ms, float dist);
 
+	// called after a script changes an entry's mob or hate directly
+	void OnEntryModified(struct_HateList *entry);
 
 protected:
 	struct_HateList* Find(Mob* m);
 private:
-	std::list<struct_HateList *> list;
-	Mob                          *hate_owner;
+	struct_HateList *AllocateEntry();
+	void ReleaseEntry(struct_HateList *entry);
+	void EraseEntry(struct_HateList *entry);
+	void RebuildIndex();
+	void OnHateRaised(struct_HateList *entry);
+	void OnHateLowered(struct_HateList *entry);
+
+	// entries live in pooled chunks so pointers handed to scripts stay put,
+	// list keeps the insertion order and index gives Find a single lookup
+	std::vector<struct_HateList *>               list;
+	std::deque<struct_HateList>                  m_pool;
+	std::vector<struct_HateList *>               m_free;
+	std::unordered_map<Mob *, struct_HateList *> m_index;
+	struct_HateList                              *m_top       = nullptr;
+	bool                                         m_top_dirty = false;
+	Mob                                          *hate_owner;
 };
 
 #endif
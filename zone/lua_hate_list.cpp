@@ -15,6 +15,9 @@ Lua_Mob Lua_HateEntry::GetEnt() {
 void Lua_HateEntry::SetEnt(Lua_Mob e) {
 	Lua_Safe_Call_Void();
 	self->entity_on_hatelist = e;
+	if (self->owner) {
+		self->owner->OnEntryModified(self);
+	}
 }
 
 int64 Lua_HateEntry::GetDamage() {
@@ -35,6 +38,9 @@ int64 Lua_HateEntry::GetHate() {
 void Lua_HateEntry::SetHate(int64 value) {
 	Lua_Safe_Call_Void();
 	self->stored_hate_amount = value;
+	if (self->owner) {
+		self->owner->OnEntryModified(self);
+	}
 }
 
 bool Lua_HateEntry::GetFrenzy() {
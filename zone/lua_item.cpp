@@ -8,6 +8,16 @@
 Lua_Item::Lua_Item(uint32 item_id) {
 	const EQ::ItemData *t = database.GetItem(item_id);
 	SetLuaPtrData(t);
+
+	if (t) {
+		pin_ = database.PinItems();
+	}
+}
+
+Lua_Item::Lua_Item(const EQ::ItemData *d) : Lua_Ptr(d) {
+	if (d) {
+		pin_ = database.PinItems();
+	}
 }
 
 int Lua_Item::GetMinStatus() {
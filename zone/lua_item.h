@@ -3,6 +3,7 @@
 #ifdef LUA_EQEMU
 
 #include "lua_ptr.h"
+#include <memory>
 
 namespace EQ
 {
@@ -21,7 +22,7 @@ class Lua_Item : public Lua_Ptr<const EQ::ItemData>
 public:
 	Lua_Item(uint32 item_id);
 	Lua_Item() : Lua_Ptr(nullptr) { }
-	Lua_Item(const EQ::ItemData *d) : Lua_Ptr(d) { }
+	Lua_Item(const EQ::ItemData *d);
 	virtual ~Lua_Item() { }
 
 	operator const EQ::ItemData*() {
@@ -204,6 +205,11 @@ public:
 	const char *GetWornName();
 	const char *GetFocusName();
 	const char *GetScrollName();
+
+private:
+	// scripts can keep an item around indefinitely, this keeps the items segment it points into mapped
+	// through a shared memory reload
+	std::shared_ptr<const void> pin_;
 };
 
 #endif
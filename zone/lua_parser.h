@@ -42,7 +42,7 @@ public:
 		QuestEventID evt,
 		NPC* npc,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -50,21 +50,21 @@ public:
 		QuestEventID evt,
 		NPC* npc,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
 	virtual int EventPlayer(
 		QuestEventID evt,
 		Client *client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
 	virtual int EventGlobalPlayer(
 		QuestEventID evt,
 		Client *client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -73,7 +73,7 @@ public:
 		Client *client,
 		EQ::ItemInstance *item,
 		Mob *mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -82,14 +82,14 @@ public:
 		Mob* mob,
 		Client *client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
 	virtual int EventEncounter(
 		QuestEventID evt,
 		std::string encounter_name,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -97,7 +97,7 @@ public:
 		QuestEventID evt,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -105,7 +105,7 @@ public:
 		QuestEventID evt,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -113,7 +113,7 @@ public:
 		QuestEventID evt,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -121,7 +121,7 @@ public:
 		QuestEventID evt,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -162,14 +162,14 @@ public:
 		QuestEventID evt,
 		NPC* npc,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
 	virtual int DispatchEventPlayer(
 		QuestEventID evt,
 		Client *client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -178,7 +178,7 @@ public:
 		Client *client,
 		EQ::ItemInstance *item,
 		Mob *mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -187,7 +187,7 @@ public:
 		Mob* mob,
 		Client *client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -195,7 +195,7 @@ public:
 		QuestEventID evt,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -203,7 +203,7 @@ public:
 		QuestEventID evt,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -243,7 +243,7 @@ private:
 		QuestEventID evt,
 		NPC* npc,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers,
 		luabind::adl::object *l_func = nullptr
@@ -252,7 +252,7 @@ private:
 		std::string package_name,
 		QuestEventID evt,
 		Client *client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers,
 		luabind::adl::object *l_func = nullptr
@@ -263,7 +263,7 @@ private:
 		Client *client,
 		EQ::ItemInstance *item,
 		Mob *mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers,
 		luabind::adl::object *l_func = nullptr
@@ -274,7 +274,7 @@ private:
 		Mob* mob,
 		Client *client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers,
 		luabind::adl::object *l_func = nullptr
@@ -283,7 +283,7 @@ private:
 		std::string package_name,
 		QuestEventID evt,
 		std::string encounter_name,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -292,7 +292,7 @@ private:
 		QuestEventID evt,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers,
 		luabind::adl::object *l_func = nullptr
@@ -302,7 +302,7 @@ private:
 		QuestEventID evt,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers,
 		luabind::adl::object* l_func = nullptr
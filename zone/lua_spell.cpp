@@ -3,16 +3,24 @@
 #include <luabind/luabind.hpp>
 
 #include "../common/spdat.h"
+#include "zonedb.h"
 #include "lua_spell.h"
 
 Lua_Spell::Lua_Spell(int id) {
 	if(IsValidSpell(id)) {
 		SetLuaPtrData(&spells[id]);
+		pin_ = database.PinSpells();
 	} else {
 		SetLuaPtrData(nullptr);
 	}
 }
 
+Lua_Spell::Lua_Spell(const SPDat_Spell_Struct *d) : Lua_Ptr(d) {
+	if (d) {
+		pin_ = database.PinSpells();
+	}
+}
+
 int Lua_Spell::GetID() {
 	Lua_Safe_Call_Int();
 	return self->id;
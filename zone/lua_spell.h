@@ -3,6 +3,7 @@
 #ifdef LUA_EQEMU
 
 #include "lua_ptr.h"
+#include <memory>
 
 struct SPDat_Spell_Struct;
 
@@ -18,7 +19,7 @@ class Lua_Spell : public Lua_Ptr<const SPDat_Spell_Struct>
 public:
 	Lua_Spell(int id);
 	Lua_Spell() : Lua_Ptr(nullptr) { }
-	Lua_Spell(const SPDat_Spell_Struct *d) : Lua_Ptr(d) { }
+	Lua_Spell(const SPDat_Spell_Struct *d);
 	virtual ~Lua_Spell() { }
 
 	operator const SPDat_Spell_Struct*() {
@@ -110,6 +111,10 @@ public:
 	float GetMinRange();
 	int GetDamageShieldType();
 	int GetRank();
+
+private:
+	// keeps the spells segment this points into mapped through a shared memory reload
+	std::shared_ptr<const void> pin_;
 };
 
 #endif
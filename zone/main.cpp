@@ -23,6 +23,7 @@
 
 #include "../common/global_define.h"
 #include "../common/timer.h"
+#include "../common/event/timing_wheel.h"
 #include "../common/eq_packet_structs.h"
 #include "../common/mutex.h"
 #include "../common/opcodemgr.h"
@@ -90,6 +91,7 @@ extern volatile bool is_zone_loaded;
 #include "../common/skill_caps.h"
 #include "zone_event_scheduler.h"
 #include "zone_cli.h"
+#include "zone_profiler.h"
 
 EntityList  entity_list;
 WorldServer worldserver;
@@ -298,6 +300,12 @@ int main(int argc, char **argv)
 		EQ::InitializeDynamicLookups();
 	}
 
+	ZoneProfiler::Instance().SetEnabled(RuleB(Zone, FrameProfilerEnabled));
+
+	if (RuleI(Zone, AsyncDatabaseConnections) > 0) {
+		database.StartAsyncPool(RuleI(Zone, AsyncDatabaseConnections));
+	}
+
 	// command handler (no sidecar or test commands)
 	if (ZoneCLI::RanConsoleCommand(argc, argv) && !(ZoneCLI::RanSidecarCommand(argc, argv) || ZoneCLI::RanTestCommand(argc, argv))) {
 		LogSys.EnableConsoleLogging();
@@ -540,6 +548,17 @@ int main(int argc, char **argv)
 		//Advance the timer to our current point in time
 		Timer::SetCurrentTime();
 
+		ZoneProfiler::Instance().BeginFrame();
+
+		// fire everything on the timing wheel that came due since the last frame
+		{
+			ZONE_PROFILE_SCOPE("timing_wheel");
+			EQ::TimingWheel::Instance().Advance(Timer::GetCurrentTime());
+		}
+
+		// applied before anything else runs this frame, so no raw item or spell pointer is held across it
+		worldserver.ProcessSharedMemoryReload();
+
 		/**
 		 * Calculate frame time
 		 */
@@ -569,6 +588,7 @@ int main(int argc, char **argv)
 			opts.daybreak_options.resend_delay_min    = RuleI(Network, ResendDelayMinMS);
 			opts.daybreak_options.resend_delay_max    = RuleI(Network, ResendDelayMaxMS);
 			opts.daybreak_options.outgoing_data_rate  = RuleR(Network, ClientDataRate);
+			opts.network_thread                       = RuleB(Network, ZoneNetworkThread);
 			eqsm      = std::make_unique<EQ::Net::EQStreamManager>(opts);
 			eqsf_open = true;
 
@@ -585,7 +605,10 @@ int main(int argc, char **argv)
 		}
 
 		//give the stream identifier a chance to do its work....
-		stream_identifier.Process();
+		{
+			ZONE_PROFILE_SCOPE("stream_identifier");
+			stream_identifier.Process();
+		}
 
 		//check the stream identifier for any now-identified streams
 		while ((eqsi = stream_identifier.PopIdentified())) {
@@ -617,25 +640,60 @@ int main(int argc, char **argv)
 
 		if (is_zone_loaded) {
 			{
-				entity_list.GroupProcess();
-				entity_list.DoorProcess();
-				entity_list.ObjectProcess();
-				entity_list.CorpseProcess();
-				entity_list.TrapProcess();
-				entity_list.RaidProcess();
-				entity_list.Process();
-				entity_list.MobProcess();
-				entity_list.BeaconProcess();
-				entity_list.EncounterProcess();
-				event_scheduler.Process(zone, &content_service);
+				{
+					ZONE_PROFILE_SCOPE("GroupProcess");
+					entity_list.GroupProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("DoorProcess");
+					entity_list.DoorProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("ObjectProcess");
+					entity_list.ObjectProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("CorpseProcess");
+					entity_list.CorpseProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("TrapProcess");
+					entity_list.TrapProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("RaidProcess");
+					entity_list.RaidProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("EntityProcess");
+					entity_list.Process();
+				}
+				{
+					ZONE_PROFILE_SCOPE("MobProcess");
+					entity_list.MobProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("BeaconProcess");
+					entity_list.BeaconProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("EncounterProcess");
+					entity_list.EncounterProcess();
+				}
+				{
+					ZONE_PROFILE_SCOPE("EventScheduler");
+					event_scheduler.Process(zone, &content_service);
+				}
 
 				if (zone) {
+					ZONE_PROFILE_SCOPE("ZoneProcess");
 					if (!zone->Process()) {
 						zone->Shutdown();
 					}
 				}
 
 				if (quest_timers.Check()) {
+					ZONE_PROFILE_SCOPE("QuestTimers");
 					quest_manager.Process();
 				}
 			}
@@ -644,11 +702,14 @@ int main(int argc, char **argv)
 		QServ->CheckForConnectState();
 
 		if (InterserverTimer.Check()) {
+			ZONE_PROFILE_SCOPE("Interserver");
 			InterserverTimer.Start();
 			database.ping();
 			content_db.ping();
 			entity_list.UpdateWho();
 		}
+
+		ZoneProfiler::Instance().EndFrame();
 	};
 
 	EQ::Timer process_timer(loop_fn);
@@ -676,6 +737,7 @@ int main(int argc, char **argv)
 	command_deinit();
 	bot_command_deinit();
 	safe_delete(parse);
+	database.StopAsyncPool();
 	LogInfo("Proper zone shutdown complete.");
 	LogSys.CloseFileLogs();
 
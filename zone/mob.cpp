@@ -3622,11 +3622,21 @@ void Mob::ShowBuffs(Client* c) {
 	);
 }
 
+void Mob::SetPosition(const float x, const float y, const float z)
+{
+	m_Position.x = x;
+	m_Position.y = y;
+	m_Position.z = z;
+
+	entity_list.UpdateMobGridPosition(this);
+}
+
 void Mob::GMMove(float x, float y, float z, float heading, bool save_guard_spot) {
 	m_Position.x = x;
 	m_Position.y = y;
 	m_Position.z = z;
 	SetHeading(heading);
+	entity_list.UpdateMobGridPosition(this);
 	mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 
 	if (IsNPC() && save_guard_spot) {
@@ -3639,6 +3649,7 @@ void Mob::GMMove(const glm::vec4 &position, bool save_guard_spot) {
 	m_Position.y = position.y;
 	m_Position.z = position.z;
 	SetHeading(position.w);
+	entity_list.UpdateMobGridPosition(this);
 	mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 
 	if (IsNPC() && save_guard_spot) {
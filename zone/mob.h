@@ -29,6 +29,7 @@
 #include "aa.h"
 #include "../common/light_source.h"
 #include "../common/emu_constants.h"
+#include "../common/event/timing_wheel.h"
 #include "combat_record.h"
 #include "event_codes.h"
 
@@ -207,6 +208,16 @@ public:
 	Timer                              m_see_close_mobs_timer;
 	Timer                              m_mob_check_moving_timer;
 
+	// bookkeeping for EntityList's MobSpatialGrid
+	uint64                             m_grid_cell = 0;
+	uint32                             m_grid_slot = 0;
+	bool                               m_in_grid   = false;
+	bool                               m_grid_wide = false;
+
+	// bookkeeping for EntityList's AILodScheduler, the closest tier a client stamped this mob with and when
+	uint32                             m_ai_lod_frame = 0;
+	uint8                              m_ai_lod_tier  = 0;
+
 	// Bot attack flag
 	Timer bot_attack_flag_timer;
 
@@ -674,7 +685,7 @@ public:
 	inline bool IsZoneController() const { return npctype_id == ZONE_CONTROLLER_NPC_ID; }
 	void SetNPCTypeID(uint32 npctypeid) { npctype_id = npctypeid; }
 	inline const glm::vec4& GetPosition() const { return m_Position; }
-	inline void SetPosition(const float x, const float y, const float z) { m_Position.x = x; m_Position.y = y; m_Position.z = z; }
+	void SetPosition(const float x, const float y, const float z);
 	inline const float GetX() const { return m_Position.x; }
 	inline const float GetY() const { return m_Position.y; }
 	inline const float GetZ() const { return m_Position.z; }
@@ -792,7 +803,7 @@ public:
 	void ClearFeignMemory();
 	bool IsOnFeignMemory(Mob *attacker) const;
 	void PrintHateListToClient(Client *who) { hate_list.PrintHateListToClient(who); }
-	std::list<struct_HateList*>& GetHateList() { return hate_list.GetHateList(); }
+	std::vector<struct_HateList*>& GetHateList() { return hate_list.GetHateList(); }
 	bool CheckLosFN(Mob* other);
 	bool CheckLosFN(float posX, float posY, float posZ, float mobSize);
 	static bool CheckLosFN(glm::vec3 posWatcher, float sizeWatcher, glm::vec3 posTarget, float sizeTarget);
@@ -805,7 +816,7 @@ public:
 	inline bool CheckLastLosState() const { return last_los_check; }
 	std::string GetMobDescription();
 
-	std::list<struct_HateList*> GetFilteredHateList(
+	std::vector<struct_HateList*> GetFilteredHateList(
 		EntityFilterType filter_type = EntityFilterType::All,
 		uint32 distance = 0
 	) {
@@ -1695,8 +1706,8 @@ protected:
 	bool always_aggro;
 	int16 slow_mitigation; // Allows for a slow mitigation (100 = 100%, 50% = 50%)
 	Timer hp_regen_per_second_timer;
-	Timer tic_timer;
-	Timer mana_timer;
+	EQ::WheelTimer tic_timer;
+	EQ::WheelTimer mana_timer;
 	int32 dw_same_delay;
 
 	Timer focusproclimit_timer[MAX_FOCUS_PROC_LIMIT_TIMERS];	//SPA 511
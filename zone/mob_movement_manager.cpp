@@ -11,6 +11,7 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <unordered_map>
 #include <stdlib.h>
 
 extern double frame_time;
@@ -643,6 +644,16 @@ struct NavigateTo {
 struct MobMovementEntry {
 	std::deque<std::unique_ptr<IMovementCommand>> Commands;
 	NavigateTo                                    NavTo;
+	uint64                                        PendingPathTicket = 0;
+};
+
+struct PendingPath {
+	Mob             *mob;
+	float           x;
+	float           y;
+	float           z;
+	MobMovementMode mode;
+	bool            underwater;
 };
 
 void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
@@ -664,9 +675,11 @@ void AdjustRoute(std::list<IPathfinder::IPathNode> &nodes, Mob *who)
 }
 
 struct MobMovementManager::Implementation {
-	std::map<Mob *, MobMovementEntry> Entries;
-	std::vector<Client *>             Clients;
-	MovementStats                     Stats;
+	std::map<Mob *, MobMovementEntry>         Entries;
+	std::vector<Client *>                     Clients;
+	MovementStats                             Stats;
+	std::unordered_map<uint64, PendingPath>   PendingPaths;
+	std::vector<IPathfinder::AsyncPathResult> CompletedPaths;
 };
 
 MobMovementManager::MobMovementManager()
@@ -680,6 +693,8 @@ MobMovementManager::~MobMovementManager()
 
 void MobMovementManager::Process()
 {
+	ProcessCompletedPaths();
+
 	for (auto &iter : _impl->Entries) {
 		auto &ent      = iter.second;
 		auto &commands = ent.Commands;
@@ -704,7 +719,11 @@ void MobMovementManager::AddMob(Mob *mob)
 
 void MobMovementManager::RemoveMob(Mob *mob)
 {
-	_impl->Entries.erase(mob);
+	auto iter = _impl->Entries.find(mob);
+	if (iter != _impl->Entries.end()) {
+		CancelPendingPath(iter->second);
+		_impl->Entries.erase(iter);
+	}
 }
 
 void MobMovementManager::AddClient(Client *client)
@@ -743,6 +762,7 @@ void MobMovementManager::Teleport(Mob *who, float x, float y, float z, float hea
 	auto &ent = (*iter);
 
 	ent.second.Commands.clear();
+	CancelPendingPath(ent.second);
 
 	PushTeleportTo(ent.second, x, y, z, heading);
 }
@@ -794,6 +814,8 @@ void MobMovementManager::StopNavigation(Mob *who)
 	nav.navigate_to_z       = 0.0;
 	nav.navigate_to_heading = 0.0;
 
+	CancelPendingPath(ent.second);
+
 	if (true == ent.second.Commands.empty()) {
 		PushStopMoving(ent.second);
 		return;
@@ -1078,6 +1100,10 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 	opts.offset      = who->GetZOffset();
 	opts.flags       = PathingNotDisabled ^ PathingZoneLine;
 
+	if (RequestPathAsync(who, x, y, z, mode, opts, false)) {
+		return;
+	}
+
 	//This is probably pointless since the nav mesh tool currently sets zonelines to disabled anyway
 	auto partial = false;
 	auto stuck   = false;
@@ -1089,6 +1115,11 @@ void MobMovementManager::UpdatePathGround(Mob *who, float x, float y, float z, M
 		opts
 	);
 
+	ApplyPathGround(who, x, y, z, mode, route, stuck);
+}
+
+void MobMovementManager::ApplyPathGround(Mob *who, float x, float y, float z, MobMovementMode mode, IPathfinder::IPath &route, bool stuck)
+{
 	auto eiter = _impl->Entries.find(who);
 	auto &ent  = (*eiter);
 
@@ -1219,6 +1250,10 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 	opts.offset      = who->GetZOffset();
 	opts.flags       = PathingNotDisabled ^ PathingZoneLine;
 
+	if (RequestPathAsync(who, x, y, z, movement_mode, opts, true)) {
+		return;
+	}
+
 	auto partial = false;
 	auto stuck   = false;
 	auto route   = zone->pathing->FindPath(
@@ -1229,6 +1264,14 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 		opts
 	);
 
+	ApplyPathUnderwater(who, x, y, z, movement_mode, route, stuck);
+}
+
+void MobMovementManager::ApplyPathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode, IPathfinder::IPath &route, bool stuck)
+{
+	auto eiter = _impl->Entries.find(who);
+	auto &ent  = (*eiter);
+
 	if (route.size() == 0) {
 		HandleStuckBehavior(who, x, y, z, movement_mode);
 		return;
@@ -1310,6 +1353,87 @@ void MobMovementManager::UpdatePathUnderwater(Mob *who, float x, float y, float
 	}
 }
 
+bool MobMovementManager::RequestPathAsync(
+	Mob *who,
+	float x,
+	float y,
+	float z,
+	MobMovementMode mode,
+	const PathfinderOptions &opts,
+	bool underwater
+)
+{
+	auto ticket = zone->pathing->FindPathAsync(glm::vec3(who->GetX(), who->GetY(), who->GetZ()), glm::vec3(x, y, z), opts);
+	if (ticket == 0) {
+		return false;
+	}
+
+	auto eiter = _impl->Entries.find(who);
+	auto &ent  = (*eiter);
+
+	CancelPendingPath(ent.second);
+
+	ent.second.PendingPathTicket = ticket;
+	_impl->PendingPaths[ticket]  = PendingPath{who, x, y, z, mode, underwater};
+
+	// head straight for the target until a worker hands the route back
+	if (underwater) {
+		PushSwimTo(ent.second, x, y, z, mode);
+	}
+	else {
+		PushMoveTo(ent.second, x, y, z, mode);
+	}
+
+	return true;
+}
+
+void MobMovementManager::CancelPendingPath(MobMovementEntry &ent)
+{
+	if (ent.PendingPathTicket == 0) {
+		return;
+	}
+
+	// the worker still finishes the query, its result is dropped when collected
+	_impl->PendingPaths.erase(ent.PendingPathTicket);
+	ent.PendingPathTicket = 0;
+}
+
+void MobMovementManager::ProcessCompletedPaths()
+{
+	if (!zone || !zone->pathing) {
+		return;
+	}
+
+	zone->pathing->CollectAsyncPaths(_impl->CompletedPaths);
+
+	for (auto &result : _impl->CompletedPaths) {
+		auto pending = _impl->PendingPaths.find(result.ticket);
+		if (pending == _impl->PendingPaths.end()) {
+			continue;
+		}
+
+		auto p = pending->second;
+		_impl->PendingPaths.erase(pending);
+
+		auto eiter = _impl->Entries.find(p.mob);
+		if (eiter == _impl->Entries.end()) {
+			continue;
+		}
+
+		eiter->second.PendingPathTicket = 0;
+		eiter->second.Commands.clear();
+
+		if (p.underwater) {
+			ApplyPathUnderwater(p.mob, p.x, p.y, p.z, p.mode, result.route, result.stuck);
+		}
+		else {
+			ApplyPathGround(p.mob, p.x, p.y, p.z, p.mode, result.route, result.stuck);
+		}
+	}
+
+	_impl->CompletedPaths.clear();
+}
+
 void MobMovementManager::UpdatePathBoat(Mob *who, float x, float y, float z, MobMovementMode mode)
 {
 	auto eiter = _impl->Entries.find(who);
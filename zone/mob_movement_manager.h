@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include "pathfinder_interface.h"
 
 class Mob;
 class Client;
@@ -82,6 +83,11 @@ private:
 	void UpdatePathGround(Mob *who, float x, float y, float z, MobMovementMode mode);
 	void UpdatePathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode);
 	void UpdatePathBoat(Mob *who, float x, float y, float z, MobMovementMode mode);
+	void ApplyPathGround(Mob *who, float x, float y, float z, MobMovementMode mode, IPathfinder::IPath &route, bool stuck);
+	void ApplyPathUnderwater(Mob *who, float x, float y, float z, MobMovementMode movement_mode, IPathfinder::IPath &route, bool stuck);
+	bool RequestPathAsync(Mob *who, float x, float y, float z, MobMovementMode mode, const PathfinderOptions &opts, bool underwater);
+	void CancelPendingPath(MobMovementEntry &ent);
+	void ProcessCompletedPaths();
 	void PushTeleportTo(MobMovementEntry &ent, float x, float y, float z, float heading);
 	void PushMoveTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode);
 	void PushSwimTo(MobMovementEntry &ent, float x, float y, float z, MobMovementMode mob_movement_mode);
@@ -0,0 +1,132 @@
+#include "mob_spatial_grid.h"
+#include "mob.h"
+
+void MobSpatialGrid::Reset(float cell_size)
+{
+	std::vector<Mob *> mobs;
+	mobs.reserve(m_mob_count);
+
+	for (auto &c : m_cells) {
+		mobs.insert(mobs.end(), c.second.begin(), c.second.end());
+	}
+
+	Clear();
+
+	m_cell_size         = std::max(cell_size, 1.0f);
+	m_inverse_cell_size = 1.0f / m_cell_size;
+
+	for (Mob *mob : mobs) {
+		Add(mob);
+	}
+}
+
+void MobSpatialGrid::Clear()
+{
+	for (auto &c : m_cells) {
+		for (Mob *mob : c.second) {
+			mob->m_in_grid   = false;
+			mob->m_grid_wide = false;
+		}
+	}
+
+	m_cells.clear();
+	m_wide_mobs.clear();
+	m_mob_count = 0;
+}
+
+void MobSpatialGrid::Add(Mob *mob)
+{
+	if (!mob || mob->m_in_grid) {
+		return;
+	}
+
+	InsertIntoCell(mob, CellKeyFor(mob));
+	mob->m_in_grid = true;
+	++m_mob_count;
+
+	UpdateWide(mob);
+}
+
+void MobSpatialGrid::Remove(Mob *mob)
+{
+	if (!mob || !mob->m_in_grid) {
+		return;
+	}
+
+	RemoveFromCell(mob);
+	mob->m_in_grid = false;
+	--m_mob_count;
+
+	if (mob->m_grid_wide) {
+		m_wide_mobs.erase(mob);
+		mob->m_grid_wide = false;
+	}
+}
+
+void MobSpatialGrid::Update(Mob *mob)
+{
+	if (!mob || !mob->m_in_grid) {
+		return;
+	}
+
+	const uint64 key = CellKeyFor(mob);
+	if (key != mob->m_grid_cell) {
+		RemoveFromCell(mob);
+		InsertIntoCell(mob, key);
+	}
+
+	UpdateWide(mob);
+}
+
+uint64 MobSpatialGrid::CellKeyFor(const Mob *mob) const
+{
+	return CellKey(ToCell(mob->GetX()), ToCell(mob->GetY()));
+}
+
+void MobSpatialGrid::InsertIntoCell(Mob *mob, uint64 key)
+{
+	auto &cell = m_cells[key];
+
+	mob->m_grid_cell = key;
+	mob->m_grid_slot = static_cast<uint32>(cell.size());
+	cell.push_back(mob);
+}
+
+void MobSpatialGrid::RemoveFromCell(Mob *mob)
+{
+	auto c = m_cells.find(mob->m_grid_cell);
+	if (c == m_cells.end()) {
+		return;
+	}
+
+	auto &cell = c->second;
+
+	// swap and pop, the mob moved into our slot takes over the slot index
+	const uint32 slot = mob->m_grid_slot;
+	if (slot < cell.size() && cell[slot] == mob) {
+		cell[slot]              = cell.back();
+		cell[slot]->m_grid_slot = slot;
+		cell.pop_back();
+	}
+
+	if (cell.empty()) {
+		m_cells.erase(c);
+	}
+}
+
+void MobSpatialGrid::UpdateWide(Mob *mob)
+{
+	const bool wide = mob->GetAggroRange() >= m_cell_size;
+	if (wide == mob->m_grid_wide) {
+		return;
+	}
+
+	if (wide) {
+		m_wide_mobs.insert(mob);
+	}
+	else {
+		m_wide_mobs.erase(mob);
+	}
+
+	mob->m_grid_wide = wide;
+}
@@ -0,0 +1,110 @@
+#ifndef EQEMU_MOB_SPATIAL_GRID_H
+#define EQEMU_MOB_SPATIAL_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/vec3.hpp>
+#include "../common/types.h"
+
+class Mob;
+
+// Uniform 2D hash grid over mob positions, owned by EntityList
+//
+// Cells are keyed by the (x, y) cell coordinate and hold a flat vector of mobs; each mob remembers
+// its own cell and slot so moves and removals are O(1). Range queries only visit the cells that
+// overlap the query square, callers are still responsible for the exact distance check
+//
+// Mobs whose aggro range reaches at least the cell size are additionally tracked in a "wide" set,
+// close list scans always consider them regardless of distance
+class MobSpatialGrid {
+public:
+	void Reset(float cell_size);
+	void Clear();
+
+	void Add(Mob *mob);
+	void Remove(Mob *mob);
+	void Update(Mob *mob);
+
+	inline float GetCellSize() const { return m_cell_size; }
+	inline size_t GetCellCount() const { return m_cells.size(); }
+	inline size_t GetMobCount() const { return m_mob_count; }
+
+	template<typename Callback>
+	void ForEachInRange(const glm::vec3 &position, float range, Callback &&callback) const
+	{
+		const int32 min_x = ToCell(position.x - range);
+		const int32 max_x = ToCell(position.x + range);
+		const int32 min_y = ToCell(position.y - range);
+		const int32 max_y = ToCell(position.y + range);
+
+		const uint64 span = static_cast<uint64>(max_x - min_x + 1) * static_cast<uint64>(max_y - min_y + 1);
+
+		// a query covering more cells than exist is cheaper as a walk of the occupied cells
+		if (span >= m_cells.size()) {
+			for (const auto &c : m_cells) {
+				const int32 cx = static_cast<int32>(c.first >> 32);
+				const int32 cy = static_cast<int32>(c.first & 0xFFFFFFFF);
+				if (cx < min_x || cx > max_x || cy < min_y || cy > max_y) {
+					continue;
+				}
+
+				for (Mob *mob : c.second) {
+					callback(mob);
+				}
+			}
+
+			return;
+		}
+
+		for (int32 x = min_x; x <= max_x; ++x) {
+			for (int32 y = min_y; y <= max_y; ++y) {
+				auto c = m_cells.find(CellKey(x, y));
+				if (c == m_cells.end()) {
+					continue;
+				}
+
+				for (Mob *mob : c->second) {
+					callback(mob);
+				}
+			}
+		}
+	}
+
+	template<typename Callback>
+	void ForEachWide(Callback &&callback) const
+	{
+		for (Mob *mob : m_wide_mobs) {
+			callback(mob);
+		}
+	}
+
+private:
+	// keep cell coordinates well inside int32 so bad positions can't overflow the key math
+	static constexpr float MAX_CELL_COORD = 1000000.0f;
+
+	inline int32 ToCell(float v) const
+	{
+		return static_cast<int32>(std::clamp(std::floor(v * m_inverse_cell_size), -MAX_CELL_COORD, MAX_CELL_COORD));
+	}
+
+	static inline uint64 CellKey(int32 x, int32 y)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y);
+	}
+
+	uint64 CellKeyFor(const Mob *mob) const;
+	void InsertIntoCell(Mob *mob, uint64 key);
+	void RemoveFromCell(Mob *mob);
+	void UpdateWide(Mob *mob);
+
+	float                                         m_cell_size         = 600.0f;
+	float                                         m_inverse_cell_size = 1.0f / 600.0f;
+	size_t                                        m_mob_count         = 0;
+	std::unordered_map<uint64, std::vector<Mob *>> m_cells;
+	std::unordered_set<Mob *>                     m_wide_mobs;
+};
+
+#endif //EQEMU_MOB_SPATIAL_GRID_H
@@ -46,6 +46,7 @@
 #include "quest_parser_collection.h"
 #include "water_map.h"
 #include "npc_scale_manager.h"
+#include "zone_profiler.h"
 
 #include "bot.h"
 #include "../common/skill_caps.h"
@@ -838,7 +839,21 @@ bool NPC::Process()
 		ClearBotAttackFlags();
 	}
 
-	AI_Process();
+	if (ZoneProfiler::Instance().IsEnabled()) {
+		ZONE_PROFILE_SCOPE("npc_ai");
+
+		const auto start = std::chrono::steady_clock::now();
+		AI_Process();
+
+		ZoneProfiler::Instance().RecordNpc(
+			GetNPCTypeID(),
+			GetCleanName(),
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()
+		);
+	}
+	else {
+		AI_Process();
+	}
 
 	return true;
 }
@@ -93,3 +93,25 @@ bool OrientedBoundingBox::ContainsPoint(const glm::vec3 &p) const {
 	
 	return false;
 }
+
+// axis aligned bounds of the box in world space, built from its eight transformed corners
+void OrientedBoundingBox::GetWorldBounds(glm::vec3 &out_min, glm::vec3 &out_max) const {
+	for (int i = 0; i < 8; ++i) {
+		glm::vec4 corner(
+			(i & 1) ? max_x : min_x,
+			(i & 2) ? max_y : min_y,
+			(i & 4) ? max_z : min_z,
+			1.0f
+		);
+
+		glm::vec3 world = glm::vec3(transformation * corner);
+		if (i == 0) {
+			out_min = world;
+			out_max = world;
+			continue;
+		}
+
+		out_min = glm::min(out_min, world);
+		out_max = glm::max(out_max, world);
+	}
+}
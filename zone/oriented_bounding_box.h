@@ -12,6 +12,7 @@ public:
 	~OrientedBoundingBox() = default;
 
 	bool ContainsPoint(const glm::vec3 &p) const;
+	void GetWorldBounds(glm::vec3 &out_min, glm::vec3 &out_max) const;
 private:
 	float min_x, max_x;
 	float min_y, max_y;
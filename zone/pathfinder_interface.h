@@ -2,6 +2,7 @@
 
 #include "map.h"
 #include <list>
+#include <vector>
 
 class Client;
 class Seperator;
@@ -70,6 +71,14 @@ public:
 
 	typedef std::list<IPathNode> IPath;
 
+	struct AsyncPathResult
+	{
+		uint64 ticket;
+		IPath  route;
+		bool   partial;
+		bool   stuck;
+	};
+
 	IPathfinder() { }
 	virtual ~IPathfinder() { }
 
@@ -77,6 +86,12 @@ public:
 	virtual IPath FindPath(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions& opts) = 0;
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start, int flags = PathingNotDisabled) = 0;
 	virtual void DebugCommand(Client *c, const Seperator *sep) = 0;
+	virtual void ClearRouteCache() { }
+
+	// queues a FindPath onto a worker thread, a ticket of 0 means the caller has to path synchronously
+	virtual uint64 FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions &opts) { return 0; }
+	// hands back every async path finished since the last call
+	virtual void CollectAsyncPaths(std::vector<AsyncPathResult> &results) { results.clear(); }
 
 	static IPathfinder *Load(const std::string &zone);
 };
@@ -1,7 +1,13 @@
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <stdio.h>
+#include <thread>
 #include <vector>
 #include "pathfinder_nav_mesh.h"
+#include "pathfinder_route_cache.h"
 #include <DetourCommon.h>
 #include <DetourNavMeshQuery.h>
 
@@ -12,22 +18,147 @@
 
 extern Zone *zone;
 
+struct AsyncPathRequest
+{
+	uint64                                ticket;
+	glm::vec3                             start;
+	glm::vec3                             end;
+	PathfinderOptions                     opts;
+	std::chrono::steady_clock::time_point queued_at;
+};
+
+struct AsyncPathStats
+{
+	uint64 submitted        = 0;
+	uint64 completed        = 0;
+	uint64 rejected         = 0;
+	uint64 peak_depth       = 0;
+	uint64 total_latency_us = 0;
+	uint64 max_latency_us   = 0;
+};
+
+struct RouteCacheLookup
+{
+	bool                      enabled    = false;
+	uint64                    generation = 0;
+	PathfinderRouteCache::Key key;
+};
+
 struct PathfinderNavmesh::Implementation
 {
 	dtNavMesh *nav_mesh;
 	dtNavMeshQuery *query;
+
+	// the route cache is shared between the zone thread and the async workers
+	std::mutex           route_cache_lock;
+	PathfinderRouteCache route_cache;
+	uint64               route_cache_generation = 0;
+
+	std::vector<std::thread>                  async_workers;
+	std::mutex                                async_lock;
+	std::condition_variable                   async_cv;
+	std::deque<AsyncPathRequest>              async_queue;
+	std::vector<IPathfinder::AsyncPathResult> async_completed;
+	size_t                                    async_outstanding = 0;
+	uint64                                    async_next_ticket = 1;
+	bool                                      async_running     = false;
+	AsyncPathStats                            async_stats;
+
+	bool FindCachedRoute(
+		RouteCacheLookup &lookup,
+		uint64 start_ref,
+		uint64 end_ref,
+		const glm::vec3 &start,
+		const glm::vec3 &end,
+		uint64 options,
+		IPathfinder::IPath &route,
+		bool &partial,
+		bool &stuck
+	)
+	{
+		std::lock_guard<std::mutex> lock(route_cache_lock);
+
+		route_cache.SetQuantization(RuleR(Pathing, RouteCacheQuantization));
+		route_cache.SetCapacity(static_cast<size_t>(std::max(RuleI(Pathing, RouteCacheSize), 0)));
+
+		lookup.enabled = route_cache.Enabled();
+		if (!lookup.enabled) {
+			return false;
+		}
+
+		lookup.key        = route_cache.MakeKey(start_ref, end_ref, start, end, options);
+		lookup.generation = route_cache_generation;
+
+		return route_cache.Find(lookup.key, route, partial, stuck);
+	}
+
+	void CacheRoute(const RouteCacheLookup &lookup, const IPathfinder::IPath &route, bool partial, bool stuck)
+	{
+		if (!lookup.enabled || route.empty()) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(route_cache_lock);
+
+		// a door moved while this route was being built, it may already be stale
+		if (lookup.generation != route_cache_generation) {
+			return;
+		}
+
+		route_cache.Insert(lookup.key, route, partial, stuck);
+	}
+
+	void ClearRouteCache()
+	{
+		std::lock_guard<std::mutex> lock(route_cache_lock);
+
+		route_cache.Clear();
+		route_cache_generation++;
+	}
 };
 
+// folds everything besides the endpoints that can change the shape of a route into the cache key
+static uint64 RouteOptionsSignature(uint32 kind, int flags, const PathfinderOptions *opts)
+{
+	uint64 h = 1469598103934665603ULL;
+
+	auto mix = [&h](const void *data, size_t len) {
+		auto p = static_cast<const uint8 *>(data);
+		for (size_t i = 0; i < len; ++i) {
+			h ^= p[i];
+			h *= 1099511628211ULL;
+		}
+	};
+
+	mix(&kind, sizeof(kind));
+	mix(&flags, sizeof(flags));
+
+	if (opts) {
+		uint8 smooth = opts->smooth_path ? 1 : 0;
+		mix(&smooth, sizeof(smooth));
+		mix(&opts->step_size, sizeof(opts->step_size));
+		mix(&opts->offset, sizeof(opts->offset));
+		mix(opts->flag_cost, sizeof(opts->flag_cost));
+	}
+
+	return h;
+}
+
 PathfinderNavmesh::PathfinderNavmesh(const std::string &path)
 {
 	m_impl = std::make_unique<Implementation>();
 	m_impl->nav_mesh = nullptr;
 	m_impl->query = nullptr;
 	Load(path);
+
+	if (m_impl->nav_mesh) {
+		StartAsyncWorkers(RuleI(Pathing, AsyncWorkerThreads));
+	}
 }
 
 PathfinderNavmesh::~PathfinderNavmesh()
 {
+	StopAsyncWorkers();
 	Clear();
 }
 
@@ -71,6 +202,34 @@ IPathfinder::IPath PathfinderNavmesh::FindRoute(const glm::vec3 &start, const gl
 		return IPath();
 	}
 
+	RouteCacheLookup lookup;
+	IPath            route;
+	if (m_impl->FindCachedRoute(lookup, start_ref, end_ref, start, end, RouteOptionsSignature(0, flags, nullptr), route, partial, stuck)) {
+		return route;
+	}
+
+	bool built_stuck = false;
+	route = BuildRoute(start_ref, end_ref, current_location, dest_location, end, filter, partial, built_stuck);
+	if (built_stuck) {
+		stuck = true;
+	}
+
+	m_impl->CacheRoute(lookup, route, partial, built_stuck);
+
+	return route;
+}
+
+IPathfinder::IPath PathfinderNavmesh::BuildRoute(
+	dtPolyRef start_ref,
+	dtPolyRef end_ref,
+	const glm::vec3 &current_location,
+	const glm::vec3 &dest_location,
+	const glm::vec3 &end,
+	const dtQueryFilter &filter,
+	bool &partial,
+	bool &stuck
+)
+{
 	int npoly = 0;
 	dtPolyRef path[1024] = { 0 };
 	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, 1024);
@@ -141,7 +300,19 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		m_impl->query = dtAllocNavMeshQuery();
 	}
 
-	m_impl->query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
+	return FindPathWithQuery(m_impl->query, start, end, partial, stuck, opts);
+}
+
+IPathfinder::IPath PathfinderNavmesh::FindPathWithQuery(
+	dtNavMeshQuery *query,
+	const glm::vec3 &start,
+	const glm::vec3 &end,
+	bool &partial,
+	bool &stuck,
+	const PathfinderOptions &opts
+)
+{
+	query->init(m_impl->nav_mesh, RuleI(Pathing, MaxNavmeshNodes));
 	glm::vec3 current_location(start.x, start.z, start.y);
 	glm::vec3 dest_location(end.x, end.z, end.y);
 
@@ -158,26 +329,56 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 	filter.setAreaCost(9, opts.flag_cost[8]); //Portal
 	filter.setAreaCost(10, opts.flag_cost[9]); //Prefer
 
-	static const int max_polys = 256;
 	dtPolyRef start_ref;
 	dtPolyRef end_ref;
 	glm::vec3 ext(10.0f, 200.0f, 10.0f);
 
-	m_impl->query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
-	m_impl->query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
+	query->findNearestPoly(&current_location[0], &ext[0], &filter, &start_ref, 0);
+	query->findNearestPoly(&dest_location[0], &ext[0], &filter, &end_ref, 0);
 
 	if (!start_ref || !end_ref) {
 		return IPath();
 	}
 
+	RouteCacheLookup lookup;
+	IPath            route;
+	if (m_impl->FindCachedRoute(lookup, start_ref, end_ref, start, end, RouteOptionsSignature(1, opts.flags, &opts), route, partial, stuck)) {
+		return route;
+	}
+
+	bool built_stuck = false;
+	route = BuildPath(query, start_ref, end_ref, current_location, dest_location, filter, opts, partial, built_stuck);
+	if (built_stuck) {
+		stuck = true;
+	}
+
+	m_impl->CacheRoute(lookup, route, partial, built_stuck);
+
+	return route;
+}
+
+IPathfinder::IPath PathfinderNavmesh::BuildPath(
+	dtNavMeshQuery *query,
+	dtPolyRef start_ref,
+	dtPolyRef end_ref,
+	const glm::vec3 &current_location,
+	const glm::vec3 &dest_location,
+	const dtQueryFilter &filter,
+	const PathfinderOptions &opts,
+	bool &partial,
+	bool &stuck
+)
+{
+	static const int max_polys = 256;
+
 	int npoly = 0;
 	dtPolyRef path[max_polys] = { 0 };
-	auto status = m_impl->query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_polys);
+	auto status = query->findPath(start_ref, end_ref, &current_location[0], &dest_location[0], &filter, path, &npoly, max_polys);
 
 	if (npoly) {
 		glm::vec3 epos = dest_location;
 		if (path[npoly - 1] != end_ref) {
-			m_impl->query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
+			query->closestPointOnPoly(path[npoly - 1], &dest_location[0], &epos[0], 0);
 			partial = true;
 
 			auto dist = DistanceSquared(epos, current_location);
@@ -191,7 +392,7 @@ IPathfinder::IPath PathfinderNavmesh::FindPath(const glm::vec3 &start, const glm
 		unsigned char straight_path_flags[max_polys];
 		dtPolyRef straight_path_polys[max_polys];
 
-		auto status = m_impl->query->findStraightPath(&current_location[0], &epos[0], path, npoly,
+		auto status = query->findStraightPath(&current_location[0], &epos[0], path, npoly,
 			(float*)&straight_path[0], straight_path_flags,
 			straight_path_polys, &n_straight_polys, 2048, DT_STRAIGHTPATH_AREA_CROSSINGS | DT_STRAIGHTPATH_ALL_CROSSINGS);
 
@@ -354,6 +555,79 @@ void PathfinderNavmesh::DebugCommand(Client *c, const Seperator *sep)
 	if (sep->arg[1][0] == '\0' || !strcasecmp(sep->arg[1], "help"))
 	{
 		c->Message(Chat::White, "#path show: Plots a path from the user to their target.");
+		c->Message(Chat::White, "#path cache [clear]: Shows route cache statistics, optionally clearing the cache.");
+		c->Message(Chat::White, "#path async: Shows async pathfinding worker queue depth and latency.");
+		return;
+	}
+
+	if (!strcasecmp(sep->arg[1], "async"))
+	{
+		size_t         workers;
+		size_t         depth;
+		size_t         outstanding;
+		AsyncPathStats stats;
+
+		{
+			std::lock_guard<std::mutex> lock(m_impl->async_lock);
+			workers     = m_impl->async_workers.size();
+			depth       = m_impl->async_queue.size();
+			outstanding = m_impl->async_outstanding;
+			stats       = m_impl->async_stats;
+		}
+
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"Async Pathing | Workers [{}] Queue Depth [{}] Peak Depth [{}] Outstanding [{}/{}]",
+				workers,
+				depth,
+				stats.peak_depth,
+				outstanding,
+				RuleI(Pathing, AsyncMaxOutstandingRequests)
+			).c_str()
+		);
+
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"Async Pathing | Submitted [{}] Completed [{}] Rejected [{}] Avg Latency [{:.2f}ms] Max Latency [{:.2f}ms]",
+				stats.submitted,
+				stats.completed,
+				stats.rejected,
+				stats.completed ? (static_cast<double>(stats.total_latency_us) / stats.completed) / 1000.0 : 0.0,
+				static_cast<double>(stats.max_latency_us) / 1000.0
+			).c_str()
+		);
+		return;
+	}
+
+	if (!strcasecmp(sep->arg[1], "cache"))
+	{
+		if (!strcasecmp(sep->arg[2], "clear")) {
+			m_impl->ClearRouteCache();
+			c->Message(Chat::White, "Route cache cleared.");
+		}
+
+		std::lock_guard<std::mutex> lock(m_impl->route_cache_lock);
+
+		auto &cache = m_impl->route_cache;
+
+		const auto &stats   = cache.GetStats();
+		const uint64 lookups = stats.hits + stats.misses;
+
+		c->Message(
+			Chat::White,
+			fmt::format(
+				"Route Cache | Entries [{}/{}] Hits [{}] Misses [{}] Hit Rate [{:.2f}%] Evictions [{}] Invalidations [{}]",
+				cache.Size(),
+				cache.Capacity(),
+				stats.hits,
+				stats.misses,
+				lookups ? (static_cast<double>(stats.hits) / lookups) * 100.0 : 0.0,
+				stats.evictions,
+				stats.invalidations
+			).c_str()
+		);
 		return;
 	}
 
@@ -371,8 +645,147 @@ void PathfinderNavmesh::DebugCommand(Client *c, const Seperator *sep)
 	}
 }
 
+void PathfinderNavmesh::ClearRouteCache()
+{
+	m_impl->ClearRouteCache();
+}
+
+uint64 PathfinderNavmesh::FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions &opts)
+{
+	if (!m_impl->nav_mesh) {
+		return 0;
+	}
+
+	std::unique_lock<std::mutex> lock(m_impl->async_lock);
+
+	if (!m_impl->async_running) {
+		return 0;
+	}
+
+	// past the limit the caller paths inline rather than letting latency pile up
+	if (m_impl->async_outstanding >= static_cast<size_t>(std::max(RuleI(Pathing, AsyncMaxOutstandingRequests), 0))) {
+		m_impl->async_stats.rejected++;
+		return 0;
+	}
+
+	AsyncPathRequest request;
+	request.ticket    = m_impl->async_next_ticket++;
+	request.start     = start;
+	request.end       = end;
+	request.opts      = opts;
+	request.queued_at = std::chrono::steady_clock::now();
+
+	m_impl->async_queue.push_back(request);
+	m_impl->async_outstanding++;
+	m_impl->async_stats.submitted++;
+	m_impl->async_stats.peak_depth = std::max<uint64>(m_impl->async_stats.peak_depth, m_impl->async_queue.size());
+
+	lock.unlock();
+	m_impl->async_cv.notify_one();
+
+	return request.ticket;
+}
+
+void PathfinderNavmesh::CollectAsyncPaths(std::vector<AsyncPathResult> &results)
+{
+	results.clear();
+
+	std::lock_guard<std::mutex> lock(m_impl->async_lock);
+
+	if (m_impl->async_completed.empty()) {
+		return;
+	}
+
+	results.swap(m_impl->async_completed);
+	m_impl->async_outstanding -= results.size();
+}
+
+void PathfinderNavmesh::StartAsyncWorkers(int count)
+{
+	if (count <= 0 || m_impl->async_running) {
+		return;
+	}
+
+	m_impl->async_running = true;
+	for (int i = 0; i < count; ++i) {
+		m_impl->async_workers.emplace_back(std::thread(&PathfinderNavmesh::ProcessAsyncPaths, this));
+	}
+
+	LogInfo("Started [{}] async pathfinding workers", count);
+}
+
+void PathfinderNavmesh::StopAsyncWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_impl->async_lock);
+		if (!m_impl->async_running) {
+			return;
+		}
+
+		m_impl->async_running = false;
+	}
+
+	m_impl->async_cv.notify_all();
+
+	for (auto &t : m_impl->async_workers) {
+		t.join();
+	}
+
+	m_impl->async_workers.clear();
+	m_impl->async_queue.clear();
+	m_impl->async_completed.clear();
+	m_impl->async_outstanding = 0;
+}
+
+void PathfinderNavmesh::ProcessAsyncPaths()
+{
+	// the navmesh is read only once loaded, each worker only needs a query of its own
+	dtNavMeshQuery *query = dtAllocNavMeshQuery();
+
+	for (;;) {
+		AsyncPathRequest request;
+
+		{
+			std::unique_lock<std::mutex> lock(m_impl->async_lock);
+			m_impl->async_cv.wait(lock, [this] { return !m_impl->async_running || !m_impl->async_queue.empty(); });
+
+			if (!m_impl->async_running) {
+				break;
+			}
+
+			request = std::move(m_impl->async_queue.front());
+			m_impl->async_queue.pop_front();
+		}
+
+		AsyncPathResult result;
+		result.ticket  = request.ticket;
+		result.partial = false;
+		result.stuck   = false;
+		result.route   = FindPathWithQuery(query, request.start, request.end, result.partial, result.stuck, request.opts);
+
+		auto latency_us = static_cast<uint64>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - request.queued_at
+			).count()
+		);
+
+		{
+			std::lock_guard<std::mutex> lock(m_impl->async_lock);
+
+			m_impl->async_completed.push_back(std::move(result));
+			m_impl->async_stats.completed++;
+			m_impl->async_stats.total_latency_us += latency_us;
+			m_impl->async_stats.max_latency_us = std::max(m_impl->async_stats.max_latency_us, latency_us);
+		}
+	}
+
+	dtFreeNavMeshQuery(query);
+}
+
 void PathfinderNavmesh::Clear()
 {
+	m_impl->ClearRouteCache();
+
 	if (m_impl->nav_mesh) {
 		dtFreeNavMesh(m_impl->nav_mesh);
 	}
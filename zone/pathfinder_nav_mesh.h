@@ -4,6 +4,9 @@
 #include <string>
 #include <DetourNavMesh.h>
 
+class dtNavMeshQuery;
+class dtQueryFilter;
+
 class PathfinderNavmesh : public IPathfinder
 {
 public:
@@ -14,9 +17,18 @@ public:
 	virtual IPath FindPath(const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions& opts);
 	virtual glm::vec3 GetRandomLocation(const glm::vec3 &start, int flags = PathingNotDisabled);
 	virtual void DebugCommand(Client *c, const Seperator *sep);
+	virtual void ClearRouteCache();
+	virtual uint64 FindPathAsync(const glm::vec3 &start, const glm::vec3 &end, const PathfinderOptions &opts);
+	virtual void CollectAsyncPaths(std::vector<AsyncPathResult> &results);
 
 private:
 	void Clear();
+	void StartAsyncWorkers(int count);
+	void StopAsyncWorkers();
+	void ProcessAsyncPaths();
+	IPath FindPathWithQuery(dtNavMeshQuery *query, const glm::vec3 &start, const glm::vec3 &end, bool &partial, bool &stuck, const PathfinderOptions &opts);
+	IPath BuildRoute(dtPolyRef start_ref, dtPolyRef end_ref, const glm::vec3 &current_location, const glm::vec3 &dest_location, const glm::vec3 &end, const dtQueryFilter &filter, bool &partial, bool &stuck);
+	IPath BuildPath(dtNavMeshQuery *query, dtPolyRef start_ref, dtPolyRef end_ref, const glm::vec3 &current_location, const glm::vec3 &dest_location, const dtQueryFilter &filter, const PathfinderOptions &opts, bool &partial, bool &stuck);
 	void Load(const std::string &path);
 	void ShowPath(Client *c, const glm::vec3 &start, const glm::vec3 &end);
 	dtStatus GetPolyHeightNoConnections(dtPolyRef ref, const float *pos, float *height) const;
@@ -0,0 +1,125 @@
+#include "pathfinder_route_cache.h"
+#include <algorithm>
+#include <cmath>
+
+size_t PathfinderRouteCache::KeyHash::operator()(const Key &k) const
+{
+	uint64 h = 1469598103934665603ULL;
+
+	auto mix = [&h](uint64 v) {
+		h ^= v;
+		h *= 1099511628211ULL;
+	};
+
+	mix(k.start_ref);
+	mix(k.end_ref);
+	for (int i = 0; i < 3; ++i) {
+		mix(static_cast<uint32>(k.start[i]));
+		mix(static_cast<uint32>(k.end[i]));
+	}
+	mix(k.options);
+
+	return static_cast<size_t>(h);
+}
+
+PathfinderRouteCache::Key PathfinderRouteCache::MakeKey(
+	uint64 start_ref,
+	uint64 end_ref,
+	const glm::vec3 &start,
+	const glm::vec3 &end,
+	uint64 options
+) const
+{
+	auto snap = [this](float v) {
+		return static_cast<int32>(std::clamp(std::floor(v / m_quantization), -1000000.0f, 1000000.0f));
+	};
+
+	Key k;
+	k.start_ref = start_ref;
+	k.end_ref   = end_ref;
+	k.options   = options;
+
+	for (int i = 0; i < 3; ++i) {
+		k.start[i] = snap(start[i]);
+		k.end[i]   = snap(end[i]);
+	}
+
+	return k;
+}
+
+bool PathfinderRouteCache::Find(const Key &key, IPathfinder::IPath &route, bool &partial, bool &stuck)
+{
+	auto it = m_index.find(key);
+	if (it == m_index.end()) {
+		m_stats.misses++;
+		return false;
+	}
+
+	// most recently used entries live at the front
+	m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+	const auto &e = *it->second;
+	route   = e.route;
+	partial = e.partial;
+	if (e.stuck) {
+		stuck = true;
+	}
+
+	m_stats.hits++;
+	return true;
+}
+
+void PathfinderRouteCache::Insert(const Key &key, const IPathfinder::IPath &route, bool partial, bool stuck)
+{
+	if (!Enabled()) {
+		return;
+	}
+
+	auto it = m_index.find(key);
+	if (it != m_index.end()) {
+		it->second->route   = route;
+		it->second->partial = partial;
+		it->second->stuck   = stuck;
+		m_entries.splice(m_entries.begin(), m_entries, it->second);
+		return;
+	}
+
+	while (m_entries.size() >= m_capacity) {
+		m_index.erase(m_entries.back().key);
+		m_entries.pop_back();
+		m_stats.evictions++;
+	}
+
+	m_entries.push_front(Entry{key, route, partial, stuck});
+	m_index[key] = m_entries.begin();
+}
+
+void PathfinderRouteCache::Clear()
+{
+	if (!m_entries.empty()) {
+		m_stats.invalidations++;
+	}
+
+	m_entries.clear();
+	m_index.clear();
+}
+
+void PathfinderRouteCache::SetCapacity(size_t capacity)
+{
+	m_capacity = capacity;
+
+	while (m_entries.size() > m_capacity) {
+		m_index.erase(m_entries.back().key);
+		m_entries.pop_back();
+		m_stats.evictions++;
+	}
+}
+
+void PathfinderRouteCache::SetQuantization(float quantization)
+{
+	quantization = std::max(quantization, 0.01f);
+	if (quantization != m_quantization) {
+		Clear();
+		m_quantization = quantization;
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "pathfinder_interface.h"
+#include <list>
+#include <unordered_map>
+
+// Bounded LRU cache of navmesh routes
+//
+// Routes are keyed on the start and end polygons, the start and end positions snapped to a small grid and
+// a signature of the query options, so mobs walking the same leash or roam legs share one Detour query
+class PathfinderRouteCache
+{
+public:
+	struct Key
+	{
+		uint64 start_ref;
+		uint64 end_ref;
+		int32  start[3];
+		int32  end[3];
+		uint64 options;
+
+		bool operator==(const Key &o) const
+		{
+			return start_ref == o.start_ref && end_ref == o.end_ref &&
+				start[0] == o.start[0] && start[1] == o.start[1] && start[2] == o.start[2] &&
+				end[0] == o.end[0] && end[1] == o.end[1] && end[2] == o.end[2] &&
+				options == o.options;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key &k) const;
+	};
+
+	struct Stats
+	{
+		uint64 hits          = 0;
+		uint64 misses        = 0;
+		uint64 evictions     = 0;
+		uint64 invalidations = 0;
+	};
+
+	Key MakeKey(uint64 start_ref, uint64 end_ref, const glm::vec3 &start, const glm::vec3 &end, uint64 options) const;
+
+	bool Find(const Key &key, IPathfinder::IPath &route, bool &partial, bool &stuck);
+	void Insert(const Key &key, const IPathfinder::IPath &route, bool partial, bool stuck);
+	void Clear();
+
+	void SetCapacity(size_t capacity);
+	void SetQuantization(float quantization);
+
+	inline bool Enabled() const { return m_capacity > 0; }
+	inline size_t Size() const { return m_entries.size(); }
+	inline size_t Capacity() const { return m_capacity; }
+	inline const Stats &GetStats() const { return m_stats; }
+
+private:
+	struct Entry
+	{
+		Key                key;
+		IPathfinder::IPath route;
+		bool               partial;
+		bool               stuck;
+	};
+
+	size_t                                                       m_capacity     = 0;
+	float                                                        m_quantization = 1.0f;
+	std::list<Entry>                                             m_entries;
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+	Stats                                                        m_stats;
+};
@@ -35,6 +35,9 @@ void Perl_HateEntry_SetDamage(struct_HateList* self, int64 value) // @categories
 void Perl_HateEntry_SetEnt(struct_HateList* self, Mob* mob) // @categories Script Utility, Hate and Aggro
 {
 	self->entity_on_hatelist = mob;
+	if (self->owner) {
+		self->owner->OnEntryModified(self);
+	}
 }
 
 void Perl_HateEntry_SetFrenzy(struct_HateList* self, bool is_frenzy) // @categories Script Utility, Hate and Aggro
@@ -45,6 +48,9 @@ void Perl_HateEntry_SetFrenzy(struct_HateList* self, bool is_frenzy) // @categor
 void Perl_HateEntry_SetHate(struct_HateList* self, int64 value) // @categories Script Utility, Hate and Aggro
 {
 	self->stored_hate_amount = value;
+	if (self->owner) {
+		self->owner->OnEntryModified(self);
+	}
 }
 
 void perl_register_hateentry()
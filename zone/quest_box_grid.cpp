@@ -0,0 +1,60 @@
+#include "quest_box_grid.h"
+
+void QuestBoxGrid::Reset(float cell_size)
+{
+	m_cells.clear();
+	m_wide.clear();
+
+	m_cell_size         = std::max(cell_size, 1.0f);
+	m_inverse_cell_size = 1.0f / m_cell_size;
+}
+
+void QuestBoxGrid::Insert(uint32 index, float min_x, float max_x, float min_y, float max_y)
+{
+	// NaN bounds never compare, leave those to the wide list so they're tested exactly like before
+	if (std::isnan(min_x) || std::isnan(max_x) || std::isnan(min_y) || std::isnan(max_y)) {
+		InsertWide(index);
+		return;
+	}
+
+	const int32 cell_min_x = ToCell(std::min(min_x, max_x));
+	const int32 cell_max_x = ToCell(std::max(min_x, max_x));
+	const int32 cell_min_y = ToCell(std::min(min_y, max_y));
+	const int32 cell_max_y = ToCell(std::max(min_y, max_y));
+
+	const uint64 span = static_cast<uint64>(cell_max_x - cell_min_x + 1) * static_cast<uint64>(cell_max_y - cell_min_y + 1);
+	if (span > MAX_CELLS_PER_BOX) {
+		InsertWide(index);
+		return;
+	}
+
+	for (int32 x = cell_min_x; x <= cell_max_x; ++x) {
+		for (int32 y = cell_min_y; y <= cell_max_y; ++y) {
+			m_cells[CellKey(x, y)].push_back(index);
+		}
+	}
+}
+
+void QuestBoxGrid::InsertWide(uint32 index)
+{
+	m_wide.push_back(index);
+}
+
+void QuestBoxGrid::Query(float x, float y, std::vector<uint32> &out) const
+{
+	out.insert(out.end(), m_wide.begin(), m_wide.end());
+
+	// a NaN coordinate passes every containment test, so every box is a candidate
+	if (std::isnan(x) || std::isnan(y)) {
+		for (const auto &c : m_cells) {
+			out.insert(out.end(), c.second.begin(), c.second.end());
+		}
+
+		return;
+	}
+
+	auto c = m_cells.find(CellKey(ToCell(x), ToCell(y)));
+	if (c != m_cells.end()) {
+		out.insert(out.end(), c->second.begin(), c->second.end());
+	}
+}
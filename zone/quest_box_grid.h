@@ -0,0 +1,50 @@
+#ifndef EQEMU_QUEST_BOX_GRID_H
+#define EQEMU_QUEST_BOX_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include "../common/types.h"
+
+// 2D bucket index over the quest proximity and area boxes, owned by EntityList
+//
+// Boxes are stored by the index the owner assigned them and registered in every (x, y) cell they
+// overlap; z is left to the caller's exact containment test. Boxes covering too many cells go into a
+// wide list that every query returns instead, so one zone sized area can't blow up the cell map
+class QuestBoxGrid {
+public:
+	static constexpr float DEFAULT_CELL_SIZE = 250.0f;
+	static constexpr uint64 MAX_CELLS_PER_BOX = 256;
+
+	void Reset(float cell_size = DEFAULT_CELL_SIZE);
+	void Insert(uint32 index, float min_x, float max_x, float min_y, float max_y);
+	void InsertWide(uint32 index);
+
+	// appends every box index whose cells may contain (x, y), may hold duplicates across calls
+	void Query(float x, float y, std::vector<uint32> &out) const;
+
+	inline size_t GetCellCount() const { return m_cells.size(); }
+	inline size_t GetWideCount() const { return m_wide.size(); }
+
+private:
+	// keep cell coordinates well inside int32 so FLT_MAX positions can't overflow the key math
+	static constexpr float MAX_CELL_COORD = 1000000.0f;
+
+	inline int32 ToCell(float v) const
+	{
+		return static_cast<int32>(std::clamp(std::floor(v * m_inverse_cell_size), -MAX_CELL_COORD, MAX_CELL_COORD));
+	}
+
+	static inline uint64 CellKey(int32 x, int32 y)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y);
+	}
+
+	float                                           m_cell_size         = DEFAULT_CELL_SIZE;
+	float                                           m_inverse_cell_size = 1.0f / DEFAULT_CELL_SIZE;
+	std::unordered_map<uint64, std::vector<uint32>> m_cells;
+	std::vector<uint32>                             m_wide;
+};
+
+#endif //EQEMU_QUEST_BOX_GRID_H
@@ -22,6 +22,7 @@
 #include "../common/types.h"
 #include "event_codes.h"
 #include <any>
+#include <string_view>
 
 class Client;
 class NPC;
@@ -36,7 +37,7 @@ public:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -48,7 +49,7 @@ public:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -59,7 +60,7 @@ public:
 	virtual int EventPlayer(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -70,7 +71,7 @@ public:
 	virtual int EventGlobalPlayer(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -83,7 +84,7 @@ public:
 		Client* client,
 		EQ::ItemInstance* inst,
 		Mob* mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -96,7 +97,7 @@ public:
 		Mob* mob,
 		Client* client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -107,7 +108,7 @@ public:
 	virtual int EventEncounter(
 		QuestEventID event_id,
 		std::string encounter_name,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -119,7 +120,7 @@ public:
 		QuestEventID event_id,
 		Bot* bot,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -131,7 +132,7 @@ public:
 		QuestEventID event_id,
 		Bot* bot,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -143,7 +144,7 @@ public:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -155,7 +156,7 @@ public:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -239,7 +240,7 @@ public:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -250,7 +251,7 @@ public:
 	virtual int DispatchEventPlayer(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -263,7 +264,7 @@ public:
 		Client* client,
 		EQ::ItemInstance* inst,
 		Mob* mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -276,7 +277,7 @@ public:
 		Mob* mob,
 		Client* client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -288,7 +289,7 @@ public:
 		QuestEventID event_id,
 		Bot* bot,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -300,7 +301,7 @@ public:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	)
@@ -25,6 +25,7 @@
 #include "quest_interface.h"
 #include "zone.h"
 #include "questmgr.h"
+#include "zone_profiler.h"
 #include "../common/path_manager.h"
 #include "../common/repositories/perl_event_export_settings_repository.h"
 #include "../common/file.h"
@@ -40,17 +41,28 @@ const std::string ENCOUNTER_NO_ENTITY_ID = "-1";
 extern Zone* zone;
 extern void MapOpcodes();
 
-QuestParserCollection::QuestParserCollection()
+// profiler keys for each quest event, interned the first time an event fires
+static uint32 QuestEventProfileKey(QuestEventID event_id)
 {
-	_player_quest_status        = QuestUnloaded;
-	_global_player_quest_status = QuestUnloaded;
-	_global_npc_quest_status    = QuestUnloaded;
-	_bot_quest_status           = QuestUnloaded;
-	_global_bot_quest_status    = QuestUnloaded;
-	_merc_quest_status          = QuestUnloaded;
-	_global_merc_quest_status   = QuestUnloaded;
+	static std::vector<uint32> keys(_LargestEventID, UINT32_MAX);
+
+	if (event_id < 0 || event_id >= _LargestEventID) {
+		return ZoneProfiler::Instance().GetKey("EVENT_UNKNOWN");
+	}
+
+	if (keys[event_id] == UINT32_MAX) {
+#ifdef EMBPERL
+		keys[event_id] = ZoneProfiler::Instance().GetKey(QuestEventSubroutines[event_id]);
+#else
+		keys[event_id] = ZoneProfiler::Instance().GetKey(fmt::format("EVENT_{}", static_cast<int>(event_id)));
+#endif
+	}
+
+	return keys[event_id];
 }
 
+QuestParserCollection::QuestParserCollection() { }
+
 QuestParserCollection::~QuestParserCollection() { }
 
 void QuestParserCollection::RegisterQuestInterface(QuestInterface* qi, std::string ext)
@@ -91,13 +103,13 @@ void QuestParserCollection::ReloadQuests(bool reset_timers)
 
 	_npc_quest_status.clear();
 
-	_player_quest_status        = QuestUnloaded;
-	_global_player_quest_status = QuestUnloaded;
-	_global_npc_quest_status    = QuestUnloaded;
-	_bot_quest_status           = QuestUnloaded;
-	_global_bot_quest_status    = QuestUnloaded;
-	_merc_quest_status          = QuestUnloaded;
-	_global_merc_quest_status   = QuestUnloaded;
+	_player_quest_status        = {};
+	_global_player_quest_status = {};
+	_global_npc_quest_status    = {};
+	_bot_quest_status           = {};
+	_global_bot_quest_status    = {};
+	_merc_quest_status          = {};
+	_global_merc_quest_status   = {};
 
 	_spell_quest_status.clear();
 	_item_quest_status.clear();
@@ -115,165 +127,282 @@ void QuestParserCollection::RemoveEncounter(const std::string& name)
 	}
 }
 
-bool QuestParserCollection::HasQuestSub(uint32 npc_id, QuestEventID event_id)
+void QuestParserCollection::SetScript(
+	QuestScript& s,
+	QuestInterface* qi,
+	const std::function<bool(QuestEventID)>& has_sub
+)
 {
-	return (
-		HasQuestSubLocal(npc_id, event_id) ||
-		HasQuestSubGlobal(event_id) ||
-		NPCHasEncounterSub(npc_id, event_id)
-	);
-}
+	s.subs.reset();
 
-bool QuestParserCollection::NPCHasEncounterSub(uint32 npc_id, QuestEventID event_id)
-{
-	return HasEncounterSub(event_id, fmt::format("npc_{}", npc_id)) || HasEncounterSub(event_id, "npc_" + ENCOUNTER_NO_ENTITY_ID);
-}
+	if (!qi) {
+		s.status = QuestFailedToLoad;
+		s.qi     = nullptr;
+		return;
+	}
 
-bool QuestParserCollection::HasQuestSubLocal(uint32 npc_id, QuestEventID event_id)
-{
-	auto iter = _npc_quest_status.find(npc_id);
+	s.status = qi->GetIdentifier();
+	s.qi     = qi;
 
-	if (iter != _npc_quest_status.end()) {
-		if (iter->second != QuestFailedToLoad) { //loaded or failed to load
-			auto qiter = _interfaces.find(iter->second);
-			if (qiter->second->HasQuestSub(npc_id, event_id)) {
-				return true;
-			}
+	for (int i = 0; i < _LargestEventID; ++i) {
+		if (has_sub(static_cast<QuestEventID>(i))) {
+			s.subs.set(i);
 		}
-	} else {
+	}
+}
+
+QuestParserCollection::QuestScript& QuestParserCollection::GetNPCScript(uint32 npc_id)
+{
+	auto& s = _npc_quest_status[npc_id];
+	if (s.status == QuestUnloaded) {
 		std::string filename;
 		auto        qi = GetQIByNPCQuest(npc_id, filename);
 
 		if (qi) {
-			_npc_quest_status[npc_id] = qi->GetIdentifier();
-
 			qi->LoadNPCScript(filename, npc_id);
-			if (qi->HasQuestSub(npc_id, event_id)) {
-				return true;
-			}
-		} else {
-			_npc_quest_status[npc_id] = QuestFailedToLoad;
 		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->HasQuestSub(npc_id, e); });
 	}
 
-	return false;
+	return s;
 }
 
-bool QuestParserCollection::HasQuestSubGlobal(QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetGlobalNPCScript()
 {
-	if (_global_npc_quest_status == QuestUnloaded) {
+	auto& s = _global_npc_quest_status;
+	if (s.status == QuestUnloaded) {
 		std::string filename;
 		auto        qi = GetQIByGlobalNPCQuest(filename);
 
 		if (qi) {
 			qi->LoadGlobalNPCScript(filename);
-			_global_npc_quest_status = qi->GetIdentifier();
-			if (qi->HasGlobalQuestSub(event_id)) {
-				return true;
-			}
-		}
-	} else {
-		if (_global_npc_quest_status != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(_global_npc_quest_status);
-			if (qiter->second->HasGlobalQuestSub(event_id)) {
-				return true;
-			}
 		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->HasGlobalQuestSub(e); });
 	}
 
-	return false;
+	return s;
 }
 
-bool QuestParserCollection::PlayerHasQuestSub(QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetPlayerScript()
 {
-	return (
-		PlayerHasQuestSubLocal(event_id) ||
-		PlayerHasQuestSubGlobal(event_id) ||
-		PlayerHasEncounterSub(event_id)
-	);
+	auto& s = _player_quest_status;
+	if (s.status == QuestUnloaded) {
+		std::string filename;
+		auto        qi = GetQIByPlayerQuest(filename);
+
+		if (qi) {
+			qi->LoadPlayerScript(filename);
+		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->PlayerHasQuestSub(e); });
+	}
+
+	return s;
 }
 
-bool QuestParserCollection::PlayerHasEncounterSub(QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetGlobalPlayerScript()
 {
-	return HasEncounterSub(event_id, "player");
+	auto& s = _global_player_quest_status;
+	if (s.status == QuestUnloaded) {
+		std::string filename;
+		auto        qi = GetQIByGlobalPlayerQuest(filename);
+
+		if (qi) {
+			qi->LoadGlobalPlayerScript(filename);
+		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->GlobalPlayerHasQuestSub(e); });
+	}
+
+	return s;
 }
 
-bool QuestParserCollection::PlayerHasQuestSubLocal(QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetBotScript()
 {
-	if (_player_quest_status == QuestUnloaded) {
+	auto& s = _bot_quest_status;
+	if (s.status == QuestUnloaded) {
 		std::string filename;
-		auto        qi = GetQIByPlayerQuest(filename);
+		auto        qi = GetQIByBotQuest(filename);
 
 		if (qi) {
-			_player_quest_status = qi->GetIdentifier();
-			qi->LoadPlayerScript(filename);
-			return qi->PlayerHasQuestSub(event_id);
+			qi->LoadBotScript(filename);
 		}
-	} else if (_player_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_player_quest_status);
-		return iter->second->PlayerHasQuestSub(event_id);
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->BotHasQuestSub(e); });
 	}
 
-	return false;
+	return s;
 }
 
-bool QuestParserCollection::PlayerHasQuestSubGlobal(QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetGlobalBotScript()
 {
-	if (_global_player_quest_status == QuestUnloaded) {
+	auto& s = _global_bot_quest_status;
+	if (s.status == QuestUnloaded) {
 		std::string filename;
-		auto        qi = GetQIByGlobalPlayerQuest(filename);
+		auto        qi = GetQIByGlobalBotQuest(filename);
 
 		if (qi) {
-			_global_player_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalPlayerScript(filename);
-			return qi->GlobalPlayerHasQuestSub(event_id);
+			qi->LoadGlobalBotScript(filename);
 		}
-	} else if (_global_player_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_player_quest_status);
-		return iter->second->GlobalPlayerHasQuestSub(event_id);
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->GlobalBotHasQuestSub(e); });
 	}
 
-	return false;
+	return s;
 }
 
-bool QuestParserCollection::SpellHasEncounterSub(uint32 spell_id, QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetMercScript()
 {
-	return HasEncounterSub(event_id, fmt::format("spell_{}", spell_id)) ||
-		   HasEncounterSub(event_id, "spell_" + ENCOUNTER_NO_ENTITY_ID);
+	auto& s = _merc_quest_status;
+	if (s.status == QuestUnloaded) {
+		std::string filename;
+		auto        qi = GetQIByMercQuest(filename);
+
+		if (qi) {
+			qi->LoadMercScript(filename);
+		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->MercHasQuestSub(e); });
+	}
+
+	return s;
 }
 
-bool QuestParserCollection::SpellHasQuestSub(uint32 spell_id, QuestEventID event_id)
+QuestParserCollection::QuestScript& QuestParserCollection::GetGlobalMercScript()
 {
-	if (SpellHasEncounterSub(spell_id, event_id)) {
-		return true;
-	}
+	auto& s = _global_merc_quest_status;
+	if (s.status == QuestUnloaded) {
+		std::string filename;
+		auto        qi = GetQIByGlobalMercQuest(filename);
 
-	auto iter = _spell_quest_status.find(spell_id);
-	if (iter != _spell_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->SpellHasQuestSub(spell_id, event_id);
+		if (qi) {
+			qi->LoadGlobalMercScript(filename);
 		}
-	} else if (_spell_quest_status[spell_id] != QuestFailedToLoad) {
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->GlobalMercHasQuestSub(e); });
+	}
+
+	return s;
+}
+
+QuestParserCollection::QuestScript& QuestParserCollection::GetSpellScript(uint32 spell_id)
+{
+	auto& s = _spell_quest_status[spell_id];
+	if (s.status == QuestUnloaded) {
 		std::string filename;
 		auto        qi = GetQIBySpellQuest(spell_id, filename);
 
 		if (qi) {
-			_spell_quest_status[spell_id] = qi->GetIdentifier();
 			qi->LoadSpellScript(filename, spell_id);
-			return qi->SpellHasQuestSub(spell_id, event_id);
+		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->SpellHasQuestSub(spell_id, e); });
+	}
+
+	return s;
+}
+
+QuestParserCollection::QuestScript& QuestParserCollection::GetItemScript(EQ::ItemInstance* inst)
+{
+	auto& s = _item_quest_status[inst->GetID()];
+	if (s.status == QuestUnloaded) {
+		std::string item_script;
+		if (inst->GetItem()->ScriptFileID != 0) {
+			item_script = fmt::format(
+				"script_{}",
+				inst->GetItem()->ScriptFileID
+			);
+		} else if (strlen(inst->GetItem()->CharmFile) > 0) {
+			item_script = inst->GetItem()->CharmFile;
 		} else {
-			_spell_quest_status[spell_id] = QuestFailedToLoad;
+			item_script = std::to_string(inst->GetID());
 		}
+
+		std::string filename;
+		auto        qi = GetQIByItemQuest(item_script, filename);
+
+		if (qi) {
+			qi->LoadItemScript(filename, inst);
+		}
+
+		SetScript(s, qi, [&](QuestEventID e) { return qi->ItemHasQuestSub(inst, e); });
 	}
 
-	return false;
+	return s;
+}
+
+bool QuestParserCollection::HasQuestSub(uint32 npc_id, QuestEventID event_id)
+{
+	return (
+		HasQuestSubLocal(npc_id, event_id) ||
+		HasQuestSubGlobal(event_id) ||
+		NPCHasEncounterSub(npc_id, event_id)
+	);
+}
+
+bool QuestParserCollection::NPCHasEncounterSub(uint32 npc_id, QuestEventID event_id)
+{
+	if (_encounter_quest_status.empty()) {
+		return false;
+	}
+
+	return HasEncounterSub(event_id, fmt::format("npc_{}", npc_id)) || HasEncounterSub(event_id, "npc_" + ENCOUNTER_NO_ENTITY_ID);
+}
+
+bool QuestParserCollection::HasQuestSubLocal(uint32 npc_id, QuestEventID event_id)
+{
+	return GetNPCScript(npc_id).HasSub(event_id);
+}
+
+bool QuestParserCollection::HasQuestSubGlobal(QuestEventID event_id)
+{
+	return GetGlobalNPCScript().HasSub(event_id);
+}
+
+bool QuestParserCollection::PlayerHasQuestSub(QuestEventID event_id)
+{
+	return (
+		PlayerHasQuestSubLocal(event_id) ||
+		PlayerHasQuestSubGlobal(event_id) ||
+		PlayerHasEncounterSub(event_id)
+	);
+}
+
+bool QuestParserCollection::PlayerHasEncounterSub(QuestEventID event_id)
+{
+	return HasEncounterSub(event_id, "player");
+}
+
+bool QuestParserCollection::PlayerHasQuestSubLocal(QuestEventID event_id)
+{
+	return GetPlayerScript().HasSub(event_id);
+}
+
+bool QuestParserCollection::PlayerHasQuestSubGlobal(QuestEventID event_id)
+{
+	return GetGlobalPlayerScript().HasSub(event_id);
+}
+
+bool QuestParserCollection::SpellHasEncounterSub(uint32 spell_id, QuestEventID event_id)
+{
+	if (_encounter_quest_status.empty()) {
+		return false;
+	}
+
+	return HasEncounterSub(event_id, fmt::format("spell_{}", spell_id)) ||
+		   HasEncounterSub(event_id, "spell_" + ENCOUNTER_NO_ENTITY_ID);
+}
+
+bool QuestParserCollection::SpellHasQuestSub(uint32 spell_id, QuestEventID event_id)
+{
+	return SpellHasEncounterSub(spell_id, event_id) || GetSpellScript(spell_id).HasSub(event_id);
 }
 
 bool QuestParserCollection::ItemHasEncounterSub(EQ::ItemInstance *inst, QuestEventID event_id)
 {
-	if (inst) {
+	if (inst && !_encounter_quest_status.empty()) {
 		return HasEncounterSub(event_id, fmt::format("item_{}", inst->GetID())) ||
 			   HasEncounterSub(event_id, "item_" + ENCOUNTER_NO_ENTITY_ID);
 	}
@@ -287,43 +416,7 @@ bool QuestParserCollection::ItemHasQuestSub(EQ::ItemInstance* inst, QuestEventID
 		return false;
 	}
 
-	if (ItemHasEncounterSub(inst, event_id)) {
-		return true;
-	}
-
-	std::string item_script;
-	if (inst->GetItem()->ScriptFileID != 0) {
-		item_script = fmt::format(
-			"script_{}",
-			inst->GetItem()->ScriptFileID
-		);
-	} else if (strlen(inst->GetItem()->CharmFile) > 0) {
-		item_script = inst->GetItem()->CharmFile;
-	} else {
-		item_script = std::to_string(inst->GetID());
-	}
-
-	uint32 item_id = inst->GetID();
-	auto   iter    = _item_quest_status.find(item_id);
-	if (iter != _item_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->ItemHasQuestSub(inst, event_id);
-		}
-	} else {
-		std::string filename;
-		auto        qi = GetQIByItemQuest(item_script, filename);
-		if (qi) {
-			_item_quest_status[item_id] = qi->GetIdentifier();
-			qi->LoadItemScript(filename, inst);
-			return qi->ItemHasQuestSub(inst, event_id);
-		} else {
-			_item_quest_status[item_id] = QuestFailedToLoad;
-		}
-	}
-
-	return false;
+	return ItemHasEncounterSub(inst, event_id) || GetItemScript(inst).HasSub(event_id);
 }
 
 bool QuestParserCollection::HasEncounterSub(QuestEventID event_id, const std::string& package_name)
@@ -342,40 +435,12 @@ bool QuestParserCollection::HasEncounterSub(QuestEventID event_id, const std::st
 
 bool QuestParserCollection::BotHasQuestSubLocal(QuestEventID event_id)
 {
-	if (_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByBotQuest(filename);
-
-		if (qi) {
-			_bot_quest_status = qi->GetIdentifier();
-			qi->LoadBotScript(filename);
-			return qi->BotHasQuestSub(event_id);
-		}
-	} else if (_bot_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_bot_quest_status);
-		return iter->second->BotHasQuestSub(event_id);
-	}
-
-	return false;
+	return GetBotScript().HasSub(event_id);
 }
 
 bool QuestParserCollection::BotHasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalBotQuest(filename);
-
-		if (qi) {
-			_global_bot_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalBotScript(filename);
-			return qi->GlobalBotHasQuestSub(event_id);
-		}
-	} else if (_global_bot_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_bot_quest_status);
-		return iter->second->GlobalBotHasQuestSub(event_id);
-	}
-
-	return false;
+	return GetGlobalBotScript().HasSub(event_id);
 }
 
 bool QuestParserCollection::BotHasQuestSub(QuestEventID event_id)
@@ -385,40 +450,12 @@ bool QuestParserCollection::BotHasQuestSub(QuestEventID event_id)
 
 bool QuestParserCollection::MercHasQuestSubLocal(QuestEventID event_id)
 {
-	if (_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByMercQuest(filename);
-
-		if (qi) {
-			_merc_quest_status = qi->GetIdentifier();
-			qi->LoadMercScript(filename);
-			return qi->MercHasQuestSub(event_id);
-		}
-	} else if (_merc_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_merc_quest_status);
-		return iter->second->MercHasQuestSub(event_id);
-	}
-
-	return false;
+	return GetMercScript().HasSub(event_id);
 }
 
 bool QuestParserCollection::MercHasQuestSubGlobal(QuestEventID event_id)
 {
-	if (_global_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalMercQuest(filename);
-
-		if (qi) {
-			_global_merc_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalMercScript(filename);
-			return qi->GlobalMercHasQuestSub(event_id);
-		}
-	} else if (_global_merc_quest_status != QuestFailedToLoad) {
-		auto iter = _interfaces.find(_global_merc_quest_status);
-		return iter->second->GlobalMercHasQuestSub(event_id);
-	}
-
-	return false;
+	return GetGlobalMercScript().HasSub(event_id);
 }
 
 bool QuestParserCollection::MercHasQuestSub(QuestEventID event_id)
@@ -430,11 +467,14 @@ int QuestParserCollection::EventNPC(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	ZONE_PROFILE_SCOPE("quest_npc");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
+
 	if (npc->IsResumedFromZoneSuspend() && npc->IsQueuedForCorpse()) {
 		return 0;
 	}
@@ -458,70 +498,47 @@ int QuestParserCollection::EventNPCLocal(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	auto iter = _npc_quest_status.find(npc->GetNPCTypeID());
-	if (iter != _npc_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->EventNPC(event_id, npc, init, data, extra_data, extra_pointers);
-		}
-	} else if (_npc_quest_status[npc->GetNPCTypeID()] != QuestFailedToLoad) {
-		std::string filename;
-		auto        qi = GetQIByNPCQuest(npc->GetNPCTypeID(), filename);
-
-		if (qi) {
-			_npc_quest_status[npc->GetNPCTypeID()] = qi->GetIdentifier();
-			qi->LoadNPCScript(filename, npc->GetNPCTypeID());
-			return qi->EventNPC(event_id, npc, init, data, extra_data, extra_pointers);
-		} else {
-			_npc_quest_status[npc->GetNPCTypeID()] = QuestFailedToLoad;
-		}
+	auto& s = GetNPCScript(npc->GetNPCTypeID());
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventNPC(event_id, npc, init, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventNPCGlobal(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_global_npc_quest_status != QuestUnloaded && _global_npc_quest_status != QuestFailedToLoad) {
-		auto qiter = _interfaces.find(_global_npc_quest_status);
-		return qiter->second->EventGlobalNPC(event_id, npc, init, data, extra_data, extra_pointers);
-	} else if (_global_npc_quest_status != QuestFailedToLoad) {
-		std::string filename;
-		auto        qi = GetQIByGlobalNPCQuest(filename);
-
-		if (qi) {
-			_global_npc_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalNPCScript(filename);
-			return qi->EventGlobalNPC(event_id, npc, init, data, extra_data, extra_pointers);
-		} else {
-			_global_npc_quest_status = QuestFailedToLoad;
-		}
+	auto& s = GetGlobalNPCScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventGlobalNPC(event_id, npc, init, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventPlayer(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	ZONE_PROFILE_SCOPE("quest_player");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
+
 	const int local_return   = EventPlayerLocal(event_id, client, data, extra_data, extra_pointers);
 	const int global_return  = EventPlayerGlobal(event_id, client, data, extra_data, extra_pointers);
 	const int default_return = DispatchEventPlayer(event_id, client, data, extra_data, extra_pointers);
@@ -540,55 +557,33 @@ int QuestParserCollection::EventPlayer(
 int QuestParserCollection::EventPlayerLocal(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_player_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByPlayerQuest(filename);
-
-		if (qi) {
-			_player_quest_status = qi->GetIdentifier();
-			qi->LoadPlayerScript(filename);
-			return qi->EventPlayer(event_id, client, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_player_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_player_quest_status);
-			return iter->second->EventPlayer(event_id, client, data, extra_data, extra_pointers);
-		}
+	auto& s = GetPlayerScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventPlayer(event_id, client, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventPlayerGlobal(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_global_player_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalPlayerQuest(filename);
-
-		if (qi) {
-			_global_player_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalPlayerScript(filename);
-			return qi->EventGlobalPlayer(event_id, client, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_global_player_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_global_player_quest_status);
-			return iter->second->EventGlobalPlayer(event_id, client, data, extra_data, extra_pointers);
-		}
+	auto& s = GetGlobalPlayerScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventGlobalPlayer(event_id, client, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventItem(
@@ -596,75 +591,29 @@ int QuestParserCollection::EventItem(
 	Client* client,
 	EQ::ItemInstance* inst,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	ZONE_PROFILE_SCOPE("quest_item");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
+
 	if (!inst) {
 		return 0;
 	}
 
-	std::string item_script;
-	if (inst->GetItem()->ScriptFileID != 0) {
-		item_script = fmt::format(
-			"script_{}",
-			inst->GetItem()->ScriptFileID
-		);
-	} else if (strlen(inst->GetItem()->CharmFile) > 0) {
-		item_script = inst->GetItem()->CharmFile;
-	} else {
-		item_script = std::to_string(inst->GetID());
-	}
-
-	uint32 item_id = inst->GetID();
-	auto   iter    = _item_quest_status.find(item_id);
-	if (iter != _item_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			int  ret   = DispatchEventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
-			int  i     = qiter->second->EventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
-			if (i != 0) {
-				ret = i;
-			}
-
-			return ret;
-		}
-
-		return DispatchEventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
-	} else if (_item_quest_status[item_id] != QuestFailedToLoad) {
-		std::string filename;
-		auto        qi = GetQIByItemQuest(item_script, filename);
-
-		if (qi) {
-			_item_quest_status[item_id] = qi->GetIdentifier();
-
-			qi->LoadItemScript(filename, inst);
-
-			int ret = DispatchEventItem(
-				event_id,
-				client,
-				inst,
-				mob,
-				data,
-				extra_data,
-				extra_pointers
-			);
-
-			int i = qi->EventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
-			if (i != 0) {
-				ret = i;
-			}
+	auto& s   = GetItemScript(inst);
+	int   ret = DispatchEventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
 
-			return ret;
-		} else {
-			_item_quest_status[item_id] = QuestFailedToLoad;
-			return DispatchEventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
+	if (s.HasSub(event_id)) {
+		const int i = s.qi->EventItem(event_id, client, inst, mob, data, extra_data, extra_pointers);
+		if (i != 0) {
+			ret = i;
 		}
 	}
 
-	return 0;
+	return ret;
 }
 
 int QuestParserCollection::EventSpell(
@@ -672,76 +621,38 @@ int QuestParserCollection::EventSpell(
 	Mob* mob,
 	Client* client,
 	uint32 spell_id,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	auto iter = _spell_quest_status.find(spell_id);
-	if (iter != _spell_quest_status.end()) {
-		//loaded or failed to load
-		if (iter->second != QuestFailedToLoad) {
-			auto qi  = _interfaces.find(iter->second);
-			int  ret = DispatchEventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
-			int  i   = qi->second->EventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
-			if (i != 0) {
-				ret = i;
-			}
-
-			return ret;
-		}
+	ZONE_PROFILE_SCOPE("quest_spell");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
 
-		return DispatchEventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
-	} else if (_spell_quest_status[spell_id] != QuestFailedToLoad) {
-		std::string filename;
-		auto        qi = GetQIBySpellQuest(spell_id, filename);
+	auto& s   = GetSpellScript(spell_id);
+	int   ret = DispatchEventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
 
-		if (qi) {
-			_spell_quest_status[spell_id] = qi->GetIdentifier();
-
-			qi->LoadSpellScript(filename, spell_id);
-
-			int ret = DispatchEventSpell(
-				event_id,
-				mob,
-				client,
-				spell_id,
-				data,
-				extra_data,
-				extra_pointers
-			);
-
-			int i = qi->EventSpell(
-				event_id,
-				mob,
-				client,
-				spell_id,
-				data,
-				extra_data,
-				extra_pointers
-			);
-			if (i != 0) {
-				ret = i;
-			}
-
-			return ret;
-		} else {
-			_spell_quest_status[spell_id] = QuestFailedToLoad;
-			return DispatchEventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
+	if (s.HasSub(event_id)) {
+		const int i = s.qi->EventSpell(event_id, mob, client, spell_id, data, extra_data, extra_pointers);
+		if (i != 0) {
+			ret = i;
 		}
 	}
 
-	return 0;
+	return ret;
 }
 
 int QuestParserCollection::EventEncounter(
 	QuestEventID event_id,
 	std::string encounter_name,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	ZONE_PROFILE_SCOPE("quest_encounter");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
+
 	auto iter = _encounter_quest_status.find(encounter_name);
 	if (iter != _encounter_quest_status.end()) {
 		if (iter->second != QuestFailedToLoad) { // Loaded or failed to load
@@ -768,11 +679,14 @@ int QuestParserCollection::EventBot(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	ZONE_PROFILE_SCOPE("quest_bot");
+	ZoneProfiler::Scope event_scope(QuestEventProfileKey(event_id));
+
 	const int local_return   = EventBotLocal(event_id, bot, init, data, extra_data, extra_pointers);
 	const int global_return  = EventBotGlobal(event_id, bot, init, data, extra_data, extra_pointers);
 	const int default_return = DispatchEventBot(event_id, bot, init, data, extra_data, extra_pointers);
@@ -792,63 +706,41 @@ int QuestParserCollection::EventBotLocal(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByBotQuest(filename);
-
-		if (qi) {
-			_bot_quest_status = qi->GetIdentifier();
-			qi->LoadBotScript(filename);
-			return qi->EventBot(event_id, bot, init, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_bot_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_bot_quest_status);
-			return iter->second->EventBot(event_id, bot, init, data, extra_data, extra_pointers);
-		}
+	auto& s = GetBotScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventBot(event_id, bot, init, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventBotGlobal(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_global_bot_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalBotQuest(filename);
-
-		if (qi) {
-			_global_bot_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalBotScript(filename);
-			return qi->EventGlobalBot(event_id, bot, init, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_global_bot_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_global_bot_quest_status);
-			return iter->second->EventGlobalBot(event_id, bot, init, data, extra_data, extra_pointers);
-		}
+	auto& s = GetGlobalBotScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventGlobalBot(event_id, bot, init, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventMerc(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
@@ -872,56 +764,34 @@ int QuestParserCollection::EventMercLocal(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByMercQuest(filename);
-
-		if (qi) {
-			_merc_quest_status = qi->GetIdentifier();
-			qi->LoadMercScript(filename);
-			return qi->EventMerc(event_id, merc, init, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_merc_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_merc_quest_status);
-			return iter->second->EventMerc(event_id, merc, init, data, extra_data, extra_pointers);
-		}
+	auto& s = GetMercScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventMerc(event_id, merc, init, data, extra_data, extra_pointers);
 }
 
 int QuestParserCollection::EventMercGlobal(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
-	if (_global_merc_quest_status == QuestUnloaded) {
-		std::string filename;
-		auto        qi = GetQIByGlobalMercQuest(filename);
-
-		if (qi) {
-			_global_merc_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalMercScript(filename);
-			return qi->EventGlobalMerc(event_id, merc, init, data, extra_data, extra_pointers);
-		}
-	} else {
-		if (_global_merc_quest_status != QuestFailedToLoad) {
-			auto iter = _interfaces.find(_global_merc_quest_status);
-			return iter->second->EventGlobalMerc(event_id, merc, init, data, extra_data, extra_pointers);
-		}
+	auto& s = GetGlobalMercScript();
+	if (!s.HasSub(event_id)) {
+		return 0;
 	}
 
-	return 0;
+	return s.qi->EventGlobalMerc(event_id, merc, init, data, extra_data, extra_pointers);
 }
 
 QuestInterface* QuestParserCollection::GetQIByNPCQuest(uint32 npc_id, std::string& filename)
@@ -1416,11 +1286,16 @@ int QuestParserCollection::DispatchEventNPC(
 	QuestEventID event_id,
 	NPC* npc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
@@ -1436,11 +1311,16 @@ int QuestParserCollection::DispatchEventNPC(
 int QuestParserCollection::DispatchEventPlayer(
 	QuestEventID event_id,
 	Client* client,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
@@ -1458,11 +1338,16 @@ int QuestParserCollection::DispatchEventItem(
 	Client* client,
 	EQ::ItemInstance* inst,
 	Mob* mob,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
@@ -1480,11 +1365,16 @@ int QuestParserCollection::DispatchEventSpell(
 	Mob* mob,
 	Client* client,
 	uint32 spell_id,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
@@ -1501,11 +1391,16 @@ int QuestParserCollection::DispatchEventBot(
 	QuestEventID event_id,
 	Bot* bot,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
@@ -1522,11 +1417,16 @@ int QuestParserCollection::DispatchEventMerc(
 	QuestEventID event_id,
 	Merc* merc,
 	Mob* init,
-	std::string data,
+	std::string_view data,
 	uint32 extra_data,
 	std::vector<std::any>* extra_pointers
 )
 {
+	// only encounters register dispatch handlers
+	if (_encounter_quest_status.empty()) {
+		return 0;
+	}
+
 	int ret = 0;
 
 	for (const auto& e: _load_precedence) {
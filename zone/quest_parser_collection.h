@@ -36,8 +36,12 @@
 
 #include "zone_config.h"
 
+#include <bitset>
+#include <functional>
 #include <list>
 #include <map>
+#include <string_view>
+#include <unordered_map>
 
 #define QuestFailedToLoad 0xFFFFFFFF
 #define QuestUnloaded 0x00
@@ -77,7 +81,7 @@ public:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers = nullptr
 	);
@@ -85,7 +89,7 @@ public:
 	int EventPlayer(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers = nullptr
 	);
@@ -95,7 +99,7 @@ public:
 		Client* client,
 		EQ::ItemInstance* inst,
 		Mob* mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers = nullptr
 	);
@@ -105,7 +109,7 @@ public:
 		Mob* mob,
 		Client* client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers = nullptr
 	);
@@ -113,7 +117,7 @@ public:
 	int EventEncounter(
 		QuestEventID event_id,
 		std::string encounter_name,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers = nullptr
 	);
@@ -122,7 +126,7 @@ public:
 		QuestEventID event_id,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers = nullptr
 	);
@@ -131,7 +135,7 @@ public:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers = nullptr
 	);
@@ -196,6 +200,31 @@ public:
 	void LoadPerlEventExportSettings(PerlEventExportSettings* s);
 
 private:
+	// a loaded script and the events it implements, filled in once at load so an event
+	// nothing handles costs a bit test instead of asking every interface
+	struct QuestScript {
+		uint32                       status = QuestUnloaded;
+		QuestInterface               *qi    = nullptr;
+		std::bitset<_LargestEventID> subs;
+
+		bool HasSub(QuestEventID event_id) const
+		{
+			return qi && event_id >= 0 && event_id < _LargestEventID && subs.test(event_id);
+		}
+	};
+
+	void SetScript(QuestScript& s, QuestInterface* qi, const std::function<bool(QuestEventID)>& has_sub);
+	QuestScript& GetNPCScript(uint32 npc_id);
+	QuestScript& GetGlobalNPCScript();
+	QuestScript& GetPlayerScript();
+	QuestScript& GetGlobalPlayerScript();
+	QuestScript& GetBotScript();
+	QuestScript& GetGlobalBotScript();
+	QuestScript& GetMercScript();
+	QuestScript& GetGlobalMercScript();
+	QuestScript& GetSpellScript(uint32 spell_id);
+	QuestScript& GetItemScript(EQ::ItemInstance* inst);
+
 	bool HasQuestSubLocal(uint32 npc_id, QuestEventID event_id);
 	bool HasQuestSubGlobal(QuestEventID event_id);
 	bool NPCHasEncounterSub(uint32 npc_id, QuestEventID event_id);
@@ -214,7 +243,7 @@ private:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -223,7 +252,7 @@ private:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -231,7 +260,7 @@ private:
 	int EventPlayerLocal(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -239,7 +268,7 @@ private:
 	int EventPlayerGlobal(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -248,7 +277,7 @@ private:
 		QuestEventID event_id,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -257,7 +286,7 @@ private:
 		QuestEventID event_id,
 		Bot *bot,
 		Mob *init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any> *extra_pointers
 	);
@@ -266,7 +295,7 @@ private:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -275,7 +304,7 @@ private:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -296,7 +325,7 @@ private:
 		QuestEventID event_id,
 		NPC* npc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -304,7 +333,7 @@ private:
 	int DispatchEventPlayer(
 		QuestEventID event_id,
 		Client* client,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -314,7 +343,7 @@ private:
 		Client* client,
 		EQ::ItemInstance* inst,
 		Mob* mob,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -324,7 +353,7 @@ private:
 		Mob* mob,
 		Client* client,
 		uint32 spell_id,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -333,7 +362,7 @@ private:
 		QuestEventID event_id,
 		Bot* bot,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -342,7 +371,7 @@ private:
 		QuestEventID event_id,
 		Merc* merc,
 		Mob* init,
-		std::string data,
+		std::string_view data,
 		uint32 extra_data,
 		std::vector<std::any>* extra_pointers
 	);
@@ -351,17 +380,17 @@ private:
 	std::map<uint32, std::string>     _extensions;
 	std::list<QuestInterface*>        _load_precedence;
 
-	std::map<uint32, uint32>      _npc_quest_status;
-	uint32                        _global_npc_quest_status;
-	uint32                        _player_quest_status;
-	uint32                        _global_player_quest_status;
-	uint32                        _bot_quest_status;
-	uint32                        _global_bot_quest_status;
-	uint32                        _merc_quest_status;
-	uint32                        _global_merc_quest_status;
-	std::map<uint32, uint32>      _spell_quest_status;
-	std::map<uint32, uint32>      _item_quest_status;
-	std::map<std::string, uint32> _encounter_quest_status;
+	std::unordered_map<uint32, QuestScript> _npc_quest_status;
+	QuestScript                             _global_npc_quest_status;
+	QuestScript                             _player_quest_status;
+	QuestScript                             _global_player_quest_status;
+	QuestScript                             _bot_quest_status;
+	QuestScript                             _global_bot_quest_status;
+	QuestScript                             _merc_quest_status;
+	QuestScript                             _global_merc_quest_status;
+	std::unordered_map<uint32, QuestScript> _spell_quest_status;
+	std::unordered_map<uint32, QuestScript> _item_quest_status;
+	std::map<std::string, uint32>           _encounter_quest_status;
 };
 
 extern QuestParserCollection *parse;
@@ -84,29 +84,28 @@ QuestManager::~QuestManager() {
 }
 
 void QuestManager::Process() {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->Timer_.Enabled() && cur->Timer_.Check()) {
-			if (cur->mob) {
-				if (cur->mob->IsEncounter()) {
-					parse->EventEncounter(EVENT_TIMER, cur->mob->CastToEncounter()->GetEncounterName(), cur->name, 0, nullptr);
-				} else {
-					parse->EventMob(EVENT_TIMER, cur->mob, nullptr, [&]() { return cur->name; }, 0);
-				}
+	while (!QTimerHeap.empty()) {
+		auto t = QTimerHeap.front();
+		if (static_cast<int32>(t->due - Timer::GetCurrentTime()) > 0) {
+			break;
+		}
 
-				//we MUST reset our iterator since the quest could have removed/added any
-				//number of timers... worst case we have to check a bunch of timers twice
-				cur = QTimerList.begin();
-				end = QTimerList.end();    //dunno if this is needed, cant hurt...
-			}
-			else {
-				cur = QTimerList.erase(cur);
-			}
+		if (!t->mob || !t->Timer_.Enabled()) {
+			EraseQuestTimer(t);
+			continue;
 		}
-		else {
-			++cur;
+
+		// re-arm before the event, the quest is free to set or stop any number of timers including this one
+		t->Timer_.Check();
+		UpdateQuestTimer(t);
+
+		Mob *mob = t->mob;
+		const std::string timer_name = t->name;
+
+		if (mob->IsEncounter()) {
+			parse->EventEncounter(EVENT_TIMER, mob->CastToEncounter()->GetEncounterName(), timer_name, 0, nullptr);
+		} else {
+			parse->EventMob(EVENT_TIMER, mob, nullptr, [&]() { return timer_name; }, 0);
 		}
 	}
 
@@ -138,22 +137,188 @@ void QuestManager::EndQuest() {
 	running_quest run = quests_running_.top();
 	if(run.depop_npc && run.owner->IsNPC()) {
 		//clear out any timers for them...
-		std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-		end = QTimerList.end();
-		while (cur != end) {
-			if (cur->mob == run.owner)
-				cur = QTimerList.erase(cur);
-			else
-				++cur;
-		}
+		EraseQuestTimers(run.owner);
 		run.owner->Depop();
 	}
 	quests_running_.pop();
 }
 
 void QuestManager::ClearAllTimers() {
-	QTimerList.clear();
+	QTimerHeap.clear();
+	QTimers.clear();
+}
+
+QuestManager::QuestTimer *QuestManager::GetQuestTimer(Mob *mob, const std::string &timer_name)
+{
+	auto m = QTimers.find(mob);
+	if (m == QTimers.end()) {
+		return nullptr;
+	}
+
+	auto e = m->second.find(timer_name);
+	return e != m->second.end() ? &e->second : nullptr;
+}
+
+// restarts an existing timer the way Timer::Start(ms, false) always has, otherwise creates it
+void QuestManager::StartQuestTimer(Mob *mob, const std::string &timer_name, uint32 milliseconds)
+{
+	auto t = GetQuestTimer(mob, timer_name);
+	if (t) {
+		t->Timer_.Start(milliseconds, false);
+		UpdateQuestTimer(t);
+		return;
+	}
+
+	auto &timers = QTimers[mob];
+	t = &timers.emplace(timer_name, QuestTimer(milliseconds, mob, timer_name)).first->second;
+
+	t->sequence   = QTimerSequence++;
+	t->due        = t->Timer_.GetStartTime() + t->Timer_.GetDuration() + 1;
+	t->heap_index = QTimerHeap.size();
+	QTimerHeap.push_back(t);
+	QuestTimerSiftUp(t->heap_index);
+}
+
+void QuestManager::EraseQuestTimer(QuestTimer *t)
+{
+	const size_t index = t->heap_index;
+	const size_t last  = QTimerHeap.size() - 1;
+
+	if (index != last) {
+		auto moved = QTimerHeap[last];
+		QTimerHeap[index] = moved;
+		moved->heap_index = index;
+		QTimerHeap.pop_back();
+
+		QuestTimerSiftUp(index);
+		QuestTimerSiftDown(moved->heap_index);
+	}
+	else {
+		QTimerHeap.pop_back();
+	}
+
+	auto m = QTimers.find(t->mob);
+	if (m != QTimers.end()) {
+		auto e = m->second.find(t->name);
+		if (e != m->second.end()) {
+			m->second.erase(e);
+		}
+
+		if (m->second.empty()) {
+			QTimers.erase(m);
+		}
+	}
+}
+
+// fires EVENT_TIMER_STOP for each of the mob's timers as it is removed
+void QuestManager::StopQuestTimers(Mob *mob)
+{
+	auto m = QTimers.find(mob);
+	if (m == QTimers.end()) {
+		return;
+	}
+
+	std::vector<std::string> timer_names;
+	timer_names.reserve(m->second.size());
+	for (const auto &e : m->second) {
+		timer_names.push_back(e.first);
+	}
+
+	for (const auto &timer_name : timer_names) {
+		if (!GetQuestTimer(mob, timer_name)) {
+			continue;
+		}
+
+		parse->EventMob(EVENT_TIMER_STOP, mob, nullptr, [&]() { return timer_name; });
+
+		if (auto t = GetQuestTimer(mob, timer_name)) {
+			EraseQuestTimer(t);
+		}
+	}
+}
+
+void QuestManager::EraseQuestTimers(Mob *mob)
+{
+	auto m = QTimers.find(mob);
+	if (m == QTimers.end()) {
+		return;
+	}
+
+	std::vector<QuestTimer *> timers;
+	timers.reserve(m->second.size());
+	for (auto &e : m->second) {
+		timers.push_back(&e.second);
+	}
+
+	for (auto t : timers) {
+		EraseQuestTimer(t);
+	}
+}
+
+// call after anything that changed the timer's start or duration
+void QuestManager::UpdateQuestTimer(QuestTimer *t)
+{
+	t->due = t->Timer_.GetStartTime() + t->Timer_.GetDuration() + 1;
+	QuestTimerSiftUp(t->heap_index);
+	QuestTimerSiftDown(t->heap_index);
+}
+
+bool QuestManager::QuestTimerBefore(const QuestTimer *a, const QuestTimer *b) const
+{
+	if (a->due != b->due) {
+		return static_cast<int32>(a->due - b->due) < 0;
+	}
+
+	return a->sequence < b->sequence;
+}
+
+void QuestManager::QuestTimerSiftUp(size_t index)
+{
+	auto t = QTimerHeap[index];
+	while (index > 0) {
+		const size_t parent = (index - 1) / 2;
+		if (!QuestTimerBefore(t, QTimerHeap[parent])) {
+			break;
+		}
+
+		QTimerHeap[index]             = QTimerHeap[parent];
+		QTimerHeap[index]->heap_index = index;
+		index = parent;
+	}
+
+	QTimerHeap[index] = t;
+	t->heap_index     = index;
+}
+
+void QuestManager::QuestTimerSiftDown(size_t index)
+{
+	const size_t size = QTimerHeap.size();
+	if (index >= size) {
+		return;
+	}
+
+	auto t = QTimerHeap[index];
+	while (true) {
+		size_t child = index * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+
+		if (child + 1 < size && QuestTimerBefore(QTimerHeap[child + 1], QTimerHeap[child])) {
+			child++;
+		}
+
+		if (!QuestTimerBefore(QTimerHeap[child], t)) {
+			break;
+		}
+
+		QTimerHeap[index]             = QTimerHeap[child];
+		QTimerHeap[index]->heap_index = index;
+		index = child;
+	}
+
+	QTimerHeap[index] = t;
+	t->heap_index     = index;
 }
 
 //quest perl functions
@@ -545,19 +710,7 @@ void QuestManager::settimer(const std::string& timer_name, uint32 seconds, Mob*
 		);
 	};
 
-	if (!QTimerList.empty()) {
-		for (auto& e : QTimerList) {
-			if (e.mob && e.mob == mob && e.name == timer_name) {
-				e.Timer_.Start(seconds * 1000, false);
-
-				parse->EventMob(EVENT_TIMER_START, mob, nullptr, f);
-
-				return;
-			}
-		}
-	}
-
-	QTimerList.emplace_back(QuestTimer(seconds * 1000, mob, timer_name));
+	StartQuestTimer(mob, timer_name, seconds * 1000);
 
 	parse->EventMob(EVENT_TIMER_START, mob, nullptr, f);
 }
@@ -594,19 +747,7 @@ void QuestManager::settimerMS(const std::string& timer_name, uint32 milliseconds
 		return;
 	}
 
-	if (!QTimerList.empty()) {
-		for (auto& e : QTimerList) {
-			if (e.mob && e.mob == owner && e.name == timer_name) {
-				e.Timer_.Start(milliseconds, false);
-
-				parse->EventMob(EVENT_TIMER_START, owner, nullptr, f);
-
-				return;
-			}
-		}
-	}
-
-	QTimerList.emplace_back(QuestTimer(milliseconds, owner, timer_name));
+	StartQuestTimer(owner, timer_name, milliseconds);
 
 	parse->EventMob(EVENT_TIMER_START, owner, nullptr, f);
 }
@@ -632,19 +773,7 @@ void QuestManager::settimerMS(const std::string& timer_name, uint32 milliseconds
 		);
 	};
 
-	if (!QTimerList.empty()) {
-		for (auto& e : QTimerList) {
-			if (e.mob && e.mob == m && e.name == timer_name) {
-				e.Timer_.Start(milliseconds, false);
-
-				parse->EventMob(EVENT_TIMER_START, m, nullptr, f);
-
-				return;
-			}
-		}
-	}
-
-	QTimerList.emplace_back(QuestTimer(milliseconds, m, timer_name));
+	StartQuestTimer(m, timer_name, milliseconds);
 
 	parse->EventMob(EVENT_TIMER_START, m, nullptr, f);
 }
@@ -667,17 +796,15 @@ void QuestManager::stoptimer(const std::string& timer_name)
 		return;
 	}
 
-	if (QTimerList.empty()) {
+	if (!GetQuestTimer(owner, timer_name)) {
 		return;
 	}
 
-	for (auto e = QTimerList.begin(); e != QTimerList.end(); ++e) {
-		if (e->mob && e->mob == owner && e->name == timer_name) {
-			parse->EventMob(EVENT_TIMER_STOP, owner, nullptr, [&]() { return timer_name; });
+	parse->EventMob(EVENT_TIMER_STOP, owner, nullptr, [&]() { return timer_name; });
 
-			QTimerList.erase(e);
-			break;
-		}
+	// looked up again, the stop event may have already removed it
+	if (auto t = GetQuestTimer(owner, timer_name)) {
+		EraseQuestTimer(t);
 	}
 }
 
@@ -694,17 +821,14 @@ void QuestManager::stoptimer(const std::string& timer_name, Mob* m)
 		return;
 	}
 
-	if (QTimerList.empty()) {
+	if (!GetQuestTimer(m, timer_name)) {
 		return;
 	}
 
-	for (auto e = QTimerList.begin(); e != QTimerList.end(); ++e) {
-		if (e->mob && e->mob == m) {
-			parse->EventMob(EVENT_TIMER_STOP, m, nullptr, [&]() { return timer_name; });
+	parse->EventMob(EVENT_TIMER_STOP, m, nullptr, [&]() { return timer_name; });
 
-			QTimerList.erase(e);
-			break;
-		}
+	if (auto t = GetQuestTimer(m, timer_name)) {
+		EraseQuestTimer(t);
 	}
 }
 
@@ -735,19 +859,7 @@ void QuestManager::stopalltimers()
 		return;
 	}
 
-	if (QTimerList.empty()) {
-		return;
-	}
-
-	for (auto e = QTimerList.begin(); e != QTimerList.end();) {
-		if (e->mob && e->mob == owner) {
-			parse->EventMob(EVENT_TIMER_STOP, owner, nullptr, [&]() { return e->name; });
-
-			e = QTimerList.erase(e);
-		} else {
-			++e;
-		}
-	}
+	StopQuestTimers(owner);
 }
 
 void QuestManager::stopalltimers(EQ::ItemInstance* inst)
@@ -777,19 +889,7 @@ void QuestManager::stopalltimers(Mob* m)
 		return;
 	}
 
-	if (QTimerList.empty()) {
-		return;
-	}
-
-	for (auto e = QTimerList.begin(); e != QTimerList.end();) {
-		if (e->mob && e->mob == m) {
-			parse->EventMob(EVENT_TIMER_STOP, m, nullptr, [&]() { return e->name; });
-
-			e = QTimerList.erase(e);
-		} else {
-			++e;
-		}
-	}
+	StopQuestTimers(m);
 }
 
 void QuestManager::pausetimer(const std::string& timer_name, Mob* m)
@@ -806,7 +906,7 @@ void QuestManager::pausetimer(const std::string& timer_name, Mob* m)
 		return;
 	}
 
-	if (QTimerList.empty()) {
+	if (QTimers.empty()) {
 		return;
 	}
 
@@ -819,14 +919,9 @@ void QuestManager::pausetimer(const std::string& timer_name, Mob* m)
 
 	uint32 milliseconds = 0;
 
-	if (!QTimerList.empty()) {
-		for (auto e = QTimerList.begin(); e != QTimerList.end(); ++e) {
-			if (e->mob && e->mob == mob && e->name == timer_name) {
-				milliseconds = e->Timer_.GetRemainingTime();
-				QTimerList.erase(e);
-				break;
-			}
-		}
+	if (auto t = GetQuestTimer(mob, timer_name)) {
+		milliseconds = t->Timer_.GetRemainingTime();
+		EraseQuestTimer(t);
 	}
 
 	PTimerList.emplace_back(
@@ -889,26 +984,23 @@ void QuestManager::resumetimer(const std::string& timer_name, Mob* m)
 		);
 	};
 
-	if (!QTimerList.empty()) {
-		for (auto e : QTimerList) {
-			if (e.mob && e.mob == mob && e.name == timer_name) {
-				e.Timer_.Enable();
-				e.Timer_.Start(milliseconds, false);
-				LogQuests(
-					"Resuming timer [{}] for [{}] with [{}] ms remaining",
-					timer_name,
-					owner->GetName(),
-					milliseconds
-				);
+	if (auto t = GetQuestTimer(mob, timer_name)) {
+		t->Timer_.Enable();
+		t->Timer_.Start(milliseconds, false);
+		UpdateQuestTimer(t);
+		LogQuests(
+			"Resuming timer [{}] for [{}] with [{}] ms remaining",
+			timer_name,
+			owner->GetName(),
+			milliseconds
+		);
 
-				parse->EventMob(EVENT_TIMER_RESUME, mob, nullptr, f);
+		parse->EventMob(EVENT_TIMER_RESUME, mob, nullptr, f);
 
-				return;
-			}
-		}
+		return;
 	}
 
-	QTimerList.emplace_back(QuestTimer(milliseconds, mob, timer_name));
+	StartQuestTimer(mob, timer_name, milliseconds);
 
 	parse->EventMob(EVENT_TIMER_RESUME, mob, nullptr, f);
 
@@ -960,15 +1052,7 @@ bool QuestManager::hastimer(const std::string& timer_name, Mob* m)
 		return false;
 	}
 
-	const auto& e = std::find_if(
-		QTimerList.begin(),
-		QTimerList.end(),
-		[&timer_name, &mob](QuestTimer e) {
-			return e.mob && e.mob == mob && e.name == timer_name;
-		}
-	);
-
-	return e != QTimerList.end();
+	return GetQuestTimer(mob, timer_name) != nullptr;
 }
 
 uint32 QuestManager::getremainingtimeMS(const std::string& timer_name, Mob* m)
@@ -985,15 +1069,9 @@ uint32 QuestManager::getremainingtimeMS(const std::string& timer_name, Mob* m)
 		return 0;
 	}
 
-	const auto& e = std::find_if(
-		QTimerList.begin(),
-		QTimerList.end(),
-		[&timer_name, &mob](QuestTimer e) {
-			return e.mob && e.mob == mob && e.name == timer_name;
-		}
-	);
+	const auto t = GetQuestTimer(mob, timer_name);
 
-	return e != QTimerList.end() ? e->Timer_.GetRemainingTime() : 0;
+	return t ? t->Timer_.GetRemainingTime() : 0;
 }
 
 uint32 QuestManager::gettimerdurationMS(const std::string& timer_name, Mob* m)
@@ -1010,15 +1088,9 @@ uint32 QuestManager::gettimerdurationMS(const std::string& timer_name, Mob* m)
 		return 0;
 	}
 
-	const auto& e = std::find_if(
-		QTimerList.begin(),
-		QTimerList.end(),
-		[&timer_name, &mob](QuestTimer e) {
-			return e.mob && e.mob == mob && e.name == timer_name;
-		}
-	);
+	const auto t = GetQuestTimer(mob, timer_name);
 
-	return e != QTimerList.end() ? e->Timer_.GetDuration() : 0;
+	return t ? t->Timer_.GetDuration() : 0;
 }
 
 void QuestManager::emote(const char *str) {
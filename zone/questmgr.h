@@ -23,6 +23,8 @@
 
 #include <list>
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 class Client;
 class Mob;
@@ -393,6 +395,9 @@ private:
 		Mob*   mob;
 		std::string name;
 		Timer Timer_;
+		uint32 due        = 0; // the current_time at which Timer_ next passes Check()
+		uint64 sequence   = 0; // creation order, timers due together fire in the order they were set
+		size_t heap_index = 0;
 	};
 	class SignalTimer {
 	public:
@@ -401,7 +406,22 @@ private:
 		int signal_id;
 		Timer Timer_;
 	};
-	std::list<QuestTimer>	QTimerList;
+	// quest timers are owned by a per mob, per name index and ordered by expiry in a min-heap of pointers
+	// into it, so set / stop / pause are a lookup plus O(log n) and Process only touches due timers
+	std::unordered_map<Mob *, std::unordered_map<std::string, QuestTimer>> QTimers;
+	std::vector<QuestTimer *> QTimerHeap;
+	uint64 QTimerSequence = 0;
+
+	QuestTimer *GetQuestTimer(Mob *mob, const std::string &timer_name);
+	void StartQuestTimer(Mob *mob, const std::string &timer_name, uint32 milliseconds);
+	void EraseQuestTimer(QuestTimer *t);
+	void EraseQuestTimers(Mob *mob);
+	void StopQuestTimers(Mob *mob);
+	void UpdateQuestTimer(QuestTimer *t);
+	bool QuestTimerBefore(const QuestTimer *a, const QuestTimer *b) const;
+	void QuestTimerSiftUp(size_t index);
+	void QuestTimerSiftDown(size_t index);
+
 	std::list<SignalTimer>	STimerList;
 	std::list<PausedTimer>	PTimerList;
 };
@@ -5747,9 +5747,7 @@ void Mob::Spin() {
 		h=GetHeading()+5;
 
 		if (IsCorpse() || (IsClient() && !IsAIControlled())) {
-			m_Position.x = x;
-			m_Position.y = y;
-			m_Position.z = z;
+			SetPosition(x, y, z);
 			mMovementManager->SendCommandToClients(this, 0.0, 0.0, 0.0, 0.0, 0, ClientRangeAny);
 		}
 		else {
@@ -45,6 +45,54 @@ ClientTaskState::~ClientTaskState()
 {
 }
 
+ClientTaskState::UnsavedState ClientTaskState::GetUnsavedState() const
+{
+	UnsavedState state;
+	state.last_completed_task_loaded = m_last_completed_task_loaded;
+
+	for (int i = 0; i < MAXACTIVEQUESTS + 2; ++i) {
+		const auto &t = m_active_tasks[i];
+		if (t.task_id == TASKSLOTEMPTY) {
+			continue;
+		}
+
+		UnsavedTask task;
+		task.index   = i;
+		task.task_id = t.task_id;
+		task.updated = t.updated;
+
+		bool dirty = t.updated;
+		for (int a = 0; a < MAXACTIVITIESPERTASK; ++a) {
+			task.activity_updated[a] = t.activity[a].updated;
+			dirty |= t.activity[a].updated;
+		}
+
+		if (dirty) {
+			state.tasks.push_back(task);
+		}
+	}
+
+	return state;
+}
+
+void ClientTaskState::RestoreUnsavedState(const UnsavedState &state)
+{
+	// only ever marks more to be written, anything changed since is already dirty
+	m_last_completed_task_loaded = std::min(m_last_completed_task_loaded, state.last_completed_task_loaded);
+
+	for (const auto &task : state.tasks) {
+		auto &t = m_active_tasks[task.index];
+		if (t.task_id != task.task_id) {
+			continue;
+		}
+
+		t.updated |= task.updated;
+		for (int a = 0; a < MAXACTIVITIESPERTASK; ++a) {
+			t.activity[a].updated |= task.activity_updated[a];
+		}
+	}
+}
+
 void ClientTaskState::SendTaskHistory(Client *client, int task_index)
 {
 
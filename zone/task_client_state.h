@@ -89,6 +89,23 @@ public:
 
 	inline bool HasFreeTaskSlot() { return m_active_task.task_id == TASKSLOTEMPTY; }
 
+	// the dirty flags and completed task cursor TaskManager::SaveClientState clears as it writes,
+	// taken before a save so one that fails to commit can put them back
+	struct UnsavedTask {
+		int  index;
+		int  task_id;
+		bool updated;
+		bool activity_updated[MAXACTIVITIESPERTASK];
+	};
+
+	struct UnsavedState {
+		int                      last_completed_task_loaded;
+		std::vector<UnsavedTask> tasks;
+	};
+
+	UnsavedState GetUnsavedState() const;
+	void RestoreUnsavedState(const UnsavedState &state);
+
 	friend class TaskManager;
 
 	// wrapper to call internal IncrementDoneCount
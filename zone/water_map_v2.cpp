@@ -1,4 +1,9 @@
 #include "water_map_v2.h"
+#include "../common/eqemu_logsys.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 WaterMapV2::WaterMapV2() {
 }
@@ -7,6 +12,59 @@ WaterMapV2::~WaterMapV2() {
 }
 
 WaterRegionType WaterMapV2::ReturnRegionType(const glm::vec3& location) const {
+	if (region_tree.empty()) {
+		return RegionTypeNormal;
+	}
+
+	const glm::vec3 point(location.y, location.x, location.z);
+
+	// regions can overlap and the first one in file order wins, so keep the lowest matching index
+	// and skip any subtree that can't beat it
+	uint32 best = std::numeric_limits<uint32>::max();
+	uint32 stack[64];
+	int    stack_size = 0;
+
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const uint32 node_index = stack[--stack_size];
+		const auto   &node      = region_tree[node_index];
+
+		if (node.min_region >= best ||
+			point.x < node.min.x || point.x > node.max.x ||
+			point.y < node.min.y || point.y > node.max.y ||
+			point.z < node.min.z || point.z > node.max.z) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32 i = node.first; i < node.first + node.count; ++i) {
+				const uint32 region_index = region_tree_indices[i];
+				if (region_index < best && regions[region_index].second.ContainsPoint(point)) {
+					best = region_index;
+				}
+			}
+
+			continue;
+		}
+
+		const uint32 left  = node_index + 1;
+		const uint32 right = node.first;
+
+		// visit the side holding lower region indices first so it can prune the other
+		if (region_tree[left].min_region <= region_tree[right].min_region) {
+			stack[stack_size++] = right;
+			stack[stack_size++] = left;
+		}
+		else {
+			stack[stack_size++] = left;
+			stack[stack_size++] = right;
+		}
+	}
+
+	return best == std::numeric_limits<uint32>::max() ? RegionTypeNormal : regions[best].first;
+}
+
+WaterRegionType WaterMapV2::ReturnRegionTypeLinear(const glm::vec3& location) const {
 	size_t sz = regions.size();
 	for(size_t i = 0; i < sz; ++i) {
 		auto const &region = regions[i];
@@ -119,5 +177,112 @@ bool WaterMapV2::Load(FILE *fp) {
 			OrientedBoundingBox(glm::vec3(x, y, z), glm::vec3(x_rot, y_rot, z_rot), glm::vec3(x_scale, y_scale, z_scale), glm::vec3(x_extent, y_extent, z_extent))));
 	}
 
+	BuildRegionTree();
+
 	return true;
 }
+
+void WaterMapV2::BuildRegionTree() {
+	region_tree.clear();
+	region_tree_indices.clear();
+
+	if (regions.empty()) {
+		return;
+	}
+
+	std::vector<glm::vec3> bounds_min(regions.size());
+	std::vector<glm::vec3> bounds_max(regions.size());
+
+	// keeps degenerate boxes in the tree with finite (if huge) bounds so the split math stays sane
+	const float limit = 1e30f;
+
+	region_tree_indices.reserve(regions.size());
+	for (uint32 i = 0; i < regions.size(); ++i) {
+		glm::vec3 &b_min = bounds_min[i];
+		glm::vec3 &b_max = bounds_max[i];
+
+		regions[i].second.GetWorldBounds(b_min, b_max);
+
+		for (int axis = 0; axis < 3; ++axis) {
+			if (std::isnan(b_min[axis]) || std::isnan(b_max[axis])) {
+				b_min[axis] = -limit;
+				b_max[axis] = limit;
+			}
+
+			b_min[axis] = std::clamp(b_min[axis], -limit, limit);
+			b_max[axis] = std::clamp(b_max[axis], -limit, limit);
+
+			// pad for float error between the forward transform here and the inverse one in ContainsPoint
+			const float pad = std::max(std::abs(b_min[axis]), std::abs(b_max[axis])) * 0.0001f + 0.1f;
+			b_min[axis] -= pad;
+			b_max[axis] += pad;
+		}
+
+		region_tree_indices.push_back(i);
+	}
+
+	region_tree.reserve(regions.size() * 2);
+	BuildRegionTreeNode(bounds_min, bounds_max, 0, static_cast<uint32>(region_tree_indices.size()));
+
+	LogInfo("Built water region tree with [{}] nodes over [{}] regions", region_tree.size(), regions.size());
+}
+
+uint32 WaterMapV2::BuildRegionTreeNode(const std::vector<glm::vec3> &bounds_min, const std::vector<glm::vec3> &bounds_max, uint32 first, uint32 count) {
+	const uint32 leaf_size  = 4;
+	const uint32 node_index = static_cast<uint32>(region_tree.size());
+	region_tree.emplace_back();
+
+	RegionTreeNode node;
+	node.min        = glm::vec3(std::numeric_limits<float>::max());
+	node.max        = glm::vec3(std::numeric_limits<float>::lowest());
+	node.min_region = std::numeric_limits<uint32>::max();
+
+	glm::vec3 centroid_min(std::numeric_limits<float>::max());
+	glm::vec3 centroid_max(std::numeric_limits<float>::lowest());
+
+	for (uint32 i = first; i < first + count; ++i) {
+		const uint32 region_index = region_tree_indices[i];
+
+		node.min        = glm::min(node.min, bounds_min[region_index]);
+		node.max        = glm::max(node.max, bounds_max[region_index]);
+		node.min_region = std::min(node.min_region, region_index);
+
+		const glm::vec3 centroid = (bounds_min[region_index] + bounds_max[region_index]) * 0.5f;
+		centroid_min = glm::min(centroid_min, centroid);
+		centroid_max = glm::max(centroid_max, centroid);
+	}
+
+	if (count <= leaf_size) {
+		node.first              = first;
+		node.count              = count;
+		region_tree[node_index] = node;
+		return node_index;
+	}
+
+	// split at the median centroid along the widest axis
+	const glm::vec3 extent = centroid_max - centroid_min;
+	int axis = 0;
+	if (extent.y > extent.x) {
+		axis = 1;
+	}
+	if (extent.z > extent[axis]) {
+		axis = 2;
+	}
+
+	const uint32 mid = first + count / 2;
+	std::nth_element(
+		region_tree_indices.begin() + first,
+		region_tree_indices.begin() + mid,
+		region_tree_indices.begin() + first + count,
+		[&](uint32 a, uint32 b) {
+			return (bounds_min[a][axis] + bounds_max[a][axis]) < (bounds_min[b][axis] + bounds_max[b][axis]);
+		}
+	);
+
+	BuildRegionTreeNode(bounds_min, bounds_max, first, mid - first);
+	node.first = BuildRegionTreeNode(bounds_min, bounds_max, mid, first + count - mid);
+	node.count = 0;
+
+	region_tree[node_index] = node;
+	return node_index;
+}
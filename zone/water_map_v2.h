@@ -20,10 +20,29 @@ public:
 	virtual bool InPvP(const glm::vec3& location) const;
 	virtual bool InZoneLine(const glm::vec3& location) const;
 
+	// reference scan over every region, used to verify the region tree
+	WaterRegionType ReturnRegionTypeLinear(const glm::vec3& location) const;
+	size_t GetRegionCount() const { return regions.size(); }
+
 protected:
 	virtual bool Load(FILE *fp);
 
+	// bounding volume hierarchy over the world space bounds of each region
+	// interior nodes have count 0, their left child directly follows them and right is stored in first
+	struct RegionTreeNode {
+		glm::vec3 min;
+		glm::vec3 max;
+		uint32    first;
+		uint32    count;
+		uint32    min_region;
+	};
+
+	void BuildRegionTree();
+	uint32 BuildRegionTreeNode(const std::vector<glm::vec3> &bounds_min, const std::vector<glm::vec3> &bounds_max, uint32 first, uint32 count);
+
 	std::vector<std::pair<WaterRegionType, OrientedBoundingBox>> regions;
+	std::vector<RegionTreeNode> region_tree;
+	std::vector<uint32> region_tree_indices;
 	friend class WaterMap;
 };
 
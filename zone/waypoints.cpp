@@ -728,9 +728,7 @@ void Mob::SendTo(float new_x, float new_y, float new_z) {
 		entity_list.ProcessMove(CastToNPC(), new_x, new_y, new_z);
 	}
 
-	m_Position.x = new_x;
-	m_Position.y = new_y;
-	m_Position.z = new_z;
+	SetPosition(new_x, new_y, new_z);
 	LogAIDetail("Sent To ({}, {}, {})", new_x, new_y, new_z);
 
 	if (flymode == GravityBehavior::Flying)
@@ -762,9 +760,7 @@ void Mob::SendToFixZ(float new_x, float new_y, float new_z) {
 		entity_list.ProcessMove(CastToNPC(), new_x, new_y, new_z + 0.1);
 	}
 
-	m_Position.x = new_x;
-	m_Position.y = new_y;
-	m_Position.z = new_z + 0.1;
+	SetPosition(new_x, new_y, new_z + 0.1);
 
 	if (zone->HasMap() && RuleB(Map, FixPathingZOnSendTo))
 	{
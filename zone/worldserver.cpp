@@ -3378,16 +3378,7 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 	}
 	case ServerOP_ChangeSharedMem:
 	{
-		std::string hotfix_name = std::string((char*)pack->pBuffer);
-		LogInfo("Loading items");
-		if (!content_db.LoadItems(hotfix_name)) {
-			LogError("Loading items failed!");
-		}
-
-		LogInfo("Loading spells");
-		if (!content_db.LoadSpells(hotfix_name, &SPDAT_RECORDS, &spells)) {
-			LogError("Loading spells failed!");
-		}
+		QueueSharedMemoryReload(std::string((char*)pack->pBuffer));
 		break;
 	}
 	case ServerOP_CZClientMessageString:
@@ -4525,6 +4516,63 @@ void WorldServer::QueueReload(ServerReload::Request r)
 	m_reload_mutex.unlock();
 }
 
+void WorldServer::QueueSharedMemoryReload(const std::string &prefix)
+{
+	LogInfo("Queuing shared memory reload for prefix [{}]", prefix);
+
+	m_shared_memory_reload = prefix;
+}
+
+bool WorldServer::ProcessSharedMemoryReload()
+{
+	if (!m_shared_memory_reload) {
+		return true;
+	}
+
+	const std::string prefix = *m_shared_memory_reload;
+	m_shared_memory_reload.reset();
+
+	// items and spells are tracked apart, so a hotfix sent again after a partial failure only remaps what is stale
+	const uint64 generation = SharedDatabase::ReadSharedMemoryGeneration(prefix);
+
+	bool success = true;
+	if (prefix == database.GetItemsPrefix() && generation == database.GetItemsGeneration()) {
+		LogInfo("Items for prefix [{}] generation [{}] are already mapped", prefix, generation);
+	}
+	else {
+		LogInfo("Loading items");
+		if (!database.LoadItems(prefix)) {
+			LogError("Loading items failed!");
+			success = false;
+		}
+	}
+
+	if (prefix == database.GetSpellsPrefix() && generation == database.GetSpellsGeneration()) {
+		LogInfo("Spells for prefix [{}] generation [{}] are already mapped", prefix, generation);
+	}
+	else {
+		LogInfo("Loading spells");
+		if (!database.LoadSpells(prefix, &SPDAT_RECORDS, &spells)) {
+			LogError("Loading spells failed!");
+			success = false;
+		}
+	}
+
+	if (!success) {
+		LogError(
+			"Shared memory reload for prefix [{}] generation [{}] failed, the zone keeps items [{}] generation [{}] and spells [{}] generation [{}]",
+			prefix,
+			generation,
+			database.GetItemsPrefix(),
+			database.GetItemsGeneration(),
+			database.GetSpellsPrefix(),
+			database.GetSpellsGeneration()
+		);
+	}
+
+	return success;
+}
+
 void WorldServer::ProcessReload(const ServerReload::Request& request)
 {
 	LogInfo(
@@ -4693,6 +4741,9 @@ void WorldServer::ProcessReload(const ServerReload::Request& request)
 
 		case ServerReload::Type::ZonePoints:
 			content_db.LoadStaticZonePoints(&zone->zone_point_list, zone->GetShortName(), zone->GetInstanceVersion());
+			if (zone->pathing) {
+				zone->pathing->ClearRouteCache();
+			}
 			break;
 
 		case ServerReload::Type::ZoneData:
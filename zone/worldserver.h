@@ -23,6 +23,8 @@
 #include "zone_event_scheduler.h"
 #include "../common/server_reload_types.h"
 
+#include <optional>
+
 class ServerPacket;
 class EQApplicationPacket;
 class Client;
@@ -64,6 +66,10 @@ public:
 	void RequestTellQueue(const char *who);
 	void QueueReload(ServerReload::Request r);
 	void ProcessReload(const ServerReload::Request &request);
+	void QueueSharedMemoryReload(const std::string &prefix);
+	// remaps items and spells, run from the top of the zone loop so nothing in the frame holds old pointers
+	// false when either failed to load, whatever failed keeps its previous generation
+	bool ProcessSharedMemoryReload();
 private:
 	virtual void OnConnected();
 
@@ -82,8 +88,9 @@ private:
 
 	// server reload queue
 	std::unique_ptr<EQ::Timer>           m_process_timer;
-	std::mutex                           m_reload_mutex   = {};
-	std::map<int, ServerReload::Request> m_reload_queue   = {};
+	std::mutex                           m_reload_mutex         = {};
+	std::map<int, ServerReload::Request> m_reload_queue         = {};
+	std::optional<std::string>           m_shared_memory_reload = {};
 public:
 	ZoneEventScheduler *GetScheduler() const;
 	void SetScheduler(ZoneEventScheduler *scheduler);
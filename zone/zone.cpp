@@ -1255,6 +1255,10 @@ void Zone::ReloadStaticData() {
 		LogError("Loading static zone points failed");
 	}
 
+	if (pathing) {
+		pathing->ClearRouteCache();
+	}
+
 	LogInfo("Reloading traps");
 	entity_list.RemoveAllTraps();
 	if (!content_db.LoadTraps(GetShortName(), GetInstanceVersion()))
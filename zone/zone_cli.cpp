@@ -29,7 +29,13 @@ void ZoneCLI::CommandHandler(int argc, char **argv)
 	auto function_map = EQEmuCommand::function_map;
 
 	// Register commands
+	function_map["benchmark:broadcast"] = &ZoneCLI::BenchmarkBroadcast;
 	function_map["benchmark:databuckets"] = &ZoneCLI::BenchmarkDatabuckets;
+	function_map["benchmark:daybreak-compression"] = &ZoneCLI::BenchmarkDaybreakCompression;
+	function_map["benchmark:item-lookups"] = &ZoneCLI::BenchmarkItemLookups;
+	function_map["benchmark:repository-load"] = &ZoneCLI::BenchmarkRepositoryLoad;
+	function_map["benchmark:timers"] = &ZoneCLI::BenchmarkTimers;
+	function_map["benchmark:water-map"] = &ZoneCLI::BenchmarkWaterMap;
 	function_map["sidecar:serve-http"] = &ZoneCLI::SidecarServeHttp;
 	function_map["tests:databuckets"] = &ZoneCLI::DataBuckets;
 	function_map["tests:npc-handins"] = &ZoneCLI::NpcHandins;
@@ -39,7 +45,13 @@ void ZoneCLI::CommandHandler(int argc, char **argv)
 }
 
 #include "cli/databuckets.cpp"
+#include "cli/benchmark_broadcast.cpp"
 #include "cli/benchmark_databuckets.cpp"
+#include "cli/benchmark_daybreak_compression.cpp"
+#include "cli/benchmark_item_lookups.cpp"
+#include "cli/benchmark_repository_load.cpp"
+#include "cli/benchmark_timers.cpp"
+#include "cli/benchmark_water_map.cpp"
 #include "cli/sidecar_serve_http.cpp"
 #include "cli/npc_handins.cpp"
 #include "cli/npc_handins_multiquest.cpp"
@@ -6,7 +6,13 @@
 class ZoneCLI {
 public:
 	static void CommandHandler(int argc, char **argv);
+	static void BenchmarkBroadcast(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void BenchmarkDatabuckets(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkDaybreakCompression(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkItemLookups(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkRepositoryLoad(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkTimers(int argc, char **argv, argh::parser &cmd, std::string &description);
+	static void BenchmarkWaterMap(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static void SidecarServeHttp(int argc, char **argv, argh::parser &cmd, std::string &description);
 	static bool RanConsoleCommand(int argc, char **argv);
 	static bool RanSidecarCommand(int argc, char **argv);
@@ -0,0 +1,212 @@
+#include "zone_profiler.h"
+#include <algorithm>
+
+ZoneProfiler::ZoneProfiler()
+{
+	Reset();
+}
+
+void ZoneProfiler::SetEnabled(bool enabled)
+{
+	if (m_enabled == enabled) {
+		return;
+	}
+
+	// a frame that was half recorded would report a bogus total
+	m_enabled  = enabled;
+	m_in_frame = false;
+	m_stack.clear();
+}
+
+void ZoneProfiler::Reset()
+{
+	m_nodes.clear();
+	m_stack.clear();
+	m_npcs.clear();
+	m_frames   = 0;
+	m_in_frame = false;
+
+	Node root;
+	root.key = GetKey("frame");
+	root.samples_us.assign(WINDOW_FRAMES, 0);
+	m_nodes.emplace_back(std::move(root));
+}
+
+uint32 ZoneProfiler::GetKey(const std::string &name)
+{
+	auto it = m_keys.find(name);
+	if (it != m_keys.end()) {
+		return it->second;
+	}
+
+	const auto key = static_cast<uint32>(m_key_names.size());
+	m_key_names.push_back(name);
+	m_keys.emplace(name, key);
+
+	return key;
+}
+
+void ZoneProfiler::BeginFrame()
+{
+	if (!m_enabled) {
+		return;
+	}
+
+	m_stack.clear();
+	m_stack.push_back(StackEntry{0, Clock::now()});
+	m_in_frame = true;
+}
+
+void ZoneProfiler::EndFrame()
+{
+	if (!m_enabled || !m_in_frame || m_stack.empty()) {
+		return;
+	}
+
+	const auto elapsed = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_stack.front().start).count());
+	auto       &root   = m_nodes[0];
+	root.frame_ns += elapsed;
+	root.total_ns += elapsed;
+	root.total_calls++;
+
+	m_stack.clear();
+	m_in_frame = false;
+
+	// every node gets a sample each frame, zero when it didn't run, so percentiles are per frame
+	const size_t slot = m_frames % WINDOW_FRAMES;
+	for (auto &n : m_nodes) {
+		n.samples_us[slot] = static_cast<uint32>(std::min<uint64>(n.frame_ns / 1000, UINT32_MAX));
+		n.frame_ns         = 0;
+	}
+
+	m_frames++;
+}
+
+bool ZoneProfiler::Enter(uint32 key)
+{
+	if (!m_in_frame || m_stack.empty()) {
+		return false;
+	}
+
+	m_stack.push_back(StackEntry{FindOrAddChild(m_stack.back().node, key), Clock::now()});
+
+	return true;
+}
+
+void ZoneProfiler::Exit()
+{
+	// the frame may have ended (or been reset) while this scope was open
+	if (m_stack.size() < 2) {
+		return;
+	}
+
+	const auto e       = m_stack.back();
+	const auto elapsed = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - e.start).count());
+	m_stack.pop_back();
+
+	auto &n = m_nodes[e.node];
+	n.frame_ns += elapsed;
+	n.total_ns += elapsed;
+	n.total_calls++;
+}
+
+void ZoneProfiler::RecordNpc(uint32 npc_type_id, const char *name, uint64 elapsed_ns)
+{
+	auto &s = m_npcs[npc_type_id];
+	if (s.name.empty() && name) {
+		s.name = name;
+	}
+
+	s.calls++;
+	s.total_ns += elapsed_ns;
+	s.max_ns = std::max(s.max_ns, elapsed_ns);
+}
+
+uint32 ZoneProfiler::FindOrAddChild(uint32 parent, uint32 key)
+{
+	for (auto child : m_nodes[parent].children) {
+		if (m_nodes[child].key == key) {
+			return child;
+		}
+	}
+
+	const auto index = static_cast<uint32>(m_nodes.size());
+
+	Node n;
+	n.key = key;
+	n.samples_us.assign(WINDOW_FRAMES, 0);
+	m_nodes.emplace_back(std::move(n));
+	m_nodes[parent].children.push_back(index);
+
+	return index;
+}
+
+std::vector<ZoneProfiler::SectionReport> ZoneProfiler::GetSections() const
+{
+	std::vector<SectionReport> out;
+	out.reserve(m_nodes.size());
+	AppendSections(0, 0, out);
+
+	return out;
+}
+
+void ZoneProfiler::AppendSections(uint32 node, uint32 depth, std::vector<SectionReport> &out) const
+{
+	const auto &n     = m_nodes[node];
+	const auto frames = static_cast<size_t>(std::min<uint64>(m_frames, WINDOW_FRAMES));
+
+	SectionReport r{};
+	r.name        = m_key_names[n.key];
+	r.depth       = depth;
+	r.calls       = n.total_calls;
+	r.avg_call_us = n.total_calls ? static_cast<double>(n.total_ns) / n.total_calls / 1000.0 : 0.0;
+
+	if (frames > 0) {
+		std::vector<uint32> s(n.samples_us.begin(), n.samples_us.begin() + frames);
+
+		auto p50 = s.begin() + (frames - 1) / 2;
+		std::nth_element(s.begin(), p50, s.end());
+		r.p50_ms = *p50 / 1000.0;
+
+		auto p99 = s.begin() + (frames - 1) * 99 / 100;
+		std::nth_element(s.begin(), p99, s.end());
+		r.p99_ms = *p99 / 1000.0;
+
+		r.max_ms = *std::max_element(s.begin(), s.end()) / 1000.0;
+	}
+
+	out.push_back(std::move(r));
+
+	for (auto child : n.children) {
+		AppendSections(child, depth + 1, out);
+	}
+}
+
+std::vector<ZoneProfiler::NpcReport> ZoneProfiler::GetTopNpcs(size_t count) const
+{
+	std::vector<NpcReport> out;
+	out.reserve(m_npcs.size());
+
+	for (const auto &e : m_npcs) {
+		NpcReport r{};
+		r.npc_type_id = e.first;
+		r.name        = e.second.name;
+		r.calls       = e.second.calls;
+		r.total_ms    = e.second.total_ns / 1000000.0;
+		r.avg_us      = e.second.calls ? static_cast<double>(e.second.total_ns) / e.second.calls / 1000.0 : 0.0;
+		r.max_us      = e.second.max_ns / 1000.0;
+		out.push_back(std::move(r));
+	}
+
+	std::sort(
+		out.begin(), out.end(), [](const NpcReport &a, const NpcReport &b) {
+			return a.total_ms > b.total_ms;
+		}
+	);
+
+	if (out.size() > count) {
+		out.resize(count);
+	}
+
+	return out;
+}
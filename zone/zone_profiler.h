@@ -0,0 +1,131 @@
+#ifndef EQEMU_ZONE_PROFILER_H
+#define EQEMU_ZONE_PROFILER_H
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../common/types.h"
+
+// Hierarchical frame profiler for the zone loop
+//
+// Scopes form a call tree under a single "frame" root; each node sums the time spent in it during a
+// frame and keeps the last WINDOW_FRAMES frame totals so p50 / p99 can be read at any time. Scopes
+// entered outside of a frame (world packets, libuv callbacks) are ignored rather than misattributed
+//
+// Disabled scopes cost a single branch, keys are interned once per call site through ZONE_PROFILE_SCOPE
+class ZoneProfiler {
+public:
+	static constexpr size_t WINDOW_FRAMES = 1024;
+
+	struct SectionReport {
+		std::string name;
+		uint32      depth;
+		uint64      calls;
+		double      p50_ms;
+		double      p99_ms;
+		double      max_ms;
+		double      avg_call_us;
+	};
+
+	struct NpcReport {
+		uint32      npc_type_id;
+		std::string name;
+		uint64      calls;
+		double      total_ms;
+		double      avg_us;
+		double      max_us;
+	};
+
+	class Scope {
+	public:
+		explicit Scope(uint32 key)
+		{
+			auto &p = ZoneProfiler::Instance();
+			m_active = p.IsEnabled() && p.Enter(key);
+		}
+
+		~Scope()
+		{
+			if (m_active) {
+				ZoneProfiler::Instance().Exit();
+			}
+		}
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		bool m_active;
+	};
+
+	static ZoneProfiler &Instance()
+	{
+		static ZoneProfiler p;
+		return p;
+	}
+
+	inline bool IsEnabled() const { return m_enabled; }
+	void SetEnabled(bool enabled);
+	void Reset();
+
+	uint32 GetKey(const std::string &name);
+
+	void BeginFrame();
+	void EndFrame();
+	bool Enter(uint32 key);
+	void Exit();
+
+	void RecordNpc(uint32 npc_type_id, const char *name, uint64 elapsed_ns);
+
+	inline uint64 GetFrameCount() const { return m_frames; }
+	std::vector<SectionReport> GetSections() const;
+	std::vector<NpcReport> GetTopNpcs(size_t count) const;
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Node {
+		uint32              key;
+		std::vector<uint32> children;
+		uint64              frame_ns    = 0;
+		uint64              total_ns    = 0;
+		uint64              total_calls = 0;
+		std::vector<uint32> samples_us;
+	};
+
+	struct StackEntry {
+		uint32            node;
+		Clock::time_point start;
+	};
+
+	struct NpcStat {
+		std::string name;
+		uint64      calls    = 0;
+		uint64      total_ns = 0;
+		uint64      max_ns   = 0;
+	};
+
+	ZoneProfiler();
+
+	uint32 FindOrAddChild(uint32 parent, uint32 key);
+	void AppendSections(uint32 node, uint32 depth, std::vector<SectionReport> &out) const;
+
+	bool                                    m_enabled  = false;
+	bool                                    m_in_frame = false;
+	uint64                                  m_frames   = 0;
+	std::vector<std::string>                m_key_names;
+	std::unordered_map<std::string, uint32> m_keys;
+	std::vector<Node>                       m_nodes;
+	std::vector<StackEntry>                 m_stack;
+	std::unordered_map<uint32, NpcStat>     m_npcs;
+};
+
+#define ZONE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ZONE_PROFILE_CONCAT(a, b) ZONE_PROFILE_CONCAT_INNER(a, b)
+
+#define ZONE_PROFILE_SCOPE(name) \
+	static const uint32 ZONE_PROFILE_CONCAT(_zone_profile_key_, __LINE__) = ZoneProfiler::Instance().GetKey(name); \
+	ZoneProfiler::Scope ZONE_PROFILE_CONCAT(_zone_profile_scope_, __LINE__)(ZONE_PROFILE_CONCAT(_zone_profile_key_, __LINE__))
+
+#endif //EQEMU_ZONE_PROFILER_H
@@ -1041,10 +1041,27 @@ bool ZoneDatabase::SaveCharacterLeadershipAbilities(uint32 character_id, PlayerP
 	return CharacterLeadershipAbilitiesRepository::ReplaceMany(*this, v);
 }
 
+namespace {
+	// position of a character_data column in the repository's column list, which quotes reserved words
+	size_t CharacterDataColumnIndex(const std::string &column)
+	{
+		static const auto columns = CharacterDataRepository::Columns();
+
+		for (size_t i = 0; i < columns.size(); ++i) {
+			if (columns[i] == column || columns[i] == fmt::format("`{}`", column)) {
+				return i;
+			}
+		}
+
+		return 0;
+	}
+}
+
 bool ZoneDatabase::SaveCharacterData(
 	Client* c,
 	PlayerProfile_Struct* pp,
-	ExtendedProfile_Struct* m_epp
+	ExtendedProfile_Struct* m_epp,
+	bool async
 ) {
 	if (!c) {
 		return false;
@@ -1057,114 +1074,181 @@ bool ZoneDatabase::SaveCharacterData(
 
 	clock_t t = std::clock(); /* Function timer start */
 
-	auto e = CharacterDataRepository::FindOne(database, c->CharacterID());
-	if (!e.id) {
-		return false;
+	// only the columns the zone owns are written, and of those only the ones that changed since this zone
+	// last wrote the row. With nothing to compare against (first save, or the last one failed) every owned
+	// column is written
+	using CharacterData = CharacterDataRepository::CharacterData;
+
+	auto &saved = c->GetSavedCharacterData();
+	auto e      = saved ? *saved : CharacterDataRepository::NewEntity();
+
+	e.id = c->CharacterID();
+
+	decltype(e.changed_columns) owned;
+
+	auto set = [&e, &owned, &saved](auto CharacterData::*field, const char *column, const auto &value) {
+		e.*field = value;
+
+		if (!saved) {
+			owned.set(CharacterDataColumnIndex(column));
+		}
+	};
+
+	set(&CharacterData::account_id, "account_id", c->AccountID());
+	set(&CharacterData::name, "name", pp->name);
+	set(&CharacterData::last_name, "last_name", pp->last_name);
+	set(&CharacterData::gender, "gender", pp->gender);
+	set(&CharacterData::race, "race", pp->race);
+	set(&CharacterData::class_, "class", pp->class_);
+	set(&CharacterData::level, "level", pp->level);
+	set(&CharacterData::deity, "deity", pp->deity);
+	set(&CharacterData::birthday, "birthday", pp->birthday);
+	set(&CharacterData::last_login, "last_login", pp->lastlogin);
+	set(&CharacterData::time_played, "time_played", pp->timePlayedMin);
+	set(&CharacterData::pvp_status, "pvp_status", pp->pvp);
+	set(&CharacterData::level2, "level2", pp->level2);
+	set(&CharacterData::anon, "anon", pp->anon);
+	set(&CharacterData::gm, "gm", pp->gm);
+	set(&CharacterData::intoxication, "intoxication", pp->intoxication);
+	set(&CharacterData::hair_color, "hair_color", pp->haircolor);
+	set(&CharacterData::beard_color, "beard_color", pp->beardcolor);
+	set(&CharacterData::eye_color_1, "eye_color_1", pp->eyecolor1);
+	set(&CharacterData::eye_color_2, "eye_color_2", pp->eyecolor2);
+	set(&CharacterData::hair_style, "hair_style", pp->hairstyle);
+	set(&CharacterData::beard, "beard", pp->beard);
+	set(&CharacterData::ability_time_seconds, "ability_time_seconds", pp->ability_time_seconds);
+	set(&CharacterData::ability_number, "ability_number", pp->ability_number);
+	set(&CharacterData::ability_time_minutes, "ability_time_minutes", pp->ability_time_minutes);
+	set(&CharacterData::ability_time_hours, "ability_time_hours", pp->ability_time_hours);
+	set(&CharacterData::title, "title", pp->title);
+	set(&CharacterData::suffix, "suffix", pp->suffix);
+	set(&CharacterData::exp, "exp", pp->exp);
+	set(&CharacterData::exp_enabled, "exp_enabled", c->IsEXPEnabled());
+	set(&CharacterData::points, "points", pp->points);
+	set(&CharacterData::mana, "mana", pp->mana);
+	set(&CharacterData::cur_hp, "cur_hp", pp->cur_hp);
+	set(&CharacterData::str, "str", pp->STR);
+	set(&CharacterData::sta, "sta", pp->STA);
+	set(&CharacterData::cha, "cha", pp->CHA);
+	set(&CharacterData::dex, "dex", pp->DEX);
+	set(&CharacterData::int_, "int", pp->INT);
+	set(&CharacterData::agi, "agi", pp->AGI);
+	set(&CharacterData::wis, "wis", pp->WIS);
+	set(&CharacterData::face, "face", pp->face);
+	set(&CharacterData::y, "y", pp->y);
+	set(&CharacterData::x, "x", pp->x);
+	set(&CharacterData::z, "z", pp->z);
+	set(&CharacterData::heading, "heading", pp->heading);
+	set(&CharacterData::pvp2, "pvp2", pp->pvp2);
+	set(&CharacterData::pvp_type, "pvp_type", pp->pvptype);
+	set(&CharacterData::autosplit_enabled, "autosplit_enabled", pp->autosplit);
+	set(&CharacterData::zone_change_count, "zone_change_count", pp->zone_change_count);
+	set(&CharacterData::drakkin_heritage, "drakkin_heritage", pp->drakkin_heritage);
+	set(&CharacterData::drakkin_tattoo, "drakkin_tattoo", pp->drakkin_tattoo);
+	set(&CharacterData::drakkin_details, "drakkin_details", pp->drakkin_details);
+	set(&CharacterData::toxicity, "toxicity", pp->toxicity);
+	set(&CharacterData::hunger_level, "hunger_level", pp->hunger_level);
+	set(&CharacterData::thirst_level, "thirst_level", pp->thirst_level);
+	set(&CharacterData::ability_up, "ability_up", pp->ability_up);
+	set(&CharacterData::zone_id, "zone_id", pp->zone_id);
+	set(&CharacterData::zone_instance, "zone_instance", pp->zoneInstance);
+	set(&CharacterData::leadership_exp_on, "leadership_exp_on", pp->leadAAActive);
+	set(&CharacterData::ldon_points_guk, "ldon_points_guk", pp->ldon_points_guk);
+	set(&CharacterData::ldon_points_mir, "ldon_points_mir", pp->ldon_points_mir);
+	set(&CharacterData::ldon_points_mmc, "ldon_points_mmc", pp->ldon_points_mmc);
+	set(&CharacterData::ldon_points_ruj, "ldon_points_ruj", pp->ldon_points_ruj);
+	set(&CharacterData::ldon_points_tak, "ldon_points_tak", pp->ldon_points_tak);
+	set(&CharacterData::ldon_points_available, "ldon_points_available", pp->ldon_points_available);
+	set(&CharacterData::tribute_time_remaining, "tribute_time_remaining", pp->tribute_time_remaining);
+	set(&CharacterData::show_helm, "show_helm", pp->showhelm);
+	set(&CharacterData::career_tribute_points, "career_tribute_points", pp->career_tribute_points);
+	set(&CharacterData::tribute_points, "tribute_points", pp->tribute_points);
+	set(&CharacterData::tribute_active, "tribute_active", pp->tribute_active);
+	set(&CharacterData::endurance, "endurance", pp->endurance);
+	set(&CharacterData::group_leadership_exp, "group_leadership_exp", pp->group_leadership_exp);
+	set(&CharacterData::raid_leadership_exp, "raid_leadership_exp", pp->raid_leadership_exp);
+	set(&CharacterData::group_leadership_points, "group_leadership_points", pp->group_leadership_points);
+	set(&CharacterData::raid_leadership_points, "raid_leadership_points", pp->raid_leadership_points);
+	set(&CharacterData::air_remaining, "air_remaining", pp->air_remaining);
+	set(&CharacterData::pvp_kills, "pvp_kills", pp->PVPKills);
+	set(&CharacterData::pvp_deaths, "pvp_deaths", pp->PVPDeaths);
+	set(&CharacterData::pvp_current_points, "pvp_current_points", pp->PVPCurrentPoints);
+	set(&CharacterData::pvp_career_points, "pvp_career_points", pp->PVPCareerPoints);
+	set(&CharacterData::pvp_best_kill_streak, "pvp_best_kill_streak", pp->PVPBestKillStreak);
+	set(&CharacterData::pvp_worst_death_streak, "pvp_worst_death_streak", pp->PVPWorstDeathStreak);
+	set(&CharacterData::pvp_current_kill_streak, "pvp_current_kill_streak", pp->PVPCurrentKillStreak);
+	set(&CharacterData::aa_points_spent, "aa_points_spent", pp->aapoints_spent);
+	set(&CharacterData::aa_exp, "aa_exp", pp->expAA);
+	set(&CharacterData::aa_points, "aa_points", pp->aapoints);
+	set(&CharacterData::group_auto_consent, "group_auto_consent", pp->groupAutoconsent);
+	set(&CharacterData::raid_auto_consent, "raid_auto_consent", pp->raidAutoconsent);
+	set(&CharacterData::guild_auto_consent, "guild_auto_consent", pp->guildAutoconsent);
+	set(&CharacterData::RestTimer, "RestTimer", pp->RestTimer);
+	set(&CharacterData::e_aa_effects, "e_aa_effects", m_epp->aa_effects);
+	set(&CharacterData::e_percent_to_aa, "e_percent_to_aa", m_epp->perAA);
+	set(&CharacterData::e_expended_aa_spent, "e_expended_aa_spent", m_epp->expended_aa);
+	set(&CharacterData::e_last_invsnapshot, "e_last_invsnapshot", m_epp->last_invsnapshot_time);
+	set(&CharacterData::mailkey, "mailkey", c->GetMailKeyFull());
+	set(&CharacterData::illusion_block, "illusion_block", c->GetIllusionBlock());
+
+	if (saved) {
+		CharacterDataRepository::MarkChanged(e, *saved);
+	}
+	else {
+		e.changed_columns = owned;
 	}
 
-	e.id                      = c->CharacterID();
-	e.account_id              = c->AccountID();
-	e.name                    = pp->name;
-	e.last_name               = pp->last_name;
-	e.gender                  = pp->gender;
-	e.race                    = pp->race;
-	e.class_                  = pp->class_;
-	e.level                   = pp->level;
-	e.deity                   = pp->deity;
-	e.birthday                = pp->birthday;
-	e.last_login              = pp->lastlogin;
-	e.time_played             = pp->timePlayedMin;
-	e.pvp_status              = pp->pvp;
-	e.level2                  = pp->level2;
-	e.anon                    = pp->anon;
-	e.gm                      = pp->gm;
-	e.intoxication            = pp->intoxication;
-	e.hair_color              = pp->haircolor;
-	e.beard_color             = pp->beardcolor;
-	e.eye_color_1             = pp->eyecolor1;
-	e.eye_color_2             = pp->eyecolor2;
-	e.hair_style              = pp->hairstyle;
-	e.beard                   = pp->beard;
-	e.ability_time_seconds    = pp->ability_time_seconds;
-	e.ability_number          = pp->ability_number;
-	e.ability_time_minutes    = pp->ability_time_minutes;
-	e.ability_time_hours      = pp->ability_time_hours;
-	e.title                   = pp->title;
-	e.suffix                  = pp->suffix;
-	e.exp                     = pp->exp;
-	e.exp_enabled             = c->IsEXPEnabled();
-	e.points                  = pp->points;
-	e.mana                    = pp->mana;
-	e.cur_hp                  = pp->cur_hp;
-	e.str                     = pp->STR;
-	e.sta                     = pp->STA;
-	e.cha                     = pp->CHA;
-	e.dex                     = pp->DEX;
-	e.int_                    = pp->INT;
-	e.agi                     = pp->AGI;
-	e.wis                     = pp->WIS;
-	e.face                    = pp->face;
-	e.y                       = pp->y;
-	e.x                       = pp->x;
-	e.z                       = pp->z;
-	e.heading                 = pp->heading;
-	e.pvp2                    = pp->pvp2;
-	e.pvp_type                = pp->pvptype;
-	e.autosplit_enabled       = pp->autosplit;
-	e.zone_change_count       = pp->zone_change_count;
-	e.drakkin_heritage        = pp->drakkin_heritage;
-	e.drakkin_tattoo          = pp->drakkin_tattoo;
-	e.drakkin_details         = pp->drakkin_details;
-	e.toxicity                = pp->toxicity;
-	e.hunger_level            = pp->hunger_level;
-	e.thirst_level            = pp->thirst_level;
-	e.ability_up              = pp->ability_up;
-	e.zone_id                 = pp->zone_id;
-	e.zone_instance           = pp->zoneInstance;
-	e.leadership_exp_on       = pp->leadAAActive;
-	e.ldon_points_guk         = pp->ldon_points_guk;
-	e.ldon_points_mir         = pp->ldon_points_mir;
-	e.ldon_points_mmc         = pp->ldon_points_mmc;
-	e.ldon_points_ruj         = pp->ldon_points_ruj;
-	e.ldon_points_tak         = pp->ldon_points_tak;
-	e.ldon_points_available   = pp->ldon_points_available;
-	e.tribute_time_remaining  = pp->tribute_time_remaining;
-	e.show_helm               = pp->showhelm;
-	e.career_tribute_points   = pp->career_tribute_points;
-	e.tribute_points          = pp->tribute_points;
-	e.tribute_active          = pp->tribute_active;
-	e.endurance               = pp->endurance;
-	e.group_leadership_exp    = pp->group_leadership_exp;
-	e.raid_leadership_exp     = pp->raid_leadership_exp;
-	e.group_leadership_points = pp->group_leadership_points;
-	e.raid_leadership_points  = pp->raid_leadership_points;
-	e.air_remaining           = pp->air_remaining;
-	e.pvp_kills               = pp->PVPKills;
-	e.pvp_deaths              = pp->PVPDeaths;
-	e.pvp_current_points      = pp->PVPCurrentPoints;
-	e.pvp_career_points       = pp->PVPCareerPoints;
-	e.pvp_best_kill_streak    = pp->PVPBestKillStreak;
-	e.pvp_worst_death_streak  = pp->PVPWorstDeathStreak;
-	e.pvp_current_kill_streak = pp->PVPCurrentKillStreak;
-	e.aa_points_spent         = pp->aapoints_spent;
-	e.aa_exp                  = pp->expAA;
-	e.aa_points               = pp->aapoints;
-	e.group_auto_consent      = pp->groupAutoconsent;
-	e.raid_auto_consent       = pp->raidAutoconsent;
-	e.guild_auto_consent      = pp->guildAutoconsent;
-	e.RestTimer               = pp->RestTimer;
-	e.e_aa_effects            = m_epp->aa_effects;
-	e.e_percent_to_aa         = m_epp->perAA;
-	e.e_expended_aa_spent     = m_epp->expended_aa;
-	e.e_last_invsnapshot      = m_epp->last_invsnapshot_time;
-	e.mailkey                 = c->GetMailKeyFull();
-	e.illusion_block          = c->GetIllusionBlock();
-
-	const int replaced = CharacterDataRepository::ReplaceOne(database, e);
-
-	if (!replaced) {
-		LogError("Failed to save character data for [{}] ID [{}].", c->GetCleanName(), c->CharacterID());
-		return false;
+	if (e.changed_columns.none()) {
+		return true;
+	}
+
+	// taken as written right away so the next save diffs against it, a failed write clears it again
+	saved = e;
+
+	// part of a save that goes out as one transaction, whether it commits comes back through the save state
+	if (IsCapturingWrites()) {
+		CharacterDataRepository::UpdateOne(*this, e);
+		return true;
+	}
+
+	// the repository builds the statement, it's sent here so a failure can be told apart from a write that
+	// changed nothing, mysql counts no affected rows when the values were already stored
+	std::vector<std::string> statements;
+	BeginWriteCapture(&statements);
+	CharacterDataRepository::UpdateOne(*this, e);
+	EndWriteCapture();
+
+	// saves for the same character share an order key so they land in the order they were made
+	if (async) {
+		const uint32      character_id   = c->CharacterID();
+		const std::string character_name = c->GetCleanName();
+
+		for (auto &query : statements) {
+			QueryDatabaseAsync(
+				query,
+				[character_id, character_name](MySQLRequestResult &results) {
+					if (!results.Success()) {
+						LogError("Failed to save character data for [{}] ID [{}].", character_name, character_id);
+
+						auto client = entity_list.GetClientByCharID(character_id);
+						if (client) {
+							client->GetSavedCharacterData().reset();
+						}
+					}
+				},
+				character_id
+			);
+		}
+
+		return true;
+	}
+
+	for (auto &query : statements) {
+		if (!QueryDatabase(query).Success()) {
+			LogError("Failed to save character data for [{}] ID [{}].", c->GetCleanName(), c->CharacterID());
+			saved.reset();
+			return false;
+		}
 	}
 
 	LogDebug(
@@ -1175,6 +1259,87 @@ bool ZoneDatabase::SaveCharacterData(
 	return true;
 }
 
+void ZoneDatabase::CommitCharacterSave(
+	Client *c,
+	std::vector<std::string> statements,
+	uint32 sections_written,
+	uint32 sections_skipped,
+	std::chrono::steady_clock::time_point started,
+	bool sync,
+	uint32 save_id
+)
+{
+	auto &stats = m_character_save_stats;
+
+	stats.saves++;
+	stats.sections_written += sections_written;
+	stats.sections_skipped += sections_skipped;
+
+	if (statements.empty()) {
+		stats.empty_saves++;
+		c->GetSaveState().Committed(save_id);
+		return;
+	}
+
+	uint64 bytes = 0;
+	for (const auto &s : statements) {
+		bytes += s.length();
+	}
+
+	stats.statements += statements.size();
+	stats.bytes_written += bytes;
+	stats.pending++;
+
+	const uint32      character_id   = c->CharacterID();
+	const std::string character_name = c->GetCleanName();
+
+	auto on_done = [this, character_id, character_name, started, save_id](MySQLRequestResult &results) {
+		auto &stats = m_character_save_stats;
+
+		const auto latency_us = static_cast<uint64>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - started
+			).count()
+		);
+
+		stats.pending--;
+		stats.total_latency_us += latency_us;
+		stats.max_latency_us = std::max(stats.max_latency_us, latency_us);
+
+		auto client = entity_list.GetClientByCharID(character_id);
+
+		if (!results.Success()) {
+			stats.failed++;
+			LogError(
+				"Failed to save character [{}] ID [{}] [{}], next save writes everything",
+				character_name,
+				character_id,
+				results.ErrorMessage()
+			);
+
+			// the transaction rolled back, what it wrote is marked unsaved again
+			if (client) {
+				client->GetSaveState().Failed(save_id);
+			}
+
+			return;
+		}
+
+		if (client) {
+			client->GetSaveState().Committed(save_id);
+		}
+	};
+
+	if (sync) {
+		auto results = QueryDatabaseTransaction(statements);
+		on_done(results);
+		return;
+	}
+
+	// saves for the same character share an order key so they land in the order they were made
+	QueryDatabaseTransactionAsync(std::move(statements), on_done, character_id);
+}
+
 bool ZoneDatabase::SaveCharacterCurrency(uint32 character_id, PlayerProfile_Struct* pp)
 {
 	ZeroPlayerProfileCurrency(pp);
@@ -1,6 +1,7 @@
 #ifndef ZONEDB_H_
 #define ZONEDB_H_
 
+#include <chrono>
 #include <unordered_set>
 
 #include "../common/shareddb.h"
@@ -361,6 +362,19 @@ namespace NPCSpawnTypes {
   };
 }
 
+struct CharacterSaveStats {
+	uint64 saves;
+	uint64 empty_saves; // nothing had changed since the last save
+	uint64 sections_written;
+	uint64 sections_skipped;
+	uint64 statements;
+	uint64 bytes_written;
+	uint64 failed;
+	uint64 pending;
+	uint64 total_latency_us;
+	uint64 max_latency_us;
+};
+
 namespace RaidLootTypes {
 	enum : uint32 {
 		RaidLeader = 1,
@@ -448,7 +462,7 @@ public:
 
 	bool SaveCharacterBandolier(uint32 character_id, uint8 bandolier_id, uint8 bandolier_slot, uint32 item_id, uint32 icon, const char* bandolier_name);
 	bool SaveCharacterCurrency(uint32 character_id, PlayerProfile_Struct* pp);
-	bool SaveCharacterData(Client* c, PlayerProfile_Struct* pp, ExtendedProfile_Struct* m_epp);
+	bool SaveCharacterData(Client* c, PlayerProfile_Struct* pp, ExtendedProfile_Struct* m_epp, bool async = false);
 	bool SaveCharacterDiscipline(uint32 character_id, uint32 slot_id, uint32 disc_id);
 	bool SaveCharacterLanguage(uint32 character_id, uint32 lang_id, uint32 value);
 	bool SaveCharacterLeadershipAbilities(uint32 character_id, PlayerProfile_Struct* pp);
@@ -653,6 +667,19 @@ public:
 
 	static void SaveCharacterBinds(Client *c);
 	static void SaveCharacterTribute(Client* c);
+
+	// sends the statements Client::Save collected as one transaction, off the game thread unless sync
+	void CommitCharacterSave(
+		Client *c,
+		std::vector<std::string> statements,
+		uint32 sections_written,
+		uint32 sections_skipped,
+		std::chrono::steady_clock::time_point started,
+		bool sync,
+		uint32 save_id
+	);
+	const CharacterSaveStats &GetCharacterSaveStats() const { return m_character_save_stats; }
+	void ResetCharacterSaveStats() { m_character_save_stats = CharacterSaveStats{}; }
 protected:
 	void ZDBInitVars();
 
@@ -666,6 +693,7 @@ protected:
 	std::unordered_map<uint32, DBbotspells_Struct> bot_spells_cache;
 	std::unordered_set<uint32> bot_spells_loadtried;
 
+	CharacterSaveStats m_character_save_stats = {};
 };
 
 extern ZoneDatabase database;
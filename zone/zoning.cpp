@@ -416,9 +416,7 @@ void Client::SendZoneCancel(ZoneChange_Struct *zc) {
 	// we're using rewind location because it should be where the client relatively was before we rejected the zone request.
 	// it also prevents the client from getting caught up in a zone loop because if we sent them exactly back to where they
 	// originated the request we could end up in a situation where the client is caught in a zone loop.
-	m_Position.x = m_RewindLocation.x;
-	m_Position.y = m_RewindLocation.y;
-	m_Position.z = m_RewindLocation.z;
+	SetPosition(m_RewindLocation.x, m_RewindLocation.y, m_RewindLocation.z);
 	zc2->x       = m_Position.x;
 	zc2->y       = m_Position.y;
 	zc2->z       = m_Position.z;
@@ -520,10 +518,8 @@ void Client::DoZoneSuccess(ZoneChange_Struct *zc, uint16 zone_id, uint32 instanc
 
 	//set the player's coordinates in the new zone so they have them
 	//when they zone into it
-	m_Position.x = dest_x; //these coordinates will now be saved when ~client is called
-	m_Position.y = dest_y;
-	m_Position.z = dest_z;
-	m_Position.w = dest_h; // Cripp: fix for zone heading
+	SetPosition(dest_x, dest_y, dest_z); //these coordinates will now be saved when ~client is called
+	SetHeading(dest_h); // Cripp: fix for zone heading
 	m_pp.heading = dest_h;
 	m_pp.zone_id = zone_id;
 	m_pp.zoneInstance = instance_id;
@@ -864,7 +860,8 @@ void Client::ZonePC(uint32 zoneID, uint32 instance_id, float x, float y, float z
 			break;
 		case GMSummon:
 		case GMHiddenSummon:
-			m_Position = glm::vec4(x, y, z, heading);
+			SetPosition(x, y, z);
+			SetHeading(heading);
 			m_ZoneSummonLocation = m_Position;
 			zonesummon_id = zoneID;
 			zonesummon_ignorerestrictions = 1;
@@ -875,15 +872,17 @@ void Client::ZonePC(uint32 zoneID, uint32 instance_id, float x, float y, float z
 			zonesummon_ignorerestrictions = ignorerestrictions;
 			break;
 		case GateToBindPoint:
-			x = m_Position.x = m_pp.binds[0].x;
-			y = m_Position.y = m_pp.binds[0].y;
-			z = m_Position.z = m_pp.binds[0].z;
+			x = m_pp.binds[0].x;
+			y = m_pp.binds[0].y;
+			z = m_pp.binds[0].z;
+			SetPosition(x, y, z);
 			heading = m_pp.binds[0].heading;
 			break;
 		case ZoneToBindPoint:
-			x = m_Position.x = m_pp.binds[0].x;
-			y = m_Position.y = m_pp.binds[0].y;
-			z = m_Position.z = m_pp.binds[0].z;
+			x = m_pp.binds[0].x;
+			y = m_pp.binds[0].y;
+			z = m_pp.binds[0].z;
+			SetPosition(x, y, z);
 			heading = m_pp.binds[0].heading;
 			zonesummon_ignorerestrictions = 1;
 			LogDebug("Player [{}] has died and will be zoned to bind point in zone: [{}] at LOC x=[{}], y=[{}], z=[{}], heading=[{}]",
@@ -891,14 +890,16 @@ void Client::ZonePC(uint32 zoneID, uint32 instance_id, float x, float y, float z
 			break;
 		case SummonPC:
 			m_ZoneSummonLocation = glm::vec4(x, y, z, heading);
-			m_Position = m_ZoneSummonLocation;
+			SetPosition(x, y, z);
+			SetHeading(heading);
 			break;
 		case Rewind:
 			LogDebug("[{}] has requested a /rewind from [{}], [{}], [{}], to [{}], [{}], [{}] in [{}]", GetName(),
 					m_Position.x, m_Position.y, m_Position.z,
 					m_RewindLocation.x, m_RewindLocation.y, m_RewindLocation.z, zone->GetShortName());
 			m_ZoneSummonLocation = glm::vec4(x, y, z, heading);
-			m_Position = m_ZoneSummonLocation;
+			SetPosition(x, y, z);
+			SetHeading(heading);
 			break;
 		default:
 			LogError("Client::ZonePC() received a reguest to perform an unsupported client zone operation");
@@ -1111,6 +1112,7 @@ void Client::SetBindPoint(int bind_number, int to_zone, int to_instance, const g
 		m_pp.binds[bind_number].heading     = GetHeading();
 	}
 
+	m_save_state.Forget(SaveSectionBinds);
 	database.SaveCharacterBinds(this);
 }
 
@@ -1135,6 +1137,7 @@ void Client::SetBindPoint2(int bind_number, int to_zone, int to_instance, const
 		m_pp.binds[bind_number].heading = location.w;
 	}
 
+	m_save_state.Forget(SaveSectionBinds);
 	database.SaveCharacterBinds(this);
 }
 